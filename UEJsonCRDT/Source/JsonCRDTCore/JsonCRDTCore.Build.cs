@@ -0,0 +1,23 @@
+// Copyright Your Company. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class JsonCRDTCore : ModuleRules
+{
+	public JsonCRDTCore(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		// Engine-independent CRDT core: no Engine, HTTP or WebSockets, so it links into
+		// dedicated servers, commandlets and standalone programs (bots, load testers).
+		// CoreUObject is only needed for the reflected operation and patch structs.
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Json",
+			}
+		);
+	}
+}
@@ -0,0 +1,441 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "JsonCRDTBinaryCodec.h"
+
+const TCHAR* FJsonCRDTBinaryCodec::ProtocolName = TEXT("jsoncrdt-binary/1");
+
+namespace JsonCRDTBinaryCodec
+{
+	/** 문자열 코드: 원문 + 사전 등록 */
+	static constexpr uint64 StringCodeDefine = 0;
+
+	/** 문자열 코드: 원문만 (사전이 가득 찬 경우) */
+	static constexpr uint64 StringCodeLiteral = 1;
+
+	/** 사전 항목 번호에 더해지는 값 */
+	static constexpr uint64 StringCodeFirstIndex = 2;
+
+	/** 디코딩 시 허용하는 최대 개수 (손상된 프레임으로 인한 과도한 할당 방지) */
+	static constexpr uint64 MaxDecodedCount = 1 << 20;
+
+	/** 항목 하나가 프레임에서 차지하는 최소 바이트 수 (남은 바이트로 담을 수 없는 개수는 할당 전에 거부) */
+	static constexpr int32 MinPatchBytes = 5;
+	static constexpr int32 MinVersionVectorEntryBytes = 2;
+	static constexpr int32 MinOperationBytes = 3;
+
+	static void WriteVarUInt(uint64 Value, TArray<uint8>& Out)
+	{
+		do
+		{
+			uint8 Byte = static_cast<uint8>(Value & 0x7F);
+			Value >>= 7;
+			if (Value != 0)
+			{
+				Byte |= 0x80;
+			}
+			Out.Add(Byte);
+		}
+		while (Value != 0);
+	}
+
+	static void WriteVarInt(int64 Value, TArray<uint8>& Out)
+	{
+		// 지그재그 인코딩으로 작은 음수도 짧게 표현
+		WriteVarUInt((static_cast<uint64>(Value) << 1) ^ static_cast<uint64>(Value >> 63), Out);
+	}
+
+	static void WriteBytes(const FString& Value, TArray<uint8>& Out)
+	{
+		FTCHARToUTF8 Utf8(*Value, Value.Len());
+		WriteVarUInt(static_cast<uint64>(Utf8.Length()), Out);
+		Out.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	}
+
+	static bool ReadByte(const uint8*& Cursor, const uint8* End, uint8& OutValue)
+	{
+		if (Cursor >= End)
+		{
+			return false;
+		}
+		OutValue = *Cursor++;
+		return true;
+	}
+
+	static bool ReadVarUInt(const uint8*& Cursor, const uint8* End, uint64& OutValue)
+	{
+		OutValue = 0;
+		for (int32 Shift = 0; Shift < 64; Shift += 7)
+		{
+			uint8 Byte;
+			if (!ReadByte(Cursor, End, Byte))
+			{
+				return false;
+			}
+			OutValue |= static_cast<uint64>(Byte & 0x7F) << Shift;
+			if ((Byte & 0x80) == 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static bool ReadVarInt(const uint8*& Cursor, const uint8* End, int64& OutValue)
+	{
+		uint64 Encoded;
+		if (!ReadVarUInt(Cursor, End, Encoded))
+		{
+			return false;
+		}
+		OutValue = static_cast<int64>(Encoded >> 1) ^ -static_cast<int64>(Encoded & 1);
+		return true;
+	}
+
+	static bool ReadCount(const uint8*& Cursor, const uint8* End, int32 MinEntryBytes, int32& OutCount)
+	{
+		uint64 Count;
+		if (!ReadVarUInt(Cursor, End, Count) || Count > MaxDecodedCount || Count > static_cast<uint64>(End - Cursor) / MinEntryBytes)
+		{
+			return false;
+		}
+		OutCount = static_cast<int32>(Count);
+		return true;
+	}
+
+	static bool ReadBytes(const uint8*& Cursor, const uint8* End, FString& OutValue)
+	{
+		uint64 Length;
+		if (!ReadVarUInt(Cursor, End, Length) || Length > static_cast<uint64>(End - Cursor))
+		{
+			return false;
+		}
+
+		FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Cursor), static_cast<int32>(Length));
+		OutValue = FString(Converted.Length(), Converted.Get());
+		Cursor += Length;
+		return true;
+	}
+
+	static bool HasFromPath(EJsonCRDTOperationType Type)
+	{
+		return Type == EJsonCRDTOperationType::Move || Type == EJsonCRDTOperationType::Copy;
+	}
+
+	static bool HasValue(EJsonCRDTOperationType Type)
+	{
+		return Type == EJsonCRDTOperationType::Add
+			|| Type == EJsonCRDTOperationType::Replace
+			|| Type == EJsonCRDTOperationType::Test;
+	}
+}
+
+FJsonCRDTStringDictionary::FJsonCRDTStringDictionary(int32 InMaxEntries)
+	: MaxEntries(FMath::Max(0, InMaxEntries))
+{
+}
+
+int32 FJsonCRDTStringDictionary::Find(const FString& Value) const
+{
+	const int32* Index = Indices.Find(Value);
+	return Index ? *Index : INDEX_NONE;
+}
+
+int32 FJsonCRDTStringDictionary::Add(const FString& Value)
+{
+	if (!HasCapacity())
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 Index = Entries.Add(Value);
+	Indices.Add(Value, Index);
+	return Index;
+}
+
+const FString* FJsonCRDTStringDictionary::Get(int32 Index) const
+{
+	return Entries.IsValidIndex(Index) ? &Entries[Index] : nullptr;
+}
+
+void FJsonCRDTStringDictionary::Reset()
+{
+	Entries.Reset();
+	Indices.Reset();
+}
+
+FJsonCRDTBinaryCodec::FJsonCRDTBinaryCodec()
+{
+}
+
+void FJsonCRDTBinaryCodec::Reset()
+{
+	ResetEncoder();
+	ResetDecoder();
+}
+
+void FJsonCRDTBinaryCodec::ResetEncoder()
+{
+	EncodeStrings.Reset();
+}
+
+void FJsonCRDTBinaryCodec::ResetDecoder()
+{
+	DecodeStrings.Reset();
+}
+
+void FJsonCRDTBinaryCodec::EncodePatch(const FJsonCRDTPatch& Patch, TArray<uint8>& OutFrame, bool bIncludeClientID)
+{
+	EncodePatches(MakeArrayView(&Patch, 1), OutFrame, bIncludeClientID);
+}
+
+void FJsonCRDTBinaryCodec::EncodePatches(TArrayView<const FJsonCRDTPatch> Patches, TArray<uint8>& OutFrame, bool bIncludeClientID)
+{
+	using namespace JsonCRDTBinaryCodec;
+
+	OutFrame.Reset();
+	OutFrame.Add(FrameMagic);
+	OutFrame.Add(FrameVersion);
+	OutFrame.Add(static_cast<uint8>(EFrameType::Patches));
+	WriteVarUInt(static_cast<uint64>(Patches.Num()), OutFrame);
+
+	for (const FJsonCRDTPatch& Patch : Patches)
+	{
+		WritePatch(Patch, bIncludeClientID, OutFrame);
+	}
+}
+
+bool FJsonCRDTBinaryCodec::DecodeFrame(const uint8* Data, int32 Size, TArray<FJsonCRDTPatch>& OutPatches)
+{
+	using namespace JsonCRDTBinaryCodec;
+
+	if (!IsBinaryFrame(Data, Size) || Size < 3)
+	{
+		return false;
+	}
+
+	const uint8* Cursor = Data + 1;
+	const uint8* End = Data + Size;
+
+	uint8 Version = 0;
+	uint8 FrameType = 0;
+	if (!ReadByte(Cursor, End, Version) || Version != FrameVersion
+		|| !ReadByte(Cursor, End, FrameType) || FrameType != static_cast<uint8>(EFrameType::Patches))
+	{
+		return false;
+	}
+
+	int32 NumPatches;
+	if (!ReadCount(Cursor, End, MinPatchBytes, NumPatches))
+	{
+		return false;
+	}
+
+	const int32 FirstPatch = OutPatches.Num();
+	OutPatches.Reserve(FirstPatch + NumPatches);
+	for (int32 i = 0; i < NumPatches; ++i)
+	{
+		if (!ReadPatch(Cursor, End, OutPatches.AddDefaulted_GetRef()))
+		{
+			OutPatches.SetNum(FirstPatch);
+			return false;
+		}
+	}
+
+	return Cursor == End;
+}
+
+bool FJsonCRDTBinaryCodec::IsBinaryFrame(const uint8* Data, int32 Size)
+{
+	return Data != nullptr && Size > 0 && Data[0] == FrameMagic;
+}
+
+void FJsonCRDTBinaryCodec::WritePatch(const FJsonCRDTPatch& Patch, bool bIncludeClientID, TArray<uint8>& Out)
+{
+	using namespace JsonCRDTBinaryCodec;
+
+	const int64 PatchTicks = Patch.Timestamp.GetTicks();
+	const bool bWriteClientID = bIncludeClientID && !Patch.ClientID.IsEmpty();
+
+	uint8 Flags = 0;
+	Flags |= bWriteClientID ? PatchFlag_HasClientID : 0;
+	Flags |= Patch.Sequence > 0 ? PatchFlag_HasSequence : 0;
+	Flags |= Patch.VersionVector.Num() > 0 ? PatchFlag_HasVersionVector : 0;
+
+	WriteString(Patch.DocumentID, Out);
+	Out.Add(Flags);
+	WriteVarInt(Patch.BaseVersion, Out);
+	WriteVarUInt(static_cast<uint64>(PatchTicks), Out);
+	if (bWriteClientID)
+	{
+		WriteString(Patch.ClientID, Out);
+	}
+	if ((Flags & PatchFlag_HasSequence) != 0)
+	{
+		WriteVarUInt(static_cast<uint64>(Patch.Sequence), Out);
+	}
+	if ((Flags & PatchFlag_HasVersionVector) != 0)
+	{
+		WriteVarUInt(static_cast<uint64>(Patch.VersionVector.Num()), Out);
+		for (const TPair<FString, int64>& Entry : Patch.VersionVector)
+		{
+			WriteString(Entry.Key, Out);
+			WriteVarUInt(static_cast<uint64>(FMath::Max<int64>(0, Entry.Value)), Out);
+		}
+	}
+
+	WriteVarUInt(static_cast<uint64>(Patch.Operations.Num()), Out);
+	for (const FJsonCRDTOperation& Operation : Patch.Operations)
+	{
+		Out.Add(static_cast<uint8>(Operation.Type));
+		WriteString(Operation.Path, Out);
+		if (HasFromPath(Operation.Type))
+		{
+			WriteString(Operation.FromPath, Out);
+		}
+		if (HasValue(Operation.Type))
+		{
+			WriteBytes(Operation.Value, Out);
+		}
+
+		// 작업 시간은 대부분 패치 시간과 같으므로 차이만 기록
+		WriteVarInt(Operation.Timestamp.GetTicks() - PatchTicks, Out);
+	}
+}
+
+void FJsonCRDTBinaryCodec::WriteString(const FString& Value, TArray<uint8>& Out)
+{
+	using namespace JsonCRDTBinaryCodec;
+
+	const int32 Index = EncodeStrings.Find(Value);
+	if (Index != INDEX_NONE)
+	{
+		WriteVarUInt(StringCodeFirstIndex + static_cast<uint64>(Index), Out);
+		return;
+	}
+
+	// 사전에 여유가 있으면 상대도 같은 번호로 등록하도록 알림
+	WriteVarUInt(EncodeStrings.Add(Value) != INDEX_NONE ? StringCodeDefine : StringCodeLiteral, Out);
+	WriteBytes(Value, Out);
+}
+
+bool FJsonCRDTBinaryCodec::ReadPatch(const uint8*& Cursor, const uint8* End, FJsonCRDTPatch& OutPatch)
+{
+	using namespace JsonCRDTBinaryCodec;
+
+	uint8 Flags;
+	uint64 PatchTicks;
+	if (!ReadString(Cursor, End, OutPatch.DocumentID)
+		|| !ReadByte(Cursor, End, Flags)
+		|| !ReadVarInt(Cursor, End, OutPatch.BaseVersion)
+		|| !ReadVarUInt(Cursor, End, PatchTicks))
+	{
+		return false;
+	}
+
+	OutPatch.Timestamp = FDateTime(static_cast<int64>(PatchTicks));
+	if ((Flags & PatchFlag_HasClientID) != 0 && !ReadString(Cursor, End, OutPatch.ClientID))
+	{
+		return false;
+	}
+
+	uint64 Sequence = 0;
+	if ((Flags & PatchFlag_HasSequence) != 0 && !ReadVarUInt(Cursor, End, Sequence))
+	{
+		return false;
+	}
+	OutPatch.Sequence = static_cast<int64>(Sequence);
+
+	if ((Flags & PatchFlag_HasVersionVector) != 0)
+	{
+		int32 NumEntries;
+		if (!ReadCount(Cursor, End, MinVersionVectorEntryBytes, NumEntries))
+		{
+			return false;
+		}
+
+		OutPatch.VersionVector.Reserve(NumEntries);
+		for (int32 i = 0; i < NumEntries; ++i)
+		{
+			FString EntryClientID;
+			uint64 EntrySequence;
+			if (!ReadString(Cursor, End, EntryClientID) || !ReadVarUInt(Cursor, End, EntrySequence))
+			{
+				return false;
+			}
+			OutPatch.VersionVector.Add(MoveTemp(EntryClientID), static_cast<int64>(EntrySequence));
+		}
+	}
+
+	int32 NumOperations;
+	if (!ReadCount(Cursor, End, MinOperationBytes, NumOperations))
+	{
+		return false;
+	}
+
+	OutPatch.Operations.Reset(NumOperations);
+	for (int32 i = 0; i < NumOperations; ++i)
+	{
+		FJsonCRDTOperation& Operation = OutPatch.Operations.AddDefaulted_GetRef();
+
+		uint8 Type;
+		if (!ReadByte(Cursor, End, Type) || Type > static_cast<uint8>(EJsonCRDTOperationType::Test))
+		{
+			return false;
+		}
+		Operation.Type = static_cast<EJsonCRDTOperationType>(Type);
+
+		if (!ReadString(Cursor, End, Operation.Path))
+		{
+			return false;
+		}
+		if (HasFromPath(Operation.Type) && !ReadString(Cursor, End, Operation.FromPath))
+		{
+			return false;
+		}
+		if (HasValue(Operation.Type) && !ReadBytes(Cursor, End, Operation.Value))
+		{
+			return false;
+		}
+
+		int64 TimestampDelta;
+		if (!ReadVarInt(Cursor, End, TimestampDelta))
+		{
+			return false;
+		}
+		Operation.Timestamp = FDateTime(static_cast<int64>(PatchTicks) + TimestampDelta);
+		Operation.ClientID = OutPatch.ClientID;
+	}
+
+	return true;
+}
+
+bool FJsonCRDTBinaryCodec::ReadString(const uint8*& Cursor, const uint8* End, FString& OutValue)
+{
+	using namespace JsonCRDTBinaryCodec;
+
+	uint64 Code;
+	if (!ReadVarUInt(Cursor, End, Code))
+	{
+		return false;
+	}
+
+	if (Code >= StringCodeFirstIndex)
+	{
+		const uint64 Index = Code - StringCodeFirstIndex;
+		const FString* Entry = Index <= static_cast<uint64>(MAX_int32) ? DecodeStrings.Get(static_cast<int32>(Index)) : nullptr;
+		if (!Entry)
+		{
+			return false;
+		}
+		OutValue = *Entry;
+		return true;
+	}
+
+	if (!ReadBytes(Cursor, End, OutValue))
+	{
+		return false;
+	}
+
+	// 보낸 쪽이 등록했다면 같은 번호로 등록 (사전 크기가 다르면 동기화가 깨지므로 실패 처리)
+	return Code != StringCodeDefine || DecodeStrings.Add(OutValue) != INDEX_NONE;
+}
@@ -0,0 +1,644 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "JsonCRDTBinaryDocument.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+
+namespace JsonCRDTBinaryDocument
+{
+	/** 디코딩 시 허용하는 최대 개수 (손상된 파일로 인한 과도한 할당 방지) */
+	static constexpr uint64 MaxDecodedCount = 1 << 24;
+
+	/** 항목 하나가 파일에서 차지하는 최소 바이트 수 (남은 바이트로 담을 수 없는 개수는 할당 전에 거부) */
+	static constexpr int32 MinChildBytes = 2;
+	static constexpr int32 MinKeyBytes = 1;
+
+	/** 디코딩 시 허용하는 최대 중첩 깊이 */
+	static constexpr int32 MaxDepth = 512;
+
+	static void WriteVarUInt(uint64 Value, TArray<uint8>& Out)
+	{
+		do
+		{
+			uint8 Byte = static_cast<uint8>(Value & 0x7F);
+			Value >>= 7;
+			if (Value != 0)
+			{
+				Byte |= 0x80;
+			}
+			Out.Add(Byte);
+		}
+		while (Value != 0);
+	}
+
+	static void WriteVarInt(int64 Value, TArray<uint8>& Out)
+	{
+		WriteVarUInt((static_cast<uint64>(Value) << 1) ^ static_cast<uint64>(Value >> 63), Out);
+	}
+
+	static void WriteFixed(uint64 Value, int32 NumBytes, uint8* Out)
+	{
+		for (int32 i = 0; i < NumBytes; ++i)
+		{
+			Out[i] = static_cast<uint8>(Value >> (i * 8));
+		}
+	}
+
+	static uint64 ReadFixed(const uint8* In, int32 NumBytes)
+	{
+		uint64 Value = 0;
+		for (int32 i = 0; i < NumBytes; ++i)
+		{
+			Value |= static_cast<uint64>(In[i]) << (i * 8);
+		}
+		return Value;
+	}
+
+	static void WriteString(const FString& Value, TArray<uint8>& Out)
+	{
+		FTCHARToUTF8 Utf8(*Value, Value.Len());
+		WriteVarUInt(static_cast<uint64>(Utf8.Length()), Out);
+		Out.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	}
+
+	static bool ReadByte(const uint8*& Cursor, const uint8* End, uint8& OutValue)
+	{
+		if (Cursor >= End)
+		{
+			return false;
+		}
+		OutValue = *Cursor++;
+		return true;
+	}
+
+	static bool ReadVarUInt(const uint8*& Cursor, const uint8* End, uint64& OutValue)
+	{
+		OutValue = 0;
+		for (int32 Shift = 0; Shift < 64; Shift += 7)
+		{
+			uint8 Byte;
+			if (!ReadByte(Cursor, End, Byte))
+			{
+				return false;
+			}
+			OutValue |= static_cast<uint64>(Byte & 0x7F) << Shift;
+			if ((Byte & 0x80) == 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static bool ReadVarInt(const uint8*& Cursor, const uint8* End, int64& OutValue)
+	{
+		uint64 Encoded;
+		if (!ReadVarUInt(Cursor, End, Encoded))
+		{
+			return false;
+		}
+		OutValue = static_cast<int64>(Encoded >> 1) ^ -static_cast<int64>(Encoded & 1);
+		return true;
+	}
+
+	static bool ReadCount(const uint8*& Cursor, const uint8* End, int32 MinEntryBytes, int32& OutCount)
+	{
+		uint64 Count;
+		if (!ReadVarUInt(Cursor, End, Count) || Count > MaxDecodedCount || Count > static_cast<uint64>(End - Cursor) / MinEntryBytes)
+		{
+			return false;
+		}
+		OutCount = static_cast<int32>(Count);
+		return true;
+	}
+
+	static bool SkipString(const uint8*& Cursor, const uint8* End)
+	{
+		uint64 Length;
+		if (!ReadVarUInt(Cursor, End, Length) || Length > static_cast<uint64>(End - Cursor))
+		{
+			return false;
+		}
+		Cursor += Length;
+		return true;
+	}
+
+	static bool ReadString(const uint8*& Cursor, const uint8* End, FString& OutValue)
+	{
+		const uint8* Start = Cursor;
+		if (!SkipString(Cursor, End))
+		{
+			return false;
+		}
+
+		// 길이 varint 뒤의 UTF-8 바이트만 변환
+		uint64 Length;
+		ReadVarUInt(Start, End, Length);
+		FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Start), static_cast<int32>(Length));
+		OutValue = FString(Converted.Length(), Converted.Get());
+		return true;
+	}
+
+	/** 컨테이너 머리 읽기 (자식 수와 내용 크기, 내용이 파일 범위 안에 있는지 확인) */
+	static bool ReadContainerHeader(const uint8*& Cursor, const uint8* End, int32& OutCount, uint32& OutPayloadSize)
+	{
+		if (!ReadCount(Cursor, End, MinChildBytes, OutCount) || End - Cursor < 4)
+		{
+			return false;
+		}
+		OutPayloadSize = static_cast<uint32>(ReadFixed(Cursor, 4));
+		Cursor += 4;
+		return OutPayloadSize <= static_cast<uint64>(End - Cursor);
+	}
+
+	static void WriteNode(const FJsonCRDTNodeStore& Store, int32 NodeIndex, int64 ParentTimestamp, TArray<uint8>& Out)
+	{
+		const FJsonCRDTNode& Node = Store.GetNode(NodeIndex);
+		Out.Add(static_cast<uint8>(Node.Type));
+		WriteVarInt(Node.Timestamp - ParentTimestamp, Out);
+
+		switch (Node.Type)
+		{
+		case EJsonCRDTNodeType::Boolean:
+			Out.Add(static_cast<uint8>(Node.bBoolValue ? 1 : 0));
+			break;
+
+		case EJsonCRDTNodeType::Number:
+		{
+			uint64 Bits;
+			FMemory::Memcpy(&Bits, &Node.NumberValue, sizeof(Bits));
+			WriteFixed(Bits, 8, Out.GetData() + Out.AddUninitialized(8));
+			break;
+		}
+
+		case EJsonCRDTNodeType::String:
+			WriteString(Store.GetString(NodeIndex), Out);
+			break;
+
+		case EJsonCRDTNodeType::Array:
+		case EJsonCRDTNodeType::Object:
+		{
+			WriteVarUInt(static_cast<uint64>(Node.Children.Num()), Out);
+			const int32 SizeOffset = Out.AddUninitialized(4);
+			const int32 PayloadStart = Out.Num();
+
+			const bool bObject = Node.Type == EJsonCRDTNodeType::Object;
+			for (int32 i = 0; i < Node.Children.Num(); ++i)
+			{
+				if (bObject)
+				{
+					WriteVarUInt(static_cast<uint64>(Node.ChildKeys[i]), Out);
+				}
+				WriteNode(Store, Node.Children[i], Node.Timestamp, Out);
+			}
+
+			WriteFixed(static_cast<uint64>(Out.Num() - PayloadStart), 4, Out.GetData() + SizeOffset);
+			break;
+		}
+
+		default:
+			break;
+		}
+	}
+}
+
+FJsonCRDTBinaryDocument::FJsonCRDTBinaryDocument()
+	: Data(nullptr)
+	, End(nullptr)
+	, Root(nullptr)
+{
+}
+
+FJsonCRDTBinaryDocument::~FJsonCRDTBinaryDocument()
+{
+	Close();
+}
+
+void FJsonCRDTBinaryDocument::Encode(const FHeader& InHeader, const FJsonCRDTNodeStore& Store, TArray<uint8>& OutBytes)
+{
+	using namespace JsonCRDTBinaryDocument;
+
+	OutBytes.Reset();
+	WriteFixed(FileMagic, 4, OutBytes.GetData() + OutBytes.AddUninitialized(4));
+	OutBytes.Add(FormatVersion);
+
+	uint8 Flags = 0;
+	if (InHeader.bHasSnapshot)
+	{
+		Flags |= FileFlag_HasSnapshot;
+		if (InHeader.Snapshot.Content.IsEmpty())
+		{
+			Flags |= FileFlag_SnapshotIsContent;
+		}
+	}
+	OutBytes.Add(Flags);
+
+	WriteString(InHeader.DocumentID, OutBytes);
+	WriteVarInt(InHeader.Version, OutBytes);
+	WriteVarInt(InHeader.Timestamp.GetTicks(), OutBytes);
+
+	if (Flags & FileFlag_HasSnapshot)
+	{
+		WriteVarInt(InHeader.Snapshot.Version, OutBytes);
+		WriteVarInt(InHeader.Snapshot.Timestamp.GetTicks(), OutBytes);
+		if (!(Flags & FileFlag_SnapshotIsContent))
+		{
+			WriteString(InHeader.Snapshot.Content, OutBytes);
+		}
+	}
+
+	WriteVarUInt(static_cast<uint64>(Store.Keys.Num()), OutBytes);
+	for (const FString& Key : Store.Keys)
+	{
+		WriteString(Key, OutBytes);
+	}
+
+	WriteNode(Store, Store.GetRoot(), 0, OutBytes);
+}
+
+bool FJsonCRDTBinaryDocument::Open(const FString& FilePath)
+{
+	Close();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	MappedFile.Reset(PlatformFile.OpenMapped(*FilePath));
+	if (MappedFile)
+	{
+		MappedRegion.Reset(MappedFile->MapRegion());
+	}
+
+	if (MappedRegion)
+	{
+		Data = MappedRegion->GetMappedPtr();
+		End = Data + MappedRegion->GetMappedSize();
+	}
+	else
+	{
+		// 매핑을 지원하지 않으면 파일을 한 번에 읽음
+		MappedFile.Reset();
+		if (!FFileHelper::LoadFileToArray(LoadedBytes, *FilePath))
+		{
+			return false;
+		}
+		Data = LoadedBytes.GetData();
+		End = Data + LoadedBytes.Num();
+	}
+
+	if (!ReadHeader())
+	{
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void FJsonCRDTBinaryDocument::Close()
+{
+	// 영역을 먼저 해제한 뒤 파일 핸들을 닫아야 함
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	LoadedBytes.Empty();
+	Data = nullptr;
+	End = nullptr;
+	Root = nullptr;
+	Keys.Empty();
+	KeyIndices.Empty();
+	Header = FHeader();
+}
+
+bool FJsonCRDTBinaryDocument::ReadHeader()
+{
+	using namespace JsonCRDTBinaryDocument;
+
+	const uint8* Cursor = Data;
+	if (End - Cursor < 6 || ReadFixed(Cursor, 4) != FileMagic || Cursor[4] != FormatVersion)
+	{
+		return false;
+	}
+	const uint8 Flags = Cursor[5];
+	Cursor += 6;
+
+	int64 Ticks;
+	if (!ReadString(Cursor, End, Header.DocumentID) || !ReadVarInt(Cursor, End, Header.Version) || !ReadVarInt(Cursor, End, Ticks))
+	{
+		return false;
+	}
+	Header.Timestamp = FDateTime(Ticks);
+
+	Header.bHasSnapshot = (Flags & FileFlag_HasSnapshot) != 0;
+	if (Header.bHasSnapshot)
+	{
+		Header.Snapshot.DocumentID = Header.DocumentID;
+		if (!ReadVarInt(Cursor, End, Header.Snapshot.Version) || !ReadVarInt(Cursor, End, Ticks))
+		{
+			return false;
+		}
+		Header.Snapshot.Timestamp = FDateTime(Ticks);
+
+		if (!(Flags & FileFlag_SnapshotIsContent) && !ReadString(Cursor, End, Header.Snapshot.Content))
+		{
+			return false;
+		}
+	}
+
+	int32 NumKeys;
+	if (!ReadCount(Cursor, End, MinKeyBytes, NumKeys))
+	{
+		return false;
+	}
+	Keys.Reserve(NumKeys);
+	KeyIndices.Reserve(NumKeys);
+	for (int32 i = 0; i < NumKeys; ++i)
+	{
+		FString& Key = Keys.AddDefaulted_GetRef();
+		if (!ReadString(Cursor, End, Key))
+		{
+			return false;
+		}
+		KeyIndices.Add(Key, i);
+	}
+
+	// 루트는 객체여야 하며 내용 전체가 파일 안에 있어야 함 (내용 자체는 읽지 않음)
+	Root = Cursor;
+	if (Cursor >= End || *Cursor != static_cast<uint8>(EJsonCRDTNodeType::Object))
+	{
+		return false;
+	}
+	return SkipNode(Cursor);
+}
+
+bool FJsonCRDTBinaryDocument::SkipNode(const uint8*& Cursor) const
+{
+	using namespace JsonCRDTBinaryDocument;
+
+	uint8 Type;
+	int64 TimestampDelta;
+	if (!ReadByte(Cursor, End, Type) || !ReadVarInt(Cursor, End, TimestampDelta))
+	{
+		return false;
+	}
+
+	switch (static_cast<EJsonCRDTNodeType>(Type))
+	{
+	case EJsonCRDTNodeType::Null:
+		return true;
+
+	case EJsonCRDTNodeType::Boolean:
+		return ReadByte(Cursor, End, Type);
+
+	case EJsonCRDTNodeType::Number:
+		if (End - Cursor < 8)
+		{
+			return false;
+		}
+		Cursor += 8;
+		return true;
+
+	case EJsonCRDTNodeType::String:
+		return SkipString(Cursor, End);
+
+	case EJsonCRDTNodeType::Array:
+	case EJsonCRDTNodeType::Object:
+	{
+		int32 Count;
+		uint32 PayloadSize;
+		if (!ReadContainerHeader(Cursor, End, Count, PayloadSize))
+		{
+			return false;
+		}
+		Cursor += PayloadSize;
+		return true;
+	}
+
+	default:
+		return false;
+	}
+}
+
+bool FJsonCRDTBinaryDocument::FindChild(const uint8*& Cursor, const FJsonCRDTPath& Path, int32 TokenIndex) const
+{
+	using namespace JsonCRDTBinaryDocument;
+
+	uint8 Type;
+	int64 TimestampDelta;
+	int32 Count;
+	uint32 PayloadSize;
+	if (!ReadByte(Cursor, End, Type) || !ReadVarInt(Cursor, End, TimestampDelta))
+	{
+		return false;
+	}
+
+	const EJsonCRDTNodeType NodeType = static_cast<EJsonCRDTNodeType>(Type);
+	if ((NodeType != EJsonCRDTNodeType::Array && NodeType != EJsonCRDTNodeType::Object) || !ReadContainerHeader(Cursor, End, Count, PayloadSize))
+	{
+		return false;
+	}
+
+	if (NodeType == EJsonCRDTNodeType::Array)
+	{
+		const int32 ArrayIndex = Path.GetArrayIndex(TokenIndex);
+		if (ArrayIndex < 0 || ArrayIndex >= Count)
+		{
+			return false;
+		}
+		for (int32 i = 0; i < ArrayIndex; ++i)
+		{
+			if (!SkipNode(Cursor))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// 파일에 없는 키면 읽지 않고 바로 실패
+	const int32* KeyIndex = KeyIndices.Find(Path.GetToken(TokenIndex));
+	if (!KeyIndex)
+	{
+		return false;
+	}
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		uint64 ChildKey;
+		if (!ReadVarUInt(Cursor, End, ChildKey))
+		{
+			return false;
+		}
+		if (ChildKey == static_cast<uint64>(*KeyIndex))
+		{
+			return true;
+		}
+		if (!SkipNode(Cursor))
+		{
+			return false;
+		}
+	}
+	return false;
+}
+
+bool FJsonCRDTBinaryDocument::GetValueAtPath(const FJsonCRDTPath& Path, FString& OutValue) const
+{
+	if (!IsOpen())
+	{
+		return false;
+	}
+
+	const uint8* Cursor = Root;
+	for (int32 i = 0; i < Path.Num(); ++i)
+	{
+		if (!FindChild(Cursor, Path, i))
+		{
+			return false;
+		}
+	}
+
+	// 대상 서브트리만 임시 저장소로 디코딩해 기존 직렬화 경로를 그대로 사용
+	FJsonCRDTNodeStore Subtree;
+	TArray<int32> StoreKeys;
+	StoreKeys.Init(INDEX_NONE, Keys.Num());
+	const int32 NodeIndex = DecodeNode(Cursor, 0, Subtree, StoreKeys, 0);
+	if (NodeIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	OutValue = Subtree.NodeToString(NodeIndex);
+	return true;
+}
+
+bool FJsonCRDTBinaryDocument::DecodeContent(FJsonCRDTNodeStore& OutStore) const
+{
+	if (!IsOpen())
+	{
+		return false;
+	}
+
+	FJsonCRDTNodeStore Loaded;
+	TArray<int32> StoreKeys;
+	StoreKeys.Init(INDEX_NONE, Keys.Num());
+
+	const uint8* Cursor = Root;
+	const int32 NewRoot = DecodeNode(Cursor, 0, Loaded, StoreKeys, 0);
+	if (NewRoot == INDEX_NONE || Loaded.Nodes[NewRoot].Type != EJsonCRDTNodeType::Object)
+	{
+		return false;
+	}
+
+	Loaded.FreeSubtree(Loaded.RootIndex);
+	Loaded.RootIndex = NewRoot;
+
+	OutStore = MoveTemp(Loaded);
+	return true;
+}
+
+int32 FJsonCRDTBinaryDocument::DecodeNode(const uint8*& Cursor, int64 ParentTimestamp, FJsonCRDTNodeStore& Store, TArray<int32>& StoreKeys, int32 Depth) const
+{
+	using namespace JsonCRDTBinaryDocument;
+
+	uint8 Type;
+	int64 TimestampDelta;
+	if (Depth > MaxDepth || !ReadByte(Cursor, End, Type) || !ReadVarInt(Cursor, End, TimestampDelta))
+	{
+		return INDEX_NONE;
+	}
+	const int64 Timestamp = ParentTimestamp + TimestampDelta;
+
+	FJsonCRDTScalar Scalar;
+	switch (static_cast<EJsonCRDTNodeType>(Type))
+	{
+	case EJsonCRDTNodeType::Null:
+		return Store.AllocateScalar(Scalar, Timestamp);
+
+	case EJsonCRDTNodeType::Boolean:
+	{
+		uint8 Value;
+		if (!ReadByte(Cursor, End, Value))
+		{
+			return INDEX_NONE;
+		}
+		Scalar.Type = EJsonCRDTNodeType::Boolean;
+		Scalar.bBoolValue = Value != 0;
+		return Store.AllocateScalar(Scalar, Timestamp);
+	}
+
+	case EJsonCRDTNodeType::Number:
+	{
+		if (End - Cursor < 8)
+		{
+			return INDEX_NONE;
+		}
+		const uint64 Bits = ReadFixed(Cursor, 8);
+		Cursor += 8;
+		Scalar.Type = EJsonCRDTNodeType::Number;
+		FMemory::Memcpy(&Scalar.NumberValue, &Bits, sizeof(Bits));
+		return Store.AllocateScalar(Scalar, Timestamp);
+	}
+
+	case EJsonCRDTNodeType::String:
+		Scalar.Type = EJsonCRDTNodeType::String;
+		if (!ReadString(Cursor, End, Scalar.StringValue))
+		{
+			return INDEX_NONE;
+		}
+		return Store.AllocateScalar(Scalar, Timestamp);
+
+	case EJsonCRDTNodeType::Array:
+	case EJsonCRDTNodeType::Object:
+	{
+		int32 Count;
+		uint32 PayloadSize;
+		if (!ReadContainerHeader(Cursor, End, Count, PayloadSize))
+		{
+			return INDEX_NONE;
+		}
+
+		const bool bObject = static_cast<EJsonCRDTNodeType>(Type) == EJsonCRDTNodeType::Object;
+		const int32 Container = Store.AllocateNode(static_cast<EJsonCRDTNodeType>(Type), Timestamp);
+		Store.ReserveChildren(Container, Count);
+
+		for (int32 i = 0; i < Count; ++i)
+		{
+			int32 StoreKey = INDEX_NONE;
+			if (bObject)
+			{
+				uint64 FileKey;
+				if (!ReadVarUInt(Cursor, End, FileKey) || FileKey >= static_cast<uint64>(Keys.Num()))
+				{
+					Store.FreeSubtree(Container);
+					return INDEX_NONE;
+				}
+
+				int32& MappedKey = StoreKeys[static_cast<int32>(FileKey)];
+				if (MappedKey == INDEX_NONE)
+				{
+					MappedKey = Store.InternKey(Keys[static_cast<int32>(FileKey)]);
+				}
+				StoreKey = MappedKey;
+			}
+
+			const int32 Child = DecodeNode(Cursor, Timestamp, Store, StoreKeys, Depth + 1);
+			if (Child == INDEX_NONE)
+			{
+				Store.FreeSubtree(Container);
+				return INDEX_NONE;
+			}
+
+			// 저장할 때 키가 이미 중복 없이 정리되어 있으므로 그대로 연결
+			// (자식 할당으로 배열이 다시 할당될 수 있어 참조는 매번 새로 얻음, 자식 목록은 미리 확보했으므로 크기 변화 없음)
+			Store.Nodes[Child].Parent = Container;
+			FJsonCRDTNode& ContainerNode = Store.Nodes[Container];
+			ContainerNode.Children.Add(Child);
+			if (bObject)
+			{
+				ContainerNode.ChildKeys.Add(StoreKey);
+				Store.FieldNodes.Add(FJsonCRDTNodeStore::MakeFieldKey(Container, StoreKey), Child);
+			}
+		}
+		return Container;
+	}
+
+	default:
+		return INDEX_NONE;
+	}
+}
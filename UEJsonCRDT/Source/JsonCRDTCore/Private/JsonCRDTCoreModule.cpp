@@ -0,0 +1,5 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, JsonCRDTCore)
@@ -0,0 +1,217 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "JsonCRDTDocumentCore.h"
+#include "JsonCRDTOperationApplier.h"
+
+FJsonCRDTDocumentCore::FJsonCRDTDocumentCore(const FString& InDocumentID)
+	: DocumentID(InDocumentID)
+	, Version(1)
+{
+}
+
+int32 FJsonCRDTDocumentCore::FindNodeAtPath(const FString& Path) const
+{
+	// 빈 경로는 RFC 6901에서 문서 전체를 가리킴 (문서 전체 구독도 루트 값을 받음)
+	if (Path.IsEmpty())
+	{
+		return Content.GetRoot();
+	}
+
+	// 경로 파싱 결과는 문서별 캐시에서 재사용 (JSON Pointer 형식: /path/to/value)
+	return Content.Resolve(*PathCache.Get(Path));
+}
+
+bool FJsonCRDTDocumentCore::GetValueAtPath(const FString& Path, FString& OutValue) const
+{
+	const int32 NodeIndex = FindNodeAtPath(Path);
+	if (NodeIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	OutValue = Content.NodeToString(NodeIndex);
+	return true;
+}
+
+FString FJsonCRDTDocumentCore::GetContentAsString() const
+{
+	return Content.ToString();
+}
+
+bool FJsonCRDTDocumentCore::SetContentFromString(const FString& JsonString)
+{
+	FJsonCRDTNodeStore NewContent;
+	if (!NewContent.LoadFromString(JsonString))
+	{
+		return false;
+	}
+
+	Content = MoveTemp(NewContent);
+	Version++;
+	return true;
+}
+
+bool FJsonCRDTDocumentCore::ApplyOperation(const FJsonCRDTOperation& Operation, TArray<FJsonCRDTOperation>* OutInverse)
+{
+	return ApplyOperationToStore(Content, Operation, OutInverse);
+}
+
+bool FJsonCRDTDocumentCore::ApplyOperationToStore(FJsonCRDTNodeStore& Store, const FJsonCRDTOperation& Operation, TArray<FJsonCRDTOperation>* OutInverse) const
+{
+	return FJsonCRDTOperationApplier::Apply(Store, Operation, PathCache, OutInverse);
+}
+
+void FJsonCRDTDocumentCore::RollbackOperations(const TArray<FJsonCRDTOperation>& InverseOperations)
+{
+	for (int32 i = InverseOperations.Num() - 1; i >= 0; --i)
+	{
+		if (!ApplyOperation(InverseOperations[i]))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to roll back operation at path: %s"), *InverseOperations[i].Path);
+		}
+	}
+}
+
+int32 FJsonCRDTDocumentCore::ApplyOperationsAtomically(TArrayView<const FJsonCRDTOperation> Operations, TArray<FJsonCRDTOperation>& OutInverse, TArray<bool, TInlineAllocator<16>>* OutCreatesValue)
+{
+	OutInverse.Reset();
+	for (int32 i = 0; i < Operations.Num(); ++i)
+	{
+		const FJsonCRDTOperation& Operation = Operations[i];
+		const int32 NumInverse = OutInverse.Num();
+		if (!ApplyOperation(Operation, &OutInverse))
+		{
+			RollbackOperations(OutInverse);
+			OutInverse.Reset();
+			return i;
+		}
+
+		// An add whose inverse is a remove created the value instead of overwriting one
+		if (OutCreatesValue)
+		{
+			OutCreatesValue->Add((Operation.Type == EJsonCRDTOperationType::Add || Operation.Type == EJsonCRDTOperationType::Copy)
+				&& OutInverse.Num() > NumInverse
+				&& OutInverse.Last().Type == EJsonCRDTOperationType::Remove);
+		}
+	}
+	return INDEX_NONE;
+}
+
+bool FJsonCRDTDocumentCore::ShouldApplyPatch(const FJsonCRDTPatch& Patch, bool& bOutResult) const
+{
+	// Validate the patch
+	if (Patch.DocumentID != DocumentID)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Patch document ID does not match: %s != %s"), *Patch.DocumentID, *DocumentID);
+		bOutResult = false;
+		return false;
+	}
+
+	// A numbered patch at or below the sender's entry in the version vector was already applied (e.g. resent during a sync)
+	const int64* KnownSequence = Patch.Sequence > 0 && !Patch.ClientID.IsEmpty() ? VersionVector.Find(Patch.ClientID) : nullptr;
+	if (KnownSequence && Patch.Sequence <= *KnownSequence)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("Skipping patch %lld from client %s for document %s, already applied"), Patch.Sequence, *Patch.ClientID, *DocumentID);
+		bOutResult = true;
+		return false;
+	}
+
+	return true;
+}
+
+void FJsonCRDTDocumentCore::RecordPatchSequence(const FJsonCRDTPatch& Patch)
+{
+	if (Patch.Sequence > 0 && !Patch.ClientID.IsEmpty())
+	{
+		int64& AppliedSequence = VersionVector.FindOrAdd(Patch.ClientID, 0);
+		AppliedSequence = FMath::Max(AppliedSequence, Patch.Sequence);
+	}
+}
+
+bool FJsonCRDTDocumentCore::ApplyLocalOperations(const TArray<FJsonCRDTOperation>& Operations)
+{
+	if (Operations.Num() == 0)
+	{
+		return true;
+	}
+
+	// Fill in timestamps before applying; the store records them on the nodes it writes
+	const FDateTime Now = FDateTime::UtcNow();
+	TArray<FJsonCRDTOperation> Applied(Operations);
+	for (FJsonCRDTOperation& Operation : Applied)
+	{
+		if (Operation.Timestamp.GetTicks() == 0)
+		{
+			Operation.Timestamp = Now;
+		}
+	}
+
+	TArray<FJsonCRDTOperation> InverseOperations;
+	const int32 FailedIndex = ApplyOperationsAtomically(Applied, InverseOperations);
+	if (FailedIndex != INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to apply local operation %d at path: %s"), FailedIndex, *Applied[FailedIndex].Path);
+		return false;
+	}
+
+	Version++;
+	for (FJsonCRDTOperation& Operation : Applied)
+	{
+		OperationHistory.Add(MoveTemp(Operation));
+	}
+	return true;
+}
+
+bool FJsonCRDTDocumentCore::ApplyPatch(const FJsonCRDTPatch& Patch)
+{
+	bool bResult;
+	if (!ShouldApplyPatch(Patch, bResult))
+	{
+		return bResult;
+	}
+
+	// The history keeps the applied operations anyway, so copy once up front and move from there
+	FJsonCRDTPatch OwnedPatch(Patch);
+	return ApplyAcceptedPatch(OwnedPatch);
+}
+
+bool FJsonCRDTDocumentCore::ApplyPatch(FJsonCRDTPatch&& Patch)
+{
+	bool bResult;
+	if (!ShouldApplyPatch(Patch, bResult))
+	{
+		return bResult;
+	}
+	return ApplyAcceptedPatch(Patch);
+}
+
+bool FJsonCRDTDocumentCore::ApplyAcceptedPatch(FJsonCRDTPatch& Patch)
+{
+	// RFC 6902: 작업 하나가 실패하면 패치 전체를 적용하지 않음
+	TArray<FJsonCRDTOperation> InverseOperations;
+	const int32 FailedIndex = ApplyOperationsAtomically(Patch.Operations, InverseOperations);
+	if (FailedIndex != INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to apply operation %d at path: %s"), FailedIndex, *Patch.Operations[FailedIndex].Path);
+		return false;
+	}
+
+	RecordPatchSequence(Patch);
+	if (Patch.Operations.Num() == 0)
+	{
+		return true;
+	}
+
+	Version++;
+	for (FJsonCRDTOperation& Operation : Patch.Operations)
+	{
+		OperationHistory.Add(MoveTemp(Operation));
+	}
+	Patch.Operations.Reset();
+	return true;
+}
+
+SIZE_T FJsonCRDTDocumentCore::GetAllocatedSize() const
+{
+	return Content.GetAllocatedSize() + OperationHistory.GetAllocatedSize();
+}
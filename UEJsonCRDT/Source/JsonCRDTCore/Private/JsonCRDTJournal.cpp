@@ -0,0 +1,74 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "JsonCRDTJournal.h"
+#include "JsonCRDTBinaryCodec.h"
+#include "Misc/Crc.h"
+
+namespace JsonCRDTJournal
+{
+	static void WriteUInt32(uint32 Value, uint8* Out)
+	{
+		Out[0] = static_cast<uint8>(Value);
+		Out[1] = static_cast<uint8>(Value >> 8);
+		Out[2] = static_cast<uint8>(Value >> 16);
+		Out[3] = static_cast<uint8>(Value >> 24);
+	}
+
+	static uint32 ReadUInt32(const uint8* In)
+	{
+		return static_cast<uint32>(In[0])
+			| (static_cast<uint32>(In[1]) << 8)
+			| (static_cast<uint32>(In[2]) << 16)
+			| (static_cast<uint32>(In[3]) << 24);
+	}
+}
+
+void FJsonCRDTJournal::AppendRecord(const FJsonCRDTPatch& Record, TArray<uint8>& OutBytes)
+{
+	using namespace JsonCRDTJournal;
+
+	// 레코드마다 새 코덱을 사용해 사전이 레코드 안에서만 유효하도록 함
+	FJsonCRDTBinaryCodec Codec;
+	TArray<uint8> Payload;
+	Codec.EncodePatch(Record, Payload);
+
+	const int32 RecordStart = OutBytes.AddUninitialized(RecordHeaderSize);
+	WriteUInt32(static_cast<uint32>(Payload.Num()), OutBytes.GetData() + RecordStart);
+	WriteUInt32(FCrc::MemCrc32(Payload.GetData(), Payload.Num()), OutBytes.GetData() + RecordStart + 4);
+	OutBytes.Append(Payload);
+}
+
+int32 FJsonCRDTJournal::ReadRecords(const TArray<uint8>& Bytes, TArray<FJsonCRDTPatch>& OutRecords)
+{
+	using namespace JsonCRDTJournal;
+
+	int32 Offset = 0;
+	while (Bytes.Num() - Offset >= RecordHeaderSize)
+	{
+		const uint32 Length = ReadUInt32(Bytes.GetData() + Offset);
+		const uint32 Crc = ReadUInt32(Bytes.GetData() + Offset + 4);
+		const int32 PayloadStart = Offset + RecordHeaderSize;
+		if (Length > static_cast<uint32>(Bytes.Num() - PayloadStart))
+		{
+			break;
+		}
+
+		const uint8* Payload = Bytes.GetData() + PayloadStart;
+		if (FCrc::MemCrc32(Payload, static_cast<int32>(Length)) != Crc)
+		{
+			break;
+		}
+
+		FJsonCRDTBinaryCodec Codec;
+		TArray<FJsonCRDTPatch> Decoded;
+		if (!Codec.DecodeFrame(Payload, static_cast<int32>(Length), Decoded) || Decoded.Num() != 1)
+		{
+			break;
+		}
+
+		OutRecords.Add(MoveTemp(Decoded[0]));
+		Offset = PayloadStart + static_cast<int32>(Length);
+	}
+
+	return Offset;
+}
@@ -0,0 +1,1076 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "JsonCRDTNodeStore.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+namespace JsonCRDTNodeStore
+{
+	/** \uXXXX 이스케이프의 16진수 4자리 해석 */
+	static bool ParseHex4(const TCHAR* Chars, uint32& OutCodePoint)
+	{
+		OutCodePoint = 0;
+		for (int32 i = 0; i < 4; ++i)
+		{
+			const TCHAR Char = Chars[i];
+			uint32 Digit;
+			if (Char >= TEXT('0') && Char <= TEXT('9'))
+			{
+				Digit = Char - TEXT('0');
+			}
+			else if (Char >= TEXT('a') && Char <= TEXT('f'))
+			{
+				Digit = Char - TEXT('a') + 10;
+			}
+			else if (Char >= TEXT('A') && Char <= TEXT('F'))
+			{
+				Digit = Char - TEXT('A') + 10;
+			}
+			else
+			{
+				return false;
+			}
+			OutCodePoint = (OutCodePoint << 4) | Digit;
+		}
+		return true;
+	}
+
+	/** 따옴표로 감싼 JSON 문자열의 이스케이프 해제 */
+	static bool UnescapeString(const TCHAR* Begin, const TCHAR* End, FString& OutString)
+	{
+		OutString.Reset(UE_PTRDIFF_TO_INT32(End - Begin));
+		for (const TCHAR* Char = Begin; Char < End; ++Char)
+		{
+			if (*Char == TEXT('"'))
+			{
+				// 이스케이프되지 않은 따옴표가 중간에 있으면 잘못된 문자열
+				return false;
+			}
+
+			if (*Char != TEXT('\\'))
+			{
+				OutString.AppendChar(*Char);
+				continue;
+			}
+
+			if (++Char >= End)
+			{
+				return false;
+			}
+
+			switch (*Char)
+			{
+			case TEXT('"'): OutString.AppendChar(TEXT('"')); break;
+			case TEXT('\\'): OutString.AppendChar(TEXT('\\')); break;
+			case TEXT('/'): OutString.AppendChar(TEXT('/')); break;
+			case TEXT('b'): OutString.AppendChar(TEXT('\b')); break;
+			case TEXT('f'): OutString.AppendChar(TEXT('\f')); break;
+			case TEXT('n'): OutString.AppendChar(TEXT('\n')); break;
+			case TEXT('r'): OutString.AppendChar(TEXT('\r')); break;
+			case TEXT('t'): OutString.AppendChar(TEXT('\t')); break;
+			case TEXT('u'):
+			{
+				uint32 CodePoint;
+				if (End - Char < 5 || !ParseHex4(Char + 1, CodePoint))
+				{
+					return false;
+				}
+				Char += 4;
+
+				// 서로게이트 쌍 결합
+				if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF && End - Char >= 7 && Char[1] == TEXT('\\') && Char[2] == TEXT('u'))
+				{
+					uint32 LowSurrogate;
+					if (ParseHex4(Char + 3, LowSurrogate) && LowSurrogate >= 0xDC00 && LowSurrogate <= 0xDFFF)
+					{
+						CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (LowSurrogate - 0xDC00);
+						Char += 6;
+					}
+				}
+
+				if (sizeof(TCHAR) == 2 && CodePoint >= 0x10000)
+				{
+					CodePoint -= 0x10000;
+					OutString.AppendChar(static_cast<TCHAR>(0xD800 + (CodePoint >> 10)));
+					OutString.AppendChar(static_cast<TCHAR>(0xDC00 + (CodePoint & 0x3FF)));
+				}
+				else
+				{
+					OutString.AppendChar(static_cast<TCHAR>(CodePoint));
+				}
+				break;
+			}
+			default:
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+FJsonCRDTNodeStore::FJsonCRDTNodeStore()
+	: RootIndex(INDEX_NONE)
+	, PayloadBytes(0)
+{
+	Reset();
+}
+
+void FJsonCRDTNodeStore::Reset()
+{
+	Nodes.Empty();
+	Strings.Empty();
+	Keys.Empty();
+	KeyIndices.Empty();
+	FieldNodes.Empty();
+	PayloadBytes = 0;
+	RootIndex = AllocateNode(EJsonCRDTNodeType::Object, 0);
+}
+
+bool FJsonCRDTNodeStore::LoadFromString(const FString& JsonString)
+{
+	FJsonCRDTNodeStore Loaded;
+	const int32 NewRoot = Loaded.ParseContainer(JsonString, 0);
+	if (NewRoot == INDEX_NONE)
+	{
+		return false;
+	}
+
+	if (Loaded.Nodes[NewRoot].Type != EJsonCRDTNodeType::Object)
+	{
+		return false;
+	}
+
+	Loaded.FreeSubtree(Loaded.RootIndex);
+	Loaded.RootIndex = NewRoot;
+
+	*this = MoveTemp(Loaded);
+	return true;
+}
+
+bool FJsonCRDTNodeStore::LoadFromJsonObject(const TSharedPtr<FJsonObject>& JsonObject)
+{
+	if (!JsonObject.IsValid())
+	{
+		return false;
+	}
+
+	FJsonCRDTNodeStore Loaded;
+	const int32 NewRoot = Loaded.ImportValue(MakeShared<FJsonValueObject>(JsonObject));
+	Loaded.FreeSubtree(Loaded.RootIndex);
+	Loaded.RootIndex = NewRoot;
+
+	*this = MoveTemp(Loaded);
+	return true;
+}
+
+int32 FJsonCRDTNodeStore::ParseValue(const FString& JsonString, int64 Timestamp)
+{
+	// 대부분의 작업 값은 스칼라이므로 토큰 리더를 거치지 않고 직접 파싱
+	FJsonCRDTScalar Scalar;
+	if (ParseScalar(JsonString, Scalar))
+	{
+		return AllocateScalar(Scalar, Timestamp);
+	}
+
+	return ParseContainer(JsonString, Timestamp);
+}
+
+int32 FJsonCRDTNodeStore::ParseContainer(const FString& JsonString, int64 Timestamp)
+{
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+
+	TArray<int32, TInlineAllocator<16>> Stack;
+	int32 Result = INDEX_NONE;
+	bool bFailed = false;
+
+	EJsonNotation Notation;
+	while (!bFailed && Reader->ReadNext(Notation))
+	{
+		int32 NewNode = INDEX_NONE;
+		switch (Notation)
+		{
+		case EJsonNotation::ObjectStart:
+			NewNode = AllocateNode(EJsonCRDTNodeType::Object, Timestamp);
+			break;
+
+		case EJsonNotation::ArrayStart:
+			NewNode = AllocateNode(EJsonCRDTNodeType::Array, Timestamp);
+			break;
+
+		case EJsonNotation::ObjectEnd:
+		case EJsonNotation::ArrayEnd:
+			if (Stack.Num() == 0)
+			{
+				bFailed = true;
+			}
+			else
+			{
+				Stack.Pop();
+			}
+			continue;
+
+		case EJsonNotation::String:
+			NewNode = AllocateNode(EJsonCRDTNodeType::String, Timestamp);
+			Nodes[NewNode].StringIndex = AddString(Reader->GetValueAsString());
+			break;
+
+		case EJsonNotation::Number:
+			NewNode = AllocateNode(EJsonCRDTNodeType::Number, Timestamp);
+			Nodes[NewNode].NumberValue = Reader->GetValueAsNumber();
+			break;
+
+		case EJsonNotation::Boolean:
+			NewNode = AllocateNode(EJsonCRDTNodeType::Boolean, Timestamp);
+			Nodes[NewNode].bBoolValue = Reader->GetValueAsBoolean();
+			break;
+
+		case EJsonNotation::Null:
+			NewNode = AllocateNode(EJsonCRDTNodeType::Null, Timestamp);
+			break;
+
+		default:
+			bFailed = true;
+			continue;
+		}
+
+		if (Stack.Num() == 0)
+		{
+			if (Result != INDEX_NONE)
+			{
+				// 루트 값이 둘 이상
+				FreeSubtree(NewNode);
+				bFailed = true;
+				continue;
+			}
+			Result = NewNode;
+		}
+		else
+		{
+			const int32 ContainerIndex = Stack.Top();
+			const int32 KeyIndex = Nodes[ContainerIndex].Type == EJsonCRDTNodeType::Object ? InternKey(Reader->GetIdentifier()) : INDEX_NONE;
+			AppendChild(ContainerIndex, KeyIndex, NewNode);
+		}
+
+		if (Nodes[NewNode].IsContainer())
+		{
+			Stack.Push(NewNode);
+		}
+	}
+
+	if (bFailed || Stack.Num() > 0 || !Reader->GetErrorMessage().IsEmpty())
+	{
+		if (Result != INDEX_NONE)
+		{
+			FreeSubtree(Result);
+		}
+		return INDEX_NONE;
+	}
+
+	return Result;
+}
+
+int32 FJsonCRDTNodeStore::ImportValue(const TSharedPtr<FJsonValue>& Value, int64 Timestamp)
+{
+	if (!Value.IsValid())
+	{
+		return AllocateNode(EJsonCRDTNodeType::Null, Timestamp);
+	}
+
+	int32 NewNode = INDEX_NONE;
+	switch (Value->Type)
+	{
+	case EJson::String:
+		NewNode = AllocateNode(EJsonCRDTNodeType::String, Timestamp);
+		Nodes[NewNode].StringIndex = AddString(Value->AsString());
+		break;
+
+	case EJson::Number:
+		NewNode = AllocateNode(EJsonCRDTNodeType::Number, Timestamp);
+		Nodes[NewNode].NumberValue = Value->AsNumber();
+		break;
+
+	case EJson::Boolean:
+		NewNode = AllocateNode(EJsonCRDTNodeType::Boolean, Timestamp);
+		Nodes[NewNode].bBoolValue = Value->AsBool();
+		break;
+
+	case EJson::Array:
+	{
+		NewNode = AllocateNode(EJsonCRDTNodeType::Array, Timestamp);
+		const TArray<TSharedPtr<FJsonValue>>& Array = Value->AsArray();
+		ReserveChildren(NewNode, Array.Num());
+		for (const TSharedPtr<FJsonValue>& Element : Array)
+		{
+			AppendChild(NewNode, INDEX_NONE, ImportValue(Element, Timestamp));
+		}
+		break;
+	}
+
+	case EJson::Object:
+	{
+		NewNode = AllocateNode(EJsonCRDTNodeType::Object, Timestamp);
+		const TSharedPtr<FJsonObject>& Object = Value->AsObject();
+		if (Object.IsValid())
+		{
+			ReserveChildren(NewNode, Object->Values.Num());
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object->Values)
+			{
+				AppendChild(NewNode, InternKey(Field.Key), ImportValue(Field.Value, Timestamp));
+			}
+		}
+		break;
+	}
+
+	default:
+		NewNode = AllocateNode(EJsonCRDTNodeType::Null, Timestamp);
+		break;
+	}
+
+	return NewNode;
+}
+
+bool FJsonCRDTNodeStore::Add(const FJsonCRDTPath& Path, int32 ValueNode)
+{
+	if (!Nodes.IsValidIndex(ValueNode))
+	{
+		return false;
+	}
+
+	if (!AttachAtPath(Path, ValueNode))
+	{
+		FreeSubtree(ValueNode);
+		return false;
+	}
+	return true;
+}
+
+bool FJsonCRDTNodeStore::Remove(const FJsonCRDTPath& Path)
+{
+	const int32 Target = Resolve(Path);
+	if (Target == INDEX_NONE || Target == RootIndex)
+	{
+		return false;
+	}
+
+	int32 Slot;
+	int32 KeyIndex;
+	DetachNode(Target, Slot, KeyIndex);
+	FreeSubtree(Target);
+	return true;
+}
+
+bool FJsonCRDTNodeStore::Replace(const FJsonCRDTPath& Path, int32 ValueNode)
+{
+	if (!Nodes.IsValidIndex(ValueNode))
+	{
+		return false;
+	}
+
+	const int32 Target = Resolve(Path);
+	if (Target == INDEX_NONE)
+	{
+		FreeSubtree(ValueNode);
+		return false;
+	}
+
+	if (Target == RootIndex)
+	{
+		if (!ReplaceRoot(ValueNode))
+		{
+			FreeSubtree(ValueNode);
+			return false;
+		}
+		return true;
+	}
+
+	// 부모의 같은 위치에 새 노드를 연결하고 기존 서브트리 해제
+	const int32 ParentIndex = Nodes[Target].Parent;
+	FJsonCRDTNode& Parent = Nodes[ParentIndex];
+	const int32 Slot = Parent.Children.Find(Target);
+	Parent.Children[Slot] = ValueNode;
+	if (Parent.Type == EJsonCRDTNodeType::Object)
+	{
+		FieldNodes.Add(MakeFieldKey(ParentIndex, Parent.ChildKeys[Slot]), ValueNode);
+	}
+	Nodes[ValueNode].Parent = ParentIndex;
+	FreeSubtree(Target);
+	return true;
+}
+
+bool FJsonCRDTNodeStore::Move(const FJsonCRDTPath& From, const FJsonCRDTPath& Path, int64 Timestamp)
+{
+	const int32 Source = Resolve(From);
+	if (Source == INDEX_NONE || Source == RootIndex)
+	{
+		return false;
+	}
+
+	// 자기 자신의 하위 경로로는 이동할 수 없음
+	if (From.Num() < Path.Num())
+	{
+		bool bIsPrefix = true;
+		for (int32 i = 0; i < From.Num() && bIsPrefix; ++i)
+		{
+			bIsPrefix = From.GetToken(i).Equals(Path.GetToken(i), ESearchCase::CaseSensitive);
+		}
+		if (bIsPrefix)
+		{
+			return false;
+		}
+	}
+
+	// 원본을 먼저 분리한 뒤 대상 경로를 해석 (RFC 6902의 remove 후 add 순서)
+	int32 Slot;
+	int32 KeyIndex;
+	const int32 OldParent = DetachNode(Source, Slot, KeyIndex);
+	if (!AttachAtPath(Path, Source))
+	{
+		InsertChild(OldParent, Slot, KeyIndex, Source);
+		return false;
+	}
+
+	Nodes[Source].Timestamp = Timestamp;
+	return true;
+}
+
+bool FJsonCRDTNodeStore::Copy(const FJsonCRDTPath& From, const FJsonCRDTPath& Path, int64 Timestamp)
+{
+	const int32 Source = Resolve(From);
+	if (Source == INDEX_NONE)
+	{
+		return false;
+	}
+
+	return Add(Path, CloneSubtree(Source, Timestamp));
+}
+
+bool FJsonCRDTNodeStore::Test(const FJsonCRDTPath& Path, int32 ValueNode) const
+{
+	const int32 Target = Resolve(Path);
+	return Target != INDEX_NONE && Nodes.IsValidIndex(ValueNode) && NodesEqual(Target, ValueNode);
+}
+
+bool FJsonCRDTNodeStore::SetScalar(int32 NodeIndex, const FJsonCRDTScalar& Scalar, int64 Timestamp)
+{
+	if (!Nodes.IsValidIndex(NodeIndex))
+	{
+		return false;
+	}
+
+	FJsonCRDTNode& Node = Nodes[NodeIndex];
+	if (Node.IsContainer() || Scalar.Type == EJsonCRDTNodeType::Array || Scalar.Type == EJsonCRDTNodeType::Object)
+	{
+		return false;
+	}
+
+	if (Scalar.Type == EJsonCRDTNodeType::String)
+	{
+		// 기존 문자열 슬롯이 있으면 재사용
+		if (Node.Type == EJsonCRDTNodeType::String)
+		{
+			FString& String = Strings[Node.StringIndex];
+			PayloadBytes -= String.GetAllocatedSize();
+			String = Scalar.StringValue;
+			PayloadBytes += String.GetAllocatedSize();
+		}
+		else
+		{
+			Node.StringIndex = AddString(CopyTemp(Scalar.StringValue));
+		}
+	}
+	else
+	{
+		if (Node.Type == EJsonCRDTNodeType::String)
+		{
+			RemoveString(Node.StringIndex);
+		}
+
+		if (Scalar.Type == EJsonCRDTNodeType::Boolean)
+		{
+			Node.bBoolValue = Scalar.bBoolValue;
+		}
+		else
+		{
+			Node.NumberValue = Scalar.NumberValue;
+		}
+	}
+
+	Node.Type = Scalar.Type;
+	Node.Timestamp = Timestamp;
+	return true;
+}
+
+bool FJsonCRDTNodeStore::NodesEqual(int32 NodeA, int32 NodeB) const
+{
+	const FJsonCRDTNode& A = Nodes[NodeA];
+	const FJsonCRDTNode& B = Nodes[NodeB];
+	if (A.Type != B.Type)
+	{
+		return false;
+	}
+
+	switch (A.Type)
+	{
+	case EJsonCRDTNodeType::Boolean:
+		return A.bBoolValue == B.bBoolValue;
+
+	case EJsonCRDTNodeType::Number:
+		return A.NumberValue == B.NumberValue;
+
+	case EJsonCRDTNodeType::String:
+		return Strings[A.StringIndex].Equals(Strings[B.StringIndex], ESearchCase::CaseSensitive);
+
+	case EJsonCRDTNodeType::Array:
+		if (A.Children.Num() != B.Children.Num())
+		{
+			return false;
+		}
+		for (int32 i = 0; i < A.Children.Num(); ++i)
+		{
+			if (!NodesEqual(A.Children[i], B.Children[i]))
+			{
+				return false;
+			}
+		}
+		return true;
+
+	case EJsonCRDTNodeType::Object:
+		if (A.Children.Num() != B.Children.Num())
+		{
+			return false;
+		}
+		// 키는 같은 저장소에서 인터닝되므로 인덱스 비교로 충분 (필드 순서는 무시)
+		for (int32 i = 0; i < A.Children.Num(); ++i)
+		{
+			const int32 BChild = FindField(NodeB, A.ChildKeys[i]);
+			if (BChild == INDEX_NONE || !NodesEqual(A.Children[i], BChild))
+			{
+				return false;
+			}
+		}
+		return true;
+
+	default:
+		return true;
+	}
+}
+
+int32 FJsonCRDTNodeStore::CloneSubtree(int32 NodeIndex, int64 Timestamp)
+{
+	const EJsonCRDTNodeType Type = Nodes[NodeIndex].Type;
+	const int32 NewNode = AllocateNode(Type, Timestamp);
+
+	// AllocateNode 이후에는 노드 참조가 무효화될 수 있으므로 인덱스로 다시 접근
+	switch (Type)
+	{
+	case EJsonCRDTNodeType::Boolean:
+		Nodes[NewNode].bBoolValue = Nodes[NodeIndex].bBoolValue;
+		break;
+
+	case EJsonCRDTNodeType::Number:
+		Nodes[NewNode].NumberValue = Nodes[NodeIndex].NumberValue;
+		break;
+
+	case EJsonCRDTNodeType::String:
+	{
+		FString StringValue = Strings[Nodes[NodeIndex].StringIndex];
+		Nodes[NewNode].StringIndex = AddString(MoveTemp(StringValue));
+		break;
+	}
+
+	case EJsonCRDTNodeType::Array:
+	case EJsonCRDTNodeType::Object:
+	{
+		const int32 NumChildren = Nodes[NodeIndex].Children.Num();
+		ReserveChildren(NewNode, NumChildren);
+
+		for (int32 i = 0; i < NumChildren; ++i)
+		{
+			const int32 ChildClone = CloneSubtree(Nodes[NodeIndex].Children[i], Timestamp);
+			const int32 KeyIndex = Type == EJsonCRDTNodeType::Object ? Nodes[NodeIndex].ChildKeys[i] : INDEX_NONE;
+			InsertChild(NewNode, i, KeyIndex, ChildClone);
+		}
+		break;
+	}
+
+	default:
+		break;
+	}
+
+	return NewNode;
+}
+
+void FJsonCRDTNodeStore::ReleaseNode(int32 NodeIndex)
+{
+	if (Nodes.IsValidIndex(NodeIndex))
+	{
+		FreeSubtree(NodeIndex);
+	}
+}
+
+TSharedPtr<FJsonObject> FJsonCRDTNodeStore::ToJsonObject() const
+{
+	return ToJsonValue(RootIndex)->AsObject();
+}
+
+TSharedPtr<FJsonValue> FJsonCRDTNodeStore::ToJsonValue(int32 NodeIndex) const
+{
+	const FJsonCRDTNode& Node = Nodes[NodeIndex];
+	switch (Node.Type)
+	{
+	case EJsonCRDTNodeType::Boolean:
+		return MakeShared<FJsonValueBoolean>(Node.bBoolValue);
+
+	case EJsonCRDTNodeType::Number:
+		return MakeShared<FJsonValueNumber>(Node.NumberValue);
+
+	case EJsonCRDTNodeType::String:
+		return MakeShared<FJsonValueString>(Strings[Node.StringIndex]);
+
+	case EJsonCRDTNodeType::Array:
+	{
+		TArray<TSharedPtr<FJsonValue>> Array;
+		Array.Reserve(Node.Children.Num());
+		for (int32 ChildIndex : Node.Children)
+		{
+			Array.Add(ToJsonValue(ChildIndex));
+		}
+		return MakeShared<FJsonValueArray>(Array);
+	}
+
+	case EJsonCRDTNodeType::Object:
+	{
+		TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+		for (int32 i = 0; i < Node.Children.Num(); ++i)
+		{
+			Object->SetField(Keys[Node.ChildKeys[i]], ToJsonValue(Node.Children[i]));
+		}
+		return MakeShared<FJsonValueObject>(Object);
+	}
+
+	default:
+		return MakeShared<FJsonValueNull>();
+	}
+}
+
+FString FJsonCRDTNodeStore::ToString() const
+{
+	FString OutputString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+	WriteNode(RootIndex, Writer);
+	Writer->Close();
+	return OutputString;
+}
+
+FString FJsonCRDTNodeStore::NodeToString(int32 NodeIndex) const
+{
+	FString OutputString;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutputString);
+	WriteNode(NodeIndex, Writer);
+	Writer->Close();
+	return OutputString;
+}
+
+int32 FJsonCRDTNodeStore::ResolvePrefix(const FJsonCRDTPath& Path, int32 NumTokens) const
+{
+	int32 Current = RootIndex;
+	for (int32 i = 0; i < NumTokens && Current != INDEX_NONE; ++i)
+	{
+		Current = FindChild(Current, Path, i);
+	}
+	return Current;
+}
+
+int32 FJsonCRDTNodeStore::FindChild(int32 ContainerIndex, const FJsonCRDTPath& Path, int32 TokenIndex) const
+{
+	const FJsonCRDTNode& Container = Nodes[ContainerIndex];
+
+	if (Container.Type == EJsonCRDTNodeType::Object)
+	{
+		const int32 KeyIndex = FindKey(Path.GetToken(TokenIndex));
+		if (KeyIndex == INDEX_NONE)
+		{
+			return INDEX_NONE;
+		}
+
+		return FindField(ContainerIndex, KeyIndex);
+	}
+
+	if (Container.Type == EJsonCRDTNodeType::Array)
+	{
+		const int32 ArrayIndex = Path.GetArrayIndex(TokenIndex);
+		return Container.Children.IsValidIndex(ArrayIndex) ? Container.Children[ArrayIndex] : INDEX_NONE;
+	}
+
+	return INDEX_NONE;
+}
+
+FString FJsonCRDTNodeStore::BuildPath(int32 NodeIndex) const
+{
+	TArray<FString, TInlineAllocator<8>> Tokens;
+	for (int32 Current = NodeIndex; Current != RootIndex; )
+	{
+		const int32 ParentIndex = Nodes[Current].Parent;
+		if (ParentIndex == INDEX_NONE)
+		{
+			break;
+		}
+
+		const FJsonCRDTNode& Parent = Nodes[ParentIndex];
+		const int32 Slot = Parent.Children.Find(Current);
+		if (Parent.Type == EJsonCRDTNodeType::Object)
+		{
+			FString Token = Keys[Parent.ChildKeys[Slot]];
+			Token.ReplaceInline(TEXT("~"), TEXT("~0"), ESearchCase::CaseSensitive);
+			Token.ReplaceInline(TEXT("/"), TEXT("~1"), ESearchCase::CaseSensitive);
+			Tokens.Add(MoveTemp(Token));
+		}
+		else
+		{
+			Tokens.Add(FString::FromInt(Slot));
+		}
+
+		Current = ParentIndex;
+	}
+
+	FString Path;
+	for (int32 i = Tokens.Num() - 1; i >= 0; --i)
+	{
+		Path += TEXT("/");
+		Path += Tokens[i];
+	}
+	return Path;
+}
+
+int32 FJsonCRDTNodeStore::FindKey(const FString& Key) const
+{
+	const int32* KeyIndex = KeyIndices.Find(Key);
+	return KeyIndex ? *KeyIndex : INDEX_NONE;
+}
+
+int32 FJsonCRDTNodeStore::InternKey(const FString& Key)
+{
+	if (const int32* KeyIndex = KeyIndices.Find(Key))
+	{
+		return *KeyIndex;
+	}
+
+	const int32 NewIndex = Keys.Add(Key);
+	KeyIndices.Add(Key, NewIndex);
+	PayloadBytes += Keys[NewIndex].GetAllocatedSize();
+	return NewIndex;
+}
+
+SIZE_T FJsonCRDTNodeStore::GetAllocatedSize() const
+{
+	return Nodes.GetAllocatedSize() + Strings.GetAllocatedSize() + Keys.GetAllocatedSize() + KeyIndices.GetAllocatedSize() + FieldNodes.GetAllocatedSize() + PayloadBytes;
+}
+
+bool FJsonCRDTNodeStore::ParseScalar(const FString& JsonString, FJsonCRDTScalar& OutScalar)
+{
+	const TCHAR* Begin = *JsonString;
+	const TCHAR* End = Begin + JsonString.Len();
+
+	// 앞뒤 공백 제거
+	while (Begin < End && FChar::IsWhitespace(*Begin))
+	{
+		++Begin;
+	}
+	while (End > Begin && FChar::IsWhitespace(End[-1]))
+	{
+		--End;
+	}
+
+	const int32 Length = UE_PTRDIFF_TO_INT32(End - Begin);
+	if (Length == 0)
+	{
+		return false;
+	}
+
+	switch (*Begin)
+	{
+	case TEXT('n'):
+		if (Length == 4 && FCString::Strncmp(Begin, TEXT("null"), 4) == 0)
+		{
+			OutScalar.Type = EJsonCRDTNodeType::Null;
+			return true;
+		}
+		return false;
+
+	case TEXT('t'):
+		if (Length == 4 && FCString::Strncmp(Begin, TEXT("true"), 4) == 0)
+		{
+			OutScalar.Type = EJsonCRDTNodeType::Boolean;
+			OutScalar.bBoolValue = true;
+			return true;
+		}
+		return false;
+
+	case TEXT('f'):
+		if (Length == 5 && FCString::Strncmp(Begin, TEXT("false"), 5) == 0)
+		{
+			OutScalar.Type = EJsonCRDTNodeType::Boolean;
+			OutScalar.bBoolValue = false;
+			return true;
+		}
+		return false;
+
+	case TEXT('"'):
+		if (Length >= 2 && End[-1] == TEXT('"') && JsonCRDTNodeStore::UnescapeString(Begin + 1, End - 1, OutScalar.StringValue))
+		{
+			OutScalar.Type = EJsonCRDTNodeType::String;
+			return true;
+		}
+		return false;
+
+	default:
+		break;
+	}
+
+	if (*Begin != TEXT('-') && !FChar::IsDigit(*Begin))
+	{
+		return false;
+	}
+
+	// 숫자 문법 검사 (JSON은 16진수, NaN, Infinity 등을 허용하지 않음)
+	for (const TCHAR* Char = Begin; Char < End; ++Char)
+	{
+		if (!FChar::IsDigit(*Char) && *Char != TEXT('-') && *Char != TEXT('+') && *Char != TEXT('.') && *Char != TEXT('e') && *Char != TEXT('E'))
+		{
+			return false;
+		}
+	}
+
+	TCHAR* ParseEnd = nullptr;
+	const double Number = FCString::Strtod(Begin, &ParseEnd);
+	if (ParseEnd != End)
+	{
+		return false;
+	}
+
+	OutScalar.Type = EJsonCRDTNodeType::Number;
+	OutScalar.NumberValue = Number;
+	return true;
+}
+
+int32 FJsonCRDTNodeStore::AllocateNode(EJsonCRDTNodeType Type, int64 Timestamp)
+{
+	FJsonCRDTNode Node;
+	Node.Type = Type;
+	Node.Timestamp = Timestamp;
+	return Nodes.Add(MoveTemp(Node));
+}
+
+int32 FJsonCRDTNodeStore::AllocateScalar(const FJsonCRDTScalar& Scalar, int64 Timestamp)
+{
+	const int32 NewNode = AllocateNode(Scalar.Type, Timestamp);
+	switch (Scalar.Type)
+	{
+	case EJsonCRDTNodeType::Boolean:
+		Nodes[NewNode].bBoolValue = Scalar.bBoolValue;
+		break;
+
+	case EJsonCRDTNodeType::Number:
+		Nodes[NewNode].NumberValue = Scalar.NumberValue;
+		break;
+
+	case EJsonCRDTNodeType::String:
+		Nodes[NewNode].StringIndex = AddString(CopyTemp(Scalar.StringValue));
+		break;
+
+	default:
+		break;
+	}
+	return NewNode;
+}
+
+void FJsonCRDTNodeStore::FreeSubtree(int32 NodeIndex)
+{
+	TArray<int32, TInlineAllocator<16>> Pending;
+	Pending.Add(NodeIndex);
+
+	while (Pending.Num() > 0)
+	{
+		const int32 Current = Pending.Pop();
+		if (!Nodes.IsValidIndex(Current))
+		{
+			continue;
+		}
+
+		FJsonCRDTNode& Node = Nodes[Current];
+		Pending.Append(Node.Children);
+		if (Node.Type == EJsonCRDTNodeType::Object)
+		{
+			// 해제된 노드 인덱스는 재사용되므로 색인에서도 제거
+			for (const int32 KeyIndex : Node.ChildKeys)
+			{
+				FieldNodes.Remove(MakeFieldKey(Current, KeyIndex));
+			}
+		}
+		if (Node.Type == EJsonCRDTNodeType::String && Strings.IsValidIndex(Node.StringIndex))
+		{
+			RemoveString(Node.StringIndex);
+		}
+		PayloadBytes -= GetChildListSize(Node);
+		Nodes.RemoveAt(Current);
+	}
+}
+
+void FJsonCRDTNodeStore::AppendChild(int32 ContainerIndex, int32 KeyIndex, int32 ChildIndex)
+{
+	Nodes[ChildIndex].Parent = ContainerIndex;
+
+	FJsonCRDTNode& Container = Nodes[ContainerIndex];
+	const SIZE_T ChildListSize = GetChildListSize(Container);
+	if (Container.Type == EJsonCRDTNodeType::Object)
+	{
+		// 중복 키는 마지막 값이 우선 (FJsonObject와 같은 동작)
+		int32& FieldNode = FieldNodes.FindOrAdd(MakeFieldKey(ContainerIndex, KeyIndex), INDEX_NONE);
+		if (FieldNode != INDEX_NONE)
+		{
+			const int32 Replaced = FieldNode;
+			Container.Children[Container.Children.Find(Replaced)] = ChildIndex;
+			FieldNode = ChildIndex;
+			FreeSubtree(Replaced);
+			return;
+		}
+		FieldNode = ChildIndex;
+		Container.ChildKeys.Add(KeyIndex);
+	}
+	Container.Children.Add(ChildIndex);
+	PayloadBytes = PayloadBytes - ChildListSize + GetChildListSize(Container);
+}
+
+void FJsonCRDTNodeStore::InsertChild(int32 ContainerIndex, int32 Slot, int32 KeyIndex, int32 ChildIndex)
+{
+	Nodes[ChildIndex].Parent = ContainerIndex;
+
+	FJsonCRDTNode& Container = Nodes[ContainerIndex];
+	const SIZE_T ChildListSize = GetChildListSize(Container);
+	Container.Children.Insert(ChildIndex, Slot);
+	if (Container.Type == EJsonCRDTNodeType::Object)
+	{
+		Container.ChildKeys.Insert(KeyIndex, Slot);
+		FieldNodes.Add(MakeFieldKey(ContainerIndex, KeyIndex), ChildIndex);
+	}
+	PayloadBytes = PayloadBytes - ChildListSize + GetChildListSize(Container);
+}
+
+void FJsonCRDTNodeStore::ReserveChildren(int32 ContainerIndex, int32 NumChildren)
+{
+	FJsonCRDTNode& Container = Nodes[ContainerIndex];
+	const SIZE_T ChildListSize = GetChildListSize(Container);
+	Container.Children.Reserve(NumChildren);
+	if (Container.Type == EJsonCRDTNodeType::Object)
+	{
+		Container.ChildKeys.Reserve(NumChildren);
+	}
+	PayloadBytes = PayloadBytes - ChildListSize + GetChildListSize(Container);
+}
+
+int32 FJsonCRDTNodeStore::AddString(FString&& Value)
+{
+	PayloadBytes += Value.GetAllocatedSize();
+	return Strings.Add(MoveTemp(Value));
+}
+
+void FJsonCRDTNodeStore::RemoveString(int32 StringIndex)
+{
+	PayloadBytes -= Strings[StringIndex].GetAllocatedSize();
+	Strings.RemoveAt(StringIndex);
+}
+
+int32 FJsonCRDTNodeStore::DetachNode(int32 NodeIndex, int32& OutSlot, int32& OutKeyIndex)
+{
+	OutSlot = INDEX_NONE;
+	OutKeyIndex = INDEX_NONE;
+
+	const int32 ParentIndex = Nodes[NodeIndex].Parent;
+	if (ParentIndex == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	FJsonCRDTNode& Parent = Nodes[ParentIndex];
+	const SIZE_T ChildListSize = GetChildListSize(Parent);
+	OutSlot = Parent.Children.Find(NodeIndex);
+	Parent.Children.RemoveAt(OutSlot);
+	if (Parent.Type == EJsonCRDTNodeType::Object)
+	{
+		OutKeyIndex = Parent.ChildKeys[OutSlot];
+		Parent.ChildKeys.RemoveAt(OutSlot);
+		FieldNodes.Remove(MakeFieldKey(ParentIndex, OutKeyIndex));
+	}
+	PayloadBytes = PayloadBytes - ChildListSize + GetChildListSize(Parent);
+
+	Nodes[NodeIndex].Parent = INDEX_NONE;
+	return ParentIndex;
+}
+
+bool FJsonCRDTNodeStore::AttachAtPath(const FJsonCRDTPath& Path, int32 ValueNode)
+{
+	if (Path.IsRoot())
+	{
+		return ReplaceRoot(ValueNode);
+	}
+
+	const int32 LastToken = Path.Num() - 1;
+	const int32 ParentIndex = ResolvePrefix(Path, LastToken);
+	if (ParentIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FJsonCRDTNode& Parent = Nodes[ParentIndex];
+	if (Parent.Type == EJsonCRDTNodeType::Object)
+	{
+		const int32 KeyIndex = InternKey(Path.GetToken(LastToken));
+		const int32 Replaced = FindField(ParentIndex, KeyIndex);
+		if (Replaced == INDEX_NONE)
+		{
+			InsertChild(ParentIndex, Parent.Children.Num(), KeyIndex, ValueNode);
+			return true;
+		}
+
+		// 기존 필드는 덮어씀
+		Nodes[ParentIndex].Children[Parent.Children.Find(Replaced)] = ValueNode;
+		FieldNodes.Add(MakeFieldKey(ParentIndex, KeyIndex), ValueNode);
+		Nodes[ValueNode].Parent = ParentIndex;
+		FreeSubtree(Replaced);
+		return true;
+	}
+
+	if (Parent.Type == EJsonCRDTNodeType::Array)
+	{
+		int32 ArrayIndex = Path.GetArrayIndex(LastToken);
+		if (ArrayIndex == FJsonCRDTPath::AppendIndex)
+		{
+			ArrayIndex = Parent.Children.Num();
+		}
+
+		if (ArrayIndex < 0 || ArrayIndex > Parent.Children.Num())
+		{
+			return false;
+		}
+
+		InsertChild(ParentIndex, ArrayIndex, INDEX_NONE, ValueNode);
+		return true;
+	}
+
+	return false;
+}
+
+bool FJsonCRDTNodeStore::ReplaceRoot(int32 ValueNode)
+{
+	// 문서 루트는 항상 객체
+	if (Nodes[ValueNode].Type != EJsonCRDTNodeType::Object)
+	{
+		return false;
+	}
+
+	FreeSubtree(RootIndex);
+	RootIndex = ValueNode;
+	Nodes[RootIndex].Parent = INDEX_NONE;
+	return true;
+}
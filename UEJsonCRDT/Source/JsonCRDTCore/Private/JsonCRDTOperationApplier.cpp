@@ -0,0 +1,204 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "JsonCRDTOperationApplier.h"
+#include "JsonCRDTStats.h"
+
+namespace JsonCRDTOperationApplier
+{
+	/** 경로에 값을 추가할 때 덮어쓰게 되는 노드 (배열 삽입은 덮어쓰지 않으므로 INDEX_NONE) */
+	static int32 FindOverwrittenNode(const FJsonCRDTNodeStore& Store, const FJsonCRDTPath& Path)
+	{
+		if (Path.IsRoot())
+		{
+			return Store.GetRoot();
+		}
+
+		const int32 ParentIndex = Store.ResolvePrefix(Path, Path.Num() - 1);
+		if (ParentIndex == INDEX_NONE || Store.GetNode(ParentIndex).Type != EJsonCRDTNodeType::Object)
+		{
+			return INDEX_NONE;
+		}
+		return Store.FindChild(ParentIndex, Path, Path.Num() - 1);
+	}
+
+	/** Prefix가 Path의 앞부분(또는 같은 경로)인지 확인 */
+	static bool IsPathPrefix(const FJsonCRDTPath& Prefix, const FJsonCRDTPath& Path)
+	{
+		if (Prefix.Num() > Path.Num())
+		{
+			return false;
+		}
+		for (int32 i = 0; i < Prefix.Num(); ++i)
+		{
+			if (!Prefix.GetToken(i).Equals(Path.GetToken(i), ESearchCase::CaseSensitive))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+FJsonCRDTOperation FJsonCRDTOperationApplier::MakeInverse(const FJsonCRDTOperation& Source, EJsonCRDTOperationType Type, const FString& Path, const FString& Value, const FString& FromPath)
+{
+	FJsonCRDTOperation Inverse;
+	Inverse.Type = Type;
+	Inverse.Path = Path;
+	Inverse.FromPath = FromPath;
+	Inverse.Value = Value;
+	Inverse.Timestamp = Source.Timestamp;
+	Inverse.ClientID = Source.ClientID;
+	return Inverse;
+}
+
+bool FJsonCRDTOperationApplier::Apply(FJsonCRDTNodeStore& Store, const FJsonCRDTOperation& Operation, FJsonCRDTPathCache& InPathCache, TArray<FJsonCRDTOperation>* OutInverse)
+{
+	JSONCRDT_SCOPE_CYCLE_COUNTER(STAT_JsonCRDT_ApplyOperation);
+
+	const TSharedRef<const FJsonCRDTPath, ESPMode::ThreadSafe> Path = InPathCache.Get(Operation.Path);
+	const int64 Timestamp = Operation.Timestamp.GetTicks();
+
+	// Apply the operation based on its type
+	switch (Operation.Type)
+	{
+	case EJsonCRDTOperationType::Add:
+	case EJsonCRDTOperationType::Copy:
+	{
+		// Add a value at the specified path (object members are overwritten, array elements are inserted)
+		// Copy adds a clone of the value found at FromPath
+		int32 ValueNode = INDEX_NONE;
+		if (Operation.Type == EJsonCRDTOperationType::Add)
+		{
+			ValueNode = Store.ParseValue(Operation.Value, Timestamp);
+		}
+		else
+		{
+			const int32 Source = Store.Resolve(*InPathCache.Get(Operation.FromPath));
+			ValueNode = Source != INDEX_NONE ? Store.CloneSubtree(Source, Timestamp) : INDEX_NONE;
+		}
+
+		if (ValueNode == INDEX_NONE)
+		{
+			return false;
+		}
+
+		const int32 Overwritten = OutInverse ? JsonCRDTOperationApplier::FindOverwrittenNode(Store, *Path) : INDEX_NONE;
+		const FString OverwrittenValue = Overwritten != INDEX_NONE ? Store.NodeToString(Overwritten) : FString();
+
+		if (!Store.Add(*Path, ValueNode))
+		{
+			return false;
+		}
+
+		if (OutInverse)
+		{
+			// "-" 같은 경로는 실제로 들어간 위치로 바꿔서 기록
+			const FString ConcretePath = Store.BuildPath(ValueNode);
+			OutInverse->Add(Overwritten != INDEX_NONE
+				? MakeInverse(Operation, EJsonCRDTOperationType::Replace, ConcretePath, OverwrittenValue)
+				: MakeInverse(Operation, EJsonCRDTOperationType::Remove, ConcretePath));
+		}
+		return true;
+	}
+
+	case EJsonCRDTOperationType::Remove:
+	{
+		// Remove a value at the specified path
+		const int32 Target = OutInverse ? Store.Resolve(*Path) : INDEX_NONE;
+		const FString RemovedValue = Target != INDEX_NONE ? Store.NodeToString(Target) : FString();
+
+		if (!Store.Remove(*Path))
+		{
+			return false;
+		}
+
+		if (OutInverse)
+		{
+			OutInverse->Add(MakeInverse(Operation, EJsonCRDTOperationType::Add, Operation.Path, RemovedValue));
+		}
+		return true;
+	}
+
+	case EJsonCRDTOperationType::Replace:
+	{
+		// Replace a value at the specified path; scalar leaves are updated in place
+		const int32 Target = Store.Resolve(*Path);
+		if (Target == INDEX_NONE)
+		{
+			return false;
+		}
+
+		const FString ReplacedValue = OutInverse ? Store.NodeToString(Target) : FString();
+
+		bool bReplaced;
+		FJsonCRDTScalar Scalar;
+		if (!Store.GetNode(Target).IsContainer() && FJsonCRDTNodeStore::ParseScalar(Operation.Value, Scalar))
+		{
+			bReplaced = Store.SetScalar(Target, Scalar, Timestamp);
+		}
+		else
+		{
+			const int32 ValueNode = Store.ParseValue(Operation.Value, Timestamp);
+			bReplaced = ValueNode != INDEX_NONE && Store.Replace(*Path, ValueNode);
+		}
+
+		if (bReplaced && OutInverse)
+		{
+			OutInverse->Add(MakeInverse(Operation, EJsonCRDTOperationType::Replace, Operation.Path, ReplacedValue));
+		}
+		return bReplaced;
+	}
+
+	case EJsonCRDTOperationType::Move:
+	{
+		// Move a value from one path to another
+		const TSharedRef<const FJsonCRDTPath, ESPMode::ThreadSafe> From = InPathCache.Get(Operation.FromPath);
+		const int32 Source = Store.Resolve(*From);
+
+		int32 Overwritten = OutInverse ? JsonCRDTOperationApplier::FindOverwrittenNode(Store, *Path) : INDEX_NONE;
+		if (Overwritten == Source)
+		{
+			Overwritten = INDEX_NONE;
+		}
+		const FString OverwrittenValue = Overwritten != INDEX_NONE ? Store.NodeToString(Overwritten) : FString();
+
+		if (!Store.Move(*From, *Path, Timestamp))
+		{
+			return false;
+		}
+
+		if (OutInverse)
+		{
+			const FString ConcretePath = Store.BuildPath(Source);
+			if (Overwritten != INDEX_NONE && JsonCRDTOperationApplier::IsPathPrefix(*Path, *From))
+			{
+				// 원본의 상위 값을 덮어쓴 경우 덮어쓴 값 안에 원본이 들어 있으므로 교체만으로 복구
+				OutInverse->Add(MakeInverse(Operation, EJsonCRDTOperationType::Replace, ConcretePath, OverwrittenValue));
+			}
+			else
+			{
+				// 되돌릴 때는 뒤에서부터 적용되므로 원래 위치로 이동한 뒤 덮어쓴 값을 다시 추가
+				if (Overwritten != INDEX_NONE)
+				{
+					OutInverse->Add(MakeInverse(Operation, EJsonCRDTOperationType::Add, ConcretePath, OverwrittenValue));
+				}
+				OutInverse->Add(MakeInverse(Operation, EJsonCRDTOperationType::Move, Operation.FromPath, FString(), ConcretePath));
+			}
+		}
+		return true;
+	}
+
+	case EJsonCRDTOperationType::Test:
+	{
+		// Test if a value at the specified path equals the given value
+		const int32 ValueNode = Store.ParseValue(Operation.Value, Timestamp);
+		const bool bEqual = ValueNode != INDEX_NONE && Store.Test(*Path, ValueNode);
+		Store.ReleaseNode(ValueNode);
+		return bEqual;
+	}
+
+	default:
+		UE_LOG(LogTemp, Error, TEXT("Unknown operation type: %d"), (int32)Operation.Type);
+		return false;
+	}
+}
@@ -0,0 +1,219 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "JsonCRDTOperationHistory.h"
+
+FJsonCRDTOperationHistory::FJsonCRDTOperationHistory(int32 InCapacity)
+	: Capacity(FMath::Max(1, InCapacity))
+	, Head(0)
+	, Count(0)
+	, NextSequence(0)
+	, OperationBytes(0)
+	, ClientIDBytes(0)
+{
+}
+
+uint64 FJsonCRDTOperationHistory::Add(const FJsonCRDTOperation& Operation)
+{
+	// 클라이언트 ID는 인터닝되므로 나머지만 복사
+	FJsonCRDTOperation Copy;
+	Copy.Type = Operation.Type;
+	Copy.Path = Operation.Path;
+	Copy.FromPath = Operation.FromPath;
+	Copy.Value = Operation.Value;
+	Copy.Timestamp = Operation.Timestamp;
+	const int32 ClientIndex = InternClientID(Operation.ClientID);
+
+	const uint64 Sequence = Add(MoveTemp(Copy));
+	EntryClients[GetSlot(Sequence)] = ClientIndex;
+	return Sequence;
+}
+
+uint64 FJsonCRDTOperationHistory::Add(FJsonCRDTOperation&& Operation)
+{
+	const int32 Slot = ClaimSlot();
+	const uint64 Sequence = NextSequence++;
+	const int32 ClientIndex = InternClientID(Operation.ClientID);
+	Operation.ClientID.Empty();
+
+	if (Slot == Entries.Num())
+	{
+		Entries.Add(MoveTemp(Operation));
+		EntryClients.Add(ClientIndex);
+	}
+	else
+	{
+		Entries[Slot] = MoveTemp(Operation);
+		EntryClients[Slot] = ClientIndex;
+	}
+
+	OperationBytes += Entries[Slot].GetAllocatedSize();
+	IndexOperation(Entries[Slot], Sequence);
+	return Sequence;
+}
+
+const FJsonCRDTOperation* FJsonCRDTOperationHistory::FindLatestReplace(const FString& Path) const
+{
+	const uint64* Sequence = LatestReplaceByPath.Find(Path);
+	return Sequence ? FindBySequence(*Sequence) : nullptr;
+}
+
+const FJsonCRDTOperation* FJsonCRDTOperationHistory::FindBySequence(uint64 Sequence) const
+{
+	if (Sequence < GetOldestSequence() || Sequence >= NextSequence)
+	{
+		return nullptr;
+	}
+	return &Entries[GetSlot(Sequence)];
+}
+
+bool FJsonCRDTOperationHistory::CopyBySequence(uint64 Sequence, FJsonCRDTOperation& OutOperation) const
+{
+	const FJsonCRDTOperation* Operation = FindBySequence(Sequence);
+	if (!Operation)
+	{
+		return false;
+	}
+
+	OutOperation = *Operation;
+	OutOperation.ClientID = GetClientID(Sequence);
+	return true;
+}
+
+const FString& FJsonCRDTOperationHistory::GetClientID(uint64 Sequence) const
+{
+	static const FString NoClientID;
+	if (Sequence < GetOldestSequence() || Sequence >= NextSequence)
+	{
+		return NoClientID;
+	}
+
+	const int32 ClientIndex = EntryClients[GetSlot(Sequence)];
+	return ClientIndex != INDEX_NONE ? ClientIDs[ClientIndex] : NoClientID;
+}
+
+uint64 FJsonCRDTOperationHistory::FindLatestReplaceSequence(const FString& Path) const
+{
+	const uint64* Sequence = LatestReplaceByPath.Find(Path);
+	return Sequence && *Sequence >= GetOldestSequence() ? *Sequence : InvalidSequence;
+}
+
+const FJsonCRDTOperation& FJsonCRDTOperationHistory::Get(int32 Index) const
+{
+	check(Index >= 0 && Index < Count);
+	return Entries[(Head + Index) % Capacity];
+}
+
+void FJsonCRDTOperationHistory::SetCapacity(int32 NewCapacity)
+{
+	NewCapacity = FMath::Max(1, NewCapacity);
+	if (NewCapacity == Capacity)
+	{
+		return;
+	}
+
+	// 오래된 순서로 펼친 뒤 새 용량에 맞게 최근 작업만 유지
+	const int32 NumToKeep = FMath::Min(Count, NewCapacity);
+	const uint64 FirstKept = NextSequence - NumToKeep;
+
+	TArray<FJsonCRDTOperation> Linear;
+	TArray<int32> LinearClients;
+	Linear.Reserve(NumToKeep);
+	LinearClients.Reserve(NumToKeep);
+	OperationBytes = 0;
+	for (int32 i = Count - NumToKeep; i < Count; ++i)
+	{
+		const int32 Slot = (Head + i) % Capacity;
+		FJsonCRDTOperation& Kept = Linear.Add_GetRef(MoveTemp(Entries[Slot]));
+		LinearClients.Add(EntryClients[Slot]);
+		OperationBytes += Kept.GetAllocatedSize();
+	}
+
+	Entries = MoveTemp(Linear);
+	EntryClients = MoveTemp(LinearClients);
+	Capacity = NewCapacity;
+	Head = 0;
+	Count = NumToKeep;
+
+	// 버려진 작업을 가리키는 색인 제거
+	for (auto It = LatestReplaceByPath.CreateIterator(); It; ++It)
+	{
+		if (It->Value < FirstKept)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FJsonCRDTOperationHistory::Empty()
+{
+	Entries.Empty();
+	EntryClients.Empty();
+	ClientIDs.Empty();
+	ClientIndices.Empty();
+	ClientIDBytes = 0;
+	LatestReplaceByPath.Empty();
+	Head = 0;
+	Count = 0;
+	OperationBytes = 0;
+}
+
+SIZE_T FJsonCRDTOperationHistory::GetAllocatedSize() const
+{
+	return Entries.GetAllocatedSize() + EntryClients.GetAllocatedSize() + LatestReplaceByPath.GetAllocatedSize() + OperationBytes
+		+ ClientIDs.GetAllocatedSize() + ClientIndices.GetAllocatedSize() + ClientIDBytes;
+}
+
+int32 FJsonCRDTOperationHistory::ClaimSlot()
+{
+	if (Count < Capacity)
+	{
+		return (Head + Count++) % Capacity;
+	}
+
+	// 가장 오래된 작업을 밀어내고, 그 작업이 경로의 최신 Replace였다면 색인에서도 제거
+	const int32 Slot = Head;
+	const FJsonCRDTOperation& Evicted = Entries[Slot];
+	OperationBytes -= Evicted.GetAllocatedSize();
+	if (Evicted.Type == EJsonCRDTOperationType::Replace)
+	{
+		const uint64* Latest = LatestReplaceByPath.Find(Evicted.Path);
+		if (Latest && *Latest == GetOldestSequence())
+		{
+			LatestReplaceByPath.Remove(Evicted.Path);
+		}
+	}
+
+	Head = (Head + 1) % Capacity;
+	return Slot;
+}
+
+void FJsonCRDTOperationHistory::IndexOperation(const FJsonCRDTOperation& Operation, uint64 Sequence)
+{
+	if (Operation.Type == EJsonCRDTOperationType::Replace)
+	{
+		LatestReplaceByPath.Add(Operation.Path, Sequence);
+	}
+}
+
+int32 FJsonCRDTOperationHistory::GetSlot(uint64 Sequence) const
+{
+	return (Head + static_cast<int32>(Sequence - GetOldestSequence())) % Capacity;
+}
+
+int32 FJsonCRDTOperationHistory::InternClientID(const FString& ClientID)
+{
+	if (ClientID.IsEmpty())
+	{
+		return INDEX_NONE;
+	}
+
+	if (const int32* ClientIndex = ClientIndices.Find(ClientID))
+	{
+		return *ClientIndex;
+	}
+
+	const int32 NewIndex = ClientIDs.Add(ClientID);
+	ClientIndices.Add(ClientID, NewIndex);
+	ClientIDBytes += ClientIDs[NewIndex].GetAllocatedSize() * 2;
+	return NewIndex;
+}
@@ -0,0 +1,751 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "JsonCRDTPatchParser.h"
+
+namespace JsonCRDTPatchParser
+{
+	/** 건너뛰거나 복사하는 값의 최대 중첩 깊이 */
+	static constexpr int32 MaxDepth = 512;
+
+	/** 작업 타입 이름 (EJsonCRDTOperationType 순서, 대소문자 무시) */
+	static const TCHAR* OperationTypeNames[] =
+	{
+		TEXT("add"),
+		TEXT("remove"),
+		TEXT("replace"),
+		TEXT("move"),
+		TEXT("copy"),
+		TEXT("test")
+	};
+
+	static bool HasFromPath(EJsonCRDTOperationType Type)
+	{
+		return Type == EJsonCRDTOperationType::Move || Type == EJsonCRDTOperationType::Copy;
+	}
+
+	static bool HasValue(EJsonCRDTOperationType Type)
+	{
+		return Type == EJsonCRDTOperationType::Add
+			|| Type == EJsonCRDTOperationType::Replace
+			|| Type == EJsonCRDTOperationType::Test;
+	}
+
+	static int32 HexDigit(TCHAR Char)
+	{
+		if (Char >= TEXT('0') && Char <= TEXT('9'))
+		{
+			return Char - TEXT('0');
+		}
+		if (Char >= TEXT('a') && Char <= TEXT('f'))
+		{
+			return Char - TEXT('a') + 10;
+		}
+		if (Char >= TEXT('A') && Char <= TEXT('F'))
+		{
+			return Char - TEXT('A') + 10;
+		}
+		return INDEX_NONE;
+	}
+
+	/** 입력 위치와 첫 오류를 보관하는 토큰 단위 스캐너 */
+	class FScanner
+	{
+	public:
+		explicit FScanner(FStringView Text)
+			: Begin(Text.GetData())
+			, Cursor(Text.GetData())
+			, End(Text.GetData() + Text.Len())
+		{
+		}
+
+		const TCHAR* Begin;
+		const TCHAR* Cursor;
+		const TCHAR* End;
+
+		/** 첫 오류 (없으면 nullptr) */
+		const TCHAR* ErrorMessage = nullptr;
+
+		bool HasError() const { return ErrorMessage != nullptr; }
+
+		bool Fail(const TCHAR* Message)
+		{
+			if (!ErrorMessage)
+			{
+				ErrorMessage = Message;
+			}
+			return false;
+		}
+
+		void SkipWhitespace()
+		{
+			while (Cursor < End && (*Cursor == TEXT(' ') || *Cursor == TEXT('\t') || *Cursor == TEXT('\n') || *Cursor == TEXT('\r')))
+			{
+				++Cursor;
+			}
+		}
+
+		TCHAR Peek()
+		{
+			SkipWhitespace();
+			return Cursor < End ? *Cursor : TEXT('\0');
+		}
+
+		bool Consume(TCHAR Char)
+		{
+			if (Peek() == Char && Cursor < End)
+			{
+				++Cursor;
+				return true;
+			}
+			return false;
+		}
+
+		bool AtEnd()
+		{
+			SkipWhitespace();
+			return Cursor == End;
+		}
+
+		bool BeginObject()
+		{
+			return Consume(TEXT('{')) || Fail(TEXT("Expected '{'"));
+		}
+
+		bool BeginArray()
+		{
+			return Consume(TEXT('[')) || Fail(TEXT("Expected '['"));
+		}
+
+		/**
+		 * 객체의 다음 필드 이름까지 읽기
+		 * @param bFirst 첫 필드인지 여부 (처음에 true로 넘김)
+		 * @param OutKey 필드 이름 (nullptr이면 건너뜀)
+		 * @return 필드가 있으면 true, 객체가 끝났거나 오류면 false (HasError로 구분)
+		 */
+		bool NextField(bool& bFirst, FString* OutKey)
+		{
+			if (Consume(TEXT('}')))
+			{
+				return false;
+			}
+			if (!bFirst && !Consume(TEXT(',')))
+			{
+				return Fail(TEXT("Expected ',' or '}'"));
+			}
+			bFirst = false;
+
+			if (!(OutKey ? ReadString(*OutKey) : SkipString()))
+			{
+				return false;
+			}
+			return Consume(TEXT(':')) || Fail(TEXT("Expected ':'"));
+		}
+
+		/**
+		 * 배열의 다음 요소 앞까지 읽기
+		 * @return 요소가 있으면 true, 배열이 끝났거나 오류면 false (HasError로 구분)
+		 */
+		bool NextElement(bool& bFirst)
+		{
+			if (Consume(TEXT(']')))
+			{
+				return false;
+			}
+			if (!bFirst && !Consume(TEXT(',')))
+			{
+				return Fail(TEXT("Expected ',' or ']'"));
+			}
+			bFirst = false;
+			return true;
+		}
+
+		/** 문자열 읽기 (이스케이프가 없는 구간은 한 번에 복사) */
+		bool ReadString(FString& Out)
+		{
+			Out.Reset();
+			if (!Consume(TEXT('"')))
+			{
+				return Fail(TEXT("Expected string"));
+			}
+
+			const TCHAR* Start = Cursor;
+			while (Cursor < End)
+			{
+				const TCHAR Char = *Cursor;
+				if (Char == TEXT('"'))
+				{
+					Out.AppendChars(Start, static_cast<int32>(Cursor - Start));
+					++Cursor;
+					return true;
+				}
+
+				if (Char == TEXT('\\'))
+				{
+					Out.AppendChars(Start, static_cast<int32>(Cursor - Start));
+					if (!ReadEscape(Out))
+					{
+						return false;
+					}
+					Start = Cursor;
+					continue;
+				}
+
+				if (Char < 0x20)
+				{
+					return Fail(TEXT("Control character in string"));
+				}
+				++Cursor;
+			}
+			return Fail(TEXT("Unterminated string"));
+		}
+
+		/** 문자열을 내용 없이 건너뜀 */
+		bool SkipString()
+		{
+			if (!Consume(TEXT('"')))
+			{
+				return Fail(TEXT("Expected string"));
+			}
+
+			while (Cursor < End)
+			{
+				const TCHAR Char = *Cursor++;
+				if (Char == TEXT('"'))
+				{
+					return true;
+				}
+				if (Char == TEXT('\\'))
+				{
+					if (Cursor == End)
+					{
+						break;
+					}
+					++Cursor;
+				}
+				else if (Char < 0x20)
+				{
+					return Fail(TEXT("Control character in string"));
+				}
+			}
+			return Fail(TEXT("Unterminated string"));
+		}
+
+		/** 정수 읽기 (소수나 지수가 있으면 double로 읽어 변환) */
+		bool ReadInt64(int64& Out)
+		{
+			SkipWhitespace();
+			const TCHAR* Start = Cursor;
+			if (!SkipNumber())
+			{
+				return false;
+			}
+
+			bool bNegative = false;
+			const TCHAR* Digit = Start;
+			if (*Digit == TEXT('-'))
+			{
+				bNegative = true;
+				++Digit;
+			}
+
+			uint64 Value = 0;
+			for (; Digit < Cursor && FChar::IsDigit(*Digit); ++Digit)
+			{
+				Value = Value * 10 + static_cast<uint64>(*Digit - TEXT('0'));
+			}
+
+			if (Digit < Cursor)
+			{
+				const FString Number(static_cast<int32>(Cursor - Start), Start);
+				Out = static_cast<int64>(FCString::Atod(*Number));
+				return true;
+			}
+
+			Out = bNegative ? -static_cast<int64>(Value) : static_cast<int64>(Value);
+			return true;
+		}
+
+		/** 값 하나를 건너뜀 (문법은 검사) */
+		bool SkipValue(int32 Depth = 0)
+		{
+			if (Depth > MaxDepth)
+			{
+				return Fail(TEXT("Value nested too deeply"));
+			}
+
+			bool bFirst = true;
+			switch (Peek())
+			{
+			case TEXT('{'):
+				++Cursor;
+				while (NextField(bFirst, nullptr))
+				{
+					if (!SkipValue(Depth + 1))
+					{
+						return false;
+					}
+				}
+				return !HasError();
+
+			case TEXT('['):
+				++Cursor;
+				while (NextElement(bFirst))
+				{
+					if (!SkipValue(Depth + 1))
+					{
+						return false;
+					}
+				}
+				return !HasError();
+
+			case TEXT('"'):
+				return SkipString();
+
+			case TEXT('t'):
+				return ConsumeLiteral(TEXT("true"));
+
+			case TEXT('f'):
+				return ConsumeLiteral(TEXT("false"));
+
+			case TEXT('n'):
+				return ConsumeLiteral(TEXT("null"));
+
+			default:
+				return SkipNumber();
+			}
+		}
+
+		/** 값 하나의 원문을 그대로 복사 */
+		bool ReadRawValue(FString& Out)
+		{
+			SkipWhitespace();
+			const TCHAR* Start = Cursor;
+			if (!SkipValue())
+			{
+				return false;
+			}
+
+			Out.Reset();
+			Out.AppendChars(Start, static_cast<int32>(Cursor - Start));
+			return true;
+		}
+
+		/** 입력 앞부분에서의 위치 */
+		int32 GetOffset() const
+		{
+			return static_cast<int32>(Cursor - Begin);
+		}
+
+	private:
+		bool ConsumeLiteral(const TCHAR* Literal)
+		{
+			const int32 Length = FCString::Strlen(Literal);
+			if (End - Cursor < Length || FCString::Strncmp(Cursor, Literal, Length) != 0)
+			{
+				return Fail(TEXT("Invalid literal"));
+			}
+			Cursor += Length;
+			return true;
+		}
+
+		bool SkipNumber()
+		{
+			const TCHAR* Start = Cursor;
+			if (Cursor < End && *Cursor == TEXT('-'))
+			{
+				++Cursor;
+			}
+
+			const TCHAR* Digits = Cursor;
+			while (Cursor < End && FChar::IsDigit(*Cursor))
+			{
+				++Cursor;
+			}
+			if (Cursor == Digits)
+			{
+				Cursor = Start;
+				return Fail(TEXT("Expected value"));
+			}
+
+			if (Cursor < End && *Cursor == TEXT('.'))
+			{
+				++Cursor;
+				while (Cursor < End && FChar::IsDigit(*Cursor))
+				{
+					++Cursor;
+				}
+			}
+
+			if (Cursor < End && (*Cursor == TEXT('e') || *Cursor == TEXT('E')))
+			{
+				++Cursor;
+				if (Cursor < End && (*Cursor == TEXT('+') || *Cursor == TEXT('-')))
+				{
+					++Cursor;
+				}
+				while (Cursor < End && FChar::IsDigit(*Cursor))
+				{
+					++Cursor;
+				}
+			}
+			return true;
+		}
+
+		/** 역슬래시 뒤의 이스케이프 하나를 풀어 추가 (\u는 UTF-16 코드 단위 그대로 추가) */
+		bool ReadEscape(FString& Out)
+		{
+			++Cursor;
+			if (Cursor == End)
+			{
+				return Fail(TEXT("Unterminated string"));
+			}
+
+			const TCHAR Char = *Cursor++;
+			switch (Char)
+			{
+			case TEXT('"'):
+			case TEXT('\\'):
+			case TEXT('/'):
+				Out.AppendChar(Char);
+				return true;
+			case TEXT('b'):
+				Out.AppendChar(TEXT('\b'));
+				return true;
+			case TEXT('f'):
+				Out.AppendChar(TEXT('\f'));
+				return true;
+			case TEXT('n'):
+				Out.AppendChar(TEXT('\n'));
+				return true;
+			case TEXT('r'):
+				Out.AppendChar(TEXT('\r'));
+				return true;
+			case TEXT('t'):
+				Out.AppendChar(TEXT('\t'));
+				return true;
+			case TEXT('u'):
+			{
+				if (End - Cursor < 4)
+				{
+					return Fail(TEXT("Invalid unicode escape"));
+				}
+
+				uint32 CodeUnit = 0;
+				for (int32 i = 0; i < 4; ++i)
+				{
+					const int32 Digit = HexDigit(*Cursor++);
+					if (Digit == INDEX_NONE)
+					{
+						return Fail(TEXT("Invalid unicode escape"));
+					}
+					CodeUnit = (CodeUnit << 4) | static_cast<uint32>(Digit);
+				}
+				Out.AppendChar(static_cast<TCHAR>(CodeUnit));
+				return true;
+			}
+			default:
+				return Fail(TEXT("Invalid escape"));
+			}
+		}
+	};
+
+	static bool ReadOperationType(FScanner& Scanner, FString& Scratch, EJsonCRDTOperationType& OutType)
+	{
+		// 숫자는 열거형 값으로 받음
+		if (Scanner.Peek() != TEXT('"'))
+		{
+			int64 Index = 0;
+			if (!Scanner.ReadInt64(Index))
+			{
+				return false;
+			}
+			if (Index < 0 || Index >= static_cast<int64>(UE_ARRAY_COUNT(OperationTypeNames)))
+			{
+				return Scanner.Fail(TEXT("Unknown operation type"));
+			}
+			OutType = static_cast<EJsonCRDTOperationType>(Index);
+			return true;
+		}
+
+		if (!Scanner.ReadString(Scratch))
+		{
+			return false;
+		}
+
+		for (int32 Index = 0; Index < UE_ARRAY_COUNT(OperationTypeNames); ++Index)
+		{
+			if (Scratch.Equals(OperationTypeNames[Index], ESearchCase::IgnoreCase))
+			{
+				OutType = static_cast<EJsonCRDTOperationType>(Index);
+				return true;
+			}
+		}
+		return Scanner.Fail(TEXT("Unknown operation type"));
+	}
+
+	static bool ReadTimestamp(FScanner& Scanner, FString& Scratch, FDateTime& OutTimestamp, bool& bOutHasTimestamp)
+	{
+		if (Scanner.Peek() != TEXT('"'))
+		{
+			return Scanner.SkipValue();
+		}
+
+		if (!Scanner.ReadString(Scratch))
+		{
+			return false;
+		}
+
+		bOutHasTimestamp = FDateTime::ParseIso8601(*Scratch, OutTimestamp) || FDateTime::Parse(Scratch, OutTimestamp);
+		return true;
+	}
+
+	static bool ReadVersionVector(FScanner& Scanner, FString& Key, TMap<FString, int64>& OutVersionVector)
+	{
+		if (!Scanner.BeginObject())
+		{
+			return false;
+		}
+
+		bool bFirst = true;
+		while (Scanner.NextField(bFirst, &Key))
+		{
+			int64 Sequence = 0;
+			if (!Scanner.ReadInt64(Sequence))
+			{
+				return false;
+			}
+			OutVersionVector.Add(Key, Sequence);
+		}
+		return !Scanner.HasError();
+	}
+
+	static bool ReadOperation(FScanner& Scanner, FJsonCRDTPatchParser::EFormat Format, FString& Key, FString& Scratch, FJsonCRDTOperation& Operation, bool& bOutHasTimestamp)
+	{
+		if (!Scanner.BeginObject())
+		{
+			return false;
+		}
+
+		bool bHasType = false;
+		bool bHasPath = false;
+		bool bHasFromPath = false;
+		bool bHasValue = false;
+		bool bFirst = true;
+		while (Scanner.NextField(bFirst, &Key))
+		{
+			bool bRead;
+			if (Key.Equals(TEXT("op"), ESearchCase::IgnoreCase) || Key.Equals(TEXT("type"), ESearchCase::IgnoreCase))
+			{
+				bRead = ReadOperationType(Scanner, Scratch, Operation.Type);
+				bHasType = true;
+			}
+			else if (Key.Equals(TEXT("path"), ESearchCase::IgnoreCase))
+			{
+				bRead = Scanner.ReadString(Operation.Path);
+				bHasPath = true;
+			}
+			else if (Key.Equals(TEXT("from"), ESearchCase::IgnoreCase) || Key.Equals(TEXT("fromPath"), ESearchCase::IgnoreCase))
+			{
+				bRead = Scanner.ReadString(Operation.FromPath);
+				bHasFromPath = true;
+			}
+			else if (Key.Equals(TEXT("value"), ESearchCase::IgnoreCase))
+			{
+				// 구조체 형식은 JSON 텍스트를 문자열에 담아 두므로 풀어서 사용
+				bRead = Format == FJsonCRDTPatchParser::EFormat::Struct && Scanner.Peek() == TEXT('"')
+					? Scanner.ReadString(Operation.Value)
+					: Scanner.ReadRawValue(Operation.Value);
+				bHasValue = true;
+			}
+			else if (Key.Equals(TEXT("timestamp"), ESearchCase::IgnoreCase))
+			{
+				bRead = ReadTimestamp(Scanner, Scratch, Operation.Timestamp, bOutHasTimestamp);
+			}
+			else if (Key.Equals(TEXT("clientId"), ESearchCase::IgnoreCase))
+			{
+				bRead = Scanner.ReadString(Operation.ClientID);
+			}
+			else
+			{
+				bRead = Scanner.SkipValue();
+			}
+
+			if (!bRead)
+			{
+				return false;
+			}
+		}
+
+		if (Scanner.HasError())
+		{
+			return false;
+		}
+		if (!bHasType || !bHasPath)
+		{
+			return Scanner.Fail(TEXT("Operation is missing op or path"));
+		}
+		if (HasFromPath(Operation.Type) && !bHasFromPath)
+		{
+			return Scanner.Fail(TEXT("Operation is missing from"));
+		}
+		if (HasValue(Operation.Type) && !bHasValue)
+		{
+			return Scanner.Fail(TEXT("Operation is missing value"));
+		}
+		return true;
+	}
+
+	static bool ReadPatch(FScanner& Scanner, FJsonCRDTPatchParser::EFormat Format, FJsonCRDTPatch& OutPatch, FString* OutMessageType)
+	{
+		OutPatch.DocumentID.Reset();
+		OutPatch.ClientID.Reset();
+		OutPatch.BaseVersion = 0;
+		OutPatch.Sequence = 0;
+		OutPatch.VersionVector.Reset();
+
+		// 작업 요소는 문자열 메모리를 재사용하도록 끝에서 개수만 맞춤
+		TArray<FJsonCRDTOperation>& Operations = OutPatch.Operations;
+		TBitArray<> OperationHasTimestamp;
+		int32 NumOperations = 0;
+
+		FString Key;
+		FString Scratch;
+		bool bHasDocumentID = false;
+		bool bHasOperations = false;
+		bool bHasTimestamp = false;
+
+		if (!Scanner.BeginObject())
+		{
+			return false;
+		}
+
+		bool bFirst = true;
+		while (Scanner.NextField(bFirst, &Key))
+		{
+			bool bRead;
+			if (Key.Equals(TEXT("documentId"), ESearchCase::IgnoreCase))
+			{
+				bRead = Scanner.ReadString(OutPatch.DocumentID);
+				bHasDocumentID = true;
+			}
+			else if (Key.Equals(TEXT("baseVersion"), ESearchCase::IgnoreCase))
+			{
+				bRead = Scanner.ReadInt64(OutPatch.BaseVersion);
+			}
+			else if (Key.Equals(TEXT("sequence"), ESearchCase::IgnoreCase))
+			{
+				bRead = Scanner.ReadInt64(OutPatch.Sequence);
+			}
+			else if (Key.Equals(TEXT("clientId"), ESearchCase::IgnoreCase))
+			{
+				bRead = Scanner.ReadString(OutPatch.ClientID);
+			}
+			else if (Key.Equals(TEXT("timestamp"), ESearchCase::IgnoreCase))
+			{
+				bRead = ReadTimestamp(Scanner, Scratch, OutPatch.Timestamp, bHasTimestamp);
+			}
+			else if (Key.Equals(TEXT("versionVector"), ESearchCase::IgnoreCase))
+			{
+				bRead = ReadVersionVector(Scanner, Key, OutPatch.VersionVector);
+			}
+			else if (Key.Equals(TEXT("operations"), ESearchCase::IgnoreCase))
+			{
+				bRead = Scanner.BeginArray();
+				bool bFirstOperation = true;
+				while (bRead && Scanner.NextElement(bFirstOperation))
+				{
+					if (NumOperations == Operations.Num())
+					{
+						Operations.AddDefaulted();
+					}
+
+					FJsonCRDTOperation& Operation = Operations[NumOperations++];
+					Operation.Type = EJsonCRDTOperationType::Add;
+					Operation.Path.Reset();
+					Operation.FromPath.Reset();
+					Operation.Value.Reset();
+					Operation.ClientID.Reset();
+
+					bool bOperationHasTimestamp = false;
+					bRead = ReadOperation(Scanner, Format, Key, Scratch, Operation, bOperationHasTimestamp);
+					OperationHasTimestamp.Add(bOperationHasTimestamp);
+				}
+				bRead = bRead && !Scanner.HasError();
+				bHasOperations = true;
+			}
+			else if (Format == FJsonCRDTPatchParser::EFormat::Message && OutMessageType && Key.Equals(TEXT("type"), ESearchCase::IgnoreCase))
+			{
+				bRead = Scanner.ReadString(*OutMessageType);
+			}
+			else
+			{
+				bRead = Scanner.SkipValue();
+			}
+
+			if (!bRead)
+			{
+				return false;
+			}
+		}
+
+		if (Scanner.HasError())
+		{
+			return false;
+		}
+		if (!Scanner.AtEnd())
+		{
+			return Scanner.Fail(TEXT("Unexpected data after patch"));
+		}
+		if (!bHasDocumentID)
+		{
+			return Scanner.Fail(TEXT("Patch is missing documentId"));
+		}
+		if (!bHasOperations)
+		{
+			return Scanner.Fail(TEXT("Patch is missing operations"));
+		}
+
+		Operations.SetNum(NumOperations, false);
+		if (!bHasTimestamp)
+		{
+			OutPatch.Timestamp = FDateTime::UtcNow();
+		}
+
+		// 작업에 없는 시각과 클라이언트 ID는 패치의 값 (패치 필드가 작업 뒤에 올 수 있어 끝에서 채움)
+		for (int32 Index = 0; Index < NumOperations; ++Index)
+		{
+			FJsonCRDTOperation& Operation = Operations[Index];
+			if (!OperationHasTimestamp[Index])
+			{
+				Operation.Timestamp = OutPatch.Timestamp;
+			}
+			if (Operation.ClientID.IsEmpty())
+			{
+				Operation.ClientID = OutPatch.ClientID;
+			}
+		}
+		return true;
+	}
+}
+
+bool FJsonCRDTPatchParser::Parse(FStringView Json, EFormat Format, FJsonCRDTPatch& OutPatch, FString* OutMessageType, FString* OutError)
+{
+	using namespace JsonCRDTPatchParser;
+
+	if (OutMessageType)
+	{
+		OutMessageType->Reset();
+	}
+
+	FScanner Scanner(Json);
+	if (ReadPatch(Scanner, Format, OutPatch, OutMessageType))
+	{
+		return true;
+	}
+
+	if (OutError)
+	{
+		*OutError = FString::Printf(TEXT("%s at offset %d"), Scanner.ErrorMessage ? Scanner.ErrorMessage : TEXT("Invalid patch"), Scanner.GetOffset());
+	}
+	return false;
+}
@@ -0,0 +1,143 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "JsonCRDTPath.h"
+#include "Misc/ScopeLock.h"
+
+namespace JsonCRDTPath
+{
+	/** 세그먼트를 배열 인덱스로 해석 */
+	static int32 ParseArrayIndex(const FString& Token)
+	{
+		if (Token == TEXT("-"))
+		{
+			return FJsonCRDTPath::AppendIndex;
+		}
+
+		// RFC 6901: 0 이외의 인덱스는 0으로 시작할 수 없음
+		if (Token.IsEmpty() || Token.Len() > 9 || (Token.Len() > 1 && Token[0] == TEXT('0')))
+		{
+			return INDEX_NONE;
+		}
+
+		int32 Index = 0;
+		for (TCHAR Char : Token)
+		{
+			if (!FChar::IsDigit(Char))
+			{
+				return INDEX_NONE;
+			}
+			Index = Index * 10 + (Char - TEXT('0'));
+		}
+		return Index;
+	}
+}
+
+FJsonCRDTPath::FJsonCRDTPath(const FString& InPath)
+	: Source(InPath)
+{
+	// 경로를 '/'로 분할 (선행 '/'와 빈 세그먼트는 무시)
+	InPath.ParseIntoArray(Tokens, TEXT("/"), true);
+
+	ArrayIndices.Reserve(Tokens.Num());
+	for (FString& Token : Tokens)
+	{
+		// ~로 시작하는 이스케이프된 문자 처리 (~1을 먼저 처리해야 "~01"이 올바르게 해석됨)
+		if (Token.Contains(TEXT("~"), ESearchCase::CaseSensitive))
+		{
+			Token.ReplaceInline(TEXT("~1"), TEXT("/"), ESearchCase::CaseSensitive);
+			Token.ReplaceInline(TEXT("~0"), TEXT("~"), ESearchCase::CaseSensitive);
+		}
+
+		ArrayIndices.Add(JsonCRDTPath::ParseArrayIndex(Token));
+	}
+}
+
+TSharedPtr<FJsonValue> FJsonCRDTPath::Resolve(const TSharedPtr<FJsonObject>& Root) const
+{
+	return ResolvePrefix(Root, Tokens.Num());
+}
+
+TSharedPtr<FJsonValue> FJsonCRDTPath::ResolvePrefix(const TSharedPtr<FJsonObject>& Root, int32 NumTokens) const
+{
+	if (!Root.IsValid())
+	{
+		return nullptr;
+	}
+
+	// 빈 경로인 경우 전체 객체 반환
+	if (NumTokens <= 0)
+	{
+		return MakeShared<FJsonValueObject>(Root);
+	}
+
+	const TSharedPtr<FJsonObject>* CurrentObject = &Root;
+	const TSharedPtr<FJsonValue>* CurrentValue = nullptr;
+
+	for (int32 i = 0; i < NumTokens && i < Tokens.Num(); ++i)
+	{
+		// 현재 값이 객체인 경우
+		if (CurrentObject)
+		{
+			CurrentValue = (*CurrentObject)->Values.Find(Tokens[i]);
+		}
+		// 현재 값이 배열인 경우
+		else if (CurrentValue && (*CurrentValue)->Type == EJson::Array)
+		{
+			const TArray<TSharedPtr<FJsonValue>>& Array = (*CurrentValue)->AsArray();
+			const int32 Index = ArrayIndices[i];
+			CurrentValue = Array.IsValidIndex(Index) ? &Array[Index] : nullptr;
+		}
+		// 다른 타입인 경우 (경로가 더 남아있으면 오류)
+		else
+		{
+			return nullptr;
+		}
+
+		if (!CurrentValue || !CurrentValue->IsValid())
+		{
+			return nullptr;
+		}
+
+		CurrentObject = nullptr;
+		(*CurrentValue)->TryGetObject(CurrentObject);
+	}
+
+	return CurrentValue ? *CurrentValue : nullptr;
+}
+
+FJsonCRDTPathCache::FJsonCRDTPathCache(int32 InMaxEntries)
+	: Entries(InMaxEntries)
+{
+}
+
+TSharedRef<const FJsonCRDTPath, ESPMode::ThreadSafe> FJsonCRDTPathCache::Get(const FString& Path)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	if (const TSharedPtr<const FJsonCRDTPath, ESPMode::ThreadSafe>* Cached = Entries.FindAndTouch(Path))
+	{
+		return Cached->ToSharedRef();
+	}
+
+	TSharedRef<const FJsonCRDTPath, ESPMode::ThreadSafe> Parsed = MakeShared<const FJsonCRDTPath, ESPMode::ThreadSafe>(Path);
+	Entries.Add(Path, Parsed);
+	return Parsed;
+}
+
+void FJsonCRDTPathCache::Empty()
+{
+	FScopeLock ScopeLock(&Lock);
+	Entries.Empty(Entries.Max());
+}
+
+int32 FJsonCRDTPathCache::Num() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Entries.Num();
+}
+
+FJsonCRDTPathCache& FJsonCRDTPathCache::GetShared()
+{
+	static FJsonCRDTPathCache SharedCache(2048);
+	return SharedCache;
+}
@@ -0,0 +1,150 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "JsonCRDTPathTrie.h"
+
+FJsonCRDTPathTrie::FJsonCRDTPathTrie()
+	: NumIds(0)
+{
+	Reset();
+}
+
+void FJsonCRDTPathTrie::Add(const FJsonCRDTPath& Path, int32 Id)
+{
+	int32 Current = 0;
+	for (int32 i = 0; i < Path.Num(); ++i)
+	{
+		const FString& Token = Path.GetToken(i);
+		if (const int32* Child = Nodes[Current].Children.Find(Token))
+		{
+			Current = *Child;
+			continue;
+		}
+
+		FNode NewNode;
+		NewNode.Parent = Current;
+		NewNode.Token = Token;
+		const int32 Child = Nodes.Add(MoveTemp(NewNode));
+		Nodes[Current].Children.Add(Token, Child);
+		Current = Child;
+	}
+
+	Nodes[Current].Ids.Add(Id);
+	++NumIds;
+}
+
+void FJsonCRDTPathTrie::Remove(const FJsonCRDTPath& Path, int32 Id)
+{
+	int32 Current = FindNode(Path, Path.Num());
+	if (Current == INDEX_NONE || Nodes[Current].Ids.RemoveSingle(Id) == 0)
+	{
+		return;
+	}
+	--NumIds;
+
+	// 번호도 자식도 없는 노드는 루트 쪽으로 올라가며 정리
+	while (Current != 0 && Nodes[Current].Ids.Num() == 0 && Nodes[Current].Children.Num() == 0)
+	{
+		const int32 Parent = Nodes[Current].Parent;
+		Nodes[Parent].Children.Remove(Nodes[Current].Token);
+		Nodes.RemoveAt(Current);
+		Current = Parent;
+	}
+}
+
+void FJsonCRDTPathTrie::CollectAffected(const FJsonCRDTPath& Path, int32 NumTokens, TSet<int32>& OutIds) const
+{
+	// 바뀐 경로를 포함하는 상위 경로의 구독
+	int32 Current = 0;
+	for (int32 i = 0; i < NumTokens; ++i)
+	{
+		for (int32 Id : Nodes[Current].Ids)
+		{
+			OutIds.Add(Id);
+		}
+
+		const int32* Child = Nodes[Current].Children.Find(Path.GetToken(i));
+		if (!Child)
+		{
+			return;
+		}
+		Current = *Child;
+	}
+
+	// 바뀐 경로와 그 아래 경로의 구독
+	CollectSubtree(Current, OutIds);
+}
+
+void FJsonCRDTPathTrie::CollectArrayShift(const FJsonCRDTPath& Path, int32 NumTokens, int32 FirstIndex, TSet<int32>& OutIds) const
+{
+	int32 Current = 0;
+	for (int32 i = 0; i <= NumTokens; ++i)
+	{
+		for (int32 Id : Nodes[Current].Ids)
+		{
+			OutIds.Add(Id);
+		}
+
+		if (i == NumTokens)
+		{
+			break;
+		}
+
+		const int32* Child = Nodes[Current].Children.Find(Path.GetToken(i));
+		if (!Child)
+		{
+			return;
+		}
+		Current = *Child;
+	}
+
+	// 앞쪽 요소는 그대로이므로 밀린 요소의 구독만 모음
+	for (const TPair<FString, int32>& Child : Nodes[Current].Children)
+	{
+		int32 Index;
+		if (Child.Key.IsNumeric() && LexTryParseString(Index, *Child.Key) && Index >= FirstIndex)
+		{
+			CollectSubtree(Child.Value, OutIds);
+		}
+	}
+}
+
+void FJsonCRDTPathTrie::Reset()
+{
+	Nodes.Empty();
+	Nodes.Add(FNode());
+	NumIds = 0;
+}
+
+int32 FJsonCRDTPathTrie::FindNode(const FJsonCRDTPath& Path, int32 NumTokens) const
+{
+	int32 Current = 0;
+	for (int32 i = 0; i < NumTokens; ++i)
+	{
+		const int32* Child = Nodes[Current].Children.Find(Path.GetToken(i));
+		if (!Child)
+		{
+			return INDEX_NONE;
+		}
+		Current = *Child;
+	}
+	return Current;
+}
+
+void FJsonCRDTPathTrie::CollectSubtree(int32 NodeIndex, TSet<int32>& OutIds) const
+{
+	TArray<int32, TInlineAllocator<16>> Pending;
+	Pending.Add(NodeIndex);
+
+	while (Pending.Num() > 0)
+	{
+		const FNode& Node = Nodes[Pending.Pop()];
+		for (int32 Id : Node.Ids)
+		{
+			OutIds.Add(Id);
+		}
+		for (const TPair<FString, int32>& Child : Node.Children)
+		{
+			Pending.Add(Child.Value);
+		}
+	}
+}
@@ -0,0 +1,178 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "JsonCRDTPendingQueue.h"
+#include "JsonCRDTPath.h"
+
+namespace JsonCRDTPendingQueue
+{
+	/** Prefix의 앞 PrefixLength개 토큰이 Path의 앞부분과 같은지 확인 */
+	static bool IsPrefix(const FJsonCRDTPath& Prefix, int32 PrefixLength, const FJsonCRDTPath& Path)
+	{
+		if (PrefixLength > Path.Num())
+		{
+			return false;
+		}
+		for (int32 i = 0; i < PrefixLength; ++i)
+		{
+			if (!Prefix.GetToken(i).Equals(Path.GetToken(i), ESearchCase::CaseSensitive))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** 배열 위치를 바꾸거나 값을 새로 만들고 없애는 작업인지 확인 */
+	static bool IsStructural(EJsonCRDTOperationType Type)
+	{
+		return Type == EJsonCRDTOperationType::Add
+			|| Type == EJsonCRDTOperationType::Remove
+			|| Type == EJsonCRDTOperationType::Move
+			|| Type == EJsonCRDTOperationType::Copy;
+	}
+
+	/** 작업이 경로 Target의 값을 읽거나 바꿀 수 있는지 확인 */
+	static bool Touches(const FJsonCRDTOperation& Operation, const FJsonCRDTPath& Target)
+	{
+		FJsonCRDTPathCache& PathCache = FJsonCRDTPathCache::GetShared();
+
+		const bool bHasFrom = Operation.Type == EJsonCRDTOperationType::Move || Operation.Type == EJsonCRDTOperationType::Copy;
+		const FString* Paths[] = { &Operation.Path, bHasFrom ? &Operation.FromPath : nullptr };
+		for (const FString* PathString : Paths)
+		{
+			if (!PathString)
+			{
+				continue;
+			}
+
+			const TSharedRef<const FJsonCRDTPath, ESPMode::ThreadSafe> Path = PathCache.Get(*PathString);
+			if (IsPrefix(*Path, Path->Num(), Target) || IsPrefix(Target, Target.Num(), *Path))
+			{
+				return true;
+			}
+
+			// 같은 배열의 다른 위치도 삽입/삭제로 인덱스가 밀릴 수 있음
+			if (IsStructural(Operation.Type) && Path->Num() > 0 && IsPrefix(*Path, Path->Num() - 1, Target))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+FJsonCRDTPendingQueue::FJsonCRDTPendingQueue()
+	: NumFrozen(0)
+	, BaseVersion(0)
+	, OperationBytes(0)
+{
+}
+
+void FJsonCRDTPendingQueue::Add(FJsonCRDTOperation&& Operation, bool bCreatesValue, int64 InBaseVersion)
+{
+	if (Entries.Num() == 0)
+	{
+		BaseVersion = InBaseVersion;
+	}
+
+	const bool bMergeable = Operation.Type == EJsonCRDTOperationType::Replace || Operation.Type == EJsonCRDTOperationType::Remove;
+	for (int32 i = Entries.Num() - 1; bMergeable && i >= NumFrozen; --i)
+	{
+		FEntry& Entry = Entries[i];
+		const bool bSamePath = Entry.Operation.Path.Equals(Operation.Path, ESearchCase::CaseSensitive);
+
+		if (bSamePath && (Entry.Operation.Type == EJsonCRDTOperationType::Add || Entry.Operation.Type == EJsonCRDTOperationType::Replace))
+		{
+			if (Operation.Type == EJsonCRDTOperationType::Replace)
+			{
+				// 같은 경로의 값을 다시 바꾸면 앞선 작업에 마지막 값만 남김
+				OperationBytes -= Entry.Operation.Value.GetAllocatedSize();
+				Entry.Operation.Value = MoveTemp(Operation.Value);
+				OperationBytes += Entry.Operation.Value.GetAllocatedSize();
+				Entry.Operation.Timestamp = Operation.Timestamp;
+			}
+			else if (Entry.Operation.Type == EJsonCRDTOperationType::Add && Entry.bCreatesValue)
+			{
+				// 새로 만든 값을 다시 지우면 둘 다 보낼 필요가 없음
+				OperationBytes -= Entry.Operation.GetAllocatedSize();
+				Entries.RemoveAt(i);
+			}
+			else
+			{
+				// 기존 값을 바꾼 뒤 지우면 지우기만 보내면 됨
+				OperationBytes -= Entry.Operation.GetAllocatedSize();
+				Entry.Operation = MoveTemp(Operation);
+				OperationBytes += Entry.Operation.GetAllocatedSize();
+				Entry.bCreatesValue = false;
+			}
+			return;
+		}
+
+		if (Interferes(Entry.Operation, Operation))
+		{
+			break;
+		}
+	}
+
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Operation = MoveTemp(Operation);
+	Entry.bCreatesValue = bCreatesValue;
+	OperationBytes += Entry.Operation.GetAllocatedSize();
+}
+
+bool FJsonCRDTPendingQueue::Take(TArray<FJsonCRDTOperation>& OutOperations, int64& OutBaseVersion)
+{
+	OutOperations.Reset(Entries.Num());
+	for (FEntry& Entry : Entries)
+	{
+		OutOperations.Add(MoveTemp(Entry.Operation));
+	}
+	OutBaseVersion = BaseVersion;
+
+	Empty();
+	return OutOperations.Num() > 0;
+}
+
+void FJsonCRDTPendingQueue::Requeue(TArray<FJsonCRDTOperation>&& Operations, int64 InBaseVersion)
+{
+	if (Operations.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<FEntry> Requeued;
+	Requeued.Reserve(Operations.Num() + Entries.Num());
+	for (FJsonCRDTOperation& Operation : Operations)
+	{
+		OperationBytes += Operation.GetAllocatedSize();
+		Requeued.AddDefaulted_GetRef().Operation = MoveTemp(Operation);
+	}
+	Requeued.Append(MoveTemp(Entries));
+
+	// 되돌린 작업은 값을 새로 만들었는지 알 수 없으므로 이후 작업과 합치지 않음
+	NumFrozen += Operations.Num();
+	Entries = MoveTemp(Requeued);
+	BaseVersion = InBaseVersion;
+}
+
+void FJsonCRDTPendingQueue::Empty()
+{
+	Entries.Reset();
+	NumFrozen = 0;
+	BaseVersion = 0;
+	OperationBytes = 0;
+}
+
+bool FJsonCRDTPendingQueue::Interferes(const FJsonCRDTOperation& Between, const FJsonCRDTOperation& Operation)
+{
+	using namespace JsonCRDTPendingQueue;
+
+	FJsonCRDTPathCache& PathCache = FJsonCRDTPathCache::GetShared();
+	if (Touches(Between, *PathCache.Get(Operation.Path)) || Touches(Operation, *PathCache.Get(Between.Path)))
+	{
+		return true;
+	}
+
+	const bool bBetweenHasFrom = Between.Type == EJsonCRDTOperationType::Move || Between.Type == EJsonCRDTOperationType::Copy;
+	return bBetweenHasFrom && Touches(Operation, *PathCache.Get(Between.FromPath));
+}
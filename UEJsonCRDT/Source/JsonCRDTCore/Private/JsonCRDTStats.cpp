@@ -0,0 +1,21 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "JsonCRDTStats.h"
+
+DEFINE_STAT(STAT_JsonCRDT_ApplyPatch);
+DEFINE_STAT(STAT_JsonCRDT_ApplyOperation);
+DEFINE_STAT(STAT_JsonCRDT_CreateAndAddSnapshot);
+DEFINE_STAT(STAT_JsonCRDT_SaveLocally);
+DEFINE_STAT(STAT_JsonCRDT_SendPatch);
+DEFINE_STAT(STAT_JsonCRDT_OnWebSocketMessage);
+DEFINE_STAT(STAT_JsonCRDT_ProcessReceivedPatches);
+
+DEFINE_STAT(STAT_JsonCRDT_BytesSent);
+DEFINE_STAT(STAT_JsonCRDT_BytesReceived);
+DEFINE_STAT(STAT_JsonCRDT_PatchesApplied);
+DEFINE_STAT(STAT_JsonCRDT_ConflictsResolved);
+
+DEFINE_STAT(STAT_JsonCRDT_ReceivedQueueDepth);
+DEFINE_STAT(STAT_JsonCRDT_PendingOperations);
+DEFINE_STAT(STAT_JsonCRDT_OfflineQueuedOperations);
+DEFINE_STAT(STAT_JsonCRDT_DocumentMemory);
@@ -0,0 +1,285 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "JsonCRDTBinaryCodec.h"
+#include "JsonCRDTJournal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace JsonCRDTBinaryCodecSpec
+{
+	/** 작업 유형마다 하나씩 담은 패치 (값에는 유니코드와 이스케이프가 들어감) */
+	static FJsonCRDTPatch MakePatch(int64 BaseVersion)
+	{
+		const FDateTime Time(638000000000000000LL + BaseVersion);
+
+		FJsonCRDTPatch Patch;
+		Patch.DocumentID = TEXT("codec-doc");
+		Patch.BaseVersion = BaseVersion;
+		Patch.ClientID = TEXT("client-a");
+		Patch.Timestamp = Time;
+
+		static const EJsonCRDTOperationType Types[] =
+		{
+			EJsonCRDTOperationType::Add,
+			EJsonCRDTOperationType::Remove,
+			EJsonCRDTOperationType::Replace,
+			EJsonCRDTOperationType::Move,
+			EJsonCRDTOperationType::Copy,
+			EJsonCRDTOperationType::Test
+		};
+		for (int32 i = 0; i < UE_ARRAY_COUNT(Types); ++i)
+		{
+			FJsonCRDTOperation& Operation = Patch.Operations.AddDefaulted_GetRef();
+			Operation.Type = Types[i];
+			Operation.Path = FString::Printf(TEXT("/items/%d/name"), i);
+			if (Types[i] == EJsonCRDTOperationType::Move || Types[i] == EJsonCRDTOperationType::Copy)
+			{
+				Operation.FromPath = TEXT("/items/0");
+			}
+			if (Types[i] == EJsonCRDTOperationType::Add || Types[i] == EJsonCRDTOperationType::Replace || Types[i] == EJsonCRDTOperationType::Test)
+			{
+				Operation.Value = FString::Printf(TEXT("{\"text\":\"\\\"%d\\\" \u00E9\u4E2D\",\"n\":-1.5}"), i);
+			}
+			Operation.Timestamp = FDateTime(Time.GetTicks() + i);
+			Operation.ClientID = Patch.ClientID;
+		}
+		return Patch;
+	}
+}
+
+BEGIN_DEFINE_SPEC(FJsonCRDTBinaryCodecSpec, "JsonCRDT.Core.BinaryCodec", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+	/** 인코딩에 담기는 필드 비교 (클라이언트 ID는 bCompareClientID일 때만) */
+	void TestPatchEqual(const FString& What, const FJsonCRDTPatch& Actual, const FJsonCRDTPatch& Expected, bool bCompareClientID);
+END_DEFINE_SPEC(FJsonCRDTBinaryCodecSpec)
+
+void FJsonCRDTBinaryCodecSpec::TestPatchEqual(const FString& What, const FJsonCRDTPatch& Actual, const FJsonCRDTPatch& Expected, bool bCompareClientID)
+{
+	TestEqual(What + TEXT(" DocumentID"), Actual.DocumentID, Expected.DocumentID);
+	TestEqual(What + TEXT(" BaseVersion"), Actual.BaseVersion, Expected.BaseVersion);
+	TestEqual(What + TEXT(" Timestamp"), Actual.Timestamp.GetTicks(), Expected.Timestamp.GetTicks());
+	TestEqual(What + TEXT(" Sequence"), Actual.Sequence, Expected.Sequence);
+	TestEqual(What + TEXT(" VersionVector"), Actual.VersionVector.Num(), Expected.VersionVector.Num());
+	for (const TPair<FString, int64>& Entry : Expected.VersionVector)
+	{
+		const int64* Sequence = Actual.VersionVector.Find(Entry.Key);
+		TestTrue(What + TEXT(" VersionVector entry ") + Entry.Key, Sequence && *Sequence == Entry.Value);
+	}
+	if (bCompareClientID)
+	{
+		TestEqual(What + TEXT(" ClientID"), Actual.ClientID, Expected.ClientID);
+	}
+
+	if (!TestEqual(What + TEXT(" Operations"), Actual.Operations.Num(), Expected.Operations.Num()))
+	{
+		return;
+	}
+	for (int32 i = 0; i < Expected.Operations.Num(); ++i)
+	{
+		const FJsonCRDTOperation& ActualOperation = Actual.Operations[i];
+		const FJsonCRDTOperation& ExpectedOperation = Expected.Operations[i];
+		const FString OperationWhat = FString::Printf(TEXT("%s operation %d"), *What, i);
+		TestEqual(OperationWhat + TEXT(" Type"), (int32)ActualOperation.Type, (int32)ExpectedOperation.Type);
+		TestEqual(OperationWhat + TEXT(" Path"), ActualOperation.Path, ExpectedOperation.Path);
+		TestEqual(OperationWhat + TEXT(" FromPath"), ActualOperation.FromPath, ExpectedOperation.FromPath);
+		TestEqual(OperationWhat + TEXT(" Value"), ActualOperation.Value, ExpectedOperation.Value);
+		TestEqual(OperationWhat + TEXT(" Timestamp"), ActualOperation.Timestamp.GetTicks(), ExpectedOperation.Timestamp.GetTicks());
+	}
+}
+
+void FJsonCRDTBinaryCodecSpec::Define()
+{
+	using namespace JsonCRDTBinaryCodecSpec;
+
+	Describe("FJsonCRDTStringDictionary", [this]()
+	{
+		It("numbers strings in insertion order", [this]()
+		{
+			FJsonCRDTStringDictionary Dictionary(8);
+			TestEqual(TEXT("First"), Dictionary.Add(TEXT("/a")), 0);
+			TestEqual(TEXT("Second"), Dictionary.Add(TEXT("/b")), 1);
+			TestEqual(TEXT("Find"), Dictionary.Find(TEXT("/b")), 1);
+			TestEqual(TEXT("Find missing"), Dictionary.Find(TEXT("/c")), (int32)INDEX_NONE);
+			TestTrue(TEXT("Get"), Dictionary.Get(0) && *Dictionary.Get(0) == TEXT("/a"));
+			TestNull(TEXT("Get missing"), Dictionary.Get(2));
+		});
+
+		It("is case sensitive", [this]()
+		{
+			FJsonCRDTStringDictionary Dictionary(8);
+			Dictionary.Add(TEXT("/Key"));
+			TestEqual(TEXT("Other case"), Dictionary.Find(TEXT("/key")), (int32)INDEX_NONE);
+		});
+
+		It("stops adding when full", [this]()
+		{
+			FJsonCRDTStringDictionary Dictionary(2);
+			Dictionary.Add(TEXT("a"));
+			Dictionary.Add(TEXT("b"));
+			TestFalse(TEXT("HasCapacity"), Dictionary.HasCapacity());
+			TestEqual(TEXT("Add when full"), Dictionary.Add(TEXT("c")), (int32)INDEX_NONE);
+
+			Dictionary.Reset();
+			TestTrue(TEXT("HasCapacity after Reset"), Dictionary.HasCapacity());
+			TestEqual(TEXT("Find after Reset"), Dictionary.Find(TEXT("a")), (int32)INDEX_NONE);
+		});
+	});
+
+	Describe("FJsonCRDTBinaryCodec", [this]()
+	{
+		It("round-trips every operation type", [this]()
+		{
+			const FJsonCRDTPatch Patch = MakePatch(7);
+
+			FJsonCRDTBinaryCodec Encoder;
+			FJsonCRDTBinaryCodec Decoder;
+			TArray<uint8> Frame;
+			Encoder.EncodePatch(Patch, Frame, true);
+			TestTrue(TEXT("IsBinaryFrame"), FJsonCRDTBinaryCodec::IsBinaryFrame(Frame.GetData(), Frame.Num()));
+
+			TArray<FJsonCRDTPatch> Decoded;
+			TestTrue(TEXT("Decoded"), Decoder.DecodeFrame(Frame.GetData(), Frame.Num(), Decoded));
+			if (TestEqual(TEXT("Patches"), Decoded.Num(), 1))
+			{
+				TestPatchEqual(TEXT("Patch"), Decoded[0], Patch, true);
+				TestEqual(TEXT("Operation ClientID"), Decoded[0].Operations[0].ClientID, Patch.ClientID);
+			}
+		});
+
+		It("omits the client ID unless asked to include it", [this]()
+		{
+			FJsonCRDTBinaryCodec Encoder;
+			FJsonCRDTBinaryCodec Decoder;
+			TArray<uint8> Frame;
+			Encoder.EncodePatch(MakePatch(1), Frame);
+
+			TArray<FJsonCRDTPatch> Decoded;
+			TestTrue(TEXT("Decoded"), Decoder.DecodeFrame(Frame.GetData(), Frame.Num(), Decoded));
+			TestTrue(TEXT("No ClientID"), Decoded.Num() == 1 && Decoded[0].ClientID.IsEmpty());
+		});
+
+		It("carries the sequence and version vector when present", [this]()
+		{
+			FJsonCRDTPatch Patch = MakePatch(3);
+			Patch.Sequence = 42;
+			Patch.VersionVector.Add(TEXT("client-a"), 41);
+			Patch.VersionVector.Add(TEXT("client-b"), 5);
+
+			FJsonCRDTBinaryCodec Encoder;
+			FJsonCRDTBinaryCodec Decoder;
+			TArray<uint8> Frame;
+			Encoder.EncodePatch(Patch, Frame);
+
+			TArray<FJsonCRDTPatch> Decoded;
+			TestTrue(TEXT("Decoded"), Decoder.DecodeFrame(Frame.GetData(), Frame.Num(), Decoded));
+			if (TestEqual(TEXT("Patches"), Decoded.Num(), 1))
+			{
+				TestPatchEqual(TEXT("Patch"), Decoded[0], Patch, false);
+			}
+		});
+
+		It("reuses dictionary entries across frames of one connection", [this]()
+		{
+			const FJsonCRDTPatch First = MakePatch(1);
+			const FJsonCRDTPatch Second = MakePatch(2);
+
+			FJsonCRDTBinaryCodec Encoder;
+			FJsonCRDTBinaryCodec Decoder;
+			TArray<uint8> FirstFrame;
+			TArray<uint8> SecondFrame;
+			Encoder.EncodePatch(First, FirstFrame);
+			Encoder.EncodePatch(Second, SecondFrame);
+			TestTrue(TEXT("Second frame is smaller"), SecondFrame.Num() < FirstFrame.Num());
+
+			TArray<FJsonCRDTPatch> Decoded;
+			TestTrue(TEXT("First decoded"), Decoder.DecodeFrame(FirstFrame.GetData(), FirstFrame.Num(), Decoded));
+			TestTrue(TEXT("Second decoded"), Decoder.DecodeFrame(SecondFrame.GetData(), SecondFrame.Num(), Decoded));
+			if (TestEqual(TEXT("Patches"), Decoded.Num(), 2))
+			{
+				TestPatchEqual(TEXT("First"), Decoded[0], First, false);
+				TestPatchEqual(TEXT("Second"), Decoded[1], Second, false);
+			}
+		});
+
+		It("encodes several patches into one frame", [this]()
+		{
+			const TArray<FJsonCRDTPatch> Patches = { MakePatch(1), MakePatch(2), MakePatch(3) };
+
+			FJsonCRDTBinaryCodec Encoder;
+			FJsonCRDTBinaryCodec Decoder;
+			TArray<uint8> Frame;
+			Encoder.EncodePatches(Patches, Frame);
+
+			TArray<FJsonCRDTPatch> Decoded;
+			TestTrue(TEXT("Decoded"), Decoder.DecodeFrame(Frame.GetData(), Frame.Num(), Decoded));
+			if (TestEqual(TEXT("Patches"), Decoded.Num(), Patches.Num()))
+			{
+				for (int32 i = 0; i < Patches.Num(); ++i)
+				{
+					TestPatchEqual(FString::Printf(TEXT("Patch %d"), i), Decoded[i], Patches[i], false);
+				}
+			}
+		});
+
+		It("rejects JSON text and truncated frames", [this]()
+		{
+			const FTCHARToUTF8 Json(TEXT("{\"type\":\"patch\"}"));
+			TestFalse(TEXT("JSON is not binary"), FJsonCRDTBinaryCodec::IsBinaryFrame(reinterpret_cast<const uint8*>(Json.Get()), Json.Length()));
+			TestFalse(TEXT("Empty"), FJsonCRDTBinaryCodec::IsBinaryFrame(nullptr, 0));
+
+			FJsonCRDTBinaryCodec Encoder;
+			TArray<uint8> Frame;
+			Encoder.EncodePatch(MakePatch(1), Frame);
+
+			FJsonCRDTBinaryCodec Decoder;
+			TArray<FJsonCRDTPatch> Decoded;
+			TestFalse(TEXT("Truncated"), Decoder.DecodeFrame(Frame.GetData(), Frame.Num() / 2, Decoded));
+		});
+	});
+
+	Describe("FJsonCRDTJournal", [this]()
+	{
+		It("reads back appended records in order", [this]()
+		{
+			TArray<uint8> Bytes;
+			FJsonCRDTJournal::AppendRecord(MakePatch(1), Bytes);
+			FJsonCRDTJournal::AppendRecord(MakePatch(2), Bytes);
+
+			TArray<FJsonCRDTPatch> Records;
+			TestEqual(TEXT("Intact bytes"), FJsonCRDTJournal::ReadRecords(Bytes, Records), Bytes.Num());
+			if (TestEqual(TEXT("Records"), Records.Num(), 2))
+			{
+				TestPatchEqual(TEXT("First"), Records[0], MakePatch(1), false);
+				TestPatchEqual(TEXT("Second"), Records[1], MakePatch(2), false);
+			}
+		});
+
+		It("stops at a truncated record", [this]()
+		{
+			TArray<uint8> Bytes;
+			FJsonCRDTJournal::AppendRecord(MakePatch(1), Bytes);
+			const int32 FirstRecordSize = Bytes.Num();
+			FJsonCRDTJournal::AppendRecord(MakePatch(2), Bytes);
+			Bytes.SetNum(Bytes.Num() - 3);
+
+			TArray<FJsonCRDTPatch> Records;
+			TestEqual(TEXT("Intact bytes"), FJsonCRDTJournal::ReadRecords(Bytes, Records), FirstRecordSize);
+			TestEqual(TEXT("Records"), Records.Num(), 1);
+		});
+
+		It("stops at a record whose checksum does not match", [this]()
+		{
+			TArray<uint8> Bytes;
+			FJsonCRDTJournal::AppendRecord(MakePatch(1), Bytes);
+			const int32 FirstRecordSize = Bytes.Num();
+			FJsonCRDTJournal::AppendRecord(MakePatch(2), Bytes);
+			Bytes[FirstRecordSize + FJsonCRDTJournal::RecordHeaderSize + 4] ^= 0xFF;
+
+			TArray<FJsonCRDTPatch> Records;
+			TestEqual(TEXT("Intact bytes"), FJsonCRDTJournal::ReadRecords(Bytes, Records), FirstRecordSize);
+			TestEqual(TEXT("Records"), Records.Num(), 1);
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,200 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "JsonCRDTDocumentCore.h"
+#include "JsonCRDTSpecHelpers.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace JsonCRDTDocumentCoreSpec
+{
+	using JsonCRDTSpecHelpers::JsonEquals;
+
+	/** 문서 ID */
+	static const TCHAR* DocumentID = TEXT("core-doc");
+
+	/** 작업 하나 */
+	static FJsonCRDTOperation MakeOperation(EJsonCRDTOperationType Type, const TCHAR* Path, const TCHAR* Value = TEXT(""))
+	{
+		FJsonCRDTOperation Operation;
+		Operation.Type = Type;
+		Operation.Path = Path;
+		Operation.Value = Value;
+		return Operation;
+	}
+
+	/** 원격 패치 (Sequence가 0이면 번호 없는 패치) */
+	static FJsonCRDTPatch MakePatch(const TArray<FJsonCRDTOperation>& Operations, int64 Sequence = 0, const TCHAR* ClientID = TEXT("remote"))
+	{
+		FJsonCRDTPatch Patch;
+		Patch.DocumentID = DocumentID;
+		Patch.ClientID = ClientID;
+		Patch.Sequence = Sequence;
+		Patch.Timestamp = FDateTime::UtcNow();
+		Patch.Operations = Operations;
+		for (FJsonCRDTOperation& Operation : Patch.Operations)
+		{
+			Operation.ClientID = ClientID;
+			Operation.Timestamp = Patch.Timestamp;
+		}
+		return Patch;
+	}
+}
+
+BEGIN_DEFINE_SPEC(FJsonCRDTDocumentCoreSpec, "JsonCRDT.Core.DocumentCore", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+	TUniquePtr<FJsonCRDTDocumentCore> Document;
+
+	/** 경로의 값 (없으면 빈 문자열) */
+	FString ValueAt(const TCHAR* Path) const
+	{
+		FString Value;
+		Document->GetValueAtPath(Path, Value);
+		return Value;
+	}
+END_DEFINE_SPEC(FJsonCRDTDocumentCoreSpec)
+
+void FJsonCRDTDocumentCoreSpec::Define()
+{
+	using namespace JsonCRDTDocumentCoreSpec;
+
+	BeforeEach([this]()
+	{
+		Document = MakeUnique<FJsonCRDTDocumentCore>(DocumentID);
+		Document->SetContentFromString(TEXT("{\"name\":\"a\",\"list\":[1,2]}"));
+	});
+
+	AfterEach([this]()
+	{
+		Document.Reset();
+	});
+
+	Describe("Content", [this]()
+	{
+		It("bumps the version when the content is set", [this]()
+		{
+			TestEqual(TEXT("Version"), Document->GetVersion(), (int64)2);
+			TestFalse(TEXT("Invalid JSON"), Document->SetContentFromString(TEXT("[")));
+			TestEqual(TEXT("Version after invalid JSON"), Document->GetVersion(), (int64)2);
+		});
+
+		It("resolves the empty path to the whole document", [this]()
+		{
+			TestEqual(TEXT("Root"), Document->FindNodeAtPath(TEXT("")), Document->GetContent().GetRoot());
+			TestTrue(TEXT("Value"), ValueAt(TEXT("")).StartsWith(TEXT("{")));
+			TestTrue(TEXT("Field"), JsonEquals(ValueAt(TEXT("/name")), TEXT("\"a\"")));
+			TestEqual(TEXT("Missing"), Document->FindNodeAtPath(TEXT("/missing")), (int32)INDEX_NONE);
+		});
+	});
+
+	Describe("ApplyLocalOperations", [this]()
+	{
+		It("applies the operations and records them with a timestamp", [this]()
+		{
+			TestTrue(TEXT("Applied"), Document->ApplyLocalOperations({ MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/name"), TEXT("\"b\"")) }));
+			TestTrue(TEXT("Value"), JsonEquals(ValueAt(TEXT("/name")), TEXT("\"b\"")));
+			TestEqual(TEXT("Version"), Document->GetVersion(), (int64)3);
+			if (TestEqual(TEXT("History"), Document->GetOperationHistory().Num(), 1))
+			{
+				TestTrue(TEXT("Timestamp"), Document->GetOperationHistory().Get(0).Timestamp.GetTicks() != 0);
+			}
+		});
+
+		It("changes nothing when an operation fails", [this]()
+		{
+			const TArray<FJsonCRDTOperation> Operations =
+			{
+				MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/name"), TEXT("\"b\"")),
+				MakeOperation(EJsonCRDTOperationType::Remove, TEXT("/missing"))
+			};
+			AddExpectedError(TEXT("Failed to apply local operation"), EAutomationExpectedErrorFlags::Contains, 1);
+			TestFalse(TEXT("Applied"), Document->ApplyLocalOperations(Operations));
+			TestTrue(TEXT("Value"), JsonEquals(ValueAt(TEXT("/name")), TEXT("\"a\"")));
+			TestEqual(TEXT("Version"), Document->GetVersion(), (int64)2);
+			TestEqual(TEXT("History"), Document->GetOperationHistory().Num(), 0);
+		});
+	});
+
+	Describe("ApplyPatch", [this]()
+	{
+		It("applies a patch and moves its operations into the history", [this]()
+		{
+			FJsonCRDTPatch Patch = MakePatch({ MakeOperation(EJsonCRDTOperationType::Add, TEXT("/list/-"), TEXT("3")) }, 1);
+			TestTrue(TEXT("Applied"), Document->ApplyPatch(MoveTemp(Patch)));
+			TestTrue(TEXT("Value"), JsonEquals(ValueAt(TEXT("/list/2")), TEXT("3")));
+			TestEqual(TEXT("Version"), Document->GetVersion(), (int64)3);
+			TestEqual(TEXT("History"), Document->GetOperationHistory().Num(), 1);
+			TestEqual(TEXT("History ClientID"), Document->GetOperationHistory().GetClientID(Document->GetOperationHistory().GetOldestSequence()), FString(TEXT("remote")));
+			TestTrue(TEXT("Sequence recorded"), Document->GetVersionVector().FindRef(TEXT("remote")) == 1);
+		});
+
+		It("skips a patch that was already applied", [this]()
+		{
+			const FJsonCRDTPatch Patch = MakePatch({ MakeOperation(EJsonCRDTOperationType::Add, TEXT("/list/-"), TEXT("3")) }, 4);
+			TestTrue(TEXT("First"), Document->ApplyPatch(Patch));
+			TestTrue(TEXT("Resend"), Document->ApplyPatch(Patch));
+			TestTrue(TEXT("Older"), Document->ApplyPatch(MakePatch({ MakeOperation(EJsonCRDTOperationType::Add, TEXT("/list/-"), TEXT("9")) }, 2)));
+
+			TestEqual(TEXT("Version"), Document->GetVersion(), (int64)3);
+			TestTrue(TEXT("List"), JsonEquals(ValueAt(TEXT("/list")), TEXT("[1,2,3]")));
+		});
+
+		It("applies unnumbered patches every time", [this]()
+		{
+			const FJsonCRDTPatch Patch = MakePatch({ MakeOperation(EJsonCRDTOperationType::Add, TEXT("/list/-"), TEXT("3")) });
+			TestTrue(TEXT("First"), Document->ApplyPatch(Patch));
+			TestTrue(TEXT("Second"), Document->ApplyPatch(Patch));
+			TestTrue(TEXT("List"), JsonEquals(ValueAt(TEXT("/list")), TEXT("[1,2,3,3]")));
+			TestEqual(TEXT("Version vector"), Document->GetVersionVector().Num(), 0);
+		});
+
+		It("rolls back the whole patch when an operation fails", [this]()
+		{
+			const FJsonCRDTPatch Patch = MakePatch(
+			{
+				MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/name"), TEXT("\"b\"")),
+				MakeOperation(EJsonCRDTOperationType::Remove, TEXT("/list/0")),
+				MakeOperation(EJsonCRDTOperationType::Test, TEXT("/name"), TEXT("\"a\""))
+			}, 1);
+
+			AddExpectedError(TEXT("Failed to apply operation"), EAutomationExpectedErrorFlags::Contains, 1);
+			TestFalse(TEXT("Applied"), Document->ApplyPatch(Patch));
+			TestTrue(TEXT("Name"), JsonEquals(ValueAt(TEXT("/name")), TEXT("\"a\"")));
+			TestTrue(TEXT("List"), JsonEquals(ValueAt(TEXT("/list")), TEXT("[1,2]")));
+			TestEqual(TEXT("Version"), Document->GetVersion(), (int64)2);
+			TestEqual(TEXT("History"), Document->GetOperationHistory().Num(), 0);
+			TestFalse(TEXT("Sequence not recorded"), Document->GetVersionVector().Contains(TEXT("remote")));
+		});
+
+		It("rejects patches for another document", [this]()
+		{
+			FJsonCRDTPatch Patch = MakePatch({ MakeOperation(EJsonCRDTOperationType::Remove, TEXT("/name")) }, 1);
+			Patch.DocumentID = TEXT("other-doc");
+
+			AddExpectedError(TEXT("Patch document ID does not match"), EAutomationExpectedErrorFlags::Contains, 1);
+			TestFalse(TEXT("Applied"), Document->ApplyPatch(Patch));
+			TestTrue(TEXT("Name"), JsonEquals(ValueAt(TEXT("/name")), TEXT("\"a\"")));
+		});
+
+		It("keeps the version for an empty patch but records its sequence", [this]()
+		{
+			TestTrue(TEXT("Applied"), Document->ApplyPatch(MakePatch({}, 7)));
+			TestEqual(TEXT("Version"), Document->GetVersion(), (int64)2);
+			TestTrue(TEXT("Sequence recorded"), Document->GetVersionVector().FindRef(TEXT("remote")) == 7);
+		});
+	});
+
+	Describe("GetAllocatedSize", [this]()
+	{
+		It("grows with the content and the history", [this]()
+		{
+			const SIZE_T Before = Document->GetAllocatedSize();
+			const FString LongValue = TEXT("\"") + FString::ChrN(1000, TEXT('x')) + TEXT("\"");
+			TestTrue(TEXT("Applied"), Document->ApplyLocalOperations({ MakeOperation(EJsonCRDTOperationType::Add, TEXT("/long"), *LongValue) }));
+
+			// 내용의 문자열과 히스토리의 작업 값이 모두 셈에 들어감
+			TestTrue(TEXT("Grows"), Document->GetAllocatedSize() >= Before + 2 * 1000 * sizeof(TCHAR));
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
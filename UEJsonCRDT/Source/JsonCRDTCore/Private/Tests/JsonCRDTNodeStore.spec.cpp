@@ -0,0 +1,250 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "JsonCRDTNodeStore.h"
+#include "JsonCRDTPath.h"
+#include "JsonCRDTSpecHelpers.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace JsonCRDTNodeStoreSpec
+{
+	using JsonCRDTSpecHelpers::JsonEquals;
+
+	/** 경로의 노드를 JSON 문자열로 (없으면 빈 문자열) */
+	static FString ValueAt(const FJsonCRDTNodeStore& Store, const TCHAR* Path)
+	{
+		const int32 NodeIndex = Store.Resolve(FJsonCRDTPath(Path));
+		return NodeIndex != INDEX_NONE ? Store.NodeToString(NodeIndex) : FString();
+	}
+}
+
+BEGIN_DEFINE_SPEC(FJsonCRDTNodeStoreSpec, "JsonCRDT.Core.NodeStore", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+	FJsonCRDTNodeStore Store;
+END_DEFINE_SPEC(FJsonCRDTNodeStoreSpec)
+
+void FJsonCRDTNodeStoreSpec::Define()
+{
+	using namespace JsonCRDTNodeStoreSpec;
+
+	BeforeEach([this]()
+	{
+		Store.Reset();
+		Store.LoadFromString(TEXT("{\"name\":\"a\",\"count\":1,\"flag\":true,\"none\":null,\"list\":[1,2,3],\"nested\":{\"x\":{\"y\":\"z\"}}}"));
+	});
+
+	Describe("LoadFromString", [this]()
+	{
+		It("starts as an empty object", [this]()
+		{
+			FJsonCRDTNodeStore Empty;
+			TestTrue(TEXT("Empty root"), JsonEquals(Empty.NodeToString(Empty.GetRoot()), TEXT("{}")));
+		});
+
+		It("round-trips the content", [this]()
+		{
+			TestTrue(TEXT("Content"), JsonEquals(Store.ToString(), TEXT("{\"name\":\"a\",\"count\":1,\"flag\":true,\"none\":null,\"list\":[1,2,3],\"nested\":{\"x\":{\"y\":\"z\"}}}")));
+		});
+
+		It("keeps the content when the JSON is invalid", [this]()
+		{
+			TestFalse(TEXT("Loaded"), Store.LoadFromString(TEXT("{\"broken\":")));
+			TestTrue(TEXT("Content kept"), JsonEquals(ValueAt(Store, TEXT("/name")), TEXT("\"a\"")));
+		});
+	});
+
+	Describe("Resolve", [this]()
+	{
+		It("finds object fields and array elements", [this]()
+		{
+			TestTrue(TEXT("/nested/x/y"), JsonEquals(ValueAt(Store, TEXT("/nested/x/y")), TEXT("\"z\"")));
+			TestTrue(TEXT("/list/1"), JsonEquals(ValueAt(Store, TEXT("/list/1")), TEXT("2")));
+		});
+
+		It("returns INDEX_NONE for missing paths", [this]()
+		{
+			TestEqual(TEXT("Missing field"), Store.Resolve(FJsonCRDTPath(TEXT("/missing"))), (int32)INDEX_NONE);
+			TestEqual(TEXT("Out of range"), Store.Resolve(FJsonCRDTPath(TEXT("/list/3"))), (int32)INDEX_NONE);
+			TestEqual(TEXT("Through a scalar"), Store.Resolve(FJsonCRDTPath(TEXT("/name/x"))), (int32)INDEX_NONE);
+		});
+
+		It("resolves the root path to the root", [this]()
+		{
+			TestEqual(TEXT("Root"), Store.Resolve(FJsonCRDTPath(TEXT(""))), Store.GetRoot());
+		});
+	});
+
+	Describe("Add", [this]()
+	{
+		It("adds and overwrites object fields", [this]()
+		{
+			TestTrue(TEXT("Add new"), Store.Add(FJsonCRDTPath(TEXT("/added")), Store.ParseValue(TEXT("{\"a\":[true]}"))));
+			TestTrue(TEXT("Added"), JsonEquals(ValueAt(Store, TEXT("/added")), TEXT("{\"a\":[true]}")));
+
+			TestTrue(TEXT("Overwrite"), Store.Add(FJsonCRDTPath(TEXT("/count")), Store.ParseValue(TEXT("\"two\""))));
+			TestTrue(TEXT("Overwritten"), JsonEquals(ValueAt(Store, TEXT("/count")), TEXT("\"two\"")));
+		});
+
+		It("inserts into arrays and appends with '-'", [this]()
+		{
+			TestTrue(TEXT("Insert"), Store.Add(FJsonCRDTPath(TEXT("/list/0")), Store.ParseValue(TEXT("0"))));
+			TestTrue(TEXT("Append"), Store.Add(FJsonCRDTPath(TEXT("/list/-")), Store.ParseValue(TEXT("4"))));
+			TestTrue(TEXT("List"), JsonEquals(ValueAt(Store, TEXT("/list")), TEXT("[0,1,2,3,4]")));
+		});
+
+		It("fails when the parent does not exist", [this]()
+		{
+			TestFalse(TEXT("Missing parent"), Store.Add(FJsonCRDTPath(TEXT("/missing/child")), Store.ParseValue(TEXT("1"))));
+			TestFalse(TEXT("Past the end"), Store.Add(FJsonCRDTPath(TEXT("/list/5")), Store.ParseValue(TEXT("1"))));
+		});
+	});
+
+	Describe("Remove and Replace", [this]()
+	{
+		It("removes fields and shifts array elements", [this]()
+		{
+			TestTrue(TEXT("Remove field"), Store.Remove(FJsonCRDTPath(TEXT("/name"))));
+			TestEqual(TEXT("Field gone"), Store.Resolve(FJsonCRDTPath(TEXT("/name"))), (int32)INDEX_NONE);
+
+			TestTrue(TEXT("Remove element"), Store.Remove(FJsonCRDTPath(TEXT("/list/0"))));
+			TestTrue(TEXT("List"), JsonEquals(ValueAt(Store, TEXT("/list")), TEXT("[2,3]")));
+		});
+
+		It("does not remove the root or missing paths", [this]()
+		{
+			TestFalse(TEXT("Root"), Store.Remove(FJsonCRDTPath(TEXT(""))));
+			TestFalse(TEXT("Missing"), Store.Remove(FJsonCRDTPath(TEXT("/missing"))));
+		});
+
+		It("replaces only existing values", [this]()
+		{
+			TestTrue(TEXT("Replace"), Store.Replace(FJsonCRDTPath(TEXT("/nested/x")), Store.ParseValue(TEXT("[1]"))));
+			TestTrue(TEXT("Replaced"), JsonEquals(ValueAt(Store, TEXT("/nested")), TEXT("{\"x\":[1]}")));
+			TestFalse(TEXT("Missing"), Store.Replace(FJsonCRDTPath(TEXT("/missing")), Store.ParseValue(TEXT("1"))));
+		});
+	});
+
+	Describe("Move, Copy and Test", [this]()
+	{
+		It("moves a value to another path", [this]()
+		{
+			TestTrue(TEXT("Move"), Store.Move(FJsonCRDTPath(TEXT("/nested/x")), FJsonCRDTPath(TEXT("/moved")), 0));
+			TestTrue(TEXT("Moved"), JsonEquals(ValueAt(Store, TEXT("/moved")), TEXT("{\"y\":\"z\"}")));
+			TestTrue(TEXT("Source empty"), JsonEquals(ValueAt(Store, TEXT("/nested")), TEXT("{}")));
+		});
+
+		It("does not move a value into its own subtree", [this]()
+		{
+			TestFalse(TEXT("Move"), Store.Move(FJsonCRDTPath(TEXT("/nested")), FJsonCRDTPath(TEXT("/nested/x/inner")), 0));
+			TestTrue(TEXT("Unchanged"), JsonEquals(ValueAt(Store, TEXT("/nested")), TEXT("{\"x\":{\"y\":\"z\"}}")));
+		});
+
+		It("copies a subtree without sharing nodes", [this]()
+		{
+			TestTrue(TEXT("Copy"), Store.Copy(FJsonCRDTPath(TEXT("/nested")), FJsonCRDTPath(TEXT("/copy")), 0));
+			TestTrue(TEXT("Replace copy"), Store.Replace(FJsonCRDTPath(TEXT("/copy/x/y")), Store.ParseValue(TEXT("1"))));
+			TestTrue(TEXT("Original"), JsonEquals(ValueAt(Store, TEXT("/nested/x/y")), TEXT("\"z\"")));
+			TestTrue(TEXT("Copy"), JsonEquals(ValueAt(Store, TEXT("/copy/x/y")), TEXT("1")));
+		});
+
+		It("tests values deeply and compares numbers by value", [this]()
+		{
+			const int32 List = Store.ParseValue(TEXT("[1.0,2,3]"));
+			const int32 Other = Store.ParseValue(TEXT("[1,2]"));
+			TestTrue(TEXT("Equal"), Store.Test(FJsonCRDTPath(TEXT("/list")), List));
+			TestFalse(TEXT("Different"), Store.Test(FJsonCRDTPath(TEXT("/list")), Other));
+			Store.ReleaseNode(List);
+			Store.ReleaseNode(Other);
+		});
+	});
+
+	Describe("GetAllocatedSize", [this]()
+	{
+		It("follows strings as they are added and removed", [this]()
+		{
+			const FString LongString = FString::ChrN(1000, TEXT('x'));
+			const SIZE_T Before = Store.GetAllocatedSize();
+
+			TestTrue(TEXT("Add"), Store.Add(FJsonCRDTPath(TEXT("/long")), Store.ParseValue(TEXT("\"") + LongString + TEXT("\""))));
+			const SIZE_T WithString = Store.GetAllocatedSize();
+			TestTrue(TEXT("Grows by the string"), WithString >= Before + LongString.Len() * sizeof(TCHAR));
+
+			TestTrue(TEXT("Remove"), Store.Remove(FJsonCRDTPath(TEXT("/long"))));
+			TestTrue(TEXT("Shrinks by the string"), Store.GetAllocatedSize() + LongString.Len() * sizeof(TCHAR) <= WithString);
+		});
+	});
+}
+
+BEGIN_DEFINE_SPEC(FJsonCRDTPathSpec, "JsonCRDT.Core.Path", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+END_DEFINE_SPEC(FJsonCRDTPathSpec)
+
+void FJsonCRDTPathSpec::Define()
+{
+	Describe("FJsonCRDTPath", [this]()
+	{
+		It("splits tokens and parses array indices", [this]()
+		{
+			const FJsonCRDTPath Path(TEXT("/items/12/name"));
+			TestEqual(TEXT("Num"), Path.Num(), 3);
+			TestEqual(TEXT("Token"), Path.GetToken(0), FString(TEXT("items")));
+			TestEqual(TEXT("Index"), Path.GetArrayIndex(1), 12);
+			TestEqual(TEXT("Not an index"), Path.GetArrayIndex(2), (int32)INDEX_NONE);
+			TestEqual(TEXT("Source"), Path.ToString(), FString(TEXT("/items/12/name")));
+		});
+
+		It("treats the empty path as the root", [this]()
+		{
+			TestTrue(TEXT("Empty"), FJsonCRDTPath(TEXT("")).IsRoot());
+			TestTrue(TEXT("Slash"), FJsonCRDTPath(TEXT("/")).IsRoot());
+		});
+
+		It("unescapes ~1 before ~0", [this]()
+		{
+			const FJsonCRDTPath Path(TEXT("/a~1b/~01"));
+			TestEqual(TEXT("~1"), Path.GetToken(0), FString(TEXT("a/b")));
+			TestEqual(TEXT("~01"), Path.GetToken(1), FString(TEXT("~1")));
+		});
+
+		It("parses '-' as the append index and rejects leading zeros", [this]()
+		{
+			TestEqual(TEXT("Append"), FJsonCRDTPath(TEXT("/list/-")).GetArrayIndex(1), FJsonCRDTPath::AppendIndex);
+			TestEqual(TEXT("Leading zero"), FJsonCRDTPath(TEXT("/list/01")).GetArrayIndex(1), (int32)INDEX_NONE);
+			TestEqual(TEXT("Zero"), FJsonCRDTPath(TEXT("/list/0")).GetArrayIndex(1), 0);
+		});
+	});
+
+	Describe("FJsonCRDTPathCache", [this]()
+	{
+		It("returns the same parsed path for the same string", [this]()
+		{
+			FJsonCRDTPathCache Cache(4);
+			const TSharedRef<const FJsonCRDTPath, ESPMode::ThreadSafe> First = Cache.Get(TEXT("/a/b"));
+			const TSharedRef<const FJsonCRDTPath, ESPMode::ThreadSafe> Second = Cache.Get(TEXT("/a/b"));
+			TestTrue(TEXT("Shared"), &First.Get() == &Second.Get());
+			TestEqual(TEXT("Num"), Cache.Num(), 1);
+			TestEqual(TEXT("Tokens"), First->Num(), 2);
+		});
+
+		It("stays within its entry limit", [this]()
+		{
+			FJsonCRDTPathCache Cache(4);
+			for (int32 i = 0; i < 32; ++i)
+			{
+				const TSharedRef<const FJsonCRDTPath, ESPMode::ThreadSafe> Path = Cache.Get(FString::Printf(TEXT("/k%d"), i));
+				TestEqual(TEXT("Token"), Path->GetToken(0), FString::Printf(TEXT("k%d"), i));
+			}
+			TestTrue(TEXT("Bounded"), Cache.Num() <= 4);
+		});
+
+		It("keeps handed out paths valid after Empty", [this]()
+		{
+			FJsonCRDTPathCache Cache(4);
+			const TSharedRef<const FJsonCRDTPath, ESPMode::ThreadSafe> Path = Cache.Get(TEXT("/kept"));
+			Cache.Empty();
+			TestEqual(TEXT("Num"), Cache.Num(), 0);
+			TestEqual(TEXT("Token"), Path->GetToken(0), FString(TEXT("kept")));
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
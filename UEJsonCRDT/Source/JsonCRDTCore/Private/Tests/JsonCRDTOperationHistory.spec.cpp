@@ -0,0 +1,198 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "JsonCRDTOperationHistory.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace JsonCRDTOperationHistorySpec
+{
+	/** 히스토리에 넣을 작업 */
+	static FJsonCRDTOperation MakeOperation(EJsonCRDTOperationType Type, const TCHAR* Path, const TCHAR* Value, const TCHAR* ClientID = TEXT("client-a"))
+	{
+		FJsonCRDTOperation Operation;
+		Operation.Type = Type;
+		Operation.Path = Path;
+		Operation.Value = Value;
+		Operation.Timestamp = FDateTime(2024, 1, 1);
+		Operation.ClientID = ClientID;
+		return Operation;
+	}
+}
+
+BEGIN_DEFINE_SPEC(FJsonCRDTOperationHistorySpec, "JsonCRDT.Core.OperationHistory", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+END_DEFINE_SPEC(FJsonCRDTOperationHistorySpec)
+
+void FJsonCRDTOperationHistorySpec::Define()
+{
+	using namespace JsonCRDTOperationHistorySpec;
+
+	Describe("Add", [this]()
+	{
+		It("numbers operations in order", [this]()
+		{
+			FJsonCRDTOperationHistory History(8);
+			const uint64 First = History.Add(MakeOperation(EJsonCRDTOperationType::Add, TEXT("/a"), TEXT("1")));
+			const uint64 Second = History.Add(MakeOperation(EJsonCRDTOperationType::Add, TEXT("/b"), TEXT("2")));
+			TestEqual(TEXT("Consecutive"), Second, First + 1);
+			TestEqual(TEXT("Num"), History.Num(), 2);
+			TestEqual(TEXT("Oldest"), History.GetOldestSequence(), First);
+			TestEqual(TEXT("Next"), History.GetNextSequence(), Second + 1);
+			TestEqual(TEXT("Get(0)"), History.Get(0).Path, FString(TEXT("/a")));
+		});
+
+		It("stores operations without their client ID and restores it on copy", [this]()
+		{
+			FJsonCRDTOperationHistory History(8);
+			const uint64 Sequence = History.Add(MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/a"), TEXT("1"), TEXT("client-b")));
+
+			const FJsonCRDTOperation* Stored = History.FindBySequence(Sequence);
+			TestTrue(TEXT("Stored without ClientID"), Stored && Stored->ClientID.IsEmpty());
+			TestEqual(TEXT("GetClientID"), History.GetClientID(Sequence), FString(TEXT("client-b")));
+
+			FJsonCRDTOperation Copied;
+			TestTrue(TEXT("Copied"), History.CopyBySequence(Sequence, Copied));
+			TestEqual(TEXT("Copied ClientID"), Copied.ClientID, FString(TEXT("client-b")));
+			TestEqual(TEXT("Copied Value"), Copied.Value, FString(TEXT("1")));
+		});
+
+		It("leaves the caller's operation intact when added by reference", [this]()
+		{
+			FJsonCRDTOperationHistory History(8);
+			const FJsonCRDTOperation Operation = MakeOperation(EJsonCRDTOperationType::Add, TEXT("/a"), TEXT("1"));
+			const uint64 Sequence = History.Add(Operation);
+			TestEqual(TEXT("Caller's ClientID"), Operation.ClientID, FString(TEXT("client-a")));
+			TestEqual(TEXT("GetClientID"), History.GetClientID(Sequence), FString(TEXT("client-a")));
+			TestTrue(TEXT("Stored without ClientID"), History.FindBySequence(Sequence) && History.FindBySequence(Sequence)->ClientID.IsEmpty());
+		});
+	});
+
+	Describe("Ring buffer", [this]()
+	{
+		It("evicts the oldest operations when full", [this]()
+		{
+			FJsonCRDTOperationHistory History(3);
+			TArray<uint64> Sequences;
+			for (int32 i = 0; i < 5; ++i)
+			{
+				Sequences.Add(History.Add(MakeOperation(EJsonCRDTOperationType::Add, *FString::Printf(TEXT("/k%d"), i), TEXT("1"))));
+			}
+
+			TestEqual(TEXT("Num"), History.Num(), 3);
+			TestEqual(TEXT("Oldest"), History.GetOldestSequence(), Sequences[2]);
+			TestNull(TEXT("Evicted"), History.FindBySequence(Sequences[1]));
+			TestTrue(TEXT("Kept"), History.FindBySequence(Sequences[2]) != nullptr);
+			TestEqual(TEXT("Evicted ClientID"), History.GetClientID(Sequences[0]), FString());
+			TestNull(TEXT("Not yet added"), History.FindBySequence(History.GetNextSequence()));
+
+			for (int32 i = 0; i < History.Num(); ++i)
+			{
+				TestEqual(FString::Printf(TEXT("Get(%d)"), i), History.Get(i).Path, FString::Printf(TEXT("/k%d"), i + 2));
+			}
+		});
+
+		It("keeps numbering after Empty", [this]()
+		{
+			FJsonCRDTOperationHistory History(4);
+			History.Add(MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/a"), TEXT("1")));
+			const uint64 Next = History.GetNextSequence();
+			History.Empty();
+
+			TestEqual(TEXT("Num"), History.Num(), 0);
+			TestEqual(TEXT("Replace index cleared"), History.FindLatestReplaceSequence(TEXT("/a")), FJsonCRDTOperationHistory::InvalidSequence);
+			TestEqual(TEXT("Sequence continues"), History.Add(MakeOperation(EJsonCRDTOperationType::Add, TEXT("/b"), TEXT("1"))), Next);
+		});
+	});
+
+	Describe("FindLatestReplaceSequence", [this]()
+	{
+		It("tracks the latest replace per path", [this]()
+		{
+			FJsonCRDTOperationHistory History(8);
+			History.Add(MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/a"), TEXT("1")));
+			const uint64 Latest = History.Add(MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/a"), TEXT("2")));
+			History.Add(MakeOperation(EJsonCRDTOperationType::Add, TEXT("/a"), TEXT("3")));
+
+			TestEqual(TEXT("Latest replace"), History.FindLatestReplaceSequence(TEXT("/a")), Latest);
+			const FJsonCRDTOperation* Operation = History.FindLatestReplace(TEXT("/a"));
+			TestTrue(TEXT("FindLatestReplace"), Operation && Operation->Value == TEXT("2"));
+			TestEqual(TEXT("Other path"), History.FindLatestReplaceSequence(TEXT("/b")), FJsonCRDTOperationHistory::InvalidSequence);
+		});
+
+		It("forgets replaces that were evicted", [this]()
+		{
+			FJsonCRDTOperationHistory History(2);
+			History.Add(MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/a"), TEXT("1")));
+			History.Add(MakeOperation(EJsonCRDTOperationType::Add, TEXT("/b"), TEXT("1")));
+			History.Add(MakeOperation(EJsonCRDTOperationType::Add, TEXT("/c"), TEXT("1")));
+
+			TestEqual(TEXT("Evicted replace"), History.FindLatestReplaceSequence(TEXT("/a")), FJsonCRDTOperationHistory::InvalidSequence);
+			TestNull(TEXT("FindLatestReplace"), History.FindLatestReplace(TEXT("/a")));
+		});
+
+		It("keeps a newer replace when an older one is evicted", [this]()
+		{
+			FJsonCRDTOperationHistory History(2);
+			History.Add(MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/a"), TEXT("1")));
+			const uint64 Latest = History.Add(MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/a"), TEXT("2")));
+			History.Add(MakeOperation(EJsonCRDTOperationType::Add, TEXT("/b"), TEXT("1")));
+
+			TestEqual(TEXT("Newer replace"), History.FindLatestReplaceSequence(TEXT("/a")), Latest);
+		});
+	});
+
+	Describe("SetCapacity", [this]()
+	{
+		It("keeps the most recent operations when shrinking", [this]()
+		{
+			FJsonCRDTOperationHistory History(4);
+			const uint64 OldReplace = History.Add(MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/old"), TEXT("1")));
+			History.Add(MakeOperation(EJsonCRDTOperationType::Add, TEXT("/k1"), TEXT("1")));
+			History.Add(MakeOperation(EJsonCRDTOperationType::Add, TEXT("/k2"), TEXT("1"), TEXT("client-b")));
+			const uint64 Last = History.Add(MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/new"), TEXT("1")));
+
+			History.SetCapacity(2);
+			TestEqual(TEXT("Capacity"), History.GetCapacity(), 2);
+			TestEqual(TEXT("Num"), History.Num(), 2);
+			TestEqual(TEXT("Oldest"), History.GetOldestSequence(), Last - 1);
+			TestEqual(TEXT("Get(0)"), History.Get(0).Path, FString(TEXT("/k2")));
+			TestEqual(TEXT("ClientID kept"), History.GetClientID(Last - 1), FString(TEXT("client-b")));
+			TestEqual(TEXT("Dropped replace"), History.FindLatestReplaceSequence(TEXT("/old")), FJsonCRDTOperationHistory::InvalidSequence);
+			TestEqual(TEXT("Kept replace"), History.FindLatestReplaceSequence(TEXT("/new")), Last);
+			TestNull(TEXT("Dropped"), History.FindBySequence(OldReplace));
+		});
+
+		It("keeps adding in order after growing a wrapped buffer", [this]()
+		{
+			FJsonCRDTOperationHistory History(2);
+			for (int32 i = 0; i < 3; ++i)
+			{
+				History.Add(MakeOperation(EJsonCRDTOperationType::Add, *FString::Printf(TEXT("/k%d"), i), TEXT("1")));
+			}
+
+			History.SetCapacity(4);
+			History.Add(MakeOperation(EJsonCRDTOperationType::Add, TEXT("/k3"), TEXT("1")));
+			TestEqual(TEXT("Num"), History.Num(), 3);
+			for (int32 i = 0; i < History.Num(); ++i)
+			{
+				TestEqual(FString::Printf(TEXT("Get(%d)"), i), History.Get(i).Path, FString::Printf(TEXT("/k%d"), i + 1));
+			}
+		});
+	});
+
+	Describe("GetAllocatedSize", [this]()
+	{
+		It("counts operation strings and gives them back on eviction", [this]()
+		{
+			FJsonCRDTOperationHistory History(1);
+			const FString LongValue = FString::ChrN(1000, TEXT('x'));
+			History.Add(MakeOperation(EJsonCRDTOperationType::Add, TEXT("/a"), *LongValue));
+			const SIZE_T WithLongValue = History.GetAllocatedSize();
+
+			History.Add(MakeOperation(EJsonCRDTOperationType::Add, TEXT("/a"), TEXT("1")));
+			TestTrue(TEXT("Shrinks after eviction"), History.GetAllocatedSize() + LongValue.Len() * sizeof(TCHAR) <= WithLongValue);
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
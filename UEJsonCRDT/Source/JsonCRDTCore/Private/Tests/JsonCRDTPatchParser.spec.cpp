@@ -0,0 +1,133 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "JsonCRDTPatchParser.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FJsonCRDTPatchParserSpec, "JsonCRDT.Core.PatchParser", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+END_DEFINE_SPEC(FJsonCRDTPatchParserSpec)
+
+void FJsonCRDTPatchParserSpec::Define()
+{
+	Describe("Message format", [this]()
+	{
+		It("reads the patch fields and the message type", [this]()
+		{
+			const TCHAR* Json = TEXT("{\"type\":\"patch\",\"documentId\":\"doc\",\"clientId\":\"client-a\",\"baseVersion\":3,\"sequence\":9,")
+				TEXT("\"versionVector\":{\"client-a\":8,\"client-b\":2},")
+				TEXT("\"operations\":[{\"op\":\"replace\",\"path\":\"/a\",\"value\":{\"b\":[1,\"x\"]}},{\"op\":\"move\",\"from\":\"/a\",\"path\":\"/c\"}]}");
+
+			FJsonCRDTPatch Patch;
+			FString MessageType;
+			FString Error;
+			TestTrue(TEXT("Parsed"), FJsonCRDTPatchParser::Parse(Json, FJsonCRDTPatchParser::EFormat::Message, Patch, &MessageType, &Error));
+			TestEqual(TEXT("Error"), Error, FString());
+			TestEqual(TEXT("Message type"), MessageType, FString(TEXT("patch")));
+			TestEqual(TEXT("DocumentID"), Patch.DocumentID, FString(TEXT("doc")));
+			TestEqual(TEXT("ClientID"), Patch.ClientID, FString(TEXT("client-a")));
+			TestEqual(TEXT("BaseVersion"), Patch.BaseVersion, (int64)3);
+			TestEqual(TEXT("Sequence"), Patch.Sequence, (int64)9);
+			TestEqual(TEXT("VersionVector"), Patch.VersionVector.Num(), 2);
+			TestTrue(TEXT("VersionVector entry"), Patch.VersionVector.FindRef(TEXT("client-b")) == 2);
+
+			if (TestEqual(TEXT("Operations"), Patch.Operations.Num(), 2))
+			{
+				TestEqual(TEXT("Replace type"), (int32)Patch.Operations[0].Type, (int32)EJsonCRDTOperationType::Replace);
+				TestEqual(TEXT("Raw value"), Patch.Operations[0].Value, FString(TEXT("{\"b\":[1,\"x\"]}")));
+				TestEqual(TEXT("Move type"), (int32)Patch.Operations[1].Type, (int32)EJsonCRDTOperationType::Move);
+				TestEqual(TEXT("From"), Patch.Operations[1].FromPath, FString(TEXT("/a")));
+				TestEqual(TEXT("Path"), Patch.Operations[1].Path, FString(TEXT("/c")));
+			}
+		});
+
+		It("fills missing operation client IDs and timestamps from the patch", [this]()
+		{
+			// 패치 필드가 작업 뒤에 와도 적용됨
+			const TCHAR* Json = TEXT("{\"operations\":[{\"op\":\"add\",\"path\":\"/a\",\"value\":1},{\"op\":\"remove\",\"path\":\"/b\",\"clientId\":\"other\"}],")
+				TEXT("\"documentId\":\"doc\",\"clientId\":\"client-a\",\"timestamp\":\"2024-01-02T03:04:05.000Z\"}");
+
+			FJsonCRDTPatch Patch;
+			TestTrue(TEXT("Parsed"), FJsonCRDTPatchParser::Parse(Json, FJsonCRDTPatchParser::EFormat::Message, Patch));
+			if (TestEqual(TEXT("Operations"), Patch.Operations.Num(), 2))
+			{
+				TestEqual(TEXT("Inherited ClientID"), Patch.Operations[0].ClientID, FString(TEXT("client-a")));
+				TestEqual(TEXT("Own ClientID"), Patch.Operations[1].ClientID, FString(TEXT("other")));
+				TestEqual(TEXT("Inherited timestamp"), Patch.Operations[0].Timestamp.GetTicks(), FDateTime(2024, 1, 2, 3, 4, 5).GetTicks());
+			}
+		});
+
+		It("matches field names and operation names without case", [this]()
+		{
+			const TCHAR* Json = TEXT("{\"DocumentID\":\"doc\",\"Operations\":[{\"Type\":\"Replace\",\"Path\":\"/a\",\"Value\":true}]}");
+
+			FJsonCRDTPatch Patch;
+			TestTrue(TEXT("Parsed"), FJsonCRDTPatchParser::Parse(Json, FJsonCRDTPatchParser::EFormat::Message, Patch));
+			TestTrue(TEXT("Replace"), Patch.Operations.Num() == 1 && Patch.Operations[0].Type == EJsonCRDTOperationType::Replace);
+		});
+
+		It("skips unknown fields", [this]()
+		{
+			const TCHAR* Json = TEXT("{\"documentId\":\"doc\",\"extra\":{\"nested\":[1,{\"x\":null}]},\"operations\":[{\"op\":\"remove\",\"path\":\"/a\",\"note\":\"x\"}]}");
+
+			FJsonCRDTPatch Patch;
+			TestTrue(TEXT("Parsed"), FJsonCRDTPatchParser::Parse(Json, FJsonCRDTPatchParser::EFormat::Message, Patch));
+			TestEqual(TEXT("Operations"), Patch.Operations.Num(), 1);
+		});
+
+		It("reuses the operations of a previously parsed patch", [this]()
+		{
+			FJsonCRDTPatch Patch;
+			TestTrue(TEXT("First"), FJsonCRDTPatchParser::Parse(TEXT("{\"documentId\":\"doc\",\"operations\":[{\"op\":\"remove\",\"path\":\"/a\"},{\"op\":\"remove\",\"path\":\"/b\"}]}"), FJsonCRDTPatchParser::EFormat::Message, Patch));
+			TestTrue(TEXT("Second"), FJsonCRDTPatchParser::Parse(TEXT("{\"documentId\":\"doc\",\"operations\":[{\"op\":\"add\",\"path\":\"/c\",\"value\":1}]}"), FJsonCRDTPatchParser::EFormat::Message, Patch));
+			if (TestEqual(TEXT("Operations"), Patch.Operations.Num(), 1))
+			{
+				TestEqual(TEXT("Path"), Patch.Operations[0].Path, FString(TEXT("/c")));
+				TestEqual(TEXT("FromPath cleared"), Patch.Operations[0].FromPath, FString());
+			}
+		});
+	});
+
+	Describe("Struct format", [this]()
+	{
+		It("unwraps values stored as JSON text", [this]()
+		{
+			const TCHAR* Json = TEXT("{\"documentID\":\"doc\",\"baseVersion\":1,\"operations\":[{\"type\":\"Add\",\"path\":\"/a\",\"value\":\"{\\\"b\\\":1}\"},{\"type\":2,\"path\":\"/c\",\"value\":5}]}");
+
+			FJsonCRDTPatch Patch;
+			TestTrue(TEXT("Parsed"), FJsonCRDTPatchParser::Parse(Json, FJsonCRDTPatchParser::EFormat::Struct, Patch));
+			if (TestEqual(TEXT("Operations"), Patch.Operations.Num(), 2))
+			{
+				TestEqual(TEXT("Unwrapped value"), Patch.Operations[0].Value, FString(TEXT("{\"b\":1}")));
+				TestEqual(TEXT("Numeric type"), (int32)Patch.Operations[1].Type, (int32)EJsonCRDTOperationType::Replace);
+				TestEqual(TEXT("Raw value"), Patch.Operations[1].Value, FString(TEXT("5")));
+			}
+		});
+	});
+
+	Describe("Errors", [this]()
+	{
+		It("rejects patches with missing fields", [this]()
+		{
+			FJsonCRDTPatch Patch;
+			FString Error;
+			TestFalse(TEXT("No documentId"), FJsonCRDTPatchParser::Parse(TEXT("{\"operations\":[]}"), FJsonCRDTPatchParser::EFormat::Message, Patch, nullptr, &Error));
+			TestTrue(TEXT("Error message"), Error.Contains(TEXT("documentId")));
+
+			TestFalse(TEXT("No operations"), FJsonCRDTPatchParser::Parse(TEXT("{\"documentId\":\"doc\"}"), FJsonCRDTPatchParser::EFormat::Message, Patch));
+			TestFalse(TEXT("No value"), FJsonCRDTPatchParser::Parse(TEXT("{\"documentId\":\"doc\",\"operations\":[{\"op\":\"add\",\"path\":\"/a\"}]}"), FJsonCRDTPatchParser::EFormat::Message, Patch));
+			TestFalse(TEXT("No from"), FJsonCRDTPatchParser::Parse(TEXT("{\"documentId\":\"doc\",\"operations\":[{\"op\":\"copy\",\"path\":\"/a\"}]}"), FJsonCRDTPatchParser::EFormat::Message, Patch));
+		});
+
+		It("rejects malformed JSON and unknown operations", [this]()
+		{
+			FJsonCRDTPatch Patch;
+			TestFalse(TEXT("Truncated"), FJsonCRDTPatchParser::Parse(TEXT("{\"documentId\":\"doc\",\"operations\":[{\"op\":\"add\""), FJsonCRDTPatchParser::EFormat::Message, Patch));
+			TestFalse(TEXT("Trailing data"), FJsonCRDTPatchParser::Parse(TEXT("{\"documentId\":\"doc\",\"operations\":[]} x"), FJsonCRDTPatchParser::EFormat::Message, Patch));
+			TestFalse(TEXT("Unknown op"), FJsonCRDTPatchParser::Parse(TEXT("{\"documentId\":\"doc\",\"operations\":[{\"op\":\"merge\",\"path\":\"/a\"}]}"), FJsonCRDTPatchParser::EFormat::Message, Patch));
+			TestFalse(TEXT("Unterminated string"), FJsonCRDTPatchParser::Parse(TEXT("{\"documentId\":\"doc"), FJsonCRDTPatchParser::EFormat::Message, Patch));
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,133 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "JsonCRDTPathTrie.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FJsonCRDTPathTrieSpec, "JsonCRDT.Core.PathTrie", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+	FJsonCRDTPathTrie Trie;
+
+	/** 바뀐 경로 전체에 영향을 받는 번호 */
+	TSet<int32> Affected(const TCHAR* Path) const
+	{
+		const FJsonCRDTPath Parsed(Path);
+		TSet<int32> Ids;
+		Trie.CollectAffected(Parsed, Parsed.Num(), Ids);
+		return Ids;
+	}
+
+	/** 모은 번호가 기대한 번호와 정확히 같은지 확인 */
+	void TestIds(const TCHAR* What, const TSet<int32>& Actual, const TSet<int32>& Expected)
+	{
+		TestTrue(What, Actual.Num() == Expected.Num() && Actual.Includes(Expected));
+	}
+END_DEFINE_SPEC(FJsonCRDTPathTrieSpec)
+
+void FJsonCRDTPathTrieSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Trie.Reset();
+		Trie.Add(FJsonCRDTPath(TEXT("")), 1);
+		Trie.Add(FJsonCRDTPath(TEXT("/player")), 2);
+		Trie.Add(FJsonCRDTPath(TEXT("/player/stats/hp")), 3);
+		Trie.Add(FJsonCRDTPath(TEXT("/player/name")), 4);
+		Trie.Add(FJsonCRDTPath(TEXT("/world")), 5);
+		Trie.Add(FJsonCRDTPath(TEXT("/player/items/0")), 6);
+		Trie.Add(FJsonCRDTPath(TEXT("/player/items/2/count")), 7);
+		Trie.Add(FJsonCRDTPath(TEXT("/player/items")), 8);
+	});
+
+	Describe("CollectAffected", [this]()
+	{
+		It("collects ancestors and the changed path", [this]()
+		{
+			TestIds(TEXT("/player/name"), Affected(TEXT("/player/name")), { 1, 2, 4 });
+		});
+
+		It("collects descendants when a parent is replaced", [this]()
+		{
+			TestIds(TEXT("/player/stats"), Affected(TEXT("/player/stats")), { 1, 2, 3 });
+			TestIds(TEXT("/player"), Affected(TEXT("/player")), { 1, 2, 3, 4, 6, 7, 8 });
+		});
+
+		It("collects only ancestors for unsubscribed paths", [this]()
+		{
+			TestIds(TEXT("/player/level"), Affected(TEXT("/player/level")), { 1, 2 });
+			TestIds(TEXT("/other/x"), Affected(TEXT("/other/x")), { 1 });
+		});
+
+		It("collects everything for the root", [this]()
+		{
+			TestIds(TEXT("Root"), Affected(TEXT("")), { 1, 2, 3, 4, 5, 6, 7, 8 });
+		});
+
+		It("uses only the leading tokens", [this]()
+		{
+			const FJsonCRDTPath Path(TEXT("/player/stats/hp"));
+			TSet<int32> Ids;
+			Trie.CollectAffected(Path, 1, Ids);
+			TestIds(TEXT("First token"), Ids, { 1, 2, 3, 4, 6, 7, 8 });
+		});
+	});
+
+	Describe("CollectArrayShift", [this]()
+	{
+		It("collects the array, its ancestors and elements from the first shifted index", [this]()
+		{
+			const FJsonCRDTPath Path(TEXT("/player/items/1"));
+			TSet<int32> Ids;
+			Trie.CollectArrayShift(Path, 2, 1, Ids);
+			TestIds(TEXT("From index 1"), Ids, { 1, 2, 7, 8 });
+		});
+
+		It("collects only the array and its ancestors for an append", [this]()
+		{
+			const FJsonCRDTPath Path(TEXT("/player/items/-"));
+			TSet<int32> Ids;
+			Trie.CollectArrayShift(Path, 2, MAX_int32, Ids);
+			TestIds(TEXT("Append"), Ids, { 1, 2, 8 });
+		});
+	});
+
+	Describe("Remove", [this]()
+	{
+		It("stops reporting removed ids", [this]()
+		{
+			Trie.Remove(FJsonCRDTPath(TEXT("/player/name")), 4);
+			TestIds(TEXT("/player/name"), Affected(TEXT("/player/name")), { 1, 2 });
+		});
+
+		It("ignores ids that were not added at the path", [this]()
+		{
+			Trie.Remove(FJsonCRDTPath(TEXT("/player/name")), 5);
+			Trie.Remove(FJsonCRDTPath(TEXT("/missing")), 4);
+			TestIds(TEXT("/player/name"), Affected(TEXT("/player/name")), { 1, 2, 4 });
+			TestIds(TEXT("/world"), Affected(TEXT("/world")), { 1, 5 });
+		});
+
+		It("keeps the same id at other paths", [this]()
+		{
+			Trie.Add(FJsonCRDTPath(TEXT("/world/zone")), 4);
+			Trie.Remove(FJsonCRDTPath(TEXT("/player/name")), 4);
+			TestIds(TEXT("/world/zone"), Affected(TEXT("/world/zone")), { 1, 4, 5 });
+		});
+
+		It("becomes empty when every id is removed", [this]()
+		{
+			FJsonCRDTPathTrie Single;
+			TestTrue(TEXT("Empty at start"), Single.IsEmpty());
+			Single.Add(FJsonCRDTPath(TEXT("/a/b")), 1);
+			TestFalse(TEXT("Not empty"), Single.IsEmpty());
+			Single.Remove(FJsonCRDTPath(TEXT("/a/b")), 1);
+			TestTrue(TEXT("Empty"), Single.IsEmpty());
+
+			TSet<int32> Ids;
+			Single.CollectAffected(FJsonCRDTPath(TEXT("/a")), 1, Ids);
+			TestEqual(TEXT("Nothing collected"), Ids.Num(), 0);
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,25 @@
+// Copyright Your Company. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace JsonCRDTSpecHelpers
+{
+	/** 두 JSON 문자열을 구조로 비교 (숫자 표기는 엔진 버전마다 다르므로 문자열로 비교하지 않음) */
+	inline bool JsonEquals(const FString& A, const FString& B)
+	{
+		// 스칼라도 읽을 수 있게 배열로 감싸서 파싱
+		TArray<TSharedPtr<FJsonValue>> ValuesA;
+		TArray<TSharedPtr<FJsonValue>> ValuesB;
+		if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(TEXT("[") + A + TEXT("]")), ValuesA)
+			|| !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(TEXT("[") + B + TEXT("]")), ValuesB))
+		{
+			return false;
+		}
+		return ValuesA.Num() == 1 && ValuesB.Num() == 1 && FJsonValue::CompareEqual(*ValuesA[0], *ValuesB[0]);
+	}
+}
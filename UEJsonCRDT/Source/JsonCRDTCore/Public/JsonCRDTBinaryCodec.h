@@ -0,0 +1,145 @@
+// Copyright Your Company. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonCRDTTypes.h"
+#include "JsonCRDTPath.h"
+
+/**
+ * 연결 단위 문자열 사전
+ *
+ * 처음 등장한 문자열은 원문으로 보내면서 양쪽이 같은 순서로 번호를 붙이고,
+ * 이후에는 번호만 보냅니다. 경로와 문서 ID처럼 반복되는 문자열에 사용합니다.
+ */
+class JSONCRDTCORE_API FJsonCRDTStringDictionary
+{
+public:
+	/**
+	 * 생성자
+	 * @param InMaxEntries 사전에 등록할 최대 문자열 수 (가득 차면 원문으로만 전송)
+	 */
+	explicit FJsonCRDTStringDictionary(int32 InMaxEntries = 4096);
+
+	/** 문자열 번호 찾기 (없으면 INDEX_NONE) */
+	int32 Find(const FString& Value) const;
+
+	/** 문자열 등록 (가득 찼으면 INDEX_NONE) */
+	int32 Add(const FString& Value);
+
+	/** 번호로 문자열 가져오기 (없으면 nullptr) */
+	const FString* Get(int32 Index) const;
+
+	/** 더 등록할 수 있는지 여부 */
+	bool HasCapacity() const { return Entries.Num() < MaxEntries; }
+
+	/** 모든 항목 제거 */
+	void Reset();
+
+private:
+	/** 번호순 문자열 */
+	TArray<FString> Entries;
+
+	/** 문자열에서 번호로의 맵 */
+	TMap<FString, int32, FDefaultSetAllocator, TJsonCRDTCaseSensitiveMapKeyFuncs<int32>> Indices;
+
+	/** 최대 항목 수 */
+	int32 MaxEntries;
+};
+
+/**
+ * 패치 전송용 바이너리 프레임 코덱
+ *
+ * 프레임 형식 (정수는 모두 LEB128 가변 길이, 부호 있는 값은 지그재그 인코딩):
+ *   [u8 Magic][u8 FrameVersion][u8 FrameType][varint NumPatches] Patch...
+ *   Patch: [string DocumentID][u8 Flags][svarint BaseVersion][varint TimestampTicks]
+ *          ([string ClientID] Flags & HasClientID)([varint Sequence] Flags & HasSequence)
+ *          ([varint NumEntries] ([string ClientID][varint Sequence])... Flags & HasVersionVector)
+ *          [varint NumOperations] Operation...
+ *   Operation: [u8 Type][string Path]([string From] move/copy)([bytes Value] add/replace/test)[svarint TimestampDelta]
+ *   string: [varint Code] 0 = 원문 + 사전 등록, 1 = 원문만, N >= 2 = 사전 항목 N - 2
+ *           원문은 [varint Length][UTF-8 bytes]
+ *
+ * 값은 JSON 텍스트를 그대로 UTF-8로 담으므로 송수신 어느 쪽에서도 다시 파싱하지 않습니다.
+ * 클라이언트 ID는 인증 때 한 번만 보내며 클라이언트가 보내는 패치에는 포함하지 않습니다.
+ * 시퀀스 번호와 버전 벡터는 값이 있을 때만 기록하므로 로컬 저널 레코드의 형식은 바뀌지 않습니다.
+ * 인코딩과 디코딩 사전은 방향별로 따로 유지되므로 연결마다 Reset()해야 합니다.
+ * 두 방향은 서로 다른 상태만 사용하므로 인코딩과 디코딩을 각각 다른 스레드에서 수행할 수 있습니다.
+ */
+class JSONCRDTCORE_API FJsonCRDTBinaryCodec
+{
+public:
+	/** 협상에 사용하는 프로토콜 이름 */
+	static const TCHAR* ProtocolName;
+
+	/** 프레임 첫 바이트 (JSON 텍스트의 첫 문자가 될 수 없는 값) */
+	static constexpr uint8 FrameMagic = 0xC7;
+
+	/** 프레임 형식 버전 */
+	static constexpr uint8 FrameVersion = 1;
+
+	FJsonCRDTBinaryCodec();
+
+	/** 연결이 새로 맺어졌을 때 양방향 사전 초기화 */
+	void Reset();
+
+	/** 보내는 방향 사전만 초기화 (인코딩하는 스레드에서 호출) */
+	void ResetEncoder();
+
+	/** 받는 방향 사전만 초기화 (디코딩하는 스레드에서 호출) */
+	void ResetDecoder();
+
+	/**
+	 * 패치 하나를 프레임으로 인코딩
+	 * @param Patch 인코딩할 패치
+	 * @param OutFrame 프레임 바이트 (기존 내용은 지워짐)
+	 * @param bIncludeClientID 패치의 클라이언트 ID 포함 여부 (서버가 다른 클라이언트에 전달할 때만 사용)
+	 */
+	void EncodePatch(const FJsonCRDTPatch& Patch, TArray<uint8>& OutFrame, bool bIncludeClientID = false);
+
+	/**
+	 * 여러 패치를 한 프레임으로 인코딩
+	 * @param Patches 인코딩할 패치들
+	 * @param OutFrame 프레임 바이트 (기존 내용은 지워짐)
+	 * @param bIncludeClientID 패치의 클라이언트 ID 포함 여부
+	 */
+	void EncodePatches(TArrayView<const FJsonCRDTPatch> Patches, TArray<uint8>& OutFrame, bool bIncludeClientID = false);
+
+	/**
+	 * 프레임 디코딩
+	 * @param Data 프레임 바이트
+	 * @param Size 바이트 수
+	 * @param OutPatches 디코딩된 패치 (뒤에 추가됨)
+	 * @return 성공 여부 (실패 시 사전 상태를 신뢰할 수 없으므로 연결을 다시 맺어야 함)
+	 */
+	bool DecodeFrame(const uint8* Data, int32 Size, TArray<FJsonCRDTPatch>& OutPatches);
+
+	/** 바이너리 프레임인지 확인 */
+	static bool IsBinaryFrame(const uint8* Data, int32 Size);
+
+private:
+	/** 프레임 종류 */
+	enum class EFrameType : uint8
+	{
+		Patches = 1
+	};
+
+	/** 패치 플래그 */
+	enum EPatchFlags : uint8
+	{
+		PatchFlag_HasClientID = 1 << 0,
+		PatchFlag_HasSequence = 1 << 1,
+		PatchFlag_HasVersionVector = 1 << 2
+	};
+
+	/** 보내는 방향 사전 */
+	FJsonCRDTStringDictionary EncodeStrings;
+
+	/** 받는 방향 사전 */
+	FJsonCRDTStringDictionary DecodeStrings;
+
+	void WritePatch(const FJsonCRDTPatch& Patch, bool bIncludeClientID, TArray<uint8>& Out);
+	void WriteString(const FString& Value, TArray<uint8>& Out);
+	bool ReadPatch(const uint8*& Cursor, const uint8* End, FJsonCRDTPatch& OutPatch);
+	bool ReadString(const uint8*& Cursor, const uint8* End, FString& OutValue);
+};
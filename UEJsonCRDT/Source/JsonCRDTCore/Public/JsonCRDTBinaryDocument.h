@@ -0,0 +1,152 @@
+// Copyright Your Company. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/MappedFileHandle.h"
+#include "JsonCRDTTypes.h"
+#include "JsonCRDTNodeStore.h"
+
+/**
+ * 메모리 매핑해서 필요한 부분만 읽는 바이너리 로컬 저장 형식
+ *
+ * 파일 형식 (varint는 LEB128, svarint는 지그재그 인코딩, 고정 길이 정수는 리틀 엔디언):
+ *   [u32 Magic][u8 FormatVersion][u8 Flags][string DocumentID][svarint Version][svarint TimestampTicks]
+ *   (Flags & HasSnapshot) [svarint SnapshotVersion][svarint SnapshotTicks]([string SnapshotContent] !(Flags & SnapshotIsContent))
+ *   [varint NumKeys] string... Node
+ *   Node: [u8 Type][svarint TimestampDelta] + 타입별 값
+ *         Boolean [u8], Number [8바이트 double], String [string]
+ *         Array [varint Count][u32 PayloadSize] Node..., Object [varint Count][u32 PayloadSize] ([varint KeyIndex] Node)...
+ *   string: [varint Length][UTF-8 bytes]
+ *
+ * 노드 타임스탬프는 부모 노드와의 차이로 기록합니다. 컨테이너는 내용 크기를 앞에 적으므로
+ * 경로를 찾을 때 관계없는 서브트리를 읽지 않고 건너뜁니다. 스냅샷 내용이 문서 내용과 같으면
+ * 두 번 기록하지 않습니다.
+ */
+class JSONCRDTCORE_API FJsonCRDTBinaryDocument
+{
+public:
+	/** 파일 첫 4바이트 ("JCRD") */
+	static constexpr uint32 FileMagic = 0x4452434A;
+
+	/** 파일 형식 버전 */
+	static constexpr uint8 FormatVersion = 1;
+
+	/** 파일 머리에 기록되는 문서 정보 */
+	struct FHeader
+	{
+		/** 문서 ID */
+		FString DocumentID;
+
+		/** 저장 시점의 문서 버전 */
+		int64 Version = 0;
+
+		/** 저장 시각 */
+		FDateTime Timestamp;
+
+		/** 최신 스냅샷이 있는지 여부 */
+		bool bHasSnapshot = false;
+
+		/** 최신 스냅샷 (내용이 문서 내용과 같으면 Content가 비어 있음) */
+		FJsonCRDTSnapshot Snapshot;
+	};
+
+	FJsonCRDTBinaryDocument();
+	~FJsonCRDTBinaryDocument();
+
+	/**
+	 * 문서를 바이너리 형식으로 인코딩
+	 * @param Header 문서 정보 (Snapshot.Content가 비어 있으면 스냅샷 내용을 문서 내용으로 간주)
+	 * @param Store 문서 내용
+	 * @param OutBytes 파일 내용 (기존 내용은 지워짐)
+	 */
+	static void Encode(const FHeader& Header, const FJsonCRDTNodeStore& Store, TArray<uint8>& OutBytes);
+
+	/**
+	 * 파일 열기 (가능하면 메모리 매핑, 아니면 읽어 들임)
+	 * 머리와 키 테이블만 읽으며 내용은 필요할 때 읽습니다.
+	 * @param FilePath 파일 경로
+	 * @return 성공 여부
+	 */
+	bool Open(const FString& FilePath);
+
+	/** 파일 닫기 (매핑 해제) */
+	void Close();
+
+	/** 파일이 열려 있는지 여부 */
+	bool IsOpen() const { return Data != nullptr; }
+
+	/** 문서 정보 */
+	const FHeader& GetHeader() const { return Header; }
+
+	/**
+	 * 경로의 값을 JSON 문자열로 가져오기 (경로를 따라가며 대상 서브트리만 디코딩)
+	 * @param Path 파싱된 경로
+	 * @param OutValue 값의 JSON 문자열
+	 * @return 값이 있으면 true
+	 */
+	bool GetValueAtPath(const FJsonCRDTPath& Path, FString& OutValue) const;
+
+	/**
+	 * 전체 내용을 노드 저장소로 디코딩 (실패 시 기존 내용 유지)
+	 * @param OutStore 내용을 받을 저장소
+	 * @return 성공 여부
+	 */
+	bool DecodeContent(FJsonCRDTNodeStore& OutStore) const;
+
+private:
+	/** 파일 플래그 */
+	enum EFileFlags : uint8
+	{
+		FileFlag_HasSnapshot = 1 << 0,
+		FileFlag_SnapshotIsContent = 1 << 1
+	};
+
+	/** 매핑된 파일 */
+	TUniquePtr<IMappedFileHandle> MappedFile;
+
+	/** 매핑된 영역 */
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	/** 매핑을 지원하지 않는 플랫폼에서 읽어 들인 파일 내용 */
+	TArray<uint8> LoadedBytes;
+
+	/** 파일 내용의 시작과 끝 */
+	const uint8* Data;
+	const uint8* End;
+
+	/** 루트 노드 위치 */
+	const uint8* Root;
+
+	/** 파일의 키 테이블 */
+	TArray<FString> Keys;
+
+	/** 키 문자열에서 파일 키 인덱스로의 맵 */
+	TMap<FString, int32, FDefaultSetAllocator, TJsonCRDTCaseSensitiveMapKeyFuncs<int32>> KeyIndices;
+
+	/** 문서 정보 */
+	FHeader Header;
+
+	/** 머리와 키 테이블 읽기 */
+	bool ReadHeader();
+
+	/**
+	 * 노드 하나를 건너뜀
+	 * @return 노드가 파일 범위 안에 온전히 있으면 true
+	 */
+	bool SkipNode(const uint8*& Cursor) const;
+
+	/**
+	 * 컨테이너 노드에서 경로 세그먼트 하나에 해당하는 자식 노드로 이동
+	 * @param Cursor 컨테이너 노드 위치 (성공하면 자식 노드 위치)
+	 * @return 자식이 있으면 true
+	 */
+	bool FindChild(const uint8*& Cursor, const FJsonCRDTPath& Path, int32 TokenIndex) const;
+
+	/**
+	 * 노드 서브트리를 저장소의 분리된 노드로 디코딩
+	 * @param StoreKeys 파일 키 인덱스에서 저장소 키 인덱스로의 맵 (처음 사용할 때 인터닝)
+	 * @return 새 노드 인덱스 (실패 시 INDEX_NONE)
+	 */
+	int32 DecodeNode(const uint8*& Cursor, int64 ParentTimestamp, FJsonCRDTNodeStore& Store, TArray<int32>& StoreKeys, int32 Depth) const;
+};
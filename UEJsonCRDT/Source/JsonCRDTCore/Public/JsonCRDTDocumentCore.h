@@ -0,0 +1,151 @@
+// Copyright Your Company. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonCRDTTypes.h"
+#include "JsonCRDTPath.h"
+#include "JsonCRDTNodeStore.h"
+#include "JsonCRDTOperationHistory.h"
+
+/**
+ * UObject 없이 쓰는 문서 상태와 패치 적용
+ *
+ * 문서 ID, 버전, 노드 저장소, 작업 히스토리, 버전 벡터를 소유하고 작업의 원자적 적용과 되돌리기,
+ * 이미 적용한 패치 시퀀스 건너뛰기를 구현합니다. UJsonCRDTDocument는 이 상태 위에 충돌 해결, 저널,
+ * 스냅샷, 구독 알림을 얹은 래퍼이고, 데디케이티드 서버나 봇, 부하 테스트 프로세스는
+ * ApplyPatch와 ApplyLocalOperations로 엔진 없이 같은 문서를 다룰 수 있습니다.
+ * 이 경로에는 충돌 해결기가 없으므로 원격 작업은 받은 순서대로 적용됩니다 (마지막 작성자 우선).
+ */
+class JSONCRDTCORE_API FJsonCRDTDocumentCore
+{
+public:
+	/** 클라이언트별로 적용한 마지막 패치 시퀀스 */
+	using FVersionVector = TMap<FString, int64, FDefaultSetAllocator, TJsonCRDTCaseSensitiveMapKeyFuncs<int64>>;
+
+	explicit FJsonCRDTDocumentCore(const FString& InDocumentID = FString());
+
+	/** 문서 ID */
+	const FString& GetDocumentID() const { return DocumentID; }
+	void SetDocumentID(const FString& InDocumentID) { DocumentID = InDocumentID; }
+
+	/** 문서 버전 (내용이 바뀔 때마다 1씩 증가) */
+	int64 GetVersion() const { return Version; }
+	void SetVersion(int64 InVersion) { Version = InVersion; }
+
+	/**
+	 * 버전을 1 올림
+	 * @return 올리기 전 버전
+	 */
+	int64 AdvanceVersion() { return Version++; }
+
+	/** 문서 내용 */
+	const FJsonCRDTNodeStore& GetContent() const { return Content; }
+	FJsonCRDTNodeStore& GetContent() { return Content; }
+
+	/** 내용 교체 (버전과 히스토리는 바꾸지 않음) */
+	void SetContent(FJsonCRDTNodeStore&& NewContent) { Content = MoveTemp(NewContent); }
+
+	/** 적용한 작업 히스토리 */
+	const FJsonCRDTOperationHistory& GetOperationHistory() const { return OperationHistory; }
+	FJsonCRDTOperationHistory& GetOperationHistory() { return OperationHistory; }
+
+	/** 클라이언트별로 적용한 마지막 패치 시퀀스 */
+	const FVersionVector& GetVersionVector() const { return VersionVector; }
+	void SetVersionVector(FVersionVector&& InVersionVector) { VersionVector = MoveTemp(InVersionVector); }
+
+	/** 경로 파싱 캐시 */
+	FJsonCRDTPathCache& GetPathCache() const { return PathCache; }
+
+	/** JSON Pointer 경로가 가리키는 노드 찾기 (빈 경로는 루트, 없으면 INDEX_NONE) */
+	int32 FindNodeAtPath(const FString& Path) const;
+
+	/**
+	 * 경로의 값을 JSON 문자열로 가져오기
+	 * @return 값이 있으면 true
+	 */
+	bool GetValueAtPath(const FString& Path, FString& OutValue) const;
+
+	/** 내용을 JSON 문자열로 가져오기 */
+	FString GetContentAsString() const;
+
+	/**
+	 * 내용을 JSON 문자열로 교체하고 버전을 올림 (히스토리는 그대로)
+	 * @return 올바른 JSON이면 true
+	 */
+	bool SetContentFromString(const FString& JsonString);
+
+	/**
+	 * 작업 하나 적용 (RFC 6902 의미, 내용을 제자리에서 변경)
+	 * @param Operation 적용할 작업
+	 * @param OutInverse 작업을 되돌리는 역작업을 추가할 배열 (적용 순서대로 추가되므로 되돌릴 때는 뒤에서부터 적용)
+	 * @return 성공 여부
+	 */
+	bool ApplyOperation(const FJsonCRDTOperation& Operation, TArray<FJsonCRDTOperation>* OutInverse = nullptr);
+
+	/** 임의의 노드 저장소에 작업 적용 (스냅샷 재구성에도 사용, 경로 캐시만 공유) */
+	bool ApplyOperationToStore(FJsonCRDTNodeStore& Store, const FJsonCRDTOperation& Operation, TArray<FJsonCRDTOperation>* OutInverse) const;
+
+	/** 이미 적용한 작업을 역작업으로 되돌림 (역작업은 적용 순서대로, 뒤에서부터 적용) */
+	void RollbackOperations(const TArray<FJsonCRDTOperation>& InverseOperations);
+
+	/**
+	 * 작업들을 차례로 적용하고 하나라도 실패하면 앞서 적용한 작업을 모두 되돌림 (버전과 히스토리는 바꾸지 않음)
+	 * @param Operations 적용할 작업
+	 * @param OutInverse 적용한 작업의 역작업 (적용 순서대로, 기존 내용과 실패했을 때의 내용은 지워짐)
+	 * @param OutCreatesValue 작업별로 기존 값을 덮지 않고 새 값을 만들었는지 여부 (필요 없으면 nullptr)
+	 * @return 실패한 작업의 색인 (모두 적용되면 INDEX_NONE)
+	 */
+	int32 ApplyOperationsAtomically(TArrayView<const FJsonCRDTOperation> Operations, TArray<FJsonCRDTOperation>& OutInverse, TArray<bool, TInlineAllocator<16>>* OutCreatesValue = nullptr);
+
+	/**
+	 * 패치를 적용할지 확인 (문서 ID와 이미 적용한 시퀀스)
+	 * @param Patch 받은 패치
+	 * @param bOutResult 적용하지 않을 때 ApplyPatch가 돌려줄 값
+	 * @return 작업을 적용해야 하면 true
+	 */
+	bool ShouldApplyPatch(const FJsonCRDTPatch& Patch, bool& bOutResult) const;
+
+	/** 적용한 패치의 보낸 쪽 시퀀스를 버전 벡터에 기록 (다시 보낸 패치를 건너뛰기 위해) */
+	void RecordPatchSequence(const FJsonCRDTPatch& Patch);
+
+	/**
+	 * 로컬 작업들을 원자적으로 적용하고 히스토리에 기록 (시각이 비어 있는 작업은 현재 시각으로 기록)
+	 * @return 성공 여부 (실패하면 내용은 바뀌지 않음)
+	 */
+	bool ApplyLocalOperations(const TArray<FJsonCRDTOperation>& Operations);
+
+	/**
+	 * 패치 적용 (이미 적용한 시퀀스는 건너뜀, 작업 하나가 실패하면 패치 전체를 되돌림)
+	 * @return 성공하거나 이미 적용한 패치이면 true
+	 */
+	bool ApplyPatch(const FJsonCRDTPatch& Patch);
+
+	/** 더 필요 없는 패치 적용 (작업을 복사하지 않고 히스토리로 옮김) */
+	bool ApplyPatch(FJsonCRDTPatch&& Patch);
+
+	/** 내용과 작업 히스토리가 차지하는 힙 메모리 (상수 시간) */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	/** 문서 ID */
+	FString DocumentID;
+
+	/** 문서 버전 */
+	int64 Version;
+
+	/** 문서 내용 */
+	FJsonCRDTNodeStore Content;
+
+	/** 적용한 작업 히스토리 (링 버퍼, 경로 색인) */
+	FJsonCRDTOperationHistory OperationHistory;
+
+	/** 클라이언트별로 적용한 마지막 패치 시퀀스 */
+	FVersionVector VersionVector;
+
+	/** 파싱된 경로 캐시 */
+	mutable FJsonCRDTPathCache PathCache;
+
+	/** 확인을 마친 패치의 작업 적용 (작업은 히스토리로 옮겨짐) */
+	bool ApplyAcceptedPatch(FJsonCRDTPatch& Patch);
+};
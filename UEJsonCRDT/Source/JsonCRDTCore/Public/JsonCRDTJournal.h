@@ -0,0 +1,37 @@
+// Copyright Your Company. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonCRDTTypes.h"
+
+/**
+ * 로컬 저장 파일 옆에 두는 추가 전용 작업 저널의 레코드 형식
+ *
+ * 레코드 하나는 버전 하나의 변경(BaseVersion에서 BaseVersion + 1)이며 다음과 같이 기록됩니다.
+ *   [u32 PayloadLength][u32 PayloadCrc32][Payload]
+ * Payload는 패치 하나를 담은 FJsonCRDTBinaryCodec 프레임이며, 레코드마다 사전을 새로 시작하므로
+ * 레코드끼리 독립적입니다. 정수는 리틀 엔디언으로 기록합니다.
+ * 쓰는 도중 중단되어 잘리거나 손상된 레코드는 길이와 체크섬으로 감지하며 그 뒤는 읽지 않습니다.
+ */
+class JSONCRDTCORE_API FJsonCRDTJournal
+{
+public:
+	/** 레코드 머리 크기 (길이 + 체크섬) */
+	static constexpr int32 RecordHeaderSize = 8;
+
+	/**
+	 * 레코드 인코딩
+	 * @param Record 버전 변경 하나 (BaseVersion은 변경 전 버전, Operations는 실제로 적용된 작업)
+	 * @param OutBytes 레코드를 뒤에 추가할 버퍼
+	 */
+	static void AppendRecord(const FJsonCRDTPatch& Record, TArray<uint8>& OutBytes);
+
+	/**
+	 * 저널 바이트에서 레코드 읽기
+	 * @param Bytes 저널 파일 내용
+	 * @param OutRecords 읽은 레코드 (뒤에 추가됨)
+	 * @return 온전한 레코드가 차지하는 앞부분 바이트 수 (Bytes.Num()보다 작으면 뒷부분이 잘렸거나 손상됨)
+	 */
+	static int32 ReadRecords(const TArray<uint8>& Bytes, TArray<FJsonCRDTPatch>& OutRecords);
+};
@@ -0,0 +1,444 @@
+// Copyright Your Company. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonWriter.h"
+#include "JsonCRDTPath.h"
+
+/**
+ * 노드 값 타입
+ */
+enum class EJsonCRDTNodeType : uint8
+{
+	Null,
+	Boolean,
+	Number,
+	String,
+	Array,
+	Object
+};
+
+/**
+ * 노드 저장소의 단일 노드
+ *
+ * 스칼라 값은 노드 안에 바로 저장하고(문자열은 저장소의 문자열 테이블 인덱스),
+ * 컨테이너는 자식 노드 인덱스만 가집니다.
+ */
+struct FJsonCRDTNode
+{
+	/** 값 타입 */
+	EJsonCRDTNodeType Type = EJsonCRDTNodeType::Null;
+
+	/** 인라인 스칼라 값 */
+	union
+	{
+		bool bBoolValue;
+		double NumberValue;
+		int32 StringIndex;
+	};
+
+	/** 부모 노드 인덱스 (루트 또는 분리된 노드는 INDEX_NONE) */
+	int32 Parent = INDEX_NONE;
+
+	/** 마지막으로 값을 쓴 작업의 타임스탬프 (LWW 비교용, FDateTime 틱) */
+	int64 Timestamp = 0;
+
+	/** 자식 노드 (배열 요소 또는 객체 필드 값, 삽입 순서 유지) */
+	TArray<int32> Children;
+
+	/** 객체 필드의 인터닝된 키 (Children과 같은 순서, 키로 자식을 찾을 때는 저장소의 필드 색인 사용) */
+	TArray<int32> ChildKeys;
+
+	FJsonCRDTNode()
+		: NumberValue(0.0)
+	{
+	}
+
+	bool IsContainer() const
+	{
+		return Type == EJsonCRDTNodeType::Array || Type == EJsonCRDTNodeType::Object;
+	}
+};
+
+/**
+ * 단일 스칼라 값 (노드 저장소 밖에서 값을 주고받을 때 사용)
+ */
+struct FJsonCRDTScalar
+{
+	EJsonCRDTNodeType Type = EJsonCRDTNodeType::Null;
+	bool bBoolValue = false;
+	double NumberValue = 0.0;
+	FString StringValue;
+};
+
+/**
+ * JSON 문서를 위한 아레나 기반 노드 저장소
+ *
+ * 모든 노드는 하나의 연속된 희소 배열에 저장되며 객체 키는 저장소 단위로 인터닝됩니다.
+ * FJsonObject 트리는 ToJsonObject()로 요청할 때만 만들어지므로
+ * 작업 적용 경로에서는 공유 포인터 할당이 발생하지 않습니다.
+ */
+class JSONCRDTCORE_API FJsonCRDTNodeStore
+{
+public:
+	/** 빈 객체 하나를 루트로 가진 저장소를 만듭니다 */
+	FJsonCRDTNodeStore();
+
+	/** 빈 객체 루트로 초기화 */
+	void Reset();
+
+	/** 루트 노드 인덱스 */
+	int32 GetRoot() const { return RootIndex; }
+
+	/** 노드 인덱스 유효성 확인 */
+	bool IsValidNode(int32 NodeIndex) const { return Nodes.IsValidIndex(NodeIndex); }
+
+	/** 노드 가져오기 */
+	const FJsonCRDTNode& GetNode(int32 NodeIndex) const { return Nodes[NodeIndex]; }
+
+	/** 문자열 노드의 값 */
+	const FString& GetString(int32 NodeIndex) const { return Strings[Nodes[NodeIndex].StringIndex]; }
+
+	/** 인터닝된 키 문자열 */
+	const FString& GetKey(int32 KeyIndex) const { return Keys[KeyIndex]; }
+
+	/** 노드 수 */
+	int32 NumNodes() const { return Nodes.Num(); }
+
+	/**
+	 * JSON 문자열을 루트 객체로 로드합니다 (실패 시 기존 내용 유지)
+	 * @param JsonString 객체 형식의 JSON 문자열
+	 * @return 성공 여부
+	 */
+	bool LoadFromString(const FString& JsonString);
+
+	/**
+	 * FJsonObject 트리를 루트 객체로 로드합니다
+	 * @param JsonObject 가져올 객체
+	 * @return 성공 여부
+	 */
+	bool LoadFromJsonObject(const TSharedPtr<FJsonObject>& JsonObject);
+
+	/**
+	 * JSON 문자열을 분리된 노드 서브트리로 파싱합니다
+	 * @param JsonString JSON 값 (스칼라 포함)
+	 * @param Timestamp 새 노드에 기록할 타임스탬프
+	 * @return 새 노드 인덱스 (실패 시 INDEX_NONE)
+	 */
+	int32 ParseValue(const FString& JsonString, int64 Timestamp = 0);
+
+	/**
+	 * FJsonValue를 분리된 노드 서브트리로 가져옵니다
+	 * @param Value 가져올 값
+	 * @param Timestamp 새 노드에 기록할 타임스탬프
+	 * @return 새 노드 인덱스
+	 */
+	int32 ImportValue(const TSharedPtr<FJsonValue>& Value, int64 Timestamp = 0);
+
+	/**
+	 * 경로에 값 추가 (RFC 6902 add, 객체 필드는 덮어쓰고 배열은 삽입)
+	 * @param Path 대상 경로
+	 * @param ValueNode 분리된 값 노드 (성공 여부와 관계없이 저장소가 소유권을 가짐)
+	 * @return 성공 여부
+	 */
+	bool Add(const FJsonCRDTPath& Path, int32 ValueNode);
+
+	/**
+	 * 경로의 값 제거 (RFC 6902 remove)
+	 * @param Path 대상 경로 (루트는 제거할 수 없음)
+	 * @return 성공 여부
+	 */
+	bool Remove(const FJsonCRDTPath& Path);
+
+	/**
+	 * 경로의 기존 값 교체 (RFC 6902 replace)
+	 * @param Path 대상 경로 (값이 이미 있어야 함)
+	 * @param ValueNode 분리된 값 노드 (성공 여부와 관계없이 저장소가 소유권을 가짐)
+	 * @return 성공 여부
+	 */
+	bool Replace(const FJsonCRDTPath& Path, int32 ValueNode);
+
+	/**
+	 * 값을 다른 경로로 이동 (RFC 6902 move, 실패 시 원래 위치로 복구)
+	 * @param From 원본 경로
+	 * @param Path 대상 경로 (원본의 하위 경로일 수 없음)
+	 * @param Timestamp 이동한 노드에 기록할 타임스탬프
+	 * @return 성공 여부
+	 */
+	bool Move(const FJsonCRDTPath& From, const FJsonCRDTPath& Path, int64 Timestamp);
+
+	/**
+	 * 값을 다른 경로로 복사 (RFC 6902 copy)
+	 * @param From 원본 경로
+	 * @param Path 대상 경로
+	 * @param Timestamp 복사된 노드에 기록할 타임스탬프
+	 * @return 성공 여부
+	 */
+	bool Copy(const FJsonCRDTPath& From, const FJsonCRDTPath& Path, int64 Timestamp);
+
+	/**
+	 * 경로의 값이 주어진 값과 같은지 확인 (RFC 6902 test)
+	 * @param Path 대상 경로
+	 * @param ValueNode 비교할 노드 (소유권은 호출자에게 남음)
+	 * @return 같으면 true
+	 */
+	bool Test(const FJsonCRDTPath& Path, int32 ValueNode) const;
+
+	/**
+	 * 스칼라 노드의 값을 제자리에서 바꿉니다 (새 노드를 할당하지 않음)
+	 * @param NodeIndex 대상 노드 (컨테이너면 실패)
+	 * @param Scalar 새 값
+	 * @param Timestamp 기록할 타임스탬프
+	 * @return 성공 여부
+	 */
+	bool SetScalar(int32 NodeIndex, const FJsonCRDTScalar& Scalar, int64 Timestamp);
+
+	/** 두 노드의 값이 같은지 깊은 비교 (숫자는 값으로 비교) */
+	bool NodesEqual(int32 NodeA, int32 NodeB) const;
+
+	/** 노드 서브트리를 복제해 분리된 새 노드로 반환 */
+	int32 CloneSubtree(int32 NodeIndex, int64 Timestamp);
+
+	/** 트리에 연결되지 않은 노드와 하위 노드 해제 */
+	void ReleaseNode(int32 NodeIndex);
+
+	/** 루트를 FJsonObject 트리로 변환 */
+	TSharedPtr<FJsonObject> ToJsonObject() const;
+
+	/** 노드를 FJsonValue 트리로 변환 */
+	TSharedPtr<FJsonValue> ToJsonValue(int32 NodeIndex) const;
+
+	/** 루트를 JSON 문자열로 직렬화 */
+	FString ToString() const;
+
+	/** 노드를 JSON 문자열로 직렬화 */
+	FString NodeToString(int32 NodeIndex) const;
+
+	/**
+	 * 노드를 JSON 작성기에 직접 씁니다
+	 * @param NodeIndex 쓸 노드
+	 * @param Writer JSON 작성기
+	 * @param Identifier 객체 필드로 쓸 때의 이름 (배열 요소나 루트면 nullptr)
+	 */
+	template <class CharType, class PrintPolicy>
+	void WriteNode(int32 NodeIndex, const TSharedRef<TJsonWriter<CharType, PrintPolicy>>& Writer, const FString* Identifier = nullptr) const;
+
+	/**
+	 * 경로가 가리키는 노드 찾기
+	 * @param Path 파싱된 경로
+	 * @return 노드 인덱스 (없으면 INDEX_NONE)
+	 */
+	int32 Resolve(const FJsonCRDTPath& Path) const { return ResolvePrefix(Path, Path.Num()); }
+
+	/**
+	 * 경로의 앞쪽 NumTokens개 세그먼트가 가리키는 노드 찾기
+	 * @param Path 파싱된 경로
+	 * @param NumTokens 따라갈 세그먼트 수
+	 * @return 노드 인덱스 (없으면 INDEX_NONE)
+	 */
+	int32 ResolvePrefix(const FJsonCRDTPath& Path, int32 NumTokens) const;
+
+	/**
+	 * 컨테이너에서 경로 세그먼트 하나에 해당하는 자식 찾기
+	 * @param ContainerIndex 객체 또는 배열 노드
+	 * @param Path 파싱된 경로
+	 * @param TokenIndex 사용할 세그먼트 인덱스
+	 * @return 자식 노드 인덱스 (없으면 INDEX_NONE)
+	 */
+	int32 FindChild(int32 ContainerIndex, const FJsonCRDTPath& Path, int32 TokenIndex) const;
+
+	/**
+	 * 노드의 구체적인 JSON Pointer 경로 생성 (배열은 실제 인덱스, 키는 ~0/~1 이스케이프)
+	 * @param NodeIndex 트리에 연결된 노드
+	 * @return 경로 (루트는 빈 문자열)
+	 */
+	FString BuildPath(int32 NodeIndex) const;
+
+	/** 키 인덱스 찾기 (인터닝되지 않았으면 INDEX_NONE) */
+	int32 FindKey(const FString& Key) const;
+
+	/** 키를 인터닝하고 인덱스 반환 */
+	int32 InternKey(const FString& Key);
+
+	/** 할당된 메모리 크기 (바이트, 변경될 때마다 갱신되는 값이므로 상수 시간) */
+	SIZE_T GetAllocatedSize() const;
+
+	/** 스칼라 JSON 문자열을 빠르게 파싱 (객체/배열이면 false) */
+	static bool ParseScalar(const FString& JsonString, FJsonCRDTScalar& OutScalar);
+
+private:
+	/** 바이너리 로컬 저장 형식은 노드 배열을 직접 쓰고 읽음 */
+	friend class FJsonCRDTBinaryDocument;
+
+	/** 노드 배열 */
+	TSparseArray<FJsonCRDTNode> Nodes;
+
+	/** 문자열 값 테이블 */
+	TSparseArray<FString> Strings;
+
+	/** 인터닝된 객체 키 */
+	TArray<FString> Keys;
+
+	/** 키 문자열에서 인덱스로의 맵 */
+	TMap<FString, int32, FDefaultSetAllocator, TJsonCRDTCaseSensitiveMapKeyFuncs<int32>> KeyIndices;
+
+	/**
+	 * 객체 필드 색인 ((객체 노드, 키 인덱스) -> 자식 노드)
+	 * 넓은 객체에서도 경로 한 단계를 상수 시간에 찾도록 저장소 전체에서 하나만 유지합니다 (노드마다 맵을 두지 않음).
+	 */
+	TMap<uint64, int32> FieldNodes;
+
+	/** 필드 색인 키 */
+	static uint64 MakeFieldKey(int32 ContainerIndex, int32 KeyIndex)
+	{
+		return (static_cast<uint64>(static_cast<uint32>(ContainerIndex)) << 32) | static_cast<uint32>(KeyIndex);
+	}
+
+	/** 객체의 키에 연결된 자식 노드 (없으면 INDEX_NONE) */
+	int32 FindField(int32 ContainerIndex, int32 KeyIndex) const
+	{
+		const int32* Child = FieldNodes.Find(MakeFieldKey(ContainerIndex, KeyIndex));
+		return Child ? *Child : INDEX_NONE;
+	}
+
+	/** 루트 노드 인덱스 */
+	int32 RootIndex;
+
+	/** 노드 배열 밖에 할당된 메모리 (문자열 값, 키, 자식 목록) */
+	SIZE_T PayloadBytes;
+
+	/** 문자열 값 추가 */
+	int32 AddString(FString&& Value);
+
+	/** 문자열 값 제거 */
+	void RemoveString(int32 StringIndex);
+
+	/** 자식 목록 공간 미리 확보 */
+	void ReserveChildren(int32 ContainerIndex, int32 NumChildren);
+
+	/** 노드의 자식 목록이 차지하는 메모리 */
+	static SIZE_T GetChildListSize(const FJsonCRDTNode& Node)
+	{
+		return Node.Children.GetAllocatedSize() + Node.ChildKeys.GetAllocatedSize();
+	}
+
+	/** 새 노드 할당 */
+	int32 AllocateNode(EJsonCRDTNodeType Type, int64 Timestamp);
+
+	/** 스칼라 값으로 새 노드 할당 */
+	int32 AllocateScalar(const FJsonCRDTScalar& Scalar, int64 Timestamp);
+
+	/** 노드와 모든 하위 노드 해제 */
+	void FreeSubtree(int32 NodeIndex);
+
+	/** 자식을 컨테이너 끝에 연결 */
+	void AppendChild(int32 ContainerIndex, int32 KeyIndex, int32 ChildIndex);
+
+	/** 토큰 기반 JSON 파싱 (객체/배열 루트) */
+	int32 ParseContainer(const FString& JsonString, int64 Timestamp);
+
+	/** 자식을 컨테이너의 지정 위치에 연결 */
+	void InsertChild(int32 ContainerIndex, int32 Slot, int32 KeyIndex, int32 ChildIndex);
+
+	/**
+	 * 노드를 부모에서 분리 (해제하지 않음)
+	 * @param NodeIndex 분리할 노드
+	 * @param OutSlot 부모 안에서의 위치
+	 * @param OutKeyIndex 객체 필드였다면 키 인덱스
+	 * @return 원래 부모 노드 (루트면 INDEX_NONE)
+	 */
+	int32 DetachNode(int32 NodeIndex, int32& OutSlot, int32& OutKeyIndex);
+
+	/** 경로 위치에 분리된 노드 연결 (실패 시 노드는 해제하지 않음) */
+	bool AttachAtPath(const FJsonCRDTPath& Path, int32 ValueNode);
+
+	/** 루트를 주어진 객체 노드로 교체 */
+	bool ReplaceRoot(int32 ValueNode);
+};
+
+template <class CharType, class PrintPolicy>
+void FJsonCRDTNodeStore::WriteNode(int32 NodeIndex, const TSharedRef<TJsonWriter<CharType, PrintPolicy>>& Writer, const FString* Identifier) const
+{
+	const FJsonCRDTNode& Node = Nodes[NodeIndex];
+	switch (Node.Type)
+	{
+	case EJsonCRDTNodeType::Null:
+		if (Identifier)
+		{
+			Writer->WriteNull(*Identifier);
+		}
+		else
+		{
+			Writer->WriteNull();
+		}
+		break;
+
+	case EJsonCRDTNodeType::Boolean:
+		if (Identifier)
+		{
+			Writer->WriteValue(*Identifier, Node.bBoolValue);
+		}
+		else
+		{
+			Writer->WriteValue(Node.bBoolValue);
+		}
+		break;
+
+	case EJsonCRDTNodeType::Number:
+		if (Identifier)
+		{
+			Writer->WriteValue(*Identifier, Node.NumberValue);
+		}
+		else
+		{
+			Writer->WriteValue(Node.NumberValue);
+		}
+		break;
+
+	case EJsonCRDTNodeType::String:
+		if (Identifier)
+		{
+			Writer->WriteValue(*Identifier, Strings[Node.StringIndex]);
+		}
+		else
+		{
+			Writer->WriteValue(Strings[Node.StringIndex]);
+		}
+		break;
+
+	case EJsonCRDTNodeType::Array:
+		if (Identifier)
+		{
+			Writer->WriteArrayStart(*Identifier);
+		}
+		else
+		{
+			Writer->WriteArrayStart();
+		}
+		for (int32 ChildIndex : Node.Children)
+		{
+			WriteNode(ChildIndex, Writer);
+		}
+		Writer->WriteArrayEnd();
+		break;
+
+	case EJsonCRDTNodeType::Object:
+		if (Identifier)
+		{
+			Writer->WriteObjectStart(*Identifier);
+		}
+		else
+		{
+			Writer->WriteObjectStart();
+		}
+		for (int32 i = 0; i < Node.Children.Num(); ++i)
+		{
+			WriteNode(Node.Children[i], Writer, &Keys[Node.ChildKeys[i]]);
+		}
+		Writer->WriteObjectEnd();
+		break;
+	}
+}
@@ -0,0 +1,31 @@
+// Copyright Your Company. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonCRDTTypes.h"
+#include "JsonCRDTPath.h"
+#include "JsonCRDTNodeStore.h"
+
+/**
+ * 노드 저장소에 작업을 적용하는 RFC 6902 의미 구현
+ *
+ * UJsonCRDTDocument의 작업 적용과 역작업 생성이 이 코드를 사용하며, 엔진 없이 노드 저장소만 다루는
+ * 프로그램(데디케이티드 서버, 봇, 부하 테스트)에서도 같은 결과를 얻을 수 있습니다.
+ */
+class JSONCRDTCORE_API FJsonCRDTOperationApplier
+{
+public:
+	/**
+	 * 노드 저장소에 작업 하나 적용 (저장소를 제자리에서 변경)
+	 * @param Store 대상 저장소
+	 * @param Operation 적용할 작업
+	 * @param InPathCache 경로 파싱 캐시
+	 * @param OutInverse 작업을 되돌리는 역작업을 추가할 배열 (적용 순서대로 추가되므로 되돌릴 때는 뒤에서부터 적용, 필요 없으면 nullptr)
+	 * @return 성공 여부
+	 */
+	static bool Apply(FJsonCRDTNodeStore& Store, const FJsonCRDTOperation& Operation, FJsonCRDTPathCache& InPathCache, TArray<FJsonCRDTOperation>* OutInverse);
+
+	/** 원본 작업의 시각과 클라이언트 ID로 역작업 생성 */
+	static FJsonCRDTOperation MakeInverse(const FJsonCRDTOperation& Source, EJsonCRDTOperationType Type, const FString& Path, const FString& Value = FString(), const FString& FromPath = FString());
+};
@@ -0,0 +1,138 @@
+// Copyright Your Company. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonCRDTTypes.h"
+#include "JsonCRDTPath.h"
+
+/**
+ * 경로 색인이 있는 고정 용량 작업 히스토리
+ *
+ * 작업은 링 버퍼에 저장되어 추가 시 배열 이동이 없고,
+ * 경로별 가장 최근 Replace 작업을 해시 색인으로 유지해 충돌 검사를 상수 시간에 처리합니다.
+ * 각 작업에는 증가하는 시퀀스 번호가 붙으며 밀려난 작업의 번호는 재사용되지 않습니다.
+ * 클라이언트 ID는 작업마다 복사해 두지 않고 히스토리 단위로 인터닝하므로,
+ * 저장된 작업의 ClientID는 비어 있고 GetClientID나 CopyBySequence로 얻습니다.
+ */
+class JSONCRDTCORE_API FJsonCRDTOperationHistory
+{
+public:
+	/** 시퀀스 번호가 없음을 나타내는 값 */
+	static constexpr uint64 InvalidSequence = MAX_uint64;
+
+	/**
+	 * 생성자
+	 * @param InCapacity 유지할 최대 작업 수
+	 */
+	explicit FJsonCRDTOperationHistory(int32 InCapacity = 4096);
+
+	/**
+	 * 작업 추가 (가득 차면 가장 오래된 작업을 덮어씀)
+	 * @param Operation 추가할 작업
+	 * @return 추가된 작업의 시퀀스 번호
+	 */
+	uint64 Add(const FJsonCRDTOperation& Operation);
+	uint64 Add(FJsonCRDTOperation&& Operation);
+
+	/**
+	 * 경로에 대한 가장 최근 Replace 작업 찾기
+	 * @param Path 작업 경로
+	 * @return 작업 (없거나 이미 밀려났으면 nullptr)
+	 */
+	const FJsonCRDTOperation* FindLatestReplace(const FString& Path) const;
+
+	/**
+	 * 시퀀스 번호로 작업 찾기
+	 * @param Sequence 시퀀스 번호
+	 * @return 작업 (없거나 이미 밀려났으면 nullptr, ClientID는 비어 있음)
+	 */
+	const FJsonCRDTOperation* FindBySequence(uint64 Sequence) const;
+
+	/**
+	 * 시퀀스 번호의 작업을 클라이언트 ID까지 채워 복사
+	 * @param Sequence 시퀀스 번호
+	 * @param OutOperation 복사할 작업
+	 * @return 작업이 아직 히스토리에 있으면 true
+	 */
+	bool CopyBySequence(uint64 Sequence, FJsonCRDTOperation& OutOperation) const;
+
+	/** 시퀀스 번호의 작업을 만든 클라이언트 ID (없거나 이미 밀려났으면 빈 문자열) */
+	const FString& GetClientID(uint64 Sequence) const;
+
+	/** 가장 최근 Replace 작업의 시퀀스 번호 (없으면 InvalidSequence) */
+	uint64 FindLatestReplaceSequence(const FString& Path) const;
+
+	/** 오래된 순서로 Index번째 작업 (0이 가장 오래된 작업, ClientID는 비어 있음) */
+	const FJsonCRDTOperation& Get(int32 Index) const;
+
+	/** 저장된 작업 수 */
+	int32 Num() const { return Count; }
+
+	/** 최대 작업 수 */
+	int32 GetCapacity() const { return Capacity; }
+
+	/**
+	 * 최대 작업 수 변경 (줄이면 오래된 작업부터 버림)
+	 * @param NewCapacity 새 최대 작업 수
+	 */
+	void SetCapacity(int32 NewCapacity);
+
+	/** 가장 오래된 작업의 시퀀스 번호 */
+	uint64 GetOldestSequence() const { return NextSequence - Count; }
+
+	/** 다음에 추가될 작업의 시퀀스 번호 */
+	uint64 GetNextSequence() const { return NextSequence; }
+
+	/** 모든 작업 제거 (시퀀스 번호는 계속 증가) */
+	void Empty();
+
+	/** 히스토리가 차지하는 힙 메모리 (작업 문자열은 추가하고 밀려날 때마다 갱신해 두므로 상수 시간) */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	/** 링 버퍼 */
+	TArray<FJsonCRDTOperation> Entries;
+
+	/** 링 버퍼 위치별 인터닝된 클라이언트 ID 인덱스 (Entries와 같은 위치) */
+	TArray<int32> EntryClients;
+
+	/** 인터닝된 클라이언트 ID (히스토리를 비울 때만 줄어듦) */
+	TArray<FString> ClientIDs;
+
+	/** 클라이언트 ID에서 인덱스로의 맵 */
+	TMap<FString, int32, FDefaultSetAllocator, TJsonCRDTCaseSensitiveMapKeyFuncs<int32>> ClientIndices;
+
+	/** 경로별 가장 최근 Replace 작업의 시퀀스 번호 */
+	TMap<FString, uint64, FDefaultSetAllocator, TJsonCRDTCaseSensitiveMapKeyFuncs<uint64>> LatestReplaceByPath;
+
+	/** 최대 작업 수 */
+	int32 Capacity;
+
+	/** 가장 오래된 작업의 버퍼 위치 */
+	int32 Head;
+
+	/** 저장된 작업 수 */
+	int32 Count;
+
+	/** 다음 시퀀스 번호 */
+	uint64 NextSequence;
+
+	/** 저장된 작업들의 문자열이 차지하는 메모리 */
+	SIZE_T OperationBytes;
+
+	/** 인터닝된 클라이언트 ID 문자열이 차지하는 메모리 (테이블과 맵 키) */
+	SIZE_T ClientIDBytes;
+
+	/** 새 작업이 들어갈 버퍼 위치를 확보하고 밀려나는 작업의 색인 정리 */
+	int32 ClaimSlot();
+
+	/** 추가된 작업을 색인에 등록 */
+	void IndexOperation(const FJsonCRDTOperation& Operation, uint64 Sequence);
+
+	/** 시퀀스 번호의 버퍼 위치 */
+	int32 GetSlot(uint64 Sequence) const;
+
+	/** 클라이언트 ID 인터닝 (빈 ID는 INDEX_NONE) */
+	int32 InternClientID(const FString& ClientID);
+};
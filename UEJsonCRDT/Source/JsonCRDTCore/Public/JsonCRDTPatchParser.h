@@ -0,0 +1,39 @@
+// Copyright Your Company. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonCRDTTypes.h"
+
+/**
+ * 패치 JSON을 중간 DOM 없이 한 번에 읽는 파서
+ *
+ * FJsonObject를 만들거나 리플렉션으로 필드를 채우지 않고 입력을 한 번 훑으며 패치를 바로 채웁니다.
+ * 작업 값은 다시 직렬화하지 않고 원문의 JSON 조각을 그대로 복사하며, 이스케이프가 없는 문자열은
+ * 한 번에 복사합니다. 필드 이름은 FJsonObject처럼 대소문자를 구분하지 않고 모르는 필드는 건너뜁니다.
+ * 작업에 시각이나 클라이언트 ID가 없으면 필드 순서와 관계없이 패치의 값을 사용합니다.
+ */
+class JSONCRDTCORE_API FJsonCRDTPatchParser
+{
+public:
+	/** 입력 형식 */
+	enum class EFormat : uint8
+	{
+		/** WebSocket 패치 메시지 (작업 값은 JSON 값 그대로) */
+		Message,
+
+		/** FJsonObjectConverter로 기록한 FJsonCRDTPatch (작업 값은 JSON 텍스트를 담은 문자열, 문자열이 아닌 값은 그대로 사용) */
+		Struct
+	};
+
+	/**
+	 * 패치 파싱
+	 * @param Json 입력 텍스트
+	 * @param Format 입력 형식
+	 * @param OutPatch 채울 패치 (기존 작업 배열과 문자열의 메모리를 재사용, 실패하면 내용은 정의되지 않음)
+	 * @param OutMessageType 최상위 "type" 필드 값 (Message 형식, 패치가 아닌 메시지여도 그 필드까지 읽었으면 채워짐)
+	 * @param OutError 실패 이유
+	 * @return 올바른 패치이면 true
+	 */
+	static bool Parse(FStringView Json, EFormat Format, FJsonCRDTPatch& OutPatch, FString* OutMessageType = nullptr, FString* OutError = nullptr);
+};
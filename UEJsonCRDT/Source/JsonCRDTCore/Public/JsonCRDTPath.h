@@ -0,0 +1,139 @@
+// Copyright Your Company. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Containers/LruCache.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * 대소문자를 구분하는 FString 키 해시/비교
+ *
+ * JSON 필드 이름과 경로는 대소문자를 구분하지만 FString의 기본 해시와 비교는 대소문자를 무시합니다.
+ */
+struct FJsonCRDTCaseSensitiveKeyFuncs
+{
+	static FORCEINLINE bool Matches(const FString& A, const FString& B)
+	{
+		return A.Equals(B, ESearchCase::CaseSensitive);
+	}
+
+	static FORCEINLINE uint32 GetKeyHash(const FString& Key)
+	{
+		return FCrc::StrCrc32(*Key);
+	}
+};
+
+/** FString 키를 대소문자 구분으로 다루는 TMap 키 함수 */
+template <typename ValueType>
+struct TJsonCRDTCaseSensitiveMapKeyFuncs : TDefaultMapKeyFuncs<FString, ValueType, false>
+{
+	static FORCEINLINE bool Matches(const FString& A, const FString& B)
+	{
+		return FJsonCRDTCaseSensitiveKeyFuncs::Matches(A, B);
+	}
+
+	static FORCEINLINE uint32 GetKeyHash(const FString& Key)
+	{
+		return FJsonCRDTCaseSensitiveKeyFuncs::GetKeyHash(Key);
+	}
+};
+
+/**
+ * 미리 파싱된 JSON Pointer (RFC 6901) 경로
+ *
+ * 세그먼트 분할과 ~0/~1 이스케이프 해제를 생성 시 한 번만 수행하고,
+ * 각 세그먼트의 배열 인덱스도 미리 계산해 둡니다.
+ * 기존 동작과 호환되도록 선행 '/'는 생략 가능하며 빈 세그먼트는 무시합니다.
+ */
+class JSONCRDTCORE_API FJsonCRDTPath
+{
+public:
+	/** 배열 끝을 가리키는 "-" 세그먼트의 인덱스 값 */
+	static constexpr int32 AppendIndex = -2;
+
+	FJsonCRDTPath() = default;
+	explicit FJsonCRDTPath(const FString& InPath);
+
+	/** 원본 경로 문자열 */
+	const FString& ToString() const { return Source; }
+
+	/** 루트(전체 문서)를 가리키는지 여부 */
+	bool IsRoot() const { return Tokens.Num() == 0; }
+
+	/** 세그먼트 수 */
+	int32 Num() const { return Tokens.Num(); }
+
+	/** 이스케이프가 해제된 세그먼트 */
+	const FString& GetToken(int32 Index) const { return Tokens[Index]; }
+
+	/** 세그먼트를 배열 인덱스로 해석한 값 (숫자가 아니면 INDEX_NONE, "-"이면 AppendIndex) */
+	int32 GetArrayIndex(int32 Index) const { return ArrayIndices[Index]; }
+
+	/**
+	 * FJsonObject 트리에서 경로의 값을 찾습니다.
+	 * 배열은 복사하지 않고 참조로 탐색합니다.
+	 * @param Root 탐색을 시작할 객체
+	 * @return 찾은 값 (없으면 nullptr)
+	 */
+	TSharedPtr<FJsonValue> Resolve(const TSharedPtr<FJsonObject>& Root) const;
+
+	/**
+	 * 앞쪽 NumTokens개의 세그먼트만 따라가 값을 찾습니다.
+	 * @param Root 탐색을 시작할 객체
+	 * @param NumTokens 따라갈 세그먼트 수
+	 * @return 찾은 값 (없으면 nullptr)
+	 */
+	TSharedPtr<FJsonValue> ResolvePrefix(const TSharedPtr<FJsonObject>& Root, int32 NumTokens) const;
+
+private:
+	/** 원본 경로 */
+	FString Source;
+
+	/** 이스케이프가 해제된 세그먼트 */
+	TArray<FString> Tokens;
+
+	/** 세그먼트별 배열 인덱스 */
+	TArray<int32> ArrayIndices;
+};
+
+/**
+ * 파싱된 경로의 LRU 캐시
+ *
+ * 같은 경로가 반복해서 들어오는 패치 부하에서 파싱 비용을 한 번으로 줄입니다.
+ * 내부적으로 잠금을 사용하므로 어느 스레드에서나 호출할 수 있습니다.
+ */
+class JSONCRDTCORE_API FJsonCRDTPathCache
+{
+public:
+	/**
+	 * 생성자
+	 * @param InMaxEntries 캐시에 유지할 최대 경로 수
+	 */
+	explicit FJsonCRDTPathCache(int32 InMaxEntries = 512);
+
+	/**
+	 * 파싱된 경로 가져오기 (캐시에 없으면 파싱 후 추가)
+	 * @param Path JSON Pointer 문자열
+	 * @return 파싱된 경로
+	 */
+	TSharedRef<const FJsonCRDTPath, ESPMode::ThreadSafe> Get(const FString& Path);
+
+	/** 캐시 비우기 */
+	void Empty();
+
+	/** 캐시된 경로 수 */
+	int32 Num() const;
+
+	/** 문서에 속하지 않은 호출부(블루프린트 라이브러리 등)가 공유하는 캐시 */
+	static FJsonCRDTPathCache& GetShared();
+
+private:
+	/** 경로 문자열에서 파싱된 경로로의 LRU 맵 */
+	TLruCache<FString, TSharedPtr<const FJsonCRDTPath, ESPMode::ThreadSafe>, FJsonCRDTCaseSensitiveKeyFuncs> Entries;
+
+	/** 캐시 접근 보호 */
+	mutable FCriticalSection Lock;
+};
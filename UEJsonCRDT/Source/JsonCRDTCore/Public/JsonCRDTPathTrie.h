@@ -0,0 +1,85 @@
+// Copyright Your Company. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonCRDTPath.h"
+
+/**
+ * 경로 세그먼트 단위 접두사 트리
+ *
+ * 경로마다 구독 번호를 등록해 두고, 바뀐 경로가 주어지면 그 경로의 상위 경로(서브트리 안이 바뀜)와
+ * 하위 경로(부모가 통째로 바뀜)에 등록된 번호를 모읍니다. 등록된 경로 수와 관계없이
+ * 바뀐 경로의 깊이와 그 아래에 실제로 등록된 노드 수만큼만 방문합니다.
+ */
+class JSONCRDTCORE_API FJsonCRDTPathTrie
+{
+public:
+	FJsonCRDTPathTrie();
+
+	/**
+	 * 경로에 번호 등록
+	 * @param Path 파싱된 경로 (루트면 모든 변경에 해당)
+	 * @param Id 등록할 번호
+	 */
+	void Add(const FJsonCRDTPath& Path, int32 Id);
+
+	/**
+	 * 경로에서 번호 제거 (비게 된 노드는 정리)
+	 * @param Path 등록할 때 사용한 경로
+	 * @param Id 제거할 번호
+	 */
+	void Remove(const FJsonCRDTPath& Path, int32 Id);
+
+	/**
+	 * 경로의 앞쪽 NumTokens개 세그먼트가 바뀌었을 때 영향을 받는 번호 모으기
+	 * @param Path 바뀐 경로
+	 * @param NumTokens 사용할 세그먼트 수
+	 * @param OutIds 번호를 추가할 집합
+	 */
+	void CollectAffected(const FJsonCRDTPath& Path, int32 NumTokens, TSet<int32>& OutIds) const;
+
+	/**
+	 * 배열 요소가 삽입되거나 제거되어 뒤쪽 요소의 인덱스가 밀렸을 때 영향을 받는 번호 모으기
+	 * (배열 경로의 상위 경로, 배열 경로 자체, FirstIndex 이상의 요소 경로와 그 아래 경로)
+	 * @param Path 배열 요소 경로
+	 * @param NumTokens 배열 경로의 세그먼트 수
+	 * @param FirstIndex 인덱스가 바뀐 첫 요소 (끝에 추가한 경우 MAX_int32)
+	 * @param OutIds 번호를 추가할 집합
+	 */
+	void CollectArrayShift(const FJsonCRDTPath& Path, int32 NumTokens, int32 FirstIndex, TSet<int32>& OutIds) const;
+
+	/** 등록된 번호가 없는지 여부 */
+	bool IsEmpty() const { return NumIds == 0; }
+
+	/** 모든 등록 제거 */
+	void Reset();
+
+private:
+	struct FNode
+	{
+		/** 세그먼트별 자식 노드 */
+		TMap<FString, int32, FDefaultSetAllocator, TJsonCRDTCaseSensitiveMapKeyFuncs<int32>> Children;
+
+		/** 이 경로에 등록된 번호 */
+		TArray<int32, TInlineAllocator<1>> Ids;
+
+		/** 부모 노드 (루트는 INDEX_NONE) */
+		int32 Parent = INDEX_NONE;
+
+		/** 부모에서 이 노드로 오는 세그먼트 */
+		FString Token;
+	};
+
+	/** 노드 배열 (0번이 루트) */
+	TSparseArray<FNode> Nodes;
+
+	/** 등록된 번호 수 */
+	int32 NumIds;
+
+	/** 경로 노드 찾기 (없으면 INDEX_NONE) */
+	int32 FindNode(const FJsonCRDTPath& Path, int32 NumTokens) const;
+
+	/** 노드와 모든 하위 노드의 번호 모으기 */
+	void CollectSubtree(int32 NodeIndex, TSet<int32>& OutIds) const;
+};
@@ -0,0 +1,81 @@
+// Copyright Your Company. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonCRDTTypes.h"
+
+/**
+ * 서버로 보낼 로컬 작업 대기열
+ *
+ * 작업을 추가할 때 같은 경로의 중복 작업을 바로 합칩니다.
+ * - 같은 경로에 대한 연속된 Replace는 마지막 값만 남김 (앞선 Add에도 합쳐짐)
+ * - 새 값을 만든 Add 뒤의 Remove는 둘 다 제거
+ * - 기존 값을 덮어쓴 Add나 Replace 뒤의 Remove는 Remove만 남김
+ * 사이에 같은 경로나 그 상위/하위 경로, 같은 배열의 위치를 바꾸는 작업이 있으면 합치지 않습니다.
+ */
+class JSONCRDTCORE_API FJsonCRDTPendingQueue
+{
+public:
+	FJsonCRDTPendingQueue();
+
+	/**
+	 * 작업 추가
+	 * @param Operation 이미 로컬에 적용된 작업
+	 * @param bCreatesValue 작업이 없던 값을 새로 만들었는지 여부 (Add/Copy의 역작업이 Remove인 경우)
+	 * @param InBaseVersion 대기열이 비어 있을 때 사용할 기준 버전 (작업 적용 전 문서 버전)
+	 */
+	void Add(FJsonCRDTOperation&& Operation, bool bCreatesValue, int64 InBaseVersion);
+
+	/**
+	 * 대기 중인 작업을 모두 꺼냄
+	 * @param OutOperations 작업 (기존 내용은 교체됨)
+	 * @param OutBaseVersion 첫 작업의 기준 버전
+	 * @return 꺼낸 작업이 있으면 true
+	 */
+	bool Take(TArray<FJsonCRDTOperation>& OutOperations, int64& OutBaseVersion);
+
+	/**
+	 * 전송하지 못한 작업을 대기열 앞에 되돌림 (되돌린 작업에는 더 이상 합치지 않음)
+	 * @param Operations 되돌릴 작업
+	 * @param InBaseVersion 되돌린 작업의 기준 버전
+	 */
+	void Requeue(TArray<FJsonCRDTOperation>&& Operations, int64 InBaseVersion);
+
+	/** 대기 중인 작업 수 */
+	int32 Num() const { return Entries.Num(); }
+
+	/** 대기 중인 작업 (오래된 순서) */
+	const FJsonCRDTOperation& Get(int32 Index) const { return Entries[Index].Operation; }
+
+	/** 첫 작업의 기준 버전 */
+	int64 GetBaseVersion() const { return BaseVersion; }
+
+	/** 모든 작업 제거 */
+	void Empty();
+
+	/** 할당된 메모리 크기 (바이트, 상수 시간) */
+	SIZE_T GetAllocatedSize() const { return Entries.GetAllocatedSize() + OperationBytes; }
+
+private:
+	struct FEntry
+	{
+		FJsonCRDTOperation Operation;
+		bool bCreatesValue = false;
+	};
+
+	/** 대기 중인 작업 */
+	TArray<FEntry> Entries;
+
+	/** 앞에서부터 합치기 대상에서 제외된 작업 수 (되돌린 작업) */
+	int32 NumFrozen;
+
+	/** 첫 작업의 기준 버전 */
+	int64 BaseVersion;
+
+	/** 대기 중인 작업들의 문자열이 차지하는 메모리 */
+	SIZE_T OperationBytes;
+
+	/** 두 작업의 순서를 바꾸면 결과가 달라질 수 있는지 확인 (합칠 작업 사이에 있는 작업 검사) */
+	static bool Interferes(const FJsonCRDTOperation& Between, const FJsonCRDTOperation& Operation);
+};
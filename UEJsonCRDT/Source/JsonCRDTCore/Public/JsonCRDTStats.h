@@ -0,0 +1,41 @@
+// Copyright Your Company. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/**
+ * JsonCRDT 통계 그룹 (stat JsonCRDT)
+ *
+ * 사이클 카운터는 핫 패스의 시간을, 카운터는 프레임마다의 트래픽과 적용량을 보여 줍니다.
+ * 수신 대기열 깊이는 동기화 관리자가 틱마다, 대기 작업 수와 문서 메모리는 1초마다 갱신합니다.
+ * 같은 값은 UJsonCRDTSyncManager::GetSyncStats로 STATS 없이도 조회할 수 있습니다.
+ */
+DECLARE_STATS_GROUP(TEXT("JsonCRDT"), STATGROUP_JsonCRDT, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ApplyPatch"), STAT_JsonCRDT_ApplyPatch, STATGROUP_JsonCRDT, JSONCRDTCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ApplyOperation"), STAT_JsonCRDT_ApplyOperation, STATGROUP_JsonCRDT, JSONCRDTCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("CreateAndAddSnapshot"), STAT_JsonCRDT_CreateAndAddSnapshot, STATGROUP_JsonCRDT, JSONCRDTCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("SaveLocally"), STAT_JsonCRDT_SaveLocally, STATGROUP_JsonCRDT, JSONCRDTCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("SendPatch"), STAT_JsonCRDT_SendPatch, STATGROUP_JsonCRDT, JSONCRDTCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("OnWebSocketMessage"), STAT_JsonCRDT_OnWebSocketMessage, STATGROUP_JsonCRDT, JSONCRDTCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ProcessReceivedPatches"), STAT_JsonCRDT_ProcessReceivedPatches, STATGROUP_JsonCRDT, JSONCRDTCORE_API);
+
+/** 프레임마다 초기화되는 카운터 */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bytes Sent"), STAT_JsonCRDT_BytesSent, STATGROUP_JsonCRDT, JSONCRDTCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bytes Received"), STAT_JsonCRDT_BytesReceived, STATGROUP_JsonCRDT, JSONCRDTCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Patches Applied"), STAT_JsonCRDT_PatchesApplied, STATGROUP_JsonCRDT, JSONCRDTCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Conflicts Resolved"), STAT_JsonCRDT_ConflictsResolved, STATGROUP_JsonCRDT, JSONCRDTCORE_API);
+
+/** 마지막으로 설정한 값을 유지하는 카운터 */
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Received Queue Depth"), STAT_JsonCRDT_ReceivedQueueDepth, STATGROUP_JsonCRDT, JSONCRDTCORE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pending Operations"), STAT_JsonCRDT_PendingOperations, STATGROUP_JsonCRDT, JSONCRDTCORE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Offline Queued Operations"), STAT_JsonCRDT_OfflineQueuedOperations, STATGROUP_JsonCRDT, JSONCRDTCORE_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Document Memory"), STAT_JsonCRDT_DocumentMemory, STATGROUP_JsonCRDT, JSONCRDTCORE_API);
+
+/** 사이클 카운터와 Unreal Insights CPU 트레이스 범위를 함께 여는 매크로 (트레이스 이름은 통계 이름과 같음) */
+#define JSONCRDT_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(Stat)
@@ -0,0 +1,221 @@
+// Copyright Your Company. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonCRDTTypes.generated.h"
+
+/**
+ * Operation types for JSON CRDT
+ */
+UENUM(BlueprintType)
+enum class EJsonCRDTOperationType : uint8
+{
+	Add UMETA(DisplayName = "Add"),
+	Remove UMETA(DisplayName = "Remove"),
+	Replace UMETA(DisplayName = "Replace"),
+	Move UMETA(DisplayName = "Move"),
+	Copy UMETA(DisplayName = "Copy"),
+	Test UMETA(DisplayName = "Test")
+};
+
+/**
+ * On-disk format of a locally saved document
+ */
+UENUM(BlueprintType)
+enum class EJsonCRDTLocalStorageFormat : uint8
+{
+	/** Human-readable JSON file (<id>.json) */
+	Json UMETA(DisplayName = "JSON"),
+
+	/** Memory-mapped binary file read lazily on load (<id>.jcrdt) */
+	Binary UMETA(DisplayName = "Binary")
+};
+
+/**
+ * A single CRDT operation
+ */
+USTRUCT(BlueprintType)
+struct JSONCRDTCORE_API FJsonCRDTOperation
+{
+	GENERATED_BODY()
+
+	/** The type of operation */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	EJsonCRDTOperationType Type;
+
+	/** The path to the target location */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	FString Path;
+
+	/** The path to the source location (for Move and Copy operations) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	FString FromPath;
+
+	/** The value to use for the operation (as a JSON string) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	FString Value;
+
+	/** The timestamp of the operation (zero until stamped; local operations are stamped when applied) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	FDateTime Timestamp;
+
+	/** The ID of the client that created the operation */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	FString ClientID;
+
+	/** Does not read the clock, so decoding and resizing operation arrays stays cheap */
+	FJsonCRDTOperation()
+		: Type(EJsonCRDTOperationType::Add)
+	{
+	}
+
+	/** Heap memory owned by the operation's strings (not including the struct itself) */
+	SIZE_T GetAllocatedSize() const
+	{
+		return Path.GetAllocatedSize() + FromPath.GetAllocatedSize() + Value.GetAllocatedSize() + ClientID.GetAllocatedSize();
+	}
+};
+
+/**
+ * A patch containing multiple CRDT operations
+ */
+USTRUCT(BlueprintType)
+struct JSONCRDTCORE_API FJsonCRDTPatch
+{
+	GENERATED_BODY()
+
+	/** The ID of the document this patch applies to */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	FString DocumentID;
+
+	/** The version of the document this patch is based on */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	int64 BaseVersion;
+
+	/** The operations in this patch */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	TArray<FJsonCRDTOperation> Operations;
+
+	/** The timestamp of the patch */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	FDateTime Timestamp;
+
+	/** The ID of the client that created the patch */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	FString ClientID;
+
+	/** The creating client's sequence number for this document (from 1, 0 if unnumbered); receivers skip sequences they have applied */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	int64 Sequence;
+
+	/**
+	 * Highest sequence applied from each client (sync requests only). The server answers with the patches
+	 * the vector does not cover, instead of deriving what is missing from BaseVersion alone.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	TMap<FString, int64> VersionVector;
+
+	/** Does not read the clock; whoever sends or decodes the patch sets the timestamp */
+	FJsonCRDTPatch()
+		: BaseVersion(0)
+		, Sequence(0)
+	{
+	}
+};
+
+/**
+ * A snapshot of a document at a specific point in time
+ */
+USTRUCT(BlueprintType)
+struct JSONCRDTCORE_API FJsonCRDTSnapshot
+{
+	GENERATED_BODY()
+
+	/** The ID of the document */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	FString DocumentID;
+
+	/** The version of the document */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	int64 Version;
+
+	/** The timestamp of the snapshot */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	FDateTime Timestamp;
+
+	/** The content of the document (as a JSON string) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	FString Content;
+
+	FJsonCRDTSnapshot()
+		: Version(0)
+		, Timestamp(FDateTime::UtcNow())
+	{
+	}
+};
+
+/**
+ * The inverse operations that take a document from one version back to the previous one
+ */
+USTRUCT(BlueprintType)
+struct JSONCRDTCORE_API FJsonCRDTSnapshotDelta
+{
+	GENERATED_BODY()
+
+	/** The version the document had before the change */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	int64 PreviousVersion;
+
+	/** The version produced by the change */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	int64 Version;
+
+	/** Operations that undo the change, in the order they must be applied */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	TArray<FJsonCRDTOperation> InverseOperations;
+
+	FJsonCRDTSnapshotDelta()
+		: PreviousVersion(0)
+		, Version(0)
+	{
+	}
+};
+
+/**
+ * Controls when a document takes full snapshots and how much delta history it keeps
+ */
+USTRUCT(BlueprintType)
+struct JSONCRDTCORE_API FJsonCRDTSnapshotPolicy
+{
+	GENERATED_BODY()
+
+	/** Take a full snapshot when this many seconds have passed since the last one and there are changes (0 disables) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	float IntervalSeconds;
+
+	/** Take a full snapshot after this many applied operations (0 disables) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	int32 OperationsPerSnapshot;
+
+	/** Take a full snapshot once the document has been idle for this many seconds after a change (0 disables) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	float IdleSeconds;
+
+	/** Maximum number of full snapshots to keep */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	int32 MaxFullSnapshots;
+
+	/** Maximum number of versions that can be rebuilt from inverse deltas */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+	int32 MaxDeltaVersions;
+
+	FJsonCRDTSnapshotPolicy()
+		: IntervalSeconds(60.0f)
+		, OperationsPerSnapshot(1000)
+		, IdleSeconds(5.0f)
+		, MaxFullSnapshots(2)
+		, MaxDeltaVersions(1024)
+	{
+	}
+};
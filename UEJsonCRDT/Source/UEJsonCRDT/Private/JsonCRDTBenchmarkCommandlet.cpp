@@ -0,0 +1,439 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "JsonCRDTBenchmarkCommandlet.h"
+#include "JsonCRDTDocument.h"
+#include "JsonCRDTTransport.h"
+#include "JsonCRDTBinaryCodec.h"
+#include "JsonCRDTDefaultLogger.h"
+#include "JsonCRDTLocalStorageWriter.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+namespace JsonCRDTBenchmarkCommandlet
+{
+	/** 벤치마크 문서 ID 접두사 (로컬 저장 파일이 이 폴더 아래에 생기고 끝나면 지워짐) */
+	static const TCHAR* DocumentPrefix = TEXT("JsonCRDTBenchmark/");
+
+	/** 원격 패치의 클라이언트 ID */
+	static const TCHAR* RemoteClientID = TEXT("benchmark-remote");
+
+	/** 난수 시드 (실행마다 같은 패치를 만들어 결과를 비교할 수 있게) */
+	static constexpr int32 RandomSeed = 0x4A435244;
+
+	/** 쉼표로 구분된 정수 목록 옵션 읽기 */
+	static TArray<int32> ParseIntList(const FString& Params, const TCHAR* Key, const TArray<int32>& Default)
+	{
+		FString Value;
+		if (!FParse::Value(*Params, Key, Value, false))
+		{
+			return Default;
+		}
+
+		TArray<FString> Items;
+		Value.ParseIntoArray(Items, TEXT(","), true);
+
+		TArray<int32> Result;
+		for (const FString& Item : Items)
+		{
+			int32 Number;
+			if (LexTryParseString(Number, *Item.TrimStartAndEnd()) && Number >= 0)
+			{
+				Result.Add(Number);
+			}
+		}
+		return Result.Num() > 0 ? Result : Default;
+	}
+
+	/** 키 NumKeys개짜리 평평한 객체 ({"k0":0,"k1":1,...}) */
+	static FString MakeContent(int32 NumKeys)
+	{
+		FString Content;
+		Content.Reserve(NumKeys * 14 + 2);
+		Content += TEXT("{");
+		for (int32 i = 0; i < NumKeys; ++i)
+		{
+			Content += FString::Printf(i > 0 ? TEXT(",\"k%d\":%d") : TEXT("\"k%d\":%d"), i, i);
+		}
+		Content += TEXT("}");
+		return Content;
+	}
+
+	/** 임의의 키에 대한 스칼라 Replace 패치 생성 */
+	static void MakeReplacePatches(const FString& DocumentID, int32 NumKeys, int32 NumPatches, int32 OpsPerPatch, int64 FirstSequence, FRandomStream& Random, TArray<FJsonCRDTPatch>& OutPatches)
+	{
+		const int64 StartTicks = FDateTime::UtcNow().GetTicks();
+		OutPatches.Reset(NumPatches);
+		for (int32 PatchIndex = 0; PatchIndex < NumPatches; ++PatchIndex)
+		{
+			FJsonCRDTPatch& Patch = OutPatches.AddDefaulted_GetRef();
+			Patch.DocumentID = DocumentID;
+			Patch.ClientID = RemoteClientID;
+			Patch.Sequence = FirstSequence + PatchIndex;
+			Patch.Timestamp = FDateTime(StartTicks + PatchIndex);
+			Patch.Operations.Reserve(OpsPerPatch);
+			for (int32 OperationIndex = 0; OperationIndex < OpsPerPatch; ++OperationIndex)
+			{
+				FJsonCRDTOperation& Operation = Patch.Operations.AddDefaulted_GetRef();
+				Operation.Type = EJsonCRDTOperationType::Replace;
+				Operation.Path = FString::Printf(TEXT("/k%d"), Random.RandRange(0, NumKeys - 1));
+				Operation.Value = FString::FromInt(Random.RandRange(0, 1000000));
+				Operation.Timestamp = Patch.Timestamp;
+				Operation.ClientID = Patch.ClientID;
+			}
+		}
+	}
+
+	/** 로거 없이 내용을 채운 문서 생성 (로그 기록 비용은 측정에서 제외) */
+	static UJsonCRDTDocument* CreateDocument(const FString& DocumentID, const FString& Content)
+	{
+		UJsonCRDTDocument* Document = NewObject<UJsonCRDTDocument>(GetTransientPackage());
+		Document->Initialize(DocumentID, nullptr);
+		Document->SetLoggingEnabled(false);
+		Document->SetContentFromString(Content);
+		return Document;
+	}
+
+	/** 로그 항목의 작업 유형 이름 해석 */
+	static bool ParseOperationType(const FString& Name, EJsonCRDTOperationType& OutType)
+	{
+		static const TPair<const TCHAR*, EJsonCRDTOperationType> Types[] =
+		{
+			{ TEXT("Add"), EJsonCRDTOperationType::Add },
+			{ TEXT("Remove"), EJsonCRDTOperationType::Remove },
+			{ TEXT("Replace"), EJsonCRDTOperationType::Replace },
+			{ TEXT("Move"), EJsonCRDTOperationType::Move },
+			{ TEXT("Copy"), EJsonCRDTOperationType::Copy },
+			{ TEXT("Test"), EJsonCRDTOperationType::Test }
+		};
+
+		for (const TPair<const TCHAR*, EJsonCRDTOperationType>& Type : Types)
+		{
+			if (Name.Equals(Type.Key, ESearchCase::IgnoreCase))
+			{
+				OutType = Type.Value;
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+UJsonCRDTBenchmarkCommandlet::UJsonCRDTBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UJsonCRDTBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace JsonCRDTBenchmarkCommandlet;
+
+	// 세션 리플레이는 벤치마크와 따로 수행
+	FString ReplayFile;
+	if (FParse::Value(*Params, TEXT("Replay="), ReplayFile))
+	{
+		FString ReplayDocumentID;
+		FString ContentFile;
+		FParse::Value(*Params, TEXT("ReplayDocument="), ReplayDocumentID);
+		FParse::Value(*Params, TEXT("ReplayContent="), ContentFile);
+		return RunReplay(ReplayFile, ReplayDocumentID, ContentFile);
+	}
+
+	const TArray<int32> Sizes = ParseIntList(Params, TEXT("Sizes="), { 100, 1000, 10000 });
+	const TArray<int32> Histories = ParseIntList(Params, TEXT("Histories="), { 0, 4096, 65536 });
+	const TArray<int32> OpsPerPatch = ParseIntList(Params, TEXT("OpsPerPatch="), { 1, 16, 256 });
+	int32 NumPatches = 2000;
+	int32 NumLookups = 10000;
+	FParse::Value(*Params, TEXT("Patches="), NumPatches);
+	FParse::Value(*Params, TEXT("Lookups="), NumLookups);
+	NumPatches = FMath::Max(NumPatches, 1);
+	NumLookups = FMath::Max(NumLookups, 1);
+
+	for (const int32 Size : Sizes)
+	{
+		const int32 DocumentSize = FMath::Max(Size, 1);
+		for (const int32 HistoryLength : Histories)
+		{
+			RunApplyPatch(DocumentSize, HistoryLength, NumPatches);
+		}
+		RunGetValueAtPath(DocumentSize, NumLookups);
+		RunLocalStorage(DocumentSize);
+	}
+
+	for (const int32 Ops : OpsPerPatch)
+	{
+		RunEncode(FMath::Max(Ops, 1), NumPatches);
+	}
+
+	// 로컬 저장 측정에서 만든 파일 정리
+	FJsonCRDTLocalStorageWriter::Get().Flush();
+	IFileManager::Get().DeleteDirectory(*(FPaths::ProjectSavedDir() / TEXT("JsonCRDT") / DocumentPrefix), false, true);
+
+	FString CsvFile;
+	if (FParse::Value(*Params, TEXT("Csv="), CsvFile) && !WriteCsv(CsvFile))
+	{
+		return 1;
+	}
+	return 0;
+}
+
+void UJsonCRDTBenchmarkCommandlet::AddResult(const FString& Name, int32 DocumentSize, int32 HistoryLength, int32 Count, double Seconds)
+{
+	FResult& Result = Results.AddDefaulted_GetRef();
+	Result.Name = Name;
+	Result.DocumentSize = DocumentSize;
+	Result.HistoryLength = HistoryLength;
+	Result.Count = Count;
+	Result.Seconds = Seconds;
+
+	UE_LOG(LogTemp, Display, TEXT("%-24s size %7d history %7d: %8d in %9.3f ms (%9.3f us each, %12.0f/s)"),
+		*Name, DocumentSize, HistoryLength, Count, Seconds * 1000.0,
+		Count > 0 ? Seconds * 1000000.0 / Count : 0.0,
+		Seconds > 0.0 ? Count / Seconds : 0.0);
+}
+
+void UJsonCRDTBenchmarkCommandlet::RunApplyPatch(int32 DocumentSize, int32 HistoryLength, int32 NumPatches)
+{
+	using namespace JsonCRDTBenchmarkCommandlet;
+
+	const FString DocumentID = FString(DocumentPrefix) + TEXT("apply");
+	UJsonCRDTDocument* Document = CreateDocument(DocumentID, MakeContent(DocumentSize));
+	Document->SetMaxOperationHistory(FMath::Max(HistoryLength, 1));
+
+	// 측정 전에 히스토리를 채워 둠 (충돌 검사가 긴 히스토리에서 조회하도록)
+	FRandomStream Random(RandomSeed);
+	TArray<FJsonCRDTPatch> Patches;
+	if (HistoryLength > 0)
+	{
+		MakeReplacePatches(DocumentID, DocumentSize, HistoryLength, 1, 1, Random, Patches);
+		for (FJsonCRDTPatch& Patch : Patches)
+		{
+			Document->ApplyPatch(MoveTemp(Patch));
+		}
+	}
+
+	MakeReplacePatches(DocumentID, DocumentSize, NumPatches, 1, HistoryLength + 1, Random, Patches);
+
+	int32 NumFailed = 0;
+	const double StartTime = FPlatformTime::Seconds();
+	for (FJsonCRDTPatch& Patch : Patches)
+	{
+		if (!Document->ApplyPatch(MoveTemp(Patch)))
+		{
+			++NumFailed;
+		}
+	}
+	AddResult(TEXT("ApplyPatch"), DocumentSize, HistoryLength, NumPatches, FPlatformTime::Seconds() - StartTime);
+
+	if (NumFailed > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%d of %d benchmark patches failed to apply"), NumFailed, NumPatches);
+	}
+}
+
+void UJsonCRDTBenchmarkCommandlet::RunGetValueAtPath(int32 DocumentSize, int32 NumLookups)
+{
+	using namespace JsonCRDTBenchmarkCommandlet;
+
+	UJsonCRDTDocument* Document = CreateDocument(FString(DocumentPrefix) + TEXT("lookup"), MakeContent(DocumentSize));
+
+	FRandomStream Random(RandomSeed);
+	TArray<FString> Paths;
+	Paths.Reserve(NumLookups);
+	for (int32 i = 0; i < NumLookups; ++i)
+	{
+		Paths.Add(FString::Printf(TEXT("/k%d"), Random.RandRange(0, DocumentSize - 1)));
+	}
+
+	// 값 길이를 쌓아 조회가 최적화로 사라지지 않게 함
+	int64 TotalLength = 0;
+	FString Value;
+	const double StartTime = FPlatformTime::Seconds();
+	for (const FString& Path : Paths)
+	{
+		if (Document->GetValueAtPath(Path, Value))
+		{
+			TotalLength += Value.Len();
+		}
+	}
+	AddResult(TEXT("GetValueAtPath"), DocumentSize, 0, NumLookups, FPlatformTime::Seconds() - StartTime);
+	UE_LOG(LogTemp, Verbose, TEXT("Read %lld characters"), TotalLength);
+}
+
+void UJsonCRDTBenchmarkCommandlet::RunLocalStorage(int32 DocumentSize)
+{
+	using namespace JsonCRDTBenchmarkCommandlet;
+
+	const FString DocumentID = FString::Printf(TEXT("%sstorage-%d"), DocumentPrefix, DocumentSize);
+	UJsonCRDTDocument* Document = CreateDocument(DocumentID, MakeContent(DocumentSize));
+
+	const TPair<EJsonCRDTLocalStorageFormat, const TCHAR*> Formats[] =
+	{
+		{ EJsonCRDTLocalStorageFormat::Json, TEXT("Json") },
+		{ EJsonCRDTLocalStorageFormat::Binary, TEXT("Binary") }
+	};
+
+	for (const TPair<EJsonCRDTLocalStorageFormat, const TCHAR*>& Format : Formats)
+	{
+		// 파일 쓰기는 백그라운드 작성기가 하므로 디스크에 닿을 때까지 포함해 측정
+		Document->SetLocalStorageFormat(Format.Key);
+		double StartTime = FPlatformTime::Seconds();
+		const bool bSaved = Document->SaveLocally();
+		FJsonCRDTLocalStorageWriter::Get().Flush();
+		AddResult(FString::Printf(TEXT("SaveLocally(%s)"), Format.Value), DocumentSize, 0, 1, FPlatformTime::Seconds() - StartTime);
+
+		if (!bSaved)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to save benchmark document %s"), *DocumentID);
+			continue;
+		}
+
+		// 바이너리 파일은 매핑만 하므로 첫 전체 읽기도 따로 측정
+		UJsonCRDTDocument* Loaded = NewObject<UJsonCRDTDocument>(GetTransientPackage());
+		Loaded->Initialize(DocumentID, nullptr);
+		Loaded->SetLocalStorageFormat(Format.Key);
+		StartTime = FPlatformTime::Seconds();
+		const bool bLoaded = Loaded->LoadFromLocal();
+		AddResult(FString::Printf(TEXT("LoadFromLocal(%s)"), Format.Value), DocumentSize, 0, 1, FPlatformTime::Seconds() - StartTime);
+
+		if (!bLoaded)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to load benchmark document %s"), *DocumentID);
+			continue;
+		}
+
+		StartTime = FPlatformTime::Seconds();
+		const FString Content = Loaded->GetContentAsString();
+		AddResult(FString::Printf(TEXT("FirstRead(%s)"), Format.Value), DocumentSize, 0, 1, FPlatformTime::Seconds() - StartTime);
+	}
+}
+
+void UJsonCRDTBenchmarkCommandlet::RunEncode(int32 OpsPerPatch, int32 NumPatches)
+{
+	using namespace JsonCRDTBenchmarkCommandlet;
+
+	FRandomStream Random(RandomSeed);
+	TArray<FJsonCRDTPatch> Patches;
+	MakeReplacePatches(FString(DocumentPrefix) + TEXT("encode"), 1000, NumPatches, OpsPerPatch, 1, Random, Patches);
+
+	// 바이너리 프레임 (연결마다 사전이 새로 시작하므로 처음 한 번만 초기화)
+	FJsonCRDTBinaryCodec Codec;
+	TArray<uint8> Frame;
+	int64 BinaryBytes = 0;
+	double StartTime = FPlatformTime::Seconds();
+	for (const FJsonCRDTPatch& Patch : Patches)
+	{
+		Codec.EncodePatch(Patch, Frame);
+		BinaryBytes += Frame.Num();
+	}
+	AddResult(FString::Printf(TEXT("EncodeBinary(%d ops)"), OpsPerPatch), 0, 0, NumPatches, FPlatformTime::Seconds() - StartTime);
+
+	// 이전 서버용 JSON 메시지 (연결하지 않은 전송 계층의 메시지 생성만 사용)
+	FDefaultJsonCRDTTransport Transport(TEXT("http://jsoncrdt-benchmark.invalid"), TEXT("ws://jsoncrdt-benchmark.invalid"));
+	int64 JsonBytes = 0;
+	StartTime = FPlatformTime::Seconds();
+	for (const FJsonCRDTPatch& Patch : Patches)
+	{
+		const FString Message = Transport.BuildPatchMessage(Patch);
+		JsonBytes += FPlatformString::ConvertedLength<UTF8CHAR>(*Message, Message.Len());
+	}
+	AddResult(FString::Printf(TEXT("EncodeJson(%d ops)"), OpsPerPatch), 0, 0, NumPatches, FPlatformTime::Seconds() - StartTime);
+
+	UE_LOG(LogTemp, Display, TEXT("Encoded size with %d ops per patch: binary %.1f bytes, JSON %.1f bytes per patch"),
+		OpsPerPatch, static_cast<double>(BinaryBytes) / NumPatches, static_cast<double>(JsonBytes) / NumPatches);
+}
+
+int32 UJsonCRDTBenchmarkCommandlet::RunReplay(const FString& FilePath, const FString& ReplayDocumentID, const FString& ContentFile)
+{
+	using namespace JsonCRDTBenchmarkCommandlet;
+
+	TArray<FJsonCRDTLogEntry> LogEntries;
+	if (!FJsonCRDTDefaultLogger().LoadExportedLogs(FilePath, LogEntries))
+	{
+		return 1;
+	}
+
+	FString DocumentID = ReplayDocumentID;
+	if (DocumentID.IsEmpty() && LogEntries.Num() > 0)
+	{
+		DocumentID = LogEntries[0].DocumentID;
+	}
+
+	FString Content = TEXT("{}");
+	if (!ContentFile.IsEmpty() && !FFileHelper::LoadFileToString(Content, *ContentFile))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to load replay content: %s"), *ContentFile);
+		return 1;
+	}
+
+	// 로그에는 FromPath가 없으므로 Move와 Copy는 다시 적용할 수 없음
+	TArray<FJsonCRDTPatch> Patches;
+	int32 NumSkipped = 0;
+	for (const FJsonCRDTLogEntry& LogEntry : LogEntries)
+	{
+		EJsonCRDTOperationType Type;
+		if (LogEntry.DocumentID != DocumentID)
+		{
+			continue;
+		}
+		if (!ParseOperationType(LogEntry.OperationType, Type) || Type == EJsonCRDTOperationType::Move || Type == EJsonCRDTOperationType::Copy)
+		{
+			++NumSkipped;
+			continue;
+		}
+
+		FJsonCRDTPatch& Patch = Patches.AddDefaulted_GetRef();
+		Patch.DocumentID = DocumentID;
+		Patch.ClientID = LogEntry.ClientID;
+		Patch.Timestamp = LogEntry.Timestamp;
+
+		FJsonCRDTOperation& Operation = Patch.Operations.AddDefaulted_GetRef();
+		Operation.Type = Type;
+		Operation.Path = LogEntry.Path;
+		Operation.Value = Type != EJsonCRDTOperationType::Remove ? LogEntry.NewValue : FString();
+		Operation.Timestamp = LogEntry.Timestamp;
+		Operation.ClientID = LogEntry.ClientID;
+	}
+
+	UJsonCRDTDocument* Document = CreateDocument(DocumentID, Content);
+	const int32 NumOperations = Patches.Num();
+	int32 NumFailed = 0;
+	const double StartTime = FPlatformTime::Seconds();
+	for (FJsonCRDTPatch& Patch : Patches)
+	{
+		if (!Document->ApplyPatch(MoveTemp(Patch)))
+		{
+			++NumFailed;
+		}
+	}
+	AddResult(TEXT("Replay"), 0, 0, NumOperations, FPlatformTime::Seconds() - StartTime);
+
+	UE_LOG(LogTemp, Display, TEXT("Replayed %d operations on %s (%d failed, %d skipped), final version %lld"),
+		NumOperations, *DocumentID, NumFailed, NumSkipped, Document->GetVersion());
+	return 0;
+}
+
+bool UJsonCRDTBenchmarkCommandlet::WriteCsv(const FString& FilePath) const
+{
+	FString Csv = TEXT("Name,DocumentSize,HistoryLength,Count,Seconds,MicrosecondsEach,PerSecond\n");
+	for (const FResult& Result : Results)
+	{
+		Csv += FString::Printf(TEXT("%s,%d,%d,%d,%.6f,%.3f,%.0f\n"),
+			*Result.Name, Result.DocumentSize, Result.HistoryLength, Result.Count, Result.Seconds,
+			Result.Count > 0 ? Result.Seconds * 1000000.0 / Result.Count : 0.0,
+			Result.Seconds > 0.0 ? Result.Count / Result.Seconds : 0.0);
+	}
+
+	if (!FFileHelper::SaveStringToFile(Csv, *FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to write benchmark results: %s"), *FilePath);
+		return false;
+	}
+	return true;
+}
@@ -4,6 +4,7 @@
 #include "JsonCRDTDocument.h"
 #include "JsonCRDTSyncManager.h"
 #include "JsonCRDTTransport.h"
+#include "JsonCRDTPath.h"
 #include "JsonObjectConverter.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
@@ -92,378 +93,144 @@ bool UJsonCRDTBlueprintLibrary::GetJsonValueByPath(const TSharedPtr<FJsonObject>
 		return false;
 	}
 
-	// Split the path into segments
-	TArray<FString> PathSegments;
-	Path.ParseIntoArray(PathSegments, TEXT("/"), true);
-
-	// Remove empty segments
-	for (int32 i = PathSegments.Num() - 1; i >= 0; --i)
-	{
-		if (PathSegments[i].IsEmpty())
-		{
-			PathSegments.RemoveAt(i);
-		}
-	}
-
-	if (PathSegments.Num() == 0)
+	TSharedRef<const FJsonCRDTPath, ESPMode::ThreadSafe> ParsedPath = FJsonCRDTPathCache::GetShared().Get(Path);
+	if (ParsedPath->IsRoot())
 	{
 		// Return the entire object as a string
 		return JsonObjectToString(JsonObject, OutValue);
 	}
 
 	// Navigate through the path
-	TSharedPtr<FJsonObject> CurrentObject = JsonObject;
-	for (int32 i = 0; i < PathSegments.Num() - 1; ++i)
+	TSharedPtr<FJsonValue> JsonValue = ParsedPath->Resolve(JsonObject);
+	if (!JsonValue.IsValid())
 	{
-		const FString& Segment = PathSegments[i];
-
-		// Check if the segment is an array index
-		int32 ArrayIndex = -1;
-		if (Segment.IsNumeric() && Segment.IsNumeric())
-		{
-			ArrayIndex = FCString::Atoi(*Segment);
-		}
-
-		if (ArrayIndex >= 0)
-		{
-			// Get the array
-			const TArray<TSharedPtr<FJsonValue>>* JsonArray;
-			if (!CurrentObject->TryGetArrayField(Segment, JsonArray))
-			{
-				return false;
-			}
-
-			// Check if the index is valid
-			if (ArrayIndex >= JsonArray->Num())
-			{
-				return false;
-			}
-
-			// Get the object at the index
-			const TSharedPtr<FJsonValue>& JsonValue = (*JsonArray)[ArrayIndex];
-			if (JsonValue->Type != EJson::Object)
-			{
-				return false;
-			}
-
-			CurrentObject = JsonValue->AsObject();
-		}
-		else
-		{
-			// Get the object field
-			const TSharedPtr<FJsonObject>* NextObject;
-			if (!CurrentObject->TryGetObjectField(Segment, NextObject))
-			{
-				return false;
-			}
-
-			CurrentObject = *NextObject;
-		}
+		return false;
 	}
 
-	// Get the value at the final segment
-	const FString& FinalSegment = PathSegments.Last();
-
-	// Check if the final segment is an array index
-	int32 ArrayIndex = -1;
-	if (FinalSegment.IsNumeric())
+	// Convert the value to a string
+	if (JsonValue->Type == EJson::String)
 	{
-		ArrayIndex = FCString::Atoi(*FinalSegment);
+		OutValue = JsonValue->AsString();
 	}
-
-	if (ArrayIndex >= 0)
+	else if (JsonValue->Type == EJson::Number)
 	{
-		// Get the array
-		const TArray<TSharedPtr<FJsonValue>>* JsonArray;
-		if (!CurrentObject->TryGetArrayField(FinalSegment, JsonArray))
-		{
-			return false;
-		}
-
-		// Check if the index is valid
-		if (ArrayIndex >= JsonArray->Num())
-		{
-			return false;
-		}
+		OutValue = FString::Printf(TEXT("%f"), JsonValue->AsNumber());
+	}
+	else if (JsonValue->Type == EJson::Boolean)
+	{
+		OutValue = JsonValue->AsBool() ? TEXT("true") : TEXT("false");
+	}
+	else if (JsonValue->Type == EJson::Null)
+	{
+		OutValue = TEXT("null");
+	}
+	else
+	{
+		// Convert the value to a JSON string
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutValue);
+		FJsonSerializer::Serialize(JsonValue, FString(), Writer);
+	}
 
-		// Get the value at the index
-		const TSharedPtr<FJsonValue>& JsonValue = (*JsonArray)[ArrayIndex];
+	return true;
+}
 
-		// Convert the value to a string
-		if (JsonValue->Type == EJson::String)
-		{
-			OutValue = JsonValue->AsString();
-		}
-		else if (JsonValue->Type == EJson::Number)
-		{
-			OutValue = FString::Printf(TEXT("%f"), JsonValue->AsNumber());
-		}
-		else if (JsonValue->Type == EJson::Boolean)
-		{
-			OutValue = JsonValue->AsBool() ? TEXT("true") : TEXT("false");
-		}
-		else if (JsonValue->Type == EJson::Null)
+namespace JsonCRDTBlueprintLibrary
+{
+	/** 빈 컨테이너 생성 (자식을 가리키는 세그먼트가 배열 인덱스면 배열, 아니면 객체) */
+	static TSharedPtr<FJsonValue> MakeContainer(const FJsonCRDTPath& Path, int32 ChildTokenIndex)
+	{
+		if (Path.GetArrayIndex(ChildTokenIndex) != INDEX_NONE)
 		{
-			OutValue = TEXT("null");
+			return MakeShared<FJsonValueArray>(TArray<TSharedPtr<FJsonValue>>());
 		}
-		else
+		return MakeShared<FJsonValueObject>(MakeShared<FJsonObject>());
+	}
+
+	/**
+	 * 컨테이너 아래 경로에 값 설정 (중간에 없는 컨테이너는 생성)
+	 * 객체는 제자리에서 바꾸고, 배열은 공개 API가 읽기 전용이므로 바꾼 복사본으로 새 배열 값을 만듦.
+	 * 실패하면 아무것도 바꾸지 않음.
+	 * @param Container 객체 또는 배열 값 (그 밖의 값이나 빈 값이면 새 컨테이너로 대체)
+	 * @param Path 경로
+	 * @param TokenIndex Container의 자식을 가리키는 세그먼트 인덱스
+	 * @param NewValue 마지막 세그먼트에 설정할 값
+	 * @return 설정을 반영한 컨테이너 (배열 인덱스가 잘못되었거나 배열 크기보다 크면 nullptr)
+	 */
+	static TSharedPtr<FJsonValue> SetInContainer(TSharedPtr<FJsonValue> Container, const FJsonCRDTPath& Path, int32 TokenIndex, const TSharedPtr<FJsonValue>& NewValue)
+	{
+		if (!Container.IsValid() || (Container->Type != EJson::Object && Container->Type != EJson::Array))
 		{
-			// Convert the value to a JSON string
-			TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutValue);
-			FJsonSerializer::Serialize(JsonValue, Writer);
+			Container = MakeContainer(Path, TokenIndex);
 		}
+		const bool bLastToken = TokenIndex == Path.Num() - 1;
 
-		return true;
-	}
-	else
-	{
-		// Get the field value
-		const TSharedPtr<FJsonValue>* JsonValue;
-		if (!CurrentObject->TryGetField(FinalSegment, JsonValue))
+		if (Container->Type == EJson::Object)
 		{
-			return false;
+			const TSharedPtr<FJsonObject> Object = Container->AsObject();
+			const FString& Key = Path.GetToken(TokenIndex);
+			const TSharedPtr<FJsonValue>* Existing = Object->Values.Find(Key);
+			TSharedPtr<FJsonValue> Child = bLastToken ? NewValue : SetInContainer(Existing ? *Existing : nullptr, Path, TokenIndex + 1, NewValue);
+			if (!Child.IsValid())
+			{
+				return nullptr;
+			}
+			Object->Values.Add(Key, MoveTemp(Child));
+			return Container;
 		}
 
-		// Convert the value to a string
-		if ((*JsonValue)->Type == EJson::String)
+		// RFC 6902 add와 같이 배열 끝 바로 뒤("-" 포함)까지만 허용하고 그 너머를 채우지 않음
+		TArray<TSharedPtr<FJsonValue>> Array = Container->AsArray();
+		int32 Index = Path.GetArrayIndex(TokenIndex);
+		if (Index == FJsonCRDTPath::AppendIndex)
 		{
-			OutValue = (*JsonValue)->AsString();
+			Index = Array.Num();
 		}
-		else if ((*JsonValue)->Type == EJson::Number)
+		if (Index == INDEX_NONE || Index > Array.Num())
 		{
-			OutValue = FString::Printf(TEXT("%f"), (*JsonValue)->AsNumber());
+			return nullptr;
 		}
-		else if ((*JsonValue)->Type == EJson::Boolean)
+
+		TSharedPtr<FJsonValue> Child = bLastToken ? NewValue : SetInContainer(Index < Array.Num() ? Array[Index] : nullptr, Path, TokenIndex + 1, NewValue);
+		if (!Child.IsValid())
 		{
-			OutValue = (*JsonValue)->AsBool() ? TEXT("true") : TEXT("false");
+			return nullptr;
 		}
-		else if ((*JsonValue)->Type == EJson::Null)
+		if (Index == Array.Num())
 		{
-			OutValue = TEXT("null");
+			Array.Add(MoveTemp(Child));
 		}
 		else
 		{
-			// Convert the value to a JSON string
-			TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutValue);
-			FJsonSerializer::Serialize(*JsonValue, Writer);
+			Array[Index] = MoveTemp(Child);
 		}
-
-		return true;
+		return MakeShared<FJsonValueArray>(Array);
 	}
 }
 
 bool UJsonCRDTBlueprintLibrary::SetJsonValueByPath(TSharedPtr<FJsonObject>& JsonObject, const FString& Path, const FString& Value)
 {
+	using namespace JsonCRDTBlueprintLibrary;
+
 	if (!JsonObject.IsValid())
 	{
 		return false;
 	}
 
-	// Split the path into segments
-	TArray<FString> PathSegments;
-	Path.ParseIntoArray(PathSegments, TEXT("/"), true);
-
-	// Remove empty segments
-	for (int32 i = PathSegments.Num() - 1; i >= 0; --i)
-	{
-		if (PathSegments[i].IsEmpty())
-		{
-			PathSegments.RemoveAt(i);
-		}
-	}
-
-	if (PathSegments.Num() == 0)
+	TSharedRef<const FJsonCRDTPath, ESPMode::ThreadSafe> ParsedPath = FJsonCRDTPathCache::GetShared().Get(Path);
+	if (ParsedPath->IsRoot())
 	{
 		// Cannot set the entire object
 		return false;
 	}
 
-	// Parse the value as JSON
+	// Parse the value as JSON (treat the value as a string if parsing fails)
 	TSharedPtr<FJsonValue> JsonValue;
 	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Value);
-	if (FJsonSerializer::Deserialize(Reader, JsonValue))
+	if (!FJsonSerializer::Deserialize(Reader, JsonValue) || !JsonValue.IsValid())
 	{
-		// Navigate through the path
-		TSharedPtr<FJsonObject> CurrentObject = JsonObject;
-		for (int32 i = 0; i < PathSegments.Num() - 1; ++i)
-		{
-			const FString& Segment = PathSegments[i];
-
-			// Check if the segment is an array index
-			int32 ArrayIndex = -1;
-			if (Segment.IsNumeric())
-			{
-				ArrayIndex = FCString::Atoi(*Segment);
-			}
-
-			if (ArrayIndex >= 0)
-			{
-				// Get the array
-				TArray<TSharedPtr<FJsonValue>>* JsonArray;
-				if (!CurrentObject->TryGetArrayField(Segment, JsonArray))
-				{
-					// Create the array if it doesn't exist
-					JsonArray = &CurrentObject->SetArrayField(Segment);
-				}
-
-				// Ensure the array is large enough
-				while (JsonArray->Num() <= ArrayIndex)
-				{
-					JsonArray->Add(MakeShared<FJsonValueObject>(MakeShared<FJsonObject>()));
-				}
-
-				// Get the object at the index
-				TSharedPtr<FJsonValue>& ArrayValue = (*JsonArray)[ArrayIndex];
-				if (ArrayValue->Type != EJson::Object)
-				{
-					// Replace with an object
-					ArrayValue = MakeShared<FJsonValueObject>(MakeShared<FJsonObject>());
-				}
-
-				CurrentObject = ArrayValue->AsObject();
-			}
-			else
-			{
-				// Get the object field
-				TSharedPtr<FJsonObject>* NextObject;
-				if (!CurrentObject->TryGetObjectField(Segment, NextObject))
-				{
-					// Create the object if it doesn't exist
-					NextObject = &CurrentObject->SetObjectField(Segment, MakeShared<FJsonObject>());
-				}
-
-				CurrentObject = *NextObject;
-			}
-		}
-
-		// Set the value at the final segment
-		const FString& FinalSegment = PathSegments.Last();
-
-		// Check if the final segment is an array index
-		int32 ArrayIndex = -1;
-		if (FinalSegment.IsNumeric())
-		{
-			ArrayIndex = FCString::Atoi(*FinalSegment);
-		}
-
-		if (ArrayIndex >= 0)
-		{
-			// Get the array
-			TArray<TSharedPtr<FJsonValue>>* JsonArray;
-			if (!CurrentObject->TryGetArrayField(FinalSegment, JsonArray))
-			{
-				// Create the array if it doesn't exist
-				JsonArray = &CurrentObject->SetArrayField(FinalSegment);
-			}
-
-			// Ensure the array is large enough
-			while (JsonArray->Num() <= ArrayIndex)
-			{
-				JsonArray->Add(MakeShared<FJsonValueNull>());
-			}
-
-			// Set the value at the index
-			(*JsonArray)[ArrayIndex] = JsonValue;
-		}
-		else
-		{
-			// Set the field value
-			CurrentObject->SetField(FinalSegment, JsonValue);
-		}
-
-		return true;
+		JsonValue = MakeShared<FJsonValueString>(Value);
 	}
-	else
-	{
-		// Treat the value as a string
-		// Navigate through the path
-		TSharedPtr<FJsonObject> CurrentObject = JsonObject;
-		for (int32 i = 0; i < PathSegments.Num() - 1; ++i)
-		{
-			const FString& Segment = PathSegments[i];
-
-			// Check if the segment is an array index
-			int32 ArrayIndex = -1;
-			if (Segment.IsNumeric())
-			{
-				ArrayIndex = FCString::Atoi(*Segment);
-			}
-
-			if (ArrayIndex >= 0)
-			{
-				// Get the array
-				TArray<TSharedPtr<FJsonValue>>* JsonArray;
-				if (!CurrentObject->TryGetArrayField(Segment, JsonArray))
-				{
-					// Create the array if it doesn't exist
-					JsonArray = &CurrentObject->SetArrayField(Segment);
-				}
-
-				// Ensure the array is large enough
-				while (JsonArray->Num() <= ArrayIndex)
-				{
-					JsonArray->Add(MakeShared<FJsonValueObject>(MakeShared<FJsonObject>()));
-				}
-
-				// Get the object at the index
-				TSharedPtr<FJsonValue>& ArrayValue = (*JsonArray)[ArrayIndex];
-				if (ArrayValue->Type != EJson::Object)
-				{
-					// Replace with an object
-					ArrayValue = MakeShared<FJsonValueObject>(MakeShared<FJsonObject>());
-				}
-
-				CurrentObject = ArrayValue->AsObject();
-			}
-			else
-			{
-				// Get the object field
-				TSharedPtr<FJsonObject>* NextObject;
-				if (!CurrentObject->TryGetObjectField(Segment, NextObject))
-				{
-					// Create the object if it doesn't exist
-					NextObject = &CurrentObject->SetObjectField(Segment, MakeShared<FJsonObject>());
-				}
-
-				CurrentObject = *NextObject;
-			}
-		}
-
-		// Set the value at the final segment
-		const FString& FinalSegment = PathSegments.Last();
 
-		// Check if the final segment is an array index
-		int32 ArrayIndex = -1;
-		if (FinalSegment.IsNumeric())
-		{
-			ArrayIndex = FCString::Atoi(*FinalSegment);
-		}
-
-		if (ArrayIndex >= 0)
-		{
-			// Get the array
-			TArray<TSharedPtr<FJsonValue>>* JsonArray;
-			if (!CurrentObject->TryGetArrayField(FinalSegment, JsonArray))
-			{
-				// Create the array if it doesn't exist
-				JsonArray = &CurrentObject->SetArrayField(FinalSegment);
-			}
-
-			// Ensure the array is large enough
-			while (JsonArray->Num() <= ArrayIndex)
-			{
-				JsonArray->Add(MakeShared<FJsonValueNull>());
-			}
-
-			// Set the value at the index
-			(*JsonArray)[ArrayIndex] = MakeShared<FJsonValueString>(Value);
-		}
-		else
-		{
-			// Set the field value
-			CurrentObject->SetStringField(FinalSegment, Value);
-		}
-
-		return true;
-	}
+	// Navigate through the path, creating missing containers (the root object is updated in place)
+	return SetInContainer(MakeShared<FJsonValueObject>(JsonObject), *ParsedPath, 0, JsonValue).IsValid();
 }
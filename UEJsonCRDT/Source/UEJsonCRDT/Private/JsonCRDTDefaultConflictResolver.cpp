@@ -31,6 +31,48 @@ bool FJsonCRDTDefaultConflictResolver::ResolveConflict(FJsonCRDTConflict& Confli
     }
 }
 
+int32 FJsonCRDTDefaultConflictResolver::ResolveConflicts(TArrayView<FJsonCRDTConflict> Conflicts)
+{
+    switch (Strategy)
+    {
+        case EJsonCRDTConflictStrategy::LastWriterWins:
+            for (FJsonCRDTConflict& Conflict : Conflicts)
+            {
+                ResolveLastWriterWins(Conflict);
+            }
+            return Conflicts.Num();
+        
+        case EJsonCRDTConflictStrategy::LocalWins:
+            for (FJsonCRDTConflict& Conflict : Conflicts)
+            {
+                ResolveLocalWins(Conflict);
+            }
+            return Conflicts.Num();
+        
+        case EJsonCRDTConflictStrategy::RemoteWins:
+            for (FJsonCRDTConflict& Conflict : Conflicts)
+            {
+                ResolveRemoteWins(Conflict);
+            }
+            return Conflicts.Num();
+        
+        case EJsonCRDTConflictStrategy::Custom:
+            // 충돌마다 경고하지 않고 한 번만 알림
+            UE_LOG(LogTemp, Warning, TEXT("Custom conflict resolution strategy not implemented in default resolver, %d conflicts left unresolved"), Conflicts.Num());
+            break;
+        
+        default:
+            UE_LOG(LogTemp, Error, TEXT("Unknown conflict resolution strategy"));
+            break;
+    }
+
+    for (FJsonCRDTConflict& Conflict : Conflicts)
+    {
+        Conflict.bResolved = false;
+    }
+    return 0;
+}
+
 EJsonCRDTConflictStrategy FJsonCRDTDefaultConflictResolver::GetStrategy() const
 {
     return Strategy;
@@ -44,7 +86,7 @@ void FJsonCRDTDefaultConflictResolver::SetStrategy(EJsonCRDTConflictStrategy InS
 bool FJsonCRDTDefaultConflictResolver::ResolveLastWriterWins(FJsonCRDTConflict& Conflict)
 {
     // 타임스탬프 비교
-    if (Conflict.LocalOperation.Timestamp > Conflict.RemoteOperation.Timestamp)
+    if (Conflict.LocalTimestamp > Conflict.RemoteTimestamp)
     {
         // 로컬 작업이 더 최신
         Conflict.ResolvedValue = Conflict.LocalValue;
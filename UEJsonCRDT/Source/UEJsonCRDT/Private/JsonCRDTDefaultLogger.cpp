@@ -6,49 +6,99 @@
 #include "Serialization/JsonWriter.h"
 #include "Serialization/JsonReader.h"
 #include "Misc/Paths.h"
+#include "HAL/FileManager.h"
 #include "HAL/PlatformFilemanager.h"
+#include "HAL/PlatformProcess.h"
+
+namespace JsonCRDTDefaultLogger
+{
+    /** 문자열을 UTF-8로 기록 */
+    static void WriteUTF8(FArchive& Archive, const FString& Text)
+    {
+        FTCHARToUTF8 Utf8(*Text, Text.Len());
+        Archive.Serialize(const_cast<uint8*>(reinterpret_cast<const uint8*>(Utf8.Get())), Utf8.Length());
+    }
+}
 
 FJsonCRDTDefaultLogger::FJsonCRDTDefaultLogger(int32 InMaxLogEntries)
-    : MaxLogEntries(InMaxLogEntries)
+    : WriteCursor(0)
+    , MaxLogEntries(FMath::Max(1, InMaxLogEntries))
     , bLoggingEnabled(true)
 {
 }
 
 void FJsonCRDTDefaultLogger::LogOperation(const FJsonCRDTLogEntry& LogEntry)
 {
-    if (!bLoggingEnabled)
+    if (!bLoggingEnabled.load(std::memory_order_relaxed))
     {
         return;
     }
     
-    // 로그 항목 추가
-    LogEntries.Add(LogEntry);
+    SlotsLock.ReadLock();
     
-    // 최대 개수 초과 시 가장 오래된 항목 제거
-    if (LogEntries.Num() > MaxLogEntries)
+    // 처음 기록할 때 버퍼 할당
+    if (!Slots.IsValid())
     {
-        LogEntries.RemoveAt(0);
+        SlotsLock.ReadUnlock();
+        {
+            FWriteScopeLock WriteLock(SlotsLock);
+            if (!Slots.IsValid())
+            {
+                AllocateSlots(MaxLogEntries);
+            }
+        }
+        SlotsLock.ReadLock();
     }
-}
-
-bool FJsonCRDTDefaultLogger::ExportLogs(const FString& FilePath, const FJsonCRDTLogFilter& Filter)
-{
-    // 필터링된 로그 항목 가져오기
-    TArray<FJsonCRDTLogEntry> FilteredLogs = GetLogs(Filter);
     
-    // JSON 배열 생성
-    TArray<TSharedPtr<FJsonValue>> JsonArray;
-    for (const FJsonCRDTLogEntry& LogEntry : FilteredLogs)
+    // 슬롯을 잡기 전에 인터닝해 슬롯 점유 시간을 줄임
+    FInternedString* DocumentEntry;
+    FInternedString* ClientEntry;
+    FInternedString* UnusedEntry;
+    const int32 DocumentID = Intern(LogEntry.DocumentID, DocumentEntry);
+    const int32 OperationType = Intern(LogEntry.OperationType, UnusedEntry);
+    const int32 ClientID = Intern(LogEntry.ClientID, ClientEntry);
+    const int32 Source = Intern(LogEntry.Source, UnusedEntry);
+    
+    const uint64 Sequence = WriteCursor.fetch_add(1, std::memory_order_relaxed);
+    const int32 SlotIndex = static_cast<int32>(Sequence % static_cast<uint64>(MaxLogEntries));
+    FLogSlot& Slot = Slots[SlotIndex];
+    
+    LockSlot(Slot);
+    
+    // 더 나중 항목이 한 바퀴 돌아 이미 이 슬롯을 썼으면 이 항목은 밀려난 것으로 봄
+    if (Slot.Sequence.load(std::memory_order_relaxed) <= Sequence)
     {
-        TSharedPtr<FJsonObject> JsonObject = LogEntryToJson(LogEntry);
-        JsonArray.Add(MakeShared<FJsonValueObject>(JsonObject));
+        // 기존 문자열 버퍼를 재사용하도록 필드별로 대입
+        FLogRecord& Record = Slot.Record;
+        Record.LogID = LogEntry.LogID;
+        Record.DocumentID = DocumentID;
+        Record.OperationType = OperationType;
+        Record.Path = LogEntry.Path;
+        Record.OldValue = LogEntry.OldValue;
+        Record.NewValue = LogEntry.NewValue;
+        Record.Timestamp = LogEntry.Timestamp;
+        Record.bHadConflict = LogEntry.bHadConflict;
+        if (LogEntry.bHadConflict)
+        {
+            Record.Conflict = LogEntry.Conflict;
+        }
+        Record.ClientID = ClientID;
+        Record.Source = Source;
+        
+        // 문서/클라이언트 체인에 연결 (슬롯을 잡은 채로 바꾸므로 체인을 따라온 조회는 기록이 끝날 때까지 기다림)
+        Record.PrevDocumentEntry = DocumentEntry ? DocumentEntry->LastDocumentEntry.exchange(Sequence + 1) : 0;
+        Record.PrevClientEntry = ClientEntry ? ClientEntry->LastClientEntry.exchange(Sequence + 1) : 0;
+        SetConflictBit(SlotIndex, LogEntry.bHadConflict);
+        
+        Slot.Sequence.store(Sequence + 1, std::memory_order_relaxed);
     }
     
-    // JSON 문자열로 변환
-    FString JsonString;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
-    FJsonSerializer::Serialize(JsonArray, Writer);
-    
+    UnlockSlot(Slot);
+    SlotsLock.ReadUnlock();
+}
+
+bool FJsonCRDTDefaultLogger::ExportLogs(const FString& FilePath, const FJsonCRDTLogFilter& Filter)
+{
     // 디렉토리 생성
     FString Directory = FPaths::GetPath(FilePath);
     IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
@@ -61,35 +111,94 @@ bool FJsonCRDTDefaultLogger::ExportLogs(const FString& FilePath, const FJsonCRDT
         }
     }
     
-    // 파일에 저장
-    if (!FFileHelper::SaveStringToFile(JsonString, *FilePath))
+    TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*FilePath));
+    if (!FileWriter)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Failed to save logs to file: %s"), *FilePath);
+        return false;
+    }
+    
+    // 전체 문자열을 만들지 않고 항목별로 JSON 배열에 이어 기록
+    int32 NumExported = 0;
+    FString EntryString;
+    JsonCRDTDefaultLogger::WriteUTF8(*FileWriter, TEXT("["));
+    {
+        FReadScopeLock Lock(SlotsLock);
+        ForEachMatching(Filter, [this, &FileWriter, &EntryString, &NumExported](FJsonCRDTLogEntry&& LogEntry)
+        {
+            EntryString.Reset();
+            TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&EntryString, 1);
+            FJsonSerializer::Serialize(LogEntryToJson(LogEntry).ToSharedRef(), Writer);
+            
+            JsonCRDTDefaultLogger::WriteUTF8(*FileWriter, NumExported > 0 ? TEXT(",\n\t") : TEXT("\n\t"));
+            JsonCRDTDefaultLogger::WriteUTF8(*FileWriter, EntryString);
+            ++NumExported;
+        });
+    }
+    JsonCRDTDefaultLogger::WriteUTF8(*FileWriter, NumExported > 0 ? TEXT("\n]") : TEXT("]"));
+    
+    if (!FileWriter->Close())
     {
         UE_LOG(LogTemp, Error, TEXT("Failed to save logs to file: %s"), *FilePath);
         return false;
     }
     
-    UE_LOG(LogTemp, Log, TEXT("Exported %d log entries to %s"), FilteredLogs.Num(), *FilePath);
+    UE_LOG(LogTemp, Log, TEXT("Exported %d log entries to %s"), NumExported, *FilePath);
     return true;
 }
 
-TArray<FJsonCRDTLogEntry> FJsonCRDTDefaultLogger::GetLogs(const FJsonCRDTLogFilter& Filter)
+bool FJsonCRDTDefaultLogger::LoadExportedLogs(const FString& FilePath, TArray<FJsonCRDTLogEntry>& OutLogEntries) const
 {
-    TArray<FJsonCRDTLogEntry> FilteredLogs;
+    FString FileContent;
+    if (!FFileHelper::LoadFileToString(FileContent, *FilePath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("Failed to load logs from file: %s"), *FilePath);
+        return false;
+    }
     
-    // 필터 적용
-    for (const FJsonCRDTLogEntry& LogEntry : LogEntries)
+    TArray<TSharedPtr<FJsonValue>> JsonEntries;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FileContent);
+    if (!FJsonSerializer::Deserialize(Reader, JsonEntries))
     {
-        if (ApplyFilter(LogEntry, Filter))
+        UE_LOG(LogTemp, Error, TEXT("Failed to parse logs from file: %s"), *FilePath);
+        return false;
+    }
+    
+    OutLogEntries.Reserve(OutLogEntries.Num() + JsonEntries.Num());
+    for (const TSharedPtr<FJsonValue>& JsonEntry : JsonEntries)
+    {
+        FJsonCRDTLogEntry LogEntry;
+        if (JsonEntry.IsValid() && JsonToLogEntry(JsonEntry->AsObject(), LogEntry))
         {
-            FilteredLogs.Add(LogEntry);
+            OutLogEntries.Add(MoveTemp(LogEntry));
         }
     }
     
+    return true;
+}
+
+TArray<FJsonCRDTLogEntry> FJsonCRDTDefaultLogger::GetLogs(const FJsonCRDTLogFilter& Filter)
+{
+    TArray<FJsonCRDTLogEntry> FilteredLogs;
+    
+    FReadScopeLock Lock(SlotsLock);
+    ForEachMatching(Filter, [&FilteredLogs](FJsonCRDTLogEntry&& LogEntry)
+    {
+        FilteredLogs.Add(MoveTemp(LogEntry));
+    });
+    
     return FilteredLogs;
 }
 
 void FJsonCRDTDefaultLogger::ClearLogs(const FJsonCRDTLogFilter& Filter)
 {
+    FWriteScopeLock Lock(SlotsLock);
+    
+    if (!Slots.IsValid())
+    {
+        return;
+    }
+    
     // 필터가 비어있으면 모든 로그 지우기
     if (Filter.DocumentID.IsEmpty() && 
         Filter.OperationType.IsEmpty() && 
@@ -100,92 +209,498 @@ void FJsonCRDTDefaultLogger::ClearLogs(const FJsonCRDTLogFilter& Filter)
         Filter.StartTime.GetTicks() == 0 &&
         Filter.EndTime.GetTicks() == 0)
     {
-        LogEntries.Empty();
+        // 남은 항목이 없으므로 인터닝 테이블도 비움
+        AllocateSlots(MaxLogEntries);
+        
+        FWriteScopeLock InternWriteLock(InternLock);
+        InternedStrings.Empty();
+        InternIndices.Empty();
+        return;
+    }
+    
+    const FResolvedFilter Resolved = ResolveFilter(Filter);
+    if (Resolved.bMatchesNothing)
+    {
         return;
     }
     
-    // 필터에 맞지 않는 항목만 유지
-    for (int32 i = LogEntries.Num() - 1; i >= 0; --i)
+    // 기록 중인 스레드가 없으므로 슬롯 플래그 없이 한 번에 압축:
+    // 남길 항목을 앞쪽 순번으로 당기면서 체인과 충돌 비트맵을 다시 만듦
+    const uint64 Capacity = static_cast<uint64>(MaxLogEntries);
+    const uint64 End = WriteCursor.load(std::memory_order_relaxed);
+    const uint64 Begin = GetOldestSequence(End);
+    
+    for (const TUniquePtr<FInternedString>& Entry : InternedStrings)
+    {
+        Entry->LastDocumentEntry.store(0, std::memory_order_relaxed);
+        Entry->LastClientEntry.store(0, std::memory_order_relaxed);
+    }
+    
+    const int32 NumWords = (MaxLogEntries + 63) / 64;
+    for (int32 Word = 0; Word < NumWords; ++Word)
+    {
+        ConflictBits[Word].store(0, std::memory_order_relaxed);
+    }
+    
+    uint64 KeptEnd = Begin;
+    for (uint64 Sequence = Begin; Sequence < End; ++Sequence)
+    {
+        FLogSlot& SourceSlot = Slots[Sequence % Capacity];
+        if (SourceSlot.Sequence.load(std::memory_order_relaxed) != Sequence + 1 || ApplyFilter(SourceSlot.Record, Filter, Resolved))
+        {
+            continue;
+        }
+        
+        const int32 TargetIndex = static_cast<int32>(KeptEnd % Capacity);
+        FLogSlot& TargetSlot = Slots[TargetIndex];
+        if (&TargetSlot != &SourceSlot)
+        {
+            TargetSlot.Record = MoveTemp(SourceSlot.Record);
+        }
+        
+        FLogRecord& Record = TargetSlot.Record;
+        Record.PrevDocumentEntry = Record.DocumentID != INDEX_NONE ? InternedStrings[Record.DocumentID]->LastDocumentEntry.exchange(KeptEnd + 1) : 0;
+        Record.PrevClientEntry = Record.ClientID != INDEX_NONE ? InternedStrings[Record.ClientID]->LastClientEntry.exchange(KeptEnd + 1) : 0;
+        SetConflictBit(TargetIndex, Record.bHadConflict);
+        TargetSlot.Sequence.store(KeptEnd + 1, std::memory_order_relaxed);
+        
+        ++KeptEnd;
+    }
+    
+    // 압축된 범위 밖의 슬롯 비우기 (문자열 버퍼는 다음 기록에 재사용)
+    for (int32 i = 0; i < MaxLogEntries; ++i)
     {
-        if (ApplyFilter(LogEntries[i], Filter))
+        const uint64 Stored = Slots[i].Sequence.load(std::memory_order_relaxed);
+        if (Stored <= Begin || Stored > KeptEnd)
         {
-            LogEntries.RemoveAt(i);
+            Slots[i].Sequence.store(0, std::memory_order_relaxed);
         }
     }
+    
+    WriteCursor.store(KeptEnd, std::memory_order_relaxed);
 }
 
 void FJsonCRDTDefaultLogger::SetLoggingEnabled(bool bEnable)
 {
-    bLoggingEnabled = bEnable;
+    bLoggingEnabled.store(bEnable, std::memory_order_relaxed);
 }
 
 bool FJsonCRDTDefaultLogger::IsLoggingEnabled() const
 {
-    return bLoggingEnabled;
+    return bLoggingEnabled.load(std::memory_order_relaxed);
 }
 
 void FJsonCRDTDefaultLogger::SetMaxLogEntries(int32 InMaxLogEntries)
 {
-    MaxLogEntries = InMaxLogEntries;
+    InMaxLogEntries = FMath::Max(1, InMaxLogEntries);
     
-    // 최대 개수 초과 시 가장 오래된 항목 제거
-    while (LogEntries.Num() > MaxLogEntries)
+    FWriteScopeLock Lock(SlotsLock);
+    
+    // 버퍼를 새 크기로 바꾸고 최근 항목부터 들어가는 만큼 옮김 (순번을 유지하므로 체인은 그대로 유효)
+    if (Slots.IsValid() && InMaxLogEntries != MaxLogEntries)
     {
-        LogEntries.RemoveAt(0);
+        TUniquePtr<FLogSlot[]> OldSlots = MoveTemp(Slots);
+        AllocateSlots(InMaxLogEntries);
+        
+        const uint64 OldCapacity = static_cast<uint64>(MaxLogEntries);
+        const uint64 NewCapacity = static_cast<uint64>(InMaxLogEntries);
+        const uint64 KeepCount = FMath::Min(OldCapacity, NewCapacity);
+        const uint64 End = WriteCursor.load(std::memory_order_relaxed);
+        const uint64 Begin = End > KeepCount ? End - KeepCount : 0;
+        
+        for (uint64 Sequence = Begin; Sequence < End; ++Sequence)
+        {
+            FLogSlot& OldSlot = OldSlots[Sequence % OldCapacity];
+            if (OldSlot.Sequence.load(std::memory_order_relaxed) == Sequence + 1)
+            {
+                const int32 NewIndex = static_cast<int32>(Sequence % NewCapacity);
+                FLogSlot& NewSlot = Slots[NewIndex];
+                NewSlot.Record = MoveTemp(OldSlot.Record);
+                NewSlot.Sequence.store(Sequence + 1, std::memory_order_relaxed);
+                SetConflictBit(NewIndex, NewSlot.Record.bHadConflict);
+            }
+        }
     }
+    
+    MaxLogEntries = InMaxLogEntries;
 }
 
 int32 FJsonCRDTDefaultLogger::GetMaxLogEntries() const
 {
+    FReadScopeLock Lock(SlotsLock);
     return MaxLogEntries;
 }
 
-bool FJsonCRDTDefaultLogger::ApplyFilter(const FJsonCRDTLogEntry& LogEntry, const FJsonCRDTLogFilter& Filter) const
+void FJsonCRDTDefaultLogger::AllocateSlots(int32 Capacity)
+{
+    Slots = MakeUnique<FLogSlot[]>(Capacity);
+    ConflictBits = MakeUnique<std::atomic<uint64>[]>((Capacity + 63) / 64);
+}
+
+int32 FJsonCRDTDefaultLogger::Intern(const FString& Value, FInternedString*& OutEntry)
+{
+    OutEntry = nullptr;
+    if (Value.IsEmpty())
+    {
+        return INDEX_NONE;
+    }
+    
+    {
+        FReadScopeLock Lock(InternLock);
+        if (const int32* Found = InternIndices.Find(Value))
+        {
+            OutEntry = InternedStrings[*Found].Get();
+            return *Found;
+        }
+    }
+    
+    FWriteScopeLock Lock(InternLock);
+    if (const int32* Found = InternIndices.Find(Value))
+    {
+        OutEntry = InternedStrings[*Found].Get();
+        return *Found;
+    }
+    
+    TUniquePtr<FInternedString> NewEntry = MakeUnique<FInternedString>();
+    NewEntry->Value = Value;
+    OutEntry = NewEntry.Get();
+    
+    const int32 Index = InternedStrings.Add(MoveTemp(NewEntry));
+    InternIndices.Add(Value, Index);
+    return Index;
+}
+
+void FJsonCRDTDefaultLogger::LockSlot(FLogSlot& Slot)
+{
+    // 슬롯을 잡는 구간은 필드 대입이나 복사 한 번이므로 잠들지 않고 양보만 함
+    bool bExpected = false;
+    while (!Slot.bBusy.compare_exchange_weak(bExpected, true, std::memory_order_acquire, std::memory_order_relaxed))
+    {
+        bExpected = false;
+        FPlatformProcess::YieldThread();
+    }
+}
+
+void FJsonCRDTDefaultLogger::UnlockSlot(FLogSlot& Slot)
+{
+    Slot.bBusy.store(false, std::memory_order_release);
+}
+
+void FJsonCRDTDefaultLogger::SetConflictBit(int32 SlotIndex, bool bConflict)
+{
+    const uint64 Mask = 1ull << (SlotIndex % 64);
+    if (bConflict)
+    {
+        ConflictBits[SlotIndex / 64].fetch_or(Mask, std::memory_order_relaxed);
+    }
+    else
+    {
+        ConflictBits[SlotIndex / 64].fetch_and(~Mask, std::memory_order_relaxed);
+    }
+}
+
+uint64 FJsonCRDTDefaultLogger::GetOldestSequence(uint64 End) const
+{
+    const uint64 Capacity = static_cast<uint64>(MaxLogEntries);
+    return End > Capacity ? End - Capacity : 0;
+}
+
+bool FJsonCRDTDefaultLogger::CollectCandidates(const FJsonCRDTLogFilter& Filter, const FResolvedFilter& Resolved, TArray<uint64>& OutSequences, uint64& OutBegin, uint64& OutEnd) const
+{
+    OutEnd = WriteCursor.load(std::memory_order_relaxed);
+    OutBegin = GetOldestSequence(OutEnd);
+    
+    // 충돌은 드물다고 보고 충돌 비트맵을 가장 먼저 사용
+    if (Filter.bConflictsOnly)
+    {
+        const int32 NumWords = (MaxLogEntries + 63) / 64;
+        for (int32 Word = 0; Word < NumWords; ++Word)
+        {
+            uint64 Bits = ConflictBits[Word].load(std::memory_order_relaxed);
+            while (Bits != 0)
+            {
+                const int32 SlotIndex = Word * 64 + static_cast<int32>(FMath::CountTrailingZeros64(Bits));
+                Bits &= Bits - 1;
+                
+                // 슬롯 내용은 방문할 때 다시 확인
+                const uint64 Stored = Slots[SlotIndex].Sequence.load(std::memory_order_relaxed);
+                if (Stored > OutBegin && Stored <= OutEnd)
+                {
+                    OutSequences.Add(Stored - 1);
+                }
+            }
+        }
+        
+        OutSequences.Sort();
+        return true;
+    }
+    
+    if (Resolved.DocumentID != INDEX_NONE || Resolved.ClientID != INDEX_NONE)
+    {
+        const bool bClientChain = Resolved.DocumentID == INDEX_NONE;
+        uint64 Head;
+        {
+            FReadScopeLock Lock(InternLock);
+            Head = bClientChain
+                ? InternedStrings[Resolved.ClientID]->LastClientEntry.load()
+                : InternedStrings[Resolved.DocumentID]->LastDocumentEntry.load();
+        }
+        
+        CollectChain(Head, bClientChain, OutBegin, OutSequences);
+        return true;
+    }
+    
+    // 색인이 없으면 시간 범위로만 좁힘
+    FindTimeRange(Filter, OutBegin, OutEnd);
+    return false;
+}
+
+void FJsonCRDTDefaultLogger::CollectChain(uint64 Head, bool bClientChain, uint64 Oldest, TArray<uint64>& OutSequences) const
+{
+    const uint64 Capacity = static_cast<uint64>(MaxLogEntries);
+    
+    uint64 Link = Head;
+    while (Link > Oldest)
+    {
+        FLogSlot& Slot = Slots[(Link - 1) % Capacity];
+        
+        LockSlot(Slot);
+        const bool bHoldsEntry = Slot.Sequence.load(std::memory_order_relaxed) == Link;
+        const uint64 Prev = bClientChain ? Slot.Record.PrevClientEntry : Slot.Record.PrevDocumentEntry;
+        UnlockSlot(Slot);
+        
+        // 덮어쓴 슬롯에 닿으면 그보다 오래된 항목도 남아 있지 않음
+        if (!bHoldsEntry)
+        {
+            break;
+        }
+        
+        OutSequences.Add(Link - 1);
+        Link = Prev;
+    }
+    
+    // 동시에 기록된 항목은 체인 순서와 순번 순서가 다를 수 있음
+    OutSequences.Sort();
+}
+
+void FJsonCRDTDefaultLogger::FindTimeRange(const FJsonCRDTLogFilter& Filter, uint64& InOutBegin, uint64& InOutEnd) const
+{
+    // 읽지 못한 슬롯(기록 중)을 만나면 거기서 멈추고 지금까지 좁힌 범위를 사용
+    if (Filter.StartTime.GetTicks() > 0)
+    {
+        uint64 Low = InOutBegin;
+        uint64 High = InOutEnd;
+        while (Low < High)
+        {
+            const uint64 Mid = Low + (High - Low) / 2;
+            FDateTime Timestamp;
+            if (!ReadTimestamp(Mid, Timestamp))
+            {
+                break;
+            }
+            
+            if (Timestamp < Filter.StartTime)
+            {
+                Low = Mid + 1;
+            }
+            else
+            {
+                High = Mid;
+            }
+        }
+        InOutBegin = Low;
+    }
+    
+    if (Filter.EndTime.GetTicks() > 0)
+    {
+        uint64 Low = InOutBegin;
+        uint64 High = InOutEnd;
+        while (Low < High)
+        {
+            const uint64 Mid = Low + (High - Low) / 2;
+            FDateTime Timestamp;
+            if (!ReadTimestamp(Mid, Timestamp))
+            {
+                break;
+            }
+            
+            if (Timestamp > Filter.EndTime)
+            {
+                High = Mid;
+            }
+            else
+            {
+                Low = Mid + 1;
+            }
+        }
+        InOutEnd = High;
+    }
+}
+
+bool FJsonCRDTDefaultLogger::ReadTimestamp(uint64 Sequence, FDateTime& OutTimestamp) const
+{
+    FLogSlot& Slot = Slots[Sequence % static_cast<uint64>(MaxLogEntries)];
+    
+    LockSlot(Slot);
+    const bool bHoldsEntry = Slot.Sequence.load(std::memory_order_relaxed) == Sequence + 1;
+    if (bHoldsEntry)
+    {
+        OutTimestamp = Slot.Record.Timestamp;
+    }
+    UnlockSlot(Slot);
+    
+    return bHoldsEntry;
+}
+
+void FJsonCRDTDefaultLogger::ForEachMatching(const FJsonCRDTLogFilter& Filter, TFunctionRef<void(FJsonCRDTLogEntry&&)> Visitor) const
+{
+    if (!Slots.IsValid())
+    {
+        return;
+    }
+    
+    // 필터 문자열이 한 번도 기록되지 않았으면 맞는 항목이 없음
+    const FResolvedFilter Resolved = ResolveFilter(Filter);
+    if (Resolved.bMatchesNothing)
+    {
+        return;
+    }
+    
+    const uint64 Capacity = static_cast<uint64>(MaxLogEntries);
+    auto VisitSequence = [this, &Filter, &Resolved, &Visitor, Capacity](uint64 Sequence)
+    {
+        FLogSlot& Slot = Slots[Sequence % Capacity];
+        FJsonCRDTLogEntry LogEntry;
+        
+        LockSlot(Slot);
+        const bool bMatched = Slot.Sequence.load(std::memory_order_relaxed) == Sequence + 1 && ApplyFilter(Slot.Record, Filter, Resolved);
+        if (bMatched)
+        {
+            RecordToLogEntry(Slot.Record, LogEntry);
+        }
+        UnlockSlot(Slot);
+        
+        if (bMatched)
+        {
+            Visitor(MoveTemp(LogEntry));
+        }
+    };
+    
+    TArray<uint64> Sequences;
+    uint64 Begin;
+    uint64 End;
+    if (CollectCandidates(Filter, Resolved, Sequences, Begin, End))
+    {
+        for (uint64 Sequence : Sequences)
+        {
+            VisitSequence(Sequence);
+        }
+    }
+    else
+    {
+        for (uint64 Sequence = Begin; Sequence < End; ++Sequence)
+        {
+            VisitSequence(Sequence);
+        }
+    }
+}
+
+void FJsonCRDTDefaultLogger::RecordToLogEntry(const FLogRecord& Record, FJsonCRDTLogEntry& OutLogEntry) const
+{
+    OutLogEntry.LogID = Record.LogID;
+    OutLogEntry.Path = Record.Path;
+    OutLogEntry.OldValue = Record.OldValue;
+    OutLogEntry.NewValue = Record.NewValue;
+    OutLogEntry.Timestamp = Record.Timestamp;
+    OutLogEntry.bHadConflict = Record.bHadConflict;
+    if (Record.bHadConflict)
+    {
+        OutLogEntry.Conflict = Record.Conflict;
+    }
+    
+    FReadScopeLock Lock(InternLock);
+    OutLogEntry.DocumentID = Record.DocumentID != INDEX_NONE ? InternedStrings[Record.DocumentID]->Value : FString();
+    OutLogEntry.OperationType = Record.OperationType != INDEX_NONE ? InternedStrings[Record.OperationType]->Value : FString();
+    OutLogEntry.ClientID = Record.ClientID != INDEX_NONE ? InternedStrings[Record.ClientID]->Value : FString();
+    OutLogEntry.Source = Record.Source != INDEX_NONE ? InternedStrings[Record.Source]->Value : FString();
+}
+
+FJsonCRDTDefaultLogger::FResolvedFilter FJsonCRDTDefaultLogger::ResolveFilter(const FJsonCRDTLogFilter& Filter) const
+{
+    FResolvedFilter Resolved;
+    
+    FReadScopeLock Lock(InternLock);
+    auto Resolve = [this, &Resolved](const FString& Value, int32& OutIndex)
+    {
+        if (Value.IsEmpty())
+        {
+            return;
+        }
+        
+        if (const int32* Found = InternIndices.Find(Value))
+        {
+            OutIndex = *Found;
+        }
+        else
+        {
+            Resolved.bMatchesNothing = true;
+        }
+    };
+    
+    Resolve(Filter.DocumentID, Resolved.DocumentID);
+    Resolve(Filter.OperationType, Resolved.OperationType);
+    Resolve(Filter.ClientID, Resolved.ClientID);
+    Resolve(Filter.Source, Resolved.Source);
+    
+    return Resolved;
+}
+
+bool FJsonCRDTDefaultLogger::ApplyFilter(const FLogRecord& Record, const FJsonCRDTLogFilter& Filter, const FResolvedFilter& Resolved) const
 {
     // 문서 ID 필터
-    if (!Filter.DocumentID.IsEmpty() && LogEntry.DocumentID != Filter.DocumentID)
+    if (Resolved.DocumentID != INDEX_NONE && Record.DocumentID != Resolved.DocumentID)
     {
         return false;
     }
     
     // 시작 시간 필터
-    if (Filter.StartTime.GetTicks() > 0 && LogEntry.Timestamp < Filter.StartTime)
+    if (Filter.StartTime.GetTicks() > 0 && Record.Timestamp < Filter.StartTime)
     {
         return false;
     }
     
     // 종료 시간 필터
-    if (Filter.EndTime.GetTicks() > 0 && LogEntry.Timestamp > Filter.EndTime)
+    if (Filter.EndTime.GetTicks() > 0 && Record.Timestamp > Filter.EndTime)
     {
         return false;
     }
     
     // 작업 유형 필터
-    if (!Filter.OperationType.IsEmpty() && LogEntry.OperationType != Filter.OperationType)
+    if (Resolved.OperationType != INDEX_NONE && Record.OperationType != Resolved.OperationType)
     {
         return false;
     }
     
     // 경로 필터
-    if (!Filter.Path.IsEmpty() && !LogEntry.Path.Contains(Filter.Path))
+    if (!Filter.Path.IsEmpty() && !Record.Path.Contains(Filter.Path))
     {
         return false;
     }
     
     // 충돌 필터
-    if (Filter.bConflictsOnly && !LogEntry.bHadConflict)
+    if (Filter.bConflictsOnly && !Record.bHadConflict)
     {
         return false;
     }
     
     // 클라이언트 ID 필터
-    if (!Filter.ClientID.IsEmpty() && LogEntry.ClientID != Filter.ClientID)
+    if (Resolved.ClientID != INDEX_NONE && Record.ClientID != Resolved.ClientID)
     {
         return false;
     }
     
     // 소스 필터
-    if (!Filter.Source.IsEmpty() && LogEntry.Source != Filter.Source)
+    if (Resolved.Source != INDEX_NONE && Record.Source != Resolved.Source)
     {
         return false;
     }
@@ -219,24 +734,11 @@ TSharedPtr<FJsonObject> FJsonCRDTDefaultLogger::LogEntryToJson(const FJsonCRDTLo
         ConflictObject->SetStringField(TEXT("resolvedValue"), LogEntry.Conflict.ResolvedValue);
         ConflictObject->SetBoolField(TEXT("resolved"), LogEntry.Conflict.bResolved);
         
-        // 로컬 작업 정보
-        TSharedPtr<FJsonObject> LocalOperationObject = MakeShared<FJsonObject>();
-        LocalOperationObject->SetStringField(TEXT("type"), FString::FromInt(static_cast<int32>(LogEntry.Conflict.LocalOperation.Type)));
-        LocalOperationObject->SetStringField(TEXT("path"), LogEntry.Conflict.LocalOperation.Path);
-        LocalOperationObject->SetStringField(TEXT("value"), LogEntry.Conflict.LocalOperation.Value);
-        LocalOperationObject->SetStringField(TEXT("fromPath"), LogEntry.Conflict.LocalOperation.FromPath);
-        LocalOperationObject->SetStringField(TEXT("timestamp"), LogEntry.Conflict.LocalOperation.Timestamp.ToString());
-        
-        // 원격 작업 정보
-        TSharedPtr<FJsonObject> RemoteOperationObject = MakeShared<FJsonObject>();
-        RemoteOperationObject->SetStringField(TEXT("type"), FString::FromInt(static_cast<int32>(LogEntry.Conflict.RemoteOperation.Type)));
-        RemoteOperationObject->SetStringField(TEXT("path"), LogEntry.Conflict.RemoteOperation.Path);
-        RemoteOperationObject->SetStringField(TEXT("value"), LogEntry.Conflict.RemoteOperation.Value);
-        RemoteOperationObject->SetStringField(TEXT("fromPath"), LogEntry.Conflict.RemoteOperation.FromPath);
-        RemoteOperationObject->SetStringField(TEXT("timestamp"), LogEntry.Conflict.RemoteOperation.Timestamp.ToString());
-        
-        ConflictObject->SetObjectField(TEXT("localOperation"), LocalOperationObject);
-        ConflictObject->SetObjectField(TEXT("remoteOperation"), RemoteOperationObject);
+        // 작업 자체는 문서의 작업 히스토리에 있으므로 시퀀스 번호와 타임스탬프만 기록
+        ConflictObject->SetNumberField(TEXT("localSequence"), static_cast<double>(LogEntry.Conflict.LocalSequence));
+        ConflictObject->SetNumberField(TEXT("remoteSequence"), static_cast<double>(LogEntry.Conflict.RemoteSequence));
+        ConflictObject->SetStringField(TEXT("localTimestamp"), LogEntry.Conflict.LocalTimestamp.ToString());
+        ConflictObject->SetStringField(TEXT("remoteTimestamp"), LogEntry.Conflict.RemoteTimestamp.ToString());
         
         JsonObject->SetObjectField(TEXT("conflict"), ConflictObject);
     }
@@ -282,46 +784,17 @@ bool FJsonCRDTDefaultLogger::JsonToLogEntry(const TSharedPtr<FJsonObject>& JsonO
             (*ConflictObject)->TryGetStringField(TEXT("resolvedValue"), OutLogEntry.Conflict.ResolvedValue);
             (*ConflictObject)->TryGetBoolField(TEXT("resolved"), OutLogEntry.Conflict.bResolved);
             
-            // 로컬 작업 정보 파싱
-            const TSharedPtr<FJsonObject>* LocalOperationObject;
-            if ((*ConflictObject)->TryGetObjectField(TEXT("localOperation"), LocalOperationObject))
+            (*ConflictObject)->TryGetNumberField(TEXT("localSequence"), OutLogEntry.Conflict.LocalSequence);
+            (*ConflictObject)->TryGetNumberField(TEXT("remoteSequence"), OutLogEntry.Conflict.RemoteSequence);
+            
+            FString OperationTimestampString;
+            if ((*ConflictObject)->TryGetStringField(TEXT("localTimestamp"), OperationTimestampString))
             {
-                FString TypeString;
-                if ((*LocalOperationObject)->TryGetStringField(TEXT("type"), TypeString))
-                {
-                    OutLogEntry.Conflict.LocalOperation.Type = static_cast<EJsonCRDTOperationType>(FCString::Atoi(*TypeString));
-                }
-                
-                (*LocalOperationObject)->TryGetStringField(TEXT("path"), OutLogEntry.Conflict.LocalOperation.Path);
-                (*LocalOperationObject)->TryGetStringField(TEXT("value"), OutLogEntry.Conflict.LocalOperation.Value);
-                (*LocalOperationObject)->TryGetStringField(TEXT("fromPath"), OutLogEntry.Conflict.LocalOperation.FromPath);
-                
-                FString OperationTimestampString;
-                if ((*LocalOperationObject)->TryGetStringField(TEXT("timestamp"), OperationTimestampString))
-                {
-                    FDateTime::Parse(OperationTimestampString, OutLogEntry.Conflict.LocalOperation.Timestamp);
-                }
+                FDateTime::Parse(OperationTimestampString, OutLogEntry.Conflict.LocalTimestamp);
             }
-            
-            // 원격 작업 정보 파싱
-            const TSharedPtr<FJsonObject>* RemoteOperationObject;
-            if ((*ConflictObject)->TryGetObjectField(TEXT("remoteOperation"), RemoteOperationObject))
+            if ((*ConflictObject)->TryGetStringField(TEXT("remoteTimestamp"), OperationTimestampString))
             {
-                FString TypeString;
-                if ((*RemoteOperationObject)->TryGetStringField(TEXT("type"), TypeString))
-                {
-                    OutLogEntry.Conflict.RemoteOperation.Type = static_cast<EJsonCRDTOperationType>(FCString::Atoi(*TypeString));
-                }
-                
-                (*RemoteOperationObject)->TryGetStringField(TEXT("path"), OutLogEntry.Conflict.RemoteOperation.Path);
-                (*RemoteOperationObject)->TryGetStringField(TEXT("value"), OutLogEntry.Conflict.RemoteOperation.Value);
-                (*RemoteOperationObject)->TryGetStringField(TEXT("fromPath"), OutLogEntry.Conflict.RemoteOperation.FromPath);
-                
-                FString OperationTimestampString;
-                if ((*RemoteOperationObject)->TryGetStringField(TEXT("timestamp"), OperationTimestampString))
-                {
-                    FDateTime::Parse(OperationTimestampString, OutLogEntry.Conflict.RemoteOperation.Timestamp);
-                }
+                FDateTime::Parse(OperationTimestampString, OutLogEntry.Conflict.RemoteTimestamp);
             }
         }
     }
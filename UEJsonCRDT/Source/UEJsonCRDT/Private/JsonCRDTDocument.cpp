@@ -2,7 +2,8 @@
 
 #include "JsonCRDTDocument.h"
 #include "JsonCRDTSyncManager.h"
-#include "JsonObjectConverter.h"
+#include "JsonCRDTPatchParser.h"
+#include "JsonCRDTOperationApplier.h"
 #include "JsonCRDTDefaultConflictResolver.h"
 #include "JsonCRDTDefaultLogger.h"
 #include "JsonCRDTVisualizer.h"
@@ -12,17 +13,90 @@
 #include "Misc/FileHelper.h"
 #include "HAL/PlatformFilemanager.h"
 #include "Misc/Guid.h"
+#include "HAL/PlatformTime.h"
+#include "Algo/Reverse.h"
+#include "JsonCRDTLocalStorageWriter.h"
+#include "JsonCRDTJournal.h"
+#include "JsonCRDTStats.h"
+
+namespace JsonCRDTDocument
+{
+	/** 변경 기록에 보관하는 최대 작업 수 (넘으면 다음 저장은 전체 내용으로) */
+	static constexpr int32 MaxChangeLogOperations = 16384;
+
+	/** 같은 패치에서 앞서 바꾼 경로라서 적용할 때 충돌을 확인할 작업의 충돌 색인 */
+	static constexpr int32 DeferredConflict = -2;
+
+	/** 공백을 건너뛴 첫 문자가 객체나 배열의 시작인지 확인 */
+	static bool LooksLikeContainer(const FString& Value)
+	{
+		for (const TCHAR Char : Value)
+		{
+			if (!FChar::IsWhitespace(Char))
+			{
+				return Char == TEXT('{') || Char == TEXT('[');
+			}
+		}
+		return false;
+	}
+
+	/** 원격 Replace가 로컬 작업과 다른 값을 쓰면 충돌로 채움 (작업은 복사하지 않고 로컬 작업의 히스토리 시퀀스 번호만 남김) */
+	static bool MakeConflict(const FJsonCRDTOperation& LocalOperation, uint64 LocalSequence, const FJsonCRDTOperation& RemoteOperation, FJsonCRDTConflict& OutConflict)
+	{
+		if (LocalOperation.Value.Equals(RemoteOperation.Value, ESearchCase::CaseSensitive))
+		{
+			return false;
+		}
+
+		OutConflict.Path = RemoteOperation.Path;
+		OutConflict.LocalValue = LocalOperation.Value;
+		OutConflict.RemoteValue = RemoteOperation.Value;
+		OutConflict.LocalTimestamp = LocalOperation.Timestamp;
+		OutConflict.RemoteTimestamp = RemoteOperation.Timestamp;
+		OutConflict.LocalSequence = static_cast<int64>(LocalSequence);
+		return true;
+	}
+
+	/** 스냅샷 문자열이 차지하는 메모리 */
+	static SIZE_T GetSnapshotSize(const FJsonCRDTSnapshot& Snapshot)
+	{
+		return Snapshot.DocumentID.GetAllocatedSize() + Snapshot.Content.GetAllocatedSize();
+	}
+
+	/** 델타의 역작업이 차지하는 메모리 */
+	static SIZE_T GetDeltaSize(const FJsonCRDTSnapshotDelta& Delta)
+	{
+		SIZE_T Size = Delta.InverseOperations.GetAllocatedSize();
+		for (const FJsonCRDTOperation& Operation : Delta.InverseOperations)
+		{
+			Size += Operation.GetAllocatedSize();
+		}
+		return Size;
+	}
+}
 
 UJsonCRDTDocument::UJsonCRDTDocument()
-	: Version(1)
-	, SyncManager(nullptr)
-	, MaxOperationHistory(100)
-	, MaxSnapshotHistory(10)
+	: SyncManager(nullptr)
+	, OperationsSinceSnapshot(0)
+	, LastSnapshotTime(0.0)
+	, HistoryBytes(0)
+	, LastChangeTime(0.0)
 	, bAutoLocalSave(false)
+	, LocalStorageFormat(EJsonCRDTLocalStorageFormat::Json)
+	, bLocalSaveRequested(false)
+	, FirstLocalSaveRequestTime(0.0)
+	, LastLocalSaveRequestTime(0.0)
+	, LocalJournalSize(0)
+	, MaxLocalJournalSize(1024 * 1024)
+	, bLocalJournalValid(false)
+	, LocalPatchSequence(0)
+	, ChangeLogStartVersion(1)
+	, NumChangeLogOperations(0)
+	, ChangeLogGeneration(0)
+	, NextSubscriptionHandle(1)
 	, ConflictStrategy(EJsonCRDTConflictStrategy::LastWriterWins)
+	, NumResolvedConflicts(0)
 {
-	Content = MakeShared<FJsonObject>();
-
 	// 기본 충돌 해결 전략 설정
 	ConflictResolver = MakeShared<FJsonCRDTDefaultConflictResolver>(ConflictStrategy);
 
@@ -36,7 +110,7 @@ UJsonCRDTDocument::~UJsonCRDTDocument()
 
 void UJsonCRDTDocument::Initialize(const FString& InDocumentID, UJsonCRDTSyncManager* InSyncManager)
 {
-	DocumentID = InDocumentID;
+	Core.SetDocumentID(InDocumentID);
 	SyncManager = InSyncManager;
 
 	// Create initial snapshot
@@ -45,50 +119,117 @@ void UJsonCRDTDocument::Initialize(const FString& InDocumentID, UJsonCRDTSyncMan
 
 FString UJsonCRDTDocument::GetDocumentID() const
 {
-	return DocumentID;
+	return Core.GetDocumentID();
 }
 
 int64 UJsonCRDTDocument::GetVersion() const
 {
-	return Version;
+	return Core.GetVersion();
 }
 
 FString UJsonCRDTDocument::GetContentAsString() const
 {
-	FString OutputString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
-	FJsonSerializer::Serialize(Content.ToSharedRef(), Writer);
-	return OutputString;
+	MaterializeContent();
+	return Core.GetContent().ToString();
 }
 
 TSharedPtr<FJsonObject> UJsonCRDTDocument::GetContent() const
 {
-	return Content;
+	// Object view is built on demand; the node store stays the source of truth
+	MaterializeContent();
+	return Core.GetContent().ToJsonObject();
+}
+
+bool UJsonCRDTDocument::GetValueAtPath(const FString& Path, FString& OutValue) const
+{
+	// A mapped base file answers from the addressed subtree without decoding the rest
+	if (MappedContent)
+	{
+		return MappedContent->GetValueAtPath(*Core.GetPathCache().Get(Path), OutValue);
+	}
+
+	const int32 NodeIndex = Core.FindNodeAtPath(Path);
+	if (NodeIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	OutValue = Core.GetContent().NodeToString(NodeIndex);
+	return true;
+}
+
+const FJsonCRDTNodeStore& UJsonCRDTDocument::GetContentStore() const
+{
+	MaterializeContent();
+	return Core.GetContent();
 }
 
 bool UJsonCRDTDocument::SetContentFromString(const FString& JsonString)
 {
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
-	if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
+	// Parse straight into a node store without going through an FJsonObject tree
+	FJsonCRDTNodeStore NewContent;
+	if (!NewContent.LoadFromString(JsonString))
 	{
-		return SetContent(JsonObject);
+		return false;
 	}
-	return false;
+	return CommitContent(MoveTemp(NewContent));
 }
 
 bool UJsonCRDTDocument::SetContent(TSharedPtr<FJsonObject> JsonObject)
 {
-	if (!JsonObject.IsValid())
+	FJsonCRDTNodeStore NewContent;
+	if (!NewContent.LoadFromJsonObject(JsonObject))
 	{
 		return false;
 	}
+	return CommitContent(MoveTemp(NewContent));
+}
 
-	Content = JsonObject;
-	Version++;
+bool UJsonCRDTDocument::SetContentFromStore(FJsonCRDTNodeStore&& NewContent)
+{
+	return CommitContent(MoveTemp(NewContent));
+}
 
-	// Create a snapshot after content change
+bool UJsonCRDTDocument::SetServerContent(FJsonCRDTNodeStore&& NewContent, int64 ServerVersion)
+{
+	// Versions from here on continue the server's numbering, so the local history before it no longer lines up
+	MappedContent.Reset();
+	Core.SetContent(MoveTemp(NewContent));
+	Core.SetVersion(ServerVersion);
+	DeltaHistory.Reset();
+	SnapshotHistory.Reset();
+	HistoryBytes = 0;
 	CreateAndAddSnapshot();
+	LastChangeTime = FPlatformTime::Seconds();
+
+	// The loaded content goes into the next base file rather than the journal
+	InvalidateLocalJournal();
+	ResetChangeLog();
+
+	// Notify that the document has changed
+	NotifyDocumentChanged();
+
+	return true;
+}
+
+bool UJsonCRDTDocument::CommitContent(FJsonCRDTNodeStore&& NewContent)
+{
+	// A whole-content replace is a snapshot point: the previous content is kept as a full snapshot (bounded by
+	// MaxFullSnapshots) rather than as an inverse delta, and restores before it rewind from that snapshot
+	MaterializeContent();
+	if (OperationsSinceSnapshot > 0 || SnapshotHistory.Num() == 0 || SnapshotHistory.Last().Version != Core.GetVersion())
+	{
+		CreateAndAddSnapshot();
+	}
+
+	Core.SetContent(MoveTemp(NewContent));
+	Core.AdvanceVersion();
+	OperationsSinceSnapshot = 1;
+	LastChangeTime = FPlatformTime::Seconds();
+
+	// Whole-content changes go into the next base file rather than the journal
+	InvalidateLocalJournal();
+	ResetChangeLog();
 
 	// Notify that the document has changed
 	NotifyDocumentChanged();
@@ -98,306 +239,1183 @@ bool UJsonCRDTDocument::SetContent(TSharedPtr<FJsonObject> JsonObject)
 
 bool UJsonCRDTDocument::ApplyPatch(const FJsonCRDTPatch& Patch)
 {
-	// Validate the patch
-	if (Patch.DocumentID != DocumentID)
+	bool bResult;
+	if (!Core.ShouldApplyPatch(Patch, bResult))
 	{
-		UE_LOG(LogTemp, Error, TEXT("Patch document ID does not match: %s != %s"), *Patch.DocumentID, *DocumentID);
-		return false;
+		return bResult;
 	}
 
-	// Apply the operations in the patch
-	for (const FJsonCRDTOperation& Operation : Patch.Operations)
+	// The history keeps the applied operations anyway, so copy once up front and move from there
+	FJsonCRDTPatch OwnedPatch(Patch);
+	return ApplyAcceptedPatch(OwnedPatch);
+}
+
+bool UJsonCRDTDocument::ApplyPatch(FJsonCRDTPatch&& Patch)
+{
+	bool bResult;
+	if (!Core.ShouldApplyPatch(Patch, bResult))
 	{
-		// 현재 값 가져오기 (로깅 및 충돌 해결용)
-		FString OldValue;
-		if (Operation.Type == EJsonCRDTOperationType::Replace ||
-			Operation.Type == EJsonCRDTOperationType::Remove ||
-			Operation.Type == EJsonCRDTOperationType::Test)
+		return bResult;
+	}
+	return ApplyAcceptedPatch(Patch);
+}
+
+bool UJsonCRDTDocument::ApplyAcceptedPatch(FJsonCRDTPatch& Patch)
+{
+	JSONCRDT_SCOPE_CYCLE_COUNTER(STAT_JsonCRDT_ApplyPatch);
+
+	MaterializeContent();
+
+	// 스칼라 리프 Replace만으로 이루어진 패치는 경로와 값을 한 번만 해석하고 노드를 제자리에서 갱신
+	TArray<int32, TInlineAllocator<16>> BatchNodes;
+	TArray<FJsonCRDTScalar, TInlineAllocator<16>> BatchScalars;
+	bool bScalarBatch = PrepareScalarReplaceBatch(Patch, BatchNodes, BatchScalars);
+
+	// Apply the operations in the patch; the journal records what was actually applied after conflict resolution,
+	// so applied operations are compacted to the front of the patch's own array instead of being copied out
+	TArray<FJsonCRDTOperation>& Operations = Patch.Operations;
+
+	// 충돌은 적용 전에 모아 해결자에 한 번에 넘김 (같은 패치에서 다시 바꾸는 경로는 앞서 적용한 작업과 비교해 하나씩 해결)
+	TArray<FJsonCRDTConflict> Conflicts;
+	TArray<int32, TInlineAllocator<16>> OperationConflicts;
+	CollectConflicts(Operations, Conflicts, OperationConflicts);
+	if (Conflicts.Num() > 0)
+	{
+		ResolveConflicts(Conflicts);
+	}
+
+	// 히스토리와 로그에는 패치가 끝까지 적용된 뒤에만 넣으므로, 같은 패치에서 마지막으로 적용한 Replace는 따로 추적
+	const bool bHasDeferredConflicts = OperationConflicts.Contains(JsonCRDTDocument::DeferredConflict);
+	TMap<FString, int32, FDefaultSetAllocator, TJsonCRDTCaseSensitiveMapKeyFuncs<int32>> KeptReplaces;
+
+	// 남긴 작업은 패치가 끝까지 적용된 뒤 이 번호부터 차례로 히스토리에 들어감 (충돌 기록이 시퀀스 번호로 참조)
+	const uint64 FirstSequence = Core.GetOperationHistory().GetNextSequence();
+
+	// 남긴 작업별 충돌 색인과 이전 값 (로그용)
+	TArray<int32, TInlineAllocator<16>> KeptConflicts;
+	TArray<FString, TInlineAllocator<16>> KeptOldValues;
+	int32 NumKeptConflicts = 0;
+
+	TArray<FJsonCRDTOperation> InverseOperations;
+	int32 NumKept = 0;
+	for (int32 i = 0; i < Operations.Num(); ++i)
+	{
+		FJsonCRDTOperation& Operation = Operations[i];
+
+		int32 ConflictIndex = OperationConflicts.Num() > 0 ? OperationConflicts[i] : INDEX_NONE;
+		if (ConflictIndex == JsonCRDTDocument::DeferredConflict)
 		{
-			// 경로에서 현재 값 가져오기
-			TSharedPtr<FJsonValue> CurrentValue = GetValueAtPath(Content, Operation.Path);
-			if (CurrentValue.IsValid())
+			FJsonCRDTConflict Deferred;
+			ConflictIndex = INDEX_NONE;
+			const int32* EarlierIndex = KeptReplaces.Find(Operation.Path);
+			if (EarlierIndex ? JsonCRDTDocument::MakeConflict(Operations[*EarlierIndex], FirstSequence + *EarlierIndex, Operation, Deferred) : FindConflict(Operation, Deferred))
 			{
-				// 값을 문자열로 변환
-				TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OldValue);
-				FJsonSerializer::Serialize(CurrentValue.ToSharedRef(), Writer);
+				Deferred.bResolved = ResolveConflict(Deferred);
+				ConflictIndex = Conflicts.Add(MoveTemp(Deferred));
 			}
 		}
+		const FJsonCRDTConflict* Conflict = ConflictIndex != INDEX_NONE ? &Conflicts[ConflictIndex] : nullptr;
 
-		// 충돌 감지 및 해결
-		bool bHadConflict = false;
-		FJsonCRDTConflict Conflict;
+		bool bTreeChanged = false;
+		bool bSkipped = false;
+		FString OldValue;
+		const bool bApplied = bScalarBatch
+			? ApplyRemoteOperation(Operation, Conflict, BatchNodes[i], &BatchScalars[i], bTreeChanged, bSkipped, OldValue, InverseOperations)
+			: ApplyRemoteOperation(Operation, Conflict, INDEX_NONE, nullptr, bTreeChanged, bSkipped, OldValue, InverseOperations);
+
+		if (!bApplied)
+		{
+			// RFC 6902: 작업 하나가 실패하면 패치 전체를 적용하지 않음 (이미 적용된 작업은 역작업으로 되돌림)
+			Core.RollbackOperations(InverseOperations);
 
-		if (Operation.Type == EJsonCRDTOperationType::Replace)
+			SetLastErrorMessage(FString::Printf(TEXT("Failed to apply operation %d at path: %s"), i, *Operation.Path));
+			UE_LOG(LogTemp, Error, TEXT("%s"), *LastErrorMessage);
+			return false;
+		}
+
+		// 미리 찾은 노드가 무효화되었으면 남은 작업은 일반 경로로 적용
+		if (bTreeChanged)
 		{
-			// 같은 경로에 대한 로컬 작업이 있는지 확인
-			for (int32 i = OperationHistory.Num() - 1; i >= 0; --i)
+			bScalarBatch = false;
+		}
+
+		if (!bSkipped)
+		{
+			if (NumKept != i)
+			{
+				Operations[NumKept] = MoveTemp(Operation);
+			}
+			if (bHasDeferredConflicts && Operations[NumKept].Type == EJsonCRDTOperationType::Replace)
 			{
-				const FJsonCRDTOperation& LocalOperation = OperationHistory[i];
+				KeptReplaces.Add(Operations[NumKept].Path, NumKept);
+			}
 
-				// 같은 경로에 대한 Replace 작업인 경우 충돌 가능성 있음
-				if (LocalOperation.Path == Operation.Path &&
-					LocalOperation.Type == EJsonCRDTOperationType::Replace &&
-					LocalOperation.Value != Operation.Value)
-				{
-					// 충돌 정보 설정
-					Conflict.Path = Operation.Path;
-					Conflict.LocalValue = LocalOperation.Value;
-					Conflict.RemoteValue = Operation.Value;
-					Conflict.LocalOperation = LocalOperation;
-					Conflict.RemoteOperation = Operation;
-
-					// 충돌 해결
-					bHadConflict = true;
-
-					// 충돌 해결 시도
-					if (ResolveConflict(Conflict))
-					{
-						// 충돌이 해결되었으면 해결된 값으로 작업 수정
-						FJsonCRDTOperation ResolvedOperation = Operation;
-						ResolvedOperation.Value = Conflict.ResolvedValue;
+			KeptConflicts.Add(ConflictIndex);
+			KeptOldValues.Add(MoveTemp(OldValue));
+			if (Conflict)
+			{
+				Conflicts[ConflictIndex].RemoteSequence = static_cast<int64>(FirstSequence + NumKept);
+				++NumKeptConflicts;
+			}
+			++NumKept;
+		}
+	}
+	Operations.SetNum(NumKept, false);
+
+	// Remember the sender's sequence so a resend is skipped
+	Core.RecordPatchSequence(Patch);
+
+	// Nothing changed when every operation was rejected by the resolver, so there is no version, delta or journal record
+	if (NumKept == 0)
+	{
+		return true;
+	}
+
+	// Update the version
+	const int64 PreviousVersion = Core.AdvanceVersion();
+	INC_DWORD_STAT(STAT_JsonCRDT_PatchesApplied);
+
+	// Record the inverse delta; full snapshots are taken according to the snapshot policy
+	RecordChange(PreviousVersion, MoveTemp(InverseOperations), NumKept);
+	JournalChange(PreviousVersion, Operations);
 
-						// 해결된 작업 적용
-						ApplyOperation(ResolvedOperation);
+	// Notify that the document has changed, and path subscribers whose subtree was touched
+	TSet<int32> ChangedSubscriptions;
+	CollectChangedSubscriptions(Operations, ChangedSubscriptions);
 
-						// 충돌 이벤트 발생
-						OnConflictDetected.Broadcast(Conflict);
+	// 끝까지 적용된 작업만 히스토리와 작업 로그에 남김 (되돌린 패치의 작업은 이후 충돌 검사에 쓰이지 않음)
+	// 히스토리가 작업을 가져가고 변경 기록과 충돌 기록은 시퀀스 번호로 참조
+	for (int32 i = 0; i < NumKept; ++i)
+	{
+#if JSONCRDT_LOGGING_ENABLED
+		if (KeptConflicts[i] != INDEX_NONE)
+		{
+			const FJsonCRDTConflict& KeptConflict = Conflicts[KeptConflicts[i]];
+			LogOperation(Operations[i], KeptOldValues[i], KeptConflict.ResolvedValue, true, KeptConflict);
+		}
+		else
+		{
+			LogOperation(Operations[i], KeptOldValues[i], Operations[i].Value);
+		}
+#endif
+		Core.GetOperationHistory().Add(MoveTemp(Operations[i]));
+	}
+	AppendChangeLog(PreviousVersion, FirstSequence, NumKept);
 
-						// 작업 로깅
-						LogOperation(ResolvedOperation, OldValue, Conflict.ResolvedValue, true, Conflict);
+	// 적용한 충돌은 패치가 끝까지 적용된 뒤에만 셈하고 알림 (되돌린 패치의 충돌은 알리지 않음)
+	if (NumKeptConflicts > 0)
+	{
+		NumResolvedConflicts += NumKeptConflicts;
+		INC_DWORD_STAT_BY(STAT_JsonCRDT_ConflictsResolved, NumKeptConflicts);
 
-						// 작업 히스토리에 추가
-						OperationHistory.Add(ResolvedOperation);
-						if (OperationHistory.Num() > MaxOperationHistory)
-						{
-							OperationHistory.RemoveAt(0);
-						}
+		for (const int32 ConflictIndex : KeptConflicts)
+		{
+			if (ConflictIndex != INDEX_NONE)
+			{
+				OnConflictDetected.Broadcast(Conflicts[ConflictIndex]);
+			}
+		}
 
-						// 다음 작업으로 넘어감
-						continue;
+		if (OnConflictsDetected.IsBound())
+		{
+			TArray<FJsonCRDTConflict> AppliedConflictData;
+			if (NumKeptConflicts == Conflicts.Num())
+			{
+				AppliedConflictData = MoveTemp(Conflicts);
+			}
+			else
+			{
+				AppliedConflictData.Reserve(NumKeptConflicts);
+				for (const int32 ConflictIndex : KeptConflicts)
+				{
+					if (ConflictIndex != INDEX_NONE)
+					{
+						AppliedConflictData.Add(MoveTemp(Conflicts[ConflictIndex]));
 					}
 				}
 			}
+			OnConflictsDetected.Broadcast(Core.GetDocumentID(), AppliedConflictData);
 		}
+	}
 
-		// 충돌이 없거나 해결되지 않은 경우 일반적인 작업 적용
-		if (!bHadConflict)
-		{
-			// 새 값 가져오기 (로깅용)
-			FString NewValue = Operation.Value;
+	NotifyDocumentChanged(&ChangedSubscriptions);
+
+	return true;
+}
+
+bool UJsonCRDTDocument::ValidatePatch(const FJsonCRDTPatch& Patch, FString& OutError)
+{
+	if (Patch.DocumentID.IsEmpty())
+	{
+		OutError = TEXT("Patch has no document ID");
+		return false;
+	}
 
-			// 작업 적용
-			ApplyOperation(Operation);
+	for (int32 i = 0; i < Patch.Operations.Num(); ++i)
+	{
+		const FJsonCRDTOperation& Operation = Patch.Operations[i];
+		switch (Operation.Type)
+		{
+		case EJsonCRDTOperationType::Add:
+		case EJsonCRDTOperationType::Replace:
+		case EJsonCRDTOperationType::Test:
+		{
+			// Scalars are checked fully; containers only need to start like one, the apply parses them anyway
+			FJsonCRDTScalar Scalar;
+			if (!FJsonCRDTNodeStore::ParseScalar(Operation.Value, Scalar) && !JsonCRDTDocument::LooksLikeContainer(Operation.Value))
+			{
+				OutError = FString::Printf(TEXT("Operation %d at path %s has an invalid value"), i, *Operation.Path);
+				return false;
+			}
+			break;
+		}
 
-			// 작업 로깅
-			LogOperation(Operation, OldValue, NewValue);
+		case EJsonCRDTOperationType::Move:
+		case EJsonCRDTOperationType::Copy:
+			break;
 
-			// 작업 히스토리에 추가
-			OperationHistory.Add(Operation);
-			if (OperationHistory.Num() > MaxOperationHistory)
+		case EJsonCRDTOperationType::Remove:
+			if (FJsonCRDTPathCache::GetShared().Get(Operation.Path)->IsRoot())
 			{
-				OperationHistory.RemoveAt(0);
+				OutError = FString::Printf(TEXT("Operation %d removes the document root"), i);
+				return false;
 			}
+			break;
+
+		default:
+			OutError = FString::Printf(TEXT("Operation %d has an unknown type %d"), i, (int32)Operation.Type);
+			return false;
 		}
 	}
 
-	// Update the version
-	Version++;
+	return true;
+}
 
-	// Create a snapshot after applying a patch
-	CreateAndAddSnapshot();
+bool UJsonCRDTDocument::PrepareScalarReplaceBatch(const FJsonCRDTPatch& Patch, TArray<int32, TInlineAllocator<16>>& OutNodes, TArray<FJsonCRDTScalar, TInlineAllocator<16>>& OutScalars) const
+{
+	if (Patch.Operations.Num() == 0)
+	{
+		return false;
+	}
 
-	// Notify that the document has changed
-	NotifyDocumentChanged();
+	OutNodes.Reset(Patch.Operations.Num());
+	OutScalars.Reset(Patch.Operations.Num());
+
+	for (const FJsonCRDTOperation& Operation : Patch.Operations)
+	{
+		if (Operation.Type != EJsonCRDTOperationType::Replace)
+		{
+			return false;
+		}
+
+		const int32 NodeIndex = Core.FindNodeAtPath(Operation.Path);
+		if (NodeIndex == INDEX_NONE || Core.GetContent().GetNode(NodeIndex).IsContainer())
+		{
+			return false;
+		}
+
+		FJsonCRDTScalar& Scalar = OutScalars.AddDefaulted_GetRef();
+		if (!FJsonCRDTNodeStore::ParseScalar(Operation.Value, Scalar))
+		{
+			return false;
+		}
+
+		OutNodes.Add(NodeIndex);
+	}
 
 	return true;
 }
 
-void UJsonCRDTDocument::ApplyOperation(const FJsonCRDTOperation& Operation)
+bool UJsonCRDTDocument::ApplyRemoteOperation(FJsonCRDTOperation& Operation, const FJsonCRDTConflict* Conflict, int32 KnownNode, const FJsonCRDTScalar* KnownScalar, bool& bOutTreeChanged, bool& bOutSkipped, FString& OutOldValue, TArray<FJsonCRDTOperation>& OutInverse)
 {
-	// Apply the operation based on its type
-	switch (Operation.Type)
+	bOutTreeChanged = false;
+	bOutSkipped = false;
+
+	// 현재 값 가져오기 (로깅 및 충돌 해결용)
+	if (Operation.Type == EJsonCRDTOperationType::Replace ||
+		Operation.Type == EJsonCRDTOperationType::Remove ||
+		Operation.Type == EJsonCRDTOperationType::Test)
 	{
-	case EJsonCRDTOperationType::Add:
-		// Add a value at the specified path
-		// Implementation depends on the path format and structure
-		break;
+		// 경로에서 현재 값 가져오기
+		const int32 CurrentNode = KnownNode != INDEX_NONE ? KnownNode : Core.FindNodeAtPath(Operation.Path);
+		if (CurrentNode != INDEX_NONE)
+		{
+			// 값을 문자열로 변환
+			OutOldValue = Core.GetContent().NodeToString(CurrentNode);
+		}
+	}
 
-	case EJsonCRDTOperationType::Remove:
-		// Remove a value at the specified path
-		break;
+	// 해결되지 않은 충돌의 원격 작업은 적용하지 않음
+	FJsonCRDTScalar ResolvedScalar;
+	if (Conflict)
+	{
+		if (!Conflict->bResolved)
+		{
+			bOutSkipped = true;
+			return true;
+		}
 
-	case EJsonCRDTOperationType::Replace:
-		// Replace a value at the specified path
-		break;
+		// 해결된 값으로 작업을 제자리에서 수정 (해결된 값도 스칼라면 제자리 갱신)
+		Operation.Value = Conflict->ResolvedValue;
+		if (KnownScalar)
+		{
+			KnownScalar = FJsonCRDTNodeStore::ParseScalar(Operation.Value, ResolvedScalar) ? &ResolvedScalar : nullptr;
+		}
+	}
 
-	case EJsonCRDTOperationType::Move:
-		// Move a value from one path to another
-		break;
+	// 작업 적용
+	bool bApplied;
+	if (KnownScalar)
+	{
+		bApplied = Core.GetContent().SetScalar(KnownNode, *KnownScalar, Operation.Timestamp.GetTicks());
+		if (bApplied)
+		{
+			OutInverse.Add(FJsonCRDTOperationApplier::MakeInverse(Operation, EJsonCRDTOperationType::Replace, Operation.Path, OutOldValue));
+		}
+	}
+	else
+	{
+		bApplied = Core.ApplyOperation(Operation, &OutInverse);
+		bOutTreeChanged = true;
+	}
+
+	// 히스토리와 로그에는 호출한 쪽이 패치 전체가 적용된 뒤에 넣음
+	return bApplied;
+}
+
+bool UJsonCRDTDocument::ApplyPatchFromString(const FString& PatchString)
+{
+	// Single pass over the text, without an intermediate FJsonObject or reflection
+	FJsonCRDTPatch Patch;
+	FString Error;
+	if (!FJsonCRDTPatchParser::Parse(PatchString, FJsonCRDTPatchParser::EFormat::Struct, Patch, nullptr, &Error))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to parse patch: %s"), *Error);
+		return false;
+	}
+	return ApplyPatch(Patch);
+}
+
+bool UJsonCRDTDocument::ApplyLocalOperation(const FJsonCRDTOperation& Operation)
+{
+	return ApplyLocalOperations(TArray<FJsonCRDTOperation>{ Operation });
+}
+
+bool UJsonCRDTDocument::ApplyLocalOperations(const TArray<FJsonCRDTOperation>& Operations)
+{
+	if (Operations.Num() == 0)
+	{
+		return true;
+	}
+
+	const FDateTime Now = FDateTime::UtcNow();
+	MaterializeContent();
+
+	TArray<FJsonCRDTOperation> Applied(Operations);
+	for (FJsonCRDTOperation& Operation : Applied)
+	{
+		if (Operation.Timestamp.GetTicks() == 0)
+		{
+			Operation.Timestamp = Now;
+		}
+	}
+
+	// Apply everything first so that a failing operation leaves neither content nor queue changed
+	TArray<bool, TInlineAllocator<16>> CreatesValue;
+	TArray<FJsonCRDTOperation> InverseOperations;
+	const int32 FailedIndex = Core.ApplyOperationsAtomically(Applied, InverseOperations, &CreatesValue);
+	if (FailedIndex != INDEX_NONE)
+	{
+		SetLastErrorMessage(FString::Printf(TEXT("Failed to apply local operation %d at path: %s"), FailedIndex, *Applied[FailedIndex].Path));
+		UE_LOG(LogTemp, Error, TEXT("%s"), *LastErrorMessage);
+		return false;
+	}
+
+	const int64 PreviousVersion = Core.AdvanceVersion();
+
+	JournalChange(PreviousVersion, Applied);
+
+	TSet<int32> ChangedSubscriptions;
+	CollectChangedSubscriptions(Applied, ChangedSubscriptions);
+
+	// The pending queue must keep unsent operations after the bounded history drops them, so it gets its own copy;
+	// the change log refers to the history entries
+	const uint64 FirstSequence = Core.GetOperationHistory().GetNextSequence();
+	for (int32 i = 0; i < Applied.Num(); ++i)
+	{
+		Core.GetOperationHistory().Add(Applied[i]);
+		PendingOperations.Add(MoveTemp(Applied[i]), CreatesValue[i], PreviousVersion);
+	}
+	AppendChangeLog(PreviousVersion, FirstSequence, Applied.Num());
+
+	RecordChange(PreviousVersion, MoveTemp(InverseOperations), Operations.Num());
+	NotifyDocumentChanged(&ChangedSubscriptions);
+
+	return true;
+}
+
+int32 UJsonCRDTDocument::GetNumPendingOperations() const
+{
+	return PendingOperations.Num();
+}
+
+bool UJsonCRDTDocument::TakePendingPatch(FJsonCRDTPatch& OutPatch)
+{
+	OutPatch.DocumentID = Core.GetDocumentID();
+	OutPatch.Timestamp = FDateTime::UtcNow();
+	if (!PendingOperations.Take(OutPatch.Operations, OutPatch.BaseVersion))
+	{
+		return false;
+	}
+
+	OutPatch.Sequence = ++LocalPatchSequence;
+	return true;
+}
+
+FJsonCRDTPatch UJsonCRDTDocument::MakeSyncRequest() const
+{
+	FJsonCRDTPatch Request;
+	Request.DocumentID = Core.GetDocumentID();
+	Request.BaseVersion = Core.GetVersion();
+	Request.Timestamp = FDateTime::UtcNow();
+	Request.VersionVector.Reserve(Core.GetVersionVector().Num());
+	for (const TPair<FString, int64>& Entry : Core.GetVersionVector())
+	{
+		Request.VersionVector.Add(Entry.Key, Entry.Value);
+	}
+	return Request;
+}
+
+void UJsonCRDTDocument::RequeuePendingPatch(FJsonCRDTPatch&& Patch)
+{
+	PendingOperations.Requeue(MoveTemp(Patch.Operations), Patch.BaseVersion);
+}
+
+bool UJsonCRDTDocument::GetChangesSince(int32 Generation, int64 SinceVersion, TArray<FJsonCRDTOperation>& OutOperations) const
+{
+	if (Generation != ChangeLogGeneration || SinceVersion < ChangeLogStartVersion || SinceVersion > Core.GetVersion())
+	{
+		return false;
+	}
+
+	// Records are contiguous from the start version, so everything from the first matching record on is needed
+	for (const FChangeLogRecord& Record : ChangeLog)
+	{
+		if (Record.BaseVersion < SinceVersion)
+		{
+			continue;
+		}
+
+		// Once the history has dropped an operation the delta can no longer be built, and a full save is needed
+		if (Record.FirstSequence < Core.GetOperationHistory().GetOldestSequence())
+		{
+			OutOperations.Reset();
+			return false;
+		}
+
+		for (int32 i = 0; i < Record.NumOperations; ++i)
+		{
+			Core.GetOperationHistory().CopyBySequence(Record.FirstSequence + i, OutOperations.AddDefaulted_GetRef());
+		}
+	}
+	return true;
+}
+
+void UJsonCRDTDocument::DiscardChangesBefore(int64 InVersion)
+{
+	int32 NumDiscarded = 0;
+	while (NumDiscarded < ChangeLog.Num() && ChangeLog[NumDiscarded].BaseVersion < InVersion)
+	{
+		NumChangeLogOperations -= ChangeLog[NumDiscarded].NumOperations;
+		++NumDiscarded;
+	}
+
+	if (NumDiscarded > 0)
+	{
+		ChangeLog.RemoveAt(0, NumDiscarded);
+		ChangeLogStartVersion = FMath::Min(InVersion, Core.GetVersion());
+	}
+}
+
+void UJsonCRDTDocument::AppendChangeLog(int64 PreviousVersion, uint64 FirstSequence, int32 NumOperations)
+{
+	// Past the limit a full save is cheaper than replaying the log, so give up on the current run
+	if (NumChangeLogOperations + NumOperations > JsonCRDTDocument::MaxChangeLogOperations)
+	{
+		ResetChangeLog();
+		return;
+	}
+
+	FChangeLogRecord& Record = ChangeLog.AddDefaulted_GetRef();
+	Record.BaseVersion = PreviousVersion;
+	Record.FirstSequence = FirstSequence;
+	Record.NumOperations = NumOperations;
+	NumChangeLogOperations += NumOperations;
+}
+
+void UJsonCRDTDocument::ResetChangeLog()
+{
+	ChangeLog.Reset();
+	ChangeLogStartVersion = Core.GetVersion();
+	NumChangeLogOperations = 0;
+	++ChangeLogGeneration;
+}
+
+FJsonCRDTSnapshot UJsonCRDTDocument::CreateSnapshot() const
+{
+	FJsonCRDTSnapshot Snapshot;
+	Snapshot.DocumentID = Core.GetDocumentID();
+	Snapshot.Version = Core.GetVersion();
+	Snapshot.Timestamp = FDateTime::UtcNow();
+	Snapshot.Content = GetContentAsString();
+	return Snapshot;
+}
+
+bool UJsonCRDTDocument::RestoreFromSnapshot(const FJsonCRDTSnapshot& Snapshot)
+{
+	// Validate the snapshot
+	if (Snapshot.DocumentID != Core.GetDocumentID())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Snapshot document ID does not match: %s != %s"), *Snapshot.DocumentID, *Core.GetDocumentID());
+		return false;
+	}
+
+	// A snapshot without content refers to a version retained in the delta history
+	if (Snapshot.Content.IsEmpty())
+	{
+		return RestoreToVersion(Snapshot.Version);
+	}
+
+	// Restore the content from the snapshot
+	FJsonCRDTNodeStore RestoredContent;
+	if (!RestoredContent.LoadFromString(Snapshot.Content))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to restore content from snapshot"));
+		return false;
+	}
+
+	// The snapshot replaces the content, so a mapped base file no longer needs to be decoded
+	MappedContent.Reset();
+	Core.SetContent(MoveTemp(RestoredContent));
+
+	// Update the version
+	Core.SetVersion(Snapshot.Version);
+
+	// The restored state does not follow from the current delta chain, so start a new base from it
+	ResetDeltaHistory();
+	DiscardHistoryAfter(Core.GetVersion() - 1);
+	AddSnapshot(Snapshot);
+	OperationsSinceSnapshot = 0;
+	LastSnapshotTime = FPlatformTime::Seconds();
+	InvalidateLocalJournal();
+	ResetChangeLog();
+
+	// Notify that the document has changed
+	NotifyDocumentChanged();
+
+	return true;
+}
+
+bool UJsonCRDTDocument::RestoreToVersion(int64 TargetVersion)
+{
+	if (TargetVersion == Core.GetVersion())
+	{
+		return true;
+	}
+
+	// Rewind a copy of the current content first; fall back to the nearest newer full snapshot
+	// when the delta chain from the current version does not reach the target
+	MaterializeContent();
+	FJsonCRDTNodeStore Working = Core.GetContent();
+	int32 FirstDeltaIndex = INDEX_NONE;
+	bool bRestored = RewindStore(Working, Core.GetVersion(), TargetVersion, FirstDeltaIndex);
+
+	if (!bRestored)
+	{
+		TArray<const FJsonCRDTSnapshot*, TInlineAllocator<8>> Candidates;
+		for (const FJsonCRDTSnapshot& Snapshot : SnapshotHistory)
+		{
+			if (Snapshot.Version >= TargetVersion)
+			{
+				Candidates.Add(&Snapshot);
+			}
+		}
+		Candidates.Sort([](const FJsonCRDTSnapshot& A, const FJsonCRDTSnapshot& B) { return A.Version < B.Version; });
+
+		for (const FJsonCRDTSnapshot* Snapshot : Candidates)
+		{
+			if (Working.LoadFromString(Snapshot->Content) && RewindStore(Working, Snapshot->Version, TargetVersion, FirstDeltaIndex))
+			{
+				bRestored = true;
+				break;
+			}
+		}
+	}
+
+	if (!bRestored)
+	{
+		SetLastErrorMessage(FString::Printf(TEXT("Version %lld is not retained in the snapshot history"), TargetVersion));
+		UE_LOG(LogTemp, Error, TEXT("%s"), *LastErrorMessage);
+		return false;
+	}
+
+	Core.SetContent(MoveTemp(Working));
+	Core.SetVersion(TargetVersion);
+
+	// Versions after the target no longer describe the document
+	DiscardHistoryAfter(TargetVersion);
+	OperationsSinceSnapshot = 1;
+	LastChangeTime = FPlatformTime::Seconds();
+
+	// Journal records after the target no longer apply
+	InvalidateLocalJournal();
+	ResetChangeLog();
+
+	// Notify that the document has changed
+	NotifyDocumentChanged();
+
+	return true;
+}
+
+void UJsonCRDTDocument::SetSnapshotPolicy(const FJsonCRDTSnapshotPolicy& InPolicy)
+{
+	SnapshotPolicy = InPolicy;
+}
+
+FJsonCRDTSnapshotPolicy UJsonCRDTDocument::GetSnapshotPolicy() const
+{
+	return SnapshotPolicy;
+}
+
+void UJsonCRDTDocument::TickSnapshotPolicy(double CurrentTime)
+{
+	if (OperationsSinceSnapshot == 0)
+	{
+		return;
+	}
+
+	const bool bIntervalElapsed = SnapshotPolicy.IntervalSeconds > 0.0f && CurrentTime - LastSnapshotTime >= SnapshotPolicy.IntervalSeconds;
+	const bool bIdle = SnapshotPolicy.IdleSeconds > 0.0f && CurrentTime - LastChangeTime >= SnapshotPolicy.IdleSeconds;
+	if (bIntervalElapsed || bIdle)
+	{
+		CreateAndAddSnapshot();
+	}
+}
+
+void UJsonCRDTDocument::Save()
+{
+	if (SyncManager)
+	{
+		SyncManager->SaveDocument(this);
+	}
+}
+
+void UJsonCRDTDocument::Sync()
+{
+	if (SyncManager)
+	{
+		SyncManager->SyncDocument(this);
+	}
+}
+
+void UJsonCRDTDocument::CreateAndAddSnapshot()
+{
+	JSONCRDT_SCOPE_CYCLE_COUNTER(STAT_JsonCRDT_CreateAndAddSnapshot);
+
+	AddSnapshot(CreateSnapshot());
+	OperationsSinceSnapshot = 0;
+	LastSnapshotTime = FPlatformTime::Seconds();
+
+	// Trim the snapshot history if needed
+	const int32 MaxFullSnapshots = FMath::Max(1, SnapshotPolicy.MaxFullSnapshots);
+	if (SnapshotHistory.Num() > MaxFullSnapshots)
+	{
+		const int32 NumTrimmed = SnapshotHistory.Num() - MaxFullSnapshots;
+		for (int32 i = 0; i < NumTrimmed; ++i)
+		{
+			HistoryBytes -= JsonCRDTDocument::GetSnapshotSize(SnapshotHistory[i]);
+		}
+		SnapshotHistory.RemoveAt(0, NumTrimmed);
+	}
+}
+
+void UJsonCRDTDocument::AddSnapshot(const FJsonCRDTSnapshot& Snapshot)
+{
+	HistoryBytes += JsonCRDTDocument::GetSnapshotSize(SnapshotHistory.Add_GetRef(Snapshot));
+}
+
+void UJsonCRDTDocument::ResetDeltaHistory()
+{
+	for (const FJsonCRDTSnapshotDelta& Delta : DeltaHistory)
+	{
+		HistoryBytes -= JsonCRDTDocument::GetDeltaSize(Delta);
+	}
+	DeltaHistory.Reset();
+}
+
+void UJsonCRDTDocument::RecordChange(int64 PreviousVersion, TArray<FJsonCRDTOperation>&& InverseOperations, int32 NumOperations)
+{
+	// Inverse operations are collected in forward order; undoing applies them last to first
+	Algo::Reverse(InverseOperations);
+
+	FJsonCRDTSnapshotDelta& Delta = DeltaHistory.AddDefaulted_GetRef();
+	Delta.PreviousVersion = PreviousVersion;
+	Delta.Version = Core.GetVersion();
+	Delta.InverseOperations = MoveTemp(InverseOperations);
+	HistoryBytes += JsonCRDTDocument::GetDeltaSize(Delta);
+
+	// Trim in batches so that the front of the array is not shifted on every change
+	const int32 MaxDeltaVersions = FMath::Max(0, SnapshotPolicy.MaxDeltaVersions);
+	if (DeltaHistory.Num() > MaxDeltaVersions + FMath::Max(1, MaxDeltaVersions / 8))
+	{
+		const int32 NumTrimmed = DeltaHistory.Num() - MaxDeltaVersions;
+		for (int32 i = 0; i < NumTrimmed; ++i)
+		{
+			HistoryBytes -= JsonCRDTDocument::GetDeltaSize(DeltaHistory[i]);
+		}
+		DeltaHistory.RemoveAt(0, NumTrimmed);
+	}
+
+	OperationsSinceSnapshot += NumOperations;
+	LastChangeTime = FPlatformTime::Seconds();
+
+	if (SnapshotPolicy.OperationsPerSnapshot > 0 && OperationsSinceSnapshot >= SnapshotPolicy.OperationsPerSnapshot)
+	{
+		CreateAndAddSnapshot();
+	}
+}
+
+void UJsonCRDTDocument::DiscardHistoryAfter(int64 InVersion)
+{
+	DeltaHistory.RemoveAll([this, InVersion](const FJsonCRDTSnapshotDelta& Delta)
+	{
+		if (Delta.Version <= InVersion)
+		{
+			return false;
+		}
+		HistoryBytes -= JsonCRDTDocument::GetDeltaSize(Delta);
+		return true;
+	});
+	SnapshotHistory.RemoveAll([this, InVersion](const FJsonCRDTSnapshot& Snapshot)
+	{
+		if (Snapshot.Version <= InVersion)
+		{
+			return false;
+		}
+		HistoryBytes -= JsonCRDTDocument::GetSnapshotSize(Snapshot);
+		return true;
+	});
+}
+
+bool UJsonCRDTDocument::RewindStore(FJsonCRDTNodeStore& Store, int64 FromVersion, int64 TargetVersion, int32& OutFirstDeltaIndex) const
+{
+	int64 CurrentVersion = FromVersion;
+	for (int32 i = DeltaHistory.Num() - 1; i >= 0 && CurrentVersion != TargetVersion; --i)
+	{
+		const FJsonCRDTSnapshotDelta& Delta = DeltaHistory[i];
+		if (Delta.Version != CurrentVersion)
+		{
+			continue;
+		}
+
+		for (const FJsonCRDTOperation& Inverse : Delta.InverseOperations)
+		{
+			if (!Core.ApplyOperationToStore(Store, Inverse, nullptr))
+			{
+				return false;
+			}
+		}
+
+		CurrentVersion = Delta.PreviousVersion;
+		OutFirstDeltaIndex = i;
+	}
+
+	return CurrentVersion == TargetVersion;
+}
+
+int32 UJsonCRDTDocument::Subscribe(const FString& Path, FOnPathChanged Callback)
+{
+	const int32 Handle = NextSubscriptionHandle++;
+	FPathSubscription& Subscription = PathSubscriptions.Add(Handle);
+	Subscription.Path = Path;
+	Subscription.Callback = MoveTemp(Callback);
+
+	SubscriptionTrie.Add(*Core.GetPathCache().Get(Path), Handle);
+	return Handle;
+}
+
+void UJsonCRDTDocument::Unsubscribe(int32 SubscriptionHandle)
+{
+	FPathSubscription Subscription;
+	if (PathSubscriptions.RemoveAndCopyValue(SubscriptionHandle, Subscription))
+	{
+		SubscriptionTrie.Remove(*Core.GetPathCache().Get(Subscription.Path), SubscriptionHandle);
+	}
+}
+
+void UJsonCRDTDocument::CollectChangedSubscriptions(const TArray<FJsonCRDTOperation>& Operations, TSet<int32>& OutHandles) const
+{
+	if (SubscriptionTrie.IsEmpty())
+	{
+		return;
+	}
+
+	for (const FJsonCRDTOperation& Operation : Operations)
+	{
+		if (Operation.Type == EJsonCRDTOperationType::Test)
+		{
+			continue;
+		}
+
+		// A move changes both ends; a copy only its target
+		const FString* Paths[] = { &Operation.Path, Operation.Type == EJsonCRDTOperationType::Move ? &Operation.FromPath : nullptr };
+		for (const FString* PathString : Paths)
+		{
+			if (!PathString)
+			{
+				continue;
+			}
+
+			const TSharedRef<const FJsonCRDTPath, ESPMode::ThreadSafe> Path = Core.GetPathCache().Get(*PathString);
+			const int32 NumTokens = Path->Num();
+
+			// Inserting or removing an array element shifts the elements after it
+			if (Operation.Type != EJsonCRDTOperationType::Replace && NumTokens > 0 && Path->GetArrayIndex(NumTokens - 1) != INDEX_NONE)
+			{
+				const int32 ArrayNode = Core.GetContent().ResolvePrefix(*Path, NumTokens - 1);
+				if (ArrayNode != INDEX_NONE && Core.GetContent().GetNode(ArrayNode).Type == EJsonCRDTNodeType::Array)
+				{
+					const int32 ArrayIndex = Path->GetArrayIndex(NumTokens - 1);
+					const int32 FirstIndex = ArrayIndex == FJsonCRDTPath::AppendIndex
+						? FMath::Max(Core.GetContent().GetNode(ArrayNode).Children.Num() - 1, 0)
+						: ArrayIndex;
+					SubscriptionTrie.CollectArrayShift(*Path, NumTokens - 1, FirstIndex, OutHandles);
+					continue;
+				}
+			}
+
+			SubscriptionTrie.CollectAffected(*Path, NumTokens, OutHandles);
+		}
+	}
+}
+
+void UJsonCRDTDocument::NotifyDocumentChanged(const TSet<int32>* ChangedSubscriptions)
+{
+	OnDocumentChanged.Broadcast(Core.GetDocumentID());
+
+	// Resolve the values first: callbacks may change the document or the subscriptions
+	if (PathSubscriptions.Num() > 0 && (!ChangedSubscriptions || ChangedSubscriptions->Num() > 0))
+	{
+		TArray<int32, TInlineAllocator<8>> Handles;
+		if (ChangedSubscriptions)
+		{
+			for (int32 Handle : *ChangedSubscriptions)
+			{
+				Handles.Add(Handle);
+			}
+		}
+		else
+		{
+			PathSubscriptions.GenerateKeyArray(Handles);
+		}
+
+		TArray<TPair<int32, FString>, TInlineAllocator<8>> Changed;
+		for (int32 Handle : Handles)
+		{
+			FString Value;
+			GetValueAtPath(PathSubscriptions[Handle].Path, Value);
+			Changed.Emplace(Handle, MoveTemp(Value));
+		}
+
+		for (const TPair<int32, FString>& Entry : Changed)
+		{
+			// Copy the subscription in case the callback unsubscribes while it runs
+			const FPathSubscription* Subscription = PathSubscriptions.Find(Entry.Key);
+			if (Subscription)
+			{
+				const FPathSubscription Current = *Subscription;
+				Current.Callback.ExecuteIfBound(Current.Path, Entry.Value);
+			}
+		}
+	}
+
+	// Auto-save locally if enabled; bursts of changes are written once
+	if (bAutoLocalSave)
+	{
+		RequestLocalSave();
+	}
+}
+
+bool UJsonCRDTDocument::SaveLocally()
+{
+	JSONCRDT_SCOPE_CYCLE_COUNTER(STAT_JsonCRDT_SaveLocally);
+
+	// A direct save also satisfies any pending debounced request
+	bLocalSaveRequested = false;
+
+	// The base file may be the mapped one; decode it and release the mapping so the file can be replaced
+	MaterializeContent();
+
+	// Get the local storage path
+	FString FilePath = GetLocalStoragePath();
+
+	if (LocalStorageFormat == EJsonCRDTLocalStorageFormat::Binary)
+	{
+		FJsonCRDTBinaryDocument::FHeader Header;
+		Header.DocumentID = Core.GetDocumentID();
+		Header.Version = Core.GetVersion();
+		Header.Timestamp = FDateTime::UtcNow();
+
+		// A snapshot of the current version is the content itself and is not stored twice
+		if (SnapshotHistory.Num() > 0)
+		{
+			const FJsonCRDTSnapshot& LatestSnapshot = SnapshotHistory.Last();
+			const bool bSnapshotIsContent = LatestSnapshot.Version == Core.GetVersion();
+			if (bSnapshotIsContent || !LatestSnapshot.Content.IsEmpty())
+			{
+				Header.bHasSnapshot = true;
+				Header.Snapshot.Version = LatestSnapshot.Version;
+				Header.Snapshot.Timestamp = LatestSnapshot.Timestamp;
+				if (!bSnapshotIsContent)
+				{
+					Header.Snapshot.Content = LatestSnapshot.Content;
+				}
+			}
+		}
 
-	case EJsonCRDTOperationType::Copy:
-		// Copy a value from one path to another
-		break;
+		TArray<uint8> SaveBytes;
+		FJsonCRDTBinaryDocument::Encode(Header, Core.GetContent(), SaveBytes);
+		FJsonCRDTLocalStorageWriter::Get().Write(FilePath, MoveTemp(SaveBytes), GetLocalJournalPath());
+	}
+	else
+	{
+		// Write the document data directly from the node store (no intermediate FJsonObject tree)
+		FString SaveString;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&SaveString);
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("documentId"), Core.GetDocumentID());
+		Writer->WriteValue(TEXT("version"), Core.GetVersion());
+		Writer->WriteValue(TEXT("timestamp"), FDateTime::UtcNow().ToString());
+
+		static const FString ContentField(TEXT("content"));
+		Core.GetContent().WriteNode(Core.GetContent().GetRoot(), Writer, &ContentField);
+
+		// Add the latest snapshot
+		if (SnapshotHistory.Num() > 0)
+		{
+			const FJsonCRDTSnapshot& LatestSnapshot = SnapshotHistory.Last();
+			Writer->WriteObjectStart(TEXT("latestSnapshot"));
+			Writer->WriteValue(TEXT("documentId"), LatestSnapshot.DocumentID);
+			Writer->WriteValue(TEXT("version"), LatestSnapshot.Version);
+			Writer->WriteValue(TEXT("timestamp"), LatestSnapshot.Timestamp.ToString());
+			Writer->WriteValue(TEXT("content"), LatestSnapshot.Content);
+			Writer->WriteObjectEnd();
+		}
 
-	case EJsonCRDTOperationType::Test:
-		// Test if a value at the specified path equals the given value
-		break;
+		Writer->WriteObjectEnd();
+		if (!Writer->Close())
+		{
+			SetLastErrorMessage(TEXT("Failed to serialize document data"));
+			UE_LOG(LogTemp, Error, TEXT("%s"), *LastErrorMessage);
+			return false;
+		}
 
-	default:
-		UE_LOG(LogTemp, Error, TEXT("Unknown operation type: %d"), (int32)Operation.Type);
-		break;
+		// Hand the string to the background writer (temp file + rename, directories created as needed)
+		FJsonCRDTLocalStorageWriter::Get().Write(FilePath, MoveTemp(SaveString), GetLocalJournalPath());
 	}
+
+	// The new base file contains every journaled change, so the journal is removed once it is written
+	PendingJournal.Reset();
+	LocalJournalSize = 0;
+	bLocalJournalValid = true;
+
+	UE_LOG(LogTemp, Verbose, TEXT("Document %s queued for local save to %s"), *Core.GetDocumentID(), *FilePath);
+	return true;
 }
 
-bool UJsonCRDTDocument::ApplyPatchFromString(const FString& PatchString)
+void UJsonCRDTDocument::RequestLocalSave()
 {
-	FJsonCRDTPatch Patch;
-	if (FJsonObjectConverter::JsonObjectStringToUStruct(PatchString, &Patch, 0, 0))
+	const double CurrentTime = FPlatformTime::Seconds();
+	if (!bLocalSaveRequested)
 	{
-		return ApplyPatch(Patch);
+		bLocalSaveRequested = true;
+		FirstLocalSaveRequestTime = CurrentTime;
 	}
-	return false;
+	LastLocalSaveRequestTime = CurrentTime;
 }
 
-FJsonCRDTSnapshot UJsonCRDTDocument::CreateSnapshot() const
+bool UJsonCRDTDocument::HasUnsavedLocalChanges() const
 {
-	FJsonCRDTSnapshot Snapshot;
-	Snapshot.DocumentID = DocumentID;
-	Snapshot.Version = Version;
-	Snapshot.Timestamp = FDateTime::UtcNow();
-	Snapshot.Content = GetContentAsString();
-	return Snapshot;
+	return bLocalSaveRequested;
 }
 
-bool UJsonCRDTDocument::RestoreFromSnapshot(const FJsonCRDTSnapshot& Snapshot)
+void UJsonCRDTDocument::TickLocalSave(double CurrentTime, double DebounceSeconds, double MaxDelaySeconds)
 {
-	// Validate the snapshot
-	if (Snapshot.DocumentID != DocumentID)
+	if (!bLocalSaveRequested)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Snapshot document ID does not match: %s != %s"), *Snapshot.DocumentID, *DocumentID);
-		return false;
+		return;
 	}
 
-	// Restore the content from the snapshot
-	if (!SetContentFromString(Snapshot.Content))
+	// Wait for the burst of changes to settle, but never longer than the maximum delay
+	if (CurrentTime - LastLocalSaveRequestTime >= DebounceSeconds || CurrentTime - FirstLocalSaveRequestTime >= MaxDelaySeconds)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to restore content from snapshot"));
-		return false;
+		// Append only what changed since the last save; rewrite the base file when the journal cannot take it
+		if (!AppendLocalJournal())
+		{
+			SaveLocally();
+		}
 	}
-
-	// Update the version
-	Version = Snapshot.Version;
-
-	// Notify that the document has changed
-	NotifyDocumentChanged();
-
-	return true;
 }
 
-void UJsonCRDTDocument::Save()
+void UJsonCRDTDocument::SetLocalStorageFormat(EJsonCRDTLocalStorageFormat Format)
 {
-	if (SyncManager)
+	if (LocalStorageFormat == Format)
 	{
-		SyncManager->SaveDocument(this);
+		return;
 	}
+
+	// The journal continues the base file of the previous format, so the next save writes a new base
+	LocalStorageFormat = Format;
+	InvalidateLocalJournal();
 }
 
-void UJsonCRDTDocument::Sync()
+EJsonCRDTLocalStorageFormat UJsonCRDTDocument::GetLocalStorageFormat() const
 {
-	if (SyncManager)
-	{
-		SyncManager->SyncDocument(this);
-	}
+	return LocalStorageFormat;
 }
 
-void UJsonCRDTDocument::CreateAndAddSnapshot()
+void UJsonCRDTDocument::SetMaxLocalJournalSize(int32 MaxBytes)
 {
-	FJsonCRDTSnapshot Snapshot = CreateSnapshot();
-	SnapshotHistory.Add(Snapshot);
+	MaxLocalJournalSize = FMath::Max(MaxBytes, 0);
+}
 
-	// Trim the snapshot history if needed
-	if (SnapshotHistory.Num() > MaxSnapshotHistory)
+int32 UJsonCRDTDocument::GetMaxLocalJournalSize() const
+{
+	return MaxLocalJournalSize;
+}
+
+void UJsonCRDTDocument::JournalChange(int64 PreviousVersion, TArray<FJsonCRDTOperation>& Operations)
+{
+	if (!bLocalJournalValid)
 	{
-		SnapshotHistory.RemoveAt(0, SnapshotHistory.Num() - MaxSnapshotHistory);
+		return;
 	}
+
+	// Borrow the operations for encoding instead of copying them into the record
+	FJsonCRDTPatch Record;
+	Record.DocumentID = Core.GetDocumentID();
+	Record.BaseVersion = PreviousVersion;
+	Record.Timestamp = FDateTime::UtcNow();
+	Record.Operations = MoveTemp(Operations);
+	FJsonCRDTJournal::AppendRecord(Record, PendingJournal);
+	Operations = MoveTemp(Record.Operations);
 }
 
-void UJsonCRDTDocument::NotifyDocumentChanged()
+void UJsonCRDTDocument::InvalidateLocalJournal()
 {
-	OnDocumentChanged.Broadcast(DocumentID);
+	bLocalJournalValid = false;
+	PendingJournal.Reset();
+}
 
-	// Auto-save locally if enabled
-	if (bAutoLocalSave)
+bool UJsonCRDTDocument::AppendLocalJournal()
+{
+	if (!bLocalJournalValid || LocalJournalSize + PendingJournal.Num() > MaxLocalJournalSize)
 	{
-		SaveLocally();
+		return false;
 	}
+
+	bLocalSaveRequested = false;
+	LocalJournalSize += PendingJournal.Num();
+	FJsonCRDTLocalStorageWriter::Get().Append(GetLocalJournalPath(), MoveTemp(PendingJournal));
+	PendingJournal.Reset();
+	return true;
 }
 
-bool UJsonCRDTDocument::SaveLocally()
+int32 UJsonCRDTDocument::ReplayLocalJournal(bool& bOutNeedsCompaction)
 {
-	// Get the local storage path
-	FString FilePath = GetLocalStoragePath();
+	bOutNeedsCompaction = false;
 
-	// Create the directory if it doesn't exist
-	FString DirectoryPath = FPaths::GetPath(FilePath);
+	TArray<uint8> JournalBytes;
+	const FString JournalPath = GetLocalJournalPath();
 	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-	if (!PlatformFile.DirectoryExists(*DirectoryPath))
+	if (!PlatformFile.FileExists(*JournalPath) || !FFileHelper::LoadFileToArray(JournalBytes, *JournalPath))
 	{
-		if (!PlatformFile.CreateDirectoryTree(*DirectoryPath))
-		{
-			SetLastErrorMessage(FString::Printf(TEXT("Failed to create directory: %s"), *DirectoryPath));
-			UE_LOG(LogTemp, Error, TEXT("%s"), *LastErrorMessage);
-			return false;
-		}
+		return 0;
 	}
 
-	// Create a JSON object to store the document data
-	TSharedPtr<FJsonObject> SaveData = MakeShared<FJsonObject>();
-	SaveData->SetStringField(TEXT("documentId"), DocumentID);
-	SaveData->SetNumberField(TEXT("version"), Version);
-	SaveData->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToString());
-	SaveData->SetObjectField(TEXT("content"), Content);
+	// A torn or corrupt record ends the journal; everything after it is dropped by the next compaction
+	TArray<FJsonCRDTPatch> Records;
+	const int32 IntactBytes = FJsonCRDTJournal::ReadRecords(JournalBytes, Records);
+	if (IntactBytes < JournalBytes.Num())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Journal of document %s is truncated after %d of %d bytes"), *Core.GetDocumentID(), IntactBytes, JournalBytes.Num());
+		bOutNeedsCompaction = true;
+	}
 
-	// Add the latest snapshot
-	if (SnapshotHistory.Num() > 0)
+	int32 NumReplayed = 0;
+	for (const FJsonCRDTPatch& Record : Records)
 	{
-		TSharedPtr<FJsonObject> SnapshotObject = MakeShared<FJsonObject>();
-		SnapshotObject->SetStringField(TEXT("documentId"), SnapshotHistory.Last().DocumentID);
-		SnapshotObject->SetNumberField(TEXT("version"), SnapshotHistory.Last().Version);
-		SnapshotObject->SetStringField(TEXT("timestamp"), SnapshotHistory.Last().Timestamp.ToString());
-		SnapshotObject->SetStringField(TEXT("content"), SnapshotHistory.Last().Content);
-		SaveData->SetObjectField(TEXT("latestSnapshot"), SnapshotObject);
+		// Records older than the base file were already compacted into it
+		if (Record.BaseVersion < Core.GetVersion())
+		{
+			bOutNeedsCompaction = true;
+			continue;
+		}
+
+		if (Record.BaseVersion != Core.GetVersion() || Record.DocumentID != Core.GetDocumentID())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Journal of document %s does not continue version %lld, stopping replay"), *Core.GetDocumentID(), Core.GetVersion());
+			bOutNeedsCompaction = true;
+			break;
+		}
+
+		// Replaying needs the decoded content even when the base file was mapped
+		MaterializeContent();
+
+		TArray<FJsonCRDTOperation> InverseOperations;
+		if (Core.ApplyOperationsAtomically(Record.Operations, InverseOperations) != INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Journal record for version %lld of document %s could not be applied, stopping replay"), Core.GetVersion() + 1, *Core.GetDocumentID());
+			bOutNeedsCompaction = true;
+			break;
+		}
+
+		const int64 PreviousVersion = Core.AdvanceVersion();
+		RecordChange(PreviousVersion, MoveTemp(InverseOperations), Record.Operations.Num());
+		++NumReplayed;
 	}
 
-	// Serialize the JSON object to a string
-	FString SaveString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&SaveString);
-	if (!FJsonSerializer::Serialize(SaveData.ToSharedRef(), Writer))
+	if (NumReplayed > 0)
 	{
-		SetLastErrorMessage(TEXT("Failed to serialize document data"));
-		UE_LOG(LogTemp, Error, TEXT("%s"), *LastErrorMessage);
-		return false;
+		bOutNeedsCompaction = true;
 	}
 
-	// Save the string to a file
-	if (!FFileHelper::SaveStringToFile(SaveString, *FilePath))
+	return NumReplayed;
+}
+
+bool UJsonCRDTDocument::LoadFromLocal()
+{
+	// Make sure a queued save of this document is on disk before reading it back
+	FJsonCRDTLocalStorageWriter::Get().Flush();
+
+	if (!ReadFromLocal())
 	{
-		SetLastErrorMessage(FString::Printf(TEXT("Failed to save document to file: %s"), *FilePath));
-		UE_LOG(LogTemp, Error, TEXT("%s"), *LastErrorMessage);
 		return false;
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("Document %s saved locally to %s"), *DocumentID, *FilePath);
+	NotifyLoadedFromLocal(false);
 	return true;
 }
 
-bool UJsonCRDTDocument::LoadFromLocal()
+bool UJsonCRDTDocument::ReadFromLocal()
 {
-	// Get the local storage path
-	FString FilePath = GetLocalStoragePath();
+	// Prefer the binary file when configured; a document saved as JSON before the switch still loads
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString BinaryPath = GetLocalStoragePath(EJsonCRDTLocalStorageFormat::Binary);
+	const bool bBinary = LocalStorageFormat == EJsonCRDTLocalStorageFormat::Binary && PlatformFile.FileExists(*BinaryPath);
+	const FString FilePath = bBinary ? BinaryPath : GetLocalStoragePath(EJsonCRDTLocalStorageFormat::Json);
 
 	// Check if the file exists
-	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
 	if (!PlatformFile.FileExists(*FilePath))
 	{
 		SetLastErrorMessage(FString::Printf(TEXT("Local file does not exist: %s"), *FilePath));
@@ -405,6 +1423,42 @@ bool UJsonCRDTDocument::LoadFromLocal()
 		return false;
 	}
 
+	if (!(bBinary ? LoadBinaryBaseFile(FilePath) : LoadJsonBaseFile(FilePath)))
+	{
+		return false;
+	}
+
+	// Replay changes journaled after the base file was written
+	bool bNeedsCompaction = false;
+	const int32 NumReplayed = ReplayLocalJournal(bNeedsCompaction);
+
+	PendingJournal.Reset();
+	LocalJournalSize = 0;
+	bLocalJournalValid = !bNeedsCompaction;
+	ResetChangeLog();
+	if (bNeedsCompaction)
+	{
+		// Fold the replayed records into a new base file on the next local save tick
+		RequestLocalSave();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Document %s loaded from local storage (%d journal records replayed)"), *Core.GetDocumentID(), NumReplayed);
+	return true;
+}
+
+void UJsonCRDTDocument::NotifyLoadedFromLocal(bool bRecovered)
+{
+	// Notify that the document has changed
+	NotifyDocumentChanged();
+
+	if (bRecovered)
+	{
+		OnDocumentRecovered.Broadcast(Core.GetDocumentID(), TEXT("LocalStorage"));
+	}
+}
+
+bool UJsonCRDTDocument::LoadJsonBaseFile(const FString& FilePath)
+{
 	// Load the string from the file
 	FString LoadString;
 	if (!FFileHelper::LoadFileToString(LoadString, *FilePath))
@@ -426,33 +1480,37 @@ bool UJsonCRDTDocument::LoadFromLocal()
 
 	// Validate the document ID
 	FString LoadedDocumentID;
-	if (!LoadData->TryGetStringField(TEXT("documentId"), LoadedDocumentID) || LoadedDocumentID != DocumentID)
+	if (!LoadData->TryGetStringField(TEXT("documentId"), LoadedDocumentID) || LoadedDocumentID != Core.GetDocumentID())
 	{
-		SetLastErrorMessage(FString::Printf(TEXT("Document ID mismatch: %s != %s"), *LoadedDocumentID, *DocumentID));
+		SetLastErrorMessage(FString::Printf(TEXT("Document ID mismatch: %s != %s"), *LoadedDocumentID, *Core.GetDocumentID()));
 		UE_LOG(LogTemp, Error, TEXT("%s"), *LastErrorMessage);
 		return false;
 	}
 
+	// The in-memory state is replaced from here on, so journaling resumes only after the replay below
+	InvalidateLocalJournal();
+
 	// Get the version
 	int64 LoadedVersion;
 	if (LoadData->TryGetNumberField(TEXT("version"), LoadedVersion))
 	{
-		Version = LoadedVersion;
+		Core.SetVersion(LoadedVersion);
 	}
 
 	// Get the content
 	const TSharedPtr<FJsonObject>* ContentObject;
-	if (LoadData->TryGetObjectField(TEXT("content"), ContentObject))
-	{
-		Content = *ContentObject;
-	}
-	else
+	if (!LoadData->TryGetObjectField(TEXT("content"), ContentObject) || !Core.GetContent().LoadFromJsonObject(*ContentObject))
 	{
 		SetLastErrorMessage(TEXT("Failed to get content from loaded data"));
 		UE_LOG(LogTemp, Error, TEXT("%s"), *LastErrorMessage);
 		return false;
 	}
 
+	// The loaded content replaces the in-memory history
+	ResetDeltaHistory();
+	DiscardHistoryAfter(Core.GetVersion());
+	OperationsSinceSnapshot = 0;
+
 	// Load the latest snapshot if available
 	const TSharedPtr<FJsonObject>* SnapshotObject;
 	if (LoadData->TryGetObjectField(TEXT("latestSnapshot"), SnapshotObject))
@@ -460,7 +1518,7 @@ bool UJsonCRDTDocument::LoadFromLocal()
 		FJsonCRDTSnapshot Snapshot;
 
 		// Get the snapshot document ID
-		if (!(*SnapshotObject)->TryGetStringField(TEXT("documentId"), Snapshot.DocumentID) || Snapshot.DocumentID != DocumentID)
+		if (!(*SnapshotObject)->TryGetStringField(TEXT("documentId"), Snapshot.DocumentID) || Snapshot.DocumentID != Core.GetDocumentID())
 		{
 			UE_LOG(LogTemp, Warning, TEXT("Snapshot document ID mismatch, ignoring snapshot"));
 		}
@@ -480,15 +1538,53 @@ bool UJsonCRDTDocument::LoadFromLocal()
 			(*SnapshotObject)->TryGetStringField(TEXT("content"), Snapshot.Content);
 
 			// Add the snapshot to the history
-			SnapshotHistory.Add(Snapshot);
+			AddSnapshot(Snapshot);
 		}
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("Document %s loaded from local storage"), *DocumentID);
+	// A mapped base file from an earlier load is superseded by the loaded content
+	MappedContent.Reset();
 
-	// Notify that the document has changed
-	NotifyDocumentChanged();
+	return true;
+}
+
+bool UJsonCRDTDocument::LoadBinaryBaseFile(const FString& FilePath)
+{
+	// Only the header and key table are read here; the content is decoded on first access
+	TUniquePtr<FJsonCRDTBinaryDocument> Binary = MakeUnique<FJsonCRDTBinaryDocument>();
+	if (!Binary->Open(FilePath))
+	{
+		SetLastErrorMessage(FString::Printf(TEXT("Failed to open binary document file: %s"), *FilePath));
+		UE_LOG(LogTemp, Error, TEXT("%s"), *LastErrorMessage);
+		return false;
+	}
+
+	// Validate the document ID
+	const FJsonCRDTBinaryDocument::FHeader& Header = Binary->GetHeader();
+	if (Header.DocumentID != Core.GetDocumentID())
+	{
+		SetLastErrorMessage(FString::Printf(TEXT("Document ID mismatch: %s != %s"), *Header.DocumentID, *Core.GetDocumentID()));
+		UE_LOG(LogTemp, Error, TEXT("%s"), *LastErrorMessage);
+		return false;
+	}
+
+	// The in-memory state is replaced from here on, so journaling resumes only after the replay
+	InvalidateLocalJournal();
+	Core.SetVersion(Header.Version);
+	Core.GetContent().Reset();
+
+	// The loaded content replaces the in-memory history
+	ResetDeltaHistory();
+	DiscardHistoryAfter(Core.GetVersion());
+	OperationsSinceSnapshot = 0;
+
+	// A snapshot without content refers to the loaded version itself
+	if (Header.bHasSnapshot)
+	{
+		AddSnapshot(Header.Snapshot);
+	}
 
+	MappedContent = MoveTemp(Binary);
 	return true;
 }
 
@@ -518,21 +1614,97 @@ bool UJsonCRDTDocument::IsAutoLocalSaveEnabled() const
 	return bAutoLocalSave;
 }
 
+void UJsonCRDTDocument::SetMaxOperationHistory(int32 MaxOperations)
+{
+	Core.GetOperationHistory().SetCapacity(MaxOperations);
+}
+
+int32 UJsonCRDTDocument::GetMaxOperationHistory() const
+{
+	return Core.GetOperationHistory().GetCapacity();
+}
+
+const FJsonCRDTOperationHistory& UJsonCRDTDocument::GetOperationHistory() const
+{
+	return Core.GetOperationHistory();
+}
+
+int32 UJsonCRDTDocument::GetNumResolvedConflicts() const
+{
+	return NumResolvedConflicts;
+}
+
+bool UJsonCRDTDocument::HasListeners() const
+{
+	return OnDocumentChanged.IsBound() || OnConflictDetected.IsBound() || OnConflictsDetected.IsBound() || PathSubscriptions.Num() > 0;
+}
+
+void UJsonCRDTDocument::CaptureEvictedState(FJsonCRDTEvictedState& OutState) const
+{
+	OutState.VersionVector = Core.GetVersionVector();
+	OutState.LocalPatchSequence = LocalPatchSequence;
+	OutState.LocalStorageFormat = LocalStorageFormat;
+	OutState.SnapshotPolicy = SnapshotPolicy;
+	OutState.ConflictResolver = ConflictResolver;
+	OutState.ConflictStrategy = ConflictStrategy;
+	OutState.MaxOperationHistory = Core.GetOperationHistory().GetCapacity();
+	OutState.MaxLocalJournalSize = MaxLocalJournalSize;
+	OutState.bAutoLocalSave = bAutoLocalSave;
+}
+
+void UJsonCRDTDocument::RestoreEvictedState(FJsonCRDTEvictedState&& State)
+{
+	Core.SetVersionVector(MoveTemp(State.VersionVector));
+	LocalPatchSequence = State.LocalPatchSequence;
+	SetLocalStorageFormat(State.LocalStorageFormat);
+	SetSnapshotPolicy(State.SnapshotPolicy);
+	if (State.ConflictResolver.IsValid())
+	{
+		SetConflictResolver(State.ConflictResolver);
+	}
+	else
+	{
+		SetConflictStrategy(State.ConflictStrategy);
+	}
+	SetMaxOperationHistory(State.MaxOperationHistory);
+	SetMaxLocalJournalSize(State.MaxLocalJournalSize);
+
+	// Not through SetAutoLocalSave, which would save the still empty content over the stored file
+	bAutoLocalSave = State.bAutoLocalSave;
+}
+
+SIZE_T UJsonCRDTDocument::GetAllocatedSize() const
+{
+	// The mapped base file is not counted; it is backed by the file, not the heap.
+	// Every part keeps its own running byte count, so this does not walk the content or the histories.
+	return Core.GetAllocatedSize() + PendingJournal.GetAllocatedSize()
+		+ SnapshotHistory.GetAllocatedSize() + DeltaHistory.GetAllocatedSize() + HistoryBytes
+		+ ChangeLog.GetAllocatedSize() + PendingOperations.GetAllocatedSize();
+}
+
 bool UJsonCRDTDocument::RecoverDocument()
 {
 	// First try to load from local storage
-	if (LoadFromLocal())
+	FJsonCRDTLocalStorageWriter::Get().Flush();
+	if (ReadFromLocal())
 	{
-		OnDocumentRecovered.Broadcast(DocumentID, TEXT("LocalStorage"));
+		NotifyLoadedFromLocal(true);
 		return true;
 	}
 
 	// If that fails, try to restore from the latest snapshot
+	return RecoverFromSnapshot();
+}
+
+bool UJsonCRDTDocument::RecoverFromSnapshot()
+{
 	if (SnapshotHistory.Num() > 0)
 	{
-		if (RestoreFromSnapshot(SnapshotHistory.Last()))
+		// Copy first: restoring rewrites the snapshot history
+		const FJsonCRDTSnapshot LatestSnapshot = SnapshotHistory.Last();
+		if (RestoreFromSnapshot(LatestSnapshot))
 		{
-			OnDocumentRecovered.Broadcast(DocumentID, TEXT("Snapshot"));
+			OnDocumentRecovered.Broadcast(Core.GetDocumentID(), TEXT("Snapshot"));
 			return true;
 		}
 	}
@@ -545,82 +1717,37 @@ bool UJsonCRDTDocument::RecoverDocument()
 
 FString UJsonCRDTDocument::GetLocalStoragePath() const
 {
-	return FPaths::ProjectSavedDir() / TEXT("JsonCRDT") / DocumentID + TEXT(".json");
+	return GetLocalStoragePath(LocalStorageFormat);
 }
 
-void UJsonCRDTDocument::SetLastErrorMessage(const FString& ErrorMessage)
+FString UJsonCRDTDocument::GetLocalStoragePath(EJsonCRDTLocalStorageFormat Format) const
 {
-	LastErrorMessage = ErrorMessage;
+	const TCHAR* Extension = Format == EJsonCRDTLocalStorageFormat::Binary ? TEXT(".jcrdt") : TEXT(".json");
+	return FPaths::ProjectSavedDir() / TEXT("JsonCRDT") / Core.GetDocumentID() + Extension;
 }
 
-TSharedPtr<FJsonValue> UJsonCRDTDocument::GetValueAtPath(TSharedPtr<FJsonObject> JsonObject, const FString& Path) const
+void UJsonCRDTDocument::MaterializeContent() const
 {
-	if (!JsonObject.IsValid() || Path.IsEmpty())
-	{
-		return nullptr;
-	}
-
-	// 경로 파싱 (JSON Pointer 형식: /path/to/value)
-	TArray<FString> PathParts;
-	FString PathCopy = Path;
-
-	// 첫 번째 '/'가 있으면 제거
-	if (PathCopy.StartsWith(TEXT("/")))
+	if (!MappedContent)
 	{
-		PathCopy.RemoveAt(0, 1);
+		return;
 	}
 
-	// 경로를 '/'로 분할
-	PathCopy.ParseIntoArray(PathParts, TEXT("/"));
-
-	// 빈 경로인 경우 전체 객체 반환
-	if (PathParts.Num() == 0)
+	if (!MappedContent->DecodeContent(Core.GetContent()))
 	{
-		return MakeShared<FJsonValueObject>(JsonObject);
+		UE_LOG(LogTemp, Error, TEXT("Failed to decode the binary local storage content of document %s"), *Core.GetDocumentID());
 	}
+	MappedContent.Reset();
+}
 
-	// 경로를 따라 값 찾기
-	TSharedPtr<FJsonValue> CurrentValue = MakeShared<FJsonValueObject>(JsonObject);
-	for (int32 i = 0; i < PathParts.Num(); ++i)
-	{
-		FString& Part = PathParts[i];
-
-		// ~로 시작하는 이스케이프된 문자 처리
-		Part.ReplaceInline(TEXT("~1"), TEXT("/"));
-		Part.ReplaceInline(TEXT("~0"), TEXT("~"));
-
-		// 현재 값이 객체인 경우
-		if (CurrentValue->Type == EJson::Object)
-		{
-			TSharedPtr<FJsonObject> CurrentObject = CurrentValue->AsObject();
-			if (!CurrentObject->HasField(Part))
-			{
-				return nullptr;
-			}
-
-			CurrentValue = CurrentObject->GetField<EJson::None>(Part);
-		}
-		// 현재 값이 배열인 경우
-		else if (CurrentValue->Type == EJson::Array)
-		{
-			TArray<TSharedPtr<FJsonValue>> Array = CurrentValue->AsArray();
-			int32 Index = FCString::Atoi(*Part);
-
-			if (Index < 0 || Index >= Array.Num())
-			{
-				return nullptr;
-			}
-
-			CurrentValue = Array[Index];
-		}
-		// 다른 타입인 경우 (경로가 더 남아있으면 오류)
-		else if (i < PathParts.Num() - 1)
-		{
-			return nullptr;
-		}
-	}
+FString UJsonCRDTDocument::GetLocalJournalPath() const
+{
+	return FPaths::ProjectSavedDir() / TEXT("JsonCRDT") / Core.GetDocumentID() + TEXT(".journal");
+}
 
-	return CurrentValue;
+void UJsonCRDTDocument::SetLastErrorMessage(const FString& ErrorMessage)
+{
+	LastErrorMessage = ErrorMessage;
 }
 
 void UJsonCRDTDocument::SetConflictStrategy(EJsonCRDTConflictStrategy Strategy)
@@ -699,7 +1826,7 @@ bool UJsonCRDTDocument::ExportLogs(const FString& FilePath)
 
 	// 현재 문서에 대한 로그만 필터링
 	FJsonCRDTLogFilter Filter;
-	Filter.DocumentID = DocumentID;
+	Filter.DocumentID = Core.GetDocumentID();
 
 	return Logger->ExportLogs(FilePath, Filter);
 }
@@ -714,7 +1841,7 @@ bool UJsonCRDTDocument::VisualizeHistory(const FString& FilePath)
 
 	// 현재 문서에 대한 로그만 필터링
 	FJsonCRDTLogFilter Filter;
-	Filter.DocumentID = DocumentID;
+	Filter.DocumentID = Core.GetDocumentID();
 
 	// 로그 가져오기
 	TArray<FJsonCRDTLogEntry> Logs = Logger->GetLogs(Filter);
@@ -737,8 +1864,79 @@ bool UJsonCRDTDocument::ResolveConflict(FJsonCRDTConflict& Conflict)
 	return ConflictResolver->ResolveConflict(Conflict);
 }
 
+void UJsonCRDTDocument::ResolveConflicts(TArrayView<FJsonCRDTConflict> Conflicts)
+{
+	if (!ConflictResolver.IsValid())
+	{
+		ConflictResolver = MakeShared<FJsonCRDTDefaultConflictResolver>(ConflictStrategy);
+	}
+
+	ConflictResolver->ResolveConflicts(Conflicts);
+}
+
+bool UJsonCRDTDocument::FindConflict(const FJsonCRDTOperation& Operation, FJsonCRDTConflict& OutConflict) const
+{
+	if (Operation.Type != EJsonCRDTOperationType::Replace)
+	{
+		return false;
+	}
+
+	// 같은 경로에 대한 가장 최근 Replace 작업을 경로 색인에서 바로 조회하고, 값이 다르면 충돌
+	const uint64 LocalSequence = Core.GetOperationHistory().FindLatestReplaceSequence(Operation.Path);
+	if (LocalSequence == FJsonCRDTOperationHistory::InvalidSequence)
+	{
+		return false;
+	}
+	return JsonCRDTDocument::MakeConflict(*Core.GetOperationHistory().FindBySequence(LocalSequence), LocalSequence, Operation, OutConflict);
+}
+
+bool UJsonCRDTDocument::GetConflictOperations(const FJsonCRDTConflict& Conflict, FJsonCRDTOperation& OutLocalOperation, FJsonCRDTOperation& OutRemoteOperation) const
+{
+	if (Conflict.LocalSequence < 0 || Conflict.RemoteSequence < 0)
+	{
+		return false;
+	}
+
+	return Core.GetOperationHistory().CopyBySequence(static_cast<uint64>(Conflict.LocalSequence), OutLocalOperation)
+		&& Core.GetOperationHistory().CopyBySequence(static_cast<uint64>(Conflict.RemoteSequence), OutRemoteOperation);
+}
+
+void UJsonCRDTDocument::CollectConflicts(const TArray<FJsonCRDTOperation>& Operations, TArray<FJsonCRDTConflict>& OutConflicts, TArray<int32, TInlineAllocator<16>>& OutOperationConflicts) const
+{
+	OutOperationConflicts.Init(INDEX_NONE, Operations.Num());
+
+	// 같은 패치에서 이미 바꾼 경로 (작업이 하나면 쓰지 않음)
+	TMap<FString, int32, FDefaultSetAllocator, TJsonCRDTCaseSensitiveMapKeyFuncs<int32>> ReplacedPaths;
+	for (int32 i = 0; i < Operations.Num(); ++i)
+	{
+		const FJsonCRDTOperation& Operation = Operations[i];
+		if (Operation.Type != EJsonCRDTOperationType::Replace)
+		{
+			continue;
+		}
+
+		if (Operations.Num() > 1)
+		{
+			if (ReplacedPaths.Contains(Operation.Path))
+			{
+				OutOperationConflicts[i] = JsonCRDTDocument::DeferredConflict;
+				continue;
+			}
+			ReplacedPaths.Add(Operation.Path, i);
+		}
+
+		FJsonCRDTConflict Conflict;
+		if (FindConflict(Operation, Conflict))
+		{
+			OutOperationConflicts[i] = OutConflicts.Add(MoveTemp(Conflict));
+		}
+	}
+}
+
 void UJsonCRDTDocument::LogOperation(const FJsonCRDTOperation& Operation, const FString& OldValue, const FString& NewValue, bool bHadConflict, const FJsonCRDTConflict& Conflict)
 {
+#if JSONCRDT_LOGGING_ENABLED
+	// 로거가 항목을 버릴 경우 항목을 만들지 않음
 	if (!Logger.IsValid() || !Logger->IsLoggingEnabled())
 	{
 		return;
@@ -747,7 +1945,7 @@ void UJsonCRDTDocument::LogOperation(const FJsonCRDTOperation& Operation, const
 	// 로그 항목 생성
 	FJsonCRDTLogEntry LogEntry;
 	LogEntry.LogID = FGuid::NewGuid().ToString();
-	LogEntry.DocumentID = DocumentID;
+	LogEntry.DocumentID = Core.GetDocumentID();
 	LogEntry.Path = Operation.Path;
 	LogEntry.OldValue = OldValue;
 	LogEntry.NewValue = NewValue;
@@ -790,4 +1988,5 @@ void UJsonCRDTDocument::LogOperation(const FJsonCRDTOperation& Operation, const
 
 	// 로그 기록
 	Logger->LogOperation(LogEntry);
+#endif
 }
@@ -0,0 +1,194 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "JsonCRDTLocalStorageWriter.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+
+FJsonCRDTLocalStorageWriter::FJsonCRDTLocalStorageWriter()
+	: bWriteScheduled(false)
+{
+}
+
+FJsonCRDTLocalStorageWriter::~FJsonCRDTLocalStorageWriter()
+{
+	Flush();
+}
+
+FJsonCRDTLocalStorageWriter& FJsonCRDTLocalStorageWriter::Get()
+{
+	static FJsonCRDTLocalStorageWriter Writer;
+	return Writer;
+}
+
+void FJsonCRDTLocalStorageWriter::Write(const FString& FilePath, FString&& Contents, const FString& JournalPathToReset)
+{
+	FPendingWrite PendingWrite;
+	PendingWrite.Text = MoveTemp(Contents);
+
+	FScopeLock Lock(&CriticalSection);
+	AddWrite(FilePath, MoveTemp(PendingWrite), JournalPathToReset);
+}
+
+void FJsonCRDTLocalStorageWriter::Write(const FString& FilePath, TArray<uint8>&& Bytes, const FString& JournalPathToReset)
+{
+	FPendingWrite PendingWrite;
+	PendingWrite.Bytes = MoveTemp(Bytes);
+	PendingWrite.bBinary = true;
+
+	FScopeLock Lock(&CriticalSection);
+	AddWrite(FilePath, MoveTemp(PendingWrite), JournalPathToReset);
+}
+
+void FJsonCRDTLocalStorageWriter::AddWrite(const FString& FilePath, FPendingWrite&& PendingWrite, const FString& JournalPathToReset)
+{
+	PendingWrites.Add(FilePath, MoveTemp(PendingWrite));
+
+	if (!JournalPathToReset.IsEmpty())
+	{
+		// 새 파일이 저널 내용을 모두 담으므로 아직 덧붙이지 않은 내용도 필요 없음
+		PendingAppends.Remove(JournalPathToReset);
+		PendingJournalResets.Add(FilePath, JournalPathToReset);
+	}
+
+	ScheduleWrite();
+}
+
+void FJsonCRDTLocalStorageWriter::Append(const FString& FilePath, TArray<uint8>&& Bytes)
+{
+	if (Bytes.Num() == 0)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&CriticalSection);
+	TArray<uint8>* Pending = PendingAppends.Find(FilePath);
+	if (Pending)
+	{
+		Pending->Append(Bytes);
+	}
+	else
+	{
+		PendingAppends.Add(FilePath, MoveTemp(Bytes));
+	}
+
+	ScheduleWrite();
+}
+
+void FJsonCRDTLocalStorageWriter::ScheduleWrite()
+{
+	// 이미 작업이 돌고 있으면 그 작업이 이번 요청까지 함께 처리
+	if (!bWriteScheduled)
+	{
+		bWriteScheduled = true;
+		WriteTask = UE::Tasks::Launch(TEXT("JsonCRDTLocalStorageWrite"), [this]()
+		{
+			WritePending();
+		});
+	}
+}
+
+void FJsonCRDTLocalStorageWriter::Flush()
+{
+	for (;;)
+	{
+		UE::Tasks::FTask Task;
+		{
+			FScopeLock Lock(&CriticalSection);
+			if (!bWriteScheduled)
+			{
+				return;
+			}
+			Task = WriteTask;
+		}
+
+		// 기다리는 동안 새 작업이 예약될 수 있으므로 다시 확인
+		Task.Wait();
+	}
+}
+
+int32 FJsonCRDTLocalStorageWriter::NumPendingWrites() const
+{
+	FScopeLock Lock(&CriticalSection);
+	return PendingWrites.Num() + PendingAppends.Num();
+}
+
+void FJsonCRDTLocalStorageWriter::WritePending()
+{
+	for (;;)
+	{
+		TMap<FString, FPendingWrite> Batch;
+		TMap<FString, FString> JournalResets;
+		TMap<FString, TArray<uint8>> Appends;
+		{
+			FScopeLock Lock(&CriticalSection);
+			if (PendingWrites.Num() == 0 && PendingAppends.Num() == 0)
+			{
+				bWriteScheduled = false;
+				return;
+			}
+			Batch = MoveTemp(PendingWrites);
+			PendingWrites.Reset();
+			JournalResets = MoveTemp(PendingJournalResets);
+			PendingJournalResets.Reset();
+			Appends = MoveTemp(PendingAppends);
+			PendingAppends.Reset();
+		}
+
+		for (const TPair<FString, FPendingWrite>& Pair : Batch)
+		{
+			if (!WriteFileAtomically(Pair.Key, Pair.Value))
+			{
+				UE_LOG(LogTemp, Error, TEXT("Failed to save document to file: %s"), *Pair.Key);
+				continue;
+			}
+
+			// 파일 교체가 끝난 뒤에만 저널을 지움 (중간에 중단되면 불러올 때 이미 반영된 레코드를 건너뜀)
+			if (const FString* JournalPath = JournalResets.Find(Pair.Key))
+			{
+				IFileManager::Get().Delete(**JournalPath, false, true, true);
+			}
+		}
+
+		for (const TPair<FString, TArray<uint8>>& Pair : Appends)
+		{
+			if (!AppendToFile(Pair.Key, Pair.Value))
+			{
+				UE_LOG(LogTemp, Error, TEXT("Failed to append to file: %s"), *Pair.Key);
+			}
+		}
+	}
+}
+
+bool FJsonCRDTLocalStorageWriter::WriteFileAtomically(const FString& FilePath, const FPendingWrite& PendingWrite)
+{
+	// 파일 쓰기는 필요한 디렉터리를 만들어 주므로 따로 확인하지 않음
+	const FString TempPath = FilePath + TEXT(".tmp");
+	const bool bSaved = PendingWrite.bBinary
+		? FFileHelper::SaveArrayToFile(PendingWrite.Bytes, *TempPath)
+		: FFileHelper::SaveStringToFile(PendingWrite.Text, *TempPath);
+	if (!bSaved)
+	{
+		return false;
+	}
+
+	if (!IFileManager::Get().Move(*FilePath, *TempPath, true, true))
+	{
+		IFileManager::Get().Delete(*TempPath, false, true, true);
+		return false;
+	}
+
+	return true;
+}
+
+bool FJsonCRDTLocalStorageWriter::AppendToFile(const FString& FilePath, const TArray<uint8>& Bytes)
+{
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath, FILEWRITE_Append | FILEWRITE_AllowRead));
+	if (!Writer)
+	{
+		return false;
+	}
+
+	Writer->Serialize(const_cast<uint8*>(Bytes.GetData()), Bytes.Num());
+	return Writer->Close();
+}
@@ -4,175 +4,1362 @@
 #include "JsonCRDTDocument.h"
 #include "JsonCRDTTransport.h"
 #include "JsonObjectConverter.h"
+#include "HAL/PlatformTime.h"
+#include "Async/ParallelFor.h"
+#include "JsonCRDTLocalStorageWriter.h"
+#include "JsonCRDTStats.h"
+
+namespace JsonCRDTSyncManager
+{
+    /** 패치 전송에 실패한 뒤 다시 시도하기까지 기다리는 시간 (초) */
+    static constexpr double PatchRetryDelaySeconds = 1.0;
+
+    /** 초당 적용 패치 수를 재는 구간과 문서 메모리 통계를 갱신하는 주기 (초) */
+    static constexpr double StatsUpdateInterval = 1.0;
+}
 
 UJsonCRDTSyncManager::UJsonCRDTSyncManager()
-    : DefaultConflictStrategy(EJsonCRDTConflictStrategy::LastWriterWins)
+    : PatchFlushInterval(0.05f)
+    , PatchFlushThreshold(256)
+    , LastPatchFlushTime(0.0)
+    , bOfflineMode(false)
+    , NumPatchesApplied(0)
+    , PatchRateWindowStart(0.0)
+    , PatchRateWindowCount(0)
+    , PatchesPerSecond(0.0f)
+    , NumScheduledPatches(0)
+    , OutboundRateLimit(0)
+    , OutboundTokens(0.0)
+    , LastOutboundRefillTime(0.0)
+    , DocumentMemoryBudget(0)
+    , DocumentEvictionIdleTime(30.0f)
+    , LastBudgetCheckTime(0.0)
+    , LocalSaveDebounce(0.5f)
+    , LocalSaveMaxDelay(5.0f)
+    , DefaultConflictStrategy(EJsonCRDTConflictStrategy::LastWriterWins)
+{
+    // 중요 문서는 틱마다 모두 적용하고, 나머지는 프레임을 넘기지 않도록 예산 안에서 적용
+    PriorityApplyBudgets[static_cast<int32>(EJsonCRDTSyncPriority::Critical)] = -1.0f;
+    PriorityApplyBudgets[static_cast<int32>(EJsonCRDTSyncPriority::Normal)] = 0.004f;
+    PriorityApplyBudgets[static_cast<int32>(EJsonCRDTSyncPriority::Background)] = 0.001f;
+
+    // 기본 로거 설정
+    Logger = MakeShared<FJsonCRDTDefaultLogger>();
+}
+
+UJsonCRDTSyncManager::~UJsonCRDTSyncManager()
+{
+    // Transport 객체는 shared_ptr이므로 자동으로 정리됨
+}
+
+void UJsonCRDTSyncManager::BeginDestroy()
+{
+    // Transport는 다른 곳에서 공유되어 이 객체보다 오래 남을 수 있으므로, 디코딩 작업이 해제된 객체의 수신 큐에 넣지 않도록 등록 취소
+    UnregisterTransport();
+
+    Super::BeginDestroy();
+}
+
+void UJsonCRDTSyncManager::Tick(float DeltaTime)
+{
+    // 작업 스레드에서 디코딩된 수신 패치 적용
+    ProcessReceivedPatches();
+
+    // 문서별 스냅샷 정책 (주기/유휴) 평가
+    const double CurrentTime = FPlatformTime::Seconds();
+    const bool bRetryWaiting = CurrentTime < LastPatchFlushTime;
+    bool bFlushDue = CurrentTime - LastPatchFlushTime >= PatchFlushInterval;
+    TArray<UJsonCRDTDocument*> CriticalPendingDocuments;
+    for (const TPair<FString, UJsonCRDTDocument*>& Pair : Documents)
+    {
+        if (Pair.Value)
+        {
+            Pair.Value->TickSnapshotPolicy(CurrentTime);
+            Pair.Value->TickLocalSave(CurrentTime, LocalSaveDebounce, LocalSaveMaxDelay);
+
+            // 대기 작업이 많이 쌓인 문서가 있으면 주기를 기다리지 않고 전송
+            if (!bFlushDue && !bRetryWaiting && PatchFlushThreshold > 0 && Pair.Value->GetNumPendingOperations() >= PatchFlushThreshold)
+            {
+                bFlushDue = true;
+            }
+
+            if (!bFlushDue && !bRetryWaiting && Pair.Value->HasPendingChanges() && GetDocumentPriority(Pair.Key) == EJsonCRDTSyncPriority::Critical)
+            {
+                CriticalPendingDocuments.Add(Pair.Value);
+            }
+        }
+    }
+
+    // 중요 문서는 틱마다, 나머지는 주기마다 송신 제한 안에서 전송
+    RefillOutboundTokens(CurrentTime);
+    if (bFlushDue)
+    {
+        FlushScheduledPatches(CurrentTime);
+    }
+    else if (CriticalPendingDocuments.Num() > 0)
+    {
+        SendDocumentPatches(CriticalPendingDocuments);
+    }
+
+    if (!bRetryWaiting)
+    {
+        SendScheduledSaves();
+    }
+
+    SET_DWORD_STAT(STAT_JsonCRDT_ReceivedQueueDepth, NumReceivedPatches.load() + NumScheduledPatches);
+    UpdateStats(CurrentTime);
+
+    // 위의 문서 순회가 끝난 뒤에 맵을 바꿈
+    EnforceMemoryBudget(CurrentTime);
+}
+
+void UJsonCRDTSyncManager::UpdateStats(double CurrentTime)
+{
+    const double Elapsed = CurrentTime - PatchRateWindowStart;
+    if (Elapsed < JsonCRDTSyncManager::StatsUpdateInterval)
+    {
+        return;
+    }
+
+    // 첫 틱은 구간 시작만 기록
+    PatchesPerSecond = PatchRateWindowStart > 0.0 ? static_cast<float>(PatchRateWindowCount / Elapsed) : 0.0f;
+    PatchRateWindowStart = CurrentTime;
+    PatchRateWindowCount = 0;
+
+#if STATS
+    // 문서 메모리 계산은 문서 크기에 비례하므로 통계 그룹이 있을 때만 주기적으로 계산
+    const FJsonCRDTSyncStats Stats = GetSyncStats();
+    SET_DWORD_STAT(STAT_JsonCRDT_PendingOperations, Stats.PendingOperations);
+    SET_DWORD_STAT(STAT_JsonCRDT_OfflineQueuedOperations, Stats.OfflineQueuedOperations);
+    SET_MEMORY_STAT(STAT_JsonCRDT_DocumentMemory, Stats.DocumentMemory);
+#endif
+}
+
+FJsonCRDTSyncStats UJsonCRDTSyncManager::GetSyncStats() const
+{
+    FJsonCRDTSyncStats Stats;
+    if (Transport.IsValid())
+    {
+        const FJsonCRDTTransportStats TransportStats = Transport->GetStats();
+        Stats.BytesSent = TransportStats.BytesSent;
+        Stats.BytesReceived = TransportStats.BytesReceived;
+        Stats.PatchesSent = TransportStats.PatchesSent;
+        Stats.PatchesReceived = TransportStats.PatchesReceived;
+        Stats.OfflineQueuedOperations = TransportStats.QueuedOperations;
+    }
+
+    Stats.PatchesApplied = NumPatchesApplied;
+    Stats.PatchesPerSecond = PatchesPerSecond;
+    Stats.ReceivedQueueDepth = NumReceivedPatches.load() + NumScheduledPatches;
+    Stats.NumEvictedDocuments = EvictedDocuments.Num();
+
+    for (const TPair<FString, UJsonCRDTDocument*>& Pair : Documents)
+    {
+        if (Pair.Value)
+        {
+            Stats.ConflictsResolved += Pair.Value->GetNumResolvedConflicts();
+            Stats.PendingOperations += Pair.Value->GetNumPendingOperations();
+            Stats.DocumentMemory += Pair.Value->GetAllocatedSize();
+            ++Stats.NumDocuments;
+        }
+    }
+
+    return Stats;
+}
+
+TMap<FString, int64> UJsonCRDTSyncManager::GetDocumentMemoryUsage() const
+{
+    TMap<FString, int64> Usage;
+    Usage.Reserve(Documents.Num());
+    for (const TPair<FString, UJsonCRDTDocument*>& Pair : Documents)
+    {
+        if (Pair.Value)
+        {
+            Usage.Add(Pair.Key, Pair.Value->GetAllocatedSize());
+        }
+    }
+    return Usage;
+}
+
+TStatId UJsonCRDTSyncManager::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UJsonCRDTSyncManager, STATGROUP_Tickables);
+}
+
+bool UJsonCRDTSyncManager::IsTickable() const
+{
+    return !HasAnyFlags(RF_ClassDefaultObject) && (Documents.Num() > 0 || !ReceivedPatches.IsEmpty() || NumScheduledPatches > 0);
+}
+
+void UJsonCRDTSyncManager::Initialize(const FString& InServerURL, const FString& InWebSocketURL)
+{
+    // 기본 Transport 생성 (HTTP 및 WebSocket 사용)
+    TSharedPtr<FDefaultJsonCRDTTransport> DefaultTransport = MakeShared<FDefaultJsonCRDTTransport>(InServerURL, InWebSocketURL);
+    SetTransport(DefaultTransport);
+
+    // 서버에 연결
+    Connect();
+}
+
+void UJsonCRDTSyncManager::SetTransport(TSharedPtr<IJsonCRDTTransport> InTransport)
+{
+    UnregisterTransport();
+    Transport = InTransport;
+
+    // 패치 수신 및 연결 상태 이벤트 등록
+    if (Transport.IsValid())
+    {
+        Transport->RegisterPatchReceived(FOnPatchReceived::CreateUObject(this, &UJsonCRDTSyncManager::OnPatchReceived));
+        Transport->RegisterConnectionStatusChanged(FOnConnectionStatusChanged::CreateUObject(this, &UJsonCRDTSyncManager::OnConnectionStatusChanged));
+        Transport->SetReconnectSettings(ReconnectSettings);
+
+        // 새 Transport는 구독 목록을 모르므로 관리 중인 문서를 다시 구독
+        for (const TPair<FString, UJsonCRDTDocument*>& Pair : Documents)
+        {
+            SubscribeDocument(Pair.Key);
+        }
+    }
+}
+
+void UJsonCRDTSyncManager::UnregisterTransport()
+{
+    // 등록을 바꾸면 Transport가 진행 중인 콜백이 끝날 때까지 기다리므로 반환 후에는 호출되지 않음
+    if (Transport.IsValid())
+    {
+        Transport->RegisterPatchReceived(FOnPatchReceived());
+        Transport->RegisterConnectionStatusChanged(FOnConnectionStatusChanged());
+    }
+}
+
+bool UJsonCRDTSyncManager::Connect()
+{
+    if (!Transport.IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("Transport is not valid"));
+        return false;
+    }
+
+    if (bOfflineMode)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Offline mode is enabled, not connecting"));
+        return false;
+    }
+
+    if (!Transport->Connect())
+    {
+        return false;
+    }
+
+    // 연결이 필요 없는 Transport는 상태 변경을 알리지 않으므로 바로 재개
+    if (Transport->IsConnected())
+    {
+        ResumeOnline();
+    }
+    return true;
+}
+
+void UJsonCRDTSyncManager::Disconnect()
+{
+    if (Transport.IsValid())
+    {
+        Transport->Disconnect();
+    }
+}
+
+bool UJsonCRDTSyncManager::IsConnected() const
+{
+    return !bOfflineMode && Transport.IsValid() && Transport->IsConnected();
+}
+
+void UJsonCRDTSyncManager::SetAutoReconnect(bool bEnable)
+{
+    ReconnectSettings.bAutoReconnect = bEnable;
+    if (Transport.IsValid())
+    {
+        Transport->SetReconnectSettings(ReconnectSettings);
+    }
+}
+
+void UJsonCRDTSyncManager::SetMaxReconnectAttempts(int32 MaxAttempts)
+{
+    ReconnectSettings.MaxAttempts = FMath::Max(0, MaxAttempts);
+    if (Transport.IsValid())
+    {
+        Transport->SetReconnectSettings(ReconnectSettings);
+    }
+}
+
+void UJsonCRDTSyncManager::SetReconnectDelay(float InitialDelaySeconds, float MaxDelaySeconds)
+{
+    ReconnectSettings.InitialDelaySeconds = FMath::Max(0.1f, InitialDelaySeconds);
+    ReconnectSettings.MaxDelaySeconds = FMath::Max(ReconnectSettings.InitialDelaySeconds, MaxDelaySeconds);
+    if (Transport.IsValid())
+    {
+        Transport->SetReconnectSettings(ReconnectSettings);
+    }
+}
+
+void UJsonCRDTSyncManager::SetOfflineMode(bool bEnable)
+{
+    if (bOfflineMode == bEnable)
+    {
+        return;
+    }
+
+    bOfflineMode = bEnable;
+    if (!Transport.IsValid())
+    {
+        return;
+    }
+
+    if (bEnable)
+    {
+        // 로컬 작업은 Transport의 전송 대기열에 보관되고, 다시 연결되면 묶어서 전송됨
+        Transport->Disconnect();
+        OnNetworkStatusChanged.Broadcast(false, TEXT("Offline mode enabled"));
+    }
+    else
+    {
+        Connect();
+    }
+}
+
+bool UJsonCRDTSyncManager::IsOfflineMode() const
+{
+    return bOfflineMode;
+}
+
+void UJsonCRDTSyncManager::OnConnectionStatusChanged(bool bIsConnected, const FString& StatusMessage)
+{
+    // 오프라인 모드에서 직접 끊은 것은 SetOfflineMode에서 이미 알림
+    if (bOfflineMode)
+    {
+        return;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Network status changed: %s, %s"), bIsConnected ? TEXT("online") : TEXT("offline"), *StatusMessage);
+    OnNetworkStatusChanged.Broadcast(bIsConnected, StatusMessage);
+
+    if (bIsConnected)
+    {
+        ResumeOnline();
+    }
+}
+
+void UJsonCRDTSyncManager::ResumeOnline()
+{
+    // 오프라인 모드에서 미룬 서버 저장
+    TSet<FString> DeferredSaves = MoveTemp(DeferredSaveDocumentIDs);
+    DeferredSaveDocumentIDs.Reset();
+    for (const FString& DocumentID : DeferredSaves)
+    {
+        if (UJsonCRDTDocument* Document = GetDocument(DocumentID))
+        {
+            SaveDocument(Document);
+        }
+    }
+
+    // 끊긴 동안 놓친 원격 변경 요청 (보관한 로컬 작업은 Transport가 이미 보냄)
+    SyncAllDocuments();
+}
+
+void UJsonCRDTSyncManager::CreateDocument(UJsonCRDTDocument* Document)
+{
+    if (!Document)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Cannot create null document"));
+        return;
+    }
+
+    // 문서를 맵에 추가 (같은 ID로 내려 둔 문서는 새 문서로 대체)
+    Documents.Add(Document->GetDocumentID(), Document);
+    EvictedDocuments.Remove(Document->GetDocumentID());
+    SubscribeDocument(Document->GetDocumentID());
+
+    // 로거 설정
+    if (Logger.IsValid())
+    {
+        Document->SetLogger(Logger);
+    }
+
+    // 충돌 해결 전략 설정
+    Document->SetConflictStrategy(DefaultConflictStrategy);
+
+    // 문서 저장
+    SaveDocument(Document);
+}
+
+void UJsonCRDTSyncManager::LoadDocument(const FString& DocumentID)
+{
+    // 이미 로드된 문서인지 확인
+    if (Documents.Contains(DocumentID))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Document %s is already loaded"), *DocumentID);
+        return;
+    }
+
+    // Transport가 유효한지 확인
+    if (!Transport.IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("Transport is not valid"));
+        return;
+    }
+
+    // 로드 응답 이후의 패치를 놓치지 않도록 요청 전에 구독 (실패하면 해제)
+    SubscribeDocument(DocumentID);
+
+    // 서버에서 문서 로드
+    TWeakObjectPtr<UJsonCRDTSyncManager> WeakThis(this);
+    Transport->LoadDocument(
+        DocumentID,
+        FOnDocumentLoaded::CreateUObject(this, &UJsonCRDTSyncManager::OnDocumentLoaded),
+        FOnTransportError::CreateLambda([WeakThis](const FString& FailedDocumentID, const FString& ErrorMessage) {
+            UJsonCRDTSyncManager* This = WeakThis.Get();
+            if (!This)
+            {
+                return;
+            }
+
+            if (This->Transport.IsValid() && !This->Documents.Contains(FailedDocumentID) && !This->EvictedDocuments.Contains(FailedDocumentID))
+            {
+                This->Transport->Unsubscribe(FailedDocumentID);
+            }
+            This->OnTransportError(FailedDocumentID, ErrorMessage);
+        })
+    );
+}
+
+void UJsonCRDTSyncManager::SaveDocument(UJsonCRDTDocument* Document)
+{
+    if (!Document)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Cannot save null document"));
+        return;
+    }
+
+    // 항상 로컬에 먼저 저장
+    if (Document->SaveLocally())
+    {
+        UE_LOG(LogTemp, Log, TEXT("Document %s saved locally"), *Document->GetDocumentID());
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to save document %s locally"), *Document->GetDocumentID());
+    }
+
+    // Transport가 유효한지 확인
+    if (!Transport.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Transport is not valid, document %s saved locally only"), *Document->GetDocumentID());
+        return;
+    }
+
+    // 오프라인 모드에서는 다시 연결된 뒤 저장
+    if (bOfflineMode)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Offline mode, document %s saved locally only"), *Document->GetDocumentID());
+        DeferredSaveDocumentIDs.Add(Document->GetDocumentID());
+        return;
+    }
+
+    // 송신 제한이 있으면 중요 문서가 아닌 저장은 틱에서 우선순위 순서대로 보냄 (같은 문서의 저장은 하나로 합침)
+    if (OutboundRateLimit > 0 && GetDocumentPriority(Document->GetDocumentID()) != EJsonCRDTSyncPriority::Critical)
+    {
+        ScheduledSaveDocumentIDs.AddUnique(Document->GetDocumentID());
+        return;
+    }
+
+    SendDocumentSave(Document);
+}
+
+void UJsonCRDTSyncManager::SendDocumentSave(UJsonCRDTDocument* Document)
+{
+    // 서버가 확인한 버전 이후의 작업이 기록되어 있으면 변경분만 전송
+    const FServerVersion* Acknowledged = ServerVersions.Find(Document->GetDocumentID());
+    FJsonCRDTPatch Delta;
+    if (!Acknowledged || !Document->GetChangesSince(Acknowledged->ChangeLogGeneration, Acknowledged->Version, Delta.Operations))
+    {
+        SaveDocumentContent(Document);
+        return;
+    }
+
+    if (Delta.Operations.Num() == 0)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("Document %s is unchanged since the last server save"), *Document->GetDocumentID());
+        OnDocumentSaved(Document->GetDocumentID());
+        return;
+    }
+
+    Delta.DocumentID = Document->GetDocumentID();
+    Delta.BaseVersion = Acknowledged->Version;
+    Delta.Timestamp = FDateTime::UtcNow();
+
+    const int64 Version = Document->GetVersion();
+    const int32 ChangeLogGeneration = Document->GetChangeLogGeneration();
+    TWeakObjectPtr<UJsonCRDTSyncManager> WeakThis(this);
+    TWeakObjectPtr<UJsonCRDTDocument> WeakDocument(Document);
+
+    // 서버에 변경분 저장 (서버 버전이 달라졌으면 전체 내용으로 다시 저장)
+    Transport->SaveDocumentDelta(
+        Delta,
+        Version,
+        FOnDocumentSaved::CreateLambda([WeakThis, WeakDocument, Version, ChangeLogGeneration](const FString& DocumentID) {
+            UJsonCRDTSyncManager* This = WeakThis.Get();
+            if (!This)
+            {
+                return;
+            }
+
+            This->SetServerVersion(WeakDocument.Get(), Version, ChangeLogGeneration);
+            This->OnDocumentSaved(DocumentID);
+        }),
+        FOnDocumentDeltaRejected::CreateLambda([WeakThis, WeakDocument](const FString& DocumentID) {
+            UJsonCRDTSyncManager* This = WeakThis.Get();
+            UJsonCRDTDocument* RejectedDocument = WeakDocument.Get();
+            if (!This || !RejectedDocument)
+            {
+                return;
+            }
+
+            UE_LOG(LogTemp, Log, TEXT("Server rejected the delta for document %s, saving full content"), *DocumentID);
+            This->ServerVersions.Remove(DocumentID);
+            This->SaveDocumentContent(RejectedDocument);
+        }),
+        FOnTransportError::CreateUObject(this, &UJsonCRDTSyncManager::OnTransportError)
+    );
+}
+
+void UJsonCRDTSyncManager::SaveDocumentContent(UJsonCRDTDocument* Document)
+{
+    // 문서 데이터 생성
+    FJsonCRDTDocumentData DocumentData;
+    DocumentData.DocumentID = Document->GetDocumentID();
+    DocumentData.Version = Document->GetVersion();
+    DocumentData.Content = Document->GetContentAsString();
+    DocumentData.UpdatedAt = FDateTime::UtcNow();
+
+    const int32 ChangeLogGeneration = Document->GetChangeLogGeneration();
+    TWeakObjectPtr<UJsonCRDTSyncManager> WeakThis(this);
+    TWeakObjectPtr<UJsonCRDTDocument> WeakDocument(Document);
+
+    // 서버에 문서 저장
+    Transport->SaveDocument(
+        DocumentData,
+        FOnDocumentSaved::CreateLambda([WeakThis, WeakDocument, Version = DocumentData.Version, ChangeLogGeneration](const FString& DocumentID) {
+            UJsonCRDTSyncManager* This = WeakThis.Get();
+            if (!This)
+            {
+                return;
+            }
+
+            This->SetServerVersion(WeakDocument.Get(), Version, ChangeLogGeneration);
+            This->OnDocumentSaved(DocumentID);
+        }),
+        FOnTransportError::CreateUObject(this, &UJsonCRDTSyncManager::OnTransportError)
+    );
+}
+
+void UJsonCRDTSyncManager::SetServerVersion(UJsonCRDTDocument* Document, int64 Version, int32 ChangeLogGeneration)
+{
+    if (!Document || Documents.FindRef(Document->GetDocumentID()) != Document)
+    {
+        return;
+    }
+
+    // 전송 중에 내용이 통째로 바뀌었으면 그 버전은 변경분의 기준이 될 수 없음
+    if (ChangeLogGeneration != Document->GetChangeLogGeneration())
+    {
+        ServerVersions.Remove(Document->GetDocumentID());
+        return;
+    }
+
+    FServerVersion& Acknowledged = ServerVersions.FindOrAdd(Document->GetDocumentID());
+    Acknowledged.Version = Version;
+    Acknowledged.ChangeLogGeneration = ChangeLogGeneration;
+    Document->DiscardChangesBefore(Version);
+}
+
+void UJsonCRDTSyncManager::LoadDocuments(const TArray<FString>& DocumentIDs)
+{
+    // 이미 로드된 문서는 요청하지 않음 (중복 ID는 한 번만)
+    TArray<FString> AlreadyLoaded;
+    TArray<FString> DocumentIDsToLoad;
+    for (const FString& DocumentID : DocumentIDs)
+    {
+        if (Documents.Contains(DocumentID))
+        {
+            AlreadyLoaded.AddUnique(DocumentID);
+        }
+        else
+        {
+            DocumentIDsToLoad.AddUnique(DocumentID);
+        }
+    }
+
+    if (DocumentIDsToLoad.Num() == 0)
+    {
+        OnDocumentsLoadComplete.Broadcast(AlreadyLoaded, TArray<FString>());
+        return;
+    }
+
+    // Transport가 유효한지 확인
+    if (!Transport.IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("Transport is not valid"));
+        OnDocumentsLoadComplete.Broadcast(AlreadyLoaded, DocumentIDsToLoad);
+        return;
+    }
+
+    // 로드 응답 이후의 패치를 놓치지 않도록 요청 전에 구독 (실패하면 해제)
+    for (const FString& DocumentID : DocumentIDsToLoad)
+    {
+        SubscribeDocument(DocumentID);
+    }
+
+    // 서버에서 문서들 로드
+    TWeakObjectPtr<UJsonCRDTSyncManager> WeakThis(this);
+    Transport->LoadDocuments(
+        DocumentIDsToLoad,
+        FOnDocumentsLoaded::CreateLambda([WeakThis, AlreadyLoaded](const TArray<FJsonCRDTDocumentData>& Loaded, const TMap<FString, FString>& Errors) {
+            UJsonCRDTSyncManager* This = WeakThis.Get();
+            if (!This)
+            {
+                return;
+            }
+
+            // 요청한 사이 따로 로드된 문서는 덮어쓰지 않음
+            TArray<FString> LoadedDocumentIDs = AlreadyLoaded;
+            TArray<const FJsonCRDTDocumentData*> NewDocumentData;
+            for (const FJsonCRDTDocumentData& DocumentData : Loaded)
+            {
+                if (!This->Documents.Contains(DocumentData.DocumentID))
+                {
+                    NewDocumentData.Add(&DocumentData);
+                }
+                LoadedDocumentIDs.Add(DocumentData.DocumentID);
+            }
+            This->OnDocumentsLoaded(NewDocumentData);
+
+            TArray<FString> FailedDocumentIDs;
+            for (const TPair<FString, FString>& Error : Errors)
+            {
+                if (This->Transport.IsValid() && !This->Documents.Contains(Error.Key) && !This->EvictedDocuments.Contains(Error.Key))
+                {
+                    This->Transport->Unsubscribe(Error.Key);
+                }
+                This->OnTransportError(Error.Key, Error.Value);
+                FailedDocumentIDs.Add(Error.Key);
+            }
+
+            This->OnDocumentsLoadComplete.Broadcast(LoadedDocumentIDs, FailedDocumentIDs);
+        })
+    );
+}
+
+void UJsonCRDTSyncManager::SaveDocuments(const TArray<UJsonCRDTDocument*>& InDocuments)
+{
+    TArray<UJsonCRDTDocument*> DocumentsToSave;
+    DocumentsToSave.Reserve(InDocuments.Num());
+    for (UJsonCRDTDocument* Document : InDocuments)
+    {
+        if (Document)
+        {
+            DocumentsToSave.AddUnique(Document);
+        }
+    }
+
+    // 항상 로컬에 먼저 저장 (문서마다 독립적이므로 직렬화는 병렬로 수행)
+    TArray<FJsonCRDTDocumentData> DocumentData;
+    DocumentData.SetNum(DocumentsToSave.Num());
+    const FDateTime Now = FDateTime::UtcNow();
+    ParallelFor(DocumentsToSave.Num(), [&DocumentsToSave, &DocumentData, &Now](int32 Index)
+    {
+        UJsonCRDTDocument* Document = DocumentsToSave[Index];
+        if (!Document->SaveLocally())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Failed to save document %s locally"), *Document->GetDocumentID());
+        }
+
+        FJsonCRDTDocumentData& Data = DocumentData[Index];
+        Data.DocumentID = Document->GetDocumentID();
+        Data.Version = Document->GetVersion();
+        Data.Content = Document->GetContentAsString();
+        Data.UpdatedAt = Now;
+    });
+
+    // Transport가 유효한지 확인
+    if (!Transport.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Transport is not valid, %d documents saved locally only"), DocumentData.Num());
+
+        TArray<FString> FailedDocumentIDs;
+        for (const FJsonCRDTDocumentData& Data : DocumentData)
+        {
+            FailedDocumentIDs.Add(Data.DocumentID);
+        }
+        OnDocumentsSaveComplete.Broadcast(TArray<FString>(), FailedDocumentIDs);
+        return;
+    }
+
+    // 오프라인 모드에서는 다시 연결된 뒤 문서별로 저장
+    if (bOfflineMode)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Offline mode, %d documents saved locally only"), DocumentData.Num());
+
+        TArray<FString> DeferredDocumentIDs;
+        for (const FJsonCRDTDocumentData& Data : DocumentData)
+        {
+            DeferredSaveDocumentIDs.Add(Data.DocumentID);
+            DeferredDocumentIDs.Add(Data.DocumentID);
+        }
+        OnDocumentsSaveComplete.Broadcast(TArray<FString>(), DeferredDocumentIDs);
+        return;
+    }
+
+    // 저장이 확인되면 다음 저장의 변경분 기준으로 기록할 버전
+    TMap<FString, TPair<TWeakObjectPtr<UJsonCRDTDocument>, FServerVersion>> SentVersions;
+    for (int32 Index = 0; Index < DocumentsToSave.Num(); ++Index)
+    {
+        FServerVersion Sent;
+        Sent.Version = DocumentData[Index].Version;
+        Sent.ChangeLogGeneration = DocumentsToSave[Index]->GetChangeLogGeneration();
+        SentVersions.Add(DocumentData[Index].DocumentID, TPair<TWeakObjectPtr<UJsonCRDTDocument>, FServerVersion>(DocumentsToSave[Index], Sent));
+    }
+
+    // 서버에 문서들 저장
+    TWeakObjectPtr<UJsonCRDTSyncManager> WeakThis(this);
+    Transport->SaveDocuments(
+        DocumentData,
+        FOnDocumentsSaved::CreateLambda([WeakThis, SentVersions = MoveTemp(SentVersions)](const TArray<FString>& SavedDocumentIDs, const TMap<FString, FString>& Errors) {
+            UJsonCRDTSyncManager* This = WeakThis.Get();
+            if (!This)
+            {
+                return;
+            }
+
+            for (const FString& DocumentID : SavedDocumentIDs)
+            {
+                if (const TPair<TWeakObjectPtr<UJsonCRDTDocument>, FServerVersion>* Sent = SentVersions.Find(DocumentID))
+                {
+                    This->SetServerVersion(Sent->Key.Get(), Sent->Value.Version, Sent->Value.ChangeLogGeneration);
+                }
+                This->OnDocumentSaved(DocumentID);
+            }
+
+            TArray<FString> FailedDocumentIDs;
+            for (const TPair<FString, FString>& Error : Errors)
+            {
+                This->OnTransportError(Error.Key, Error.Value);
+                FailedDocumentIDs.Add(Error.Key);
+            }
+
+            This->OnDocumentsSaveComplete.Broadcast(SavedDocumentIDs, FailedDocumentIDs);
+        })
+    );
+}
+
+void UJsonCRDTSyncManager::SyncDocument(UJsonCRDTDocument* Document)
+{
+    if (!Document)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Cannot sync null document"));
+        return;
+    }
+
+    // Transport가 유효한지 확인
+    if (!Transport.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Transport is not valid, cannot sync document %s"), *Document->GetDocumentID());
+        return;
+    }
+
+    // 송신 제한이 있으면 중요 문서가 아닌 로컬 작업은 다음 전송 주기에 우선순위 순서대로 보냄
+    if (OutboundRateLimit > 0 && Document->HasPendingChanges() && GetDocumentPriority(Document->GetDocumentID()) != EJsonCRDTSyncPriority::Critical)
+    {
+        return;
+    }
+
+    // 대기 중인 로컬 작업이 있으면 주기를 기다리지 않고 전송
+    FJsonCRDTPatch PendingPatch;
+    if (Document->TakePendingPatch(PendingPatch))
+    {
+        TArray<FJsonCRDTPatch> Patches;
+        Patches.Add(MoveTemp(PendingPatch));
+        SendPendingPatches(MoveTemp(Patches));
+        return;
+    }
+
+    // 오프라인이면 다시 연결된 뒤 모든 문서를 동기화하므로 요청하지 않음
+    if (bOfflineMode)
+    {
+        return;
+    }
+
+    // 동기화 요청 전송 (작업 없는 패치에 클라이언트별로 적용한 시퀀스를 담아 서버가 빠진 패치만 보내게 함)
+    Transport->SendPatch(
+        Document->MakeSyncRequest(),
+        FOnPatchSent::CreateLambda([](const FString& DocumentID) {
+            UE_LOG(LogTemp, Log, TEXT("Sync request sent for document %s"), *DocumentID);
+        }),
+        FOnTransportError::CreateUObject(this, &UJsonCRDTSyncManager::OnTransportError)
+    );
+}
+
+void UJsonCRDTSyncManager::SyncAllDocuments()
+{
+    // Transport가 유효한지 확인
+    if (!Transport.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Transport is not valid, cannot sync documents"));
+        return;
+    }
+
+    // 대기 중인 로컬 작업을 먼저 보내고, 모든 문서의 동기화 요청을 한 번에 전송
+    FlushPendingPatches();
+    if (bOfflineMode)
+    {
+        return;
+    }
+
+    TArray<FJsonCRDTPatch> Requests;
+    Requests.Reserve(Documents.Num());
+    for (const TPair<FString, UJsonCRDTDocument*>& Pair : Documents)
+    {
+        if (Pair.Value)
+        {
+            Requests.Add(Pair.Value->MakeSyncRequest());
+        }
+    }
+
+    if (Requests.Num() == 0)
+    {
+        return;
+    }
+
+    Transport->SendPatches(
+        Requests,
+        FOnPatchSent::CreateLambda([](const FString& DocumentID) {
+            UE_LOG(LogTemp, Verbose, TEXT("Sync request sent for document %s"), *DocumentID);
+        }),
+        FOnTransportError::CreateUObject(this, &UJsonCRDTSyncManager::OnTransportError)
+    );
+}
+
+void UJsonCRDTSyncManager::FlushPendingPatches()
+{
+    LastPatchFlushTime = FPlatformTime::Seconds();
+
+    // Transport가 없으면 작업은 문서 대기열에 그대로 남음
+    if (!Transport.IsValid())
+    {
+        return;
+    }
+
+    // 문서마다 대기 작업을 하나의 패치로 모으고, 모든 문서의 패치를 한 번에 전송
+    TArray<FJsonCRDTPatch> Patches;
+    for (const TPair<FString, UJsonCRDTDocument*>& Pair : Documents)
+    {
+        if (Pair.Value && Pair.Value->HasPendingChanges())
+        {
+            if (!Pair.Value->TakePendingPatch(Patches.AddDefaulted_GetRef()))
+            {
+                Patches.Pop(false);
+            }
+        }
+    }
+
+    if (Patches.Num() > 0)
+    {
+        SendPendingPatches(MoveTemp(Patches));
+    }
+}
+
+void UJsonCRDTSyncManager::FlushScheduledPatches(double CurrentTime)
+{
+    LastPatchFlushTime = CurrentTime;
+
+    // Transport가 없으면 작업은 문서 대기열에 그대로 남음
+    if (!Transport.IsValid())
+    {
+        return;
+    }
+
+    TArray<UJsonCRDTDocument*> PendingDocuments[NumSyncPriorities];
+    for (const TPair<FString, UJsonCRDTDocument*>& Pair : Documents)
+    {
+        if (Pair.Value && Pair.Value->HasPendingChanges())
+        {
+            PendingDocuments[static_cast<int32>(GetDocumentPriority(Pair.Key))].Add(Pair.Value);
+        }
+    }
+
+    // 중요 문서는 모두, 나머지는 높은 우선순위부터 송신 제한이 허락하는 만큼 (남은 작업은 문서에 쌓여 다음 전송에 합쳐짐)
+    TArray<UJsonCRDTDocument*> DocumentsToSend = MoveTemp(PendingDocuments[static_cast<int32>(EJsonCRDTSyncPriority::Critical)]);
+    for (int32 Index = static_cast<int32>(EJsonCRDTSyncPriority::Critical) + 1; Index < NumSyncPriorities; ++Index)
+    {
+        TArray<UJsonCRDTDocument*>& Candidates = PendingDocuments[Index];
+        if (OutboundRateLimit > 0)
+        {
+            // 같은 우선순위에서는 가장 오래 기다린 문서부터
+            Candidates.Sort([this](const UJsonCRDTDocument& A, const UJsonCRDTDocument& B) {
+                return DocumentSendTimes.FindRef(A.GetDocumentID()) < DocumentSendTimes.FindRef(B.GetDocumentID());
+            });
+        }
+
+        for (UJsonCRDTDocument* Document : Candidates)
+        {
+            if (!ConsumeOutboundToken())
+            {
+                break;
+            }
+            DocumentsToSend.Add(Document);
+        }
+    }
+
+    if (OutboundRateLimit > 0)
+    {
+        for (const UJsonCRDTDocument* Document : DocumentsToSend)
+        {
+            DocumentSendTimes.Add(Document->GetDocumentID(), CurrentTime);
+        }
+    }
+
+    SendDocumentPatches(DocumentsToSend);
+}
+
+void UJsonCRDTSyncManager::SendDocumentPatches(const TArray<UJsonCRDTDocument*>& InDocuments)
+{
+    if (!Transport.IsValid())
+    {
+        return;
+    }
+
+    TArray<FJsonCRDTPatch> Patches;
+    Patches.Reserve(InDocuments.Num());
+    for (UJsonCRDTDocument* Document : InDocuments)
+    {
+        if (!Document->TakePendingPatch(Patches.AddDefaulted_GetRef()))
+        {
+            Patches.Pop(false);
+        }
+    }
+
+    if (Patches.Num() > 0)
+    {
+        SendPendingPatches(MoveTemp(Patches));
+    }
+}
+
+void UJsonCRDTSyncManager::RefillOutboundTokens(double CurrentTime)
+{
+    if (OutboundRateLimit > 0)
+    {
+        OutboundTokens = FMath::Min<double>(OutboundRateLimit, OutboundTokens + (CurrentTime - LastOutboundRefillTime) * OutboundRateLimit);
+    }
+    LastOutboundRefillTime = CurrentTime;
+}
+
+bool UJsonCRDTSyncManager::ConsumeOutboundToken()
+{
+    if (OutboundRateLimit <= 0)
+    {
+        return true;
+    }
+
+    if (OutboundTokens < 1.0)
+    {
+        return false;
+    }
+
+    OutboundTokens -= 1.0;
+    return true;
+}
+
+void UJsonCRDTSyncManager::SendScheduledSaves()
+{
+    if (ScheduledSaveDocumentIDs.Num() == 0)
+    {
+        return;
+    }
+
+    // 미루는 사이 오프라인 모드가 되었으면 다시 연결된 뒤 저장
+    if (bOfflineMode)
+    {
+        DeferredSaveDocumentIDs.Append(ScheduledSaveDocumentIDs);
+        ScheduledSaveDocumentIDs.Reset();
+        return;
+    }
+
+    if (!Transport.IsValid())
+    {
+        return;
+    }
+
+    // 높은 우선순위부터, 같은 우선순위는 요청 순서대로 송신 제한이 허락하는 만큼
+    ScheduledSaveDocumentIDs.StableSort([this](const FString& A, const FString& B) {
+        return GetDocumentPriority(A) < GetDocumentPriority(B);
+    });
+
+    int32 NumToSend = 0;
+    while (NumToSend < ScheduledSaveDocumentIDs.Num() && ConsumeOutboundToken())
+    {
+        ++NumToSend;
+    }
+
+    TArray<FString> DocumentIDsToSend(ScheduledSaveDocumentIDs.GetData(), NumToSend);
+    ScheduledSaveDocumentIDs.RemoveAt(0, NumToSend, false);
+    for (const FString& DocumentID : DocumentIDsToSend)
+    {
+        if (UJsonCRDTDocument* Document = Documents.FindRef(DocumentID))
+        {
+            SendDocumentSave(Document);
+        }
+    }
+}
+
+void UJsonCRDTSyncManager::SetOutboundRateLimit(int32 MaxSendsPerSecond)
+{
+    OutboundRateLimit = FMath::Max(0, MaxSendsPerSecond);
+
+    // 새 제한의 1초 분량으로 시작 (제한을 끄면 미룬 저장은 다음 틱에 모두 보냄)
+    OutboundTokens = OutboundRateLimit;
+    LastOutboundRefillTime = FPlatformTime::Seconds();
+}
+
+int32 UJsonCRDTSyncManager::GetOutboundRateLimit() const
+{
+    return OutboundRateLimit;
+}
+
+void UJsonCRDTSyncManager::SendPendingPatches(TArray<FJsonCRDTPatch>&& Patches)
+{
+    // 오류 콜백에서 해당 문서의 패치를 되돌릴 수 있도록 전송 중인 패치를 공유
+    TSharedRef<TArray<FJsonCRDTPatch>> Batch = MakeShared<TArray<FJsonCRDTPatch>>(MoveTemp(Patches));
+    TWeakObjectPtr<UJsonCRDTSyncManager> WeakThis(this);
+
+    Transport->SendPatches(
+        *Batch,
+        FOnPatchSent::CreateLambda([](const FString& DocumentID) {
+            UE_LOG(LogTemp, Verbose, TEXT("Pending operations sent for document %s"), *DocumentID);
+        }),
+        FOnTransportError::CreateLambda([WeakThis, Batch](const FString& DocumentID, const FString& ErrorMessage) {
+            UJsonCRDTSyncManager* This = WeakThis.Get();
+            if (!This)
+            {
+                return;
+            }
+
+            const FString FailedDocumentID = DocumentID;
+            for (FJsonCRDTPatch& Patch : *Batch)
+            {
+                UJsonCRDTDocument* Document = Patch.DocumentID == FailedDocumentID ? This->GetDocument(FailedDocumentID) : nullptr;
+                if (Document && Patch.Operations.Num() > 0)
+                {
+                    Document->RequeuePendingPatch(MoveTemp(Patch));
+                }
+            }
+
+            // 연결이 끊긴 동안 매 틱 재전송하지 않도록 잠시 대기
+            This->LastPatchFlushTime = FPlatformTime::Seconds() + JsonCRDTSyncManager::PatchRetryDelaySeconds;
+            This->OnTransportError(FailedDocumentID, ErrorMessage);
+        })
+    );
+}
+
+void UJsonCRDTSyncManager::SetPatchFlushInterval(float Seconds)
+{
+    PatchFlushInterval = FMath::Max(0.0f, Seconds);
+}
+
+float UJsonCRDTSyncManager::GetPatchFlushInterval() const
+{
+    return PatchFlushInterval;
+}
+
+void UJsonCRDTSyncManager::SetPatchFlushThreshold(int32 NumOperations)
+{
+    PatchFlushThreshold = FMath::Max(0, NumOperations);
+}
+
+int32 UJsonCRDTSyncManager::GetPatchFlushThreshold() const
+{
+    return PatchFlushThreshold;
+}
+
+UJsonCRDTDocument* UJsonCRDTSyncManager::GetDocument(const FString& DocumentID)
+{
+    UJsonCRDTDocument** Found = Documents.Find(DocumentID);
+    UJsonCRDTDocument* Document = Found ? *Found : nullptr;
+    if (!Document && EvictedDocuments.Contains(DocumentID))
+    {
+        Document = ReloadEvictedDocument(DocumentID);
+    }
+
+    if (Document)
+    {
+        DocumentAccessTimes.Add(DocumentID, FPlatformTime::Seconds());
+    }
+    return Document;
+}
+
+void UJsonCRDTSyncManager::SetDocumentMemoryBudget(int64 MaxBytes)
 {
-    // 기본 로거 설정
-    Logger = MakeShared<FJsonCRDTDefaultLogger>();
+    DocumentMemoryBudget = FMath::Max<int64>(0, MaxBytes);
+
+    // 다음 틱에 바로 확인
+    LastBudgetCheckTime = 0.0;
 }
 
-UJsonCRDTSyncManager::~UJsonCRDTSyncManager()
+int64 UJsonCRDTSyncManager::GetDocumentMemoryBudget() const
 {
-    // Transport 객체는 shared_ptr이므로 자동으로 정리됨
+    return DocumentMemoryBudget;
 }
 
-void UJsonCRDTSyncManager::Initialize(const FString& InServerURL, const FString& InWebSocketURL)
+void UJsonCRDTSyncManager::SetDocumentEvictionIdleTime(float Seconds)
 {
-    // 기본 Transport 생성 (HTTP 및 WebSocket 사용)
-    TSharedPtr<FDefaultJsonCRDTTransport> DefaultTransport = MakeShared<FDefaultJsonCRDTTransport>(InServerURL, InWebSocketURL);
-    SetTransport(DefaultTransport);
+    DocumentEvictionIdleTime = FMath::Max(0.0f, Seconds);
+}
 
-    // 서버에 연결
-    DefaultTransport->Connect();
+void UJsonCRDTSyncManager::SetDocumentPinned(const FString& DocumentID, bool bPinned)
+{
+    if (!bPinned)
+    {
+        PinnedDocumentIDs.Remove(DocumentID);
+        return;
+    }
+
+    PinnedDocumentIDs.Add(DocumentID);
+
+    // 고정한 문서는 계속 쓸 문서이므로 내려가 있으면 바로 다시 읽음
+    if (EvictedDocuments.Contains(DocumentID))
+    {
+        GetDocument(DocumentID);
+    }
 }
 
-void UJsonCRDTSyncManager::SetTransport(TSharedPtr<IJsonCRDTTransport> InTransport)
+bool UJsonCRDTSyncManager::IsDocumentPinned(const FString& DocumentID) const
 {
-    Transport = InTransport;
+    return PinnedDocumentIDs.Contains(DocumentID);
+}
 
-    // 패치 수신 이벤트 등록
-    if (Transport.IsValid())
+bool UJsonCRDTSyncManager::EvictDocument(const FString& DocumentID)
+{
+    UJsonCRDTDocument* const* Document = Documents.Find(DocumentID);
+    if (!Document || !*Document || !CanEvictDocument(*Document))
     {
-        Transport->RegisterPatchReceived(FOnPatchReceived::CreateUObject(this, &UJsonCRDTSyncManager::OnPatchReceived));
+        return false;
     }
+    return EvictResidentDocument(*Document);
 }
 
-void UJsonCRDTSyncManager::CreateDocument(UJsonCRDTDocument* Document)
+bool UJsonCRDTSyncManager::IsDocumentResident(const FString& DocumentID) const
 {
-    if (!Document)
+    return Documents.Contains(DocumentID);
+}
+
+void UJsonCRDTSyncManager::EnforceMemoryBudget(double CurrentTime)
+{
+    if (DocumentMemoryBudget <= 0 || CurrentTime - LastBudgetCheckTime < JsonCRDTSyncManager::StatsUpdateInterval)
     {
-        UE_LOG(LogTemp, Error, TEXT("Cannot create null document"));
         return;
     }
+    LastBudgetCheckTime = CurrentTime;
 
-    // 문서를 맵에 추가
-    Documents.Add(Document->GetDocumentID(), Document);
+    struct FCandidate
+    {
+        UJsonCRDTDocument* Document;
+        double LastUseTime;
+        int64 Size;
+    };
 
-    // 로거 설정
-    if (Logger.IsValid())
+    // 문서별 메모리를 합하면서 유휴 시간이 지났고 내릴 수 있는 문서를 후보로 모음
+    TArray<FCandidate> Candidates;
+    int64 TotalSize = 0;
+    for (const TPair<FString, UJsonCRDTDocument*>& Pair : Documents)
     {
-        Document->SetLogger(Logger);
+        UJsonCRDTDocument* Document = Pair.Value;
+        if (!Document)
+        {
+            continue;
+        }
+
+        const int64 Size = Document->GetAllocatedSize();
+        TotalSize += Size;
+
+        const double* AccessTime = DocumentAccessTimes.Find(Pair.Key);
+        const double LastUseTime = FMath::Max(AccessTime ? *AccessTime : 0.0, Document->GetLastChangeTime());
+        if (CurrentTime - LastUseTime >= DocumentEvictionIdleTime && CanEvictDocument(Document))
+        {
+            Candidates.Add({ Document, LastUseTime, Size });
+        }
     }
 
-    // 충돌 해결 전략 설정
-    Document->SetConflictStrategy(DefaultConflictStrategy);
+    if (TotalSize <= DocumentMemoryBudget)
+    {
+        return;
+    }
 
-    // 문서 저장
-    SaveDocument(Document);
+    // 가장 오래 쓰지 않은 문서부터 예산 안으로 들어올 때까지 내림
+    Candidates.Sort([](const FCandidate& A, const FCandidate& B) { return A.LastUseTime < B.LastUseTime; });
+    int32 NumEvicted = 0;
+    for (const FCandidate& Candidate : Candidates)
+    {
+        if (TotalSize <= DocumentMemoryBudget)
+        {
+            break;
+        }
+
+        if (EvictResidentDocument(Candidate.Document))
+        {
+            TotalSize -= Candidate.Size;
+            ++NumEvicted;
+        }
+    }
+
+    if (TotalSize > DocumentMemoryBudget)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("Documents use %lld bytes after evicting %d, over the %lld byte budget"), TotalSize, NumEvicted, DocumentMemoryBudget);
+    }
 }
 
-void UJsonCRDTSyncManager::LoadDocument(const FString& DocumentID)
+bool UJsonCRDTSyncManager::CanEvictDocument(const UJsonCRDTDocument* Document) const
 {
-    // 이미 로드된 문서인지 확인
-    if (Documents.Contains(DocumentID))
+    // 보내지 않은 작업은 로컬 저장소에 남지 않고, 이벤트를 구독한 쪽은 지금의 문서 객체를 계속 씀
+    return !PinnedDocumentIDs.Contains(Document->GetDocumentID())
+        && Document->GetNumPendingOperations() == 0
+        && !Document->HasListeners()
+        && !ScheduledPatches.Contains(Document->GetDocumentID())
+        && !ScheduledSaveDocumentIDs.Contains(Document->GetDocumentID());
+}
+
+bool UJsonCRDTSyncManager::EvictResidentDocument(UJsonCRDTDocument* Document)
+{
+    const FString DocumentID = Document->GetDocumentID();
+
+    // 로컬 저장소가 유일한 사본이 되므로 저장하지 못하면 내리지 않음 (파일 쓰기는 다시 읽을 때 먼저 끝남)
+    if (!Document->SaveLocally())
     {
-        UE_LOG(LogTemp, Warning, TEXT("Document %s is already loaded"), *DocumentID);
-        return;
+        UE_LOG(LogTemp, Warning, TEXT("Failed to save document %s locally, keeping it resident"), *DocumentID);
+        return false;
     }
 
-    // Transport가 유효한지 확인
-    if (!Transport.IsValid())
+    Document->CaptureEvictedState(EvictedDocuments.Add(DocumentID));
+    Documents.Remove(DocumentID);
+
+    // 내려가 있는 동안의 패치는 다시 읽을 때 동기화 요청으로 받으므로 서버가 보내지 않게 하고, 전송 계층이 보관한 사본도 버림
+    if (Transport.IsValid())
     {
-        UE_LOG(LogTemp, Error, TEXT("Transport is not valid"));
-        return;
+        Transport->Unsubscribe(DocumentID);
+        Transport->ReleaseDocument(DocumentID);
     }
 
-    // 서버에서 문서 로드
-    Transport->LoadDocument(
-        DocumentID,
-        FOnDocumentLoaded::CreateUObject(this, &UJsonCRDTSyncManager::OnDocumentLoaded),
-        FOnTransportError::CreateUObject(this, &UJsonCRDTSyncManager::OnTransportError)
-    );
+    // 다시 읽은 문서는 변경 기록이 새로 시작되므로 다음 서버 저장은 전체 내용으로
+    ServerVersions.Remove(DocumentID);
+
+    UE_LOG(LogTemp, Log, TEXT("Document %s evicted to local storage"), *DocumentID);
+    return true;
 }
 
-void UJsonCRDTSyncManager::SaveDocument(UJsonCRDTDocument* Document)
+UJsonCRDTDocument* UJsonCRDTSyncManager::ReloadEvictedDocument(const FString& DocumentID)
 {
-    if (!Document)
+    FJsonCRDTEvictedState State;
+    if (!EvictedDocuments.RemoveAndCopyValue(DocumentID, State))
     {
-        UE_LOG(LogTemp, Error, TEXT("Cannot save null document"));
-        return;
+        return nullptr;
     }
 
-    // 항상 로컬에 먼저 저장
-    if (Document->SaveLocally())
+    UJsonCRDTDocument* Document = NewObject<UJsonCRDTDocument>(this);
+    Document->Initialize(DocumentID, this);
+    if (Logger.IsValid())
     {
-        UE_LOG(LogTemp, Log, TEXT("Document %s saved locally"), *Document->GetDocumentID());
+        Document->SetLogger(Logger);
     }
-    else
+
+    // 저장 형식을 먼저 되돌려야 내릴 때 쓴 파일을 읽음
+    Document->RestoreEvictedState(MoveTemp(State));
+    if (!Document->LoadFromLocal())
     {
-        UE_LOG(LogTemp, Warning, TEXT("Failed to save document %s locally"), *Document->GetDocumentID());
+        UE_LOG(LogTemp, Error, TEXT("Failed to reload evicted document %s from local storage"), *DocumentID);
+
+        // 로컬 사본을 잃었으면 서버에서 다시 받음 (도착하면 OnDocumentLoaded에서 추가)
+        if (Transport.IsValid())
+        {
+            LoadDocument(DocumentID);
+        }
+        return nullptr;
     }
 
-    // Transport가 유효한지 확인
-    if (!Transport.IsValid())
+    Documents.Add(DocumentID, Document);
+    SubscribeDocument(DocumentID);
+    UE_LOG(LogTemp, Verbose, TEXT("Document %s reloaded from local storage"), *DocumentID);
+
+    // 내려가 있는 동안 놓친 패치를 요청
+    if (!bOfflineMode && IsConnected())
     {
-        UE_LOG(LogTemp, Warning, TEXT("Transport is not valid, document %s saved locally only"), *Document->GetDocumentID());
-        return;
+        SyncDocument(Document);
     }
 
-    // 문서 데이터 생성
-    FJsonCRDTDocumentData DocumentData;
-    DocumentData.DocumentID = Document->GetDocumentID();
-    DocumentData.Version = Document->GetVersion();
-    DocumentData.Content = Document->GetContentAsString();
-    DocumentData.UpdatedAt = FDateTime::UtcNow();
-
-    // 서버에 문서 저장
-    Transport->SaveDocument(
-        DocumentData,
-        FOnDocumentSaved::CreateUObject(this, &UJsonCRDTSyncManager::OnDocumentSaved),
-        FOnTransportError::CreateUObject(this, &UJsonCRDTSyncManager::OnTransportError)
-    );
+    return Document;
 }
 
-void UJsonCRDTSyncManager::SyncDocument(UJsonCRDTDocument* Document)
+void UJsonCRDTSyncManager::SetDocumentSubscriptionPaths(const FString& DocumentID, const TArray<FString>& PathPrefixes)
 {
-    if (!Document)
+    if (PathPrefixes.Num() > 0)
     {
-        UE_LOG(LogTemp, Error, TEXT("Cannot sync null document"));
-        return;
+        SubscriptionPaths.Add(DocumentID, PathPrefixes);
     }
-
-    // Transport가 유효한지 확인
-    if (!Transport.IsValid())
+    else
     {
-        UE_LOG(LogTemp, Warning, TEXT("Transport is not valid, cannot sync document %s"), *Document->GetDocumentID());
-        return;
+        SubscriptionPaths.Remove(DocumentID);
     }
 
-    // 패치 생성 (빈 패치는 동기화 요청을 의미)
-    FJsonCRDTPatch SyncPatch;
-    SyncPatch.DocumentID = Document->GetDocumentID();
-    SyncPatch.BaseVersion = Document->GetVersion();
-    SyncPatch.ClientID = TEXT(""); // Transport에서 설정
-    SyncPatch.Timestamp = FDateTime::UtcNow();
-
-    // 패치 전송
-    Transport->SendPatch(
-        SyncPatch,
-        FOnPatchSent::CreateLambda([this](const FString& DocumentID) {
-            UE_LOG(LogTemp, Log, TEXT("Sync request sent for document %s"), *DocumentID);
-        }),
-        FOnTransportError::CreateUObject(this, &UJsonCRDTSyncManager::OnTransportError)
-    );
+    // 관리 중인 문서는 바로 경로를 바꾸고, 나머지는 만들거나 로드할 때 적용
+    if (Documents.Contains(DocumentID))
+    {
+        SubscribeDocument(DocumentID);
+    }
 }
 
-UJsonCRDTDocument* UJsonCRDTSyncManager::GetDocument(const FString& DocumentID)
+void UJsonCRDTSyncManager::SubscribeDocument(const FString& DocumentID)
 {
-    UJsonCRDTDocument** Document = Documents.Find(DocumentID);
-    return Document ? *Document : nullptr;
+    if (Transport.IsValid())
+    {
+        Transport->Subscribe(DocumentID, SubscriptionPaths.FindRef(DocumentID));
+    }
 }
 
 int32 UJsonCRDTSyncManager::RecoverAllDocuments()
 {
-    int32 RecoveredCount = 0;
-
-    // 모든 문서에 대해 반복
+    TArray<UJsonCRDTDocument*> DocumentsToRecover;
+    DocumentsToRecover.Reserve(Documents.Num());
     for (auto& Pair : Documents)
     {
-        UJsonCRDTDocument* Document = Pair.Value;
-        if (Document && Document->RecoverDocument())
+        if (Pair.Value)
+        {
+            DocumentsToRecover.Add(Pair.Value);
+        }
+    }
+
+    // 파일 읽기, 파싱, 저널 재생은 문서마다 독립적이므로 병렬로 수행 (대기 중인 쓰기는 먼저 한 번에 반영)
+    FJsonCRDTLocalStorageWriter::Get().Flush();
+    TArray<bool> LoadedFromLocal;
+    LoadedFromLocal.SetNumZeroed(DocumentsToRecover.Num());
+    ParallelFor(DocumentsToRecover.Num(), [&DocumentsToRecover, &LoadedFromLocal](int32 Index)
+    {
+        LoadedFromLocal[Index] = DocumentsToRecover[Index]->ReadFromLocal();
+    });
+
+    // 알림은 게임 스레드에서, 로컬 저장소를 읽지 못한 문서는 스냅샷으로 복구
+    int32 RecoveredCount = 0;
+    for (int32 Index = 0; Index < DocumentsToRecover.Num(); ++Index)
+    {
+        UJsonCRDTDocument* Document = DocumentsToRecover[Index];
+        if (LoadedFromLocal[Index])
+        {
+            Document->NotifyLoadedFromLocal(true);
+            RecoveredCount++;
+        }
+        else if (Document->RecoverFromSnapshot())
         {
             RecoveredCount++;
         }
@@ -182,6 +1369,120 @@ int32 UJsonCRDTSyncManager::RecoverAllDocuments()
 }
 
 void UJsonCRDTSyncManager::OnPatchReceived(const FJsonCRDTPatch& Patch)
+{
+    // 문서 상태를 건드리지 않는 검증만 수행하고 적용은 게임 스레드로 넘김
+    FString ValidationError;
+    if (!UJsonCRDTDocument::ValidatePatch(Patch, ValidationError))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Rejected patch for document %s: %s"), *Patch.DocumentID, *ValidationError);
+        return;
+    }
+
+    ReceivedPatches.Enqueue(Patch);
+    ++NumReceivedPatches;
+}
+
+void UJsonCRDTSyncManager::ProcessReceivedPatches()
+{
+    check(IsInGameThread());
+    JSONCRDT_SCOPE_CYCLE_COUNTER(STAT_JsonCRDT_ProcessReceivedPatches);
+
+    // 작업 스레드가 넣은 패치를 문서별로 모음 (같은 문서의 패치는 도착 순서를 유지)
+    FJsonCRDTPatch Patch;
+    while (ReceivedPatches.Dequeue(Patch))
+    {
+        --NumReceivedPatches;
+        FScheduledPatches& DocumentPatches = ScheduledPatches.FindOrAdd(Patch.DocumentID);
+        if (DocumentPatches.Head == DocumentPatches.Patches.Num())
+        {
+            ScheduledPatchDocumentIDs[static_cast<int32>(GetDocumentPriority(Patch.DocumentID))].Add(Patch.DocumentID);
+        }
+        DocumentPatches.Patches.Add(MoveTemp(Patch));
+        ++NumScheduledPatches;
+    }
+
+    // 높은 우선순위부터 각자의 예산 안에서 적용하고 남은 패치는 다음 틱으로 미룸 (큰 패치가 몰려도 우선순위별로 틱마다 최소 하나는 적용)
+    for (int32 Index = 0; Index < NumSyncPriorities; ++Index)
+    {
+        const float Budget = PriorityApplyBudgets[Index];
+        const double StartTime = FPlatformTime::Seconds();
+
+        // 적용 중의 이벤트에서 우선순위를 바꿀 수 있으므로 문서 목록은 매번 다시 읽음
+        TArray<FString>& DocumentIDs = ScheduledPatchDocumentIDs[Index];
+        while (DocumentIDs.Num() > 0)
+        {
+            const FString DocumentID = DocumentIDs[0];
+            FScheduledPatches& DocumentPatches = ScheduledPatches.FindChecked(DocumentID);
+            FJsonCRDTPatch Next = MoveTemp(DocumentPatches.Patches[DocumentPatches.Head++]);
+            if (DocumentPatches.Head == DocumentPatches.Patches.Num())
+            {
+                ScheduledPatches.Remove(DocumentID);
+                DocumentIDs.RemoveAt(0, 1, false);
+            }
+            --NumScheduledPatches;
+
+            ApplyReceivedPatch(MoveTemp(Next));
+
+            if (Budget >= 0.0f && FPlatformTime::Seconds() - StartTime >= Budget)
+            {
+                break;
+            }
+        }
+    }
+}
+
+void UJsonCRDTSyncManager::SetPatchApplyBudget(float Seconds)
+{
+    SetPriorityApplyBudget(EJsonCRDTSyncPriority::Normal, FMath::Max(0.0f, Seconds));
+}
+
+float UJsonCRDTSyncManager::GetPatchApplyBudget() const
+{
+    return GetPriorityApplyBudget(EJsonCRDTSyncPriority::Normal);
+}
+
+void UJsonCRDTSyncManager::SetPriorityApplyBudget(EJsonCRDTSyncPriority Priority, float Seconds)
+{
+    PriorityApplyBudgets[static_cast<int32>(Priority)] = Seconds < 0.0f ? -1.0f : Seconds;
+}
+
+float UJsonCRDTSyncManager::GetPriorityApplyBudget(EJsonCRDTSyncPriority Priority) const
+{
+    return PriorityApplyBudgets[static_cast<int32>(Priority)];
+}
+
+void UJsonCRDTSyncManager::SetDocumentPriority(const FString& DocumentID, EJsonCRDTSyncPriority Priority)
+{
+    const EJsonCRDTSyncPriority Previous = GetDocumentPriority(DocumentID);
+    if (Previous == Priority)
+    {
+        return;
+    }
+
+    if (Priority == EJsonCRDTSyncPriority::Normal)
+    {
+        DocumentPriorities.Remove(DocumentID);
+    }
+    else
+    {
+        DocumentPriorities.Add(DocumentID, Priority);
+    }
+
+    // 적용을 기다리는 패치는 새 우선순위의 차례를 따름 (미룬 저장은 보낼 때 정렬됨)
+    if (ScheduledPatches.Contains(DocumentID))
+    {
+        ScheduledPatchDocumentIDs[static_cast<int32>(Previous)].RemoveSingle(DocumentID);
+        ScheduledPatchDocumentIDs[static_cast<int32>(Priority)].Add(DocumentID);
+    }
+}
+
+EJsonCRDTSyncPriority UJsonCRDTSyncManager::GetDocumentPriority(const FString& DocumentID) const
+{
+    const EJsonCRDTSyncPriority* Priority = DocumentPriorities.Find(DocumentID);
+    return Priority ? *Priority : EJsonCRDTSyncPriority::Normal;
+}
+
+void UJsonCRDTSyncManager::ApplyReceivedPatch(FJsonCRDTPatch&& Patch)
 {
     // 문서 ID로 문서 찾기
     UJsonCRDTDocument* Document = GetDocument(Patch.DocumentID);
@@ -191,58 +1492,103 @@ void UJsonCRDTSyncManager::OnPatchReceived(const FJsonCRDTPatch& Patch)
         return;
     }
 
-    // 패치 적용
-    if (Document->ApplyPatch(Patch))
+    // 패치 적용 (작업을 복사하지 않고 문서의 히스토리와 변경 기록으로 옮김)
+    if (Document->ApplyPatch(MoveTemp(Patch)))
     {
-        UE_LOG(LogTemp, Log, TEXT("Applied patch to document %s"), *Patch.DocumentID);
+        UE_LOG(LogTemp, Verbose, TEXT("Applied patch to document %s"), *Document->GetDocumentID());
+        ++NumPatchesApplied;
+        ++PatchRateWindowCount;
 
-        // 문서 로컬 저장
-        Document->SaveLocally();
+        // 문서 로컬 저장 (연속된 패치는 한 번만 기록)
+        Document->RequestLocalSave();
 
         // 동기화 완료 이벤트 발생
-        OnSyncComplete.Broadcast(Patch.DocumentID);
+        OnSyncComplete.Broadcast(Document->GetDocumentID());
     }
     else
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to apply patch to document %s"), *Patch.DocumentID);
+        UE_LOG(LogTemp, Error, TEXT("Failed to apply patch to document %s"), *Document->GetDocumentID());
 
         // 문서 복구 시도
         if (Document->RecoverDocument())
         {
-            UE_LOG(LogTemp, Log, TEXT("Recovered document %s after patch failure"), *Patch.DocumentID);
+            UE_LOG(LogTemp, Log, TEXT("Recovered document %s after patch failure"), *Document->GetDocumentID());
         }
         else
         {
-            UE_LOG(LogTemp, Error, TEXT("Failed to recover document %s after patch failure"), *Patch.DocumentID);
+            UE_LOG(LogTemp, Error, TEXT("Failed to recover document %s after patch failure"), *Document->GetDocumentID());
         }
     }
 }
 
 void UJsonCRDTSyncManager::OnDocumentLoaded(const FJsonCRDTDocumentData& DocumentData)
 {
-    // 새 문서 생성
-    UJsonCRDTDocument* Document = NewObject<UJsonCRDTDocument>(this);
-    Document->Initialize(DocumentData.DocumentID, this);
-
-    // 문서 내용 설정
-    Document->SetContentFromString(DocumentData.Content);
+    OnDocumentsLoaded({ &DocumentData });
+}
 
-    // 문서를 맵에 추가
-    Documents.Add(DocumentData.DocumentID, Document);
+void UJsonCRDTSyncManager::OnDocumentsLoaded(const TArray<const FJsonCRDTDocumentData*>& LoadedData)
+{
+    // JSON 파싱은 문서마다 독립적이므로 병렬로 수행
+    TArray<FJsonCRDTNodeStore> Contents;
+    Contents.SetNum(LoadedData.Num());
+    TArray<bool> Parsed;
+    Parsed.SetNumZeroed(LoadedData.Num());
+    ParallelFor(LoadedData.Num(), [&LoadedData, &Contents, &Parsed](int32 Index)
+    {
+        Parsed[Index] = Contents[Index].LoadFromString(LoadedData[Index]->Content);
+    });
 
-    // 로거 설정
-    if (Logger.IsValid())
+    TArray<UJsonCRDTDocument*> LoadedDocuments;
+    LoadedDocuments.Reserve(LoadedData.Num());
+    for (int32 Index = 0; Index < LoadedData.Num(); ++Index)
     {
-        Document->SetLogger(Logger);
+        const FJsonCRDTDocumentData& DocumentData = *LoadedData[Index];
+
+        // 새 문서 생성
+        UJsonCRDTDocument* Document = NewObject<UJsonCRDTDocument>(this);
+        Document->Initialize(DocumentData.DocumentID, this);
+
+        // 문서 내용 설정
+        if (Parsed[Index])
+        {
+            // 서버 버전을 문서 버전으로 이어받아 이후 저장이 서버와 같은 번호로 전송되도록 함
+            Document->SetServerContent(MoveTemp(Contents[Index]), DocumentData.Version);
+        }
+
+        // 문서를 맵에 추가 (같은 ID로 내려 둔 문서는 서버에서 받은 문서로 대체)
+        Documents.Add(DocumentData.DocumentID, Document);
+        EvictedDocuments.Remove(DocumentData.DocumentID);
+        SubscribeDocument(DocumentData.DocumentID);
+
+        // 로거 설정
+        if (Logger.IsValid())
+        {
+            Document->SetLogger(Logger);
+        }
+
+        // 충돌 해결 전략 설정
+        Document->SetConflictStrategy(DefaultConflictStrategy);
+
+        LoadedDocuments.Add(Document);
     }
 
-    // 충돌 해결 전략 설정
-    Document->SetConflictStrategy(DefaultConflictStrategy);
+    // 문서 로컬 저장 (직렬화는 병렬로 수행)
+    ParallelFor(LoadedDocuments.Num(), [&LoadedDocuments](int32 Index)
+    {
+        LoadedDocuments[Index]->SaveLocally();
+    });
 
-    // 문서 로컬 저장
-    Document->SaveLocally();
+    for (int32 Index = 0; Index < LoadedDocuments.Num(); ++Index)
+    {
+        // 다음 저장은 서버에서 받은 버전 이후의 변경분만 전송 (내용을 받지 못한 문서는 다음 저장에서 전체 내용 전송)
+        UJsonCRDTDocument* Document = LoadedDocuments[Index];
+        if (Parsed[Index])
+        {
+            SetServerVersion(Document, Document->GetVersion(), Document->GetChangeLogGeneration());
+        }
 
-    UE_LOG(LogTemp, Log, TEXT("Document %s loaded successfully"), *DocumentData.DocumentID);
+        UE_LOG(LogTemp, Log, TEXT("Document %s loaded successfully"), *LoadedData[Index]->DocumentID);
+    }
 }
 
 void UJsonCRDTSyncManager::OnDocumentSaved(const FString& DocumentID)
@@ -276,23 +1622,33 @@ void UJsonCRDTSyncManager::SaveAllDocumentsLocally()
 {
     UE_LOG(LogTemp, Log, TEXT("Saving all documents locally"));
 
-    // 모든 문서에 대해 반복
+    TArray<UJsonCRDTDocument*> DocumentsToSave;
+    DocumentsToSave.Reserve(Documents.Num());
     for (auto& Pair : Documents)
     {
-        UJsonCRDTDocument* Document = Pair.Value;
-        if (Document)
+        if (Pair.Value)
         {
-            // 문서 로컬 저장
-            if (Document->SaveLocally())
-            {
-                UE_LOG(LogTemp, Log, TEXT("Document %s saved locally"), *Document->GetDocumentID());
-            }
-            else
-            {
-                UE_LOG(LogTemp, Warning, TEXT("Failed to save document %s locally"), *Document->GetDocumentID());
-            }
+            DocumentsToSave.Add(Pair.Value);
         }
     }
+
+    // 문서마다 상태가 독립적이므로 직렬화는 병렬로 수행하고, 파일 쓰기는 한 번에 모아서 처리
+    ParallelFor(DocumentsToSave.Num(), [&DocumentsToSave](int32 Index)
+    {
+        UJsonCRDTDocument* Document = DocumentsToSave[Index];
+        if (!Document->SaveLocally())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Failed to save document %s locally"), *Document->GetDocumentID());
+        }
+    });
+
+    FJsonCRDTLocalStorageWriter::Get().Flush();
+}
+
+void UJsonCRDTSyncManager::SetLocalSaveDebounce(float DebounceSeconds, float MaxDelaySeconds)
+{
+    LocalSaveDebounce = FMath::Max(0.0f, DebounceSeconds);
+    LocalSaveMaxDelay = FMath::Max(LocalSaveDebounce, MaxDelaySeconds);
 }
 
 void UJsonCRDTSyncManager::SetLogger(TSharedPtr<IJsonCRDTLogger> InLogger)
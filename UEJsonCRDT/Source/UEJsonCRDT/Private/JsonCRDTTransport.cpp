@@ -3,300 +3,1775 @@
 #include "JsonCRDTTransport.h"
 #include "HttpModule.h"
 #include "Interfaces/IHttpResponse.h"
-#include "JsonObjectConverter.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
 #include "WebSocketsModule.h"
+#include "IWebSocket.h"
 #include "Misc/Guid.h"
+#include "Misc/Compression.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/Crc.h"
+#include "JsonCRDTJournal.h"
+#include "JsonCRDTLocalStorageWriter.h"
+#include "JsonCRDTPatchParser.h"
+#include "JsonCRDTStats.h"
+
+namespace JsonCRDTTransport
+{
+    /** JSON 메시지에서 사용하는 작업 타입 이름 */
+    static const TCHAR* OperationTypeNames[] =
+    {
+        TEXT("add"),
+        TEXT("remove"),
+        TEXT("replace"),
+        TEXT("move"),
+        TEXT("copy"),
+        TEXT("test")
+    };
+
+    static const TCHAR* OperationTypeToString(EJsonCRDTOperationType Type)
+    {
+        const int32 Index = static_cast<int32>(Type);
+        return Index < UE_ARRAY_COUNT(OperationTypeNames) ? OperationTypeNames[Index] : TEXT("unknown");
+    }
+
+    static bool HasFromPath(EJsonCRDTOperationType Type)
+    {
+        return Type == EJsonCRDTOperationType::Move || Type == EJsonCRDTOperationType::Copy;
+    }
+
+    static bool HasValue(EJsonCRDTOperationType Type)
+    {
+        return Type == EJsonCRDTOperationType::Add
+            || Type == EJsonCRDTOperationType::Replace
+            || Type == EJsonCRDTOperationType::Test;
+    }
+
+    /** 이 크기 이상인 응답 본문은 작업 스레드에서 압축 해제와 파싱 */
+    static constexpr int32 AsyncParseThreshold = 16 * 1024;
+
+    /** 압축을 풀 수 있는 최대 본문 크기 */
+    static constexpr uint32 MaxDecompressedSize = 256 * 1024 * 1024;
+
+    /** 연결 후 인증 응답을 기다리는 최대 시간 (응답하지 않는 이전 서버는 이후 JSON으로 전송) */
+    static constexpr double HandshakeTimeoutSeconds = 2.0;
+
+    /** 재연결과 대기열 전송을 확인하는 주기 (초) */
+    static constexpr float ConnectionTickInterval = 0.1f;
+
+    /** 대기열을 다시 보낼 때 바이너리 프레임 하나에 담을 최대 작업 수 */
+    static constexpr int32 MaxOperationsPerReplayFrame = 1024;
+
+    /** 공통 헤더를 설정한 요청 생성 (연결은 HTTP 모듈이 호스트별로 재사용) */
+    static TSharedRef<IHttpRequest, ESPMode::ThreadSafe> CreateHttpRequest(const FString& URL, const TCHAR* Verb)
+    {
+        TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+        HttpRequest->SetURL(URL);
+        HttpRequest->SetVerb(Verb);
+        HttpRequest->SetHeader(TEXT("Accept"), TEXT("application/json"));
+        HttpRequest->SetHeader(TEXT("Accept-Encoding"), TEXT("gzip"));
+        HttpRequest->SetHeader(TEXT("Connection"), TEXT("keep-alive"));
+        return HttpRequest;
+    }
+
+    static TSharedRef<IHttpRequest, ESPMode::ThreadSafe> CreateDocumentRequest(const FString& ServerURL, const TCHAR* Verb, const FString& DocumentID)
+    {
+        return CreateHttpRequest(FString::Printf(TEXT("%s/documents/%s"), *ServerURL, *DocumentID), Verb);
+    }
+
+    /** 작업 배열을 JSON Patch 형식으로 기록 (값은 이미 JSON 텍스트이므로 중간 객체 없이 그대로 기록) */
+    static void WriteOperations(TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>& Writer, const TArray<FJsonCRDTOperation>& Operations)
+    {
+        Writer.WriteArrayStart(TEXT("operations"));
+        for (const FJsonCRDTOperation& Operation : Operations)
+        {
+            Writer.WriteObjectStart();
+            Writer.WriteValue(TEXT("op"), OperationTypeToString(Operation.Type));
+            Writer.WriteValue(TEXT("path"), Operation.Path);
+
+            // from 필드는 move와 copy 작업에만 필요
+            if (HasFromPath(Operation.Type))
+            {
+                Writer.WriteValue(TEXT("from"), Operation.FromPath);
+            }
+
+            // value 필드는 add, replace, test 작업에만 필요
+            if (HasValue(Operation.Type))
+            {
+                Writer.WriteRawJSONValue(TEXT("value"), Operation.Value.IsEmpty() ? FString(TEXT("null")) : Operation.Value);
+            }
+
+            Writer.WriteObjectEnd();
+        }
+        Writer.WriteArrayEnd();
+    }
+
+    /** 변경분 저장을 서버가 거절한 응답인지 여부 (기준 버전 불일치, 문서 없음, 경로 없음) */
+    static bool IsDeltaRejected(int32 ResponseCode)
+    {
+        return ResponseCode == 404 || ResponseCode == 405 || ResponseCode == 409 || ResponseCode == 412
+            || ResponseCode == 422 || ResponseCode == 501;
+    }
+
+    /** 여러 문서 경로가 없는 서버의 응답인지 여부 */
+    static bool IsMissingRoute(int32 ResponseCode)
+    {
+        return ResponseCode == 404 || ResponseCode == 405 || ResponseCode == 501;
+    }
+
+    static FString SerializeCondensed(const TSharedRef<FJsonObject>& Object)
+    {
+        FString Result;
+        TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Result);
+        FJsonSerializer::Serialize(Object, Writer);
+        return Result;
+    }
+
+    /** UTF-8 요청 본문 설정 (크기가 MinSize 이상이면 gzip 압축) */
+    static void SetRequestBody(IHttpRequest& Request, const FString& Body, bool bCompress, int32 MinSize)
+    {
+        Request.SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+
+        FTCHARToUTF8 Utf8(*Body, Body.Len());
+        if (bCompress && Utf8.Length() >= MinSize)
+        {
+            int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Gzip, Utf8.Length());
+            TArray<uint8> Compressed;
+            Compressed.SetNumUninitialized(CompressedSize);
+            if (FCompression::CompressMemory(NAME_Gzip, Compressed.GetData(), CompressedSize, Utf8.Get(), Utf8.Length()))
+            {
+                Compressed.SetNum(CompressedSize);
+                Request.SetHeader(TEXT("Content-Encoding"), TEXT("gzip"));
+                Request.SetContent(MoveTemp(Compressed));
+                return;
+            }
+        }
+
+        TArray<uint8> Bytes(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+        Request.SetContent(MoveTemp(Bytes));
+    }
+
+    /** 응답 본문을 문자열로 (gzip이면 압축 해제, HTTP 모듈이 이미 풀었으면 그대로 사용) */
+    static bool DecodeResponseBody(const TArray<uint8>& Content, const FString& ContentEncoding, FString& OutBody)
+    {
+        const uint8* Data = Content.GetData();
+        int32 Size = Content.Num();
+
+        TArray<uint8> Uncompressed;
+        if (ContentEncoding.Contains(TEXT("gzip")) && Size >= 18 && Data[0] == 0x1f && Data[1] == 0x8b)
+        {
+            // gzip 꼬리의 마지막 4바이트가 원래 크기
+            const uint32 UncompressedSize = static_cast<uint32>(Data[Size - 4])
+                | (static_cast<uint32>(Data[Size - 3]) << 8)
+                | (static_cast<uint32>(Data[Size - 2]) << 16)
+                | (static_cast<uint32>(Data[Size - 1]) << 24);
+            if (UncompressedSize > MaxDecompressedSize)
+            {
+                return false;
+            }
+
+            Uncompressed.SetNumUninitialized(static_cast<int32>(UncompressedSize));
+            if (!FCompression::UncompressMemory(NAME_Gzip, Uncompressed.GetData(), Uncompressed.Num(), Data, Size))
+            {
+                return false;
+            }
+            Data = Uncompressed.GetData();
+            Size = Uncompressed.Num();
+        }
+
+        FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data), Size);
+        OutBody = FString(Converted.Length(), Converted.Get());
+        return true;
+    }
+
+    /** 응답 본문을 JSON 객체로 (gzip이면 압축 해제) */
+    static TSharedPtr<FJsonObject> ParseResponseObject(const TArray<uint8>& Content, const FString& ContentEncoding)
+    {
+        FString Body;
+        if (!DecodeResponseBody(Content, ContentEncoding, Body))
+        {
+            return nullptr;
+        }
+
+        TSharedPtr<FJsonObject> JsonObject;
+        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Body);
+        if (!FJsonSerializer::Deserialize(Reader, JsonObject))
+        {
+            return nullptr;
+        }
+        return JsonObject;
+    }
+
+    /** 문서 JSON 객체 해석 (content는 JSON 문자열과 JSON 값 모두 허용) */
+    static void ParseDocumentObject(const FJsonObject& JsonObject, const FString& DocumentID, FJsonCRDTDocumentData& OutData)
+    {
+        OutData.DocumentID = DocumentID;
+
+        // 문서 내용 가져오기
+        const TSharedPtr<FJsonValue> ContentValue = JsonObject.TryGetField(TEXT("content"));
+        if (ContentValue.IsValid())
+        {
+            if (ContentValue->Type == EJson::String)
+            {
+                OutData.Content = ContentValue->AsString();
+            }
+            else if (ContentValue->Type == EJson::Object || ContentValue->Type == EJson::Array)
+            {
+                TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutData.Content);
+                FJsonSerializer::Serialize(ContentValue, FString(), Writer);
+            }
+        }
+
+        // 문서 버전 가져오기
+        int64 Version = 1;
+        if (JsonObject.TryGetNumberField(TEXT("version"), Version))
+        {
+            OutData.Version = Version;
+        }
+
+        // 생성 시간 가져오기
+        FString CreatedAtStr;
+        if (JsonObject.TryGetStringField(TEXT("createdAt"), CreatedAtStr))
+        {
+            FDateTime::Parse(CreatedAtStr, OutData.CreatedAt);
+        }
+
+        // 수정 시간 가져오기
+        FString UpdatedAtStr;
+        if (JsonObject.TryGetStringField(TEXT("updatedAt"), UpdatedAtStr))
+        {
+            FDateTime::Parse(UpdatedAtStr, OutData.UpdatedAt);
+        }
+    }
+
+    /** 저장할 문서의 JSON 객체 생성 (id와 clientId는 호출한 쪽에서 추가) */
+    static TSharedRef<FJsonObject> BuildDocumentObject(const FJsonCRDTDocumentData& DocumentData, bool bContentAsObject)
+    {
+        TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+
+        // 내용을 JSON 값 그대로 보내면 문자열 안의 문자열로 이스케이프하지 않아도 됨
+        TSharedPtr<FJsonValue> ContentValue;
+        if (bContentAsObject)
+        {
+            TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(DocumentData.Content);
+            if (!FJsonSerializer::Deserialize(Reader, ContentValue))
+            {
+                ContentValue.Reset();
+            }
+        }
+        if (ContentValue.IsValid())
+        {
+            Object->SetField(TEXT("content"), ContentValue);
+        }
+        else
+        {
+            Object->SetStringField(TEXT("content"), DocumentData.Content);
+        }
+        Object->SetNumberField(TEXT("version"), DocumentData.Version);
+        Object->SetStringField(TEXT("updatedAt"), DocumentData.UpdatedAt.ToString());
+        return Object;
+    }
+
+    /** 여러 문서 응답의 "errors" 객체 (문서 ID -> 오류 메시지) 읽기 */
+    static void ParseBatchErrors(const FJsonObject& JsonObject, TMap<FString, FString>& OutErrors)
+    {
+        const TSharedPtr<FJsonObject>* Errors = nullptr;
+        if (JsonObject.TryGetObjectField(TEXT("errors"), Errors))
+        {
+            for (const TPair<FString, TSharedPtr<FJsonValue>>& Error : (*Errors)->Values)
+            {
+                OutErrors.Add(Error.Key, Error.Value.IsValid() ? Error.Value->AsString() : FString());
+            }
+        }
+    }
+
+    /** 여러 문서 로드 응답 */
+    struct FBatchLoadResponse
+    {
+        /** 받은 문서와 각 문서의 ETag */
+        TArray<FJsonCRDTDocumentData> Documents;
+        TArray<FString> ETags;
+
+        /** 보낸 ETag와 같아서 내용 없이 온 문서 ID */
+        TArray<FString> NotModified;
+
+        /** 서버가 알려준 문서별 오류 */
+        TMap<FString, FString> Errors;
+    };
+
+    static bool ParseBatchLoadResponse(const TArray<uint8>& Content, const FString& ContentEncoding, FBatchLoadResponse& OutResponse)
+    {
+        const TSharedPtr<FJsonObject> JsonObject = ParseResponseObject(Content, ContentEncoding);
+        if (!JsonObject.IsValid())
+        {
+            return false;
+        }
+
+        const TArray<TSharedPtr<FJsonValue>>* Documents = nullptr;
+        if (JsonObject->TryGetArrayField(TEXT("documents"), Documents))
+        {
+            for (const TSharedPtr<FJsonValue>& Value : *Documents)
+            {
+                const TSharedPtr<FJsonObject>* Document = nullptr;
+                FString DocumentID;
+                if (!Value.IsValid() || !Value->TryGetObject(Document) || !(*Document)->TryGetStringField(TEXT("id"), DocumentID))
+                {
+                    continue;
+                }
+
+                ParseDocumentObject(**Document, DocumentID, OutResponse.Documents.AddDefaulted_GetRef());
+                FString& ETag = OutResponse.ETags.AddDefaulted_GetRef();
+                (*Document)->TryGetStringField(TEXT("etag"), ETag);
+            }
+        }
+
+        JsonObject->TryGetStringArrayField(TEXT("notModified"), OutResponse.NotModified);
+        ParseBatchErrors(*JsonObject, OutResponse.Errors);
+        return true;
+    }
+
+    /**
+     * 응답 본문 파싱 후 게임 스레드에서 Finish 호출 (큰 본문은 게임 스레드를 막지 않도록 작업 스레드에서 파싱)
+     * Finish는 스레드 안전하지 않은 캐시 참조와 콜백을 잡고 있으므로 게임 스레드에서만 만들고 호출하고 지움.
+     * 작업 스레드로는 본문과 Parse만 넘기고, Finish는 소유 포인터째로 옮길 뿐 복사하거나 소멸시키지 않음.
+     */
+    template <typename ResultType, typename ParseType, typename FinishType>
+    static void ParseResponse(const TCHAR* DebugName, const FHttpResponsePtr& Response, ParseType&& Parse, FinishType&& Finish)
+    {
+        const FString ContentEncoding = Response->GetHeader(TEXT("Content-Encoding"));
+        if (Response->GetContent().Num() < AsyncParseThreshold)
+        {
+            ResultType Result;
+            const bool bParsed = Parse(Response->GetContent(), ContentEncoding, Result);
+            Finish(bParsed, MoveTemp(Result));
+            return;
+        }
+
+        TUniquePtr<TFunction<void(bool, ResultType&&)>> OwnedFinish = MakeUnique<TFunction<void(bool, ResultType&&)>>(Forward<FinishType>(Finish));
+        UE::Tasks::Launch(DebugName, [Parse = Forward<ParseType>(Parse), OwnedFinish = MoveTemp(OwnedFinish), Content = Response->GetContent(), ContentEncoding]() mutable
+        {
+            ResultType Result;
+            const bool bParsed = Parse(Content, ContentEncoding, Result);
+            AsyncTask(ENamedThreads::GameThread, [OwnedFinish = MoveTemp(OwnedFinish), bParsed, Result = MoveTemp(Result)]() mutable
+            {
+                (*OwnedFinish)(bParsed, MoveTemp(Result));
+            });
+        });
+    }
+
+    /** 요청마다 최대 MaxInFlight개씩 동시에 보내는 실행 상태 (게임 스레드에서만 사용) */
+    struct FParallelRequests
+    {
+        int32 NumRequests = 0;
+        int32 NextIndex = 0;
+        int32 NumInFlight = 0;
+        int32 MaxInFlight = 1;
+
+        /** 요청 시작 중인지 여부 (바로 끝나는 요청이 다시 들어와도 반복문 하나에서 시작) */
+        bool bStarting = false;
+
+        /** Index번째 요청 시작 (요청이 끝나면 OnDone 호출) */
+        TFunction<void(int32 Index, const TFunction<void()>& OnDone)> StartRequest;
+    };
+
+    static void RunParallelRequests(const TSharedRef<FParallelRequests>& State)
+    {
+        if (State->bStarting)
+        {
+            return;
+        }
+
+        State->bStarting = true;
+        while (State->NumInFlight < State->MaxInFlight && State->NextIndex < State->NumRequests)
+        {
+            ++State->NumInFlight;
+            State->StartRequest(State->NextIndex++, [State]()
+            {
+                --State->NumInFlight;
+                RunParallelRequests(State);
+            });
+        }
+        State->bStarting = false;
+    }
+
+    /** 문서별 로드 결과를 모아 마지막 결과에서 완료 콜백 호출 */
+    struct FLoadResults
+    {
+        TArray<FJsonCRDTDocumentData> Documents;
+        TMap<FString, FString> Errors;
+        int32 NumPending = 0;
+        FOnDocumentsLoaded OnCompleted;
+
+        void CompleteOne()
+        {
+            if (--NumPending == 0)
+            {
+                OnCompleted.ExecuteIfBound(Documents, Errors);
+            }
+        }
+    };
+
+    /** 문서별 저장 결과를 모아 마지막 결과에서 완료 콜백 호출 */
+    struct FSaveResults
+    {
+        TArray<FString> SavedDocumentIDs;
+        TMap<FString, FString> Errors;
+        int32 NumPending = 0;
+        FOnDocumentsSaved OnCompleted;
+
+        void CompleteOne()
+        {
+            if (--NumPending == 0)
+            {
+                OnCompleted.ExecuteIfBound(SavedDocumentIDs, Errors);
+            }
+        }
+    };
+
+    /** 문서마다 Load를 호출해 결과를 모음 (동시에 최대 MaxInFlight개) */
+    static void LoadEach(const TArray<FString>& DocumentIDs, int32 MaxInFlight, const FOnDocumentsLoaded& OnCompleted, TFunction<void(const FString&, const FOnDocumentLoaded&, const FOnTransportError&)>&& Load)
+    {
+        if (DocumentIDs.Num() == 0)
+        {
+            OnCompleted.ExecuteIfBound(TArray<FJsonCRDTDocumentData>(), TMap<FString, FString>());
+            return;
+        }
+
+        TSharedRef<FLoadResults> Results = MakeShared<FLoadResults>();
+        Results->NumPending = DocumentIDs.Num();
+        Results->OnCompleted = OnCompleted;
+
+        TSharedRef<FParallelRequests> Requests = MakeShared<FParallelRequests>();
+        Requests->NumRequests = DocumentIDs.Num();
+        Requests->MaxInFlight = FMath::Max(1, MaxInFlight);
+        Requests->StartRequest = [DocumentIDs, Results, Load = MoveTemp(Load)](int32 Index, const TFunction<void()>& OnDone)
+        {
+            Load(
+                DocumentIDs[Index],
+                FOnDocumentLoaded::CreateLambda([Results, OnDone](const FJsonCRDTDocumentData& DocumentData)
+                {
+                    Results->Documents.Add(DocumentData);
+                    OnDone();
+                    Results->CompleteOne();
+                }),
+                FOnTransportError::CreateLambda([Results, OnDone](const FString& DocumentID, const FString& ErrorMessage)
+                {
+                    Results->Errors.Add(DocumentID, ErrorMessage);
+                    OnDone();
+                    Results->CompleteOne();
+                })
+            );
+        };
+        RunParallelRequests(Requests);
+    }
+
+    /** 문서마다 Save를 호출해 결과를 모음 (동시에 최대 MaxInFlight개) */
+    static void SaveEach(const TArray<FJsonCRDTDocumentData>& Documents, int32 MaxInFlight, const FOnDocumentsSaved& OnCompleted, TFunction<void(const FJsonCRDTDocumentData&, const FOnDocumentSaved&, const FOnTransportError&)>&& Save)
+    {
+        if (Documents.Num() == 0)
+        {
+            OnCompleted.ExecuteIfBound(TArray<FString>(), TMap<FString, FString>());
+            return;
+        }
+
+        TSharedRef<FSaveResults> Results = MakeShared<FSaveResults>();
+        Results->NumPending = Documents.Num();
+        Results->OnCompleted = OnCompleted;
+
+        TSharedRef<FParallelRequests> Requests = MakeShared<FParallelRequests>();
+        Requests->NumRequests = Documents.Num();
+        Requests->MaxInFlight = FMath::Max(1, MaxInFlight);
+        Requests->StartRequest = [Documents, Results, Save = MoveTemp(Save)](int32 Index, const TFunction<void()>& OnDone)
+        {
+            Save(
+                Documents[Index],
+                FOnDocumentSaved::CreateLambda([Results, OnDone](const FString& DocumentID)
+                {
+                    Results->SavedDocumentIDs.Add(DocumentID);
+                    OnDone();
+                    Results->CompleteOne();
+                }),
+                FOnTransportError::CreateLambda([Results, OnDone](const FString& DocumentID, const FString& ErrorMessage)
+                {
+                    Results->Errors.Add(DocumentID, ErrorMessage);
+                    OnDone();
+                    Results->CompleteOne();
+                })
+            );
+        };
+        RunParallelRequests(Requests);
+    }
+}
+
+void IJsonCRDTTransport::LoadDocuments(const TArray<FString>& DocumentIDs, const FOnDocumentsLoaded& OnCompleted)
+{
+    // 요청은 모두 이 호출 안에서 시작하므로 콜백이 this를 붙잡지 않음
+    JsonCRDTTransport::LoadEach(DocumentIDs, MAX_int32, OnCompleted, [this](const FString& DocumentID, const FOnDocumentLoaded& OnLoaded, const FOnTransportError& OnError)
+    {
+        LoadDocument(DocumentID, OnLoaded, OnError);
+    });
+}
+
+void IJsonCRDTTransport::SaveDocuments(const TArray<FJsonCRDTDocumentData>& Documents, const FOnDocumentsSaved& OnCompleted)
+{
+    JsonCRDTTransport::SaveEach(Documents, MAX_int32, OnCompleted, [this](const FJsonCRDTDocumentData& DocumentData, const FOnDocumentSaved& OnSaved, const FOnTransportError& OnError)
+    {
+        SaveDocument(DocumentData, OnSaved, OnError);
+    });
+}
 
 FDefaultJsonCRDTTransport::FDefaultJsonCRDTTransport(const FString& InServerURL, const FString& InWebSocketURL)
     : ServerURL(InServerURL)
     , WebSocketURL(InWebSocketURL)
+    , DecodePipe(TEXT("JsonCRDTTransportDecode"))
+    , DocumentCache(MakeShared<FDocumentCache>())
+    , bBatchRouteSupported(MakeShared<bool>(true))
+    , bDeltaRouteSupported(MakeShared<bool>(true))
+    , Traffic(MakeShared<FTrafficCounters, ESPMode::ThreadSafe>())
+{
+    // 고유 클라이언트 ID 생성
+    ClientID = GenerateClientID();
+
+    // 이전 실행에서 보내지 못한 패치를 서버별 파일에서 읽어 옴
+    OfflineQueueFile = FPaths::ProjectSavedDir() / TEXT("JsonCRDT") / FString::Printf(TEXT("Outbox-%08x.journal"), FCrc::StrCrc32(*WebSocketURL));
+    LoadOfflineQueue();
+
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateRaw(this, &FDefaultJsonCRDTTransport::TickConnection),
+        JsonCRDTTransport::ConnectionTickInterval);
+}
+
+FDefaultJsonCRDTTransport::~FDefaultJsonCRDTTransport()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+    // 소멸 중에는 연결 해제를 알리지 않음
+    OnConnectionStatusChangedDelegate.Unbind();
+    Disconnect();
+
+    // 디코딩 작업이 this를 참조하므로 모두 끝날 때까지 대기
+    DecodePipe.WaitUntilEmpty();
+}
+
+FDefaultJsonCRDTTransport::FRequestOptions FDefaultJsonCRDTTransport::GetRequestOptions() const
+{
+    FRequestOptions Options;
+    Options.ServerURL = ServerURL;
+    Options.ClientID = ClientID;
+    Options.bContentAsObject = bContentAsObject;
+    Options.bCompressRequests = bCompressRequests;
+    Options.CompressionMinSize = CompressionMinSize;
+    Options.MaxParallelRequests = MaxParallelRequests;
+    Options.bBatchRouteSupported = bBatchRouteSupported;
+    Options.Traffic = Traffic;
+    return Options;
+}
+
+void FDefaultJsonCRDTTransport::ProcessHttpRequest(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& HttpRequest, const TSharedRef<FTrafficCounters, ESPMode::ThreadSafe>& Counters)
+{
+    const int64 RequestBytes = static_cast<int64>(HttpRequest->GetContentLength());
+    Counters->BytesSent += RequestBytes;
+    INC_DWORD_STAT_BY(STAT_JsonCRDT_BytesSent, RequestBytes);
+
+    // 설정된 완료 콜백을 감싸 응답 본문 크기를 먼저 더함
+    const FHttpRequestCompleteDelegate OnComplete = HttpRequest->OnProcessRequestComplete();
+    HttpRequest->OnProcessRequestComplete().BindLambda([OnComplete, Counters](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSucceeded)
+    {
+        if (Response.IsValid())
+        {
+            const int64 ResponseBytes = Response->GetContent().Num();
+            Counters->BytesReceived += ResponseBytes;
+            INC_DWORD_STAT_BY(STAT_JsonCRDT_BytesReceived, ResponseBytes);
+        }
+        OnComplete.ExecuteIfBound(Request, Response, bSucceeded);
+    });
+
+    HttpRequest->ProcessRequest();
+}
+
+FJsonCRDTTransportStats FDefaultJsonCRDTTransport::GetStats() const
+{
+    FJsonCRDTTransportStats Stats;
+    Stats.BytesSent = Traffic->BytesSent.load();
+    Stats.BytesReceived = Traffic->BytesReceived.load();
+    Stats.PatchesSent = Traffic->PatchesSent.load();
+    Stats.PatchesReceived = Traffic->PatchesReceived.load();
+    Stats.QueuedOperations = NumQueuedOperations;
+    return Stats;
+}
+
+void FDefaultJsonCRDTTransport::LoadDocument(const FString& DocumentID, const FOnDocumentLoaded& OnLoaded, const FOnTransportError& OnError)
+{
+    SendLoadRequest(GetRequestOptions(), DocumentCache, DocumentID, OnLoaded, OnError);
+}
+
+void FDefaultJsonCRDTTransport::SendLoadRequest(const FRequestOptions& Options, const TSharedRef<FDocumentCache>& Cache, const FString& DocumentID, const FOnDocumentLoaded& OnLoaded, const FOnTransportError& OnError)
+{
+    using namespace JsonCRDTTransport;
+
+    // HTTP 요청 생성
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = CreateDocumentRequest(Options.ServerURL, TEXT("GET"), DocumentID);
+
+    // 이전에 받은 문서가 있으면 바뀌었을 때만 내용을 받음
+    if (const FCachedDocument* Cached = Cache->Find(DocumentID))
+    {
+        HttpRequest->SetHeader(TEXT("If-None-Match"), Cached->ETag);
+    }
+
+    // 응답 처리 콜백 설정
+    HttpRequest->OnProcessRequestComplete().BindLambda([Options, DocumentID, OnLoaded, OnError, Cache](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSucceeded)
+    {
+        if (!bSucceeded || !Response.IsValid())
+        {
+            OnError.ExecuteIfBound(DocumentID, TEXT("No response from server"));
+            return;
+        }
+
+        // 바뀌지 않은 문서는 보관한 내용 사용 (요청한 사이 캐시에서 밀려났으면 검증 없이 다시 요청)
+        if (Response->GetResponseCode() == 304)
+        {
+            if (const FCachedDocument* Cached = Cache->Find(DocumentID))
+            {
+                OnLoaded.ExecuteIfBound(Cached->Data);
+            }
+            else
+            {
+                SendLoadRequest(Options, Cache, DocumentID, OnLoaded, OnError);
+            }
+            return;
+        }
+
+        if (Response->GetResponseCode() != 200)
+        {
+            OnError.ExecuteIfBound(DocumentID, FString::Printf(TEXT("Server error: %d, %s"), Response->GetResponseCode(), *Response->GetContentAsString()));
+            return;
+        }
+
+        // 게임 스레드에서 캐시를 갱신하고 로드 완료 콜백 호출
+        auto Finish = [DocumentID, OnLoaded, OnError, Cache, ETag = Response->GetHeader(TEXT("ETag"))](bool bParsed, FJsonCRDTDocumentData&& DocumentData)
+        {
+            if (!bParsed)
+            {
+                OnError.ExecuteIfBound(DocumentID, TEXT("Failed to parse response"));
+                return;
+            }
+
+            OnLoaded.ExecuteIfBound(DocumentData);
+            Cache->Add(ETag, MoveTemp(DocumentData));
+        };
+
+        // 응답 파싱 (작업 스레드로 넘어가는 것은 문서 ID와 본문뿐)
+        auto Parse = [DocumentID](const TArray<uint8>& Content, const FString& ContentEncoding, FJsonCRDTDocumentData& OutData)
+        {
+            const TSharedPtr<FJsonObject> JsonObject = ParseResponseObject(Content, ContentEncoding);
+            if (!JsonObject.IsValid())
+            {
+                return false;
+            }
+            ParseDocumentObject(*JsonObject, DocumentID, OutData);
+            return true;
+        };
+        ParseResponse<FJsonCRDTDocumentData>(TEXT("JsonCRDTParseDocument"), Response, MoveTemp(Parse), MoveTemp(Finish));
+    });
+
+    // 요청 전송
+    ProcessHttpRequest(HttpRequest, Options.Traffic.ToSharedRef());
+}
+
+void FDefaultJsonCRDTTransport::SaveDocument(const FJsonCRDTDocumentData& DocumentData, const FOnDocumentSaved& OnSaved, const FOnTransportError& OnError)
+{
+    SendSaveRequest(GetRequestOptions(), DocumentCache, DocumentData, OnSaved, OnError);
+}
+
+void FDefaultJsonCRDTTransport::SendSaveRequest(const FRequestOptions& Options, const TSharedRef<FDocumentCache>& Cache, const FJsonCRDTDocumentData& DocumentData, const FOnDocumentSaved& OnSaved, const FOnTransportError& OnError)
+{
+    using namespace JsonCRDTTransport;
+
+    // HTTP 요청 생성
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = CreateDocumentRequest(Options.ServerURL, TEXT("PUT"), DocumentData.DocumentID);
+
+    // 요청 본문 생성
+    TSharedRef<FJsonObject> RequestBody = BuildDocumentObject(DocumentData, Options.bContentAsObject);
+    RequestBody->SetStringField(TEXT("clientId"), Options.ClientID);
+    SetRequestBody(*HttpRequest, SerializeCondensed(RequestBody), Options.bCompressRequests, Options.CompressionMinSize);
+
+    // 응답 처리 콜백 설정
+    HttpRequest->OnProcessRequestComplete().BindLambda([DocumentData, OnSaved, OnError, Cache](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSucceeded)
+    {
+        if (!bSucceeded || !Response.IsValid())
+        {
+            OnError.ExecuteIfBound(DocumentData.DocumentID, TEXT("No response from server"));
+            return;
+        }
+
+        if (Response->GetResponseCode() != 200)
+        {
+            OnError.ExecuteIfBound(DocumentData.DocumentID, FString::Printf(TEXT("Server error: %d, %s"), Response->GetResponseCode(), *Response->GetContentAsString()));
+            return;
+        }
+
+        // 서버가 새 ETag를 알려주면 저장한 내용을 다음 로드의 검증용으로 보관
+        Cache->Add(Response->GetHeader(TEXT("ETag")), DocumentData);
+
+        // 저장 완료 콜백 호출
+        OnSaved.ExecuteIfBound(DocumentData.DocumentID);
+    });
+
+    // 요청 전송
+    ProcessHttpRequest(HttpRequest, Options.Traffic.ToSharedRef());
+}
+
+void FDefaultJsonCRDTTransport::SaveDocumentDelta(const FJsonCRDTPatch& Delta, int64 Version, const FOnDocumentSaved& OnSaved, const FOnDocumentDeltaRejected& OnRejected, const FOnTransportError& OnError)
+{
+    using namespace JsonCRDTTransport;
+
+    // 변경분 저장을 지원하지 않는 서버는 요청 없이 바로 전체 저장으로
+    if (!*bDeltaRouteSupported)
+    {
+        OnRejected.ExecuteIfBound(Delta.DocumentID);
+        return;
+    }
+
+    // HTTP 요청 생성
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = CreateDocumentRequest(ServerURL, TEXT("PATCH"), Delta.DocumentID);
+
+    // 요청 본문 생성 (서버는 자신의 버전이 baseVersion일 때만 작업을 적용)
+    FString RequestBodyString;
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&RequestBodyString);
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("clientId"), ClientID);
+    Writer->WriteValue(TEXT("baseVersion"), Delta.BaseVersion);
+    Writer->WriteValue(TEXT("version"), Version);
+    Writer->WriteValue(TEXT("updatedAt"), Delta.Timestamp.ToString());
+    WriteOperations(*Writer, Delta.Operations);
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    SetRequestBody(*HttpRequest, RequestBodyString, bCompressRequests, CompressionMinSize);
+
+    // 응답 처리 콜백 설정
+    HttpRequest->OnProcessRequestComplete().BindLambda([DocumentID = Delta.DocumentID, OnSaved, OnRejected, OnError, Cache = DocumentCache, bSupported = bDeltaRouteSupported](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSucceeded)
+    {
+        if (!bSucceeded || !Response.IsValid())
+        {
+            OnError.ExecuteIfBound(DocumentID, TEXT("No response from server"));
+            return;
+        }
+
+        const int32 ResponseCode = Response->GetResponseCode();
+        if (IsDeltaRejected(ResponseCode))
+        {
+            if (ResponseCode == 405 || ResponseCode == 501)
+            {
+                *bSupported = false;
+            }
+            OnRejected.ExecuteIfBound(DocumentID);
+            return;
+        }
+
+        if (ResponseCode != 200)
+        {
+            OnError.ExecuteIfBound(DocumentID, FString::Printf(TEXT("Server error: %d, %s"), ResponseCode, *Response->GetContentAsString()));
+            return;
+        }
+
+        // 저장 후 내용은 보관하지 않았으므로 이전 ETag로 검증하지 않음
+        Cache->Remove(DocumentID);
+
+        // 저장 완료 콜백 호출
+        OnSaved.ExecuteIfBound(DocumentID);
+    });
+
+    // 요청 전송
+    ProcessHttpRequest(HttpRequest, Traffic);
+}
+
+void FDefaultJsonCRDTTransport::LoadDocuments(const TArray<FString>& DocumentIDs, const FOnDocumentsLoaded& OnCompleted)
+{
+    using namespace JsonCRDTTransport;
+
+    const FRequestOptions Options = GetRequestOptions();
+    if (DocumentIDs.Num() <= 1 || !*bBatchRouteSupported)
+    {
+        LoadInParallel(Options, DocumentCache, DocumentIDs, OnCompleted);
+        return;
+    }
+
+    // 요청 본문 생성 (보관한 ETag를 함께 보내 바뀌지 않은 문서는 내용 없이 받음)
+    TSharedRef<FJsonObject> RequestBody = MakeShared<FJsonObject>();
+    TArray<TSharedPtr<FJsonValue>> IDValues;
+    TSharedRef<FJsonObject> ETags = MakeShared<FJsonObject>();
+    for (const FString& DocumentID : DocumentIDs)
+    {
+        IDValues.Add(MakeShared<FJsonValueString>(DocumentID));
+        if (const FCachedDocument* Cached = DocumentCache->Find(DocumentID))
+        {
+            ETags->SetStringField(DocumentID, Cached->ETag);
+        }
+    }
+    RequestBody->SetArrayField(TEXT("ids"), IDValues);
+    RequestBody->SetObjectField(TEXT("etags"), ETags);
+
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = CreateHttpRequest(FString::Printf(TEXT("%s/documents/batch/load"), *ServerURL), TEXT("POST"));
+    SetRequestBody(*HttpRequest, SerializeCondensed(RequestBody), bCompressRequests, CompressionMinSize);
+
+    // 응답 처리 콜백 설정
+    HttpRequest->OnProcessRequestComplete().BindLambda([Options, DocumentIDs, OnCompleted, Cache = DocumentCache](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSucceeded)
+    {
+        auto FailAll = [&DocumentIDs, &OnCompleted](const FString& ErrorMessage)
+        {
+            TMap<FString, FString> Errors;
+            for (const FString& DocumentID : DocumentIDs)
+            {
+                Errors.Add(DocumentID, ErrorMessage);
+            }
+            OnCompleted.ExecuteIfBound(TArray<FJsonCRDTDocumentData>(), Errors);
+        };
+
+        if (!bSucceeded || !Response.IsValid())
+        {
+            FailAll(TEXT("No response from server"));
+            return;
+        }
+
+        // 여러 문서 경로가 없는 서버는 이후로 문서별 요청 사용
+        if (IsMissingRoute(Response->GetResponseCode()))
+        {
+            UE_LOG(LogTemp, Log, TEXT("Server has no batch document route, loading %d documents individually"), DocumentIDs.Num());
+            *Options.bBatchRouteSupported = false;
+            LoadInParallel(Options, Cache, DocumentIDs, OnCompleted);
+            return;
+        }
+
+        if (Response->GetResponseCode() != 200)
+        {
+            FailAll(FString::Printf(TEXT("Server error: %d, %s"), Response->GetResponseCode(), *Response->GetContentAsString()));
+            return;
+        }
+
+        // 게임 스레드에서 캐시를 갱신하고 완료 콜백 호출
+        auto Finish = [DocumentIDs, OnCompleted, Cache](bool bParsed, FBatchLoadResponse&& Parsed)
+        {
+            TMap<FString, FString> Errors = MoveTemp(Parsed.Errors);
+            if (!bParsed)
+            {
+                for (const FString& DocumentID : DocumentIDs)
+                {
+                    Errors.Add(DocumentID, TEXT("Failed to parse response"));
+                }
+                OnCompleted.ExecuteIfBound(TArray<FJsonCRDTDocumentData>(), Errors);
+                return;
+            }
+
+            TArray<FJsonCRDTDocumentData> Documents = MoveTemp(Parsed.Documents);
+            TSet<FString> Answered;
+            for (int32 Index = 0; Index < Documents.Num(); ++Index)
+            {
+                const FJsonCRDTDocumentData& DocumentData = Documents[Index];
+                Answered.Add(DocumentData.DocumentID);
+                Cache->Add(Parsed.ETags[Index], DocumentData);
+            }
+
+            for (const FString& DocumentID : Parsed.NotModified)
+            {
+                Answered.Add(DocumentID);
+                if (const FCachedDocument* Cached = Cache->Find(DocumentID))
+                {
+                    Documents.Add(Cached->Data);
+                }
+                else
+                {
+                    Errors.Add(DocumentID, TEXT("Server reported a document that is not cached as not modified"));
+                }
+            }
+
+            // 응답에 빠진 문서는 실패로 처리
+            for (const FString& DocumentID : DocumentIDs)
+            {
+                if (!Answered.Contains(DocumentID) && !Errors.Contains(DocumentID))
+                {
+                    Errors.Add(DocumentID, TEXT("Document missing from batch response"));
+                }
+            }
+
+            OnCompleted.ExecuteIfBound(Documents, Errors);
+        };
+
+        // 응답 파싱 (작업 스레드로 넘어가는 것은 본문뿐)
+        ParseResponse<FBatchLoadResponse>(TEXT("JsonCRDTParseDocuments"), Response, &ParseBatchLoadResponse, MoveTemp(Finish));
+    });
+
+    // 요청 전송
+    ProcessHttpRequest(HttpRequest, Traffic);
+}
+
+void FDefaultJsonCRDTTransport::SaveDocuments(const TArray<FJsonCRDTDocumentData>& Documents, const FOnDocumentsSaved& OnCompleted)
+{
+    using namespace JsonCRDTTransport;
+
+    const FRequestOptions Options = GetRequestOptions();
+    if (Documents.Num() <= 1 || !*bBatchRouteSupported)
+    {
+        SaveInParallel(Options, DocumentCache, Documents, OnCompleted);
+        return;
+    }
+
+    // 요청 본문 생성
+    TSharedRef<FJsonObject> RequestBody = MakeShared<FJsonObject>();
+    RequestBody->SetStringField(TEXT("clientId"), ClientID);
+
+    TArray<TSharedPtr<FJsonValue>> DocumentValues;
+    DocumentValues.Reserve(Documents.Num());
+    for (const FJsonCRDTDocumentData& DocumentData : Documents)
+    {
+        TSharedRef<FJsonObject> DocumentObject = BuildDocumentObject(DocumentData, bContentAsObject);
+        DocumentObject->SetStringField(TEXT("id"), DocumentData.DocumentID);
+        DocumentValues.Add(MakeShared<FJsonValueObject>(DocumentObject));
+    }
+    RequestBody->SetArrayField(TEXT("documents"), DocumentValues);
+
+    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = CreateHttpRequest(FString::Printf(TEXT("%s/documents/batch/save"), *ServerURL), TEXT("POST"));
+    SetRequestBody(*HttpRequest, SerializeCondensed(RequestBody), bCompressRequests, CompressionMinSize);
+
+    // 응답 처리 콜백 설정
+    HttpRequest->OnProcessRequestComplete().BindLambda([Options, Documents, OnCompleted, Cache = DocumentCache](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSucceeded)
+    {
+        TArray<FString> SavedDocumentIDs;
+        TMap<FString, FString> Errors;
+        auto FailAll = [&Documents, &OnCompleted, &SavedDocumentIDs, &Errors](const FString& ErrorMessage)
+        {
+            for (const FJsonCRDTDocumentData& DocumentData : Documents)
+            {
+                Errors.Add(DocumentData.DocumentID, ErrorMessage);
+            }
+            OnCompleted.ExecuteIfBound(SavedDocumentIDs, Errors);
+        };
+
+        if (!bSucceeded || !Response.IsValid())
+        {
+            FailAll(TEXT("No response from server"));
+            return;
+        }
+
+        // 여러 문서 경로가 없는 서버는 이후로 문서별 요청 사용
+        if (IsMissingRoute(Response->GetResponseCode()))
+        {
+            UE_LOG(LogTemp, Log, TEXT("Server has no batch document route, saving %d documents individually"), Documents.Num());
+            *Options.bBatchRouteSupported = false;
+            SaveInParallel(Options, Cache, Documents, OnCompleted);
+            return;
+        }
+
+        if (Response->GetResponseCode() != 200)
+        {
+            FailAll(FString::Printf(TEXT("Server error: %d, %s"), Response->GetResponseCode(), *Response->GetContentAsString()));
+            return;
+        }
+
+        const TSharedPtr<FJsonObject> JsonObject = ParseResponseObject(Response->GetContent(), Response->GetHeader(TEXT("Content-Encoding")));
+        if (!JsonObject.IsValid())
+        {
+            FailAll(TEXT("Failed to parse response"));
+            return;
+        }
+
+        ParseBatchErrors(*JsonObject, Errors);
+
+        // 저장된 문서의 새 ETag를 다음 로드의 검증용으로 보관
+        TMap<FString, int32> DocumentIndices;
+        for (int32 Index = 0; Index < Documents.Num(); ++Index)
+        {
+            DocumentIndices.Add(Documents[Index].DocumentID, Index);
+        }
+
+        const TArray<TSharedPtr<FJsonValue>>* Saved = nullptr;
+        if (JsonObject->TryGetArrayField(TEXT("saved"), Saved))
+        {
+            for (const TSharedPtr<FJsonValue>& Value : *Saved)
+            {
+                const TSharedPtr<FJsonObject>* Result = nullptr;
+                FString DocumentID;
+                if (!Value.IsValid() || !Value->TryGetObject(Result) || !(*Result)->TryGetStringField(TEXT("id"), DocumentID))
+                {
+                    continue;
+                }
+
+                const int32* Index = DocumentIndices.Find(DocumentID);
+                if (!Index)
+                {
+                    continue;
+                }
+
+                FString ETag;
+                (*Result)->TryGetStringField(TEXT("etag"), ETag);
+                Cache->Add(ETag, Documents[*Index]);
+
+                SavedDocumentIDs.Add(DocumentID);
+                Errors.Remove(DocumentID);
+                DocumentIndices.Remove(DocumentID);
+            }
+        }
+
+        // 응답에 빠진 문서는 실패로 처리
+        for (const TPair<FString, int32>& Missing : DocumentIndices)
+        {
+            if (!Errors.Contains(Missing.Key))
+            {
+                Errors.Add(Missing.Key, TEXT("Document missing from batch response"));
+            }
+        }
+
+        OnCompleted.ExecuteIfBound(SavedDocumentIDs, Errors);
+    });
+
+    // 요청 전송
+    ProcessHttpRequest(HttpRequest, Traffic);
+}
+
+void FDefaultJsonCRDTTransport::LoadInParallel(const FRequestOptions& Options, const TSharedRef<FDocumentCache>& Cache, const TArray<FString>& DocumentIDs, const FOnDocumentsLoaded& OnCompleted)
+{
+    JsonCRDTTransport::LoadEach(DocumentIDs, Options.MaxParallelRequests, OnCompleted, [Options, Cache](const FString& DocumentID, const FOnDocumentLoaded& OnLoaded, const FOnTransportError& OnError)
+    {
+        SendLoadRequest(Options, Cache, DocumentID, OnLoaded, OnError);
+    });
+}
+
+void FDefaultJsonCRDTTransport::SaveInParallel(const FRequestOptions& Options, const TSharedRef<FDocumentCache>& Cache, const TArray<FJsonCRDTDocumentData>& Documents, const FOnDocumentsSaved& OnCompleted)
+{
+    JsonCRDTTransport::SaveEach(Documents, Options.MaxParallelRequests, OnCompleted, [Options, Cache](const FJsonCRDTDocumentData& DocumentData, const FOnDocumentSaved& OnSaved, const FOnTransportError& OnError)
+    {
+        SendSaveRequest(Options, Cache, DocumentData, OnSaved, OnError);
+    });
+}
+
+void FDefaultJsonCRDTTransport::SetRequestCompression(bool bEnable, int32 InMinSize)
+{
+    bCompressRequests = bEnable;
+    CompressionMinSize = FMath::Max(0, InMinSize);
+}
+
+void FDefaultJsonCRDTTransport::ClearDocumentCache()
+{
+    DocumentCache->Empty();
+}
+
+void FDefaultJsonCRDTTransport::SetDocumentCacheSize(int64 MaxBytes)
+{
+    DocumentCache->SetMaxBytes(MaxBytes);
+}
+
+void FDefaultJsonCRDTTransport::ReleaseDocument(const FString& DocumentID)
+{
+    // 내린 문서는 다시 읽을 때 로컬 저장소를 쓰므로 검증용 사본을 메모리에 남기지 않음
+    DocumentCache->Remove(DocumentID);
+}
+
+const FDefaultJsonCRDTTransport::FCachedDocument* FDefaultJsonCRDTTransport::FDocumentCache::Find(const FString& DocumentID)
+{
+    FCachedDocument* Entry = Entries.Find(DocumentID);
+    if (Entry)
+    {
+        Entry->LastUse = ++UseCounter;
+    }
+    return Entry;
+}
+
+void FDefaultJsonCRDTTransport::FDocumentCache::Add(const FString& ETag, FJsonCRDTDocumentData Data)
+{
+    const FString DocumentID = Data.DocumentID;
+    Remove(DocumentID);
+
+    // ETag가 없으면 검증할 수 없고, 한도보다 큰 문서는 다른 문서를 모두 밀어내므로 보관하지 않음
+    FCachedDocument Entry;
+    Entry.ETag = ETag;
+    Entry.Data = MoveTemp(Data);
+    const int64 EntrySize = GetEntrySize(Entry);
+    if (ETag.IsEmpty() || EntrySize > MaxBytes)
+    {
+        return;
+    }
+
+    Entry.LastUse = ++UseCounter;
+    Entries.Add(DocumentID, MoveTemp(Entry));
+    NumBytes += EntrySize;
+    Trim();
+}
+
+void FDefaultJsonCRDTTransport::FDocumentCache::Remove(const FString& DocumentID)
+{
+    if (const FCachedDocument* Entry = Entries.Find(DocumentID))
+    {
+        NumBytes -= GetEntrySize(*Entry);
+        Entries.Remove(DocumentID);
+    }
+}
+
+void FDefaultJsonCRDTTransport::FDocumentCache::Empty()
+{
+    Entries.Empty();
+    NumBytes = 0;
+}
+
+void FDefaultJsonCRDTTransport::FDocumentCache::SetMaxBytes(int64 InMaxBytes)
+{
+    MaxBytes = FMath::Max<int64>(0, InMaxBytes);
+    Trim();
+}
+
+int64 FDefaultJsonCRDTTransport::FDocumentCache::GetEntrySize(const FCachedDocument& Entry)
+{
+    return static_cast<int64>(Entry.Data.Content.GetAllocatedSize() + Entry.Data.DocumentID.GetAllocatedSize() + Entry.ETag.GetAllocatedSize());
+}
+
+void FDefaultJsonCRDTTransport::FDocumentCache::Trim()
+{
+    while (NumBytes > MaxBytes && Entries.Num() > 0)
+    {
+        // 항목 수가 적으므로 가장 오래된 항목은 훑어서 찾음
+        const FString* Oldest = nullptr;
+        uint64 OldestUse = MAX_uint64;
+        for (const TPair<FString, FCachedDocument>& Pair : Entries)
+        {
+            if (Pair.Value.LastUse < OldestUse)
+            {
+                OldestUse = Pair.Value.LastUse;
+                Oldest = &Pair.Key;
+            }
+        }
+
+        const FString OldestID = *Oldest;
+        Remove(OldestID);
+    }
+}
+
+void FDefaultJsonCRDTTransport::SetMaxParallelRequests(int32 InMaxParallelRequests)
+{
+    MaxParallelRequests = FMath::Max(1, InMaxParallelRequests);
+}
+
+void FDefaultJsonCRDTTransport::SendPatch(const FJsonCRDTPatch& Patch, const FOnPatchSent& OnSent, const FOnTransportError& OnError)
+{
+    JSONCRDT_SCOPE_CYCLE_COUNTER(STAT_JsonCRDT_SendPatch);
+
+    // 앞서 보관한 패치보다 먼저 도착하지 않도록, 보관 중인 패치가 있으면 연결되어 있어도 뒤에 보관
+    if (ShouldQueuePatches() && Patch.Operations.Num() > 0)
+    {
+        if (!EnqueuePatch(Patch))
+        {
+            OnError.ExecuteIfBound(Patch.DocumentID, TEXT("Not connected to server and the offline queue is full"));
+            return;
+        }
+
+        OnSent.ExecuteIfBound(Patch.DocumentID);
+        return;
+    }
+
+    // 작업 없는 동기화 요청은 보관하지 않음 (다시 연결되면 새로 보내야 의미가 있음)
+    if (!IsConnected())
+    {
+        OnError.ExecuteIfBound(Patch.DocumentID, TEXT("Not connected to server"));
+        return;
+    }
+
+    SendPatchNow(Patch);
+    
+    // 전송 완료 콜백 호출
+    OnSent.ExecuteIfBound(Patch.DocumentID);
+}
+
+void FDefaultJsonCRDTTransport::SendPatchNow(const FJsonCRDTPatch& Patch)
+{
+    if (IsBinaryProtocol())
+    {
+        // 협상된 바이너리 프레임으로 전송 (클라이언트 ID는 인증 때 이미 전달됨)
+        TArray<uint8> Frame;
+        BinaryCodec.EncodePatch(Patch, Frame);
+        SendFrame(Frame);
+    }
+    else
+    {
+        // 이전 서버와의 호환을 위한 JSON 메시지
+        SendText(BuildPatchMessage(Patch));
+    }
+
+    ++Traffic->PatchesSent;
+}
+
+void FDefaultJsonCRDTTransport::SendText(const FString& Message)
+{
+    const int64 NumBytes = FPlatformString::ConvertedLength<UTF8CHAR>(*Message, Message.Len());
+    Traffic->BytesSent += NumBytes;
+    INC_DWORD_STAT_BY(STAT_JsonCRDT_BytesSent, NumBytes);
+
+    WebSocket->Send(Message);
+}
+
+void FDefaultJsonCRDTTransport::SendFrame(const TArray<uint8>& Frame)
+{
+    Traffic->BytesSent += Frame.Num();
+    INC_DWORD_STAT_BY(STAT_JsonCRDT_BytesSent, Frame.Num());
+
+    WebSocket->Send(Frame.GetData(), Frame.Num(), true);
+}
+
+void FDefaultJsonCRDTTransport::SendPatches(const TArray<FJsonCRDTPatch>& Patches, const FOnPatchSent& OnSent, const FOnTransportError& OnError)
+{
+    JSONCRDT_SCOPE_CYCLE_COUNTER(STAT_JsonCRDT_SendPatch);
+
+    // 이전 서버는 메시지 하나에 패치 하나만 이해하므로 JSON일 때는 하나씩 전송 (보관할 때도 패치별로 처리)
+    if (!IsBinaryProtocol() || ShouldQueuePatches())
+    {
+        IJsonCRDTTransport::SendPatches(Patches, OnSent, OnError);
+        return;
+    }
+
+    if (Patches.Num() == 0)
+    {
+        return;
+    }
+
+    // 여러 문서의 패치를 한 프레임으로 묶어 전송
+    TArray<uint8> Frame;
+    BinaryCodec.EncodePatches(Patches, Frame);
+    SendFrame(Frame);
+    Traffic->PatchesSent += Patches.Num();
+
+    for (const FJsonCRDTPatch& Patch : Patches)
+    {
+        OnSent.ExecuteIfBound(Patch.DocumentID);
+    }
+}
+
+void FDefaultJsonCRDTTransport::Subscribe(const FString& DocumentID, const TArray<FString>& PathPrefixes)
+{
+    const TArray<FString>* Existing = Subscriptions.Find(DocumentID);
+    if (Existing && *Existing == PathPrefixes)
+    {
+        return;
+    }
+
+    Subscriptions.Add(DocumentID, PathPrefixes);
+    ChangedSubscriptions.Add(DocumentID);
+}
+
+void FDefaultJsonCRDTTransport::Unsubscribe(const FString& DocumentID)
+{
+    if (Subscriptions.Remove(DocumentID) > 0)
+    {
+        ChangedSubscriptions.Add(DocumentID);
+    }
+}
+
+void FDefaultJsonCRDTTransport::SendSubscriptions(const TArray<FString>& DocumentIDs)
+{
+    TArray<const FString*> Subscribed;
+    TArray<const FString*> Unsubscribed;
+    for (const FString& DocumentID : DocumentIDs)
+    {
+        (Subscriptions.Contains(DocumentID) ? Subscribed : Unsubscribed).Add(&DocumentID);
+    }
+
+    if (Subscribed.Num() > 0)
+    {
+        FString Message;
+        TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Message);
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("type"), TEXT("subscribe"));
+        Writer->WriteValue(TEXT("clientId"), ClientID);
+        Writer->WriteArrayStart(TEXT("subscriptions"));
+        for (const FString* DocumentID : Subscribed)
+        {
+            Writer->WriteObjectStart();
+            Writer->WriteValue(TEXT("documentId"), *DocumentID);
+
+            // 경로가 없으면 문서 전체
+            const TArray<FString>& PathPrefixes = Subscriptions.FindChecked(*DocumentID);
+            if (PathPrefixes.Num() > 0)
+            {
+                Writer->WriteValue(TEXT("paths"), PathPrefixes);
+            }
+            Writer->WriteObjectEnd();
+        }
+        Writer->WriteArrayEnd();
+        Writer->WriteObjectEnd();
+        Writer->Close();
+
+        SendText(Message);
+    }
+
+    if (Unsubscribed.Num() > 0)
+    {
+        FString Message;
+        TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Message);
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("type"), TEXT("unsubscribe"));
+        Writer->WriteValue(TEXT("clientId"), ClientID);
+        Writer->WriteArrayStart(TEXT("documentIds"));
+        for (const FString* DocumentID : Unsubscribed)
+        {
+            Writer->WriteValue(*DocumentID);
+        }
+        Writer->WriteArrayEnd();
+        Writer->WriteObjectEnd();
+        Writer->Close();
+
+        SendText(Message);
+    }
+}
+
+void FDefaultJsonCRDTTransport::RegisterPatchReceived(const FOnPatchReceived& OnPatchReceived)
+{
+    // 디코딩 작업이 호출 중이면 끝날 때까지 기다리므로, 빈 콜백을 등록한 뒤에는 이전 콜백이 호출되지 않음
+    FScopeLock Lock(&PatchReceivedCriticalSection);
+    OnPatchReceivedDelegate = OnPatchReceived;
+}
+
+bool FDefaultJsonCRDTTransport::Connect()
+{
+    // 직접 연결하면 재연결 시도 수를 처음부터 셈
+    bDisconnectRequested = false;
+    bReconnectPending = false;
+    ReconnectAttempts = 0;
+
+    if (WebSocket.IsValid() && WebSocket->IsConnected())
+    {
+        return true;
+    }
+
+    OpenSocket();
+    return true;
+}
+
+void FDefaultJsonCRDTTransport::OpenSocket()
+{
+    if (!FModuleManager::Get().IsModuleLoaded("WebSockets"))
+    {
+        FModuleManager::Get().LoadModule("WebSockets");
+    }
+
+    // 이전 소켓의 늦은 이벤트가 새 연결의 상태를 바꾸지 않도록 먼저 정리
+    CloseSocket();
+
+    WebSocket = FWebSocketsModule::Get().CreateWebSocket(WebSocketURL);
+
+    WebSocket->OnConnected().AddRaw(this, &FDefaultJsonCRDTTransport::OnWebSocketConnected);
+    WebSocket->OnConnectionError().AddRaw(this, &FDefaultJsonCRDTTransport::OnWebSocketConnectionError);
+    WebSocket->OnMessage().AddRaw(this, &FDefaultJsonCRDTTransport::OnWebSocketMessage);
+    WebSocket->OnRawMessage().AddRaw(this, &FDefaultJsonCRDTTransport::OnWebSocketRawMessage);
+    WebSocket->OnClosed().AddRaw(this, &FDefaultJsonCRDTTransport::OnWebSocketClosed);
+
+    WebSocket->Connect();
+}
+
+void FDefaultJsonCRDTTransport::CloseSocket()
+{
+    if (!WebSocket.IsValid())
+    {
+        return;
+    }
+
+    WebSocket->OnConnected().RemoveAll(this);
+    WebSocket->OnConnectionError().RemoveAll(this);
+    WebSocket->OnMessage().RemoveAll(this);
+    WebSocket->OnRawMessage().RemoveAll(this);
+    WebSocket->OnClosed().RemoveAll(this);
+
+    if (WebSocket->IsConnected())
+    {
+        WebSocket->Close();
+    }
+    WebSocket = nullptr;
+    bAwaitingHandshake = false;
+}
+
+void FDefaultJsonCRDTTransport::Disconnect()
+{
+    bDisconnectRequested = true;
+    bReconnectPending = false;
+
+    const bool bWasConnected = IsConnected();
+    CloseSocket();
+
+    // 대기열 파일에 아직 덧붙이지 않은 패치를 마저 기록 (소멸자도 여기를 거침)
+    if (!OfflineQueueFile.IsEmpty())
+    {
+        FJsonCRDTLocalStorageWriter::Get().Flush();
+    }
+
+    if (bWasConnected)
+    {
+        NotifyConnectionStatus(false, TEXT("Disconnected"));
+    }
+}
+
+bool FDefaultJsonCRDTTransport::IsConnected() const
+{
+    return WebSocket.IsValid() && WebSocket->IsConnected();
+}
+
+void FDefaultJsonCRDTTransport::SetReconnectSettings(const FJsonCRDTReconnectSettings& Settings)
+{
+    ReconnectSettings = Settings;
+    ReconnectSettings.MaxAttempts = FMath::Max(0, Settings.MaxAttempts);
+    ReconnectSettings.InitialDelaySeconds = FMath::Max(0.1f, Settings.InitialDelaySeconds);
+    ReconnectSettings.MaxDelaySeconds = FMath::Max(ReconnectSettings.InitialDelaySeconds, Settings.MaxDelaySeconds);
+
+    if (!ReconnectSettings.bAutoReconnect)
+    {
+        bReconnectPending = false;
+    }
+}
+
+void FDefaultJsonCRDTTransport::RegisterConnectionStatusChanged(const FOnConnectionStatusChanged& OnStatusChanged)
 {
-    // 고유 클라이언트 ID 생성
-    ClientID = GenerateClientID();
+    OnConnectionStatusChangedDelegate = OnStatusChanged;
 }
 
-FDefaultJsonCRDTTransport::~FDefaultJsonCRDTTransport()
+void FDefaultJsonCRDTTransport::NotifyConnectionStatus(bool bIsConnected, const FString& StatusMessage)
 {
-    Disconnect();
+    OnConnectionStatusChangedDelegate.ExecuteIfBound(bIsConnected, StatusMessage);
 }
 
-void FDefaultJsonCRDTTransport::LoadDocument(const FString& DocumentID, const FOnDocumentLoaded& OnLoaded, const FOnTransportError& OnError)
+void FDefaultJsonCRDTTransport::HandleConnectionLost(const FString& Reason)
 {
-    // HTTP 요청 생성
-    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
-    HttpRequest->SetURL(FString::Printf(TEXT("%s/documents/%s"), *ServerURL, *DocumentID));
-    HttpRequest->SetVerb(TEXT("GET"));
-    HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+    bAwaitingHandshake = false;
 
-    // 응답 처리 콜백 설정
-    HttpRequest->OnProcessRequestComplete().BindLambda([DocumentID, OnLoaded, OnError](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSucceeded)
+    // 오류와 종료가 함께 오면 한 번만 예약
+    if (bReconnectPending)
     {
-        if (!bSucceeded || !Response.IsValid())
-        {
-            OnError.ExecuteIfBound(DocumentID, TEXT("No response from server"));
-            return;
-        }
+        return;
+    }
 
-        if (Response->GetResponseCode() != 200)
-        {
-            OnError.ExecuteIfBound(DocumentID, FString::Printf(TEXT("Server error: %d, %s"), Response->GetResponseCode(), *Response->GetContentAsString()));
-            return;
-        }
+    if (bDisconnectRequested || !ReconnectSettings.bAutoReconnect)
+    {
+        NotifyConnectionStatus(false, Reason);
+        return;
+    }
 
-        // 응답 파싱
-        TSharedPtr<FJsonObject> JsonObject;
-        TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
-        if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
-        {
-            OnError.ExecuteIfBound(DocumentID, TEXT("Failed to parse response"));
-            return;
-        }
+    if (ReconnectSettings.MaxAttempts > 0 && ReconnectAttempts >= ReconnectSettings.MaxAttempts)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("WebSocket reconnect gave up after %d attempts"), ReconnectAttempts);
+        NotifyConnectionStatus(false, FString::Printf(TEXT("%s (gave up after %d reconnect attempts)"), *Reason, ReconnectAttempts));
+        return;
+    }
 
-        // 문서 데이터 생성
-        FJsonCRDTDocumentData DocumentData;
-        DocumentData.DocumentID = DocumentID;
-        
-        // 문서 내용 가져오기
-        FString Content;
-        if (JsonObject->TryGetStringField(TEXT("content"), Content))
-        {
-            DocumentData.Content = Content;
-        }
-        
-        // 문서 버전 가져오기
-        int64 Version = 1;
-        if (JsonObject->TryGetNumberField(TEXT("version"), Version))
-        {
-            DocumentData.Version = Version;
-        }
-        
-        // 생성 시간 가져오기
-        FString CreatedAtStr;
-        if (JsonObject->TryGetStringField(TEXT("createdAt"), CreatedAtStr))
-        {
-            FDateTime::Parse(CreatedAtStr, DocumentData.CreatedAt);
-        }
-        
-        // 수정 시간 가져오기
-        FString UpdatedAtStr;
-        if (JsonObject->TryGetStringField(TEXT("updatedAt"), UpdatedAtStr))
-        {
-            FDateTime::Parse(UpdatedAtStr, DocumentData.UpdatedAt);
-        }
+    // 지수 백오프의 절반은 고정, 절반은 무작위로 해서 함께 끊긴 클라이언트들이 한꺼번에 재연결하지 않게 함
+    const float Backoff = FMath::Min(ReconnectSettings.MaxDelaySeconds, ReconnectSettings.InitialDelaySeconds * FMath::Pow(2.0f, static_cast<float>(FMath::Min(ReconnectAttempts, 16))));
+    const float Delay = Backoff * 0.5f + FMath::FRandRange(0.0f, Backoff * 0.5f);
 
-        // 로드 완료 콜백 호출
-        OnLoaded.ExecuteIfBound(DocumentData);
-    });
+    ++ReconnectAttempts;
+    bReconnectPending = true;
+    NextReconnectTime = FPlatformTime::Seconds() + Delay;
 
-    // 요청 전송
-    HttpRequest->ProcessRequest();
+    UE_LOG(LogTemp, Log, TEXT("WebSocket reconnect attempt %d in %.1f seconds"), ReconnectAttempts, Delay);
+    NotifyConnectionStatus(false, FString::Printf(TEXT("%s (reconnecting in %.1f seconds)"), *Reason, Delay));
 }
 
-void FDefaultJsonCRDTTransport::SaveDocument(const FJsonCRDTDocumentData& DocumentData, const FOnDocumentSaved& OnSaved, const FOnTransportError& OnError)
+bool FDefaultJsonCRDTTransport::TickConnection(float DeltaTime)
 {
-    // HTTP 요청 생성
-    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
-    HttpRequest->SetURL(FString::Printf(TEXT("%s/documents/%s"), *ServerURL, *DocumentData.DocumentID));
-    HttpRequest->SetVerb(TEXT("PUT"));
-    HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+    using namespace JsonCRDTTransport;
 
-    // 요청 본문 생성
-    TSharedPtr<FJsonObject> RequestBody = MakeShared<FJsonObject>();
-    RequestBody->SetStringField(TEXT("clientId"), ClientID);
-    RequestBody->SetStringField(TEXT("content"), DocumentData.Content);
-    RequestBody->SetNumberField(TEXT("version"), DocumentData.Version);
-    RequestBody->SetStringField(TEXT("updatedAt"), DocumentData.UpdatedAt.ToString());
+    const double CurrentTime = FPlatformTime::Seconds();
+    if (bReconnectPending && CurrentTime >= NextReconnectTime)
+    {
+        bReconnectPending = false;
+        OpenSocket();
+    }
 
-    FString RequestBodyString;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RequestBodyString);
-    FJsonSerializer::Serialize(RequestBody.ToSharedRef(), Writer);
+    // 협상이 끝나면 (응답하지 않는 서버는 시간이 지나면) 보관한 패치를 보내고 연결을 알림
+    if (bAwaitingHandshake && IsConnected() && (IsHandshakeAcknowledged() || CurrentTime - ConnectedTime >= HandshakeTimeoutSeconds))
+    {
+        bAwaitingHandshake = false;
+        ReconnectAttempts = 0;
 
-    HttpRequest->SetContentAsString(RequestBodyString);
+        // 새 연결에는 구독이 없으므로 보관한 패치보다 먼저 전체 목록을 보냄
+        ChangedSubscriptions.Reset();
+        TArray<FString> SubscribedDocumentIDs;
+        Subscriptions.GetKeys(SubscribedDocumentIDs);
+        SendSubscriptions(SubscribedDocumentIDs);
 
-    // 응답 처리 콜백 설정
-    HttpRequest->OnProcessRequestComplete().BindLambda([DocumentData, OnSaved, OnError](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSucceeded)
+        FlushOfflineQueue();
+        NotifyConnectionStatus(true, TEXT("Connected"));
+    }
+    else if (!bAwaitingHandshake && OfflineQueue.Num() > 0 && IsConnected())
     {
-        if (!bSucceeded || !Response.IsValid())
-        {
-            OnError.ExecuteIfBound(DocumentData.DocumentID, TEXT("No response from server"));
-            return;
-        }
+        // 연결된 뒤에 대기열 파일을 바꿔 읽어 온 패치
+        FlushOfflineQueue();
+    }
 
-        if (Response->GetResponseCode() != 200)
-        {
-            OnError.ExecuteIfBound(DocumentData.DocumentID, FString::Printf(TEXT("Server error: %d, %s"), Response->GetResponseCode(), *Response->GetContentAsString()));
-            return;
-        }
+    // 이번 틱의 구독 변경을 메시지 하나씩으로 묶어 보냄 (연결이 없으면 다음 연결의 전체 목록에 포함됨)
+    if (!bAwaitingHandshake && ChangedSubscriptions.Num() > 0 && IsConnected())
+    {
+        SendSubscriptions(ChangedSubscriptions.Array());
+        ChangedSubscriptions.Reset();
+    }
 
-        // 저장 완료 콜백 호출
-        OnSaved.ExecuteIfBound(DocumentData.DocumentID);
-    });
+    return true;
+}
 
-    // 요청 전송
-    HttpRequest->ProcessRequest();
+bool FDefaultJsonCRDTTransport::ShouldQueuePatches() const
+{
+    return !IsConnected() || bAwaitingHandshake || OfflineQueue.Num() > 0;
 }
 
-void FDefaultJsonCRDTTransport::SendPatch(const FJsonCRDTPatch& Patch, const FOnPatchSent& OnSent, const FOnTransportError& OnError)
+void FDefaultJsonCRDTTransport::SetOfflineQueueLimit(int32 InMaxOperations)
 {
-    if (!IsConnected())
+    MaxQueuedOperations = FMath::Max(1, InMaxOperations);
+}
+
+void FDefaultJsonCRDTTransport::SetOfflineQueueFile(const FString& FilePath)
+{
+    if (FilePath == OfflineQueueFile)
     {
-        OnError.ExecuteIfBound(Patch.DocumentID, TEXT("Not connected to server"));
         return;
     }
 
-    // 패치 메시지 생성
-    TSharedPtr<FJsonObject> PatchMessage = MakeShared<FJsonObject>();
-    PatchMessage->SetStringField(TEXT("type"), TEXT("patch"));
-    PatchMessage->SetStringField(TEXT("documentId"), Patch.DocumentID);
-    PatchMessage->SetStringField(TEXT("clientId"), ClientID);
-    PatchMessage->SetNumberField(TEXT("baseVersion"), Patch.BaseVersion);
-    
-    // 패치 작업 배열 생성
-    TArray<TSharedPtr<FJsonValue>> OperationsArray;
-    for (const FJsonCRDTOperation& Operation : Patch.Operations)
-    {
-        TSharedPtr<FJsonObject> OperationObject = MakeShared<FJsonObject>();
-        
-        // 작업 타입 설정
-        FString OperationType;
-        switch (Operation.Type)
-        {
-        case EJsonCRDTOperationType::Add:
-            OperationType = TEXT("add");
-            break;
-        case EJsonCRDTOperationType::Remove:
-            OperationType = TEXT("remove");
-            break;
-        case EJsonCRDTOperationType::Replace:
-            OperationType = TEXT("replace");
-            break;
-        case EJsonCRDTOperationType::Move:
-            OperationType = TEXT("move");
-            break;
-        case EJsonCRDTOperationType::Copy:
-            OperationType = TEXT("copy");
-            break;
-        case EJsonCRDTOperationType::Test:
-            OperationType = TEXT("test");
-            break;
-        default:
-            OperationType = TEXT("unknown");
-            break;
-        }
-        
-        OperationObject->SetStringField(TEXT("op"), OperationType);
-        OperationObject->SetStringField(TEXT("path"), Operation.Path);
-        
-        // from 필드는 move와 copy 작업에만 필요
-        if (Operation.Type == EJsonCRDTOperationType::Move || Operation.Type == EJsonCRDTOperationType::Copy)
-        {
-            OperationObject->SetStringField(TEXT("from"), Operation.FromPath);
-        }
-        
-        // value 필드는 add, replace, test 작업에만 필요
-        if (Operation.Type == EJsonCRDTOperationType::Add || 
-            Operation.Type == EJsonCRDTOperationType::Replace || 
-            Operation.Type == EJsonCRDTOperationType::Test)
-        {
-            // value는 이미 JSON 문자열이므로 파싱하여 추가
-            TSharedPtr<FJsonValue> ValueJsonValue;
-            TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Operation.Value);
-            if (FJsonSerializer::Deserialize(Reader, ValueJsonValue))
-            {
-                OperationObject->SetField(TEXT("value"), ValueJsonValue);
-            }
-            else
-            {
-                // 파싱 실패 시 문자열로 추가
-                OperationObject->SetStringField(TEXT("value"), Operation.Value);
-            }
-        }
-        
-        OperationsArray.Add(MakeShared<FJsonValueObject>(OperationObject));
+    // 이미 보관한 패치는 새 파일로 옮김
+    DeleteOfflineQueueFile();
+    OfflineQueueFile = FilePath;
+
+    TArray<FJsonCRDTPatch> Queued = MoveTemp(OfflineQueue);
+    OfflineQueue.Reset();
+    NumQueuedOperations = 0;
+    LoadOfflineQueue();
+
+    for (const FJsonCRDTPatch& Patch : Queued)
+    {
+        EnqueuePatch(Patch);
     }
-    
-    PatchMessage->SetArrayField(TEXT("operations"), OperationsArray);
-    
-    // 패치 메시지 직렬화
-    FString PatchMessageString;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&PatchMessageString);
-    FJsonSerializer::Serialize(PatchMessage.ToSharedRef(), Writer);
-    
-    // WebSocket으로 패치 전송
-    WebSocket->Send(PatchMessageString);
-    
-    // 전송 완료 콜백 호출
-    OnSent.ExecuteIfBound(Patch.DocumentID);
 }
 
-void FDefaultJsonCRDTTransport::RegisterPatchReceived(const FOnPatchReceived& OnPatchReceived)
+bool FDefaultJsonCRDTTransport::EnqueuePatch(const FJsonCRDTPatch& Patch)
 {
-    OnPatchReceivedDelegate = OnPatchReceived;
-}
+    if (NumQueuedOperations + Patch.Operations.Num() > MaxQueuedOperations)
+    {
+        return false;
+    }
 
-bool FDefaultJsonCRDTTransport::Connect()
-{
-    if (WebSocket.IsValid() && WebSocket->IsConnected())
+    // 문서의 작업 순서만 지키면 되므로 같은 문서의 패치는 하나로 합침
+    FJsonCRDTPatch* Queued = OfflineQueue.FindByPredicate([&Patch](const FJsonCRDTPatch& Existing)
     {
-        return true;
+        return Existing.DocumentID == Patch.DocumentID && Existing.ClientID == Patch.ClientID;
+    });
+
+    if (Queued)
+    {
+        Queued->Operations.Append(Patch.Operations);
+        Queued->Timestamp = Patch.Timestamp;
+        Queued->Sequence = FMath::Max(Queued->Sequence, Patch.Sequence);
+    }
+    else
+    {
+        OfflineQueue.Add(Patch);
     }
+    NumQueuedOperations += Patch.Operations.Num();
 
-    if (!FModuleManager::Get().IsModuleLoaded("WebSockets"))
+    // 다음 실행에서도 보낼 수 있도록 파일 끝에 추가 (게임 스레드를 막지 않도록 백그라운드 기록기로 씀)
+    if (!OfflineQueueFile.IsEmpty())
     {
-        FModuleManager::Get().LoadModule("WebSockets");
+        TArray<uint8> Record;
+        FJsonCRDTJournal::AppendRecord(Patch, Record);
+        FJsonCRDTLocalStorageWriter::Get().Append(OfflineQueueFile, MoveTemp(Record));
     }
 
-    WebSocket = FWebSocketsModule::Get().CreateWebSocket(WebSocketURL);
+    return true;
+}
 
-    WebSocket->OnConnected().AddRaw(this, &FDefaultJsonCRDTTransport::OnWebSocketConnected);
-    WebSocket->OnConnectionError().AddRaw(this, &FDefaultJsonCRDTTransport::OnWebSocketConnectionError);
-    WebSocket->OnMessage().AddRaw(this, &FDefaultJsonCRDTTransport::OnWebSocketMessage);
-    WebSocket->OnClosed().AddRaw(this, &FDefaultJsonCRDTTransport::OnWebSocketClosed);
+void FDefaultJsonCRDTTransport::DeleteOfflineQueueFile()
+{
+    if (OfflineQueueFile.IsEmpty())
+    {
+        return;
+    }
 
-    WebSocket->Connect();
-    return true;
+    // 아직 덧붙이지 않은 레코드가 지운 뒤에 파일을 다시 만들지 않도록 먼저 기록을 끝냄
+    FJsonCRDTLocalStorageWriter::Get().Flush();
+    IFileManager::Get().Delete(*OfflineQueueFile, false, false, true);
 }
 
-void FDefaultJsonCRDTTransport::Disconnect()
+void FDefaultJsonCRDTTransport::LoadOfflineQueue()
 {
-    if (WebSocket.IsValid() && WebSocket->IsConnected())
+    if (OfflineQueueFile.IsEmpty())
     {
-        WebSocket->Close();
-        WebSocket = nullptr;
+        return;
+    }
+
+    TArray<uint8> Bytes;
+    FJsonCRDTLocalStorageWriter::Get().Flush();
+    if (!FFileHelper::LoadFileToArray(Bytes, *OfflineQueueFile, FILEREAD_Silent))
+    {
+        return;
+    }
+
+    TArray<FJsonCRDTPatch> Records;
+    FJsonCRDTJournal::ReadRecords(Bytes, Records);
+
+    // 잘린 뒷부분은 버리고 온전한 레코드만 다시 기록
+    DeleteOfflineQueueFile();
+    for (const FJsonCRDTPatch& Record : Records)
+    {
+        if (!EnqueuePatch(Record))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Offline queue file %s exceeds the queue limit, dropping remaining patches"), *OfflineQueueFile);
+            break;
+        }
+    }
+
+    if (OfflineQueue.Num() > 0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Loaded %d queued operations from %s"), NumQueuedOperations, *OfflineQueueFile);
     }
 }
 
-bool FDefaultJsonCRDTTransport::IsConnected() const
+void FDefaultJsonCRDTTransport::FlushOfflineQueue()
 {
-    return WebSocket.IsValid() && WebSocket->IsConnected();
+    using namespace JsonCRDTTransport;
+
+    if (OfflineQueue.Num() == 0)
+    {
+        return;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Sending %d queued operations for %d documents"), NumQueuedOperations, OfflineQueue.Num());
+
+    if (IsBinaryProtocol())
+    {
+        // 여러 문서의 패치를 작업 수 제한 안에서 프레임 하나로 묶음
+        int32 Start = 0;
+        while (Start < OfflineQueue.Num())
+        {
+            int32 End = Start;
+            int32 NumOperations = 0;
+            while (End < OfflineQueue.Num() && (End == Start || NumOperations + OfflineQueue[End].Operations.Num() <= MaxOperationsPerReplayFrame))
+            {
+                NumOperations += OfflineQueue[End].Operations.Num();
+                ++End;
+            }
+
+            TArray<uint8> Frame;
+            BinaryCodec.EncodePatches(TArrayView<const FJsonCRDTPatch>(OfflineQueue.GetData() + Start, End - Start), Frame);
+            SendFrame(Frame);
+            Start = End;
+        }
+    }
+    else
+    {
+        for (const FJsonCRDTPatch& Patch : OfflineQueue)
+        {
+            SendText(BuildPatchMessage(Patch));
+        }
+    }
+
+    Traffic->PatchesSent += OfflineQueue.Num();
+    OfflineQueue.Reset();
+    NumQueuedOperations = 0;
+    DeleteOfflineQueueFile();
 }
 
 void FDefaultJsonCRDTTransport::OnWebSocketConnected()
 {
     UE_LOG(LogTemp, Log, TEXT("Connected to WebSocket server"));
+
+    // 새 연결은 JSON으로 시작하고, 서버가 수락하면 바이너리로 전환 (세대가 바뀌면 이전 연결의 인증 응답은 무효)
+    // 받는 방향 사전은 디코딩 작업만 사용하므로 같은 파이프에서 이전 연결의 프레임 뒤에 초기화
+    ++ConnectionGeneration;
+    BinaryCodec.ResetEncoder();
+    DecodePipe.Launch(TEXT("JsonCRDTResetDecoder"), [this]()
+    {
+        BinaryCodec.ResetDecoder();
+    });
+    bAwaitingHandshake = true;
+    ConnectedTime = FPlatformTime::Seconds();
+    IncomingFrame.Reset();
+    bSkippingRawMessage = false;
     
-    // 인증 메시지 전송
+    // 인증 메시지 전송 (지원하는 프로토콜을 선호 순서대로 알림)
     TSharedPtr<FJsonObject> AuthMessage = MakeShared<FJsonObject>();
     AuthMessage->SetStringField(TEXT("type"), TEXT("auth"));
     AuthMessage->SetStringField(TEXT("clientId"), ClientID);
 
+    TArray<TSharedPtr<FJsonValue>> Protocols;
+    Protocols.Add(MakeShared<FJsonValueString>(FJsonCRDTBinaryCodec::ProtocolName));
+    Protocols.Add(MakeShared<FJsonValueString>(TEXT("json")));
+    AuthMessage->SetArrayField(TEXT("protocols"), Protocols);
+
     FString AuthMessageString;
     TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&AuthMessageString);
     FJsonSerializer::Serialize(AuthMessage.ToSharedRef(), Writer);
 
-    WebSocket->Send(AuthMessageString);
+    SendText(AuthMessageString);
 }
 
 void FDefaultJsonCRDTTransport::OnWebSocketConnectionError(const FString& Error)
 {
     UE_LOG(LogTemp, Error, TEXT("WebSocket connection error: %s"), *Error);
+    HandleConnectionLost(Error);
 }
 
 void FDefaultJsonCRDTTransport::OnWebSocketMessage(const FString& Message)
 {
-    // 메시지 파싱
+    JSONCRDT_SCOPE_CYCLE_COUNTER(STAT_JsonCRDT_OnWebSocketMessage);
+
+    // 파싱과 패치 변환은 작업 스레드에서 수신 순서대로 처리
+    DecodePipe.Launch(TEXT("JsonCRDTDecodeMessage"), [this, Message, Generation = ConnectionGeneration.load()]()
+    {
+        HandleTextMessage(Message, Generation);
+    });
+}
+
+bool FDefaultJsonCRDTTransport::IsBinaryProtocol() const
+{
+    const uint64 Handshake = AcknowledgedHandshake.load();
+    return (Handshake >> 1) == ConnectionGeneration.load() && (Handshake & 1) != 0;
+}
+
+bool FDefaultJsonCRDTTransport::IsHandshakeAcknowledged() const
+{
+    return (AcknowledgedHandshake.load() >> 1) == ConnectionGeneration.load();
+}
+
+void FDefaultJsonCRDTTransport::HandleTextMessage(const FString& Message, uint32 Generation)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FDefaultJsonCRDTTransport::HandleTextMessage);
+
+    // 다시 연결하기 전에 받은 메시지는 버림 (놓친 패치는 재연결 후 동기화 요청으로 다시 받음)
+    if (Generation != ConnectionGeneration.load())
+    {
+        return;
+    }
+
+    // 받은 바이트는 UTF-8 변환 비용이 게임 스레드에 남지 않도록 디코딩 작업에서 셈
+    const int64 NumBytes = FPlatformString::ConvertedLength<UTF8CHAR>(*Message, Message.Len());
+    Traffic->BytesReceived += NumBytes;
+    INC_DWORD_STAT_BY(STAT_JsonCRDT_BytesReceived, NumBytes);
+
+    // 대부분의 메시지는 패치이므로 DOM 없이 바로 패치로 읽음 (패치 객체는 메시지마다 재사용)
+    FString MessageType;
+    FString ParseError;
+    const bool bPatchParsed = FJsonCRDTPatchParser::Parse(Message, FJsonCRDTPatchParser::EFormat::Message, DecodedPatch, &MessageType, &ParseError);
+    if (MessageType == TEXT("patch"))
+    {
+        if (!bPatchParsed)
+        {
+            UE_LOG(LogTemp, Error, TEXT("Failed to parse patch from WebSocket message (%s): %s"), *ParseError, *Message);
+            return;
+        }
+
+        // 패치 수신 콜백 호출
+        ++Traffic->PatchesReceived;
+        FScopeLock Lock(&PatchReceivedCriticalSection);
+        OnPatchReceivedDelegate.ExecuteIfBound(DecodedPatch);
+        return;
+    }
+
+    // 그 밖의 메시지는 드물므로 DOM으로 파싱
     TSharedPtr<FJsonObject> JsonObject;
     TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Message);
     if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
@@ -306,36 +1781,131 @@ void FDefaultJsonCRDTTransport::OnWebSocketMessage(const FString& Message)
     }
 
     // 메시지 타입 가져오기
-    FString MessageType;
     if (!JsonObject->TryGetStringField(TEXT("type"), MessageType))
     {
         UE_LOG(LogTemp, Error, TEXT("WebSocket message missing 'type' field: %s"), *Message);
         return;
     }
 
-    // 패치 메시지 처리
-    if (MessageType == TEXT("patch"))
+    // 인증 응답 처리 (응답이 없거나 프로토콜을 모르는 서버는 JSON 유지)
+    if (MessageType == TEXT("auth_ack"))
+    {
+        FString Protocol;
+        const bool bBinary = JsonObject->TryGetStringField(TEXT("protocol"), Protocol)
+            && Protocol == FJsonCRDTBinaryCodec::ProtocolName;
+        AcknowledgedHandshake = (static_cast<uint64>(Generation) << 1) | (bBinary ? 1 : 0);
+        UE_LOG(LogTemp, Log, TEXT("WebSocket protocol: %s"), bBinary ? FJsonCRDTBinaryCodec::ProtocolName : TEXT("json"));
+    }
+}
+
+void FDefaultJsonCRDTTransport::OnWebSocketRawMessage(const void* Data, SIZE_T Size, SIZE_T BytesRemaining)
+{
+    JSONCRDT_SCOPE_CYCLE_COUNTER(STAT_JsonCRDT_OnWebSocketMessage);
+
+    const uint8* Bytes = static_cast<const uint8*>(Data);
+
+    // 메시지의 첫 조각에서 바이너리 프레임 여부 판단 (텍스트 메시지는 OnWebSocketMessage에서 처리)
+    if (IncomingFrame.Num() == 0 && !bSkippingRawMessage)
+    {
+        bSkippingRawMessage = !FJsonCRDTBinaryCodec::IsBinaryFrame(Bytes, static_cast<int32>(Size));
+    }
+
+    if (bSkippingRawMessage)
+    {
+        bSkippingRawMessage = BytesRemaining > 0;
+        return;
+    }
+
+    IncomingFrame.Append(Bytes, static_cast<int32>(Size));
+    Traffic->BytesReceived += static_cast<int64>(Size);
+    INC_DWORD_STAT_BY(STAT_JsonCRDT_BytesReceived, static_cast<int64>(Size));
+    if (BytesRemaining == 0)
+    {
+        // 완성된 프레임은 작업 스레드에서 수신 순서대로 디코딩
+        DecodePipe.Launch(TEXT("JsonCRDTDecodeFrame"), [this, Frame = MoveTemp(IncomingFrame), Socket = TWeakPtr<IWebSocket>(WebSocket), Generation = ConnectionGeneration.load()]()
+        {
+            HandleBinaryFrame(Frame, Socket, Generation);
+        });
+        IncomingFrame.Reset();
+    }
+}
+
+void FDefaultJsonCRDTTransport::HandleBinaryFrame(const TArray<uint8>& Frame, const TWeakPtr<IWebSocket>& Socket, uint32 Generation)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FDefaultJsonCRDTTransport::HandleBinaryFrame);
+
+    // 이전 연결의 프레임은 새 연결의 사전으로 읽을 수 없으므로 버림 (놓친 패치는 재연결 후 동기화 요청으로 다시 받음)
+    if (Generation != ConnectionGeneration.load())
+    {
+        return;
+    }
+
+    TArray<FJsonCRDTPatch> Patches;
+    if (!BinaryCodec.DecodeFrame(Frame.GetData(), Frame.Num(), Patches))
     {
-        // 패치 파싱
-        FJsonCRDTPatch Patch;
-        if (FJsonObjectConverter::JsonObjectToUStruct(JsonObject.ToSharedRef(), &Patch, 0, 0))
+        // 사전이 어긋났을 수 있으므로 연결을 끊어 다음 연결에서 처음부터 다시 맞춤 (소켓은 게임 스레드에서만 다룸)
+        UE_LOG(LogTemp, Error, TEXT("Failed to decode binary patch frame (%d bytes), closing connection"), Frame.Num());
+        AsyncTask(ENamedThreads::GameThread, [Socket]()
         {
-            // 패치 수신 콜백 호출
-            if (OnPatchReceivedDelegate.IsBound())
+            if (TSharedPtr<IWebSocket> PinnedSocket = Socket.Pin())
             {
-                OnPatchReceivedDelegate.Execute(Patch);
+                PinnedSocket->Close();
             }
+        });
+        return;
+    }
+
+    Traffic->PatchesReceived += Patches.Num();
+    FScopeLock Lock(&PatchReceivedCriticalSection);
+    if (OnPatchReceivedDelegate.IsBound())
+    {
+        for (const FJsonCRDTPatch& Patch : Patches)
+        {
+            OnPatchReceivedDelegate.Execute(Patch);
         }
-        else
+    }
+}
+
+FString FDefaultJsonCRDTTransport::BuildPatchMessage(const FJsonCRDTPatch& Patch) const
+{
+    using namespace JsonCRDTTransport;
+
+    // 값은 이미 JSON 텍스트이므로 중간 객체 없이 그대로 기록
+    FString PatchMessageString;
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&PatchMessageString);
+
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("type"), TEXT("patch"));
+    Writer->WriteValue(TEXT("documentId"), Patch.DocumentID);
+    Writer->WriteValue(TEXT("clientId"), ClientID);
+    Writer->WriteValue(TEXT("baseVersion"), Patch.BaseVersion);
+    if (Patch.Sequence > 0)
+    {
+        Writer->WriteValue(TEXT("sequence"), Patch.Sequence);
+    }
+
+    // 동기화 요청이면 클라이언트별로 적용한 마지막 시퀀스를 알림
+    if (Patch.VersionVector.Num() > 0)
+    {
+        Writer->WriteObjectStart(TEXT("versionVector"));
+        for (const TPair<FString, int64>& Entry : Patch.VersionVector)
         {
-            UE_LOG(LogTemp, Error, TEXT("Failed to parse patch from WebSocket message: %s"), *Message);
+            Writer->WriteValue(Entry.Key, Entry.Value);
         }
+        Writer->WriteObjectEnd();
     }
+
+    WriteOperations(*Writer, Patch.Operations);
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    return PatchMessageString;
 }
 
 void FDefaultJsonCRDTTransport::OnWebSocketClosed(int32 StatusCode, const FString& Reason, bool bWasClean)
 {
     UE_LOG(LogTemp, Log, TEXT("WebSocket closed: %d, %s, %s"), StatusCode, *Reason, bWasClean ? TEXT("clean") : TEXT("not clean"));
+    HandleConnectionLost(FString::Printf(TEXT("Connection closed (%d %s)"), StatusCode, *Reason));
 }
 
 FString FDefaultJsonCRDTTransport::GenerateClientID()
@@ -1,480 +1,744 @@
 // Copyright Your Company. All Rights Reserved.
 
 #include "JsonCRDTVisualizer.h"
-#include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "HAL/FileManager.h"
 #include "HAL/PlatformFilemanager.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
 
-bool UJsonCRDTVisualizer::ExportToHTML(const TArray<FJsonCRDTLogEntry>& LogEntries, const FString& FilePath)
+namespace JsonCRDTVisualizer
 {
-    // HTML 문서 생성
-    FString HtmlContent = GenerateHTMLHeader(TEXT("CRDT Log Visualization"));
+    /** 버퍼가 이 길이(문자 수)를 넘으면 파일에 기록 */
+    static constexpr int32 FlushThreshold = 64 * 1024;
     
-    // 테이블 시작
-    HtmlContent += TEXT("<table class=\"table table-striped table-hover\">\n");
-    HtmlContent += TEXT("<thead>\n");
-    HtmlContent += TEXT("<tr>\n");
-    HtmlContent += TEXT("<th>Timestamp</th>\n");
-    HtmlContent += TEXT("<th>Document ID</th>\n");
-    HtmlContent += TEXT("<th>Operation</th>\n");
-    HtmlContent += TEXT("<th>Path</th>\n");
-    HtmlContent += TEXT("<th>Old Value</th>\n");
-    HtmlContent += TEXT("<th>New Value</th>\n");
-    HtmlContent += TEXT("<th>Client ID</th>\n");
-    HtmlContent += TEXT("<th>Source</th>\n");
-    HtmlContent += TEXT("<th>Conflict</th>\n");
-    HtmlContent += TEXT("</tr>\n");
-    HtmlContent += TEXT("</thead>\n");
-    HtmlContent += TEXT("<tbody>\n");
+    /** 진행 상황을 알리는 항목 간격 */
+    static constexpr int32 ProgressInterval = 1024;
     
-    // 각 로그 항목을 테이블 행으로 추가
-    for (const FJsonCRDTLogEntry& LogEntry : LogEntries)
+    /** HTML 헤더 추가 */
+    static void AppendHTMLHeader(const FString& Title, FString& Out)
     {
-        HtmlContent += LogEntryToHTMLRow(LogEntry);
+        Out += TEXT("<!DOCTYPE html>\n");
+        Out += TEXT("<html lang=\"en\">\n");
+        Out += TEXT("<head>\n");
+        Out += TEXT("<meta charset=\"UTF-8\">\n");
+        Out += TEXT("<meta name=\"viewport\" content=\"width=device-width, initial-scale=1.0\">\n");
+        Out.Appendf(TEXT("<title>%s</title>\n"), *Title);
+        Out += TEXT("<link href=\"https://cdn.jsdelivr.net/npm/bootstrap@5.3.0-alpha1/dist/css/bootstrap.min.css\" rel=\"stylesheet\">\n");
+        Out += TEXT("<style>\n");
+        Out += TEXT("body { padding: 20px; }\n");
+        Out += TEXT(".conflict-container { display: flex; justify-content: space-between; margin-bottom: 20px; }\n");
+        Out += TEXT(".conflict-side { flex: 1; padding: 10px; border: 1px solid #ddd; border-radius: 5px; margin: 0 10px; }\n");
+        Out += TEXT(".conflict-local { background-color: #f8f9fa; }\n");
+        Out += TEXT(".conflict-remote { background-color: #f8f9fa; }\n");
+        Out += TEXT(".conflict-resolved { background-color: #d1e7dd; }\n");
+        Out += TEXT(".timeline { position: relative; margin: 20px 0; padding-left: 30px; }\n");
+        Out += TEXT(".timeline-item { position: relative; margin-bottom: 20px; }\n");
+        Out += TEXT(".timeline-item:before { content: ''; position: absolute; left: -30px; top: 0; width: 2px; height: 100%; background-color: #ddd; }\n");
+        Out += TEXT(".timeline-item:after { content: ''; position: absolute; left: -36px; top: 0; width: 14px; height: 14px; border-radius: 50%; background-color: #007bff; }\n");
+        Out += TEXT(".timeline-content { padding: 10px; border: 1px solid #ddd; border-radius: 5px; }\n");
+        Out += TEXT("</style>\n");
+        Out += TEXT("</head>\n");
+        Out += TEXT("<body>\n");
+        Out += TEXT("<div class=\"container\">\n");
+        Out.Appendf(TEXT("<h1>%s</h1>\n"), *Title);
+        Out += TEXT("<hr>\n");
     }
     
-    // 테이블 종료
-    HtmlContent += TEXT("</tbody>\n");
-    HtmlContent += TEXT("</table>\n");
-    
-    // HTML 문서 종료
-    HtmlContent += GenerateHTMLFooter();
+    /** HTML 푸터 추가 */
+    static void AppendHTMLFooter(FString& Out)
+    {
+        Out += TEXT("</div>\n");
+        Out += TEXT("<script src=\"https://cdn.jsdelivr.net/npm/bootstrap@5.3.0-alpha1/dist/js/bootstrap.bundle.min.js\"></script>\n");
+        Out += TEXT("</body>\n");
+        Out += TEXT("</html>\n");
+    }
     
-    // 디렉토리 생성
-    FString Directory = FPaths::GetPath(FilePath);
-    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-    if (!PlatformFile.DirectoryExists(*Directory))
+    /** 버퍼에 모았다가 일정 크기마다 UTF-8로 기록하는 파일 */
+    class FChunkedFileWriter
     {
-        if (!PlatformFile.CreateDirectoryTree(*Directory))
+    public:
+        bool Open(const FString& FilePath)
+        {
+            // 디렉토리 생성
+            FString Directory = FPaths::GetPath(FilePath);
+            IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+            if (!PlatformFile.DirectoryExists(*Directory))
+            {
+                if (!PlatformFile.CreateDirectoryTree(*Directory))
+                {
+                    UE_LOG(LogTemp, Error, TEXT("Failed to create directory: %s"), *Directory);
+                    return false;
+                }
+            }
+            
+            Archive.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+            if (!Archive)
+            {
+                UE_LOG(LogTemp, Error, TEXT("Failed to open file for writing: %s"), *FilePath);
+                return false;
+            }
+            
+            Buffer.Reset(FlushThreshold);
+            return true;
+        }
+        
+        FString& GetBuffer()
         {
-            UE_LOG(LogTemp, Error, TEXT("Failed to create directory: %s"), *Directory);
-            return false;
+            return Buffer;
         }
-    }
+        
+        void FlushIfFull()
+        {
+            if (Buffer.Len() >= FlushThreshold)
+            {
+                Flush();
+            }
+        }
+        
+        bool Close()
+        {
+            if (!Archive)
+            {
+                return false;
+            }
+            
+            Flush();
+            const bool bSuccess = Archive->Close();
+            Archive.Reset();
+            return bSuccess;
+        }
+        
+    private:
+        void Flush()
+        {
+            if (Buffer.Len() > 0)
+            {
+                FTCHARToUTF8 Utf8(*Buffer, Buffer.Len());
+                Archive->Serialize(const_cast<uint8*>(reinterpret_cast<const uint8*>(Utf8.Get())), Utf8.Length());
+                
+                // 버퍼 메모리는 다음 청크에 재사용
+                Buffer.Reset(FlushThreshold);
+            }
+        }
+        
+        TUniquePtr<FArchive> Archive;
+        FString Buffer;
+    };
     
-    // 파일에 저장
-    if (!FFileHelper::SaveStringToFile(HtmlContent, *FilePath))
+    /** 항목 수에 따라 여러 파일로 나누어 기록하는 HTML 페이지 */
+    class FPagedHTMLWriter
+    {
+    public:
+        FPagedHTMLWriter(const FString& InFilePath, const FString& InTitle, int32 InEntriesPerPage, int32 NumEntries)
+            : FilePath(InFilePath)
+            , Title(InTitle)
+            , EntriesPerPage(FMath::Max(0, InEntriesPerPage))
+            , NumPages(EntriesPerPage > 0 ? FMath::Max(1, FMath::DivideAndRoundUp(NumEntries, EntriesPerPage)) : 1)
+            , PageIndex(INDEX_NONE)
+            , EntriesInPage(0)
+        {
+        }
+        
+        /** 페이지 파일 경로 (첫 페이지는 요청한 경로 그대로) */
+        FString GetPagePath(int32 Index) const
+        {
+            if (Index == 0)
+            {
+                return FilePath;
+            }
+            return FString::Printf(TEXT("%s_%d%s"), *FPaths::GetBaseFilename(FilePath, false), Index + 1, *FPaths::GetExtension(FilePath, true));
+        }
+        
+        /** 현재 페이지가 가득 찼는지 (다음 항목 전에 확인) */
+        bool IsPageFull() const
+        {
+            return EntriesPerPage > 0 && EntriesInPage >= EntriesPerPage && PageIndex + 1 < NumPages;
+        }
+        
+        /** 다음 페이지 파일을 열고 머리와 페이지 이동 링크 기록 */
+        bool BeginPage()
+        {
+            ++PageIndex;
+            EntriesInPage = 0;
+            if (!File.Open(GetPagePath(PageIndex)))
+            {
+                return false;
+            }
+            
+            const FString PageTitle = NumPages > 1 ? FString::Printf(TEXT("%s (Page %d/%d)"), *Title, PageIndex + 1, NumPages) : Title;
+            AppendHTMLHeader(PageTitle, File.GetBuffer());
+            AppendNavigation();
+            return true;
+        }
+        
+        /** 페이지 이동 링크와 푸터를 기록하고 파일 닫기 */
+        bool EndPage()
+        {
+            AppendNavigation();
+            AppendHTMLFooter(File.GetBuffer());
+            
+            if (!File.Close())
+            {
+                UE_LOG(LogTemp, Error, TEXT("Failed to save HTML to file: %s"), *GetPagePath(PageIndex));
+                return false;
+            }
+            return true;
+        }
+        
+        FString& GetBuffer()
+        {
+            return File.GetBuffer();
+        }
+        
+        /** 항목 하나를 버퍼에 추가한 뒤 호출 */
+        void EntryWritten()
+        {
+            ++EntriesInPage;
+            File.FlushIfFull();
+        }
+        
+        int32 GetNumPages() const
+        {
+            return NumPages;
+        }
+        
+    private:
+        void AppendNavigation()
+        {
+            if (NumPages <= 1)
+            {
+                return;
+            }
+            
+            FString& Out = File.GetBuffer();
+            Out += TEXT("<nav><ul class=\"pagination flex-wrap\">\n");
+            for (int32 i = 0; i < NumPages; ++i)
+            {
+                Out.Appendf(TEXT("<li class=\"page-item%s\"><a class=\"page-link\" href=\"%s\">%d</a></li>\n"),
+                    i == PageIndex ? TEXT(" active") : TEXT(""), *FPaths::GetCleanFilename(GetPagePath(i)), i + 1);
+            }
+            Out += TEXT("</ul></nav>\n");
+        }
+        
+        FChunkedFileWriter File;
+        FString FilePath;
+        FString Title;
+        int32 EntriesPerPage;
+        int32 NumPages;
+        int32 PageIndex;
+        int32 EntriesInPage;
+    };
+}
+
+bool UJsonCRDTVisualizer::ExportToHTML(const TArray<FJsonCRDTLogEntry>& LogEntries, const FString& FilePath)
+{
+    return ExportEntries(EJsonCRDTVisualizerExportFormat::HTML, LogEntries, FilePath, EntriesPerPage, [](int32, int32) {});
+}
+
+bool UJsonCRDTVisualizer::ExportToCSV(const TArray<FJsonCRDTLogEntry>& LogEntries, const FString& FilePath)
+{
+    return ExportEntries(EJsonCRDTVisualizerExportFormat::CSV, LogEntries, FilePath, EntriesPerPage, [](int32, int32) {});
+}
+
+bool UJsonCRDTVisualizer::VisualizeDocumentHistory(const TArray<FJsonCRDTLogEntry>& LogEntries, const FString& FilePath)
+{
+    return ExportEntries(EJsonCRDTVisualizerExportFormat::DocumentHistory, LogEntries, FilePath, EntriesPerPage, [](int32, int32) {});
+}
+
+bool UJsonCRDTVisualizer::VisualizeConflicts(const TArray<FJsonCRDTLogEntry>& LogEntries, const FString& FilePath)
+{
+    return ExportEntries(EJsonCRDTVisualizerExportFormat::Conflicts, LogEntries, FilePath, EntriesPerPage, [](int32, int32) {});
+}
+
+void UJsonCRDTVisualizer::ExportAsync(EJsonCRDTVisualizerExportFormat Format, const TArray<FJsonCRDTLogEntry>& LogEntries, const FString& FilePath, FOnVisualizerExportProgress OnProgress, FOnVisualizerExportCompleted OnCompleted)
+{
+    // 작업 스레드에서는 이 객체를 건드리지 않도록 필요한 값만 복사
+    UE::Tasks::Launch(TEXT("JsonCRDTVisualizerExport"), [Format, LogEntries, FilePath, InEntriesPerPage = EntriesPerPage, OnProgress, OnCompleted]()
+    {
+        const bool bSuccess = ExportEntries(Format, LogEntries, FilePath, InEntriesPerPage, [&OnProgress](int32 NumExported, int32 NumTotal)
+        {
+            if (OnProgress.IsBound())
+            {
+                AsyncTask(ENamedThreads::GameThread, [OnProgress, NumExported, NumTotal]()
+                {
+                    OnProgress.ExecuteIfBound(NumExported, NumTotal);
+                });
+            }
+        });
+        
+        AsyncTask(ENamedThreads::GameThread, [OnCompleted, bSuccess]()
+        {
+            OnCompleted.ExecuteIfBound(bSuccess);
+        });
+    });
+}
+
+bool UJsonCRDTVisualizer::ExportEntries(EJsonCRDTVisualizerExportFormat Format, const TArray<FJsonCRDTLogEntry>& LogEntries, const FString& FilePath, int32 InEntriesPerPage, TFunctionRef<void(int32, int32)> OnProgress)
+{
+    switch (Format)
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to save HTML to file: %s"), *FilePath);
+    case EJsonCRDTVisualizerExportFormat::HTML:
+        return WriteHTMLTable(LogEntries, FilePath, InEntriesPerPage, OnProgress);
+    case EJsonCRDTVisualizerExportFormat::CSV:
+        return WriteCSV(LogEntries, FilePath, OnProgress);
+    case EJsonCRDTVisualizerExportFormat::DocumentHistory:
+        return WriteDocumentHistory(LogEntries, FilePath, InEntriesPerPage, OnProgress);
+    case EJsonCRDTVisualizerExportFormat::Conflicts:
+        return WriteConflicts(LogEntries, FilePath, InEntriesPerPage, OnProgress);
+    default:
         return false;
     }
-    
-    UE_LOG(LogTemp, Log, TEXT("Exported %d log entries to HTML file: %s"), LogEntries.Num(), *FilePath);
-    return true;
 }
 
-bool UJsonCRDTVisualizer::ExportToCSV(const TArray<FJsonCRDTLogEntry>& LogEntries, const FString& FilePath)
+bool UJsonCRDTVisualizer::WriteHTMLTable(const TArray<FJsonCRDTLogEntry>& LogEntries, const FString& FilePath, int32 InEntriesPerPage, TFunctionRef<void(int32, int32)> OnProgress)
 {
-    // CSV 헤더
-    FString CsvContent = TEXT("Timestamp,Document ID,Operation,Path,Old Value,New Value,Client ID,Source,Had Conflict\n");
+    using namespace JsonCRDTVisualizer;
     
-    // 각 로그 항목을 CSV 행으로 추가
-    for (const FJsonCRDTLogEntry& LogEntry : LogEntries)
+    // 테이블 시작
+    auto BeginTable = [](FString& Out)
     {
-        CsvContent += LogEntryToCSVRow(LogEntry);
+        Out += TEXT("<table class=\"table table-striped table-hover\">\n");
+        Out += TEXT("<thead>\n");
+        Out += TEXT("<tr>\n");
+        Out += TEXT("<th>Timestamp</th>\n");
+        Out += TEXT("<th>Document ID</th>\n");
+        Out += TEXT("<th>Operation</th>\n");
+        Out += TEXT("<th>Path</th>\n");
+        Out += TEXT("<th>Old Value</th>\n");
+        Out += TEXT("<th>New Value</th>\n");
+        Out += TEXT("<th>Client ID</th>\n");
+        Out += TEXT("<th>Source</th>\n");
+        Out += TEXT("<th>Conflict</th>\n");
+        Out += TEXT("</tr>\n");
+        Out += TEXT("</thead>\n");
+        Out += TEXT("<tbody>\n");
+    };
+    
+    // 테이블 종료
+    auto EndTable = [](FString& Out)
+    {
+        Out += TEXT("</tbody>\n");
+        Out += TEXT("</table>\n");
+    };
+    
+    FPagedHTMLWriter Writer(FilePath, TEXT("CRDT Log Visualization"), InEntriesPerPage, LogEntries.Num());
+    if (!Writer.BeginPage())
+    {
+        return false;
     }
+    BeginTable(Writer.GetBuffer());
     
-    // 디렉토리 생성
-    FString Directory = FPaths::GetPath(FilePath);
-    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-    if (!PlatformFile.DirectoryExists(*Directory))
+    // 각 로그 항목을 테이블 행으로 추가
+    for (int32 i = 0; i < LogEntries.Num(); ++i)
     {
-        if (!PlatformFile.CreateDirectoryTree(*Directory))
+        if (Writer.IsPageFull())
+        {
+            EndTable(Writer.GetBuffer());
+            if (!Writer.EndPage() || !Writer.BeginPage())
+            {
+                return false;
+            }
+            BeginTable(Writer.GetBuffer());
+        }
+        
+        AppendLogEntryHTMLRow(LogEntries[i], Writer.GetBuffer());
+        Writer.EntryWritten();
+        
+        if ((i + 1) % ProgressInterval == 0)
         {
-            UE_LOG(LogTemp, Error, TEXT("Failed to create directory: %s"), *Directory);
-            return false;
+            OnProgress(i + 1, LogEntries.Num());
         }
     }
     
-    // 파일에 저장
-    if (!FFileHelper::SaveStringToFile(CsvContent, *FilePath))
+    EndTable(Writer.GetBuffer());
+    if (!Writer.EndPage())
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to save CSV to file: %s"), *FilePath);
         return false;
     }
     
-    UE_LOG(LogTemp, Log, TEXT("Exported %d log entries to CSV file: %s"), LogEntries.Num(), *FilePath);
+    OnProgress(LogEntries.Num(), LogEntries.Num());
+    UE_LOG(LogTemp, Log, TEXT("Exported %d log entries to HTML file: %s (%d pages)"), LogEntries.Num(), *FilePath, Writer.GetNumPages());
     return true;
 }
 
-bool UJsonCRDTVisualizer::VisualizeDocumentHistory(const TArray<FJsonCRDTLogEntry>& LogEntries, const FString& FilePath)
+bool UJsonCRDTVisualizer::WriteCSV(const TArray<FJsonCRDTLogEntry>& LogEntries, const FString& FilePath, TFunctionRef<void(int32, int32)> OnProgress)
 {
-    // HTML 문서 생성
-    FString HtmlContent = GenerateHTMLHeader(TEXT("Document History Visualization"));
+    using namespace JsonCRDTVisualizer;
     
-    // 문서 변경 히스토리 시각화
-    HtmlContent += DocumentHistoryToHTML(LogEntries);
+    FChunkedFileWriter Writer;
+    if (!Writer.Open(FilePath))
+    {
+        return false;
+    }
     
-    // HTML 문서 종료
-    HtmlContent += GenerateHTMLFooter();
+    // CSV 헤더
+    Writer.GetBuffer() += TEXT("Timestamp,Document ID,Operation,Path,Old Value,New Value,Client ID,Source,Had Conflict\n");
     
-    // 디렉토리 생성
-    FString Directory = FPaths::GetPath(FilePath);
-    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-    if (!PlatformFile.DirectoryExists(*Directory))
+    // 각 로그 항목을 CSV 행으로 추가
+    for (int32 i = 0; i < LogEntries.Num(); ++i)
     {
-        if (!PlatformFile.CreateDirectoryTree(*Directory))
+        AppendLogEntryCSVRow(LogEntries[i], Writer.GetBuffer());
+        Writer.FlushIfFull();
+        
+        if ((i + 1) % ProgressInterval == 0)
         {
-            UE_LOG(LogTemp, Error, TEXT("Failed to create directory: %s"), *Directory);
-            return false;
+            OnProgress(i + 1, LogEntries.Num());
         }
     }
     
-    // 파일에 저장
-    if (!FFileHelper::SaveStringToFile(HtmlContent, *FilePath))
+    if (!Writer.Close())
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to save HTML to file: %s"), *FilePath);
+        UE_LOG(LogTemp, Error, TEXT("Failed to save CSV to file: %s"), *FilePath);
         return false;
     }
     
-    UE_LOG(LogTemp, Log, TEXT("Exported document history visualization to HTML file: %s"), *FilePath);
+    OnProgress(LogEntries.Num(), LogEntries.Num());
+    UE_LOG(LogTemp, Log, TEXT("Exported %d log entries to CSV file: %s"), LogEntries.Num(), *FilePath);
     return true;
 }
 
-bool UJsonCRDTVisualizer::VisualizeConflicts(const TArray<FJsonCRDTLogEntry>& LogEntries, const FString& FilePath)
+bool UJsonCRDTVisualizer::WriteDocumentHistory(const TArray<FJsonCRDTLogEntry>& LogEntries, const FString& FilePath, int32 InEntriesPerPage, TFunctionRef<void(int32, int32)> OnProgress)
 {
-    // 충돌이 있는 로그 항목만 필터링
-    TArray<FJsonCRDTLogEntry> ConflictLogs;
+    using namespace JsonCRDTVisualizer;
+    
+    // 항목을 복사하지 않고 인덱스만 문서(처음 나온 순서)별, 시간순으로 정렬
+    TMap<FString, int32> DocumentOrder;
+    TArray<int32> DocumentOfEntry;
+    DocumentOfEntry.Reserve(LogEntries.Num());
     for (const FJsonCRDTLogEntry& LogEntry : LogEntries)
     {
-        if (LogEntry.bHadConflict)
+        DocumentOfEntry.Add(DocumentOrder.FindOrAdd(LogEntry.DocumentID, DocumentOrder.Num()));
+    }
+    
+    TArray<int32> SortedIndices;
+    SortedIndices.Reserve(LogEntries.Num());
+    for (int32 i = 0; i < LogEntries.Num(); ++i)
+    {
+        SortedIndices.Add(i);
+    }
+    SortedIndices.StableSort([&LogEntries, &DocumentOfEntry](int32 A, int32 B)
+    {
+        if (DocumentOfEntry[A] != DocumentOfEntry[B])
         {
-            ConflictLogs.Add(LogEntry);
+            return DocumentOfEntry[A] < DocumentOfEntry[B];
         }
+        return LogEntries[A].Timestamp < LogEntries[B].Timestamp;
+    });
+    
+    FPagedHTMLWriter Writer(FilePath, TEXT("Document History Visualization"), InEntriesPerPage, LogEntries.Num());
+    if (!Writer.BeginPage())
+    {
+        return false;
     }
     
-    // 충돌이 없으면 빈 파일 생성
-    if (ConflictLogs.Num() == 0)
+    // 문서마다 타임라인 하나 (페이지가 바뀌면 같은 문서의 타임라인을 다시 엶)
+    int32 CurrentDocument = INDEX_NONE;
+    bool bTimelineOpen = false;
+    for (int32 i = 0; i < SortedIndices.Num(); ++i)
     {
-        UE_LOG(LogTemp, Warning, TEXT("No conflicts found in the log entries"));
-        
-        // HTML 문서 생성
-        FString HtmlContent = GenerateHTMLHeader(TEXT("Conflict Visualization"));
-        HtmlContent += TEXT("<div class=\"alert alert-info\">No conflicts found in the log entries.</div>\n");
-        HtmlContent += GenerateHTMLFooter();
+        const int32 EntryIndex = SortedIndices[i];
+        const FJsonCRDTLogEntry& LogEntry = LogEntries[EntryIndex];
         
-        // 디렉토리 생성
-        FString Directory = FPaths::GetPath(FilePath);
-        IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-        if (!PlatformFile.DirectoryExists(*Directory))
+        if (Writer.IsPageFull())
         {
-            if (!PlatformFile.CreateDirectoryTree(*Directory))
+            if (bTimelineOpen)
+            {
+                Writer.GetBuffer() += TEXT("</div>\n");
+                bTimelineOpen = false;
+            }
+            if (!Writer.EndPage() || !Writer.BeginPage())
             {
-                UE_LOG(LogTemp, Error, TEXT("Failed to create directory: %s"), *Directory);
                 return false;
             }
         }
         
-        // 파일에 저장
-        if (!FFileHelper::SaveStringToFile(HtmlContent, *FilePath))
+        if (!bTimelineOpen || DocumentOfEntry[EntryIndex] != CurrentDocument)
         {
-            UE_LOG(LogTemp, Error, TEXT("Failed to save HTML to file: %s"), *FilePath);
-            return false;
+            const bool bContinued = !bTimelineOpen && DocumentOfEntry[EntryIndex] == CurrentDocument;
+            if (bTimelineOpen)
+            {
+                Writer.GetBuffer() += TEXT("</div>\n");
+            }
+            
+            Writer.GetBuffer().Appendf(TEXT("<h2>Document: %s%s</h2>\n"), *LogEntry.DocumentID, bContinued ? TEXT(" (continued)") : TEXT(""));
+            Writer.GetBuffer() += TEXT("<div class=\"timeline\">\n");
+            CurrentDocument = DocumentOfEntry[EntryIndex];
+            bTimelineOpen = true;
         }
         
-        return true;
+        AppendTimelineItemHTML(LogEntry, Writer.GetBuffer());
+        Writer.EntryWritten();
+        
+        if ((i + 1) % ProgressInterval == 0)
+        {
+            OnProgress(i + 1, LogEntries.Num());
+        }
     }
     
-    // HTML 문서 생성
-    FString HtmlContent = GenerateHTMLHeader(TEXT("Conflict Visualization"));
+    if (bTimelineOpen)
+    {
+        Writer.GetBuffer() += TEXT("</div>\n");
+    }
+    if (!Writer.EndPage())
+    {
+        return false;
+    }
+    
+    OnProgress(LogEntries.Num(), LogEntries.Num());
+    UE_LOG(LogTemp, Log, TEXT("Exported document history visualization to HTML file: %s (%d pages)"), *FilePath, Writer.GetNumPages());
+    return true;
+}
+
+bool UJsonCRDTVisualizer::WriteConflicts(const TArray<FJsonCRDTLogEntry>& LogEntries, const FString& FilePath, int32 InEntriesPerPage, TFunctionRef<void(int32, int32)> OnProgress)
+{
+    using namespace JsonCRDTVisualizer;
+    
+    // 충돌이 있는 로그 항목만 필터링
+    TArray<int32> ConflictIndices;
+    for (int32 i = 0; i < LogEntries.Num(); ++i)
+    {
+        if (LogEntries[i].bHadConflict)
+        {
+            ConflictIndices.Add(i);
+        }
+    }
+    
+    FPagedHTMLWriter Writer(FilePath, TEXT("Conflict Visualization"), InEntriesPerPage, ConflictIndices.Num());
+    if (!Writer.BeginPage())
+    {
+        return false;
+    }
+    
+    // 충돌이 없으면 빈 파일 생성
+    if (ConflictIndices.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("No conflicts found in the log entries"));
+        
+        Writer.GetBuffer() += TEXT("<div class=\"alert alert-info\">No conflicts found in the log entries.</div>\n");
+        return Writer.EndPage();
+    }
     
     // 충돌 개요
-    HtmlContent += TEXT("<div class=\"alert alert-warning\">\n");
-    HtmlContent += FString::Printf(TEXT("<h4>Found %d conflicts</h4>\n"), ConflictLogs.Num());
-    HtmlContent += TEXT("</div>\n");
+    auto AppendOverview = [&ConflictIndices](FString& Out)
+    {
+        Out += TEXT("<div class=\"alert alert-warning\">\n");
+        Out.Appendf(TEXT("<h4>Found %d conflicts</h4>\n"), ConflictIndices.Num());
+        Out += TEXT("</div>\n");
+    };
+    AppendOverview(Writer.GetBuffer());
     
     // 각 충돌 시각화
-    for (int32 i = 0; i < ConflictLogs.Num(); ++i)
+    for (int32 i = 0; i < ConflictIndices.Num(); ++i)
     {
-        const FJsonCRDTLogEntry& LogEntry = ConflictLogs[i];
+        if (Writer.IsPageFull())
+        {
+            if (!Writer.EndPage() || !Writer.BeginPage())
+            {
+                return false;
+            }
+            AppendOverview(Writer.GetBuffer());
+        }
         
-        HtmlContent += TEXT("<div class=\"card mb-4\">\n");
-        HtmlContent += TEXT("<div class=\"card-header\">\n");
-        HtmlContent += FString::Printf(TEXT("<h5>Conflict #%d - %s</h5>\n"), i + 1, *LogEntry.Timestamp.ToString());
-        HtmlContent += TEXT("</div>\n");
-        HtmlContent += TEXT("<div class=\"card-body\">\n");
+        const FJsonCRDTLogEntry& LogEntry = LogEntries[ConflictIndices[i]];
+        FString& Out = Writer.GetBuffer();
+        
+        Out += TEXT("<div class=\"card mb-4\">\n");
+        Out += TEXT("<div class=\"card-header\">\n");
+        Out.Appendf(TEXT("<h5>Conflict #%d - %s</h5>\n"), i + 1, *LogEntry.Timestamp.ToString());
+        Out += TEXT("</div>\n");
+        Out += TEXT("<div class=\"card-body\">\n");
         
         // 충돌 정보
-        HtmlContent += TEXT("<dl class=\"row\">\n");
-        HtmlContent += FString::Printf(TEXT("<dt class=\"col-sm-3\">Document ID</dt><dd class=\"col-sm-9\">%s</dd>\n"), *LogEntry.DocumentID);
-        HtmlContent += FString::Printf(TEXT("<dt class=\"col-sm-3\">Path</dt><dd class=\"col-sm-9\">%s</dd>\n"), *LogEntry.Path);
-        HtmlContent += FString::Printf(TEXT("<dt class=\"col-sm-3\">Operation</dt><dd class=\"col-sm-9\">%s</dd>\n"), *LogEntry.OperationType);
-        HtmlContent += FString::Printf(TEXT("<dt class=\"col-sm-3\">Client ID</dt><dd class=\"col-sm-9\">%s</dd>\n"), *LogEntry.ClientID);
-        HtmlContent += TEXT("</dl>\n");
+        Out += TEXT("<dl class=\"row\">\n");
+        Out.Appendf(TEXT("<dt class=\"col-sm-3\">Document ID</dt><dd class=\"col-sm-9\">%s</dd>\n"), *LogEntry.DocumentID);
+        Out.Appendf(TEXT("<dt class=\"col-sm-3\">Path</dt><dd class=\"col-sm-9\">%s</dd>\n"), *LogEntry.Path);
+        Out.Appendf(TEXT("<dt class=\"col-sm-3\">Operation</dt><dd class=\"col-sm-9\">%s</dd>\n"), *LogEntry.OperationType);
+        Out.Appendf(TEXT("<dt class=\"col-sm-3\">Client ID</dt><dd class=\"col-sm-9\">%s</dd>\n"), *LogEntry.ClientID);
+        Out += TEXT("</dl>\n");
         
         // 충돌 시각화
-        HtmlContent += ConflictToHTML(LogEntry.Conflict);
+        AppendConflictHTML(LogEntry.Conflict, Out);
         
-        HtmlContent += TEXT("</div>\n");
-        HtmlContent += TEXT("</div>\n");
-    }
-    
-    // HTML 문서 종료
-    HtmlContent += GenerateHTMLFooter();
-    
-    // 디렉토리 생성
-    FString Directory = FPaths::GetPath(FilePath);
-    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-    if (!PlatformFile.DirectoryExists(*Directory))
-    {
-        if (!PlatformFile.CreateDirectoryTree(*Directory))
+        Out += TEXT("</div>\n");
+        Out += TEXT("</div>\n");
+        Writer.EntryWritten();
+        
+        if ((i + 1) % ProgressInterval == 0)
         {
-            UE_LOG(LogTemp, Error, TEXT("Failed to create directory: %s"), *Directory);
-            return false;
+            OnProgress(i + 1, ConflictIndices.Num());
         }
     }
     
-    // 파일에 저장
-    if (!FFileHelper::SaveStringToFile(HtmlContent, *FilePath))
+    if (!Writer.EndPage())
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to save HTML to file: %s"), *FilePath);
         return false;
     }
     
-    UE_LOG(LogTemp, Log, TEXT("Exported conflict visualization to HTML file: %s"), *FilePath);
+    OnProgress(ConflictIndices.Num(), ConflictIndices.Num());
+    UE_LOG(LogTemp, Log, TEXT("Exported conflict visualization to HTML file: %s (%d pages)"), *FilePath, Writer.GetNumPages());
     return true;
 }
 
-FString UJsonCRDTVisualizer::GenerateHTMLHeader(const FString& Title)
-{
-    FString Header = TEXT("<!DOCTYPE html>\n");
-    Header += TEXT("<html lang=\"en\">\n");
-    Header += TEXT("<head>\n");
-    Header += TEXT("<meta charset=\"UTF-8\">\n");
-    Header += TEXT("<meta name=\"viewport\" content=\"width=device-width, initial-scale=1.0\">\n");
-    Header += FString::Printf(TEXT("<title>%s</title>\n"), *Title);
-    Header += TEXT("<link href=\"https://cdn.jsdelivr.net/npm/bootstrap@5.3.0-alpha1/dist/css/bootstrap.min.css\" rel=\"stylesheet\">\n");
-    Header += TEXT("<style>\n");
-    Header += TEXT("body { padding: 20px; }\n");
-    Header += TEXT(".conflict-container { display: flex; justify-content: space-between; margin-bottom: 20px; }\n");
-    Header += TEXT(".conflict-side { flex: 1; padding: 10px; border: 1px solid #ddd; border-radius: 5px; margin: 0 10px; }\n");
-    Header += TEXT(".conflict-local { background-color: #f8f9fa; }\n");
-    Header += TEXT(".conflict-remote { background-color: #f8f9fa; }\n");
-    Header += TEXT(".conflict-resolved { background-color: #d1e7dd; }\n");
-    Header += TEXT(".timeline { position: relative; margin: 20px 0; padding-left: 30px; }\n");
-    Header += TEXT(".timeline-item { position: relative; margin-bottom: 20px; }\n");
-    Header += TEXT(".timeline-item:before { content: ''; position: absolute; left: -30px; top: 0; width: 2px; height: 100%; background-color: #ddd; }\n");
-    Header += TEXT(".timeline-item:after { content: ''; position: absolute; left: -36px; top: 0; width: 14px; height: 14px; border-radius: 50%; background-color: #007bff; }\n");
-    Header += TEXT(".timeline-content { padding: 10px; border: 1px solid #ddd; border-radius: 5px; }\n");
-    Header += TEXT("</style>\n");
-    Header += TEXT("</head>\n");
-    Header += TEXT("<body>\n");
-    Header += TEXT("<div class=\"container\">\n");
-    Header += FString::Printf(TEXT("<h1>%s</h1>\n"), *Title);
-    Header += TEXT("<hr>\n");
-    
-    return Header;
-}
-
-FString UJsonCRDTVisualizer::GenerateHTMLFooter()
+void UJsonCRDTVisualizer::AppendLogEntryHTMLRow(const FJsonCRDTLogEntry& LogEntry, FString& Out)
 {
-    FString Footer = TEXT("</div>\n");
-    Footer += TEXT("<script src=\"https://cdn.jsdelivr.net/npm/bootstrap@5.3.0-alpha1/dist/js/bootstrap.bundle.min.js\"></script>\n");
-    Footer += TEXT("</body>\n");
-    Footer += TEXT("</html>\n");
-    
-    return Footer;
-}
-
-FString UJsonCRDTVisualizer::LogEntryToHTMLRow(const FJsonCRDTLogEntry& LogEntry)
-{
-    FString Row = TEXT("<tr");
+    Out += TEXT("<tr");
     
     // 충돌이 있는 경우 행 강조
     if (LogEntry.bHadConflict)
     {
-        Row += TEXT(" class=\"table-warning\"");
+        Out += TEXT(" class=\"table-warning\"");
     }
     
-    Row += TEXT(">\n");
+    Out += TEXT(">\n");
     
     // 타임스탬프
-    Row += FString::Printf(TEXT("<td>%s</td>\n"), *LogEntry.Timestamp.ToString());
+    Out.Appendf(TEXT("<td>%s</td>\n"), *LogEntry.Timestamp.ToString());
     
     // 문서 ID
-    Row += FString::Printf(TEXT("<td>%s</td>\n"), *LogEntry.DocumentID);
+    Out.Appendf(TEXT("<td>%s</td>\n"), *LogEntry.DocumentID);
     
     // 작업 유형
-    Row += FString::Printf(TEXT("<td>%s</td>\n"), *LogEntry.OperationType);
+    Out.Appendf(TEXT("<td>%s</td>\n"), *LogEntry.OperationType);
     
     // 경로
-    Row += FString::Printf(TEXT("<td>%s</td>\n"), *LogEntry.Path);
+    Out.Appendf(TEXT("<td>%s</td>\n"), *LogEntry.Path);
     
     // 이전 값
-    Row += FString::Printf(TEXT("<td><code>%s</code></td>\n"), *LogEntry.OldValue);
+    Out.Appendf(TEXT("<td><code>%s</code></td>\n"), *LogEntry.OldValue);
     
     // 새 값
-    Row += FString::Printf(TEXT("<td><code>%s</code></td>\n"), *LogEntry.NewValue);
+    Out.Appendf(TEXT("<td><code>%s</code></td>\n"), *LogEntry.NewValue);
     
     // 클라이언트 ID
-    Row += FString::Printf(TEXT("<td>%s</td>\n"), *LogEntry.ClientID);
+    Out.Appendf(TEXT("<td>%s</td>\n"), *LogEntry.ClientID);
     
     // 소스
-    Row += FString::Printf(TEXT("<td>%s</td>\n"), *LogEntry.Source);
+    Out.Appendf(TEXT("<td>%s</td>\n"), *LogEntry.Source);
     
     // 충돌
     if (LogEntry.bHadConflict)
     {
-        Row += TEXT("<td><span class=\"badge bg-warning\">Conflict</span></td>\n");
+        Out += TEXT("<td><span class=\"badge bg-warning\">Conflict</span></td>\n");
     }
     else
     {
-        Row += TEXT("<td></td>\n");
+        Out += TEXT("<td></td>\n");
     }
     
-    Row += TEXT("</tr>\n");
-    
-    return Row;
+    Out += TEXT("</tr>\n");
 }
 
-FString UJsonCRDTVisualizer::LogEntryToCSVRow(const FJsonCRDTLogEntry& LogEntry)
+void UJsonCRDTVisualizer::AppendLogEntryCSVRow(const FJsonCRDTLogEntry& LogEntry, FString& Out)
 {
-    // CSV 필드 이스케이프
-    auto EscapeCSV = [](const FString& Field) -> FString
+    // CSV 필드 이스케이프 (따옴표가 필요 없으면 복사 없이 바로 추가)
+    auto AppendCSVField = [&Out](const FString& Field)
     {
-        FString Result = Field;
-        Result.ReplaceInline(TEXT("\""), TEXT("\"\""));
-        if (Result.Contains(TEXT(",")) || Result.Contains(TEXT("\"")) || Result.Contains(TEXT("\n")))
+        int32 Index;
+        if (!Field.FindChar(TEXT(','), Index) && !Field.FindChar(TEXT('"'), Index) && !Field.FindChar(TEXT('\n'), Index))
         {
-            Result = FString::Printf(TEXT("\"%s\""), *Result);
+            Out += Field;
+            Out += TEXT(",");
+            return;
         }
-        return Result;
+        
+        Out += TEXT("\"");
+        Out += Field.Replace(TEXT("\""), TEXT("\"\""));
+        Out += TEXT("\",");
     };
     
-    FString Row;
-    
     // 타임스탬프
-    Row += EscapeCSV(LogEntry.Timestamp.ToString()) + TEXT(",");
+    AppendCSVField(LogEntry.Timestamp.ToString());
     
     // 문서 ID
-    Row += EscapeCSV(LogEntry.DocumentID) + TEXT(",");
+    AppendCSVField(LogEntry.DocumentID);
     
     // 작업 유형
-    Row += EscapeCSV(LogEntry.OperationType) + TEXT(",");
+    AppendCSVField(LogEntry.OperationType);
     
     // 경로
-    Row += EscapeCSV(LogEntry.Path) + TEXT(",");
+    AppendCSVField(LogEntry.Path);
     
     // 이전 값
-    Row += EscapeCSV(LogEntry.OldValue) + TEXT(",");
+    AppendCSVField(LogEntry.OldValue);
     
     // 새 값
-    Row += EscapeCSV(LogEntry.NewValue) + TEXT(",");
+    AppendCSVField(LogEntry.NewValue);
     
     // 클라이언트 ID
-    Row += EscapeCSV(LogEntry.ClientID) + TEXT(",");
+    AppendCSVField(LogEntry.ClientID);
     
     // 소스
-    Row += EscapeCSV(LogEntry.Source) + TEXT(",");
+    AppendCSVField(LogEntry.Source);
     
     // 충돌 여부
-    Row += LogEntry.bHadConflict ? TEXT("Yes") : TEXT("No");
-    
-    Row += TEXT("\n");
+    Out += LogEntry.bHadConflict ? TEXT("Yes") : TEXT("No");
     
-    return Row;
+    Out += TEXT("\n");
 }
 
-FString UJsonCRDTVisualizer::ConflictToHTML(const FJsonCRDTConflict& Conflict)
+void UJsonCRDTVisualizer::AppendConflictHTML(const FJsonCRDTConflict& Conflict, FString& Out)
 {
-    FString Html = TEXT("<div class=\"conflict-container\">\n");
+    Out += TEXT("<div class=\"conflict-container\">\n");
     
     // 로컬 측
-    Html += TEXT("<div class=\"conflict-side conflict-local\">\n");
-    Html += TEXT("<h5>Local</h5>\n");
-    Html += TEXT("<dl class=\"row\">\n");
-    Html += FString::Printf(TEXT("<dt class=\"col-sm-3\">Value</dt><dd class=\"col-sm-9\"><code>%s</code></dd>\n"), *Conflict.LocalValue);
-    Html += FString::Printf(TEXT("<dt class=\"col-sm-3\">Operation</dt><dd class=\"col-sm-9\">%s</dd>\n"), *FString::FromInt(static_cast<int32>(Conflict.LocalOperation.Type)));
-    Html += FString::Printf(TEXT("<dt class=\"col-sm-3\">Path</dt><dd class=\"col-sm-9\">%s</dd>\n"), *Conflict.LocalOperation.Path);
-    Html += FString::Printf(TEXT("<dt class=\"col-sm-3\">Timestamp</dt><dd class=\"col-sm-9\">%s</dd>\n"), *Conflict.LocalOperation.Timestamp.ToString());
-    Html += TEXT("</dl>\n");
-    Html += TEXT("</div>\n");
+    Out += TEXT("<div class=\"conflict-side conflict-local\">\n");
+    Out += TEXT("<h5>Local</h5>\n");
+    Out += TEXT("<dl class=\"row\">\n");
+    Out.Appendf(TEXT("<dt class=\"col-sm-3\">Value</dt><dd class=\"col-sm-9\"><code>%s</code></dd>\n"), *Conflict.LocalValue);
+    Out.Appendf(TEXT("<dt class=\"col-sm-3\">Sequence</dt><dd class=\"col-sm-9\">%lld</dd>\n"), Conflict.LocalSequence);
+    Out.Appendf(TEXT("<dt class=\"col-sm-3\">Timestamp</dt><dd class=\"col-sm-9\">%s</dd>\n"), *Conflict.LocalTimestamp.ToString());
+    Out += TEXT("</dl>\n");
+    Out += TEXT("</div>\n");
     
     // 원격 측
-    Html += TEXT("<div class=\"conflict-side conflict-remote\">\n");
-    Html += TEXT("<h5>Remote</h5>\n");
-    Html += TEXT("<dl class=\"row\">\n");
-    Html += FString::Printf(TEXT("<dt class=\"col-sm-3\">Value</dt><dd class=\"col-sm-9\"><code>%s</code></dd>\n"), *Conflict.RemoteValue);
-    Html += FString::Printf(TEXT("<dt class=\"col-sm-3\">Operation</dt><dd class=\"col-sm-9\">%s</dd>\n"), *FString::FromInt(static_cast<int32>(Conflict.RemoteOperation.Type)));
-    Html += FString::Printf(TEXT("<dt class=\"col-sm-3\">Path</dt><dd class=\"col-sm-9\">%s</dd>\n"), *Conflict.RemoteOperation.Path);
-    Html += FString::Printf(TEXT("<dt class=\"col-sm-3\">Timestamp</dt><dd class=\"col-sm-9\">%s</dd>\n"), *Conflict.RemoteOperation.Timestamp.ToString());
-    Html += TEXT("</dl>\n");
-    Html += TEXT("</div>\n");
+    Out += TEXT("<div class=\"conflict-side conflict-remote\">\n");
+    Out += TEXT("<h5>Remote</h5>\n");
+    Out += TEXT("<dl class=\"row\">\n");
+    Out.Appendf(TEXT("<dt class=\"col-sm-3\">Value</dt><dd class=\"col-sm-9\"><code>%s</code></dd>\n"), *Conflict.RemoteValue);
+    Out.Appendf(TEXT("<dt class=\"col-sm-3\">Sequence</dt><dd class=\"col-sm-9\">%lld</dd>\n"), Conflict.RemoteSequence);
+    Out.Appendf(TEXT("<dt class=\"col-sm-3\">Timestamp</dt><dd class=\"col-sm-9\">%s</dd>\n"), *Conflict.RemoteTimestamp.ToString());
+    Out += TEXT("</dl>\n");
+    Out += TEXT("</div>\n");
     
     // 해결된 값
-    Html += TEXT("<div class=\"conflict-side conflict-resolved\">\n");
-    Html += TEXT("<h5>Resolved</h5>\n");
-    Html += TEXT("<dl class=\"row\">\n");
-    Html += FString::Printf(TEXT("<dt class=\"col-sm-3\">Value</dt><dd class=\"col-sm-9\"><code>%s</code></dd>\n"), *Conflict.ResolvedValue);
-    Html += FString::Printf(TEXT("<dt class=\"col-sm-3\">Resolved</dt><dd class=\"col-sm-9\">%s</dd>\n"), Conflict.bResolved ? TEXT("Yes") : TEXT("No"));
-    Html += TEXT("</dl>\n");
-    Html += TEXT("</div>\n");
-    
-    Html += TEXT("</div>\n");
-    
-    return Html;
+    Out += TEXT("<div class=\"conflict-side conflict-resolved\">\n");
+    Out += TEXT("<h5>Resolved</h5>\n");
+    Out += TEXT("<dl class=\"row\">\n");
+    Out.Appendf(TEXT("<dt class=\"col-sm-3\">Value</dt><dd class=\"col-sm-9\"><code>%s</code></dd>\n"), *Conflict.ResolvedValue);
+    Out.Appendf(TEXT("<dt class=\"col-sm-3\">Resolved</dt><dd class=\"col-sm-9\">%s</dd>\n"), Conflict.bResolved ? TEXT("Yes") : TEXT("No"));
+    Out += TEXT("</dl>\n");
+    Out += TEXT("</div>\n");
+    
+    Out += TEXT("</div>\n");
 }
 
-FString UJsonCRDTVisualizer::DocumentHistoryToHTML(const TArray<FJsonCRDTLogEntry>& LogEntries)
+void UJsonCRDTVisualizer::AppendTimelineItemHTML(const FJsonCRDTLogEntry& LogEntry, FString& Out)
 {
-    // 문서 ID별로 로그 항목 그룹화
-    TMap<FString, TArray<FJsonCRDTLogEntry>> DocumentLogs;
-    for (const FJsonCRDTLogEntry& LogEntry : LogEntries)
-    {
-        TArray<FJsonCRDTLogEntry>& Logs = DocumentLogs.FindOrAdd(LogEntry.DocumentID);
-        Logs.Add(LogEntry);
-    }
-    
-    FString Html;
-    
-    // 각 문서에 대한 타임라인 생성
-    for (const auto& Pair : DocumentLogs)
+    Out += TEXT("<div class=\"timeline-item\">\n");
+    Out.Appendf(TEXT("<div class=\"timeline-date\">%s</div>\n"), *LogEntry.Timestamp.ToString());
+    
+    Out += TEXT("<div class=\"timeline-content\">\n");
+    
+    // 작업 정보
+    Out.Appendf(TEXT("<h5>%s</h5>\n"), *LogEntry.OperationType);
+    Out += TEXT("<dl class=\"row\">\n");
+    Out.Appendf(TEXT("<dt class=\"col-sm-3\">Path</dt><dd class=\"col-sm-9\">%s</dd>\n"), *LogEntry.Path);
+    Out.Appendf(TEXT("<dt class=\"col-sm-3\">Old Value</dt><dd class=\"col-sm-9\"><code>%s</code></dd>\n"), *LogEntry.OldValue);
+    Out.Appendf(TEXT("<dt class=\"col-sm-3\">New Value</dt><dd class=\"col-sm-9\"><code>%s</code></dd>\n"), *LogEntry.NewValue);
+    Out.Appendf(TEXT("<dt class=\"col-sm-3\">Client ID</dt><dd class=\"col-sm-9\">%s</dd>\n"), *LogEntry.ClientID);
+    Out.Appendf(TEXT("<dt class=\"col-sm-3\">Source</dt><dd class=\"col-sm-9\">%s</dd>\n"), *LogEntry.Source);
+    Out += TEXT("</dl>\n");
+    
+    // 충돌 정보
+    if (LogEntry.bHadConflict)
     {
-        const FString& DocumentID = Pair.Key;
-        const TArray<FJsonCRDTLogEntry>& Logs = Pair.Value;
-        
-        Html += FString::Printf(TEXT("<h2>Document: %s</h2>\n"), *DocumentID);
-        Html += TEXT("<div class=\"timeline\">\n");
-        
-        // 시간순으로 정렬된 로그 항목
-        TArray<FJsonCRDTLogEntry> SortedLogs = Logs;
-        SortedLogs.Sort([](const FJsonCRDTLogEntry& A, const FJsonCRDTLogEntry& B) {
-            return A.Timestamp < B.Timestamp;
-        });
-        
-        // 각 로그 항목을 타임라인 항목으로 추가
-        for (const FJsonCRDTLogEntry& LogEntry : SortedLogs)
-        {
-            Html += TEXT("<div class=\"timeline-item\">\n");
-            Html += FString::Printf(TEXT("<div class=\"timeline-date\">%s</div>\n"), *LogEntry.Timestamp.ToString());
-            
-            Html += TEXT("<div class=\"timeline-content\">\n");
-            
-            // 작업 정보
-            Html += FString::Printf(TEXT("<h5>%s</h5>\n"), *LogEntry.OperationType);
-            Html += TEXT("<dl class=\"row\">\n");
-            Html += FString::Printf(TEXT("<dt class=\"col-sm-3\">Path</dt><dd class=\"col-sm-9\">%s</dd>\n"), *LogEntry.Path);
-            Html += FString::Printf(TEXT("<dt class=\"col-sm-3\">Old Value</dt><dd class=\"col-sm-9\"><code>%s</code></dd>\n"), *LogEntry.OldValue);
-            Html += FString::Printf(TEXT("<dt class=\"col-sm-3\">New Value</dt><dd class=\"col-sm-9\"><code>%s</code></dd>\n"), *LogEntry.NewValue);
-            Html += FString::Printf(TEXT("<dt class=\"col-sm-3\">Client ID</dt><dd class=\"col-sm-9\">%s</dd>\n"), *LogEntry.ClientID);
-            Html += FString::Printf(TEXT("<dt class=\"col-sm-3\">Source</dt><dd class=\"col-sm-9\">%s</dd>\n"), *LogEntry.Source);
-            Html += TEXT("</dl>\n");
-            
-            // 충돌 정보
-            if (LogEntry.bHadConflict)
-            {
-                Html += TEXT("<div class=\"alert alert-warning\">\n");
-                Html += TEXT("<h6>Conflict Detected</h6>\n");
-                Html += ConflictToHTML(LogEntry.Conflict);
-                Html += TEXT("</div>\n");
-            }
-            
-            Html += TEXT("</div>\n");
-            Html += TEXT("</div>\n");
-        }
-        
-        Html += TEXT("</div>\n");
+        Out += TEXT("<div class=\"alert alert-warning\">\n");
+        Out += TEXT("<h6>Conflict Detected</h6>\n");
+        AppendConflictHTML(LogEntry.Conflict, Out);
+        Out += TEXT("</div>\n");
     }
     
-    return Html;
+    Out += TEXT("</div>\n");
+    Out += TEXT("</div>\n");
 }
@@ -0,0 +1,290 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "JsonCRDTDocument.h"
+#include "JsonCRDTLocalStorageWriter.h"
+#include "Dom/JsonValue.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace JsonCRDTDocumentSpec
+{
+	/** 테스트 문서 ID 접두사 (로컬 저장 파일이 이 폴더 아래에 생기고 테스트마다 지워짐) */
+	static const TCHAR* DocumentPrefix = TEXT("JsonCRDTSpec/");
+
+	/** 초기 내용 */
+	static const TCHAR* InitialContent = TEXT("{\"player\":{\"name\":\"a\",\"hp\":100,\"items\":[\"sword\",\"shield\"]},\"score\":1}");
+
+	/** 두 JSON 문자열을 구조로 비교 (숫자 표기는 엔진 버전마다 다르므로 문자열로 비교하지 않음) */
+	static bool JsonEquals(const FString& A, const FString& B)
+	{
+		// 스칼라도 읽을 수 있게 배열로 감싸서 파싱
+		TArray<TSharedPtr<FJsonValue>> ValuesA;
+		TArray<TSharedPtr<FJsonValue>> ValuesB;
+		if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(TEXT("[") + A + TEXT("]")), ValuesA)
+			|| !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(TEXT("[") + B + TEXT("]")), ValuesB))
+		{
+			return false;
+		}
+		return ValuesA.Num() == 1 && ValuesB.Num() == 1 && FJsonValue::CompareEqual(*ValuesA[0], *ValuesB[0]);
+	}
+
+	/** 로거 없이 문서 생성 */
+	static UJsonCRDTDocument* CreateDocument(const FString& DocumentID)
+	{
+		UJsonCRDTDocument* Document = NewObject<UJsonCRDTDocument>(GetTransientPackage());
+		Document->Initialize(DocumentID, nullptr);
+		Document->SetLoggingEnabled(false);
+		return Document;
+	}
+
+	/** 작업 하나 (Ticks가 0이면 적용할 때 현재 시각) */
+	static FJsonCRDTOperation MakeOperation(EJsonCRDTOperationType Type, const TCHAR* Path, const TCHAR* Value = TEXT(""), int64 Ticks = 0)
+	{
+		FJsonCRDTOperation Operation;
+		Operation.Type = Type;
+		Operation.Path = Path;
+		Operation.Value = Value;
+		Operation.Timestamp = FDateTime(Ticks);
+		return Operation;
+	}
+
+	/** 원격 클라이언트의 패치 */
+	static FJsonCRDTPatch MakeRemotePatch(const FString& DocumentID, const TArray<FJsonCRDTOperation>& Operations, int64 Sequence, int64 Ticks)
+	{
+		FJsonCRDTPatch Patch;
+		Patch.DocumentID = DocumentID;
+		Patch.ClientID = TEXT("remote");
+		Patch.Sequence = Sequence;
+		Patch.Timestamp = FDateTime(Ticks);
+		Patch.Operations = Operations;
+		for (FJsonCRDTOperation& Operation : Patch.Operations)
+		{
+			Operation.ClientID = Patch.ClientID;
+			Operation.Timestamp = Patch.Timestamp;
+		}
+		return Patch;
+	}
+}
+
+BEGIN_DEFINE_SPEC(FJsonCRDTDocumentSpec, "JsonCRDT.Document", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+	FString DocumentID;
+	UJsonCRDTDocument* Document = nullptr;
+
+	/** 경로의 값 (없으면 빈 문자열) */
+	FString ValueAt(const UJsonCRDTDocument* Target, const TCHAR* Path) const
+	{
+		FString Value;
+		Target->GetValueAtPath(Path, Value);
+		return Value;
+	}
+
+	/** 저장한 문서를 같은 ID의 새 문서로 읽어 내용과 버전 비교 */
+	void TestRoundTrip(EJsonCRDTLocalStorageFormat Format);
+END_DEFINE_SPEC(FJsonCRDTDocumentSpec)
+
+void FJsonCRDTDocumentSpec::TestRoundTrip(EJsonCRDTLocalStorageFormat Format)
+{
+	using namespace JsonCRDTDocumentSpec;
+
+	Document->SetLocalStorageFormat(Format);
+	TestTrue(TEXT("Local operation"), Document->ApplyLocalOperation(MakeOperation(EJsonCRDTOperationType::Add, TEXT("/player/items/-"), TEXT("{\"name\":\"potion\",\"count\":3}"))));
+	TestTrue(TEXT("Saved"), Document->SaveLocally());
+	FJsonCRDTLocalStorageWriter::Get().Flush();
+
+	UJsonCRDTDocument* Loaded = CreateDocument(DocumentID);
+	Loaded->SetLocalStorageFormat(Format);
+	TestTrue(TEXT("Loaded"), Loaded->LoadFromLocal());
+	TestEqual(TEXT("Version"), Loaded->GetVersion(), Document->GetVersion());
+	TestTrue(TEXT("Value before decoding"), JsonEquals(ValueAt(Loaded, TEXT("/player/items/2/count")), TEXT("3")));
+	TestTrue(TEXT("Content"), JsonEquals(Loaded->GetContentAsString(), Document->GetContentAsString()));
+}
+
+void FJsonCRDTDocumentSpec::Define()
+{
+	using namespace JsonCRDTDocumentSpec;
+
+	BeforeEach([this]()
+	{
+		DocumentID = FString(DocumentPrefix) + FGuid::NewGuid().ToString(EGuidFormats::Digits);
+		Document = CreateDocument(DocumentID);
+		Document->SetContentFromString(InitialContent);
+	});
+
+	AfterEach([this]()
+	{
+		Document = nullptr;
+		FJsonCRDTLocalStorageWriter::Get().Flush();
+		IFileManager::Get().DeleteDirectory(*(FPaths::ProjectSavedDir() / TEXT("JsonCRDT") / DocumentPrefix), false, true);
+	});
+
+	Describe("GetValueAtPath", [this]()
+	{
+		It("returns values as JSON", [this]()
+		{
+			TestTrue(TEXT("String"), JsonEquals(ValueAt(Document, TEXT("/player/name")), TEXT("\"a\"")));
+			TestTrue(TEXT("Number"), JsonEquals(ValueAt(Document, TEXT("/player/hp")), TEXT("100")));
+			TestTrue(TEXT("Array element"), JsonEquals(ValueAt(Document, TEXT("/player/items/1")), TEXT("\"shield\"")));
+			TestTrue(TEXT("Object"), JsonEquals(ValueAt(Document, TEXT("/player/items")), TEXT("[\"sword\",\"shield\"]")));
+		});
+
+		It("returns the whole document for the empty path", [this]()
+		{
+			TestTrue(TEXT("Root"), JsonEquals(ValueAt(Document, TEXT("")), InitialContent));
+		});
+
+		It("fails for missing paths", [this]()
+		{
+			FString Value;
+			TestFalse(TEXT("Missing field"), Document->GetValueAtPath(TEXT("/player/missing"), Value));
+			TestFalse(TEXT("Out of range"), Document->GetValueAtPath(TEXT("/player/items/2"), Value));
+		});
+	});
+
+	Describe("ApplyPatch", [this]()
+	{
+		It("applies remote operations in order", [this]()
+		{
+			const int64 Ticks = FDateTime::UtcNow().GetTicks();
+			const int64 VersionBefore = Document->GetVersion();
+
+			FJsonCRDTOperation Copy = MakeOperation(EJsonCRDTOperationType::Copy, TEXT("/player/backup"));
+			Copy.FromPath = TEXT("/player/items");
+			TestTrue(TEXT("Applied"), Document->ApplyPatch(MakeRemotePatch(DocumentID,
+			{
+				MakeOperation(EJsonCRDTOperationType::Add, TEXT("/player/level"), TEXT("2")),
+				MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/player/hp"), TEXT("90")),
+				MakeOperation(EJsonCRDTOperationType::Remove, TEXT("/player/items/0")),
+				Copy
+			}, 2, Ticks)));
+
+			TestEqual(TEXT("Version"), Document->GetVersion(), VersionBefore + 1);
+			TestTrue(TEXT("Player"), JsonEquals(ValueAt(Document, TEXT("/player")), TEXT("{\"name\":\"a\",\"hp\":90,\"items\":[\"shield\"],\"level\":2,\"backup\":[\"shield\"]}")));
+		});
+
+		It("rolls back every operation of a failing patch", [this]()
+		{
+			const FString Before = Document->GetContentAsString();
+			const int64 VersionBefore = Document->GetVersion();
+
+			AddExpectedError(TEXT("Failed to apply operation"), EAutomationExpectedErrorFlags::Contains, 1);
+			TestFalse(TEXT("Applied"), Document->ApplyPatch(MakeRemotePatch(DocumentID,
+			{
+				MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/player/hp"), TEXT("1")),
+				MakeOperation(EJsonCRDTOperationType::Remove, TEXT("/player/items/0")),
+				MakeOperation(EJsonCRDTOperationType::Add, TEXT("/player/items/-"), TEXT("\"bow\"")),
+				MakeOperation(EJsonCRDTOperationType::Test, TEXT("/score"), TEXT("2"))
+			}, 1, FDateTime::UtcNow().GetTicks())));
+
+			TestTrue(TEXT("Content"), JsonEquals(Document->GetContentAsString(), Before));
+			TestEqual(TEXT("Version"), Document->GetVersion(), VersionBefore);
+			TestFalse(TEXT("Sequence not recorded"), Document->GetVersionVector().Contains(TEXT("remote")));
+		});
+
+		It("skips a resent patch", [this]()
+		{
+			const FJsonCRDTPatch Patch = MakeRemotePatch(DocumentID, { MakeOperation(EJsonCRDTOperationType::Add, TEXT("/player/items/-"), TEXT("\"bow\"")) }, 5, FDateTime::UtcNow().GetTicks());
+			TestTrue(TEXT("First"), Document->ApplyPatch(Patch));
+			const int64 Version = Document->GetVersion();
+			TestTrue(TEXT("Resend"), Document->ApplyPatch(Patch));
+			TestEqual(TEXT("Version"), Document->GetVersion(), Version);
+			TestTrue(TEXT("Items"), JsonEquals(ValueAt(Document, TEXT("/player/items")), TEXT("[\"sword\",\"shield\",\"bow\"]")));
+		});
+	});
+
+	Describe("Conflicts", [this]()
+	{
+		It("keeps the newer local value under last writer wins", [this]()
+		{
+			const int64 Ticks = FDateTime::UtcNow().GetTicks();
+			TestTrue(TEXT("Local"), Document->ApplyLocalOperation(MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/score"), TEXT("2"), Ticks + 1000)));
+			TestTrue(TEXT("Remote"), Document->ApplyPatch(MakeRemotePatch(DocumentID, { MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/score"), TEXT("3")) }, 1, Ticks)));
+
+			TestTrue(TEXT("Score"), JsonEquals(ValueAt(Document, TEXT("/score")), TEXT("2")));
+			TestEqual(TEXT("Resolved conflicts"), Document->GetNumResolvedConflicts(), 1);
+		});
+
+		It("takes the newer remote value under last writer wins", [this]()
+		{
+			const int64 Ticks = FDateTime::UtcNow().GetTicks();
+			TestTrue(TEXT("Local"), Document->ApplyLocalOperation(MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/score"), TEXT("2"), Ticks)));
+			TestTrue(TEXT("Remote"), Document->ApplyPatch(MakeRemotePatch(DocumentID, { MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/score"), TEXT("3")) }, 1, Ticks + 1000)));
+
+			TestTrue(TEXT("Score"), JsonEquals(ValueAt(Document, TEXT("/score")), TEXT("3")));
+			TestEqual(TEXT("Resolved conflicts"), Document->GetNumResolvedConflicts(), 1);
+		});
+
+		It("does not report a conflict for the same value", [this]()
+		{
+			const int64 Ticks = FDateTime::UtcNow().GetTicks();
+			TestTrue(TEXT("Local"), Document->ApplyLocalOperation(MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/score"), TEXT("2"), Ticks)));
+			TestTrue(TEXT("Remote"), Document->ApplyPatch(MakeRemotePatch(DocumentID, { MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/score"), TEXT("2")) }, 1, Ticks + 1000)));
+			TestEqual(TEXT("Resolved conflicts"), Document->GetNumResolvedConflicts(), 0);
+		});
+
+		It("finds the operations behind a conflict by sequence", [this]()
+		{
+			const int64 Ticks = FDateTime::UtcNow().GetTicks();
+			TestTrue(TEXT("Local"), Document->ApplyLocalOperation(MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/score"), TEXT("2"), Ticks)));
+			const uint64 LocalSequence = Document->GetOperationHistory().FindLatestReplaceSequence(TEXT("/score"));
+			TestTrue(TEXT("Remote"), Document->ApplyPatch(MakeRemotePatch(DocumentID, { MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/score"), TEXT("3")) }, 1, Ticks + 1000)));
+			const uint64 RemoteSequence = Document->GetOperationHistory().FindLatestReplaceSequence(TEXT("/score"));
+
+			FJsonCRDTConflict Conflict;
+			Conflict.LocalSequence = static_cast<int64>(LocalSequence);
+			Conflict.RemoteSequence = static_cast<int64>(RemoteSequence);
+
+			FJsonCRDTOperation LocalOperation;
+			FJsonCRDTOperation RemoteOperation;
+			TestTrue(TEXT("Found"), Document->GetConflictOperations(Conflict, LocalOperation, RemoteOperation));
+			TestEqual(TEXT("Local value"), LocalOperation.Value, FString(TEXT("2")));
+			TestEqual(TEXT("Remote value"), RemoteOperation.Value, FString(TEXT("3")));
+			TestEqual(TEXT("Remote ClientID"), RemoteOperation.ClientID, FString(TEXT("remote")));
+		});
+	});
+
+	Describe("Local storage", [this]()
+	{
+		It("round-trips through a JSON file", [this]()
+		{
+			TestRoundTrip(EJsonCRDTLocalStorageFormat::Json);
+		});
+
+		It("round-trips through a binary file", [this]()
+		{
+			TestRoundTrip(EJsonCRDTLocalStorageFormat::Binary);
+		});
+
+		It("replays changes journaled after the save", [this]()
+		{
+			Document->SetLocalStorageFormat(EJsonCRDTLocalStorageFormat::Binary);
+			TestTrue(TEXT("Saved"), Document->SaveLocally());
+
+			TestTrue(TEXT("Local operation"), Document->ApplyLocalOperation(MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/player/hp"), TEXT("50"))));
+			TestTrue(TEXT("Remote patch"), Document->ApplyPatch(MakeRemotePatch(DocumentID, { MakeOperation(EJsonCRDTOperationType::Remove, TEXT("/score")) }, 1, FDateTime::UtcNow().GetTicks())));
+			Document->RequestLocalSave();
+			Document->TickLocalSave(FPlatformTime::Seconds() + 60.0, 0.0, 0.0);
+			FJsonCRDTLocalStorageWriter::Get().Flush();
+
+			UJsonCRDTDocument* Loaded = CreateDocument(DocumentID);
+			Loaded->SetLocalStorageFormat(EJsonCRDTLocalStorageFormat::Binary);
+			TestTrue(TEXT("Loaded"), Loaded->LoadFromLocal());
+			TestEqual(TEXT("Version"), Loaded->GetVersion(), Document->GetVersion());
+			TestTrue(TEXT("Content"), JsonEquals(Loaded->GetContentAsString(), Document->GetContentAsString()));
+		});
+
+		It("fails when nothing was saved", [this]()
+		{
+			AddExpectedError(TEXT("Local file does not exist"), EAutomationExpectedErrorFlags::Contains, 1);
+			TestFalse(TEXT("Loaded"), Document->LoadFromLocal());
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,252 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "JsonCRDTDocument.h"
+#include "JsonCRDTTransport.h"
+#include "JsonCRDTLocalStorageWriter.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace JsonCRDTPerformanceSpec
+{
+	/** 테스트 문서 ID 접두사 (로컬 저장 파일이 이 폴더 아래에 생기고 테스트마다 지워짐) */
+	static const TCHAR* DocumentPrefix = TEXT("JsonCRDTPerformanceSpec/");
+
+	/** 원격 패치의 클라이언트 ID */
+	static const TCHAR* RemoteClientID = TEXT("spec-remote");
+
+	/** 난수 시드 (실행마다 같은 패치) */
+	static constexpr int32 RandomSeed = 0x4A435244;
+
+	/** 측정할 문서 크기 (키 수) */
+	static const int32 DocumentSizes[] = { 100, 10000 };
+
+	/** 측정에 쓰는 패치 수와 패치당 작업 수 */
+	static constexpr int32 NumPatches = 2000;
+	static constexpr int32 OpsPerPatch = 4;
+
+	/** 키 NumKeys개짜리 평평한 객체 ({"k0":0,"k1":1,...}) */
+	static FString MakeContent(int32 NumKeys)
+	{
+		FString Content;
+		Content.Reserve(NumKeys * 14 + 2);
+		Content += TEXT("{");
+		for (int32 i = 0; i < NumKeys; ++i)
+		{
+			Content += FString::Printf(i > 0 ? TEXT(",\"k%d\":%d") : TEXT("\"k%d\":%d"), i, i);
+		}
+		Content += TEXT("}");
+		return Content;
+	}
+
+	/** 임의의 키에 대한 스칼라 Replace 패치와 가끔 끼는 Add/Remove (한 패치 안에서는 키가 겹치지 않음) */
+	static void MakePatches(const FString& DocumentID, int32 NumKeys, FRandomStream& Random, TArray<FJsonCRDTPatch>& OutPatches)
+	{
+		const int64 StartTicks = FDateTime::UtcNow().GetTicks();
+		OutPatches.Reset(NumPatches);
+		for (int32 PatchIndex = 0; PatchIndex < NumPatches; ++PatchIndex)
+		{
+			FJsonCRDTPatch& Patch = OutPatches.AddDefaulted_GetRef();
+			Patch.DocumentID = DocumentID;
+			Patch.ClientID = RemoteClientID;
+			Patch.Sequence = PatchIndex + 1;
+			Patch.Timestamp = FDateTime(StartTicks + PatchIndex);
+
+			// 같은 패치에서 같은 경로를 다시 바꾸면 타임스탬프가 같아 충돌 해결 결과가 코어 문서와 달라질 수 있음
+			const int32 FirstKey = Random.RandHelper(NumKeys);
+			for (int32 OperationIndex = 0; OperationIndex < OpsPerPatch; ++OperationIndex)
+			{
+				FJsonCRDTOperation& Operation = Patch.Operations.AddDefaulted_GetRef();
+				Operation.Type = EJsonCRDTOperationType::Replace;
+				Operation.Path = FString::Printf(TEXT("/k%d"), (FirstKey + OperationIndex * (NumKeys / OpsPerPatch)) % NumKeys);
+				Operation.Value = FString::FromInt(Random.RandHelper(1000000));
+				Operation.ClientID = Patch.ClientID;
+				Operation.Timestamp = Patch.Timestamp;
+			}
+
+			// 구조를 바꾸는 작업도 섞어 스칼라 일괄 적용 밖의 경로도 측정
+			if (PatchIndex % 16 == 0)
+			{
+				FJsonCRDTOperation& Operation = Patch.Operations.AddDefaulted_GetRef();
+				Operation.Type = (PatchIndex / 16) % 2 == 0 ? EJsonCRDTOperationType::Add : EJsonCRDTOperationType::Remove;
+				Operation.Path = FString::Printf(TEXT("/extra%d"), PatchIndex / 32);
+				Operation.Value = Operation.Type == EJsonCRDTOperationType::Add ? TEXT("{\"a\":[1,2,3]}") : TEXT("");
+				Operation.ClientID = Patch.ClientID;
+				Operation.Timestamp = Patch.Timestamp;
+			}
+		}
+	}
+
+	/** 로거 없이 문서 생성 */
+	static UJsonCRDTDocument* CreateDocument(const FString& DocumentID, const FString& Content)
+	{
+		UJsonCRDTDocument* Document = NewObject<UJsonCRDTDocument>(GetTransientPackage());
+		Document->Initialize(DocumentID, nullptr);
+		Document->SetLoggingEnabled(false);
+		Document->SetContentFromString(Content);
+		return Document;
+	}
+}
+
+BEGIN_DEFINE_SPEC(FJsonCRDTPerformanceSpec, "JsonCRDT.Performance", EAutomationTestFlags::PerfFilter | EAutomationTestFlags::ApplicationContextMask)
+	/** 걸린 시간을 작업당 마이크로초로 보고 */
+	void ReportTime(const FString& What, double Seconds, int32 NumOperations)
+	{
+		AddInfo(FString::Printf(TEXT("%s: %.3f ms total, %.3f us/op"), *What, Seconds * 1000.0, NumOperations > 0 ? Seconds * 1000000.0 / NumOperations : 0.0));
+	}
+END_DEFINE_SPEC(FJsonCRDTPerformanceSpec)
+
+void FJsonCRDTPerformanceSpec::Define()
+{
+	using namespace JsonCRDTPerformanceSpec;
+
+	AfterEach([this]()
+	{
+		FJsonCRDTLocalStorageWriter::Get().Flush();
+		IFileManager::Get().DeleteDirectory(*(FPaths::ProjectSavedDir() / TEXT("JsonCRDT") / DocumentPrefix), false, true);
+	});
+
+	for (const int32 NumKeys : DocumentSizes)
+	{
+		Describe(FString::Printf(TEXT("Document with %d keys"), NumKeys), [this, NumKeys]()
+		{
+			It("applies remote patches to the same result as the core document", [this, NumKeys]()
+			{
+				const FString DocumentID = FString(DocumentPrefix) + TEXT("apply");
+				const FString Content = MakeContent(NumKeys);
+				FRandomStream Random(RandomSeed);
+				TArray<FJsonCRDTPatch> Patches;
+				MakePatches(DocumentID, NumKeys, Random, Patches);
+
+				// 충돌 해결과 구독 알림이 없는 코어 문서를 기준 결과로 사용
+				FJsonCRDTDocumentCore Expected(DocumentID);
+				Expected.SetContentFromString(Content);
+				for (const FJsonCRDTPatch& Patch : Patches)
+				{
+					Expected.ApplyPatch(Patch);
+				}
+
+				UJsonCRDTDocument* Document = CreateDocument(DocumentID, Content);
+				int32 NumFailed = 0;
+				const double StartTime = FPlatformTime::Seconds();
+				for (const FJsonCRDTPatch& Patch : Patches)
+				{
+					NumFailed += Document->ApplyPatch(Patch) ? 0 : 1;
+				}
+				const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+				int32 NumOperations = 0;
+				for (const FJsonCRDTPatch& Patch : Patches)
+				{
+					NumOperations += Patch.Operations.Num();
+				}
+				ReportTime(TEXT("ApplyPatch"), Elapsed, NumOperations);
+
+				TestEqual(TEXT("Failed patches"), NumFailed, 0);
+				TestEqual(TEXT("Version"), Document->GetVersion(), Expected.GetVersion());
+				TestTrue(TEXT("Sequence recorded"), Document->GetVersionVector().FindRef(RemoteClientID) == NumPatches);
+				TestEqual(TEXT("Content"), Document->GetContentAsString(), Expected.GetContent().ToString());
+			});
+
+			It("reads values by path", [this, NumKeys]()
+			{
+				UJsonCRDTDocument* Document = CreateDocument(FString(DocumentPrefix) + TEXT("read"), MakeContent(NumKeys));
+				constexpr int32 NumReads = 20000;
+
+				FRandomStream Random(RandomSeed);
+				int32 NumMismatched = 0;
+				FString Value;
+				const double StartTime = FPlatformTime::Seconds();
+				for (int32 i = 0; i < NumReads; ++i)
+				{
+					const int32 Key = Random.RandHelper(NumKeys);
+					if (!Document->GetValueAtPath(FString::Printf(TEXT("/k%d"), Key), Value) || FCString::Atoi(*Value) != Key)
+					{
+						++NumMismatched;
+					}
+				}
+				ReportTime(TEXT("GetValueAtPath"), FPlatformTime::Seconds() - StartTime, NumReads);
+
+				TestEqual(TEXT("Mismatched values"), NumMismatched, 0);
+			});
+
+			It("saves and loads locally in both formats", [this, NumKeys]()
+			{
+				for (const EJsonCRDTLocalStorageFormat Format : { EJsonCRDTLocalStorageFormat::Json, EJsonCRDTLocalStorageFormat::Binary })
+				{
+					const FString FormatName = Format == EJsonCRDTLocalStorageFormat::Json ? TEXT("Json") : TEXT("Binary");
+					const FString DocumentID = FString(DocumentPrefix) + TEXT("storage-") + FormatName;
+					UJsonCRDTDocument* Document = CreateDocument(DocumentID, MakeContent(NumKeys));
+					Document->SetLocalStorageFormat(Format);
+
+					double StartTime = FPlatformTime::Seconds();
+					TestTrue(FormatName + TEXT(" saved"), Document->SaveLocally());
+					FJsonCRDTLocalStorageWriter::Get().Flush();
+					ReportTime(FormatName + TEXT(" SaveLocally"), FPlatformTime::Seconds() - StartTime, NumKeys);
+
+					UJsonCRDTDocument* Loaded = NewObject<UJsonCRDTDocument>(GetTransientPackage());
+					Loaded->Initialize(DocumentID, nullptr);
+					Loaded->SetLoggingEnabled(false);
+					Loaded->SetLocalStorageFormat(Format);
+
+					StartTime = FPlatformTime::Seconds();
+					TestTrue(FormatName + TEXT(" loaded"), Loaded->LoadFromLocal());
+					ReportTime(FormatName + TEXT(" LoadFromLocal"), FPlatformTime::Seconds() - StartTime, NumKeys);
+
+					TestEqual(FormatName + TEXT(" version"), Loaded->GetVersion(), Document->GetVersion());
+					TestEqual(FormatName + TEXT(" content"), Loaded->GetContentAsString(), Document->GetContentAsString());
+				}
+			});
+		});
+	}
+
+	Describe("Patch encoding", [this]()
+	{
+		It("encodes patches as JSON messages and binary frames", [this]()
+		{
+			FRandomStream Random(RandomSeed);
+			TArray<FJsonCRDTPatch> Patches;
+			MakePatches(FString(DocumentPrefix) + TEXT("encode"), 10000, Random, Patches);
+
+			FDefaultJsonCRDTTransport Transport(TEXT("http://jsoncrdt-spec.invalid"), TEXT("ws://jsoncrdt-spec.invalid"));
+			Transport.SetOfflineQueueFile(TEXT(""));
+
+			int64 JsonBytes = 0;
+			double StartTime = FPlatformTime::Seconds();
+			for (const FJsonCRDTPatch& Patch : Patches)
+			{
+				JsonBytes += FTCHARToUTF8(*Transport.BuildPatchMessage(Patch)).Length();
+			}
+			ReportTime(TEXT("JSON patch message"), FPlatformTime::Seconds() - StartTime, Patches.Num());
+
+			FJsonCRDTBinaryCodec Encoder;
+			FJsonCRDTBinaryCodec Decoder;
+			TArray<uint8> Frame;
+			TArray<FJsonCRDTPatch> Decoded;
+			int64 BinaryBytes = 0;
+			StartTime = FPlatformTime::Seconds();
+			for (const FJsonCRDTPatch& Patch : Patches)
+			{
+				Encoder.EncodePatch(Patch, Frame);
+				BinaryBytes += Frame.Num();
+				Decoder.DecodeFrame(Frame.GetData(), Frame.Num(), Decoded);
+			}
+			ReportTime(TEXT("Binary patch frame encode and decode"), FPlatformTime::Seconds() - StartTime, Patches.Num());
+			AddInfo(FString::Printf(TEXT("JSON %lld bytes, binary %lld bytes"), JsonBytes, BinaryBytes));
+
+			TestEqual(TEXT("Decoded patches"), Decoded.Num(), Patches.Num());
+			TestTrue(TEXT("Binary is smaller"), BinaryBytes < JsonBytes);
+			if (Decoded.Num() == Patches.Num())
+			{
+				TestEqual(TEXT("Last patch value"), Decoded.Last().Operations[0].Value, Patches.Last().Operations[0].Value);
+			}
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,178 @@
+// Copyright Your Company. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "JsonCRDTTransport.h"
+#include "JsonCRDTPatchParser.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace JsonCRDTTransportSpec
+{
+	/** 작업 하나 */
+	static FJsonCRDTOperation MakeOperation(EJsonCRDTOperationType Type, const TCHAR* Path, const TCHAR* Value = TEXT(""), const TCHAR* FromPath = TEXT(""))
+	{
+		FJsonCRDTOperation Operation;
+		Operation.Type = Type;
+		Operation.Path = Path;
+		Operation.Value = Value;
+		Operation.FromPath = FromPath;
+		return Operation;
+	}
+
+	/** 보낼 패치 (작업 종류마다 하나씩) */
+	static FJsonCRDTPatch MakePatch()
+	{
+		FJsonCRDTPatch Patch;
+		Patch.DocumentID = TEXT("transport-doc");
+		Patch.BaseVersion = 12;
+		Patch.Sequence = 3;
+		Patch.Timestamp = FDateTime(2024, 1, 2);
+		Patch.Operations =
+		{
+			MakeOperation(EJsonCRDTOperationType::Add, TEXT("/items/-"), TEXT("{\"name\":\"potion\\n\",\"count\":3}")),
+			MakeOperation(EJsonCRDTOperationType::Remove, TEXT("/items/0")),
+			MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/a~1b"), TEXT("[1,2.5,true,null]")),
+			MakeOperation(EJsonCRDTOperationType::Move, TEXT("/c"), TEXT(""), TEXT("/a~1b")),
+			MakeOperation(EJsonCRDTOperationType::Copy, TEXT("/d"), TEXT(""), TEXT("/c")),
+			MakeOperation(EJsonCRDTOperationType::Test, TEXT("/e"), TEXT("\"x\""))
+		};
+		return Patch;
+	}
+}
+
+BEGIN_DEFINE_SPEC(FJsonCRDTTransportSpec, "JsonCRDT.Transport", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+	TUniquePtr<FDefaultJsonCRDTTransport> Transport;
+
+	/** 작업 종류, 경로, from, 값 비교 */
+	void TestOperationsEqual(const TArray<FJsonCRDTOperation>& Actual, const TArray<FJsonCRDTOperation>& Expected)
+	{
+		if (!TestEqual(TEXT("Operations"), Actual.Num(), Expected.Num()))
+		{
+			return;
+		}
+		for (int32 i = 0; i < Expected.Num(); ++i)
+		{
+			TestEqual(FString::Printf(TEXT("Type %d"), i), (int32)Actual[i].Type, (int32)Expected[i].Type);
+			TestEqual(FString::Printf(TEXT("Path %d"), i), Actual[i].Path, Expected[i].Path);
+			TestEqual(FString::Printf(TEXT("From %d"), i), Actual[i].FromPath, Expected[i].FromPath);
+			TestEqual(FString::Printf(TEXT("Value %d"), i), Actual[i].Value, Expected[i].Value);
+		}
+	}
+END_DEFINE_SPEC(FJsonCRDTTransportSpec)
+
+void FJsonCRDTTransportSpec::Define()
+{
+	using namespace JsonCRDTTransportSpec;
+
+	BeforeEach([this]()
+	{
+		// 연결하지 않는 주소로 만들고, 보관한 패치는 파일에 쓰지 않음
+		Transport = MakeUnique<FDefaultJsonCRDTTransport>(TEXT("http://jsoncrdt-spec.invalid"), TEXT("ws://jsoncrdt-spec.invalid"));
+		Transport->SetOfflineQueueFile(TEXT(""));
+	});
+
+	AfterEach([this]()
+	{
+		Transport.Reset();
+	});
+
+	Describe("JSON patch message", [this]()
+	{
+		It("is read back by the patch parser", [this]()
+		{
+			FJsonCRDTPatch Patch = MakePatch();
+			Patch.VersionVector.Add(TEXT("client-b"), 7);
+			const FString Message = Transport->BuildPatchMessage(Patch);
+
+			FJsonCRDTPatch Parsed;
+			FString MessageType;
+			FString Error;
+			TestTrue(TEXT("Parsed"), FJsonCRDTPatchParser::Parse(Message, FJsonCRDTPatchParser::EFormat::Message, Parsed, &MessageType, &Error));
+			TestEqual(TEXT("Error"), Error, FString());
+			TestEqual(TEXT("Message type"), MessageType, FString(TEXT("patch")));
+			TestEqual(TEXT("DocumentID"), Parsed.DocumentID, Patch.DocumentID);
+			TestFalse(TEXT("Transport ClientID"), Parsed.ClientID.IsEmpty());
+			TestEqual(TEXT("BaseVersion"), Parsed.BaseVersion, Patch.BaseVersion);
+			TestEqual(TEXT("Sequence"), Parsed.Sequence, Patch.Sequence);
+			TestTrue(TEXT("VersionVector"), Parsed.VersionVector.Num() == 1 && Parsed.VersionVector.FindRef(TEXT("client-b")) == 7);
+			TestOperationsEqual(Parsed.Operations, Patch.Operations);
+		});
+
+		It("writes an empty value as null and leaves out unnumbered fields", [this]()
+		{
+			FJsonCRDTPatch Patch;
+			Patch.DocumentID = TEXT("transport-doc");
+			Patch.Operations.Add(MakeOperation(EJsonCRDTOperationType::Replace, TEXT("/a")));
+			const FString Message = Transport->BuildPatchMessage(Patch);
+
+			TestFalse(TEXT("No sequence"), Message.Contains(TEXT("\"sequence\"")));
+			TestFalse(TEXT("No version vector"), Message.Contains(TEXT("\"versionVector\"")));
+
+			FJsonCRDTPatch Parsed;
+			TestTrue(TEXT("Parsed"), FJsonCRDTPatchParser::Parse(Message, FJsonCRDTPatchParser::EFormat::Message, Parsed));
+			TestTrue(TEXT("Null value"), Parsed.Operations.Num() == 1 && Parsed.Operations[0].Value == TEXT("null"));
+		});
+	});
+
+	Describe("Binary patch frame", [this]()
+	{
+		It("round-trips without the client ID and is smaller than the JSON message", [this]()
+		{
+			const FJsonCRDTPatch Patch = MakePatch();
+
+			// SendPatch와 같은 방식으로 인코딩 (클라이언트 ID는 인증 때 전달되므로 프레임에 넣지 않음)
+			FJsonCRDTBinaryCodec Encoder;
+			TArray<uint8> Frame;
+			Encoder.EncodePatch(Patch, Frame);
+			TestTrue(TEXT("IsBinaryFrame"), FJsonCRDTBinaryCodec::IsBinaryFrame(Frame.GetData(), Frame.Num()));
+
+			FJsonCRDTBinaryCodec Decoder;
+			TArray<FJsonCRDTPatch> Decoded;
+			TestTrue(TEXT("Decoded"), Decoder.DecodeFrame(Frame.GetData(), Frame.Num(), Decoded));
+			if (TestEqual(TEXT("Patches"), Decoded.Num(), 1))
+			{
+				TestEqual(TEXT("DocumentID"), Decoded[0].DocumentID, Patch.DocumentID);
+				TestEqual(TEXT("ClientID"), Decoded[0].ClientID, FString());
+				TestEqual(TEXT("BaseVersion"), Decoded[0].BaseVersion, Patch.BaseVersion);
+				TestEqual(TEXT("Sequence"), Decoded[0].Sequence, Patch.Sequence);
+				TestOperationsEqual(Decoded[0].Operations, Patch.Operations);
+			}
+
+			const int32 JsonBytes = FTCHARToUTF8(*Transport->BuildPatchMessage(Patch)).Length();
+			TestTrue(TEXT("Smaller than JSON"), Frame.Num() < JsonBytes);
+		});
+	});
+
+	Describe("SendPatch while disconnected", [this]()
+	{
+		It("queues the patch and reports it as sent", [this]()
+		{
+			TestFalse(TEXT("Not connected"), Transport->IsConnected());
+
+			const FJsonCRDTPatch Patch = MakePatch();
+			FString SentDocumentID;
+			bool bError = false;
+			Transport->SendPatch(Patch,
+				FOnPatchSent::CreateLambda([&SentDocumentID](const FString& DocumentID) { SentDocumentID = DocumentID; }),
+				FOnTransportError::CreateLambda([&bError](const FString&, const FString&) { bError = true; }));
+
+			TestFalse(TEXT("No error"), bError);
+			TestEqual(TEXT("Sent"), SentDocumentID, Patch.DocumentID);
+			TestEqual(TEXT("Queued operations"), Transport->GetNumQueuedOperations(), Patch.Operations.Num());
+		});
+
+		It("reports an error once the offline queue is full", [this]()
+		{
+			Transport->SetOfflineQueueLimit(1);
+
+			bool bError = false;
+			Transport->SendPatch(MakePatch(), FOnPatchSent(),
+				FOnTransportError::CreateLambda([&bError](const FString&, const FString&) { bError = true; }));
+
+			TestTrue(TEXT("Error"), bError);
+			TestEqual(TEXT("Queued operations"), Transport->GetNumQueuedOperations(), 0);
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -3,6 +3,7 @@
 #include "UEJsonCRDTModule.h"
 #include "Modules/ModuleManager.h"
 #include "Interfaces/IPluginManager.h"
+#include "JsonCRDTLocalStorageWriter.h"
 
 #define LOCTEXT_NAMESPACE "FUEJsonCRDTModule"
 
@@ -16,6 +17,7 @@ void FUEJsonCRDTModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FJsonCRDTLocalStorageWriter::Get().Flush();
 	UE_LOG(LogTemp, Log, TEXT("UEJsonCRDT module has shut down"));
 }
 
@@ -0,0 +1,71 @@
+// Copyright Your Company. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "JsonCRDTBenchmarkCommandlet.generated.h"
+
+/**
+ * 문서 핫 패스 벤치마크와 로그 세션 리플레이
+ *
+ * 문서 크기와 히스토리 길이별 ApplyPatch 처리량, GetValueAtPath 지연, SaveLocally/LoadFromLocal 시간,
+ * SendPatch 인코딩 비용(바이너리 프레임과 JSON 메시지)을 측정해 로그로 출력합니다.
+ * -Replay를 주면 ExportLogs로 내보낸 세션을 문서에 다시 적용하고 걸린 시간을 출력합니다.
+ *
+ * 사용법: UnrealEditor-Cmd <Project> -run=JsonCRDTBenchmark [옵션]
+ *   -Sizes=100,1000,10000        문서 키 수
+ *   -Histories=0,4096,65536      작업 히스토리 길이 (측정 전에 채워 둠)
+ *   -Patches=2000                크기마다 적용할 패치 수
+ *   -Lookups=10000               크기마다 조회할 경로 수
+ *   -OpsPerPatch=1,16,256        인코딩을 측정할 패치당 작업 수
+ *   -Csv=<파일>                  결과를 CSV로도 기록
+ *   -Replay=<파일>               ExportLogs JSON 세션 (주면 리플레이만 수행)
+ *   -ReplayDocument=<ID>         리플레이할 문서 (기본값: 세션의 첫 문서)
+ *   -ReplayContent=<파일>        리플레이 시작 내용 (기본값: 빈 객체)
+ */
+UCLASS()
+class UEJSONCRDT_API UJsonCRDTBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UJsonCRDTBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	/** 측정 결과 한 줄 */
+	struct FResult
+	{
+		FString Name;
+		int32 DocumentSize = 0;
+		int32 HistoryLength = 0;
+		int32 Count = 0;
+		double Seconds = 0.0;
+	};
+
+	/** 측정 결과 */
+	TArray<FResult> Results;
+
+	/** 결과 기록 및 출력 */
+	void AddResult(const FString& Name, int32 DocumentSize, int32 HistoryLength, int32 Count, double Seconds);
+
+	/** 크기와 히스토리 길이별 ApplyPatch 처리량 */
+	void RunApplyPatch(int32 DocumentSize, int32 HistoryLength, int32 NumPatches);
+
+	/** 크기별 GetValueAtPath 지연 */
+	void RunGetValueAtPath(int32 DocumentSize, int32 NumLookups);
+
+	/** 크기와 형식별 SaveLocally/LoadFromLocal 시간 */
+	void RunLocalStorage(int32 DocumentSize);
+
+	/** 패치당 작업 수별 SendPatch 인코딩 비용 */
+	void RunEncode(int32 OpsPerPatch, int32 NumPatches);
+
+	/** ExportLogs 세션 리플레이 */
+	int32 RunReplay(const FString& FilePath, const FString& ReplayDocumentID, const FString& ContentFile);
+
+	/** 결과를 CSV 파일로 기록 */
+	bool WriteCsv(const FString& FilePath) const;
+};
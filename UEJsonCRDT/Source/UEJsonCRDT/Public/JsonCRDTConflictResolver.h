@@ -26,13 +26,21 @@ struct UEJSONCRDT_API FJsonCRDTConflict
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
     FString RemoteValue;
     
-    // 로컬 작업
+    // 로컬 작업의 타임스탬프
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
-    FJsonCRDTOperation LocalOperation;
+    FDateTime LocalTimestamp;
     
-    // 원격 작업
+    // 원격 작업의 타임스탬프
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
-    FJsonCRDTOperation RemoteOperation;
+    FDateTime RemoteTimestamp;
+    
+    // 로컬 작업의 작업 히스토리 시퀀스 번호 (작업 자체는 UJsonCRDTDocument::GetConflictOperations로 조회, 없으면 -1)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+    int64 LocalSequence = -1;
+    
+    // 원격 작업의 작업 히스토리 시퀀스 번호 (패치가 끝까지 적용된 뒤 채워짐, 그 전에는 -1)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+    int64 RemoteSequence = -1;
     
     // 충돌 해결 결과 (기본값은 원격 값 우선)
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
@@ -77,6 +85,23 @@ public:
      */
     virtual bool ResolveConflict(FJsonCRDTConflict& Conflict) = 0;
     
+    /**
+     * 여러 충돌을 한 번에 해결 (문서는 패치 하나의 충돌을 모아 한 번 호출, 기본 구현은 충돌마다 ResolveConflict 호출)
+     * 각 충돌의 bResolved가 해결 여부이며, 해결되지 않은 충돌의 원격 작업은 적용하지 않습니다.
+     * @param Conflicts 충돌 정보들 (패치 안의 작업 순서)
+     * @return 해결한 충돌 수
+     */
+    virtual int32 ResolveConflicts(TArrayView<FJsonCRDTConflict> Conflicts)
+    {
+        int32 NumResolved = 0;
+        for (FJsonCRDTConflict& Conflict : Conflicts)
+        {
+            Conflict.bResolved = ResolveConflict(Conflict);
+            NumResolved += Conflict.bResolved ? 1 : 0;
+        }
+        return NumResolved;
+    }
+    
     /**
      * 충돌 해결 전략 가져오기
      * @return 충돌 해결 전략
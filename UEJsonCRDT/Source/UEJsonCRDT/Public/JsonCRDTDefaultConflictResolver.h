@@ -24,6 +24,13 @@ public:
      */
     virtual bool ResolveConflict(FJsonCRDTConflict& Conflict) override;
     
+    /**
+     * 여러 충돌 해결 (전략은 한 번만 확인하고 충돌마다 가상 호출 없이 해결)
+     * @param Conflicts 충돌 정보들
+     * @return 해결한 충돌 수
+     */
+    virtual int32 ResolveConflicts(TArrayView<FJsonCRDTConflict> Conflicts) override;
+    
     /**
      * 충돌 해결 전략 가져오기
      * @return 충돌 해결 전략
@@ -4,9 +4,27 @@
 
 #include "CoreMinimal.h"
 #include "JsonCRDTLogger.h"
+#include "JsonCRDTPath.h"
+#include "Misc/ScopeRWLock.h"
+#include <atomic>
 
 /**
  * 기본 CRDT 로거 구현체
+ *
+ * 고정 크기 링 버퍼에 최근 로그를 보관하고, 가득 차면 가장 오래된 슬롯을 덮어씁니다.
+ *
+ * 잠금 없는 구조가 아니라 대부분 경합이 없는 잠금 구조입니다. 슬롯의 문자열은 힙 버퍼를 가지므로
+ * 순번만 확인하고 복사하는 방식(쓰는 중인 버퍼를 읽을 수 있음)은 쓰지 않습니다.
+ * - 기록과 조회는 SlotsLock을 공유로 잡고, 버퍼 교체와 삭제만 단독으로 잡습니다.
+ * - 인터닝은 InternLock을 공유로 잡고 조회하며, 처음 보는 문자열일 때만 단독으로 잡습니다.
+ * - 슬롯 내용은 슬롯 단위 플래그를 잡고 쓰거나 복사합니다. 기록할 순번은 원자적 커서로 나눠 가지므로
+ *   기록하는 스레드끼리는 버퍼가 한 바퀴 돌아 같은 슬롯에 닿거나 조회가 그 슬롯을 복사하는 중일 때만 기다립니다.
+ * 문서 ID, 작업 유형, 클라이언트 ID, 소스 문자열은 인터닝해 번호로 보관합니다.
+ * 버퍼는 처음 기록할 때 할당하므로 로깅을 컴파일하지 않은 빌드에서는 메모리를 쓰지 않습니다.
+ *
+ * 조회는 전체 항목을 훑지 않도록 색인을 사용합니다. 문서 ID와 클라이언트 ID별로 이전 항목의
+ * 순번을 잇는 체인, 충돌 항목 비트맵을 유지하며, 시간 범위는 기록 순서대로 정렬된 버퍼에서
+ * 이진 탐색합니다 (항목 시각이 기록 순서대로 증가한다고 가정).
  */
 class UEJSONCRDT_API FJsonCRDTDefaultLogger : public IJsonCRDTLogger
 {
@@ -31,6 +49,14 @@ public:
      */
     virtual bool ExportLogs(const FString& FilePath, const FJsonCRDTLogFilter& Filter = FJsonCRDTLogFilter()) override;
     
+    /**
+     * ExportLogs로 내보낸 파일 읽기 (세션 리플레이용, 보관 중인 로그는 바뀌지 않음)
+     * @param FilePath 파일 경로
+     * @param OutLogEntries 읽은 로그 항목 (파일 순서대로 뒤에 추가됨)
+     * @return 읽기 성공 여부
+     */
+    bool LoadExportedLogs(const FString& FilePath, TArray<FJsonCRDTLogEntry>& OutLogEntries) const;
+    
     /**
      * 로그 가져오기
      * @param Filter 로그 필터
@@ -69,17 +95,144 @@ public:
     int32 GetMaxLogEntries() const;
     
 private:
-    /** 로그 항목 배열 */
-    TArray<FJsonCRDTLogEntry> LogEntries;
+    /** 슬롯에 보관하는 로그 내용 (문자열 일부는 인터닝 번호) */
+    struct FLogRecord
+    {
+        FString LogID;
+        int32 DocumentID = INDEX_NONE;
+        int32 OperationType = INDEX_NONE;
+        FString Path;
+        FString OldValue;
+        FString NewValue;
+        FDateTime Timestamp;
+        bool bHadConflict = false;
+        FJsonCRDTConflict Conflict;
+        int32 ClientID = INDEX_NONE;
+        int32 Source = INDEX_NONE;
+        
+        /** 같은 문서의 이전 항목 순번 + 1 (없으면 0) */
+        uint64 PrevDocumentEntry = 0;
+        
+        /** 같은 클라이언트의 이전 항목 순번 + 1 (없으면 0) */
+        uint64 PrevClientEntry = 0;
+    };
+    
+    /** 링 버퍼 슬롯 */
+    struct FLogSlot
+    {
+        /** 보관 중인 항목의 순번 + 1 (0이면 비어 있음) */
+        std::atomic<uint64> Sequence{ 0 };
+        
+        /** 슬롯을 쓰거나 읽는 중인지 여부 */
+        std::atomic<bool> bBusy{ false };
+        
+        /** 로그 내용 */
+        FLogRecord Record;
+    };
+    
+    /** 인터닝된 문자열과 그 문자열을 가진 최근 항목 */
+    struct FInternedString
+    {
+        /** 문자열 */
+        FString Value;
+        
+        /** 이 문자열이 문서 ID인 최근 항목의 순번 + 1 */
+        std::atomic<uint64> LastDocumentEntry{ 0 };
+        
+        /** 이 문자열이 클라이언트 ID인 최근 항목의 순번 + 1 */
+        std::atomic<uint64> LastClientEntry{ 0 };
+    };
+    
+    /** 필터 문자열을 인터닝 번호로 바꾼 값 */
+    struct FResolvedFilter
+    {
+        int32 DocumentID = INDEX_NONE;
+        int32 OperationType = INDEX_NONE;
+        int32 ClientID = INDEX_NONE;
+        int32 Source = INDEX_NONE;
+        
+        /** 인터닝되지 않은 문자열이 있어 어떤 항목도 맞지 않는지 여부 */
+        bool bMatchesNothing = false;
+    };
+    
+    /** 링 버퍼 (처음 기록할 때 할당) */
+    TUniquePtr<FLogSlot[]> Slots;
+    
+    /** 슬롯별 충돌 항목 여부 비트맵 */
+    TUniquePtr<std::atomic<uint64>[]> ConflictBits;
     
-    /** 로그 항목 최대 개수 */
+    /** 다음에 기록할 항목의 순번 */
+    std::atomic<uint64> WriteCursor;
+    
+    /** 버퍼 교체, 삭제를 기록/조회와 구분하는 잠금 (기록과 조회는 공유 잠금) */
+    mutable FRWLock SlotsLock;
+    
+    /** 인터닝된 문자열 (주소가 바뀌지 않도록 개별 할당) */
+    TArray<TUniquePtr<FInternedString>> InternedStrings;
+    
+    /** 문자열에서 인터닝 번호로의 맵 */
+    TMap<FString, int32, FDefaultSetAllocator, TJsonCRDTCaseSensitiveMapKeyFuncs<int32>> InternIndices;
+    
+    /** 인터닝 테이블 잠금 */
+    mutable FRWLock InternLock;
+    
+    /** 로그 항목 최대 개수 (버퍼 크기) */
     int32 MaxLogEntries;
     
     /** 로깅 활성화 여부 */
-    bool bLoggingEnabled;
+    std::atomic<bool> bLoggingEnabled;
+    
+    /** 버퍼와 비트맵 할당 (SlotsLock을 단독으로 잡은 상태에서 호출) */
+    void AllocateSlots(int32 Capacity);
+    
+    /**
+     * 문자열 인터닝 (SlotsLock을 잡은 상태에서 호출)
+     * @param OutEntry 인터닝 항목 (빈 문자열이면 nullptr)
+     * @return 인터닝 번호 (빈 문자열이면 INDEX_NONE)
+     */
+    int32 Intern(const FString& Value, FInternedString*& OutEntry);
+    
+    /** 슬롯 점유 (짧게 대기) */
+    static void LockSlot(FLogSlot& Slot);
+    
+    /** 슬롯 점유 해제 */
+    static void UnlockSlot(FLogSlot& Slot);
+    
+    /** 슬롯의 충돌 비트 설정 */
+    void SetConflictBit(int32 SlotIndex, bool bConflict);
+    
+    /** 현재 버퍼에 남아 있을 수 있는 가장 오래된 순번 */
+    uint64 GetOldestSequence(uint64 End) const;
+    
+    /**
+     * 필터에 맞을 수 있는 항목 순번 모으기 (SlotsLock을 잡은 상태에서 호출)
+     * 색인을 쓸 수 있으면 OutSequences에 오름차순으로 채우고 true, 아니면 OutBegin/OutEnd 범위를 채우고 false를 반환합니다.
+     */
+    bool CollectCandidates(const FJsonCRDTLogFilter& Filter, const FResolvedFilter& Resolved, TArray<uint64>& OutSequences, uint64& OutBegin, uint64& OutEnd) const;
+    
+    /** 이전 항목 체인을 따라가며 순번 모으기 */
+    void CollectChain(uint64 Head, bool bClientChain, uint64 Oldest, TArray<uint64>& OutSequences) const;
+    
+    /** 시간 범위에 해당하는 순번 범위 이진 탐색 */
+    void FindTimeRange(const FJsonCRDTLogFilter& Filter, uint64& InOutBegin, uint64& InOutEnd) const;
+    
+    /** 항목의 시각 읽기 (슬롯에 항목이 없으면 false) */
+    bool ReadTimestamp(uint64 Sequence, FDateTime& OutTimestamp) const;
+    
+    /**
+     * 필터에 맞는 항목을 오래된 순서로 방문 (SlotsLock을 잡은 상태에서 호출)
+     * 항목은 슬롯을 놓은 뒤에 전달되므로 방문 함수에서 오래 걸리는 작업을 해도 됩니다.
+     */
+    void ForEachMatching(const FJsonCRDTLogFilter& Filter, TFunctionRef<void(FJsonCRDTLogEntry&&)> Visitor) const;
+    
+    /** 보관된 내용을 로그 항목으로 변환 */
+    void RecordToLogEntry(const FLogRecord& Record, FJsonCRDTLogEntry& OutLogEntry) const;
+    
+    /** 필터 문자열을 인터닝 번호로 변환 */
+    FResolvedFilter ResolveFilter(const FJsonCRDTLogFilter& Filter) const;
     
     /** 로그 필터 적용 */
-    bool ApplyFilter(const FJsonCRDTLogEntry& LogEntry, const FJsonCRDTLogFilter& Filter) const;
+    bool ApplyFilter(const FLogRecord& Record, const FJsonCRDTLogFilter& Filter, const FResolvedFilter& Resolved) const;
     
     /** 로그를 JSON 형식으로 변환 */
     TSharedPtr<FJsonObject> LogEntryToJson(const FJsonCRDTLogEntry& LogEntry) const;
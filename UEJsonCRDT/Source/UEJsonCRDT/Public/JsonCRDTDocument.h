@@ -8,6 +8,13 @@
 #include "JsonCRDTTypes.h"
 #include "JsonCRDTConflictResolver.h"
 #include "JsonCRDTLogger.h"
+#include "JsonCRDTPath.h"
+#include "JsonCRDTNodeStore.h"
+#include "JsonCRDTOperationHistory.h"
+#include "JsonCRDTDocumentCore.h"
+#include "JsonCRDTPendingQueue.h"
+#include "JsonCRDTBinaryDocument.h"
+#include "JsonCRDTPathTrie.h"
 #include "JsonCRDTDocument.generated.h"
 
 class UJsonCRDTSyncManager;
@@ -16,6 +23,29 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnDocumentChanged, const FString&,
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnSyncError, const FString&, DocumentID, const FString&, ErrorMessage);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnDocumentRecovered, const FString&, DocumentID, const FString&, RecoverySource);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnConflictDetected, const FJsonCRDTConflict&, Conflict);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnConflictsDetected, const FString&, DocumentID, const TArray<FJsonCRDTConflict>&, Conflicts);
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnPathChanged, const FString&, Path, const FString&, Value);
+
+/**
+ * State that local storage does not keep, captured when a document is evicted so it can be reloaded as it was
+ */
+struct FJsonCRDTEvictedState
+{
+	/** Last applied patch sequence per client, so resent patches are still skipped after the reload */
+	TMap<FString, int64, FDefaultSetAllocator, TJsonCRDTCaseSensitiveMapKeyFuncs<int64>> VersionVector;
+
+	/** Sequence of the last local patch sent */
+	int64 LocalPatchSequence = 0;
+
+	/** Settings */
+	EJsonCRDTLocalStorageFormat LocalStorageFormat = EJsonCRDTLocalStorageFormat::Json;
+	FJsonCRDTSnapshotPolicy SnapshotPolicy;
+	TSharedPtr<IJsonCRDTConflictResolver> ConflictResolver;
+	EJsonCRDTConflictStrategy ConflictStrategy = EJsonCRDTConflictStrategy::LastWriterWins;
+	int32 MaxOperationHistory = 0;
+	int32 MaxLocalJournalSize = 0;
+	bool bAutoLocalSave = false;
+};
 
 /**
  * UJsonCRDTDocument - A CRDT-based JSON document that can be synchronized with a server
@@ -45,10 +75,17 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
 	FString GetContentAsString() const;
 
-	/** Get the document content as a JSON object */
+	/** Get the document content as a JSON object (a fresh copy built from the node store; use SetContent to apply edits) */
 	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
 	TSharedPtr<FJsonObject> GetContent() const;
 
+	/** Get the JSON value at a JSON Pointer path without building an object view of the whole document (an empty path is the whole document) */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	bool GetValueAtPath(const FString& Path, FString& OutValue) const;
+
+	/** Get the native node store backing the document content */
+	const FJsonCRDTNodeStore& GetContentStore() const;
+
 	/** Set the document content from a JSON string */
 	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
 	bool SetContentFromString(const FString& JsonString);
@@ -56,34 +93,149 @@ public:
 	/** Set the document content from a JSON object */
 	bool SetContent(TSharedPtr<FJsonObject> JsonObject);
 
+	/** Set the document content from an already parsed node store (lets callers parse on a worker thread) */
+	bool SetContentFromStore(FJsonCRDTNodeStore&& NewContent);
+
+	/** Replace the content with a copy loaded from the server and adopt the server's version as the document version */
+	bool SetServerContent(FJsonCRDTNodeStore&& NewContent, int64 ServerVersion);
+
 	/** Apply a JSON patch to the document */
 	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
 	bool ApplyPatch(const FJsonCRDTPatch& Patch);
 
+	/** Apply a JSON patch the caller no longer needs; its operations are moved into the operation history instead of copied */
+	bool ApplyPatch(FJsonCRDTPatch&& Patch);
+
+	/**
+	 * Check that a patch is well formed before it is applied (does not touch any document state, safe on any thread)
+	 * @param OutError Reason the patch was rejected
+	 */
+	static bool ValidatePatch(const FJsonCRDTPatch& Patch, FString& OutError);
+
 	/** Apply a JSON patch to the document from a JSON string */
 	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
 	bool ApplyPatchFromString(const FString& PatchString);
 
+	/** Apply a local operation and queue it for the next outgoing patch */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	bool ApplyLocalOperation(const FJsonCRDTOperation& Operation);
+
+	/** Apply local operations atomically and queue them for the next outgoing patch */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	bool ApplyLocalOperations(const TArray<FJsonCRDTOperation>& Operations);
+
+	/** Get the number of queued local operations after coalescing */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	int32 GetNumPendingOperations() const;
+
+	/** Move the queued local operations into an outgoing patch numbered with the next local sequence (returns false if nothing is queued) */
+	bool TakePendingPatch(FJsonCRDTPatch& OutPatch);
+
+	/** Highest patch sequence applied from each remote client */
+	const TMap<FString, int64, FDefaultSetAllocator, TJsonCRDTCaseSensitiveMapKeyFuncs<int64>>& GetVersionVector() const { return Core.GetVersionVector(); }
+
+	/** Build a sync request carrying the version vector, so the server can reply with only the patches this document is missing */
+	FJsonCRDTPatch MakeSyncRequest() const;
+
+	/** Put a patch that could not be sent back at the front of the queue */
+	void RequeuePendingPatch(FJsonCRDTPatch&& Patch);
+
+	/**
+	 * Identifies the current run of recorded changes. It changes whenever the content is replaced wholesale
+	 * (loads, restores, SetContent) or the change log overflows, so versions from an older run cannot be used as a base.
+	 */
+	int32 GetChangeLogGeneration() const { return ChangeLogGeneration; }
+
+	/**
+	 * Collect the operations applied after a version, oldest first (used to save only what changed since the server's copy)
+	 * @param Generation The change log generation the version was taken in
+	 * @param SinceVersion The version the operations should apply to
+	 * @return False if the changes since that version were not recorded (a full save is needed)
+	 */
+	bool GetChangesSince(int32 Generation, int64 SinceVersion, TArray<FJsonCRDTOperation>& OutOperations) const;
+
+	/** Drop recorded changes that apply to versions older than InVersion (no longer needed as a delta base) */
+	void DiscardChangesBefore(int64 InVersion);
+
 	/** Create a snapshot of the current document state */
 	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
 	FJsonCRDTSnapshot CreateSnapshot() const;
 
-	/** Restore the document from a snapshot */
+	/** Restore the document from a snapshot (a snapshot without content is rebuilt from the retained history) */
 	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
 	bool RestoreFromSnapshot(const FJsonCRDTSnapshot& Snapshot);
 
+	/** Rebuild a retained earlier version from the nearest full snapshot and inverse deltas; newer versions are discarded */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	bool RestoreToVersion(int64 TargetVersion);
+
+	/** Set when full snapshots are taken and how much delta history is kept */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void SetSnapshotPolicy(const FJsonCRDTSnapshotPolicy& InPolicy);
+
+	/** Get the snapshot policy */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	FJsonCRDTSnapshotPolicy GetSnapshotPolicy() const;
+
+	/** Evaluate the interval and idle snapshot policies (called by the sync manager every tick) */
+	void TickSnapshotPolicy(double CurrentTime);
+
 	/** Save the document to the server */
 	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
 	void Save();
 
-	/** Save the document locally */
+	/** Save the document locally as a new base file and reset its journal (serialized now, written to disk by the background writer) */
 	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
 	bool SaveLocally();
 
-	/** Load the document from local storage */
+	/** Mark the document for a debounced local save (performed from TickLocalSave) */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void RequestLocalSave();
+
+	/** Check if a requested local save has not been performed yet */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	bool HasUnsavedLocalChanges() const;
+
+	/**
+	 * Perform a requested local save once no save was requested for DebounceSeconds, or MaxDelaySeconds after the first request
+	 * (called by the sync manager every tick). Changes since the last save are appended to the journal; the base file is
+	 * rewritten only when the journal cannot continue it or has grown past the maximum journal size.
+	 */
+	void TickLocalSave(double CurrentTime, double DebounceSeconds, double MaxDelaySeconds);
+
+	/** Set the journal size in bytes after which a local save compacts the journal into a new base file */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void SetMaxLocalJournalSize(int32 MaxBytes);
+
+	/** Get the journal size in bytes after which a local save compacts the journal into a new base file */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	int32 GetMaxLocalJournalSize() const;
+
+	/** Set the format used for local saves (loading falls back to the JSON file when no binary file exists yet) */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void SetLocalStorageFormat(EJsonCRDTLocalStorageFormat Format);
+
+	/** Get the format used for local saves */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	EJsonCRDTLocalStorageFormat GetLocalStorageFormat() const;
+
+	/**
+	 * Load the document from local storage (the base file plus every intact journal record that follows it).
+	 * A binary base file stays memory-mapped and is decoded on first access; GetValueAtPath reads only the addressed subtree until then.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
 	bool LoadFromLocal();
 
+	/**
+	 * Read local storage like LoadFromLocal, but without flushing the storage writer or notifying listeners.
+	 * Only touches this document, so batches of documents can be read on worker threads; flush FJsonCRDTLocalStorageWriter
+	 * first and call NotifyLoadedFromLocal on the game thread afterwards.
+	 */
+	bool ReadFromLocal();
+
+	/** Notify listeners after ReadFromLocal succeeded (and broadcast OnDocumentRecovered when it was a recovery) */
+	void NotifyLoadedFromLocal(bool bRecovered);
+
 	/** Synchronize the document with the server */
 	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
 	void Sync();
@@ -104,10 +256,53 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
 	bool IsAutoLocalSaveEnabled() const;
 
+	/** Set the maximum number of operations kept for conflict detection */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void SetMaxOperationHistory(int32 MaxOperations);
+
+	/** Get the maximum number of operations kept for conflict detection */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	int32 GetMaxOperationHistory() const;
+
+	/** Get the operation history */
+	const FJsonCRDTOperationHistory& GetOperationHistory() const;
+
+	/** Get the number of remote operations whose conflict was resolved and applied */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	int32 GetNumResolvedConflicts() const;
+
+	/**
+	 * Get the two operations of a reported conflict from the operation history
+	 * @param Conflict A conflict passed to OnConflictDetected or OnConflictsDetected
+	 * @param OutLocalOperation The local operation (with its client ID)
+	 * @param OutRemoteOperation The applied remote operation (with its client ID)
+	 * @return False if either operation has already been evicted from the history
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	bool GetConflictOperations(const FJsonCRDTConflict& Conflict, FJsonCRDTOperation& OutLocalOperation, FJsonCRDTOperation& OutRemoteOperation) const;
+
+	/** Get the approximate heap memory held by the content, histories, change log and pending operations (constant time) */
+	SIZE_T GetAllocatedSize() const;
+
+	/** Get the time of the last change to the content (FPlatformTime::Seconds, 0 if never changed) */
+	double GetLastChangeTime() const { return LastChangeTime; }
+
+	/** Check whether anything listens to the document (change or conflict events, path subscriptions) */
+	bool HasListeners() const;
+
+	/** Capture the state local storage does not keep, before the document is evicted */
+	void CaptureEvictedState(FJsonCRDTEvictedState& OutState) const;
+
+	/** Restore state captured at eviction; call before LoadFromLocal so the storage format matches */
+	void RestoreEvictedState(FJsonCRDTEvictedState&& State);
+
 	/** Attempt to recover the document from local storage or snapshots */
 	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
 	bool RecoverDocument();
 
+	/** Attempt to recover the document from the latest snapshot only (the fallback when local storage cannot be read) */
+	bool RecoverFromSnapshot();
+
 	/** Event triggered when the document changes */
 	UPROPERTY(BlueprintAssignable, Category = "JsonCRDT")
 	FOnDocumentChanged OnDocumentChanged;
@@ -120,10 +315,27 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "JsonCRDT")
 	FOnDocumentRecovered OnDocumentRecovered;
 
-	/** Event triggered when a conflict is detected */
+	/** Event triggered for each conflict resolved by an applied patch */
 	UPROPERTY(BlueprintAssignable, Category = "JsonCRDT")
 	FOnConflictDetected OnConflictDetected;
 
+	/** Event triggered once per applied patch with all the conflicts it resolved, in operation order (one call per burst instead of one per conflict) */
+	UPROPERTY(BlueprintAssignable, Category = "JsonCRDT")
+	FOnConflictsDetected OnConflictsDetected;
+
+	/**
+	 * Subscribe to changes at or below a JSON Pointer path. The callback fires once per change that touched the path,
+	 * one of its descendants or one of its ancestors, and receives the subscribed path with its new value as a JSON string
+	 * (empty if the path no longer exists).
+	 * @return Handle for Unsubscribe
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	int32 Subscribe(const FString& Path, FOnPathChanged Callback);
+
+	/** Remove a path subscription */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void Unsubscribe(int32 SubscriptionHandle);
+
 	/** Set the conflict resolver */
 	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
 	void SetConflictStrategy(EJsonCRDTConflictStrategy Strategy);
@@ -161,53 +373,193 @@ public:
 	bool VisualizeHistory(const FString& FilePath);
 
 private:
-	/** The document ID */
-	UPROPERTY()
-	FString DocumentID;
-
-	/** The document version */
-	UPROPERTY()
-	int64 Version;
+	/**
+	 * Document ID, version, content, operation history and version vector, with the patch apply and rollback shared with headless programs.
+	 * Mutable because the content is filled from MappedContent on first access after a binary load.
+	 */
+	mutable FJsonCRDTDocumentCore Core;
 
-	/** The document content */
-	TSharedPtr<FJsonObject> Content;
+	/** Memory-mapped binary base file whose content has not been decoded yet */
+	mutable TUniquePtr<FJsonCRDTBinaryDocument> MappedContent;
 
 	/** The sync manager */
 	UPROPERTY()
 	UJsonCRDTSyncManager* SyncManager;
 
-	/** The operation history */
-	TArray<FJsonCRDTPatch> OperationHistory;
-
-	/** The snapshot history */
+	/** Full snapshots, oldest first */
 	TArray<FJsonCRDTSnapshot> SnapshotHistory;
 
-	/** Maximum number of operations to keep in history */
-	int32 MaxOperationHistory;
+	/** Inverse deltas for each recorded version change, oldest first */
+	TArray<FJsonCRDTSnapshotDelta> DeltaHistory;
+
+	/** When to take full snapshots and how much history to keep */
+	FJsonCRDTSnapshotPolicy SnapshotPolicy;
+
+	/** Operations applied since the last full snapshot */
+	int32 OperationsSinceSnapshot;
 
-	/** Maximum number of snapshots to keep */
-	int32 MaxSnapshotHistory;
+	/** Time of the last full snapshot (FPlatformTime::Seconds) */
+	double LastSnapshotTime;
+
+	/** Heap memory held by the snapshot strings and the delta inverse operations, updated as the histories change */
+	SIZE_T HistoryBytes;
+
+	/** Time of the last content change (FPlatformTime::Seconds) */
+	double LastChangeTime;
 
 	/** Whether to automatically save locally after changes */
 	UPROPERTY()
 	bool bAutoLocalSave;
 
+	/** Format used for local saves */
+	UPROPERTY()
+	EJsonCRDTLocalStorageFormat LocalStorageFormat;
+
+	/** Whether a debounced local save has been requested */
+	bool bLocalSaveRequested;
+
+	/** Time of the first and last pending local save request (FPlatformTime::Seconds) */
+	double FirstLocalSaveRequestTime;
+	double LastLocalSaveRequestTime;
+
+	/** Journal records of version changes not yet handed to the writer */
+	TArray<uint8> PendingJournal;
+
+	/** Bytes handed to the writer for the journal since the last base file */
+	int64 LocalJournalSize;
+
+	/** Journal size after which a local save compacts into a new base file */
+	int32 MaxLocalJournalSize;
+
+	/** Whether the journal continues the last base file (false until the first base file and after non-incremental changes) */
+	bool bLocalJournalValid;
+
 	/** The last error message */
 	UPROPERTY()
 	FString LastErrorMessage;
 
-	/** Pending operations that need to be synchronized */
-	TArray<FJsonCRDTPatch> PendingOperations;
+	/** Local operations that need to be synchronized, coalesced as they are queued */
+	FJsonCRDTPendingQueue PendingOperations;
+
+	/** Sequence number of the last patch taken for sending */
+	int64 LocalPatchSequence;
+
+	/** One version change in the change log; the operations themselves stay in OperationHistory */
+	struct FChangeLogRecord
+	{
+		/** Version the operations apply to */
+		int64 BaseVersion = 0;
+
+		/** History sequence number of the first operation */
+		uint64 FirstSequence = 0;
+
+		/** Number of operations, stored at consecutive history sequence numbers */
+		int32 NumOperations = 0;
+	};
+
+	/** Version changes since ChangeLogStartVersion, one record per version change */
+	TArray<FChangeLogRecord> ChangeLog;
+
+	/** Version from which the change log is complete */
+	int64 ChangeLogStartVersion;
+
+	/** Number of operations in the change log */
+	int32 NumChangeLogOperations;
+
+	/** Current change log generation */
+	int32 ChangeLogGeneration;
+
+	/** Record a version change whose operations were just added to the operation history from FirstSequence on */
+	void AppendChangeLog(int64 PreviousVersion, uint64 FirstSequence, int32 NumOperations);
+
+	/** Start a new change log generation at the current version */
+	void ResetChangeLog();
 
 	/** Create a new snapshot and add it to the history */
 	void CreateAndAddSnapshot();
 
-	/** Notify that the document has changed */
-	void NotifyDocumentChanged();
+	/** Add a snapshot to the history (without trimming) */
+	void AddSnapshot(const FJsonCRDTSnapshot& Snapshot);
+
+	/** Remove all inverse deltas */
+	void ResetDeltaHistory();
+
+	/** Record the inverse delta of a version change and apply the operation-count snapshot policy */
+	void RecordChange(int64 PreviousVersion, TArray<FJsonCRDTOperation>&& InverseOperations, int32 NumOperations);
+
+	/** Drop all deltas and full snapshots newer than the given version */
+	void DiscardHistoryAfter(int64 InVersion);
+
+	/**
+	 * Walk inverse deltas backwards from FromVersion to TargetVersion on a store
+	 * @param OutFirstDeltaIndex Index of the oldest delta that was applied
+	 * @return Whether TargetVersion was reached
+	 */
+	bool RewindStore(FJsonCRDTNodeStore& Store, int64 FromVersion, int64 TargetVersion, int32& OutFirstDeltaIndex) const;
+
+	/** A path subscription */
+	struct FPathSubscription
+	{
+		FString Path;
+		FOnPathChanged Callback;
+	};
+
+	/** Path subscriptions by handle */
+	TMap<int32, FPathSubscription> PathSubscriptions;
+
+	/** Subscription handles indexed by path */
+	FJsonCRDTPathTrie SubscriptionTrie;
+
+	/** Handle for the next subscription */
+	int32 NextSubscriptionHandle;
+
+	/** Collect the subscriptions affected by applied operations */
+	void CollectChangedSubscriptions(const TArray<FJsonCRDTOperation>& Operations, TSet<int32>& OutHandles) const;
+
+	/**
+	 * Notify that the document has changed
+	 * @param ChangedSubscriptions Subscriptions touched by the change (nullptr if the whole content may have changed)
+	 */
+	void NotifyDocumentChanged(const TSet<int32>* ChangedSubscriptions = nullptr);
 
 	/** Get the local storage path for this document */
 	FString GetLocalStoragePath() const;
 
+	/** Get the local storage path for this document in the given format */
+	FString GetLocalStoragePath(EJsonCRDTLocalStorageFormat Format) const;
+
+	/** Decode a memory-mapped base file into Content and release the mapping */
+	void MaterializeContent() const;
+
+	/** Load version, content and latest snapshot from a JSON base file */
+	bool LoadJsonBaseFile(const FString& FilePath);
+
+	/** Load version and latest snapshot from a binary base file and keep it mapped for lazy decoding */
+	bool LoadBinaryBaseFile(const FString& FilePath);
+
+	/** Get the path of the journal next to the local storage file */
+	FString GetLocalJournalPath() const;
+
+	/**
+	 * Append a journal record for a version change if the journal is valid
+	 * @param PreviousVersion Version before the change
+	 * @param Operations Operations as applied (borrowed for encoding and left unchanged)
+	 */
+	void JournalChange(int64 PreviousVersion, TArray<FJsonCRDTOperation>& Operations);
+
+	/** Stop journaling until the next base file (for changes that are not a sequence of operations) */
+	void InvalidateLocalJournal();
+
+	/** Hand pending journal records to the writer (returns false if the journal must be compacted instead) */
+	bool AppendLocalJournal();
+
+	/**
+	 * Replay journal records that follow the current version
+	 * @param bOutNeedsCompaction Whether the journal had records that could not be replayed
+	 * @return Number of records replayed
+	 */
+	int32 ReplayLocalJournal(bool& bOutNeedsCompaction);
+
 	/** Set the last error message */
 	void SetLastErrorMessage(const FString& ErrorMessage);
 
@@ -215,6 +567,9 @@ private:
 	UPROPERTY()
 	EJsonCRDTConflictStrategy ConflictStrategy;
 
+	/** 해결하고 적용한 충돌 수 */
+	int32 NumResolvedConflicts;
+
 	/** 충돌 해결 구현체 */
 	TSharedPtr<IJsonCRDTConflictResolver> ConflictResolver;
 
@@ -224,12 +579,50 @@ private:
 	/** 충돌 해결 */
 	bool ResolveConflict(FJsonCRDTConflict& Conflict);
 
+	/** 여러 충돌을 해결자에 한 번에 넘겨 해결 */
+	void ResolveConflicts(TArrayView<FJsonCRDTConflict> Conflicts);
+
+	/**
+	 * 원격 Replace 작업이 같은 경로의 마지막 Replace와 다른 값을 쓰는지 확인
+	 * @return 충돌이면 true (OutConflict를 채움)
+	 */
+	bool FindConflict(const FJsonCRDTOperation& Operation, FJsonCRDTConflict& OutConflict) const;
+
+	/**
+	 * 패치를 적용하기 전의 히스토리에 대해 충돌을 모음
+	 * @param OutOperationConflicts 작업별 충돌 색인 (충돌이 없으면 INDEX_NONE, 같은 패치에서 앞서 바꾼 경로라서 적용할 때 확인할 작업은 JsonCRDTDocument::DeferredConflict)
+	 */
+	void CollectConflicts(const TArray<FJsonCRDTOperation>& Operations, TArray<FJsonCRDTConflict>& OutConflicts, TArray<int32, TInlineAllocator<16>>& OutOperationConflicts) const;
+
 	/** 작업 로깅 */
 	void LogOperation(const FJsonCRDTOperation& Operation, const FString& OldValue, const FString& NewValue, bool bHadConflict = false, const FJsonCRDTConflict& Conflict = FJsonCRDTConflict());
 
-	/** JSON 경로에서 값 가져오기 */
-	TSharedPtr<FJsonValue> GetValueAtPath(TSharedPtr<FJsonObject> JsonObject, const FString& Path) const;
-
-	/** 작업 적용 */
-	void ApplyOperation(const FJsonCRDTOperation& Operation);
+	/** 새로 로드한 노드 저장소로 내용 교체 */
+	bool CommitContent(FJsonCRDTNodeStore&& NewContent);
+
+	/**
+	 * 확인을 마친 패치의 작업 적용
+	 * 실제로 적용된 작업은 패치의 작업 배열 앞쪽으로 옮겨 저널, 변경 기록, 구독 알림에 그대로 넘기므로 작업 배열은 비워짐
+	 */
+	bool ApplyAcceptedPatch(FJsonCRDTPatch& Patch);
+
+	/**
+	 * 원격 작업 하나를 적용 (충돌은 미리 해결됨)
+	 * @param Operation 적용할 작업 (충돌이 해결되면 해결된 값으로 바뀜)
+	 * @param Conflict 이 작업의 충돌 (없으면 nullptr, 해결되지 않았으면 적용하지 않음)
+	 * @param KnownNode 스칼라 Replace 일괄 경로에서 미리 찾은 대상 노드 (없으면 INDEX_NONE)
+	 * @param KnownScalar 미리 파싱한 스칼라 값 (없으면 nullptr)
+	 * @param bOutTreeChanged 노드가 새로 할당되거나 해제되었는지 여부 (미리 찾은 노드가 무효화됨)
+	 * @param bOutSkipped 해결되지 않은 충돌로 작업을 적용하지 않았는지 여부
+	 * @param OutOldValue 적용 전 값 (Replace, Remove, Test만, 작업 로그용)
+	 * @param OutInverse 적용된 작업의 역작업을 추가할 배열
+	 * @return 성공 여부 (히스토리와 로그에는 넣지 않음)
+	 */
+	bool ApplyRemoteOperation(FJsonCRDTOperation& Operation, const FJsonCRDTConflict* Conflict, int32 KnownNode, const FJsonCRDTScalar* KnownScalar, bool& bOutTreeChanged, bool& bOutSkipped, FString& OutOldValue, TArray<FJsonCRDTOperation>& OutInverse);
+
+	/**
+	 * 패치가 스칼라 리프에 대한 Replace 작업만으로 이루어졌는지 확인하고 대상 노드와 값을 미리 해석
+	 * @return 일괄 경로를 사용할 수 있으면 true
+	 */
+	bool PrepareScalarReplaceBatch(const FJsonCRDTPatch& Patch, TArray<int32, TInlineAllocator<16>>& OutNodes, TArray<FJsonCRDTScalar, TInlineAllocator<16>>& OutScalars) const;
 };
@@ -0,0 +1,95 @@
+// Copyright Your Company. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+
+/**
+ * 로컬 저장 파일을 작업 스레드에서 쓰는 백그라운드 기록기
+ *
+ * 쓰기 요청은 파일별로 최신 내용만 남기고, 쌓인 요청은 작업 하나가 한 번에 처리합니다.
+ * 각 파일은 임시 파일에 먼저 쓴 뒤 이름을 바꾸므로 쓰는 도중 중단되어도 이전 파일이 남습니다.
+ * 추가 쓰기 요청은 요청 순서대로 이어 붙이며, 한 번의 처리에서 파일 교체보다 뒤에 씁니다.
+ * 모든 함수는 어느 스레드에서나 호출할 수 있습니다.
+ */
+class UEJSONCRDT_API FJsonCRDTLocalStorageWriter
+{
+public:
+	FJsonCRDTLocalStorageWriter();
+	~FJsonCRDTLocalStorageWriter();
+
+	/** 플러그인 전체가 공유하는 기록기 */
+	static FJsonCRDTLocalStorageWriter& Get();
+
+	/**
+	 * 파일 쓰기 요청 (아직 쓰지 않은 같은 파일의 이전 요청은 대체됨)
+	 * @param FilePath 파일 경로
+	 * @param Contents 파일 내용
+	 * @param JournalPathToReset 파일을 쓴 뒤 지울 저널 파일 경로 (비어 있으면 없음, 아직 쓰지 않은 추가 쓰기도 버림)
+	 */
+	void Write(const FString& FilePath, FString&& Contents, const FString& JournalPathToReset = FString());
+
+	/**
+	 * 바이너리 파일 쓰기 요청 (아직 쓰지 않은 같은 파일의 이전 요청은 대체됨)
+	 * @param FilePath 파일 경로
+	 * @param Bytes 파일 내용
+	 * @param JournalPathToReset 파일을 쓴 뒤 지울 저널 파일 경로 (비어 있으면 없음, 아직 쓰지 않은 추가 쓰기도 버림)
+	 */
+	void Write(const FString& FilePath, TArray<uint8>&& Bytes, const FString& JournalPathToReset = FString());
+
+	/**
+	 * 파일 끝에 추가 쓰기 요청
+	 * @param FilePath 파일 경로
+	 * @param Bytes 덧붙일 내용
+	 */
+	void Append(const FString& FilePath, TArray<uint8>&& Bytes);
+
+	/** 요청된 쓰기가 모두 끝날 때까지 대기 */
+	void Flush();
+
+	/** 아직 쓰지 않은 파일 수 */
+	int32 NumPendingWrites() const;
+
+private:
+	/** 쓰기 요청 하나 (텍스트 또는 바이너리) */
+	struct FPendingWrite
+	{
+		FString Text;
+		TArray<uint8> Bytes;
+		bool bBinary = false;
+	};
+
+	/** 아직 쓰지 않은 파일 내용 (파일 경로별 최신 내용) */
+	TMap<FString, FPendingWrite> PendingWrites;
+
+	/** 파일을 쓴 뒤 지울 저널 파일 경로 (파일 경로별) */
+	TMap<FString, FString> PendingJournalResets;
+
+	/** 아직 덧붙이지 않은 내용 (파일 경로별, 요청 순서대로 이어 붙임) */
+	TMap<FString, TArray<uint8>> PendingAppends;
+
+	/** 쓰기 작업 */
+	UE::Tasks::FTask WriteTask;
+
+	/** 쓰기 작업이 예약되었거나 실행 중인지 여부 */
+	bool bWriteScheduled;
+
+	/** 대기 중인 요청, WriteTask, bWriteScheduled 보호 */
+	mutable FCriticalSection CriticalSection;
+
+	/** 쓰기 요청 등록 (CriticalSection을 잡은 상태에서 호출) */
+	void AddWrite(const FString& FilePath, FPendingWrite&& PendingWrite, const FString& JournalPathToReset);
+
+	/** 쓰기 작업이 없으면 예약 (CriticalSection을 잡은 상태에서 호출) */
+	void ScheduleWrite();
+
+	/** 쌓인 요청이 없을 때까지 파일 쓰기 (작업 스레드) */
+	void WritePending();
+
+	/** 임시 파일에 쓴 뒤 이름을 바꿔 파일을 교체 */
+	static bool WriteFileAtomically(const FString& FilePath, const FPendingWrite& PendingWrite);
+
+	/** 파일 끝에 내용 덧붙이기 (파일이 없으면 만듦) */
+	static bool AppendToFile(const FString& FilePath, const TArray<uint8>& Bytes);
+};
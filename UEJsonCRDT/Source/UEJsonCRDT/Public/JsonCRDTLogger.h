@@ -7,6 +7,15 @@
 #include "JsonCRDTConflictResolver.h"
 #include "JsonCRDTLogger.generated.h"
 
+/**
+ * 작업 로깅을 컴파일할지 여부 (기본값: Shipping 빌드에서는 제외)
+ * 0이면 문서가 로그 항목을 만들지 않으며 로거 호출도 남지 않습니다.
+ * 빌드 규칙의 PublicDefinitions로 덮어쓸 수 있습니다.
+ */
+#ifndef JSONCRDT_LOGGING_ENABLED
+#define JSONCRDT_LOGGING_ENABLED !UE_BUILD_SHIPPING
+#endif
+
 /**
  * 로그 항목 구조체
  */
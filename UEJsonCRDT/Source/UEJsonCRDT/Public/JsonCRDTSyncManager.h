@@ -4,16 +4,98 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "Tickable.h"
+#include "Containers/Queue.h"
 #include "JsonCRDTTypes.h"
 #include "JsonCRDTTransport.h"
 #include "JsonCRDTLogger.h"
 #include "JsonCRDTConflictResolver.h"
+#include "JsonCRDTDocument.h"
+#include <atomic>
 #include "JsonCRDTSyncManager.generated.h"
 
-class UJsonCRDTDocument;
-
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSyncComplete, const FString&, DocumentID);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnDocumentSaveError, const FString&, DocumentID, const FString&, ErrorMessage);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnDocumentsLoadComplete, const TArray<FString>&, LoadedDocumentIDs, const TArray<FString>&, FailedDocumentIDs);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnDocumentsSaveComplete, const TArray<FString>&, SavedDocumentIDs, const TArray<FString>&, FailedDocumentIDs);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnNetworkStatusChanged, bool /* bIsOnline */, const FString& /* StatusMessage */);
+
+/**
+ * 문서의 동기화 우선순위 (수신 패치를 적용하고 서버로 보내는 순서)
+ */
+UENUM(BlueprintType)
+enum class EJsonCRDTSyncPriority : uint8
+{
+	/** 틱마다 모든 수신 패치를 적용하고 로컬 작업을 바로 전송 (시간 예산과 송신 제한을 받지 않음) */
+	Critical UMETA(DisplayName = "Critical"),
+
+	/** 시간 예산 안에서 적용하고 전송 주기마다 전송 */
+	Normal UMETA(DisplayName = "Normal"),
+
+	/** 보통 문서를 처리한 뒤 자기 예산과 남은 송신 제한 안에서 처리 (인벤토리, 퀘스트처럼 몇 초 늦어도 되는 문서) */
+	Background UMETA(DisplayName = "Background")
+};
+
+/**
+ * 동기화 통계 (텔레메트리용, 트래픽과 패치 수는 누적값)
+ */
+USTRUCT(BlueprintType)
+struct UEJSONCRDT_API FJsonCRDTSyncStats
+{
+	GENERATED_BODY()
+
+	/** 보낸 바이트 수 (WebSocket 메시지와 HTTP 요청 본문) */
+	UPROPERTY(BlueprintReadOnly, Category = "JsonCRDT")
+	int64 BytesSent = 0;
+
+	/** 받은 바이트 수 (WebSocket 메시지와 HTTP 응답 본문) */
+	UPROPERTY(BlueprintReadOnly, Category = "JsonCRDT")
+	int64 BytesReceived = 0;
+
+	/** 서버로 보낸 패치 수 */
+	UPROPERTY(BlueprintReadOnly, Category = "JsonCRDT")
+	int64 PatchesSent = 0;
+
+	/** 서버에서 받은 패치 수 */
+	UPROPERTY(BlueprintReadOnly, Category = "JsonCRDT")
+	int64 PatchesReceived = 0;
+
+	/** 문서에 적용한 수신 패치 수 */
+	UPROPERTY(BlueprintReadOnly, Category = "JsonCRDT")
+	int64 PatchesApplied = 0;
+
+	/** 최근 1초 동안 초당 적용한 수신 패치 수 */
+	UPROPERTY(BlueprintReadOnly, Category = "JsonCRDT")
+	float PatchesPerSecond = 0.0f;
+
+	/** 현재 문서들이 해결하고 적용한 충돌 수 */
+	UPROPERTY(BlueprintReadOnly, Category = "JsonCRDT")
+	int64 ConflictsResolved = 0;
+
+	/** 게임 스레드에서 적용을 기다리는 수신 패치 수 */
+	UPROPERTY(BlueprintReadOnly, Category = "JsonCRDT")
+	int32 ReceivedQueueDepth = 0;
+
+	/** 모든 문서에서 전송을 기다리는 로컬 작업 수 */
+	UPROPERTY(BlueprintReadOnly, Category = "JsonCRDT")
+	int32 PendingOperations = 0;
+
+	/** 연결이 없어 Transport가 보관 중인 작업 수 */
+	UPROPERTY(BlueprintReadOnly, Category = "JsonCRDT")
+	int32 OfflineQueuedOperations = 0;
+
+	/** 관리 중인 문서 수 */
+	UPROPERTY(BlueprintReadOnly, Category = "JsonCRDT")
+	int32 NumDocuments = 0;
+
+	/** 모든 문서가 차지하는 대략적인 메모리 (바이트) */
+	UPROPERTY(BlueprintReadOnly, Category = "JsonCRDT")
+	int64 DocumentMemory = 0;
+
+	/** 메모리 예산 때문에 로컬 저장소로 내려 둔 문서 수 */
+	UPROPERTY(BlueprintReadOnly, Category = "JsonCRDT")
+	int32 NumEvictedDocuments = 0;
+};
 
 /**
  * UJsonCRDTSyncManager - Manages synchronization of CRDT documents
@@ -22,7 +104,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnDocumentSaveError, const FString
  * 서버와의 통신은 IJsonCRDTTransport 인터페이스를 통해 추상화됩니다.
  */
 UCLASS(BlueprintType, Blueprintable)
-class UEJSONCRDT_API UJsonCRDTSyncManager : public UObject
+class UEJSONCRDT_API UJsonCRDTSyncManager : public UObject, public FTickableGameObject
 {
 	GENERATED_BODY()
 
@@ -30,6 +112,10 @@ public:
 	UJsonCRDTSyncManager();
 	virtual ~UJsonCRDTSyncManager();
 
+	//~ Begin UObject Interface
+	virtual void BeginDestroy() override;
+	//~ End UObject Interface
+
 	/**
 	 * 기본 Transport로 초기화 (HTTP 및 WebSocket 사용)
 	 * @param InServerURL 서버 URL (HTTP API)
@@ -44,6 +130,64 @@ public:
 	 */
 	void SetTransport(TSharedPtr<IJsonCRDTTransport> InTransport);
 
+	/**
+	 * 서버에 연결 (오프라인 모드에서는 연결하지 않음)
+	 * @return 연결 시작 여부
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	bool Connect();
+
+	/**
+	 * 서버와의 연결 해제 (자동 재연결도 멈춤)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void Disconnect();
+
+	/**
+	 * 서버와의 연결 상태 확인
+	 * @return 연결 상태
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	bool IsConnected() const;
+
+	/**
+	 * 연결이 끊기면 자동으로 다시 연결할지 설정
+	 * @param bEnable 자동 재연결 여부
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void SetAutoReconnect(bool bEnable);
+
+	/**
+	 * 연결에 성공하기 전까지 연속으로 시도할 최대 재연결 횟수 설정
+	 * @param MaxAttempts 최대 횟수 (0이면 제한 없음)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void SetMaxReconnectAttempts(int32 MaxAttempts);
+
+	/**
+	 * 재연결 대기 시간 설정 (실패할 때마다 두 배로 늘고 무작위로 흩어짐)
+	 * @param InitialDelaySeconds 첫 재시도의 대기 시간 (초)
+	 * @param MaxDelaySeconds 대기 시간의 상한 (초)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void SetReconnectDelay(float InitialDelaySeconds, float MaxDelaySeconds = 30.0f);
+
+	/**
+	 * 오프라인 모드 설정
+	 * 켜면 연결을 끊고 로컬 작업은 전송 대기열에 보관하며 서버 저장은 미룹니다.
+	 * 끄면 다시 연결하고, 연결되면 보관한 작업과 미룬 저장을 보낸 뒤 모든 문서를 동기화합니다.
+	 * @param bEnable 오프라인 모드 여부
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void SetOfflineMode(bool bEnable);
+
+	/**
+	 * 오프라인 모드인지 확인
+	 * @return 오프라인 모드 여부
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	bool IsOfflineMode() const;
+
 	/**
 	 * 새 문서 생성
 	 * @param Document 생성할 문서
@@ -60,26 +204,228 @@ public:
 
 	/**
 	 * 문서 저장
+	 * 서버가 마지막으로 확인한 버전 이후의 작업만 보내고, 서버가 기준 버전을 거절하거나
+	 * 그 이후의 변경을 작업으로 나타낼 수 없으면 전체 내용을 보냅니다.
 	 * @param Document 저장할 문서
 	 */
 	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
 	void SaveDocument(UJsonCRDTDocument* Document);
 
 	/**
-	 * 문서 동기화
+	 * 서버에서 여러 문서를 한 번에 로드 (모두 끝나면 OnDocumentsLoadComplete 발생)
+	 * 이미 로드된 문서는 요청하지 않고 로드된 것으로 알립니다.
+	 * @param DocumentIDs 로드할 문서 ID들
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void LoadDocuments(const TArray<FString>& DocumentIDs);
+
+	/**
+	 * 여러 문서를 로컬에 저장한 뒤 서버에 한 번에 저장 (모두 끝나면 OnDocumentsSaveComplete 발생)
+	 * @param InDocuments 저장할 문서들
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void SaveDocuments(const TArray<UJsonCRDTDocument*>& InDocuments);
+
+	/**
+	 * 문서 동기화 (대기 중인 로컬 작업이 있으면 바로 전송, 없으면 버전 벡터를 담은 동기화 요청)
 	 * @param Document 동기화할 문서
 	 */
 	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
 	void SyncDocument(UJsonCRDTDocument* Document);
 
 	/**
-	 * ID로 문서 가져오기
+	 * 모든 문서 동기화 (대기 중인 로컬 작업을 보낸 뒤 모든 문서의 버전 벡터를 한 번에 전송, 재연결 후 사용)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void SyncAllDocuments();
+
+	/**
+	 * 모든 문서의 대기 중인 로컬 작업을 패치로 묶어 전송 (우선순위와 송신 제한과 관계없이 바로 전송)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void FlushPendingPatches();
+
+	/**
+	 * 대기 중인 로컬 작업을 전송하는 주기 설정
+	 * @param Seconds 전송 주기 (초, 0이면 매 틱마다 전송)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void SetPatchFlushInterval(float Seconds);
+
+	/**
+	 * 대기 중인 로컬 작업을 전송하는 주기 가져오기
+	 * @return 전송 주기 (초)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	float GetPatchFlushInterval() const;
+
+	/**
+	 * 주기와 관계없이 바로 전송할 문서별 대기 작업 수 설정
+	 * @param NumOperations 대기 작업 수 (0이면 사용 안 함)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void SetPatchFlushThreshold(int32 NumOperations);
+
+	/**
+	 * 바로 전송할 문서별 대기 작업 수 가져오기
+	 * @return 대기 작업 수
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	int32 GetPatchFlushThreshold() const;
+
+	/**
+	 * 모든 문서를 로컬에 저장하고 파일 쓰기가 끝날 때까지 대기 (문서 직렬화는 병렬로 수행)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void SaveAllDocumentsLocally();
+
+	/**
+	 * 변경 후 로컬 저장을 미루는 시간 설정
+	 * @param DebounceSeconds 마지막 변경 후 이 시간 동안 변경이 없으면 저장 (초)
+	 * @param MaxDelaySeconds 변경이 계속되어도 첫 변경 후 이 시간이 지나면 저장 (초)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void SetLocalSaveDebounce(float DebounceSeconds, float MaxDelaySeconds);
+
+	/**
+	 * 틱마다 보통 우선순위 문서의 수신 패치 적용에 쓸 수 있는 시간 설정 (SetPriorityApplyBudget(Normal, Seconds)와 같음)
+	 * @param Seconds 시간 예산 (초)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void SetPatchApplyBudget(float Seconds);
+
+	/**
+	 * 틱마다 보통 우선순위 문서의 수신 패치 적용에 쓸 수 있는 시간 가져오기
+	 * @return 시간 예산 (초)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	float GetPatchApplyBudget() const;
+
+	/**
+	 * 문서의 동기화 우선순위 설정 (아직 로드하지 않았거나 내려 둔 문서 ID도 설정할 수 있음)
+	 * 적용을 기다리던 수신 패치와 미룬 서버 저장도 새 우선순위를 따릅니다.
+	 * @param DocumentID 문서 ID
+	 * @param Priority 우선순위 (기본값은 Normal)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void SetDocumentPriority(const FString& DocumentID, EJsonCRDTSyncPriority Priority);
+
+	/**
+	 * 문서의 동기화 우선순위 가져오기
+	 * @param DocumentID 문서 ID
+	 * @return 우선순위
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	EJsonCRDTSyncPriority GetDocumentPriority(const FString& DocumentID) const;
+
+	/**
+	 * 틱마다 한 우선순위의 수신 패치 적용에 쓸 수 있는 시간 설정
+	 * 높은 우선순위부터 적용하고, 예산을 넘으면 남은 패치는 다음 틱에 적용합니다 (틱마다 우선순위별로 최소 하나는 적용).
+	 * @param Priority 우선순위
+	 * @param Seconds 시간 예산 (초, 0보다 작으면 제한 없음, 기본값은 Critical 제한 없음, Normal 4ms, Background 1ms)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void SetPriorityApplyBudget(EJsonCRDTSyncPriority Priority, float Seconds);
+
+	/**
+	 * 틱마다 한 우선순위의 수신 패치 적용에 쓸 수 있는 시간 가져오기
+	 * @param Priority 우선순위
+	 * @return 시간 예산 (초, 0보다 작으면 제한 없음)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	float GetPriorityApplyBudget(EJsonCRDTSyncPriority Priority) const;
+
+	/**
+	 * 서버로 보내는 패치와 문서 저장의 초당 최대 수 설정 (Critical 문서는 제한을 받지 않음)
+	 * 제한에 걸린 로컬 작업은 문서에 쌓여 다음 전송에 합쳐지고, 서버 저장은 문서별로 하나로 합쳐져 틱마다 우선순위 순서대로
+	 * 보냅니다. 같은 우선순위에서는 가장 오래 기다린 문서를 먼저 보내며, 1초 분량까지 몰아서 보낼 수 있습니다.
+	 * @param MaxSendsPerSecond 초당 최대 전송 수 (0이면 제한 없음)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void SetOutboundRateLimit(int32 MaxSendsPerSecond);
+
+	/**
+	 * 서버로 보내는 패치와 문서 저장의 초당 최대 수 가져오기
+	 * @return 초당 최대 전송 수 (0이면 제한 없음)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	int32 GetOutboundRateLimit() const;
+
+	/**
+	 * ID로 문서 가져오기 (메모리에서 내려 둔 문서는 로컬 저장소에서 다시 읽음)
 	 * @param DocumentID 문서 ID
 	 * @return 문서 객체
 	 */
 	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
 	UJsonCRDTDocument* GetDocument(const FString& DocumentID);
 
+	/**
+	 * 문서들이 차지할 메모리 예산 설정
+	 * 넘으면 오래 쓰지 않은 문서부터 로컬에 저장하고 메모리에서 내립니다. 고정한 문서, 전송을 기다리는 작업이 있는 문서,
+	 * 변경 이벤트나 경로 구독이 있는 문서는 내리지 않습니다. 내린 문서는 GetDocument로 다시 요청하면 로컬 저장소에서
+	 * 읽고 (바이너리 형식이면 매핑만 함) 내려가 있는 동안 놓친 패치를 서버에 요청합니다.
+	 * 내리기 전에 가져간 문서 포인터는 더 이상 관리자와 동기화되지 않으므로 계속 쓸 문서는 고정해 두어야 합니다.
+	 * @param MaxBytes 예산 (바이트, 0이면 제한 없음)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void SetDocumentMemoryBudget(int64 MaxBytes);
+
+	/**
+	 * 문서 메모리 예산 가져오기
+	 * @return 예산 (바이트, 0이면 제한 없음)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	int64 GetDocumentMemoryBudget() const;
+
+	/**
+	 * 예산을 넘어도 문서를 내리지 않는 유휴 시간 설정 (방금 쓴 문서를 내렸다가 바로 다시 읽지 않도록)
+	 * @param Seconds 마지막으로 가져오거나 바뀐 뒤 이 시간이 지난 문서만 내림 (초)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void SetDocumentEvictionIdleTime(float Seconds);
+
+	/**
+	 * 문서 고정 여부 설정 (아직 로드하지 않은 문서 ID도 고정할 수 있음)
+	 * @param DocumentID 문서 ID
+	 * @param bPinned 고정하면 메모리 예산을 넘어도 내리지 않음
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void SetDocumentPinned(const FString& DocumentID, bool bPinned);
+
+	/**
+	 * 문서가 고정되어 있는지 확인
+	 * @param DocumentID 문서 ID
+	 * @return 고정 여부
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	bool IsDocumentPinned(const FString& DocumentID) const;
+
+	/**
+	 * 문서를 로컬에 저장하고 메모리에서 내림 (예산과 유휴 시간은 보지 않고, 내리지 않는 조건은 같음)
+	 * @param DocumentID 문서 ID
+	 * @return 내렸으면 true
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	bool EvictDocument(const FString& DocumentID);
+
+	/**
+	 * 문서가 메모리에 있는지 확인 (내려 둔 문서와 모르는 문서는 false)
+	 * @param DocumentID 문서 ID
+	 * @return 메모리에 있으면 true
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	bool IsDocumentResident(const FString& DocumentID) const;
+
+	/**
+	 * 서버에서 받을 문서 안의 경로 설정 (아직 로드하지 않은 문서 ID도 설정할 수 있음)
+	 * 관리자는 만들거나 로드한 문서를 구독하고 메모리에서 내린 문서는 구독을 해제하므로, 서버는 필요 없는 패치를 보내지 않습니다.
+	 * 큰 문서에서 경로를 정하면 다른 경로의 원격 변경은 받지 않으므로 로컬 사본의 그 부분은 갱신되지 않습니다.
+	 * @param DocumentID 문서 ID
+	 * @param PathPrefixes 받을 경로 접두사 (JSON Pointer, 비어 있으면 문서 전체)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	void SetDocumentSubscriptionPaths(const FString& DocumentID, const TArray<FString>& PathPrefixes);
+
 	/**
 	 * 모든 문서 복구 시도
 	 * @return 복구된 문서 수
@@ -135,6 +481,28 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
 	EJsonCRDTConflictStrategy GetDefaultConflictStrategy() const;
 
+	/**
+	 * 동기화 통계 가져오기 (문서 메모리는 호출할 때 계산)
+	 * @return 통계
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	FJsonCRDTSyncStats GetSyncStats() const;
+
+	/**
+	 * 문서별 대략적인 메모리 가져오기 (내용, 히스토리, 변경 기록, 대기 작업)
+	 * @return 문서 ID별 바이트 수
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+	TMap<FString, int64> GetDocumentMemoryUsage() const;
+
+	//~ Begin FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override;
+	virtual bool IsTickableWhenPaused() const override { return true; }
+	virtual bool IsTickableInEditor() const override { return true; }
+	//~ End FTickableGameObject Interface
+
 	/** 문서 동기화 완료 시 이벤트 */
 	UPROPERTY(BlueprintAssignable, Category = "JsonCRDT")
 	FOnSyncComplete OnSyncComplete;
@@ -143,6 +511,17 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "JsonCRDT")
 	FOnDocumentSaveError OnDocumentSaveError;
 
+	/** LoadDocuments의 모든 문서 결과가 모였을 때 이벤트 (실패한 문서는 OnDocumentSaveError로도 알림) */
+	UPROPERTY(BlueprintAssignable, Category = "JsonCRDT")
+	FOnDocumentsLoadComplete OnDocumentsLoadComplete;
+
+	/** SaveDocuments의 모든 문서 결과가 모였을 때 이벤트 (실패한 문서는 OnDocumentSaveError로도 알림) */
+	UPROPERTY(BlueprintAssignable, Category = "JsonCRDT")
+	FOnDocumentsSaveComplete OnDocumentsSaveComplete;
+
+	/** 서버 연결 상태가 바뀌었을 때 이벤트 (재연결을 예약할 때마다 끊김으로도 알림) */
+	FOnNetworkStatusChanged OnNetworkStatusChanged;
+
 private:
 	/** Transport 인터페이스 */
 	TSharedPtr<IJsonCRDTTransport> Transport;
@@ -151,20 +530,196 @@ private:
 	UPROPERTY()
 	TMap<FString, UJsonCRDTDocument*> Documents;
 
-	/** 패치 수신 처리 */
+	/** 패치 수신 처리 (임의의 스레드에서 호출됨, 검증 후 수신 대기열에 추가) */
 	void OnPatchReceived(const FJsonCRDTPatch& Patch);
 
+	/** 수신 대기열의 패치를 문서 우선순위별로 나누고 높은 우선순위부터 각자의 시간 예산 안에서 적용 (게임 스레드) */
+	void ProcessReceivedPatches();
+
+	/** 수신 패치 적용 (게임 스레드, 작업은 문서로 옮겨짐) */
+	void ApplyReceivedPatch(FJsonCRDTPatch&& Patch);
+
+	/** 검증을 마치고 게임 스레드에서 적용을 기다리는 수신 패치 (여러 작업 스레드가 추가하고 게임 스레드가 꺼냄) */
+	TQueue<FJsonCRDTPatch, EQueueMode::Mpsc> ReceivedPatches;
+
+	/** 수신 대기열의 패치 수 (TQueue는 크기를 알 수 없으므로 따로 셈) */
+	std::atomic<int32> NumReceivedPatches{ 0 };
+
+	/** 우선순위 수 */
+	static constexpr int32 NumSyncPriorities = 3;
+
+	/** 문서 ID별 우선순위 (없으면 Normal) */
+	TMap<FString, EJsonCRDTSyncPriority> DocumentPriorities;
+
+	/** 우선순위별 틱당 적용 시간 예산 (초, 0보다 작으면 제한 없음) */
+	float PriorityApplyBudgets[NumSyncPriorities];
+
+	/** 수신 대기열에서 꺼내 게임 스레드에서 적용을 기다리는 한 문서의 패치 */
+	struct FScheduledPatches
+	{
+		/** 도착 순서대로의 패치 (Head 앞은 이미 적용함) */
+		TArray<FJsonCRDTPatch> Patches;
+		int32 Head = 0;
+	};
+
+	/** 문서 ID별로 적용을 기다리는 패치 (같은 문서의 패치는 도착 순서대로 적용) */
+	TMap<FString, FScheduledPatches> ScheduledPatches;
+
+	/** 우선순위별로 적용을 기다리는 패치가 있는 문서 ID (먼저 도착한 문서부터) */
+	TArray<FString> ScheduledPatchDocumentIDs[NumSyncPriorities];
+
+	/** ScheduledPatches에 남은 패치 수 */
+	int32 NumScheduledPatches;
+
+	/** 초당 최대 전송 수 (0이면 제한 없음) */
+	int32 OutboundRateLimit;
+
+	/** 지금 보낼 수 있는 전송 수 (초당 OutboundRateLimit만큼 차고 1초 분량까지 쌓임) */
+	double OutboundTokens;
+
+	/** 마지막으로 전송 수를 채운 시간 */
+	double LastOutboundRefillTime;
+
+	/** 문서 ID별로 마지막으로 대기 작업을 보낸 시간 (송신 제한이 있을 때 오래 기다린 문서부터 보냄) */
+	TMap<FString, double> DocumentSendTimes;
+
+	/** 송신 제한 때문에 틱에서 보낼 서버 저장 (문서별로 하나, 요청 순서대로) */
+	TArray<FString> ScheduledSaveDocumentIDs;
+
+	/** 경과 시간만큼 보낼 수 있는 전송 수를 채움 */
+	void RefillOutboundTokens(double CurrentTime);
+
+	/** 전송 하나를 쓸 수 있으면 쓰고 true (제한이 없으면 항상 true) */
+	bool ConsumeOutboundToken();
+
+	/** 전송 주기에 우선순위 순서대로 송신 제한 안에서 대기 작업 전송 */
+	void FlushScheduledPatches(double CurrentTime);
+
+	/** 문서들의 대기 작업을 하나의 요청으로 전송 */
+	void SendDocumentPatches(const TArray<UJsonCRDTDocument*>& InDocuments);
+
+	/** 미룬 서버 저장을 우선순위 순서대로 송신 제한 안에서 전송 */
+	void SendScheduledSaves();
+
+	/** 적용한 수신 패치 수 */
+	int64 NumPatchesApplied;
+
+	/** 초당 적용 패치 수를 재는 구간의 시작 시간과 그 뒤로 적용한 패치 수 */
+	double PatchRateWindowStart;
+	int64 PatchRateWindowCount;
+
+	/** 최근 구간의 초당 적용 패치 수 */
+	float PatchesPerSecond;
+
+	/** 초당 적용 패치 수와 통계 그룹의 대기 작업 수, 문서 메모리 갱신 (1초마다) */
+	void UpdateStats(double CurrentTime);
+
+	/** 메모리 예산 (바이트, 0이면 제한 없음) */
+	int64 DocumentMemoryBudget;
+
+	/** 내릴 수 있는 최소 유휴 시간 (초) */
+	float DocumentEvictionIdleTime;
+
+	/** 마지막으로 예산을 확인한 시간 */
+	double LastBudgetCheckTime;
+
+	/** 고정한 문서 ID */
+	TSet<FString> PinnedDocumentIDs;
+
+	/** 문서 ID별로 마지막으로 GetDocument로 가져온 시간 (FPlatformTime::Seconds) */
+	TMap<FString, double> DocumentAccessTimes;
+
+	/** 메모리에서 내린 문서 ID별로 다시 읽을 때 되돌릴 상태 */
+	TMap<FString, FJsonCRDTEvictedState> EvictedDocuments;
+
+	/** 예산을 넘었으면 오래 쓰지 않은 문서부터 내림 (1초마다) */
+	void EnforceMemoryBudget(double CurrentTime);
+
+	/** 고정, 대기 작업, 이벤트 구독이 없어 내릴 수 있는 문서인지 확인 */
+	bool CanEvictDocument(const UJsonCRDTDocument* Document) const;
+
+	/** 문서를 로컬에 저장하고 맵에서 제거 (저장에 실패하면 내리지 않음) */
+	bool EvictResidentDocument(UJsonCRDTDocument* Document);
+
+	/** 내려 둔 문서를 로컬 저장소에서 다시 읽어 맵에 추가 */
+	UJsonCRDTDocument* ReloadEvictedDocument(const FString& DocumentID);
+
+	/** 문서 ID별로 서버에서 받을 경로 접두사 (없으면 문서 전체) */
+	TMap<FString, TArray<FString>> SubscriptionPaths;
+
+	/** Transport에 문서 구독 요청 (경로는 SubscriptionPaths) */
+	void SubscribeDocument(const FString& DocumentID);
+
+	/** 마지막 변경 후 로컬 저장까지 기다리는 시간 (초) */
+	float LocalSaveDebounce;
+
+	/** 첫 변경 후 로컬 저장까지 기다리는 최대 시간 (초) */
+	float LocalSaveMaxDelay;
+
 	/** 문서 로드 완료 처리 */
 	void OnDocumentLoaded(const FJsonCRDTDocumentData& DocumentData);
 
+	/** 여러 문서 로드 완료 처리 (파싱과 로컬 저장은 병렬로, 문서 등록과 알림은 게임 스레드에서) */
+	void OnDocumentsLoaded(const TArray<const FJsonCRDTDocumentData*>& LoadedData);
+
+	/** 서버가 마지막으로 확인한 문서 버전 (문서 버전은 로드할 때 서버 버전을 이어받으므로 서버와 같은 번호 체계) */
+	struct FServerVersion
+	{
+		/** 서버가 가지고 있는 문서 버전 */
+		int64 Version = 0;
+
+		/** 그때의 문서 변경 기록 세대 */
+		int32 ChangeLogGeneration = INDEX_NONE;
+	};
+
+	/** 문서 ID별로 서버가 마지막으로 확인한 버전 (변경분 저장의 기준) */
+	TMap<FString, FServerVersion> ServerVersions;
+
+	/** 서버가 문서를 Version으로 가지고 있음을 기록하고 필요 없는 변경 기록 정리 */
+	void SetServerVersion(UJsonCRDTDocument* Document, int64 Version, int32 ChangeLogGeneration);
+
+	/** 서버가 확인한 버전 이후의 변경분이나 전체 내용을 서버에 저장 */
+	void SendDocumentSave(UJsonCRDTDocument* Document);
+
+	/** 문서 전체 내용을 서버에 저장 */
+	void SaveDocumentContent(UJsonCRDTDocument* Document);
+
 	/** 문서 저장 완료 처리 */
 	void OnDocumentSaved(const FString& DocumentID);
 
 	/** 전송 오류 처리 */
 	void OnTransportError(const FString& DocumentID, const FString& ErrorMessage);
 
-	/** 모든 문서 로컬 저장 */
-	void SaveAllDocumentsLocally();
+
+	/** 패치 전송 (전송하지 못한 패치는 문서 대기열로 되돌림) */
+	void SendPendingPatches(TArray<FJsonCRDTPatch>&& Patches);
+
+	/** 대기 중인 로컬 작업 전송 주기 (초) */
+	float PatchFlushInterval;
+
+	/** 바로 전송할 문서별 대기 작업 수 */
+	int32 PatchFlushThreshold;
+
+	/** 마지막으로 대기 작업을 전송한 시간 (FPlatformTime::Seconds) */
+	double LastPatchFlushTime;
+
+	/** 재연결 설정 (Transport를 바꾸면 새 Transport에 다시 적용) */
+	FJsonCRDTReconnectSettings ReconnectSettings;
+
+	/** 오프라인 모드 여부 */
+	bool bOfflineMode;
+
+	/** 오프라인 모드라서 서버 저장을 미룬 문서 ID */
+	TSet<FString> DeferredSaveDocumentIDs;
+
+	/** Transport의 연결 상태 변경 처리 */
+	void OnConnectionStatusChanged(bool bIsConnected, const FString& StatusMessage);
+
+	/** 현재 Transport에 등록한 콜백 해제 (반환 후에는 디코딩 작업이 이 객체를 호출하지 않음) */
+	void UnregisterTransport();
+
+	/** 연결된 뒤 미룬 저장을 보내고 모든 문서 동기화 */
+	void ResumeOnline();
 
 	/** 로거 */
 	TSharedPtr<IJsonCRDTLogger> Logger;
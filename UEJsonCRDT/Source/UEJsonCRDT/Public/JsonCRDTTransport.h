@@ -4,8 +4,15 @@
 
 #include "CoreMinimal.h"
 #include "JsonCRDTTypes.h"
+#include "JsonCRDTBinaryCodec.h"
+#include "Tasks/Pipe.h"
+#include "Containers/Ticker.h"
+#include <atomic>
 #include "JsonCRDTTransport.generated.h"
 
+class IWebSocket;
+class IHttpRequest;
+
 // 문서 로드 완료 시 호출되는 델리게이트
 DECLARE_DELEGATE_OneParam(FOnDocumentLoaded, const FJsonCRDTDocumentData&);
 
@@ -21,6 +28,36 @@ DECLARE_DELEGATE_OneParam(FOnPatchReceived, const FJsonCRDTPatch&);
 // 전송 오류 발생 시 호출되는 델리게이트
 DECLARE_DELEGATE_TwoParams(FOnTransportError, const FString& /* DocumentID */, const FString& /* ErrorMessage */);
 
+// 서버가 변경분 저장의 기준 버전을 받아들이지 않았을 때 호출되는 델리게이트 (전체 저장 필요)
+DECLARE_DELEGATE_OneParam(FOnDocumentDeltaRejected, const FString& /* DocumentID */);
+
+// 여러 문서 로드가 모두 끝났을 때 호출되는 델리게이트
+DECLARE_DELEGATE_TwoParams(FOnDocumentsLoaded, const TArray<FJsonCRDTDocumentData>& /* Documents */, const TMap<FString, FString>& /* DocumentID -> ErrorMessage */);
+
+// 여러 문서 저장이 모두 끝났을 때 호출되는 델리게이트
+DECLARE_DELEGATE_TwoParams(FOnDocumentsSaved, const TArray<FString>& /* SavedDocumentIDs */, const TMap<FString, FString>& /* DocumentID -> ErrorMessage */);
+
+// 서버 연결 상태가 바뀌었을 때 호출되는 델리게이트 (게임 스레드)
+DECLARE_DELEGATE_TwoParams(FOnConnectionStatusChanged, bool /* bIsConnected */, const FString& /* StatusMessage */);
+
+/**
+ * 연결이 끊겼을 때의 재연결 설정
+ */
+struct UEJSONCRDT_API FJsonCRDTReconnectSettings
+{
+    /** 연결이 끊기면 자동으로 다시 연결할지 여부 */
+    bool bAutoReconnect = true;
+
+    /** 연결에 성공하기 전까지 연속으로 시도할 최대 횟수 (0이면 제한 없음) */
+    int32 MaxAttempts = 0;
+
+    /** 첫 재시도의 대기 시간 (초, 실패할 때마다 두 배) */
+    float InitialDelaySeconds = 1.0f;
+
+    /** 재시도 대기 시간의 상한 (초) */
+    float MaxDelaySeconds = 30.0f;
+};
+
 /**
  * 문서 데이터 구조체
  */
@@ -50,6 +87,27 @@ struct UEJSONCRDT_API FJsonCRDTDocumentData
     FDateTime UpdatedAt = FDateTime::UtcNow();
 };
 
+/**
+ * 전송 통계 (연결 이후가 아니라 전송 객체가 만들어진 뒤의 누적값)
+ */
+struct FJsonCRDTTransportStats
+{
+    /** 보낸 바이트 수 (WebSocket 메시지와 HTTP 요청 본문) */
+    int64 BytesSent = 0;
+
+    /** 받은 바이트 수 (WebSocket 메시지와 HTTP 응답 본문) */
+    int64 BytesReceived = 0;
+
+    /** 서버로 보낸 패치 수 (대기열에 보관했다가 보낸 패치 포함) */
+    int64 PatchesSent = 0;
+
+    /** 서버에서 받은 패치 수 */
+    int64 PatchesReceived = 0;
+
+    /** 연결이 없어 보관 중인 작업 수 */
+    int32 QueuedOperations = 0;
+};
+
 /**
  * JsonCRDT 전송 인터페이스
  * 서버와의 통신을 추상화하는 인터페이스입니다.
@@ -76,6 +134,35 @@ public:
      */
     virtual void SaveDocument(const FJsonCRDTDocumentData& DocumentData, const FOnDocumentSaved& OnSaved, const FOnTransportError& OnError) = 0;
 
+    /**
+     * 여러 문서 로드 요청 (기본 구현은 문서마다 LoadDocument 호출)
+     * 모든 문서의 결과가 모이면 완료 콜백을 한 번 호출합니다. 문서 순서는 요청 순서와 다를 수 있습니다.
+     * @param DocumentIDs 로드할 문서 ID들
+     * @param OnCompleted 로드된 문서와 실패한 문서의 오류 메시지를 받을 콜백
+     */
+    virtual void LoadDocuments(const TArray<FString>& DocumentIDs, const FOnDocumentsLoaded& OnCompleted);
+
+    /**
+     * 여러 문서 저장 요청 (기본 구현은 문서마다 SaveDocument 호출)
+     * 모든 문서의 결과가 모이면 완료 콜백을 한 번 호출합니다.
+     * @param Documents 저장할 문서 데이터들
+     * @param OnCompleted 저장된 문서 ID와 실패한 문서의 오류 메시지를 받을 콜백
+     */
+    virtual void SaveDocuments(const TArray<FJsonCRDTDocumentData>& Documents, const FOnDocumentsSaved& OnCompleted);
+
+    /**
+     * 서버가 가진 버전 이후의 변경분만 저장 (기본 구현은 항상 거절해 전체 저장을 하게 함)
+     * @param Delta 변경분 (BaseVersion은 서버가 마지막으로 확인한 버전, Operations는 그 이후의 작업)
+     * @param Version 저장 후 문서 버전
+     * @param OnSaved 저장 완료 시 호출될 콜백
+     * @param OnRejected 서버의 버전이 BaseVersion과 다르거나 변경분 저장을 지원하지 않을 때 호출될 콜백
+     * @param OnError 오류 발생 시 호출될 콜백
+     */
+    virtual void SaveDocumentDelta(const FJsonCRDTPatch& Delta, int64 Version, const FOnDocumentSaved& OnSaved, const FOnDocumentDeltaRejected& OnRejected, const FOnTransportError& OnError)
+    {
+        OnRejected.ExecuteIfBound(Delta.DocumentID);
+    }
+
     /**
      * 패치 전송
      * @param Patch 전송할 패치
@@ -85,15 +172,98 @@ public:
     virtual void SendPatch(const FJsonCRDTPatch& Patch, const FOnPatchSent& OnSent, const FOnTransportError& OnError) = 0;
 
     /**
-     * 패치 수신 이벤트 등록
+     * 여러 문서의 패치 전송 (기본 구현은 패치마다 SendPatch 호출)
+     * @param Patches 전송할 패치들
+     * @param OnSent 패치별 전송 완료 시 호출될 콜백
+     * @param OnError 패치별 오류 발생 시 호출될 콜백
+     */
+    virtual void SendPatches(const TArray<FJsonCRDTPatch>& Patches, const FOnPatchSent& OnSent, const FOnTransportError& OnError)
+    {
+        for (const FJsonCRDTPatch& Patch : Patches)
+        {
+            SendPatch(Patch, OnSent, OnError);
+        }
+    }
+
+    /**
+     * 문서 구독 (기본 구현은 무시하며, 그런 전송은 모든 문서의 패치를 받음)
+     * 구독한 문서가 있으면 서버는 구독한 문서와 경로의 패치만 보냅니다. 같은 문서를 다시 구독하면 경로를 바꿉니다.
+     * 구현은 구독 목록을 기억했다가 다시 연결될 때마다 다시 보내야 합니다.
+     * @param DocumentID 문서 ID
+     * @param PathPrefixes 받을 경로 접두사 (비어 있으면 문서 전체)
+     */
+    virtual void Subscribe(const FString& DocumentID, const TArray<FString>& PathPrefixes) {}
+
+    /**
+     * 문서 구독 해제 (기본 구현은 무시)
+     * @param DocumentID 문서 ID
+     */
+    virtual void Unsubscribe(const FString& DocumentID) {}
+
+    /**
+     * 동기화 관리자가 메모리에서 내린 문서에 대해 보관한 데이터 버리기 (기본 구현은 무시)
+     * @param DocumentID 문서 ID
+     */
+    virtual void ReleaseDocument(const FString& DocumentID) {}
+
+    /**
+     * 패치 수신 이벤트 등록 (연결 전에 등록)
+     * 콜백은 게임 스레드가 아닌 작업 스레드에서 호출될 수 있으므로 스레드 안전해야 합니다.
+     * 다른 콜백(빈 콜백 포함)을 등록하고 반환한 뒤에는 이전 콜백을 호출하지 않아야 합니다 (해제 전 등록 취소에 사용).
      * @param OnPatchReceived 패치 수신 시 호출될 콜백
      */
     virtual void RegisterPatchReceived(const FOnPatchReceived& OnPatchReceived) = 0;
+
+    /**
+     * 서버에 연결 (기본 구현은 연결이 필요 없는 전송으로 보고 성공 반환)
+     * @return 연결 시작 여부
+     */
+    virtual bool Connect() { return true; }
+
+    /**
+     * 서버와의 연결 해제 (자동 재연결도 멈춤)
+     */
+    virtual void Disconnect() {}
+
+    /**
+     * 서버와의 연결 상태 확인
+     * @return 연결 상태
+     */
+    virtual bool IsConnected() const { return true; }
+
+    /**
+     * 재연결 설정 (기본 구현은 무시)
+     * @param Settings 재연결 설정
+     */
+    virtual void SetReconnectSettings(const FJsonCRDTReconnectSettings& Settings) {}
+
+    /**
+     * 연결 상태 변경 이벤트 등록 (기본 구현은 무시)
+     * @param OnStatusChanged 연결되거나 끊겼을 때 호출될 콜백
+     */
+    virtual void RegisterConnectionStatusChanged(const FOnConnectionStatusChanged& OnStatusChanged) {}
+
+    /**
+     * 전송 통계 가져오기 (게임 스레드, 기본 구현은 모두 0)
+     * @return 누적 통계
+     */
+    virtual FJsonCRDTTransportStats GetStats() const { return FJsonCRDTTransportStats(); }
 };
 
 /**
  * 기본 JsonCRDT 전송 구현체
  * 기본적인 HTTP 및 WebSocket 통신을 구현합니다.
+ * HTTP 요청은 keep-alive로 같은 서버에 대한 연결을 재사용하고 gzip 응답을 받으며,
+ * 마지막으로 받은 ETag를 If-None-Match로 보내 바뀌지 않은 문서는 304로 받습니다.
+ * 변경분 저장은 PATCH /documents/{id}로 보내며 서버가 409 등으로 거절하면 전체 저장으로 대신합니다.
+ * 여러 문서는 한 번의 요청으로 주고받으며 (POST /documents/batch/load, /documents/batch/save),
+ * 서버에 그 경로가 없으면 문서별 요청을 정해진 수만큼 동시에 보냅니다.
+ * 큰 응답 본문의 압축 해제와 파싱은 작업 스레드에서 하며 로드 콜백은 게임 스레드에서 호출됩니다.
+ * 수신 메시지의 파싱과 패치 디코딩은 작업 스레드의 파이프에서 수신 순서대로 처리되며,
+ * 패치 수신 콜백도 그 작업 스레드에서 호출됩니다.
+ * WebSocket이 끊기면 지터를 섞은 지수 백오프로 다시 연결하고, 연결이 없는 동안 보낸 패치는
+ * 개수 제한이 있는 대기열에 문서별로 합쳐 파일에도 기록해 두었다가 다음 연결에서 프레임 몇 개로 묶어 보냅니다.
+ * 구독 변경은 틱마다 subscribe/unsubscribe 메시지 하나씩으로 묶어 보내고, 연결할 때마다 전체 목록을 다시 보냅니다.
  */
 class UEJSONCRDT_API FDefaultJsonCRDTTransport : public IJsonCRDTTransport
 {
@@ -109,25 +279,80 @@ public:
     // IJsonCRDTTransport 인터페이스 구현
     virtual void LoadDocument(const FString& DocumentID, const FOnDocumentLoaded& OnLoaded, const FOnTransportError& OnError) override;
     virtual void SaveDocument(const FJsonCRDTDocumentData& DocumentData, const FOnDocumentSaved& OnSaved, const FOnTransportError& OnError) override;
+    virtual void LoadDocuments(const TArray<FString>& DocumentIDs, const FOnDocumentsLoaded& OnCompleted) override;
+    virtual void SaveDocuments(const TArray<FJsonCRDTDocumentData>& Documents, const FOnDocumentsSaved& OnCompleted) override;
+    virtual void SaveDocumentDelta(const FJsonCRDTPatch& Delta, int64 Version, const FOnDocumentSaved& OnSaved, const FOnDocumentDeltaRejected& OnRejected, const FOnTransportError& OnError) override;
     virtual void SendPatch(const FJsonCRDTPatch& Patch, const FOnPatchSent& OnSent, const FOnTransportError& OnError) override;
+    virtual void SendPatches(const TArray<FJsonCRDTPatch>& Patches, const FOnPatchSent& OnSent, const FOnTransportError& OnError) override;
+    virtual void Subscribe(const FString& DocumentID, const TArray<FString>& PathPrefixes) override;
+    virtual void Unsubscribe(const FString& DocumentID) override;
+    virtual void ReleaseDocument(const FString& DocumentID) override;
     virtual void RegisterPatchReceived(const FOnPatchReceived& OnPatchReceived) override;
+    virtual bool Connect() override;
+    virtual void Disconnect() override;
+    virtual bool IsConnected() const override;
+    virtual void SetReconnectSettings(const FJsonCRDTReconnectSettings& Settings) override;
+    virtual void RegisterConnectionStatusChanged(const FOnConnectionStatusChanged& OnStatusChanged) override;
+    virtual FJsonCRDTTransportStats GetStats() const override;
 
     /**
-     * 서버에 연결
-     * @return 연결 성공 여부
+     * 연결이 없는 동안 보관할 패치 작업 수 설정 (넘으면 SendPatch가 오류를 반환해 호출자가 보관)
+     * @param InMaxOperations 최대 작업 수 (최소 1)
      */
-    bool Connect();
+    void SetOfflineQueueLimit(int32 InMaxOperations);
 
     /**
-     * 서버와의 연결 해제
+     * 연결이 없는 동안 보관한 패치를 기록할 파일 설정 (기존 파일의 패치는 대기열에 추가)
+     * 기본값은 Saved/JsonCRDT/Outbox-<WebSocket URL 해시>.journal이며, 빈 문자열이면 메모리에만 보관합니다.
+     * @param FilePath 파일 경로
      */
-    void Disconnect();
+    void SetOfflineQueueFile(const FString& FilePath);
 
     /**
-     * 서버와의 연결 상태 확인
-     * @return 연결 상태
+     * 연결이 없는 동안 보관 중인 패치 작업 수
+     * @return 작업 수
+     */
+    int32 GetNumQueuedOperations() const { return NumQueuedOperations; }
+
+    /** 이전 서버용 JSON 패치 메시지 생성 (바이너리 프로토콜이 없을 때 SendPatch가 보내는 텍스트) */
+    FString BuildPatchMessage(const FJsonCRDTPatch& Patch) const;
+
+    /**
+     * 서버와 바이너리 프로토콜이 협상되었는지 확인
+     * @return 바이너리 프레임 사용 여부 (false면 JSON 메시지 사용)
+     */
+    bool IsBinaryProtocol() const;
+
+    /**
+     * 저장 요청의 content를 JSON 문자열 대신 JSON 값 그대로 보낼지 설정 (서버가 지원해야 함)
+     * 로드 응답은 설정과 관계없이 두 형식 모두 받습니다.
+     * @param bEnable 값 그대로 보낼지 여부
      */
-    bool IsConnected() const;
+    void SetContentAsObject(bool bEnable) { bContentAsObject = bEnable; }
+
+    /**
+     * 요청 본문 gzip 압축 설정 (서버가 Content-Encoding: gzip을 지원해야 함)
+     * @param bEnable 압축 여부
+     * @param InMinSize 이 크기(바이트) 이상인 본문만 압축
+     */
+    void SetRequestCompression(bool bEnable, int32 InMinSize = 1024);
+
+    /**
+     * ETag 검증용으로 보관한 문서 캐시 비우기
+     */
+    void ClearDocumentCache();
+
+    /**
+     * ETag 검증용으로 보관할 문서 내용의 최대 크기 설정 (넘으면 가장 오래 쓰지 않은 문서부터 버림)
+     * @param MaxBytes 최대 바이트 수 (0이면 보관하지 않음)
+     */
+    void SetDocumentCacheSize(int64 MaxBytes);
+
+    /**
+     * 서버에 여러 문서 경로가 없을 때 동시에 보낼 문서별 요청 수 설정
+     * @param InMaxParallelRequests 동시 요청 수 (최소 1)
+     */
+    void SetMaxParallelRequests(int32 InMaxParallelRequests);
 
 private:
     /** 서버 URL (HTTP API) */
@@ -137,7 +362,7 @@ private:
     FString WebSocketURL;
 
     /** WebSocket 연결 */
-    TSharedPtr<class IWebSocket> WebSocket;
+    TSharedPtr<IWebSocket> WebSocket;
 
     /** 클라이언트 ID */
     FString ClientID;
@@ -145,12 +370,267 @@ private:
     /** 패치 수신 콜백 */
     FOnPatchReceived OnPatchReceivedDelegate;
 
+    /** OnPatchReceivedDelegate 보호 (등록은 게임 스레드, 호출은 디코딩 작업 스레드에서 잡은 채로 수행) */
+    FCriticalSection PatchReceivedCriticalSection;
+
+    /** 연결 상태 변경 콜백 */
+    FOnConnectionStatusChanged OnConnectionStatusChangedDelegate;
+
+    /** 재연결 설정 */
+    FJsonCRDTReconnectSettings ReconnectSettings;
+
+    /** 연결에 성공하지 못하고 이어진 재연결 시도 수 */
+    int32 ReconnectAttempts = 0;
+
+    /** 재연결이 예약되어 있는지 여부와 그 시각 (FPlatformTime::Seconds) */
+    bool bReconnectPending = false;
+    double NextReconnectTime = 0.0;
+
+    /** Disconnect로 직접 끊었는지 여부 (그때는 재연결하지 않음) */
+    bool bDisconnectRequested = false;
+
+    /** 연결 후 프로토콜 협상을 기다리는 중인지 여부와 연결된 시각 */
+    bool bAwaitingHandshake = false;
+    double ConnectedTime = 0.0;
+
+    /** 연결마다 1씩 늘어나는 세대 (게임 스레드에서 늘리고, 디코딩 작업은 이전 연결의 메시지를 버리는 데 사용) */
+    std::atomic<uint32> ConnectionGeneration{ 0 };
+
+    /**
+     * 서버가 인증에 응답한 연결의 세대와 수락한 프로토콜 (세대 * 2 + 바이너리 여부, 디코딩 작업에서 설정)
+     * 세대가 현재 연결과 다르면 응답이 없는 것으로 보므로 이전 연결의 늦은 응답이 새 연결의 상태를 바꾸지 않음
+     */
+    std::atomic<uint64> AcknowledgedHandshake{ 0 };
+
+    /** 현재 연결에서 서버가 인증에 응답했는지 확인 */
+    bool IsHandshakeAcknowledged() const;
+
+    /** 재연결과 대기열 전송을 처리하는 티커 */
+    FTSTicker::FDelegateHandle TickerHandle;
+
+    /** 연결이 없는 동안 보관한 패치 (문서별로 하나로 합침, 문서가 처음 들어온 순서) */
+    TArray<FJsonCRDTPatch> OfflineQueue;
+
+    /** 보관 중인 패치 작업 수 */
+    int32 NumQueuedOperations = 0;
+
+    /** 보관할 최대 작업 수 */
+    int32 MaxQueuedOperations = 4096;
+
+    /** 보관한 패치를 기록하는 파일 (비어 있으면 메모리에만 보관) */
+    FString OfflineQueueFile;
+
+    /** 구독한 문서 ID별 경로 접두사 (게임 스레드) */
+    TMap<FString, TArray<FString>> Subscriptions;
+
+    /** 마지막으로 보낸 뒤 구독하거나 해제한 문서 ID */
+    TSet<FString> ChangedSubscriptions;
+
+    /** 바이너리 프레임 코덱 (연결마다 초기화) */
+    FJsonCRDTBinaryCodec BinaryCodec;
+
+    /** 수신 메시지를 순서대로 디코딩하는 작업 파이프 */
+    UE::Tasks::FPipe DecodePipe;
+
+    /** 텍스트 패치 메시지를 읽을 때 재사용하는 패치 (디코딩 파이프에서만 사용) */
+    FJsonCRDTPatch DecodedPatch;
+
+    /** 조각으로 나뉘어 도착 중인 바이너리 프레임 */
+    TArray<uint8> IncomingFrame;
+
+    /** 현재 수신 중인 원시 메시지가 바이너리 프레임이 아니라서 무시 중인지 여부 */
+    bool bSkippingRawMessage = false;
+
+    /** ETag로 검증할 수 있도록 보관한 마지막 로드/저장 결과 */
+    struct FCachedDocument
+    {
+        /** 서버가 보낸 ETag */
+        FString ETag;
+
+        /** 그 ETag에 해당하는 문서 데이터 */
+        FJsonCRDTDocumentData Data;
+
+        /** 마지막으로 쓴 순번 (오래된 것부터 버림) */
+        uint64 LastUse = 0;
+    };
+
+    /**
+     * 문서 ID별 ETag 검증용 캐시 (게임 스레드에서만 사용)
+     * 보관한 내용의 크기 합이 한도를 넘으면 가장 오래 쓰지 않은 문서부터 버립니다.
+     */
+    class FDocumentCache
+    {
+    public:
+        /** 보관한 문서 찾기 (찾으면 가장 최근에 쓴 것으로 표시) */
+        const FCachedDocument* Find(const FString& DocumentID);
+
+        /** 문서를 ETag와 함께 보관 (ETag가 비어 있으면 보관하던 것을 버림) */
+        void Add(const FString& ETag, FJsonCRDTDocumentData Data);
+
+        /** 문서 버리기 */
+        void Remove(const FString& DocumentID);
+
+        /** 모두 버리기 */
+        void Empty();
+
+        /** 최대 크기 설정 */
+        void SetMaxBytes(int64 InMaxBytes);
+
+    private:
+        /** 문서 ID별 항목 */
+        TMap<FString, FCachedDocument> Entries;
+
+        /** 보관한 내용의 크기 합 (바이트) */
+        int64 NumBytes = 0;
+
+        /** 최대 크기 (바이트) */
+        int64 MaxBytes = 8 * 1024 * 1024;
+
+        /** 사용 순번 */
+        uint64 UseCounter = 0;
+
+        /** 항목이 차지하는 크기 */
+        static int64 GetEntrySize(const FCachedDocument& Entry);
+
+        /** 한도를 넘는 동안 가장 오래 쓰지 않은 항목 버리기 */
+        void Trim();
+    };
+
+    /** ETag 검증용 캐시 (요청 완료 콜백이 전송 객체보다 오래 살 수 있어 공유 참조로 보관) */
+    TSharedRef<FDocumentCache> DocumentCache;
+
+    /** 저장 요청의 content를 JSON 값 그대로 보낼지 여부 */
+    bool bContentAsObject = false;
+
+    /** 요청 본문 압축 여부 */
+    bool bCompressRequests = false;
+
+    /** 압축할 최소 본문 크기 */
+    int32 CompressionMinSize = 1024;
+
+    /** 서버가 여러 문서 경로를 지원하는지 여부 */
+    TSharedRef<bool> bBatchRouteSupported;
+
+    /** 서버가 변경분 저장을 지원하는지 여부 (405/501을 받으면 false, 요청 완료 콜백에서 갱신하므로 공유 참조) */
+    TSharedRef<bool> bDeltaRouteSupported;
+
+    /** 여러 문서 경로가 없을 때 동시에 보낼 문서별 요청 수 */
+    int32 MaxParallelRequests = 6;
+
+    /** 전송 통계 (디코딩 작업과 요청 완료 콜백에서도 갱신하며, 콜백이 전송 객체보다 오래 살 수 있어 공유 참조로 보관) */
+    struct FTrafficCounters
+    {
+        std::atomic<int64> BytesSent{ 0 };
+        std::atomic<int64> BytesReceived{ 0 };
+        std::atomic<int64> PatchesSent{ 0 };
+        std::atomic<int64> PatchesReceived{ 0 };
+    };
+
+    TSharedRef<FTrafficCounters, ESPMode::ThreadSafe> Traffic;
+
+    /** 요청 완료 콜백이 전송 객체를 참조하지 않도록 요청 시점에 복사해 두는 설정 */
+    struct FRequestOptions
+    {
+        /** 서버 URL (HTTP API) */
+        FString ServerURL;
+
+        /** 저장 요청에 넣을 클라이언트 ID */
+        FString ClientID;
+
+        /** 저장 요청의 content를 JSON 값 그대로 보낼지 여부 */
+        bool bContentAsObject = false;
+
+        /** 요청 본문 압축 여부와 압축할 최소 크기 */
+        bool bCompressRequests = false;
+        int32 CompressionMinSize = 0;
+
+        /** 문서별 요청으로 나눠 보낼 때의 동시 요청 수 */
+        int32 MaxParallelRequests = 1;
+
+        /** 서버가 여러 문서 경로를 지원하는지 여부 (404/405/501을 받으면 false, 요청 완료 콜백에서 갱신하므로 공유 참조) */
+        TSharedPtr<bool> bBatchRouteSupported;
+
+        /** 전송 통계 */
+        TSharedPtr<FTrafficCounters, ESPMode::ThreadSafe> Traffic;
+    };
+
+    /** 현재 설정으로 요청 설정 만들기 */
+    FRequestOptions GetRequestOptions() const;
+
+    /** HTTP 요청 전송 (요청 본문과 응답 본문 크기를 통계에 더함) */
+    static void ProcessHttpRequest(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& HttpRequest, const TSharedRef<FTrafficCounters, ESPMode::ThreadSafe>& Counters);
+
+    /** 문서 하나 로드 요청 전송 */
+    static void SendLoadRequest(const FRequestOptions& Options, const TSharedRef<FDocumentCache>& Cache, const FString& DocumentID, const FOnDocumentLoaded& OnLoaded, const FOnTransportError& OnError);
+
+    /** 문서 하나 저장 요청 전송 */
+    static void SendSaveRequest(const FRequestOptions& Options, const TSharedRef<FDocumentCache>& Cache, const FJsonCRDTDocumentData& DocumentData, const FOnDocumentSaved& OnSaved, const FOnTransportError& OnError);
+
+    /** 여러 문서를 문서별 요청으로 로드 (최대 MaxParallelRequests개씩 동시에) */
+    static void LoadInParallel(const FRequestOptions& Options, const TSharedRef<FDocumentCache>& Cache, const TArray<FString>& DocumentIDs, const FOnDocumentsLoaded& OnCompleted);
+
+    /** 여러 문서를 문서별 요청으로 저장 (최대 MaxParallelRequests개씩 동시에) */
+    static void SaveInParallel(const FRequestOptions& Options, const TSharedRef<FDocumentCache>& Cache, const TArray<FJsonCRDTDocumentData>& Documents, const FOnDocumentsSaved& OnCompleted);
+
+    /** 소켓 생성과 연결 시작 (재연결 시도 수는 그대로 둠) */
+    void OpenSocket();
+
+    /** 현재 소켓의 이벤트 등록을 해제하고 닫음 */
+    void CloseSocket();
+
+    /** 연결이 끊겼을 때 설정에 따라 재연결 예약 */
+    void HandleConnectionLost(const FString& Reason);
+
+    /** 연결 상태 변경 알림 */
+    void NotifyConnectionStatus(bool bIsConnected, const FString& StatusMessage);
+
+    /** 예약된 재연결과 협상을 마친 연결의 대기열 전송 처리 */
+    bool TickConnection(float DeltaTime);
+
+    /** 패치를 바로 보내지 않고 대기열에 넣어야 하는지 여부 (연결 전, 협상 중, 또는 먼저 보낼 패치가 남아 있음) */
+    bool ShouldQueuePatches() const;
+
+    /**
+     * 패치를 대기열에 추가 (같은 문서의 패치에 작업을 이어 붙임)
+     * @return 제한을 넘지 않아 보관했으면 true
+     */
+    bool EnqueuePatch(const FJsonCRDTPatch& Patch);
+
+    /** 대기열의 패치를 묶어 전송하고 전송한 만큼 대기열과 파일 정리 */
+    void FlushOfflineQueue();
+
+    /** 대기열 파일의 패치를 대기열에 추가 */
+    void LoadOfflineQueue();
+
+    /** 대기열 파일 삭제 (백그라운드 기록기에 남은 추가 쓰기를 먼저 끝냄) */
+    void DeleteOfflineQueueFile();
+
+    /**
+     * 구독 메시지 전송 (Subscriptions에 있는 문서는 subscribe, 없는 문서는 unsubscribe로 각각 하나의 메시지에 묶음)
+     * @param DocumentIDs 알릴 문서 ID들
+     */
+    void SendSubscriptions(const TArray<FString>& DocumentIDs);
+
+    /** 패치를 전송 형식에 맞춰 바로 전송 */
+    void SendPatchNow(const FJsonCRDTPatch& Patch);
+
+    /** 소켓으로 메시지 전송 (보낸 바이트를 통계에 더함) */
+    void SendText(const FString& Message);
+    void SendFrame(const TArray<uint8>& Frame);
+
     /** WebSocket 연결 이벤트 핸들러 */
     void OnWebSocketConnected();
     void OnWebSocketConnectionError(const FString& Error);
     void OnWebSocketMessage(const FString& Message);
+    void OnWebSocketRawMessage(const void* Data, SIZE_T Size, SIZE_T BytesRemaining);
     void OnWebSocketClosed(int32 StatusCode, const FString& Reason, bool bWasClean);
 
+    /** 텍스트 메시지 처리 (디코딩 파이프에서 실행, Generation은 받았을 때의 연결 세대) */
+    void HandleTextMessage(const FString& Message, uint32 Generation);
+
+    /** 완성된 바이너리 프레임 처리 (디코딩 파이프에서 실행, Generation은 받았을 때의 연결 세대) */
+    void HandleBinaryFrame(const TArray<uint8>& Frame, const TWeakPtr<IWebSocket>& Socket, uint32 Generation);
+
     /** 고유 클라이언트 ID 생성 */
     FString GenerateClientID();
 };
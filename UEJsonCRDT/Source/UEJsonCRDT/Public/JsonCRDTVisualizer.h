@@ -6,8 +6,37 @@
 #include "JsonCRDTLogger.h"
 #include "JsonCRDTVisualizer.generated.h"
 
+/**
+ * 시각화 내보내기 형식
+ */
+UENUM(BlueprintType)
+enum class EJsonCRDTVisualizerExportFormat : uint8
+{
+    // 로그 테이블 (HTML)
+    HTML UMETA(DisplayName = "HTML"),
+    
+    // 로그 테이블 (CSV)
+    CSV UMETA(DisplayName = "CSV"),
+    
+    // 문서 변경 히스토리 (HTML)
+    DocumentHistory UMETA(DisplayName = "Document History"),
+    
+    // 충돌 (HTML)
+    Conflicts UMETA(DisplayName = "Conflicts")
+};
+
+// 비동기 내보내기 진행 상황 델리게이트 (게임 스레드에서 호출)
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnVisualizerExportProgress, int32, NumExported, int32, NumTotal);
+
+// 비동기 내보내기 완료 델리게이트 (게임 스레드에서 호출)
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnVisualizerExportCompleted, bool, bSuccess);
+
 /**
  * CRDT 시각화 도구
+ *
+ * 출력은 메모리에 모두 만들지 않고 일정 크기마다 파일에 나누어 기록합니다.
+ * HTML 출력은 EntriesPerPage 항목마다 별도 파일(이름_2.html, 이름_3.html ...)로 나누고
+ * 각 페이지에 페이지 이동 링크를 넣습니다.
  */
 UCLASS(BlueprintType)
 class UEJSONCRDT_API UJsonCRDTVisualizer : public UObject
@@ -15,6 +44,10 @@ class UEJSONCRDT_API UJsonCRDTVisualizer : public UObject
     GENERATED_BODY()
     
 public:
+    /** HTML 페이지당 항목 수 (0이면 한 파일에 모두 기록) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "JsonCRDT")
+    int32 EntriesPerPage = 5000;
+    
     /** 로그 데이터를 HTML 형식으로 내보내기 */
     UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
     bool ExportToHTML(const TArray<FJsonCRDTLogEntry>& LogEntries, const FString& FilePath);
@@ -31,22 +64,46 @@ public:
     UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
     bool VisualizeConflicts(const TArray<FJsonCRDTLogEntry>& LogEntries, const FString& FilePath);
     
+    /**
+     * 백그라운드 작업으로 내보내기
+     * 로그 항목은 복사해서 사용하므로 호출 직후 원본을 바꿔도 됩니다.
+     * @param Format 내보내기 형식
+     * @param LogEntries 로그 항목
+     * @param FilePath 파일 경로 (HTML 페이지가 여러 개면 첫 페이지 경로)
+     * @param OnProgress 진행 상황 (일정 항목 수마다 호출)
+     * @param OnCompleted 완료 시 호출
+     */
+    UFUNCTION(BlueprintCallable, Category = "JsonCRDT")
+    void ExportAsync(EJsonCRDTVisualizerExportFormat Format, const TArray<FJsonCRDTLogEntry>& LogEntries, const FString& FilePath, FOnVisualizerExportProgress OnProgress, FOnVisualizerExportCompleted OnCompleted);
+    
 private:
-    /** HTML 헤더 생성 */
-    FString GenerateHTMLHeader(const FString& Title);
+    /**
+     * 형식에 맞게 파일로 내보내기 (어느 스레드에서나 호출 가능)
+     * @param OnProgress 진행 상황 (기록한 단위 수, 전체 단위 수)
+     */
+    static bool ExportEntries(EJsonCRDTVisualizerExportFormat Format, const TArray<FJsonCRDTLogEntry>& LogEntries, const FString& FilePath, int32 InEntriesPerPage, TFunctionRef<void(int32, int32)> OnProgress);
+    
+    /** 로그 테이블 HTML 기록 */
+    static bool WriteHTMLTable(const TArray<FJsonCRDTLogEntry>& LogEntries, const FString& FilePath, int32 InEntriesPerPage, TFunctionRef<void(int32, int32)> OnProgress);
+    
+    /** CSV 기록 */
+    static bool WriteCSV(const TArray<FJsonCRDTLogEntry>& LogEntries, const FString& FilePath, TFunctionRef<void(int32, int32)> OnProgress);
+    
+    /** 문서 변경 히스토리 HTML 기록 */
+    static bool WriteDocumentHistory(const TArray<FJsonCRDTLogEntry>& LogEntries, const FString& FilePath, int32 InEntriesPerPage, TFunctionRef<void(int32, int32)> OnProgress);
     
-    /** HTML 푸터 생성 */
-    FString GenerateHTMLFooter();
+    /** 충돌 HTML 기록 */
+    static bool WriteConflicts(const TArray<FJsonCRDTLogEntry>& LogEntries, const FString& FilePath, int32 InEntriesPerPage, TFunctionRef<void(int32, int32)> OnProgress);
     
-    /** 로그 항목을 HTML 테이블 행으로 변환 */
-    FString LogEntryToHTMLRow(const FJsonCRDTLogEntry& LogEntry);
+    /** 로그 항목을 HTML 테이블 행으로 추가 */
+    static void AppendLogEntryHTMLRow(const FJsonCRDTLogEntry& LogEntry, FString& Out);
     
-    /** 로그 항목을 CSV 행으로 변환 */
-    FString LogEntryToCSVRow(const FJsonCRDTLogEntry& LogEntry);
+    /** 로그 항목을 CSV 행으로 추가 */
+    static void AppendLogEntryCSVRow(const FJsonCRDTLogEntry& LogEntry, FString& Out);
     
-    /** 충돌을 HTML로 시각화 */
-    FString ConflictToHTML(const FJsonCRDTConflict& Conflict);
+    /** 충돌을 HTML로 추가 */
+    static void AppendConflictHTML(const FJsonCRDTConflict& Conflict, FString& Out);
     
-    /** 문서 변경 히스토리를 HTML로 시각화 */
-    FString DocumentHistoryToHTML(const TArray<FJsonCRDTLogEntry>& LogEntries);
+    /** 로그 항목을 히스토리 타임라인 항목으로 추가 */
+    static void AppendTimelineItemHTML(const FJsonCRDTLogEntry& LogEntry, FString& Out);
 };
@@ -26,6 +26,7 @@ public class UEJsonCRDT : ModuleRules
 			{
 				"Core",
 				"CoreUObject",
+				"JsonCRDTCore",
 				"Engine",
 				"InputCore",
 				"Json",
@@ -36,6 +36,10 @@ mkdir -p $UE_DIR/LuvJsonCRDT/Resources
 echo "Copying UE header files..."
 cp ./src/ue/LuvJsonCRDT.h $UE_DIR/LuvJsonCRDT/Source/LuvJsonCRDT/Public/
 
+# Copy UE source files (the native document sits on JsonCRDTCore from the UEJsonCRDT plugin)
+echo "Copying UE source files..."
+cp ./src/ue/LuvJsonCRDT.cpp $UE_DIR/LuvJsonCRDT/Source/LuvJsonCRDT/Private/
+
 # Copy WASM files to UE plugin
 echo "Copying WASM files to UE plugin..."
 mkdir -p $UE_DIR/LuvJsonCRDT/Resources/WASM
@@ -67,6 +71,12 @@ cat > $UE_DIR/LuvJsonCRDT/LuvJsonCRDT.uplugin << EOF
 			"Type": "Runtime",
 			"LoadingPhase": "Default"
 		}
+	],
+	"Plugins": [
+		{
+			"Name": "UEJsonCRDT",
+			"Enabled": true
+		}
 	]
 }
 EOF
@@ -101,7 +111,8 @@ public class LuvJsonCRDT : ModuleRules
 				"CoreUObject",
 				"Engine",
 				"Json",
-				"JsonUtilities"
+				"JsonUtilities",
+				"JsonCRDTCore"
 			}
 		);
 			
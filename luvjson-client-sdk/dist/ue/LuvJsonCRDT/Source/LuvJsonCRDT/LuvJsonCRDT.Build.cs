@@ -25,7 +25,8 @@ public class LuvJsonCRDT : ModuleRules
 				"CoreUObject",
 				"Engine",
 				"Json",
-				"JsonUtilities"
+				"JsonUtilities",
+				"JsonCRDTCore"
 			}
 		);
 			
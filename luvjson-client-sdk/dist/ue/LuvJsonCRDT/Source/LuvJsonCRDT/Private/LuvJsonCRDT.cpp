@@ -0,0 +1,181 @@
+#include "LuvJsonCRDT.h"
+#include "JsonCRDTDocumentCore.h"
+
+/**
+ * Native document behind ULuvJsonDocument
+ *
+ * The document state and patch apply come from the JsonCRDTCore module of the UEJsonCRDT plugin,
+ * so this binding applies operations exactly like UJsonCRDTDocument and headless programs do.
+ * Paths are JSON Pointers ("/path/to/value").
+ */
+class FLuvJsonDocument : public FJsonCRDTDocumentCore
+{
+public:
+    using FJsonCRDTDocumentCore::FJsonCRDTDocumentCore;
+};
+
+namespace LuvJsonCRDT
+{
+    /** Convert a LuvJSON timestamp (Unix nanoseconds, 0 if unset) */
+    static FDateTime ToDateTime(int64 UnixNanoseconds)
+    {
+        if (UnixNanoseconds == 0)
+        {
+            return FDateTime(0);
+        }
+        return FDateTime(FDateTime(1970, 1, 1).GetTicks() + UnixNanoseconds / ETimespan::NanosecondsPerTick);
+    }
+
+    /** Convert a time to a LuvJSON timestamp (Unix nanoseconds) */
+    static int64 ToUnixNanoseconds(const FDateTime& Time)
+    {
+        return (Time.GetTicks() - FDateTime(1970, 1, 1).GetTicks()) * ETimespan::NanosecondsPerTick;
+    }
+
+    /** Convert a LuvJSON operation type */
+    static EJsonCRDTOperationType ToCoreType(ELuvJsonOperationType Type)
+    {
+        switch (Type)
+        {
+        case ELuvJsonOperationType::Remove:
+            return EJsonCRDTOperationType::Remove;
+        case ELuvJsonOperationType::Replace:
+            return EJsonCRDTOperationType::Replace;
+        default:
+            return EJsonCRDTOperationType::Add;
+        }
+    }
+
+    /** Convert a LuvJSON patch (operations and IDs are copied, the patch has no sequence so it is never skipped as a resend) */
+    static FJsonCRDTPatch ToCorePatch(const FLuvJsonPatch& Patch)
+    {
+        FJsonCRDTPatch CorePatch;
+        CorePatch.DocumentID = Patch.DocumentID;
+        CorePatch.BaseVersion = Patch.BaseVersion;
+        CorePatch.ClientID = Patch.ClientID;
+        CorePatch.Operations.Reserve(Patch.Operations.Num());
+        for (const FLuvJsonOperation& Operation : Patch.Operations)
+        {
+            FJsonCRDTOperation& CoreOperation = CorePatch.Operations.AddDefaulted_GetRef();
+            CoreOperation.Type = ToCoreType(Operation.Type);
+            CoreOperation.Path = Operation.Path;
+            CoreOperation.Value = Operation.Value;
+            CoreOperation.Timestamp = ToDateTime(Operation.Timestamp);
+            CoreOperation.ClientID = Operation.ClientID;
+        }
+        return CorePatch;
+    }
+}
+
+ULuvJsonDocument::ULuvJsonDocument()
+    : NativeDocument(MakeShared<FLuvJsonDocument>())
+{
+}
+
+ULuvJsonDocument::~ULuvJsonDocument()
+{
+}
+
+void ULuvJsonDocument::Initialize(const FString& InDocumentID)
+{
+    NativeDocument->SetDocumentID(InDocumentID);
+}
+
+FString ULuvJsonDocument::GetDocumentID() const
+{
+    return NativeDocument->GetDocumentID();
+}
+
+int64 ULuvJsonDocument::GetVersion() const
+{
+    return NativeDocument->GetVersion();
+}
+
+FString ULuvJsonDocument::GetContentAsString() const
+{
+    return NativeDocument->GetContentAsString();
+}
+
+bool ULuvJsonDocument::SetContentFromString(const FString& JsonString)
+{
+    if (!NativeDocument->SetContentFromString(JsonString))
+    {
+        return false;
+    }
+
+    OnDocumentChanged.Broadcast(NativeDocument->GetDocumentID());
+    return true;
+}
+
+bool ULuvJsonDocument::ApplyPatch(const FLuvJsonPatch& Patch)
+{
+    // Same rule as the WASM document: a patch cannot be based on a version this document has not reached
+    if (Patch.BaseVersion > NativeDocument->GetVersion())
+    {
+        UE_LOG(LogTemp, Error, TEXT("Patch base version %lld is ahead of document version %lld"), Patch.BaseVersion, NativeDocument->GetVersion());
+        return false;
+    }
+
+    const int64 PreviousVersion = NativeDocument->GetVersion();
+    if (!NativeDocument->ApplyPatch(LuvJsonCRDT::ToCorePatch(Patch)))
+    {
+        return false;
+    }
+
+    if (NativeDocument->GetVersion() != PreviousVersion)
+    {
+        OnDocumentChanged.Broadcast(NativeDocument->GetDocumentID());
+    }
+    return true;
+}
+
+FLuvJsonOperation ULuvJsonDocument::CreateOperation(ELuvJsonOperationType Type, const FString& Path, const FString& Value, const FString& ClientID)
+{
+    FLuvJsonOperation Operation;
+    Operation.Type = Type;
+    Operation.Path = Path;
+    Operation.Value = Value;
+    Operation.Timestamp = LuvJsonCRDT::ToUnixNanoseconds(FDateTime::UtcNow());
+    Operation.ClientID = ClientID;
+    return Operation;
+}
+
+FLuvJsonPatch ULuvJsonDocument::CreatePatch(const TArray<FLuvJsonOperation>& Operations, const FString& ClientID)
+{
+    FLuvJsonPatch Patch;
+    Patch.DocumentID = NativeDocument->GetDocumentID();
+    Patch.BaseVersion = NativeDocument->GetVersion();
+    Patch.Operations = Operations;
+    Patch.ClientID = ClientID;
+    return Patch;
+}
+
+ULuvJsonClient::ULuvJsonClient()
+{
+}
+
+ULuvJsonClient::~ULuvJsonClient()
+{
+}
+
+void ULuvJsonClient::Initialize()
+{
+}
+
+ULuvJsonDocument* ULuvJsonClient::CreateDocument(const FString& DocumentID)
+{
+    if (ULuvJsonDocument* Existing = Documents.FindRef(DocumentID))
+    {
+        return Existing;
+    }
+
+    ULuvJsonDocument* Document = NewObject<ULuvJsonDocument>(this);
+    Document->Initialize(DocumentID);
+    Documents.Add(DocumentID, Document);
+    return Document;
+}
+
+ULuvJsonDocument* ULuvJsonClient::GetDocument(const FString& DocumentID)
+{
+    return Documents.FindRef(DocumentID);
+}
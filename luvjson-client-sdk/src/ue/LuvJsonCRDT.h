@@ -91,7 +91,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnDocumentChanged, const FString&,
  * LuvJsonDocument - A CRDT document that can be synchronized
  */
 UCLASS(BlueprintType, Blueprintable)
-class LUVJSON_API ULuvJsonDocument : public UObject
+class LUVJSONCRDT_API ULuvJsonDocument : public UObject
 {
     GENERATED_BODY()
 
@@ -144,7 +144,7 @@ private:
  * LuvJsonClient - Main client for LuvJSON CRDT
  */
 UCLASS(BlueprintType, Blueprintable)
-class LUVJSON_API ULuvJsonClient : public UObject
+class LUVJSONCRDT_API ULuvJsonClient : public UObject
 {
     GENERATED_BODY()
 